@@ -3,8 +3,8 @@
 #include <cxxopts.hpp>
 #include <fmt/format.h>
 
-#include <array>
 #include <algorithm>
+#include <array>
 #include <cerrno>
 #include <csignal>
 #include <cstdlib>
@@ -14,7 +14,8 @@
 #include <vector>
 
 #if defined(__unix__) || defined(__APPLE__)
-    #include <sys/select.h>
+    #include <fcntl.h>
+    #include <poll.h>
     #include <sys/wait.h>
     #include <unistd.h>
 #endif
@@ -32,22 +33,88 @@ std::vector<const char *> BuildArgv(const std::filesystem::path &headlessPath,
     argv.push_back(nullptr);
     return argv;
 }
-bool WriteAll(int fd, const char *buf, size_t n) {
-    size_t written = 0;
-    while (written < n) {
-        ssize_t result = write(fd, buf + written, n - written);
-        if (result == -1) {
+// Large enough to carry a whole memory dump frame in a handful of reads.
+constexpr size_t kRelayBufferSize = 256 * 1024;
+
+enum class RelayResult {
+    Moved,
+    WouldBlock,
+    EndOfStream,
+    Failed,
+};
+
+// One direction of the stdio relay. Bytes the output cannot take yet stay in the input pipe (splice) or in the buffer
+// (copy) until poll() reports the output as writable, so the relay never blocks on one direction while the other one
+// needs draining.
+struct RelayChannel {
+    int from;
+    int to;
+    bool useSplice = true;
+    std::vector<char> buffer = std::vector<char>(kRelayBufferSize);
+    size_t pendingOffset = 0;
+    size_t pendingSize = 0;
+};
+
+RelayResult FlushPending(RelayChannel &channel) {
+    while (channel.pendingSize > 0) {
+        const ssize_t n = write(channel.to, channel.buffer.data() + channel.pendingOffset, channel.pendingSize);
+        if (n == -1) {
             if (errno == EINTR) {
                 continue;
             }
-            return false;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return RelayResult::WouldBlock;
+            }
+            channel.pendingSize = 0;
+            return RelayResult::Failed;
+        }
+        channel.pendingOffset += static_cast<size_t>(n);
+        channel.pendingSize -= static_cast<size_t>(n);
+    }
+    return RelayResult::Moved;
+}
+
+// Moves the bytes currently available on the channel's input to its output. On Linux, splice() moves them inside the
+// kernel when either end is a pipe; useSplice is cleared if splicing fails and the channel falls back to copying
+// through its buffer.
+RelayResult RelayOnce(RelayChannel &channel) {
+    if (channel.pendingSize > 0) {
+        return FlushPending(channel);
+    }
+
+#if defined(__linux__)
+    while (channel.useSplice) {
+        const ssize_t n = splice(channel.from, nullptr, channel.to, nullptr, channel.buffer.size(),
+                                 SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        if (n > 0) {
+            return RelayResult::Moved;
+        }
+        if (n == 0) {
+            return RelayResult::EndOfStream;
+        }
+        if (errno == EINTR) {
+            continue;
         }
-        if (result == 0) {
-            return false;
+        if (errno == EAGAIN) {
+            return RelayResult::WouldBlock;
         }
-        written += static_cast<size_t>(result);
+        // Not supported by these descriptors (or the output is broken); copying still drains the input
+        channel.useSplice = false;
     }
-    return true;
+#else
+    channel.useSplice = false;
+#endif
+
+    ssize_t n;
+    do {
+        n = read(channel.from, channel.buffer.data(), channel.buffer.size());
+    } while (n == -1 && errno == EINTR);
+    if (n <= 0) {
+        return RelayResult::EndOfStream;
+    }
+    channel.pendingOffset = 0;
+    channel.pendingSize = static_cast<size_t>(n);
+    return FlushPending(channel);
 }
 #endif
 
@@ -140,54 +207,64 @@ int main(int argc, char **argv) {
     close(pipeStdout[1]); // write end of stdout pipe
 
     // ---- Stdio relay loop ----
-    bool running = true;
+#if defined(__linux__)
+    // Deeper pipes mean fewer wakeups while the instance streams bulk data
+    fcntl(pipeStdout[0], F_SETPIPE_SZ, static_cast<int>(kRelayBufferSize * 4));
+    fcntl(pipeStdin[1], F_SETPIPE_SZ, static_cast<int>(kRelayBufferSize * 4));
+#endif
+    // The instance may stop reading its stdin while it writes a large response, so writes to it must not block
+    fcntl(pipeStdin[1], F_SETFL, fcntl(pipeStdin[1], F_GETFL) | O_NONBLOCK);
+
+    RelayChannel toHeadless{STDIN_FILENO, pipeStdin[1]};
+    RelayChannel fromHeadless{pipeStdout[0], STDOUT_FILENO};
     bool stdinClosed = false;
-    fd_set readfds;
-    std::array<char, 4096> buffer;
+    bool toHeadlessBlocked = false;
+    bool fromHeadlessBlocked = false;
 
     signal(SIGPIPE, SIG_IGN);
 
-    while (running) {
-        FD_ZERO(&readfds);
-        FD_SET(pipeStdout[0], &readfds);
-        if (!stdinClosed) {
-            FD_SET(STDIN_FILENO, &readfds);
-        }
-
-        int maxFd = std::max(pipeStdout[0], STDIN_FILENO);
-        // 100 ms prevents infinite block if headless hangs.
-        struct timeval tv{0, 100000};
-        int sel = select(maxFd + 1, &readfds, nullptr, nullptr, &tv);
-        if (sel == -1) {
+    while (true) {
+        // Wait for input on each direction, or for its output to drain if it is blocked. Negative descriptors are
+        // ignored by poll(). No timeout is needed: the instance exiting closes its end of the pipe, which wakes up
+        // poll() with POLLHUP.
+        std::array<pollfd, 4> fds{};
+        fds[0] = {fromHeadlessBlocked ? -1 : pipeStdout[0], POLLIN, 0};
+        fds[1] = {fromHeadlessBlocked ? STDOUT_FILENO : -1, POLLOUT, 0};
+        fds[2] = {stdinClosed || toHeadlessBlocked ? -1 : STDIN_FILENO, POLLIN, 0};
+        fds[3] = {!stdinClosed && toHeadlessBlocked ? pipeStdin[1] : -1, POLLOUT, 0};
+        if (poll(fds.data(), fds.size(), -1) == -1) {
             if (errno == EINTR) {
                 continue;
             }
             break;
         }
+        auto ready = [](const pollfd &fd) { return (fd.revents & (POLLIN | POLLOUT | POLLHUP | POLLERR)) != 0; };
 
         // Read from our stdin, write to headless stdin
-        if (FD_ISSET(STDIN_FILENO, &readfds)) {
-            ssize_t n = read(STDIN_FILENO, buffer.data(), buffer.size());
-            if (n <= 0) {
-                stdinClosed = true;
-                close(pipeStdin[1]);
-            } else {
-                if (!WriteAll(pipeStdin[1], buffer.data(), static_cast<size_t>(n))) {
-                    stdinClosed = true;
-                    close(pipeStdin[1]);
-                }
-            }
+        RelayResult toHeadlessResult = RelayResult::Moved;
+        if (ready(fds[3])) {
+            toHeadlessResult = FlushPending(toHeadless);
+        } else if (ready(fds[2])) {
+            toHeadlessResult = RelayOnce(toHeadless);
+        }
+        toHeadlessBlocked = toHeadlessResult == RelayResult::WouldBlock;
+        if (toHeadlessResult == RelayResult::EndOfStream || toHeadlessResult == RelayResult::Failed) {
+            stdinClosed = true;
+            close(pipeStdin[1]);
         }
 
         // Read from headless stdout, write to our stdout
-        if (FD_ISSET(pipeStdout[0], &readfds)) {
-            ssize_t n = read(pipeStdout[0], buffer.data(), buffer.size());
-            if (n <= 0) {
-                running = false;
-            } else {
-                WriteAll(STDOUT_FILENO, buffer.data(), static_cast<size_t>(n));
-            }
+        RelayResult fromHeadlessResult = RelayResult::Moved;
+        if (ready(fds[1])) {
+            fromHeadlessResult = FlushPending(fromHeadless);
+        } else if (ready(fds[0])) {
+            fromHeadlessResult = RelayOnce(fromHeadless);
+        }
+        if (fromHeadlessResult == RelayResult::EndOfStream) {
+            break;
         }
+        // Keep draining even if our stdout is gone so that the instance never blocks on a full pipe
+        fromHeadlessBlocked = fromHeadlessResult == RelayResult::WouldBlock;
     }
 
     // Wait for child and return its exit code
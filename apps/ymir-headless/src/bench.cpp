@@ -0,0 +1,227 @@
+#include "runner.hpp"
+#include "system.hpp"
+
+#include <ymir/debug/input_movie.hpp>
+#include <ymir/sys/saturn.hpp>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace ymir::debug {
+
+namespace {
+
+    static constexpr std::string_view kInputMovieExtension = ".ymov";
+
+    // Expands directories into the input movies they contain, sorted by path.
+    std::vector<std::filesystem::path> CollectMoviePaths(const std::vector<std::filesystem::path> &paths) {
+        std::vector<std::filesystem::path> moviePaths{};
+        for (const auto &path : paths) {
+            std::error_code error{};
+            if (!std::filesystem::is_directory(path, error)) {
+                moviePaths.push_back(path);
+                continue;
+            }
+            std::vector<std::filesystem::path> dirMovies{};
+            for (const auto &entry : std::filesystem::directory_iterator{path, error}) {
+                if (entry.is_regular_file() && entry.path().extension() == kInputMovieExtension) {
+                    dirMovies.push_back(entry.path());
+                }
+            }
+            std::sort(dirMovies.begin(), dirMovies.end());
+            moviePaths.insert(moviePaths.end(), dirMovies.begin(), dirMovies.end());
+        }
+        return moviePaths;
+    }
+
+    // Nearest-rank percentile of a sorted list of values.
+    double Percentile(const std::vector<double> &sortedValues, double percentile) {
+        if (sortedValues.empty()) {
+            return 0.0;
+        }
+        const size_t rank = static_cast<size_t>(std::ceil(percentile * sortedValues.size()));
+        return sortedValues[std::clamp<size_t>(rank, 1, sortedValues.size()) - 1];
+    }
+
+    struct BenchResult {
+        uint64 frames = 0;
+        double elapsedSecs = 0.0;
+        double p50FrameTimeMs = 0.0;
+        double p99FrameTimeMs = 0.0;
+        std::optional<uint64> firstDivergentFrame;
+        uint64 readMismatches = 0;
+        std::optional<ResidentMemory> memory; // measured at the end of the replay
+    };
+
+    // Replays an input movie on a fresh system, timing each emulated frame. Determinism hashes are computed outside of
+    // the timed region. Prints any errors and returns std::nullopt if the movie could not be replayed.
+    std::optional<BenchResult> BenchMovie(const HeadlessConfig &config, std::shared_ptr<const util::SharedMemory> ipl,
+                                          const std::filesystem::path &moviePath) {
+        InputMovie movie{};
+        std::error_code error{};
+        switch (ReadInputMovie(moviePath, movie, error)) {
+        case InputMovieReadResult::Success: break;
+        case InputMovieReadResult::FilesystemError:
+            fmt::print(stderr, "ymir-headless: failed to read input movie {}: {}\n", moviePath.string(),
+                       error.message());
+            return std::nullopt;
+        case InputMovieReadResult::InvalidFormat:
+            fmt::print(stderr, "ymir-headless: not an input movie: {}\n", moviePath.string());
+            return std::nullopt;
+        case InputMovieReadResult::VersionMismatch:
+            fmt::print(stderr, "ymir-headless: unsupported input movie version: {}\n", moviePath.string());
+            return std::nullopt;
+        case InputMovieReadResult::LayoutMismatch:
+            fmt::print(stderr, "ymir-headless: input movie recorded by an incompatible build: {}\n",
+                       moviePath.string());
+            return std::nullopt;
+        case InputMovieReadResult::Truncated:
+            fmt::print(stderr, "ymir-headless: input movie is truncated: {}\n", moviePath.string());
+            return std::nullopt;
+        }
+
+        auto saturn = std::make_unique<Saturn>();
+        saturn->LoadIPL(std::move(ipl));
+
+        // Replays must not alter the backup memory image
+        if (!ApplyHardwareConfig(*saturn, config, true)) {
+            return std::nullopt;
+        }
+
+        // --game overrides the disc the movie was recorded with
+        std::optional<std::filesystem::path> gamePath = config.game_path;
+        if (!gamePath && !movie.gamePath.empty()) {
+            gamePath = std::filesystem::path{movie.gamePath};
+        }
+        if (gamePath && !LoadGameDisc(*saturn, *gamePath, config.shared_preload)) {
+            return std::nullopt;
+        }
+
+        if (auto result = saturn->VDP.UseSoftwareRenderer(); !result) {
+            fmt::print(stderr, "ymir-headless: failed to create software renderer: {}\n", result.Error().message);
+            return std::nullopt;
+        }
+        saturn->VDP.SetFrameSkip(MakeFrameSkip(config.render_interval));
+
+        InputMoviePlayer player{};
+        switch (player.Begin(*saturn, movie)) {
+        case InputMoviePlayer::BeginResult::Success: break;
+        case InputMoviePlayer::BeginResult::InvalidState:
+            fmt::print(stderr, "ymir-headless: input movie save state is unreadable by this build: {}\n",
+                       moviePath.string());
+            return std::nullopt;
+        case InputMoviePlayer::BeginResult::IncompatibleState:
+            fmt::print(stderr, "ymir-headless: input movie save state does not match the loaded disc: {}\n",
+                       moviePath.string());
+            return std::nullopt;
+        }
+
+        using clk = std::chrono::steady_clock;
+        std::vector<double> frameTimesMs{};
+        frameTimesMs.reserve(movie.frames.size());
+        const auto t0 = clk::now();
+        while (!player.IsFinished()) {
+            const auto frameStart = clk::now();
+            saturn->RunFrame();
+            frameTimesMs.push_back(std::chrono::duration<double, std::milli>(clk::now() - frameStart).count());
+            player.EndFrame(*saturn);
+        }
+        const std::chrono::duration<double> elapsed = clk::now() - t0;
+        player.End(*saturn);
+
+        BenchResult result{};
+        result.frames = frameTimesMs.size();
+        for (const double frameTimeMs : frameTimesMs) {
+            result.elapsedSecs += frameTimeMs / 1000.0;
+        }
+        std::sort(frameTimesMs.begin(), frameTimesMs.end());
+        result.p50FrameTimeMs = Percentile(frameTimesMs, 0.50);
+        result.p99FrameTimeMs = Percentile(frameTimesMs, 0.99);
+        result.firstDivergentFrame = player.GetFirstDivergentFrame();
+        result.readMismatches = player.GetReadMismatches();
+        result.memory = MeasureResidentMemory();
+        fmt::print(stderr, "ymir-headless: replayed {} in {:.3f} s\n", moviePath.string(), elapsed.count());
+        return result;
+    }
+
+} // namespace
+
+int RunBench(const HeadlessConfig &config) {
+    const auto moviePaths = CollectMoviePaths(config.bench_movie_paths);
+    if (moviePaths.empty()) {
+        fmt::print(stderr, "ymir-headless: bench requires input movies or directories of {} files\n",
+                   kInputMovieExtension);
+        return 1;
+    }
+
+    const auto ipl = LoadIPLFile(config.ipl_path);
+    if (ipl == nullptr) {
+        return 1;
+    }
+
+    bool failed = false;
+    nlohmann::json movies = nlohmann::json::array();
+    for (const auto &moviePath : moviePaths) {
+        const auto result = BenchMovie(config, ipl, moviePath);
+        if (!result) {
+            failed = true;
+            movies.push_back({{"path", moviePath.string()}, {"error", true}});
+            continue;
+        }
+
+        const double fps = result->elapsedSecs > 0.0 ? result->frames / result->elapsedSecs : 0.0;
+        const std::string status = result->firstDivergentFrame
+                                       ? fmt::format("diverged at frame {}", *result->firstDivergentFrame)
+                                       : std::string{"deterministic"};
+        fmt::print("{}: {} frames, {:.1f} fps, p50 {:.3f} ms, p99 {:.3f} ms, {}\n", moviePath.string(), result->frames,
+                   fps, result->p50FrameTimeMs, result->p99FrameTimeMs, status);
+        if (result->readMismatches > 0) {
+            fmt::print(stderr, "ymir-headless: {} peripheral reads did not match the recording\n",
+                       result->readMismatches);
+        }
+        if (result->memory) {
+            fmt::print("{}: resident memory: {:.1f} MiB private, {:.1f} MiB shared\n", moviePath.string(),
+                       result->memory->privateBytes / 1048576.0, result->memory->sharedBytes / 1048576.0);
+        }
+        failed |= result->firstDivergentFrame.has_value();
+
+        movies.push_back({
+            {"path", moviePath.string()},
+            {"error", false},
+            {"frames", result->frames},
+            {"elapsed_s", result->elapsedSecs},
+            {"fps", fps},
+            {"p50_frame_time_ms", result->p50FrameTimeMs},
+            {"p99_frame_time_ms", result->p99FrameTimeMs},
+            {"first_divergent_frame", result->firstDivergentFrame ? nlohmann::json(*result->firstDivergentFrame)
+                                                                  : nlohmann::json(nullptr)},
+            {"read_mismatches", result->readMismatches},
+            {"private_memory_bytes",
+             result->memory ? nlohmann::json(result->memory->privateBytes) : nlohmann::json(nullptr)},
+            {"shared_memory_bytes",
+             result->memory ? nlohmann::json(result->memory->sharedBytes) : nlohmann::json(nullptr)},
+        });
+    }
+
+    if (config.bench_report_path) {
+        std::ofstream out{*config.bench_report_path};
+        out << nlohmann::json{{"movies", std::move(movies)}}.dump(2) << '\n';
+        if (!out) {
+            fmt::print(stderr, "ymir-headless: failed to write bench report {}\n", config.bench_report_path->string());
+            return 1;
+        }
+    }
+
+    return failed ? 1 : 0;
+}
+
+} // namespace ymir::debug
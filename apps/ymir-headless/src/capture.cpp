@@ -0,0 +1,41 @@
+#include "capture.hpp"
+
+#include <fmt/format.h>
+
+#include <span>
+
+namespace ymir::debug {
+
+bool StartCapture(Saturn &saturn, AVCapture &capture, const HeadlessConfig &config) {
+    saturn.SCSP.SetSampleBlockCallback({&capture, [](std::span<const scsp::OutputSample> samples, void *ctx) {
+                                            static_cast<AVCapture *>(ctx)->ReceiveSamples(samples);
+                                        }});
+    AVCapture::Settings settings{
+        .videoPath = config.capture_video_path,
+        .audioPath = config.capture_audio_path,
+    };
+    if (saturn.GetVideoStandard() == core::config::sys::VideoStandard::PAL) {
+        settings.frameRateNum = 50;
+        settings.frameRateDen = 1;
+    }
+    std::error_code error{};
+    if (!capture.Start(settings, saturn.SCSP.GetOutputSampleCount(), error)) {
+        fmt::print(stderr, "ymir-headless: failed to create capture files: {}\n", error.message());
+        return false;
+    }
+    return true;
+}
+
+bool FinishCapture(Saturn &saturn, AVCapture &capture) {
+    capture.Stop();
+    saturn.SCSP.SetSampleBlockCallback({});
+    const auto stats = capture.GetStats();
+    fmt::print(stderr,
+               "ymir-headless: captured {} video frames ({} duplicated, {} images dropped) and {} audio samples "
+               "({} replaced with silence){}\n",
+               stats.framesWritten, stats.framesDuplicated, stats.framesDropped, stats.samplesWritten,
+               stats.samplesDropped, (stats.writeError ? "; capture file write failed" : ""));
+    return !stats.writeError;
+}
+
+} // namespace ymir::debug
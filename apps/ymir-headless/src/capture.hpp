@@ -0,0 +1,18 @@
+#pragma once
+
+#include "config.hpp"
+
+#include <ymir/debug/av_capture.hpp>
+#include <ymir/sys/saturn.hpp>
+
+namespace ymir::debug {
+
+// Creates the capture files and feeds the system's audio output to the capture. Video frames are delivered by the
+// render callback. Prints any errors.
+bool StartCapture(Saturn &saturn, AVCapture &capture, const HeadlessConfig &config);
+
+// Detaches the capture, finishes the files and prints their statistics. Returns false if the files could not be fully
+// written.
+bool FinishCapture(Saturn &saturn, AVCapture &capture);
+
+} // namespace ymir::debug
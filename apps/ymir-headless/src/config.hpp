@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <optional>
+#include <vector>
 
 namespace ymir::debug {
 
@@ -19,12 +21,109 @@ struct HeadlessConfig {
     // Absent = boot to IPL shell without a game disc.
     std::optional<std::filesystem::path> game_path;
 
-    // Absent = use the standard platform path shared with the SDL3 frontend.
+    // Absent = start with blank internal backup memory that is not persisted.
+    // When set, --frames runs write to the image; bench replays never do.
     // Do NOT run the SDL3 frontend and headless simultaneously with the same
     // BRAM path; no cross-process coordination exists and concurrent writes corrupt.
     std::optional<std::filesystem::path> bram_path;
 
+    // When false, SMPC SSHON commands are ignored and the slave SH-2 never runs.
     bool slave_enabled{true};
+
+    // When set, uncompressed game disc images are preloaded into shared
+    // read-only file mappings instead of being read from the files on
+    // demand, so concurrent processes replaying the same disc keep a single
+    // copy in memory. CLI-only (--shared-preload).
+    bool shared_preload{false};
+
+    // Number of frames to emulate before exiting. Zero = validate the
+    // configuration and exit without booting. CLI-only (--frames).
+    uint64_t frames{0};
+
+    // Frame rendering interval while emulating: 0 = never compose VDP2 frames,
+    // 1 = render every frame, N = render one out of every N frames.
+    // Skipped frames are still fully emulated. CLI-only (--render-interval).
+    uint32_t render_interval{0};
+
+    // Absent = no trace. When set, a binary CPU trace of the --frames run is
+    // written to this path. CLI-only (--trace).
+    std::optional<std::filesystem::path> trace_path;
+
+    // When set, the binary trace at this path is printed as text to stdout and
+    // the process exits without booting. CLI-only (--dump-trace).
+    std::optional<std::filesystem::path> dump_trace_path;
+
+    // Absent = no profiling. When set, CPU program counters are sampled during
+    // the --frames run and written to this path as flame graph collapsed
+    // stacks. CLI-only (--profile).
+    std::optional<std::filesystem::path> profile_path;
+
+    // Sampling interval in system clock cycles. Zero = default interval.
+    // CLI-only (--profile-interval).
+    uint64_t profile_interval{0};
+
+    // Absent = report raw addresses. Symbol map applied to both SH-2 CPUs.
+    // CLI-only (--profile-symbols).
+    std::optional<std::filesystem::path> profile_symbols_path;
+
+    // Absent = no timing report. When set, host time spent on each emulated
+    // component during the --frames run is written to this path as JSON.
+    // Component times are only measured in builds with Ymir_ENABLE_HOST_TIMING.
+    // CLI-only (--timing-report).
+    std::optional<std::filesystem::path> timing_report_path;
+
+    // When set, the full XXH128 hash of every track of game_path is printed to
+    // stdout and the process exits without booting. CLI-only (--hash-disc).
+    bool hash_disc{false};
+
+    // Absent = do not cache disc hashes. Cache file keyed by image path, size
+    // and modification time; defaults to disc-hashes.txt in the standard
+    // config directory when --hash-disc is used. CLI-only (--hash-cache).
+    std::optional<std::filesystem::path> hash_cache_path;
+
+    // Maximum number of disc hashing threads. Zero = all hardware threads.
+    // CLI-only (--hash-threads).
+    uint32_t hash_threads{0};
+
+    // Absent = no input latency measurement. When set, a Control Pad is
+    // connected to port 1 and fed synthetic input during the --frames run;
+    // host-timestamp-to-INTBACK latency histograms for late-latched input and
+    // for input polled once at the start of each frame are written to this
+    // path as JSON. CLI-only (--input-latency-report).
+    std::optional<std::filesystem::path> input_latency_report_path;
+
+    // Rate at which synthetic input samples are published for the input
+    // latency measurement, in Hz. CLI-only (--synthetic-input-hz).
+    uint32_t synthetic_input_hz{1000};
+
+    // Absent = no video capture. When set, the --frames run is captured to
+    // this path as a lossless constant frame rate Y4M video. Forces every
+    // frame to be rendered. CLI-only (--capture-video).
+    std::optional<std::filesystem::path> capture_video_path;
+
+    // Absent = no audio capture. When set, the --frames run is captured to
+    // this path as a 16-bit stereo 44100 Hz WAV file kept in sync with the
+    // video capture. CLI-only (--capture-audio).
+    std::optional<std::filesystem::path> capture_audio_path;
+
+    // Absent = no input movie. When set, the --frames run starts from power
+    // on with synthetic Control Pad input on port 1 and every peripheral read
+    // is recorded to this path as an input movie along with a determinism
+    // hash of each frame. CLI-only (--record-movie).
+    std::optional<std::filesystem::path> record_movie_path;
+
+    // When set, the input movies in bench_movie_paths are replayed as fast as
+    // possible and checked for divergence instead of running --frames.
+    // CLI-only (bench subcommand).
+    bool bench{false};
+
+    // Input movies or directories of .ymov files to replay. CLI-only
+    // (positional arguments of the bench subcommand).
+    std::vector<std::filesystem::path> bench_movie_paths;
+
+    // Absent = no bench report. When set, per-movie benchmark results are
+    // written to this path as JSON. CLI-only (--bench-report).
+    std::optional<std::filesystem::path> bench_report_path;
 };
 
 } // namespace ymir::debug
@@ -5,12 +5,15 @@
 #include <toml++/toml.hpp>
 #include <ymir/debug/util/env.hpp>
 
+#include <charconv>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace ymir::debug {
 
@@ -22,8 +25,30 @@ namespace detail {
         std::optional<std::filesystem::path> bram_path;
         std::optional<std::filesystem::path> config_path;
         std::optional<bool> slave_enabled;
+        bool shared_preload{false};
+        std::optional<uint64_t> frames;
+        std::optional<uint32_t> render_interval;
+        std::optional<std::filesystem::path> trace_path;
+        std::optional<std::filesystem::path> dump_trace_path;
+        std::optional<std::filesystem::path> profile_path;
+        std::optional<uint64_t> profile_interval;
+        std::optional<std::filesystem::path> profile_symbols_path;
+        std::optional<std::filesystem::path> timing_report_path;
+        bool hash_disc{false};
+        std::optional<std::filesystem::path> hash_cache_path;
+        std::optional<uint32_t> hash_threads;
+        std::optional<std::filesystem::path> input_latency_report_path;
+        std::optional<uint32_t> synthetic_input_hz;
+        std::optional<std::filesystem::path> capture_video_path;
+        std::optional<std::filesystem::path> capture_audio_path;
+        std::optional<std::filesystem::path> record_movie_path;
+        bool bench{false};
+        std::vector<std::filesystem::path> bench_movie_paths;
+        std::optional<std::filesystem::path> bench_report_path;
     };
 
+    static constexpr std::string_view kDiscHashCacheName = "disc-hashes.txt";
+
     static constexpr std::string_view kYmirConfigName = "Ymir.toml";
     static constexpr std::string_view kDbgConfigName = "Ymir-dbg.toml";
 
@@ -35,6 +60,7 @@ namespace detail {
 
     /// @brief Parses a minimal subset of CLI flags into a CliConfig struct.
     /// This manual parser is used for the headless worker to avoid SDL/UI dependencies.
+    /// A leading `bench` argument selects the benchmark subcommand, whose positional arguments are input movies.
     inline CliConfig ParseCliConfig(int argc, char *argv[]) {
         CliConfig cli;
         for (int i = 1; i < argc; ++i) {
@@ -44,6 +70,18 @@ namespace detail {
                     out = std::filesystem::path{argv[++i]};
                 }
             };
+            auto readUInt = [&]<typename T>(std::optional<T> &out) {
+                if (i + 1 < argc) {
+                    const std::string_view value{argv[++i]};
+                    T parsed{};
+                    const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+                    if (ec == std::errc{} && ptr == value.data() + value.size()) {
+                        out = parsed;
+                    } else {
+                        std::cerr << "ymir-headless: ignoring invalid value '" << value << "' for " << arg << '\n';
+                    }
+                }
+            };
 
             if (arg == "--ipl") {
                 readPath(cli.ipl_path);
@@ -57,6 +95,46 @@ namespace detail {
                 cli.slave_enabled = true;
             } else if (arg == "--no-slave") {
                 cli.slave_enabled = false;
+            } else if (arg == "--shared-preload") {
+                cli.shared_preload = true;
+            } else if (arg == "--frames") {
+                readUInt(cli.frames);
+            } else if (arg == "--render-interval") {
+                readUInt(cli.render_interval);
+            } else if (arg == "--trace") {
+                readPath(cli.trace_path);
+            } else if (arg == "--dump-trace") {
+                readPath(cli.dump_trace_path);
+            } else if (arg == "--profile") {
+                readPath(cli.profile_path);
+            } else if (arg == "--profile-interval") {
+                readUInt(cli.profile_interval);
+            } else if (arg == "--profile-symbols") {
+                readPath(cli.profile_symbols_path);
+            } else if (arg == "--timing-report") {
+                readPath(cli.timing_report_path);
+            } else if (arg == "--hash-disc") {
+                cli.hash_disc = true;
+            } else if (arg == "--hash-cache") {
+                readPath(cli.hash_cache_path);
+            } else if (arg == "--hash-threads") {
+                readUInt(cli.hash_threads);
+            } else if (arg == "--input-latency-report") {
+                readPath(cli.input_latency_report_path);
+            } else if (arg == "--synthetic-input-hz") {
+                readUInt(cli.synthetic_input_hz);
+            } else if (arg == "--capture-video") {
+                readPath(cli.capture_video_path);
+            } else if (arg == "--capture-audio") {
+                readPath(cli.capture_audio_path);
+            } else if (arg == "--record-movie") {
+                readPath(cli.record_movie_path);
+            } else if (arg == "--bench-report") {
+                readPath(cli.bench_report_path);
+            } else if (i == 1 && arg == "bench") {
+                cli.bench = true;
+            } else if (cli.bench && !arg.starts_with("--")) {
+                cli.bench_movie_paths.emplace_back(arg);
             }
         }
         return cli;
@@ -180,6 +258,62 @@ namespace detail {
         if (cli.slave_enabled) {
             config.slave_enabled = *cli.slave_enabled;
         }
+        config.shared_preload = cli.shared_preload;
+        if (cli.frames) {
+            config.frames = *cli.frames;
+        }
+        if (cli.render_interval) {
+            config.render_interval = *cli.render_interval;
+        }
+        if (cli.trace_path) {
+            config.trace_path = cli.trace_path;
+        }
+        if (cli.dump_trace_path) {
+            config.dump_trace_path = cli.dump_trace_path;
+        }
+        if (cli.profile_path) {
+            config.profile_path = cli.profile_path;
+        }
+        if (cli.profile_interval) {
+            config.profile_interval = *cli.profile_interval;
+        }
+        if (cli.profile_symbols_path) {
+            config.profile_symbols_path = cli.profile_symbols_path;
+        }
+        if (cli.timing_report_path) {
+            config.timing_report_path = cli.timing_report_path;
+        }
+        config.hash_disc = cli.hash_disc;
+        if (cli.hash_cache_path) {
+            config.hash_cache_path = cli.hash_cache_path;
+        } else if (cli.hash_disc) {
+            if (auto dir = GetStandardConfigDir()) {
+                config.hash_cache_path = *dir / kDiscHashCacheName;
+            }
+        }
+        if (cli.hash_threads) {
+            config.hash_threads = *cli.hash_threads;
+        }
+        if (cli.input_latency_report_path) {
+            config.input_latency_report_path = cli.input_latency_report_path;
+        }
+        if (cli.synthetic_input_hz && *cli.synthetic_input_hz > 0) {
+            config.synthetic_input_hz = *cli.synthetic_input_hz;
+        }
+        if (cli.capture_video_path) {
+            config.capture_video_path = cli.capture_video_path;
+        }
+        if (cli.capture_audio_path) {
+            config.capture_audio_path = cli.capture_audio_path;
+        }
+        if (cli.record_movie_path) {
+            config.record_movie_path = cli.record_movie_path;
+        }
+        config.bench = cli.bench;
+        config.bench_movie_paths = cli.bench_movie_paths;
+        if (cli.bench_report_path) {
+            config.bench_report_path = cli.bench_report_path;
+        }
     }
 
     /// @brief Saves the debug-specific subset of configuration to a file.
@@ -0,0 +1,69 @@
+#include "runner.hpp"
+
+#include <ymir/media/disc_hash.hpp>
+#include <ymir/media/loader/loader.hpp>
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <string>
+
+namespace ymir::debug {
+
+int HashDisc(const HeadlessConfig &config) {
+    if (!config.game_path) {
+        fmt::print(stderr, "ymir-headless: --hash-disc requires a game disc; provide --game\n");
+        return 1;
+    }
+    const std::filesystem::path &path = *config.game_path;
+
+    media::DiscHashCache cache{};
+    if (config.hash_cache_path) {
+        std::error_code error{};
+        if (!cache.Load(*config.hash_cache_path, error)) {
+            fmt::print(stderr, "ymir-headless: ignoring unreadable disc hash cache {}: {}\n",
+                       config.hash_cache_path->string(), error.message());
+        }
+        if (auto hash = cache.Find(path)) {
+            fmt::print("{}  {}\n", ToString(*hash), path.string());
+            return 0;
+        }
+    }
+
+    using clk = std::chrono::steady_clock;
+    const auto t0 = clk::now();
+
+    // Memory-mapped images are hashed without copying; see media::CalcDiscImageHash
+    media::Disc disc{};
+    if (!media::LoadDisc(path, disc, false, [](media::MessageType, std::string message) {
+            fmt::print(stderr, "ymir-headless: {}\n", message);
+        })) {
+        fmt::print(stderr, "ymir-headless: failed to load game disc: {}\n", path.string());
+        return 1;
+    }
+    const auto hash = media::CalcDiscImageHash(disc, config.hash_threads);
+    if (!hash) {
+        fmt::print(stderr, "ymir-headless: failed to read game disc: {}\n", path.string());
+        return 1;
+    }
+
+    const std::chrono::duration<double> elapsed = clk::now() - t0;
+    fmt::print(stderr, "ymir-headless: hashed disc in {:.3f} s\n", elapsed.count());
+    fmt::print("{}  {}\n", ToString(*hash), path.string());
+
+    if (config.hash_cache_path) {
+        cache.Store(path, *hash, disc.imageFiles);
+        std::error_code error{};
+        if (const auto parentPath = config.hash_cache_path->parent_path(); !parentPath.empty()) {
+            std::filesystem::create_directories(parentPath, error);
+        }
+        if (!cache.Save(*config.hash_cache_path, error)) {
+            fmt::print(stderr, "ymir-headless: failed to write disc hash cache {}: {}\n",
+                       config.hash_cache_path->string(), error.message());
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ymir::debug
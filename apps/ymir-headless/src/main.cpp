@@ -1,9 +1,16 @@
 #include "config_parser.hpp"
+#include "runner.hpp"
 
 #include <fmt/format.h>
 
 int main(int argc, char **argv) {
     auto config = ymir::debug::LoadConfig(argc, argv);
+    if (config.dump_trace_path) {
+        return ymir::debug::DumpTrace(*config.dump_trace_path);
+    }
+    if (config.hash_disc) {
+        return ymir::debug::HashDisc(config);
+    }
     if (!ymir::debug::ValidateConfig(config)) {
         return 1;
     }
@@ -18,5 +25,12 @@ int main(int argc, char **argv) {
     fmt::print(stderr, "ymir-headless: slave: {}\n",
                config.slave_enabled ? "enabled" : "disabled");
 
+    if (config.bench) {
+        return ymir::debug::RunBench(config);
+    }
+    if (config.frames > 0) {
+        return ymir::debug::RunHeadless(config);
+    }
+
     return 0;
 }
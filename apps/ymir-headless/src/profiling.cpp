@@ -0,0 +1,92 @@
+#include "profiling.hpp"
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <fstream>
+#include <memory>
+
+namespace ymir::debug {
+
+namespace {
+
+    nlohmann::json MakeTimingReport(const HostTimingReport &totals, double elapsedSecs) {
+        const double frames = static_cast<double>(totals.frames);
+        nlohmann::json components = nlohmann::json::array();
+        for (size_t i = 0; i < kNumHostTimingComponents; ++i) {
+            const double totalMs = totals.componentTimeMs[i];
+            components.push_back({
+                {"name", GetHostTimingComponentName(static_cast<HostTimingComponent>(i))},
+                {"total_ms", totalMs},
+                {"avg_ms", frames > 0 ? totalMs / frames : 0.0},
+                {"max_ms", totals.maxComponentTimeMs[i]},
+                {"frame_share", totals.frameTimeMs > 0.0 ? totalMs / totals.frameTimeMs : 0.0},
+            });
+        }
+        return {
+            {"instrumented", static_cast<bool>(Ymir_HOST_TIMING)},
+            {"frames", totals.frames},
+            {"elapsed_s", elapsedSecs},
+            {"frame_time_ms",
+             {
+                 {"total", totals.frameTimeMs},
+                 {"avg", frames > 0 ? totals.frameTimeMs / frames : 0.0},
+                 {"max", totals.maxFrameTimeMs},
+             }},
+            {"components", std::move(components)},
+        };
+    }
+
+} // namespace
+
+bool ConfigureSampler(PCSampler &sampler, const HeadlessConfig &config) {
+    if (config.profile_interval > 0) {
+        sampler.SetInterval(config.profile_interval);
+    }
+    if (config.profile_symbols_path) {
+        auto symbols = std::make_shared<SymbolMap>();
+        std::error_code error{};
+        if (!symbols->Load(*config.profile_symbols_path, error)) {
+            fmt::print(stderr, "ymir-headless: failed to read symbol map {}: {}\n",
+                       config.profile_symbols_path->string(), error.message());
+            return false;
+        }
+        sampler.SetSymbolMap(ProfiledCPU::MasterSH2, symbols);
+        sampler.SetSymbolMap(ProfiledCPU::SlaveSH2, symbols);
+    }
+    return true;
+}
+
+bool WriteProfile(const PCSampler &sampler, const std::filesystem::path &path) {
+    std::ofstream out{path};
+    sampler.WriteCollapsedStacks(out);
+    if (!out) {
+        fmt::print(stderr, "ymir-headless: failed to write profile {}\n", path.string());
+        return false;
+    }
+    for (size_t i = 0; i < kNumProfiledCPUs; ++i) {
+        const auto cpu = static_cast<ProfiledCPU>(i);
+        const uint64 total = sampler.GetTotalSamples(cpu);
+        if (total == 0) {
+            continue;
+        }
+        fmt::print(stderr, "ymir-headless: {} hot spots ({} samples):\n", GetProfiledCPUName(cpu), total);
+        for (const auto &hotSpot : sampler.GetHotSpots(cpu, true, 10)) {
+            fmt::print(stderr, "  {:6.2f}%  {:08X}  {}\n", hotSpot.samples * 100.0 / total, hotSpot.address,
+                       hotSpot.name);
+        }
+    }
+    return true;
+}
+
+bool WriteTimingReport(const HostTimingStats &stats, double elapsedSecs, const std::filesystem::path &path) {
+    std::ofstream out{path};
+    out << MakeTimingReport(stats.GetTotals(), elapsedSecs).dump(2) << '\n';
+    if (!out) {
+        fmt::print(stderr, "ymir-headless: failed to write timing report {}\n", path.string());
+        return false;
+    }
+    return true;
+}
+
+} // namespace ymir::debug
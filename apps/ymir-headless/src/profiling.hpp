@@ -0,0 +1,21 @@
+#pragma once
+
+#include "config.hpp"
+
+#include <ymir/debug/host_timing.hpp>
+#include <ymir/debug/pc_sampler.hpp>
+
+#include <filesystem>
+
+namespace ymir::debug {
+
+// Applies the sampling interval and symbol map options to the sampler. Prints any errors.
+bool ConfigureSampler(PCSampler &sampler, const HeadlessConfig &config);
+
+// Writes the samples as flame graph collapsed stacks and prints the hottest addresses of each CPU. Prints any errors.
+bool WriteProfile(const PCSampler &sampler, const std::filesystem::path &path);
+
+// Writes the accumulated host timings as a JSON report. Prints any errors.
+bool WriteTimingReport(const HostTimingStats &stats, double elapsedSecs, const std::filesystem::path &path);
+
+} // namespace ymir::debug
@@ -0,0 +1,197 @@
+#include "runner.hpp"
+
+#include "capture.hpp"
+#include "profiling.hpp"
+#include "synthetic_input.hpp"
+#include "system.hpp"
+#include "tracing.hpp"
+
+#include <ymir/debug/input_movie.hpp>
+#include <ymir/sys/saturn.hpp>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace ymir::debug {
+
+int RunHeadless(const HeadlessConfig &config) {
+    auto ipl = LoadIPLFile(config.ipl_path);
+    if (ipl == nullptr) {
+        return 1;
+    }
+
+    auto saturn = std::make_unique<Saturn>();
+    saturn->LoadIPL(std::move(ipl));
+
+    if (!ApplyHardwareConfig(*saturn, config, false)) {
+        return 1;
+    }
+
+    if (config.game_path && !LoadGameDisc(*saturn, *config.game_path, config.shared_preload)) {
+        return 1;
+    }
+
+    uint32_t renderInterval = config.render_interval;
+    if (config.capture_video_path) {
+        // Render every frame on the emulator thread so that each image is captured along with the frame it belongs to
+        renderInterval = 1;
+        saturn->configuration.swRenderer.threadedVDP2 = false;
+    }
+
+    if (auto result = saturn->VDP.UseSoftwareRenderer(); !result) {
+        fmt::print(stderr, "ymir-headless: failed to create software renderer: {}\n", result.Error().message);
+        return 1;
+    }
+
+    std::unique_ptr<AVCapture> capture;
+    if (config.capture_video_path || config.capture_audio_path) {
+        capture = std::make_unique<AVCapture>();
+    }
+
+    struct RenderContext {
+        uint64_t renderedFrames = 0;
+        AVCapture *capture = nullptr;
+    } renderContext{.capture = capture.get()};
+    saturn->VDP.SetSoftwareRenderCallback({&renderContext, [](uint32 *fb, uint32 width, uint32 height, void *ctx) {
+                                               auto &renderCtx = *static_cast<RenderContext *>(ctx);
+                                               ++renderCtx.renderedFrames;
+                                               if (renderCtx.capture != nullptr) {
+                                                   renderCtx.capture->ReceiveFrame(fb, width, height);
+                                               }
+                                           }});
+    saturn->VDP.SetFrameSkip(MakeFrameSkip(renderInterval));
+
+    std::unique_ptr<trace::TraceRecorder> recorder;
+    if (config.trace_path) {
+        recorder = std::make_unique<trace::TraceRecorder>();
+        if (!StartTrace(*saturn, *recorder, *config.trace_path)) {
+            return 1;
+        }
+    }
+
+    std::unique_ptr<PCSampler> sampler;
+    if (config.profile_path) {
+        sampler = std::make_unique<PCSampler>();
+        if (!ConfigureSampler(*sampler, config)) {
+            return 1;
+        }
+        saturn->UsePCSampler(sampler.get());
+    }
+
+    std::unique_ptr<HostTimingStats> timingStats;
+    if (config.timing_report_path) {
+        if constexpr (!Ymir_HOST_TIMING) {
+            fmt::print(stderr, "ymir-headless: host timing instrumentation is not compiled in; component times will "
+                               "be reported as zero\n");
+        }
+        timingStats = std::make_unique<HostTimingStats>();
+        timingStats->EndFrame(); // establish the baseline
+        saturn->UseHostTimingStats(timingStats.get());
+    }
+
+    std::unique_ptr<SyntheticInputProbe> inputProbe;
+    if (config.input_latency_report_path || config.record_movie_path) {
+        inputProbe = std::make_unique<SyntheticInputProbe>(config.synthetic_input_hz);
+        inputProbe->Connect(*saturn);
+    }
+
+    std::unique_ptr<InputMovieRecorder> movieRecorder;
+    if (config.record_movie_path) {
+        std::string gamePath{};
+        if (config.game_path) {
+            std::error_code error{};
+            gamePath = std::filesystem::absolute(*config.game_path, error).string();
+        }
+        movieRecorder = std::make_unique<InputMovieRecorder>();
+        movieRecorder->Begin(*saturn, true, std::move(gamePath));
+        inputProbe->RecordTo(movieRecorder.get());
+    }
+
+    if (capture && !StartCapture(*saturn, *capture, config)) {
+        return 1;
+    }
+
+    using clk = std::chrono::steady_clock;
+    const auto t0 = clk::now();
+    for (uint64_t frame = 0; frame < config.frames; ++frame) {
+        if (recorder) {
+            recorder->MarkFrame(frame);
+        }
+        if (inputProbe) {
+            inputProbe->BeginFrame();
+        }
+        saturn->RunFrame();
+        if (capture) {
+            capture->MarkFrame(saturn->SCSP.GetOutputSampleCount());
+        }
+        if (movieRecorder) {
+            movieRecorder->EndFrame(*saturn);
+        }
+        if (sampler) {
+            sampler->Aggregate();
+        }
+    }
+    const std::chrono::duration<double> elapsed = clk::now() - t0;
+
+    if (sampler) {
+        saturn->UsePCSampler(nullptr);
+        if (!WriteProfile(*sampler, *config.profile_path)) {
+            return 1;
+        }
+    }
+
+    if (timingStats) {
+        saturn->UseHostTimingStats(nullptr);
+        if (!WriteTimingReport(*timingStats, elapsed.count(), *config.timing_report_path)) {
+            return 1;
+        }
+    }
+
+    if (movieRecorder) {
+        const InputMovie &movie = movieRecorder->GetMovie();
+        std::error_code error{};
+        if (!WriteInputMovie(*config.record_movie_path, movie, error)) {
+            fmt::print(stderr, "ymir-headless: failed to write input movie {}: {}\n",
+                       config.record_movie_path->string(), error.message());
+            return 1;
+        }
+        fmt::print(stderr, "ymir-headless: recorded {} frames and {} peripheral reads to {}\n", movie.frames.size(),
+                   movie.reports.size(), config.record_movie_path->string());
+    }
+
+    nlohmann::json latencyReport{};
+    if (inputProbe) {
+        saturn->SMPC.GetPeripheralPort1().DisconnectPeripherals();
+        latencyReport = inputProbe->MakeReport();
+        inputProbe.reset();
+    }
+
+    if (config.input_latency_report_path &&
+        !WriteInputLatencyReport(latencyReport, *config.input_latency_report_path)) {
+        return 1;
+    }
+
+    if (recorder && !FinishTrace(*saturn, *recorder)) {
+        return 1;
+    }
+
+    if (capture && !FinishCapture(*saturn, *capture)) {
+        return 1;
+    }
+
+    const double secs = elapsed.count();
+    fmt::print(stderr, "ymir-headless: emulated {} frames ({} rendered) in {:.3f} s ({:.1f} fps)\n", config.frames,
+               renderContext.renderedFrames, secs, secs > 0.0 ? config.frames / secs : 0.0);
+    if (const auto memory = MeasureResidentMemory()) {
+        fmt::print(stderr, "ymir-headless: resident memory: {:.1f} MiB private, {:.1f} MiB shared\n",
+                   memory->privateBytes / 1048576.0, memory->sharedBytes / 1048576.0);
+    }
+
+    return 0;
+}
+
+} // namespace ymir::debug
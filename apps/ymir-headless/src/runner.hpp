@@ -0,0 +1,37 @@
+#pragma once
+
+#include "config.hpp"
+
+#include <filesystem>
+
+namespace ymir::debug {
+
+// Boots a Saturn instance from a validated HeadlessConfig and emulates
+// config.frames frames as fast as possible, applying the configured render
+// interval, slave SH-2 switch and backup memory image. Records a binary CPU trace if config.trace_path is set and a
+// sampling CPU profile if config.profile_path is set. Writes a JSON host
+// timing report if config.timing_report_path is set. Captures video and
+// audio if config.capture_video_path or config.capture_audio_path are set.
+// Records an input movie from power on with synthetic input if
+// config.record_movie_path is set.
+// Prints a throughput summary to stderr.
+// Returns the process exit code.
+int RunHeadless(const HeadlessConfig &config);
+
+// Replays every input movie in config.bench_movie_paths on a fresh Saturn
+// instance, printing frames per second, p50/p99 frame times and the first
+// diverging frame of each movie to stdout. Writes a JSON report if
+// config.bench_report_path is set. Fails if any movie diverges.
+// Returns the process exit code.
+int RunBench(const HeadlessConfig &config);
+
+// Prints every record of a binary trace file to stdout as text.
+// Returns the process exit code.
+int DumpTrace(const std::filesystem::path &path);
+
+// Prints the full image hash of config.game_path to stdout, reusing and
+// updating the hash cache at config.hash_cache_path if set.
+// Returns the process exit code.
+int HashDisc(const HeadlessConfig &config);
+
+} // namespace ymir::debug
@@ -0,0 +1,119 @@
+#include "synthetic_input.hpp"
+
+#include <ymir/util/thread_name.hpp>
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <fstream>
+
+namespace ymir::debug {
+
+namespace {
+
+    uint64 HostTimestampNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    nlohmann::json MakeHistogramReport(const InputLatencyReport &report) {
+        auto toUs = [](double ns) { return ns / 1000.0; };
+        nlohmann::json buckets = nlohmann::json::array();
+        for (size_t i = 0; i < report.buckets.size(); ++i) {
+            if (report.buckets[i] == 0) {
+                continue;
+            }
+            const uint64 upperBound = GetInputLatencyBucketUpperBoundNs(i);
+            nlohmann::json bucket = {{"count", report.buckets[i]}};
+            bucket["below_us"] = upperBound != ~0ull ? nlohmann::json(toUs(upperBound)) : nlohmann::json(nullptr);
+            buckets.push_back(std::move(bucket));
+        }
+        return {
+            {"reads", report.count},
+            {"mean_us", toUs(report.MeanNs())},
+            {"min_us", toUs(report.minNs)},
+            {"max_us", toUs(report.maxNs)},
+            {"p50_us", toUs(report.PercentileNs(0.50))},
+            {"p95_us", toUs(report.PercentileNs(0.95))},
+            {"p99_us", toUs(report.PercentileNs(0.99))},
+            {"buckets", std::move(buckets)},
+        };
+    }
+
+} // namespace
+
+SyntheticInputProbe::SyntheticInputProbe(uint32_t rateHz)
+    : m_rateHz(rateHz) {
+    m_producer = std::jthread{[this](std::stop_token stopToken) {
+        util::SetCurrentThreadName("Synthetic input");
+        Produce(stopToken);
+    }};
+}
+
+void SyntheticInputProbe::Connect(Saturn &saturn) {
+    auto &port = saturn.SMPC.GetPeripheralPort1();
+    port.SetPeripheralReportCallback({this, [](peripheral::PeripheralReport &report, void *ctx) {
+                                          static_cast<SyntheticInputProbe *>(ctx)->Read(report);
+                                      }});
+    port.ConnectControlPad();
+}
+
+nlohmann::json SyntheticInputProbe::MakeReport() const {
+    return {
+        {"synthetic_input_hz", m_rateHz},
+        {"late_latch", MakeHistogramReport(m_lateLatency.GetReport())},
+        {"frame_start", MakeHistogramReport(m_frameLatency.GetReport())},
+    };
+}
+
+void SyntheticInputProbe::Produce(std::stop_token stopToken) {
+    const auto period = std::chrono::nanoseconds{1'000'000'000 / m_rateHz};
+    auto next = std::chrono::steady_clock::now();
+    peripheral::PeripheralReport report{.type = peripheral::PeripheralType::ControlPad};
+    report.report.controlPad.buttons = peripheral::Button::Default;
+    while (!stopToken.stop_requested()) {
+        // Alternate pressing and releasing A so that every sample differs from the previous one
+        report.report.controlPad.buttons ^= peripheral::Button::A;
+        m_latch.Publish(report, HostTimestampNs());
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+}
+
+void SyntheticInputProbe::Read(peripheral::PeripheralReport &report) {
+    const uint64 now = HostTimestampNs();
+    if (m_hasFrameSample) {
+        m_frameLatency.Record(now - m_frameTimestamp);
+    }
+
+    peripheral::PeripheralReport latched{};
+    uint64 timestamp = 0;
+    if (m_latch.Latch(latched, timestamp) && latched.type == report.type) {
+        report.report = latched.report;
+        m_lateLatency.Record(now - timestamp);
+    }
+
+    if (m_movieRecorder != nullptr) {
+        m_movieRecorder->RecordRead(0, report);
+    }
+}
+
+bool WriteInputLatencyReport(const nlohmann::json &report, const std::filesystem::path &path) {
+    std::ofstream out{path};
+    out << report.dump(2) << '\n';
+    if (!out) {
+        fmt::print(stderr, "ymir-headless: failed to write input latency report {}\n", path.string());
+        return false;
+    }
+    const auto &late = report["late_latch"];
+    const auto &frameStart = report["frame_start"];
+    fmt::print(stderr,
+               "ymir-headless: input latency over {} reads: late latch p50 {:.1f} us, p99 {:.1f} us; "
+               "frame start p50 {:.1f} us, p99 {:.1f} us\n",
+               late["reads"].get<uint64>(), late["p50_us"].get<double>(), late["p99_us"].get<double>(),
+               frameStart["p50_us"].get<double>(), frameStart["p99_us"].get<double>());
+    return true;
+}
+
+} // namespace ymir::debug
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <ymir/debug/input_latency.hpp>
+#include <ymir/debug/input_movie.hpp>
+#include <ymir/hw/smpc/peripheral/peripheral_latch.hpp>
+#include <ymir/sys/saturn.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <stop_token>
+#include <thread>
+
+namespace ymir::debug {
+
+// Feeds synthetic Control Pad input to port 1 and measures how old the inputs are when INTBACK reads them.
+//
+// A producer thread stands in for the frontend's input handling, publishing a freshly timestamped report at a fixed
+// rate. Every peripheral read records two latencies:
+// - "late_latch": the freshest published sample, latched at the moment INTBACK reads the port
+// - "frame_start": the sample latched at the start of the frame, which is what a frontend polling its inputs once
+//   per frame would hand over
+//
+// The reports delivered to the port can also be recorded into an input movie.
+class SyntheticInputProbe {
+public:
+    explicit SyntheticInputProbe(uint32_t rateHz);
+
+    void Connect(Saturn &saturn);
+
+    void RecordTo(InputMovieRecorder *movieRecorder) {
+        m_movieRecorder = movieRecorder;
+    }
+
+    void BeginFrame() {
+        m_hasFrameSample = m_latch.Latch(m_frameSample, m_frameTimestamp);
+    }
+
+    nlohmann::json MakeReport() const;
+
+private:
+    void Produce(std::stop_token stopToken);
+    void Read(peripheral::PeripheralReport &report);
+
+    const uint32_t m_rateHz;
+
+    peripheral::PeripheralLatch m_latch;
+
+    // Emulator thread state
+    peripheral::PeripheralReport m_frameSample{};
+    uint64 m_frameTimestamp = 0;
+    bool m_hasFrameSample = false;
+    InputLatencyHistogram m_lateLatency;
+    InputLatencyHistogram m_frameLatency;
+    InputMovieRecorder *m_movieRecorder = nullptr;
+
+    // Declared last so that the thread stops before the latch is destroyed
+    std::jthread m_producer;
+};
+
+// Writes a report made by SyntheticInputProbe::MakeReport to a JSON file and prints a summary. Prints any errors.
+bool WriteInputLatencyReport(const nlohmann::json &report, const std::filesystem::path &path);
+
+} // namespace ymir::debug
@@ -0,0 +1,94 @@
+#include "system.hpp"
+
+#include <ymir/media/loader/loader.hpp>
+#include <ymir/sys/shared_rom_pool.hpp>
+
+#include <fmt/format.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace ymir::debug {
+
+static sys::SharedROMPool g_romPool{};
+
+std::shared_ptr<const util::SharedMemory> LoadIPLFile(const std::filesystem::path &path) {
+    std::error_code error{};
+    auto ipl = g_romPool.AcquireFile(path, error);
+    if (ipl == nullptr) {
+        fmt::print(stderr, "ymir-headless: failed to read IPL ROM: {}: {}\n", path.string(), error.message());
+        return nullptr;
+    }
+    if (ipl->Size() != sys::kIPLSize) {
+        fmt::print(stderr, "ymir-headless: invalid IPL ROM size: {} bytes (expected {} bytes)\n", ipl->Size(),
+                   sys::kIPLSize);
+        return nullptr;
+    }
+    return ipl;
+}
+
+bool LoadGameDisc(Saturn &saturn, const std::filesystem::path &path, bool sharedPreload) {
+    media::Disc disc{};
+    if (!media::LoadDisc(
+            path, disc, sharedPreload,
+            [](media::MessageType, std::string message) { fmt::print(stderr, "ymir-headless: {}\n", message); },
+            sharedPreload)) {
+        fmt::print(stderr, "ymir-headless: failed to load game disc: {}\n", path.string());
+        return false;
+    }
+    saturn.LoadDisc(std::move(disc));
+    return true;
+}
+
+bool ApplyHardwareConfig(Saturn &saturn, const HeadlessConfig &config, bool copyOnWrite) {
+    saturn.configuration.system.slaveSH2Enabled = config.slave_enabled;
+
+    if (config.bram_path) {
+        std::error_code error{};
+        saturn.LoadInternalBackupMemoryImage(*config.bram_path, copyOnWrite, error);
+        if (error) {
+            fmt::print(stderr, "ymir-headless: failed to load internal backup memory image {}: {}\n",
+                       config.bram_path->string(), error.message());
+            return false;
+        }
+    }
+    return true;
+}
+
+std::optional<ResidentMemory> MeasureResidentMemory() {
+#ifdef __linux__
+    std::ifstream in{"/proc/self/status"};
+    std::optional<uint64> anon, file, shmem;
+    std::string line;
+    while (std::getline(in, line)) {
+        // Lines look like "RssAnon:    123456 kB"
+        auto readKB = [&](std::string_view key, std::optional<uint64> &out) {
+            if (line.starts_with(key)) {
+                out = std::strtoull(line.c_str() + key.size(), nullptr, 10);
+            }
+        };
+        readKB("RssAnon:", anon);
+        readKB("RssFile:", file);
+        readKB("RssShmem:", shmem);
+    }
+    if (!anon || !file || !shmem) {
+        return std::nullopt;
+    }
+    return ResidentMemory{.privateBytes = *anon * 1024, .sharedBytes = (*file + *shmem) * 1024};
+#else
+    return std::nullopt;
+#endif
+}
+
+vdp::config::FrameSkip MakeFrameSkip(uint32_t renderInterval) {
+    using Mode = vdp::config::FrameSkip::Mode;
+    switch (renderInterval) {
+    case 0: return {.mode = Mode::OnRequest}; // nothing ever requests a frame
+    case 1: return {.mode = Mode::Off};
+    default: return {.mode = Mode::Interval, .interval = renderInterval};
+    }
+}
+
+} // namespace ymir::debug
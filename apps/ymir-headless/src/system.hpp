@@ -0,0 +1,40 @@
+#pragma once
+
+#include "config.hpp"
+
+#include <ymir/sys/saturn.hpp>
+#include <ymir/util/shared_memory.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+
+namespace ymir::debug {
+
+// Maps and validates the IPL ROM, printing any errors. The mapping is acquired from a process-wide pool of shared
+// ROM images, so every system that loads the same IPL ROM contents uses the same copy.
+std::shared_ptr<const util::SharedMemory> LoadIPLFile(const std::filesystem::path &path);
+
+// Loads a game disc into the system, printing any errors. With sharedPreload set, uncompressed images are preloaded
+// into shared read-only file mappings; otherwise the disc is read from its files on demand.
+bool LoadGameDisc(Saturn &saturn, const std::filesystem::path &path, bool sharedPreload);
+
+// Applies the hardware options of the configuration to a freshly created system: the slave SH-2 switch and the
+// internal backup memory image. With copyOnWrite set, writes to backup memory are not persisted to the image.
+// Prints any errors.
+bool ApplyHardwareConfig(Saturn &saturn, const HeadlessConfig &config, bool copyOnWrite);
+
+// Resident memory of this process. Shared memory includes file mappings such as the IPL ROM and shared disc preloads,
+// which other processes mapping the same files do not duplicate.
+struct ResidentMemory {
+    uint64 privateBytes = 0;
+    uint64 sharedBytes = 0;
+};
+
+// Measures the resident memory of this process. Returns std::nullopt if the platform does not report it.
+std::optional<ResidentMemory> MeasureResidentMemory();
+
+// Translates a --render-interval value into a frame skipping policy.
+vdp::config::FrameSkip MakeFrameSkip(uint32_t renderInterval);
+
+} // namespace ymir::debug
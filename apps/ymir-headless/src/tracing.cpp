@@ -0,0 +1,56 @@
+#include "tracing.hpp"
+
+#include "runner.hpp"
+
+#include <ymir/debug/trace_reader.hpp>
+
+#include <fmt/format.h>
+
+namespace ymir::debug {
+
+bool StartTrace(Saturn &saturn, trace::TraceRecorder &recorder, const std::filesystem::path &path) {
+    std::error_code error{};
+    if (!recorder.Start(path, error)) {
+        fmt::print(stderr, "ymir-headless: failed to create trace file {}: {}\n", path.string(), error.message());
+        return false;
+    }
+    saturn.EnableDebugTracing(true);
+    saturn.UseTraceRecorder(&recorder);
+    return true;
+}
+
+bool FinishTrace(Saturn &saturn, trace::TraceRecorder &recorder) {
+    saturn.UseTraceRecorder(nullptr);
+    saturn.EnableDebugTracing(false);
+    recorder.Stop();
+    const auto stats = recorder.GetStats();
+    fmt::print(stderr, "ymir-headless: traced {} records in {} chunks ({} -> {} bytes){}\n", stats.records,
+               stats.chunks, stats.rawBytes, stats.compressedBytes,
+               (stats.writeError ? "; trace file write failed" : ""));
+    return !stats.writeError;
+}
+
+int DumpTrace(const std::filesystem::path &path) {
+    trace::TraceReader reader{};
+    std::error_code error{};
+    trace::ReadResult result = reader.Open(path, error);
+    if (result == trace::ReadResult::Success) {
+        result = reader.ReadAll(
+            [](const trace::RecordView &record) { fmt::print("{}\n", trace::FormatRecord(record)); }, error);
+    }
+
+    switch (result) {
+    case trace::ReadResult::Success: return 0;
+    case trace::ReadResult::FilesystemError:
+        fmt::print(stderr, "ymir-headless: failed to read trace file {}: {}\n", path.string(), error.message());
+        break;
+    case trace::ReadResult::InvalidFormat: fmt::print(stderr, "ymir-headless: not a trace file\n"); break;
+    case trace::ReadResult::VersionMismatch: fmt::print(stderr, "ymir-headless: unsupported trace version\n"); break;
+    case trace::ReadResult::Truncated: fmt::print(stderr, "ymir-headless: trace file is truncated\n"); break;
+    case trace::ReadResult::CorruptChunk: fmt::print(stderr, "ymir-headless: trace file is corrupt\n"); break;
+    default: break;
+    }
+    return 1;
+}
+
+} // namespace ymir::debug
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <ymir/debug/trace_recorder.hpp>
+#include <ymir/sys/saturn.hpp>
+
+#include <filesystem>
+
+namespace ymir::debug {
+
+// Creates the trace file and attaches the recorder to every traced component. Prints any errors.
+bool StartTrace(Saturn &saturn, trace::TraceRecorder &recorder, const std::filesystem::path &path);
+
+// Detaches the recorder, finishes the trace file and prints its statistics. Returns false if the file could not be
+// fully written.
+bool FinishTrace(Saturn &saturn, trace::TraceRecorder &recorder);
+
+} // namespace ymir::debug
@@ -12,6 +12,7 @@ int main(int argc, char **argv) {
     // runSH2PerfSandbox();
     // runDiscInfoExtractor(argc, argv);
     // runDeadlockTest(argc, argv);
+    // runMemoryTLBSandbox();
     runHostCDSandbox();
 
     return EXIT_SUCCESS;
@@ -0,0 +1,141 @@
+#include <ymir/sys/saturn.hpp>
+
+#include <ymir/util/process.hpp>
+
+#include <ymir/core/types.hpp>
+
+#include <fmt/format.h>
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+// Counts data TLB read misses on the calling thread where supported
+class DTLBMissCounter {
+public:
+    DTLBMissCounter() {
+#ifdef __linux__
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        m_fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~DTLBMissCounter() {
+#ifdef __linux__
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+#endif
+    }
+
+    void Start() {
+#ifdef __linux__
+        if (m_fd >= 0) {
+            ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    std::optional<uint64> Stop() {
+#ifdef __linux__
+        if (m_fd >= 0) {
+            ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+            uint64 count = 0;
+            if (read(m_fd, &count, sizeof(count)) == sizeof(count)) {
+                return count;
+            }
+        }
+#endif
+        return std::nullopt;
+    }
+
+private:
+    int m_fd = -1;
+};
+
+std::string_view BackingName(util::VirtualMemory::Backing backing) {
+    switch (backing) {
+    case util::VirtualMemory::Backing::Regular: return "regular pages";
+    case util::VirtualMemory::Backing::TransparentHuge: return "transparent huge pages";
+    case util::VirtualMemory::Backing::Huge: return "huge pages";
+    default: return "unknown";
+    }
+}
+
+constexpr std::array<std::pair<uint32, uint32>, 5> kRegions{{
+    {0x020'0000, 1024 * 1024}, // WRAM-L
+    {0x600'0000, 1024 * 1024}, // WRAM-H
+    {0x5A0'0000, 512 * 1024},  // SCSP RAM
+    {0x5C0'0000, 512 * 1024},  // VDP1 VRAM
+    {0x5E0'0000, 512 * 1024},  // VDP2 VRAM
+}};
+
+// Reads from random addresses in WRAM, VDP1/VDP2 VRAM and sound RAM through the main bus. Addresses are generated on
+// the fly so that the benchmark itself adds no memory traffic.
+void RunAccesses(const ymir::Saturn &saturn, std::string_view name) {
+    static constexpr uint64 kAccessCount = 64 * 1024 * 1024;
+
+    DTLBMissCounter counter{};
+    counter.Start();
+    const auto t0 = std::chrono::steady_clock::now();
+    uint32 sum = 0;
+    uint64 state = 0x9E3779B97F4A7C15ull;
+    for (uint64 i = 0; i < kAccessCount; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        const auto &[base, size] = kRegions[(state >> 32) % kRegions.size()];
+        sum += saturn.mainBus.Read<uint32>(base + (static_cast<uint32>(state) & (size - 4)));
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const auto misses = counter.Stop();
+
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    fmt::print("{:<22} {:6.2f} ns/access", name, ns / kAccessCount);
+    if (misses) {
+        fmt::print("  {:7.4f} dTLB misses/access", static_cast<double>(*misses) / kAccessCount);
+    } else {
+        fmt::print("  dTLB miss counter unavailable");
+    }
+    fmt::println("  (checksum {:08X})", sum);
+}
+
+} // namespace
+
+void runMemoryTLBSandbox() {
+    util::BoostCurrentProcessPriority(true);
+    util::BoostCurrentThreadPriority(true);
+
+    // Global new bypasses the huge page allocation done by Saturn::operator new
+    auto *regular = ::new ymir::Saturn();
+    auto huge = std::make_unique<ymir::Saturn>();
+
+    fmt::println("Saturn instance size: {} bytes", sizeof(ymir::Saturn));
+    fmt::println("Class allocation backed by {}", BackingName(huge->GetMemoryBacking()));
+
+    for (int pass = 0; pass < 3; ++pass) {
+        RunAccesses(*regular, "Global operator new");
+        RunAccesses(*huge, "Saturn::operator new");
+    }
+
+    ::delete regular;
+}
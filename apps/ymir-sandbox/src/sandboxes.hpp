@@ -8,3 +8,4 @@ void runSH2PerfSandbox();
 void runDiscInfoExtractor(int argc, char **argv);
 void runDeadlockTest(int argc, char **argv);
 void runHostCDSandbox();
+void runMemoryTLBSandbox();
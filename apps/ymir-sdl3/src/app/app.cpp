@@ -1129,9 +1129,10 @@ void App::RunEmulator() {
         return;
     }
 
-    m_context.saturn.instance->SCSP.SetSampleCallback(
-        {&m_context.audioSystem,
-         [](sint16 left, sint16 right, void *ctx) { static_cast<AudioSystem *>(ctx)->ReceiveSample(left, right); }});
+    m_context.saturn.instance->SCSP.SetSampleBlockCallback(
+        {&m_context.audioSystem, [](std::span<const Sample> samples, void *ctx) {
+             static_cast<AudioSystem *>(ctx)->ReceiveSamples(samples);
+         }});
 
     m_context.saturn.instance->SCSP.SetSendMidiOutputCallback(
         {&m_midiService, [](std::span<uint8> payload, void *ctx) {
@@ -1688,6 +1689,9 @@ void App::RunEmulator() {
                 break;
             }
             }
+
+            // Hand button changes over to the emulator thread as soon as they are processed
+            m_inputService.PublishChangedInputs();
         }
         if (rescaleUIPending) {
             rescaleUIPending = false;
@@ -1696,6 +1700,7 @@ void App::RunEmulator() {
 
         // Process all axis changes
         m_context.inputContext.ProcessAxes();
+        m_inputService.PublishChangedInputs();
 
         // Make emulator thread process next frame
         m_emuProcessEvent.Set();
@@ -2538,12 +2543,16 @@ void App::RunEmulator() {
                     ImGui::EndMenu();
                 }
                 if (ImGui::BeginMenu("Debug")) {
-                    bool debugTrace = m_context.saturn.instance->IsDebugTracingEnabled();
+                    bool debugTrace = m_context.debugTracing.requested;
                     if (ImGui::MenuItem("Enable tracing",
                                         input::ToShortcut(inputContext, actions::dbg::ToggleDebugTrace).c_str(),
                                         &debugTrace)) {
                         m_context.EnqueueEvent(events::emu::SetDebugTrace(debugTrace));
                     }
+                    bool traceRecording = m_context.traceRecording.recorder.IsRecording();
+                    if (ImGui::MenuItem("Record binary trace", nullptr, &traceRecording)) {
+                        m_context.EnqueueEvent(events::emu::SetBinaryTraceRecording(traceRecording));
+                    }
                     ImGui::Separator();
                     if (ImGui::MenuItem("Open memory viewer", nullptr)) {
                         m_windowManagerService.OpenMemoryViewer();
@@ -2665,6 +2674,8 @@ void App::RunEmulator() {
                     }
 
                     ImGui::MenuItem("Debug output", nullptr, &m_windowManagerService.DebugOutputWindow().Open);
+                    ImGui::MenuItem("CPU profiler", nullptr, &m_windowManagerService.CPUProfilerWindow().Open);
+                    ImGui::MenuItem("Host timing", nullptr, &m_windowManagerService.HostTimingWindow().Open);
                     ImGui::EndMenu();
                 }
                 if (ImGui::BeginMenu("Help")) {
@@ -3350,6 +3361,9 @@ void App::EmulatorThread() {
 
     util::SetCurrentThreadName("Emulator thread");
     util::BoostCurrentThreadPriority(settings.general.boostEmuThreadPriority);
+    if (settings.general.bindEmuMemoryToNUMANode) {
+        m_context.saturn.instance->BindMemoryToCurrentNUMANode();
+    }
 
     lsn::CScopedNoSubnormals snsNoSubnormals{};
 
@@ -3540,6 +3554,25 @@ void App::EmulatorThread() {
             }
 
             if (doRunFrame) [[likely]] {
+                // Only render frames the GUI is ready to display while fast-forwarding
+                using FrameSkipMode = ymir::vdp::config::FrameSkip::Mode;
+                auto &vdp = m_context.saturn.instance->VDP;
+                if (m_context.emuSpeed.limitSpeed) {
+                    if (vdp.GetFrameSkip().mode != FrameSkipMode::Off) {
+                        vdp.SetFrameSkip({});
+                    }
+                } else {
+                    if (vdp.GetFrameSkip().mode != FrameSkipMode::OnRequest) {
+                        vdp.SetFrameSkip({.mode = FrameSkipMode::OnRequest});
+                    }
+                    if (!m_context.screen.updated || stepAction == StepAction::FrameStep) {
+                        vdp.RequestFrameRender();
+                    }
+                }
+
+                if (m_context.traceRecording.recorder.IsRecording()) {
+                    m_context.traceRecording.recorder.MarkFrame(m_context.traceRecording.frame++);
+                }
                 m_context.saturn.instance->RunFrame();
             }
 
@@ -0,0 +1,129 @@
+#include "audio_resampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #include <immintrin.h>
+#elif defined(_M_ARM64) || defined(__aarch64__)
+    #include <arm_neon.h>
+#endif
+
+namespace app {
+
+// Cutoff frequency relative to the Nyquist frequency. Slightly below 1.0 to leave room for the filter's transition band.
+static constexpr double kCutoff = 0.92;
+
+AudioResampler::AudioResampler() {
+    static constexpr double pi = std::numbers::pi;
+    static constexpr double center = kTaps / 2 - 1;
+
+    for (uint32 phase = 0; phase <= kPhases; ++phase) {
+        const double frac = static_cast<double>(phase) / kPhases;
+        auto &row = m_kernel[phase];
+
+        double sum = 0.0;
+        std::array<double, kTaps> coeffs{};
+        for (uint32 tap = 0; tap < kTaps; ++tap) {
+            const double x = static_cast<double>(tap) - center - frac;
+            const double sinc = x == 0.0 ? 1.0 : std::sin(pi * kCutoff * x) / (pi * kCutoff * x);
+
+            // Blackman window spanning [-kTaps/2, kTaps/2]
+            const double n = (x + kTaps / 2) / kTaps;
+            const double window = 0.42 - 0.5 * std::cos(2.0 * pi * n) + 0.08 * std::cos(4.0 * pi * n);
+
+            coeffs[tap] = sinc * window;
+            sum += coeffs[tap];
+        }
+
+        // Normalize for unity gain at DC
+        for (uint32 tap = 0; tap < kTaps; ++tap) {
+            row[tap] = static_cast<float>(coeffs[tap] / sum);
+        }
+    }
+
+    SetRatio(1.0);
+    Reset();
+}
+
+void AudioResampler::Reset() {
+    m_historyL.fill(0.0f);
+    m_historyR.fill(0.0f);
+    m_historyPos = 0;
+    m_frac = 0.0;
+}
+
+void AudioResampler::SetRatio(double ratio) {
+    m_ratio = ratio;
+    m_step = 1.0 / ratio;
+}
+
+void AudioResampler::Push(Sample sample) {
+    const float left = sample.left;
+    const float right = sample.right;
+    m_historyL[m_historyPos] = m_historyL[m_historyPos + kTaps] = left;
+    m_historyR[m_historyPos] = m_historyR[m_historyPos + kTaps] = right;
+    m_historyPos = (m_historyPos + 1) % kTaps;
+}
+
+Sample AudioResampler::Interpolate(double frac) const {
+    const double phasePos = frac * kPhases;
+    const uint32 phase = std::min<uint32>(static_cast<uint32>(phasePos), kPhases - 1);
+    const float blend = static_cast<float>(phasePos - phase);
+
+    // The latest kTaps samples, from oldest to newest
+    const float *histL = &m_historyL[m_historyPos];
+    const float *histR = &m_historyR[m_historyPos];
+    const float *k0 = m_kernel[phase].data();
+    const float *k1 = m_kernel[phase + 1].data();
+
+    float left, right;
+#if defined(_M_X64) || defined(__x86_64__)
+    const __m128 blend4 = _mm_set1_ps(blend);
+    __m128 accL = _mm_setzero_ps();
+    __m128 accR = _mm_setzero_ps();
+    for (uint32 i = 0; i < kTaps; i += 4) {
+        const __m128 c0 = _mm_load_ps(&k0[i]);
+        const __m128 c1 = _mm_load_ps(&k1[i]);
+        const __m128 coeffs = _mm_add_ps(c0, _mm_mul_ps(blend4, _mm_sub_ps(c1, c0)));
+        accL = _mm_add_ps(accL, _mm_mul_ps(coeffs, _mm_loadu_ps(&histL[i])));
+        accR = _mm_add_ps(accR, _mm_mul_ps(coeffs, _mm_loadu_ps(&histR[i])));
+    }
+    // Horizontal sums: L0+L1, L2+L3, R0+R1, R2+R3 -> L, R
+    const __m128 lo = _mm_unpacklo_ps(accL, accR); // L0 R0 L1 R1
+    const __m128 hi = _mm_unpackhi_ps(accL, accR); // L2 R2 L3 R3
+    const __m128 sum = _mm_add_ps(lo, hi);         // L02 R02 L13 R13
+    const __m128 total = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    left = _mm_cvtss_f32(total);
+    right = _mm_cvtss_f32(_mm_shuffle_ps(total, total, _MM_SHUFFLE(1, 1, 1, 1)));
+#elif defined(_M_ARM64) || defined(__aarch64__)
+    const float32x4_t blend4 = vdupq_n_f32(blend);
+    float32x4_t accL = vdupq_n_f32(0.0f);
+    float32x4_t accR = vdupq_n_f32(0.0f);
+    for (uint32 i = 0; i < kTaps; i += 4) {
+        const float32x4_t c0 = vld1q_f32(&k0[i]);
+        const float32x4_t c1 = vld1q_f32(&k1[i]);
+        const float32x4_t coeffs = vfmaq_f32(c0, blend4, vsubq_f32(c1, c0));
+        accL = vfmaq_f32(accL, coeffs, vld1q_f32(&histL[i]));
+        accR = vfmaq_f32(accR, coeffs, vld1q_f32(&histR[i]));
+    }
+    left = vaddvq_f32(accL);
+    right = vaddvq_f32(accR);
+#else
+    left = 0.0f;
+    right = 0.0f;
+    for (uint32 i = 0; i < kTaps; ++i) {
+        const float coeff = k0[i] + blend * (k1[i] - k0[i]);
+        left += coeff * histL[i];
+        right += coeff * histR[i];
+    }
+#endif
+
+    auto toSample = [](float value) -> sint16 {
+        return static_cast<sint16>(std::clamp<long>(std::lround(value), -32768, 32767));
+    };
+    return {toSample(left), toSample(right)};
+}
+
+} // namespace app
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <ymir/hw/scsp/scsp_callbacks.hpp>
+
+#include <ymir/core/types.hpp>
+
+#include <array>
+#include <span>
+
+namespace app {
+
+using Sample = ymir::scsp::OutputSample;
+
+// Polyphase windowed-sinc resampler for stereo 16-bit audio.
+// Meant for dynamic rate control: the ratio is expected to stay within a fraction of a percent from 1.0 and can be
+// changed at any time without discontinuities.
+class AudioResampler {
+public:
+    static constexpr uint32 kTaps = 16;    // filter length in input samples
+    static constexpr uint32 kPhases = 256; // number of fractional positions in the filter bank
+
+    AudioResampler();
+
+    // Clears the sample history and fractional position.
+    void Reset();
+
+    // Sets the number of output samples produced per input sample.
+    void SetRatio(double ratio);
+
+    [[nodiscard]] double GetRatio() const {
+        return m_ratio;
+    }
+
+    // Resamples the input, invoking `output(Sample)` for every output sample produced.
+    template <typename FnOutput>
+    void Process(std::span<const Sample> input, FnOutput &&output) {
+        for (const Sample &sample : input) {
+            Push(sample);
+            while (m_frac < 1.0) {
+                output(Interpolate(m_frac));
+                m_frac += m_step;
+            }
+            m_frac -= 1.0;
+        }
+    }
+
+private:
+    // Filter bank. Row p holds the coefficients for the fractional position p / kPhases between the two center taps.
+    // The extra row simplifies interpolation between phases.
+    alignas(16) std::array<std::array<float, kTaps>, kPhases + 1> m_kernel;
+
+    // Sample history, stored twice in a row so that the latest kTaps samples are always contiguous
+    alignas(16) std::array<float, kTaps * 2> m_historyL;
+    alignas(16) std::array<float, kTaps * 2> m_historyR;
+    uint32 m_historyPos;
+
+    double m_ratio;
+    double m_step; // input samples advanced per output sample
+    double m_frac; // position of the next output sample relative to the latest input sample
+
+    void Push(Sample sample);
+    Sample Interpolate(double frac) const;
+};
+
+} // namespace app
@@ -3,6 +3,7 @@
 #include <SDL3/SDL_hints.h>
 #include <SDL3/SDL_log.h>
 
+#include <algorithm>
 #include <string>
 
 namespace app {
@@ -73,14 +74,41 @@ bool AudioSystem::GetAudioStreamFormat(int *sampleRate, SDL_AudioFormat *format,
     }
 }
 
-void AudioSystem::ReceiveSample(sint16 left, sint16 right) {
-    // If we're doing audio sync, wait until the buffer is no longer full.
-    // Otherwise, simply overrun the buffer.
+void AudioSystem::ReceiveSamples(std::span<const Sample> samples) {
+    const uint32 targetLevel = m_buffer.size() / 2;
+
+    // Adjust resampling ratio based on the buffer level. Output more samples if the buffer is running low and fewer if
+    // it is filling up. Skip adjustments if not syncing to audio, since the buffer is going to be overrun anyway.
+    // The level must be measured before waiting below, otherwise it always reads at or under the target and the ratio
+    // can only ever speed up.
+    double ratio = 1.0;
+    if (m_sync && !m_silent) {
+        const double level = GetBufferCount();
+        const double deviation = std::clamp((targetLevel - level) / targetLevel, -1.0, 1.0);
+        ratio += kMaxRateDeviation * deviation;
+    }
+    m_resampler.SetRatio(ratio);
+
+    // If we're doing audio sync, wait until the buffer drains down to the target level.
+    WaitForBufferLevel(targetLevel);
+
+    m_resampler.Process(samples, [&](Sample sample) {
+        // If we're doing audio sync, wait until the buffer is no longer full.
+        // Otherwise, simply overrun the buffer.
+        WaitForBufferLevel(m_buffer.size() - 2);
+
+        const uint32 writePos = m_writePos.load(std::memory_order_relaxed);
+        m_buffer[writePos] = sample;
+        m_writePos.store((writePos + 1) % m_buffer.size(), std::memory_order_release);
+    });
+}
+
+void AudioSystem::WaitForBufferLevel(uint32 level) {
     while (m_sync && !m_silent) {
         const uint32 readPos = m_readPos.load(std::memory_order_acquire);
         const uint32 writePos = m_writePos.load(std::memory_order_relaxed);
         const uint32 count = (writePos >= readPos) ? (writePos - readPos) : (m_buffer.size() - (readPos - writePos));
-        if (count < m_buffer.size() - 1) {
+        if (count <= level) {
             break;
         }
 
@@ -89,17 +117,13 @@ void AudioSystem::ReceiveSample(sint16 left, sint16 right) {
         const uint32 recheckReadPos = m_readPos.load(std::memory_order_acquire);
         const uint32 recheckCount = (writePos >= recheckReadPos) ? (writePos - recheckReadPos)
                                                                  : (m_buffer.size() - (recheckReadPos - writePos));
-        if (recheckCount < m_buffer.size() - 1) {
+        if (recheckCount <= level) {
             m_bufferNotFullEvent.Set();
             break;
         }
 
         m_bufferNotFullEvent.Wait();
     }
-
-    const uint32 writePos = m_writePos.load(std::memory_order_relaxed);
-    m_buffer[writePos] = {left, right};
-    m_writePos.store((writePos + 1) % m_buffer.size(), std::memory_order_release);
 }
 
 void AudioSystem::UpdateGain() {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "audio_resampler.hpp"
+
 #include <ymir/core/types.hpp>
 
 #include <ymir/util/event.hpp>
@@ -12,10 +14,6 @@
 
 namespace app {
 
-struct Sample {
-    sint16 left, right;
-};
-
 class AudioSystem {
 public:
     bool Init(int sampleRate, SDL_AudioFormat format, int channels, uint32 bufferSize);
@@ -27,7 +25,9 @@ public:
 
     bool GetAudioStreamFormat(int *sampleRate, SDL_AudioFormat *format, int *channels);
 
-    void ReceiveSample(sint16 left, sint16 right);
+    // Queues a block of samples for playback, resampling them to keep the buffer close to half full.
+    // When syncing to audio, blocks until the buffer drains to that level, which paces emulation once per block.
+    void ReceiveSamples(std::span<const Sample> samples);
 
     void Snapshot(std::span<Sample, 2048> out) const {
         const uint32 readPos = m_readPos.load(std::memory_order_relaxed);
@@ -100,6 +100,15 @@ private:
     float m_gain = 0.8f;
     bool m_mute = false;
 
+    // Dynamic rate control.
+    // The resampling ratio is nudged by up to this fraction to steer the buffer towards the target level, compensating
+    // for drift between the emulated and host audio clocks without audible pitch changes.
+    static constexpr double kMaxRateDeviation = 0.005;
+    AudioResampler m_resampler;
+
+    // Waits until the buffer contains at most the specified number of samples if syncing to audio.
+    void WaitForBufferLevel(uint32 level);
+
     void UpdateGain();
 
     void ProcessAudioCallback(SDL_AudioStream *stream, int additional_amount, int total_amount);
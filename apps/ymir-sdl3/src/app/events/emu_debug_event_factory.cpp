@@ -387,6 +387,46 @@ EmuEvent ClearSH2Breakpoints(bool master) {
     });
 }
 
+EmuEvent AddSH2Watchpoint(bool master, uint32 address, ymir::debug::WatchpointFlags flags) {
+    return RunFunction([=](SharedContext &ctx) {
+        auto &sh2 = ctx.saturn.GetSH2(master);
+        std::unique_lock lock{ctx.locks.watchpoints};
+        sh2.AddWatchpoint(address, flags);
+    });
+}
+
+EmuEvent RemoveSH2Watchpoint(bool master, uint32 address, ymir::debug::WatchpointFlags flags) {
+    return RunFunction([=](SharedContext &ctx) {
+        auto &sh2 = ctx.saturn.GetSH2(master);
+        std::unique_lock lock{ctx.locks.watchpoints};
+        sh2.RemoveWatchpoint(address, flags);
+    });
+}
+
+EmuEvent ClearSH2WatchpointsAt(bool master, uint32 address) {
+    return RunFunction([=](SharedContext &ctx) {
+        auto &sh2 = ctx.saturn.GetSH2(master);
+        std::unique_lock lock{ctx.locks.watchpoints};
+        sh2.ClearWatchpointsAt(address);
+    });
+}
+
+EmuEvent ReplaceSH2Watchpoints(bool master, const std::map<uint32, ymir::debug::WatchpointFlags> &watchpoints) {
+    return RunFunction([=](SharedContext &ctx) {
+        auto &sh2 = ctx.saturn.GetSH2(master);
+        std::unique_lock lock{ctx.locks.watchpoints};
+        sh2.ReplaceWatchpoints(watchpoints);
+    });
+}
+
+EmuEvent ClearSH2Watchpoints(bool master) {
+    return RunFunction([=](SharedContext &ctx) {
+        auto &sh2 = ctx.saturn.GetSH2(master);
+        std::unique_lock lock{ctx.locks.watchpoints};
+        sh2.ClearWatchpoints();
+    });
+}
+
 EmuEvent SetLayerEnabled(ymir::vdp::Layer layer, bool enabled) {
     return RunFunction([=](SharedContext &ctx) {
         auto &vdp = ctx.saturn.GetVDP();
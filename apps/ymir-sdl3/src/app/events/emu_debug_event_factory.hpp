@@ -2,10 +2,12 @@
 
 #include <ymir/core/types.hpp>
 
+#include <ymir/debug/watchpoint_defs.hpp>
 #include <ymir/hw/vdp/vdp_defs.hpp>
 
 #include "emu_event.hpp"
 
+#include <map>
 #include <set>
 
 namespace app::events::emu::debug {
@@ -23,6 +25,12 @@ EmuEvent RemoveSH2Breakpoint(bool master, uint32 address);
 EmuEvent ReplaceSH2Breakpoints(bool master, const std::set<uint32> &addresses);
 EmuEvent ClearSH2Breakpoints(bool master);
 
+EmuEvent AddSH2Watchpoint(bool master, uint32 address, ymir::debug::WatchpointFlags flags);
+EmuEvent RemoveSH2Watchpoint(bool master, uint32 address, ymir::debug::WatchpointFlags flags);
+EmuEvent ClearSH2WatchpointsAt(bool master, uint32 address);
+EmuEvent ReplaceSH2Watchpoints(bool master, const std::map<uint32, ymir::debug::WatchpointFlags> &watchpoints);
+EmuEvent ClearSH2Watchpoints(bool master);
+
 EmuEvent SetLayerEnabled(ymir::vdp::Layer layer, bool enabled);
 
 EmuEvent VDP2SetCRAMColor555(uint32 index, ymir::vdp::Color555 color);
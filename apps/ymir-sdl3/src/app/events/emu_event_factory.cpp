@@ -15,9 +15,13 @@
 #include <ymir/util/scope_guard.hpp>
 
 #include <util/file_loader.hpp>
+#include <util/std_lib.hpp>
 
+#include <fmt/chrono.h>
 #include <fmt/format.h>
+#include <fmt/std.h>
 
+#include <chrono>
 #include <fstream>
 #include <memory>
 
@@ -42,6 +46,24 @@ namespace grp {
 
 } // namespace grp
 
+namespace {
+
+    // Adds a debug tracing user, enabling debug tracing for the first one.
+    void RetainDebugTracing(SharedContext &ctx) {
+        if (ctx.debugTracing.refCount++ == 0) {
+            ctx.saturn.instance->EnableDebugTracing(true);
+        }
+    }
+
+    // Removes a debug tracing user, disabling debug tracing after the last one.
+    void ReleaseDebugTracing(SharedContext &ctx) {
+        if (--ctx.debugTracing.refCount == 0) {
+            ctx.saturn.instance->EnableDebugTracing(false);
+        }
+    }
+
+} // namespace
+
 EmuEvent SetClockSpeed(sys::ClockSpeed clockSpeed) {
     return RunFunction([=](SharedContext &ctx) { ctx.saturn.instance->SetClockSpeed(clockSpeed); });
 }
@@ -134,13 +156,24 @@ EmuEvent SwitchVDPRenderer(bool verbose) {
 
 EmuEvent SetDebugTrace(bool enable) {
     return RunFunction([=](SharedContext &ctx) {
-        ctx.saturn.instance->EnableDebugTracing(enable);
+        if (enable != ctx.debugTracing.requested) {
+            ctx.debugTracing.requested = enable;
+            if (enable) {
+                RetainDebugTracing(ctx);
+            } else {
+                ReleaseDebugTracing(ctx);
+            }
+        }
         if (enable) {
-            ctx.saturn.instance->masterSH2.UseTracer(&ctx.tracers.masterSH2);
-            ctx.saturn.instance->slaveSH2.UseTracer(&ctx.tracers.slaveSH2);
-            ctx.saturn.instance->SCU.UseTracer(&ctx.tracers.SCU);
+            // Binary trace recording owns the CPU, SCU and CD block tracers while active
+            const bool recording = ctx.traceRecording.recorder.IsRecording();
+            if (!recording) {
+                ctx.saturn.instance->masterSH2.UseTracer(&ctx.tracers.masterSH2);
+                ctx.saturn.instance->slaveSH2.UseTracer(&ctx.tracers.slaveSH2);
+                ctx.saturn.instance->SCU.UseTracer(&ctx.tracers.SCU);
+                ctx.saturn.instance->CDBlock.UseTracer(&ctx.tracers.CDBlock);
+            }
             ctx.saturn.instance->SCSP.UseTracer(&ctx.tracers.SCSP);
-            ctx.saturn.instance->CDBlock.UseTracer(&ctx.tracers.CDBlock);
             ctx.saturn.instance->CDDrive.UseTracer(&ctx.tracers.CDDrive);
             ctx.saturn.instance->YGR.UseTracer(&ctx.tracers.YGR);
         }
@@ -148,6 +181,81 @@ EmuEvent SetDebugTrace(bool enable) {
     });
 }
 
+EmuEvent SetBinaryTraceRecording(bool enable) {
+    return RunFunction([=](SharedContext &ctx) {
+        auto &recording = ctx.traceRecording;
+        auto &saturn = *ctx.saturn.instance;
+        if (enable == recording.recorder.IsRecording()) {
+            return;
+        }
+
+        if (!enable) {
+            saturn.UseTraceRecorder(nullptr);
+            recording.recorder.Stop();
+            if (ctx.debugTracing.requested) {
+                saturn.masterSH2.UseTracer(&ctx.tracers.masterSH2);
+                saturn.slaveSH2.UseTracer(&ctx.tracers.slaveSH2);
+                saturn.SCU.UseTracer(&ctx.tracers.SCU);
+                saturn.CDBlock.UseTracer(&ctx.tracers.CDBlock);
+            }
+            ReleaseDebugTracing(ctx);
+
+            const auto stats = recording.recorder.GetStats();
+            if (stats.writeError) {
+                ctx.DisplayMessage("Trace recording stopped: failed to write trace file");
+            } else {
+                ctx.DisplayMessage(fmt::format("Trace recording stopped: {} records, {} KiB", stats.records,
+                                               stats.compressedBytes / 1024));
+            }
+            return;
+        }
+
+        auto dumpPath = ctx.profile.GetPath(ProfilePath::Dumps);
+        std::error_code error{};
+        std::filesystem::create_directories(dumpPath, error);
+        if (error) {
+            devlog::warn<grp::base>("Could not create dump directory {}: {}", dumpPath, error.message());
+            return;
+        }
+
+        const auto now = std::chrono::system_clock::now();
+        const auto localNow = util::to_local_time(now);
+        const auto tracePath =
+            dumpPath / fmt::format("{}-{:%Y%m%d}T{:%H%M%S}.ytrace", ctx.GetGameFileName(), localNow, localNow);
+        if (!recording.recorder.Start(tracePath, error)) {
+            ctx.DisplayMessage(fmt::format("Could not create trace file {}: {}", tracePath, error.message()));
+            return;
+        }
+
+        recording.frame = 0;
+        RetainDebugTracing(ctx);
+        saturn.UseTraceRecorder(&recording.recorder);
+        ctx.DisplayMessage(fmt::format("Recording trace to {}", tracePath));
+    });
+}
+
+EmuEvent SetPCSampling(bool enable) {
+    return RunFunction([=](SharedContext &ctx) {
+        ctx.saturn.instance->UsePCSampler(enable ? &ctx.profiler.sampler : nullptr);
+        ctx.profiler.enabled = enable;
+        ctx.DisplayMessage(fmt::format("CPU profiler {}", (enable ? "enabled" : "disabled")));
+    });
+}
+
+EmuEvent SetHostTiming(bool enable) {
+    return RunFunction([=](SharedContext &ctx) {
+        if (enable) {
+            ctx.hostTiming.stats.ResetTotals();
+        }
+        ctx.saturn.instance->UseHostTimingStats(enable ? &ctx.hostTiming.stats : nullptr);
+        ctx.hostTiming.enabled = enable;
+    });
+}
+
+EmuEvent ResetHostTiming() {
+    return RunFunction([](SharedContext &ctx) { ctx.hostTiming.stats.ResetTotals(); });
+}
+
 EmuEvent DumpMemory() {
     return RunFunction([](SharedContext &ctx) {
         auto dumpPath = ctx.profile.GetPath(ProfilePath::Dumps);
@@ -107,6 +107,10 @@ EmuEvent UseNullVDPRenderer(util::Event &event);
 EmuEvent SwitchVDPRenderer(bool verbose = true);
 
 EmuEvent SetDebugTrace(bool enable);
+EmuEvent SetBinaryTraceRecording(bool enable);
+EmuEvent SetPCSampling(bool enable);
+EmuEvent SetHostTiming(bool enable);
+EmuEvent ResetHostTiming();
 EmuEvent DumpMemory();
 EmuEvent DumpMemRegion(const ui::mem_view::MemoryViewerState &memView);
 
@@ -624,6 +624,7 @@ void InputContext::ProcessEvent(const InputEvent &event, bool changed) {
             }
             if (event.buttonPressed && (action->second.action.kind == Action::Kind::RepeatableTrigger || changed)) {
                 if (auto handler = m_triggerHandlers.find(action->second.action); handler != m_triggerHandlers.end()) {
+                    ++m_handledActionCount;
                     handler->second(action->second.context, event.element);
                 }
             }
@@ -631,12 +632,14 @@ void InputContext::ProcessEvent(const InputEvent &event, bool changed) {
         case InputElement::Type::MouseAxis1D: [[fallthrough]];
         case InputElement::Type::GamepadAxis1D:
             if (auto handler = m_axis1DHandlers.find(action->second.action); handler != m_axis1DHandlers.end()) {
+                ++m_handledActionCount;
                 handler->second(action->second.context, event.element, event.axis1DValue);
             }
             break;
         case InputElement::Type::MouseAxis2D: [[fallthrough]];
         case InputElement::Type::GamepadAxis2D:
             if (auto handler = m_axis2DHandlers.find(action->second.action); handler != m_axis2DHandlers.end()) {
+                ++m_handledActionCount;
                 handler->second(action->second.context, event.element, event.axis2D.x, event.axis2D.y);
             }
             break;
@@ -647,6 +650,7 @@ void InputContext::ProcessEvent(const InputEvent &event, bool changed) {
 void InputContext::ProcessButtonAction(const InputElement &element, bool pressed) {
     if (auto action = m_actions.find(element); action != m_actions.end()) {
         if (auto handler = m_buttonHandlers.find(action->second.action); handler != m_buttonHandlers.end()) {
+            ++m_handledActionCount;
             handler->second(action->second.context, element, pressed);
         }
     }
@@ -153,6 +153,12 @@ public:
     Axis2DValue GetAxis2D(uint32 id, MouseAxis2D axis) const;
     Axis2DValue GetAxis2D(uint32 id, GamepadAxis2D axis) const;
 
+    // Returns the number of action handler invocations so far.
+    // Changes whenever a processed input modifies the state bound to an action.
+    uint64 GetHandledActionCount() const {
+        return m_handledActionCount;
+    }
+
 private:
     void ProcessEvent(const InputEvent &event, bool changed = true);
     void ProcessButtonAction(const InputElement &element, bool pressed);
@@ -259,6 +265,8 @@ private:
 
     bool m_axesDirty = false;
 
+    uint64 m_handledActionCount = 0;
+
     // -----------------------------------------------------------------------------------------------------------------
     // Element-action mappings
 
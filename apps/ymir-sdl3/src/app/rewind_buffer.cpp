@@ -1,13 +1,10 @@
 #include "rewind_buffer.hpp"
 
+#include <ymir/savestate/savestate_binary.hpp>
+
 #include <ymir/util/data_ops.hpp>
 #include <ymir/util/thread_name.hpp>
 
-#include <cereal/cereal.hpp>
-
-#include <serdes/cereal_archive_vector.hpp>
-#include <serdes/cereal_savestate.hpp>
-
 #include <lz4.h>
 
 namespace app {
@@ -83,7 +80,13 @@ bool RewindBuffer::PopState() {
     const size_t size = lastDelta.size();
     std::vector<char> &buffer = m_buffers[m_bufferFlip];
     buffer.resize(maxSize);
-    [[maybe_unused]] int result = LZ4_decompress_safe(&lastDelta[0], &buffer[0], size, maxSize);
+    const int result = LZ4_decompress_safe(&lastDelta[0], &buffer[0], size, maxSize);
+    if (result < 0) {
+        // Older deltas chain off this one and can no longer be reconstructed
+        buffer.clear();
+        m_deltaCount = 0;
+        return false;
+    }
     buffer.resize(result);
 
     // Use pointers to allow for vectorization
@@ -101,10 +104,11 @@ bool RewindBuffer::PopState() {
     }
 
     // Deserialize state
-    cereal::BinaryVectorInputArchive archive{m_buffers[m_bufferFlip ^ 1]};
-    archive(NextState);
-
-    return true;
+    // The XOR chain stays intact if this fails, so only this frame is dropped
+    const auto &stateBuffer = m_buffers[m_bufferFlip ^ 1];
+    const auto readResult = ymir::savestate::binary::Read(
+        {reinterpret_cast<const uint8 *>(stateBuffer.data()), stateBuffer.size()}, NextState);
+    return readResult == ymir::savestate::binary::ReadResult::Success;
 }
 
 FLATTEN void RewindBuffer::ProcThread() {
@@ -120,9 +124,10 @@ FLATTEN void RewindBuffer::ProcThread() {
         std::unique_lock lock{m_lock};
 
         // Serialize state to next buffer
+        // The native binary format has a fixed layout, so consecutive states produce sparse XOR deltas
         std::vector<char> &buffer = GetBuffer();
-        cereal::BinaryVectorOutputArchive archive{buffer};
-        archive(NextState);
+        buffer.resize(ymir::savestate::binary::CalcSize(NextState));
+        ymir::savestate::binary::Write(NextState, {reinterpret_cast<uint8 *>(buffer.data()), buffer.size()});
         m_stateProcessedEvent.Set();
 
         // Process frame from next buffer
@@ -4,129 +4,368 @@
 #include <ymir/hw/sh1/sh1_defs.hpp>
 #include <ymir/sys/memory_defs.hpp>
 
+#include <ymir/util/data_ops.hpp>
+#include <ymir/util/dev_log.hpp>
+#include <ymir/util/thread_name.hpp>
+
+#include <util/os_features.hpp>
+
+#include <fmt/std.h>
+
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iostream>
+#include <thread>
+#include <unordered_set>
 
 using namespace ymir;
 
 namespace app {
 
-void ROMManager::ScanIPLROMs(std::filesystem::path path) {
-    std::vector<char> buf{};
-    buf.resize(sys::kIPLSize);
+namespace grp {
 
-    m_iplEntries.clear();
+    // -----------------------------------------------------------------------------
+    // Dev log groups
 
-    for (const std::filesystem::directory_entry &dirEntry : std::filesystem::recursive_directory_iterator(path)) {
-        if (!dirEntry.is_regular_file()) {
-            continue;
-        }
-        if (dirEntry.file_size() != sys::kIPLSize) {
-            continue;
-        }
+    // Hierarchy:
+    //
+    // rom_manager
 
-        // Read file into buffer
-        std::filesystem::path canonicalPath = std::filesystem::canonical(dirEntry.path());
-        {
-            std::ifstream in{canonicalPath, std::ios::binary};
-            in.read(buf.data(), buf.size());
-            if (!in) {
-                continue;
-            }
-        }
+    struct rom_manager {
+        static constexpr bool enabled = true;
+        static constexpr devlog::Level level = devlog::level::debug;
+        static constexpr std::string_view name = "ROM-Manager";
+    };
 
-        // Build entry
-        IPLROMEntry entry{};
-        entry.path = canonicalPath;
+} // namespace grp
+
+// ROM index file format, all values little-endian:
+//   8 bytes   magic "YMROMIDX"
+//   uint32    version
+//   uint32    number of entries
+// followed by entries:
+//   uint8     kind
+//   uint64    file size
+//   sint64    modification time
+//   uint64    file ID
+//   16 bytes  hash
+//   uint16    version string length, followed by the string
+//   uint32    UTF-8 path length, followed by the path
+static constexpr char kIndexMagic[8] = {'Y', 'M', 'R', 'O', 'M', 'I', 'D', 'X'};
+static constexpr uint32 kIndexVersion = 1;
+
+// Hashing ROMs is bound by file reads; more threads than this won't help
+static constexpr uint32 kMaxScanThreads = 8;
+
+void ROMManager::UseIndex(std::filesystem::path path) {
+    if (path == m_indexPath) {
+        return;
+    }
+    m_indexPath = std::move(path);
+    LoadIndex();
+}
 
-        // Get database entry
-        XXH128Hash hash = CalcHash128(buf.data(), buf.size(), sys::kIPLHashSeed);
-        entry.info = db::GetIPLROMInfo(hash);
-        entry.hash = hash;
+void ROMManager::ScanIPLROMs(std::filesystem::path path) {
+    m_iplEntries.clear();
 
-        // Get version string
-        entry.versionString.assign(buf.begin() + 0x800, buf.begin() + 0x810);
+    std::error_code err{};
+    for (const ScannedROM &rom : ScanROMs(path, ROMKind::IPL, sys::kIPLSize, sys::kIPLHashSeed, err)) {
+        IPLROMEntry entry{};
+        entry.path = rom.path;
+        entry.info = db::GetIPLROMInfo(rom.entry->hash);
+        entry.hash = rom.entry->hash;
+        entry.versionString = rom.entry->versionString;
 
         // Add it to the list (including unknown entries, in case the image is modified)
-        m_iplEntries.insert({canonicalPath, entry});
+        m_iplEntries.insert({rom.path, entry});
     }
 }
 
 void ROMManager::ScanCDBlockROMs(std::filesystem::path path) {
-    std::vector<char> buf{};
-    buf.resize(sh1::kROMSize);
-
     m_cdbEntries.clear();
 
-    for (const std::filesystem::directory_entry &dirEntry : std::filesystem::recursive_directory_iterator(path)) {
-        if (!dirEntry.is_regular_file()) {
+    std::error_code err{};
+    for (const ScannedROM &rom : ScanROMs(path, ROMKind::CDBlock, sh1::kROMSize, sh1::kROMHashSeed, err)) {
+        CDBlockROMEntry entry{};
+        entry.path = rom.path;
+        entry.info = db::GetCDBlockROMInfo(rom.entry->hash);
+        entry.hash = rom.entry->hash;
+
+        // Add it to the list (including unknown entries, in case the image is modified)
+        m_cdbEntries.insert({rom.path, entry});
+    }
+}
+
+void ROMManager::ScanROMCarts(std::filesystem::path path, std::error_code &err) {
+    m_cartEntries.clear();
+
+    for (const ScannedROM &rom : ScanROMs(path, ROMKind::Cart, cart::kROMCartSize, cart::kROMCartHashSeed, err)) {
+        ROMCartEntry entry{};
+        entry.path = rom.path;
+        entry.info = db::GetROMCartInfo(rom.entry->hash);
+        entry.hash = rom.entry->hash;
+
+        // Add it to the list (including unknown entries, in case the image is modified)
+        m_cartEntries.insert({rom.path, entry});
+    }
+}
+
+std::vector<ROMManager::ScannedROM> ROMManager::ScanROMs(const std::filesystem::path &path, ROMKind kind,
+                                                         uintmax_t romSize, uint64 hashSeed, std::error_code &err) {
+    struct Candidate {
+        std::filesystem::path path;
+        IndexEntry entry;
+        bool valid;
+    };
+
+    std::vector<ScannedROM> roms{};
+    std::vector<Candidate> candidates{};
+
+    // Find candidates by size and look them up in the index. Directory iteration and stat calls are cheap compared to
+    // reading and hashing the files.
+    err.clear();
+    for (const std::filesystem::directory_entry &dirEntry : std::filesystem::recursive_directory_iterator(path, err)) {
+        std::error_code entryErr{};
+        if (!dirEntry.is_regular_file(entryErr)) {
             continue;
         }
-        if (dirEntry.file_size() != sh1::kROMSize) {
+        if (dirEntry.file_size(entryErr) != romSize) {
             continue;
         }
+        const auto writeTime = dirEntry.last_write_time(entryErr);
+        if (entryErr) {
+            continue;
+        }
+        std::filesystem::path canonicalPath = std::filesystem::canonical(dirEntry.path(), entryErr);
+        if (entryErr) {
+            continue;
+        }
+
+        IndexEntry entry{};
+        entry.kind = kind;
+        entry.size = romSize;
+        entry.mtime = writeTime.time_since_epoch().count();
+        entry.fileID = util::os::GetFileID(canonicalPath);
 
-        // Read file into buffer
-        std::filesystem::path canonicalPath = std::filesystem::canonical(dirEntry.path());
+        if (auto it = m_index.find(canonicalPath); it != m_index.end()) {
+            const IndexEntry &cached = it->second;
+            if (cached.kind == entry.kind && cached.size == entry.size && cached.mtime == entry.mtime &&
+                cached.fileID == entry.fileID) {
+                roms.push_back({canonicalPath, &cached});
+                continue;
+            }
+        }
+        candidates.push_back({std::move(canonicalPath), std::move(entry), false});
+    }
+
+    // Hash new and modified files in parallel
+    if (!candidates.empty()) {
+        std::atomic<size_t> nextCandidate = 0;
+        auto worker = [&] {
+            std::vector<char> buf{};
+            buf.resize(romSize);
+
+            size_t index;
+            while ((index = nextCandidate.fetch_add(1, std::memory_order_relaxed)) < candidates.size()) {
+                Candidate &candidate = candidates[index];
+
+                // Read file into buffer
+                {
+                    std::ifstream in{candidate.path, std::ios::binary};
+                    in.read(buf.data(), buf.size());
+                    if (!in) {
+                        continue;
+                    }
+                }
+
+                candidate.entry.hash = CalcHash128(buf.data(), buf.size(), hashSeed);
+                if (kind == ROMKind::IPL) {
+                    candidate.entry.versionString.assign(buf.begin() + 0x800, buf.begin() + 0x810);
+                }
+                candidate.valid = true;
+            }
+        };
+
+        const size_t numThreads =
+            std::min<size_t>({std::max(std::thread::hardware_concurrency(), 1u), kMaxScanThreads, candidates.size()});
         {
-            std::ifstream in{canonicalPath, std::ios::binary};
-            in.read(buf.data(), buf.size());
-            if (!in) {
+            std::vector<std::jthread> threads{};
+            threads.reserve(numThreads - 1);
+            for (size_t i = 1; i < numThreads; ++i) {
+                threads.emplace_back([&] {
+                    util::SetCurrentThreadName("ROM scanner");
+                    worker();
+                });
+            }
+            worker();
+        }
+
+        for (Candidate &candidate : candidates) {
+            if (!candidate.valid) {
                 continue;
             }
+            auto [it, inserted] = m_index.insert_or_assign(candidate.path, std::move(candidate.entry));
+            roms.push_back({it->first, &it->second});
+            m_indexDirty = true;
         }
+    }
 
-        // Build entry
-        CDBlockROMEntry entry{};
-        entry.path = canonicalPath;
+    devlog::debug<grp::rom_manager>("Scanned {}: {} ROMs, {} hashed", path, roms.size(), candidates.size());
 
-        // Get database entry
-        XXH128Hash hash = CalcHash128(buf.data(), buf.size(), sh1::kROMHashSeed);
-        entry.info = db::GetCDBlockROMInfo(hash);
-        entry.hash = hash;
+    // Drop index entries for files of this kind that are gone
+    if (!err) {
+        std::unordered_set<std::filesystem::path> found{};
+        for (const ScannedROM &rom : roms) {
+            found.insert(rom.path);
+        }
+        const size_t prevSize = m_index.size();
+        std::erase_if(m_index, [&](const auto &item) {
+            return item.second.kind == kind && !found.contains(item.first);
+        });
+        m_indexDirty |= m_index.size() != prevSize;
+    }
 
-        // Add it to the list (including unknown entries, in case the image is modified)
-        m_cdbEntries.insert({canonicalPath, entry});
+    if (m_indexDirty) {
+        SaveIndex();
     }
+
+    return roms;
 }
 
-void ROMManager::ScanROMCarts(std::filesystem::path path, std::error_code &err) {
-    std::vector<char> buf{};
-    buf.resize(cart::kROMCartSize);
+void ROMManager::LoadIndex() {
+    m_index.clear();
+    m_indexDirty = false;
+    if (m_indexPath.empty()) {
+        return;
+    }
 
-    m_cartEntries.clear();
-    err.clear();
+    std::vector<uint8> data{};
+    {
+        std::ifstream in{m_indexPath, std::ios::binary | std::ios::ate};
+        if (!in) {
+            return;
+        }
+        data.resize(in.tellg());
+        in.seekg(0, std::ios::beg);
+        in.read(reinterpret_cast<char *>(data.data()), data.size());
+        if (!in) {
+            return;
+        }
+    }
 
-    for (const std::filesystem::directory_entry &dirEntry : std::filesystem::recursive_directory_iterator(path, err)) {
-        if (!dirEntry.is_regular_file()) {
-            continue;
+    size_t pos = 0;
+    auto has = [&](size_t size) { return data.size() - pos >= size; };
+    auto read = [&]<typename T>() {
+        const T value = util::ReadLE<T>(&data[pos]);
+        pos += sizeof(T);
+        return value;
+    };
+    auto readString = [&](size_t size) {
+        std::string str(reinterpret_cast<const char *>(&data[pos]), size);
+        pos += size;
+        return str;
+    };
+
+    if (!has(sizeof(kIndexMagic) + 8) || !std::equal(std::begin(kIndexMagic), std::end(kIndexMagic), data.begin())) {
+        return;
+    }
+    pos += sizeof(kIndexMagic);
+    if (read.operator()<uint32>() != kIndexVersion) {
+        return;
+    }
+
+    // Discard the whole index if it is malformed; the next scan rebuilds it
+    const uint32 count = read.operator()<uint32>();
+    for (uint32 i = 0; i < count; ++i) {
+        IndexEntry entry{};
+        if (!has(1 + 8 + 8 + 8 + entry.hash.size() + 2)) {
+            m_index.clear();
+            return;
         }
-        if (dirEntry.file_size() != cart::kROMCartSize) {
-            continue;
+        const uint8 kind = read.operator()<uint8>();
+        if (kind > static_cast<uint8>(ROMKind::Cart)) {
+            m_index.clear();
+            return;
         }
+        entry.kind = static_cast<ROMKind>(kind);
+        entry.size = read.operator()<uint64>();
+        entry.mtime = read.operator()<sint64>();
+        entry.fileID = read.operator()<uint64>();
+        std::copy_n(&data[pos], entry.hash.size(), entry.hash.begin());
+        pos += entry.hash.size();
 
-        // Read file into buffer
-        std::filesystem::path canonicalPath = std::filesystem::canonical(dirEntry.path());
-        {
-            std::ifstream in{canonicalPath, std::ios::binary};
-            in.read(buf.data(), buf.size());
-            if (!in) {
-                continue;
-            }
+        const uint16 versionLen = read.operator()<uint16>();
+        if (!has(versionLen + 4)) {
+            m_index.clear();
+            return;
         }
+        entry.versionString = readString(versionLen);
 
-        // Build entry
-        ROMCartEntry entry{};
-        entry.path = canonicalPath;
+        const uint32 pathLen = read.operator()<uint32>();
+        if (!has(pathLen)) {
+            m_index.clear();
+            return;
+        }
+        const std::string u8path = readString(pathLen);
+        std::filesystem::path path = std::u8string{u8path.begin(), u8path.end()};
+        m_index.insert_or_assign(std::move(path), std::move(entry));
+    }
+
+    devlog::debug<grp::rom_manager>("Loaded ROM index with {} entries from {}", m_index.size(), m_indexPath);
+}
 
-        // Get database entry
-        XXH128Hash hash = CalcHash128(buf.data(), buf.size(), cart::kROMCartHashSeed);
-        entry.info = db::GetROMCartInfo(hash);
-        entry.hash = hash;
+void ROMManager::SaveIndex() {
+    if (m_indexPath.empty()) {
+        return;
+    }
 
-        // Add it to the list (including unknown entries, in case the image is modified)
-        m_cartEntries.insert({canonicalPath, entry});
+    std::vector<uint8> data{};
+    auto write = [&]<typename T>(T value) {
+        const size_t pos = data.size();
+        data.resize(pos + sizeof(T));
+        util::WriteLE<T>(&data[pos], value);
+    };
+    auto writeBytes = [&](const void *bytes, size_t size) {
+        const auto *begin = static_cast<const uint8 *>(bytes);
+        data.insert(data.end(), begin, begin + size);
+    };
+
+    writeBytes(kIndexMagic, sizeof(kIndexMagic));
+    write(kIndexVersion);
+    write(static_cast<uint32>(m_index.size()));
+    for (const auto &[path, entry] : m_index) {
+        const std::u8string u8path = path.u8string();
+        write(static_cast<uint8>(entry.kind));
+        write(static_cast<uint64>(entry.size));
+        write(static_cast<sint64>(entry.mtime));
+        write(static_cast<uint64>(entry.fileID));
+        writeBytes(entry.hash.data(), entry.hash.size());
+        write(static_cast<uint16>(entry.versionString.size()));
+        writeBytes(entry.versionString.data(), entry.versionString.size());
+        write(static_cast<uint32>(u8path.size()));
+        writeBytes(u8path.data(), u8path.size());
+    }
+
+    // Write to a temporary file first so that an interrupted write doesn't leave a truncated index behind
+    std::error_code err{};
+    std::filesystem::create_directories(m_indexPath.parent_path(), err);
+    auto tmpPath = m_indexPath;
+    tmpPath += ".tmp";
+    {
+        std::ofstream out{tmpPath, std::ios::binary | std::ios::trunc};
+        out.write(reinterpret_cast<const char *>(data.data()), data.size());
+        if (!out) {
+            devlog::warn<grp::rom_manager>("Failed to write ROM index to {}", tmpPath);
+            return;
+        }
+    }
+    std::filesystem::rename(tmpPath, m_indexPath, err);
+    if (err) {
+        devlog::warn<grp::rom_manager>("Failed to write ROM index to {}: {}", m_indexPath, err.message());
+        return;
     }
+    m_indexDirty = false;
 }
 
 } // namespace app
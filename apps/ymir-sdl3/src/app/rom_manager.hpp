@@ -7,10 +7,16 @@
 #include <ymir/core/types.hpp>
 
 #include <filesystem>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace app {
 
+// Default ROM index file name, stored in the persistent state directory
+inline constexpr std::string_view kROMIndexFile = "rom-index.bin";
+
 struct IPLROMEntry {
     std::filesystem::path path;
     const ymir::db::IPLROMInfo *info = nullptr;
@@ -32,6 +38,10 @@ struct ROMCartEntry {
 
 class ROMManager {
 public:
+    // Uses the ROM index file at the given path to skip hashing unchanged files while scanning.
+    // Loads the index if it's not the one currently in use. An empty path disables the index.
+    void UseIndex(std::filesystem::path path);
+
     // Scans the given path recursively for IPL ROM files.
     void ScanIPLROMs(std::filesystem::path path);
 
@@ -57,6 +67,37 @@ public:
     }
 
 private:
+    enum class ROMKind : uint8 { IPL, CDBlock, Cart };
+
+    // Cached scan result for a ROM file, keyed by canonical path.
+    // The database entries are not stored; they're looked up from the hash, which is cheap.
+    struct IndexEntry {
+        ROMKind kind;
+        uintmax_t size;
+        sint64 mtime;
+        uint64 fileID;
+        ymir::XXH128Hash hash;
+        std::string versionString; // IPL ROMs only
+    };
+
+    struct ScannedROM {
+        std::filesystem::path path;
+        const IndexEntry *entry;
+    };
+
+    // Scans the given path recursively for ROM files of the given kind and size, returning the index entries for all
+    // files found. Only files missing from the index or modified since they were indexed are read and hashed; these
+    // are processed in parallel.
+    std::vector<ScannedROM> ScanROMs(const std::filesystem::path &path, ROMKind kind, uintmax_t romSize,
+                                     uint64 hashSeed, std::error_code &err);
+
+    void LoadIndex();
+    void SaveIndex();
+
+    std::filesystem::path m_indexPath;
+    std::unordered_map<std::filesystem::path, IndexEntry> m_index;
+    bool m_indexDirty = false;
+
     std::unordered_map<std::filesystem::path, IPLROMEntry> m_iplEntries;
     std::unordered_map<std::filesystem::path, CDBlockROMEntry> m_cdbEntries;
     std::unordered_map<std::filesystem::path, ROMCartEntry> m_cartEntries;
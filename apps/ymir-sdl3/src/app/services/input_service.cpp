@@ -323,7 +323,7 @@ InputService::InputService(SharedContext &context, Settings &settings, InputServ
     // Debugger
     {
         inputContext.SetTriggerHandler(actions::dbg::ToggleDebugTrace, [&](void *, const input::InputElement &) {
-            m_context.EnqueueEvent(events::emu::SetDebugTrace(!m_context.saturn.instance->IsDebugTracingEnabled()));
+            m_context.EnqueueEvent(events::emu::SetDebugTrace(!m_context.debugTracing.requested));
         });
         inputContext.SetTriggerHandler(actions::dbg::DumpMemory, [&](void *, const input::InputElement &) {
             m_context.EnqueueEvent(events::emu::DumpMemory());
@@ -890,6 +890,33 @@ void InputService::UpdateInputs(double timeDelta) {
             input.UpdateInputs();
         }
     }
+
+    PublishInputs();
+}
+
+void InputService::PublishChangedInputs() {
+    if (m_context.inputContext.GetHandledActionCount() != m_publishedActionCount) {
+        PublishInputs();
+    }
+}
+
+void InputService::PublishInputs() {
+    m_publishedActionCount = m_context.inputContext.GetHandledActionCount();
+
+    const uint64 timestamp =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clk::now().time_since_epoch()).count();
+
+    auto publish = [&]<int port>() {
+        const ymir::peripheral::PeripheralType type = m_settings.input.ports[port - 1].type;
+        if (type == ymir::peripheral::PeripheralType::None) {
+            return;
+        }
+        ymir::peripheral::PeripheralReport report{.type = type};
+        BuildReport<port>(report);
+        m_latches[port - 1].Publish(report, timestamp);
+    };
+    publish.operator()<1>();
+    publish.operator()<2>();
 }
 
 void InputService::DrawInputs(ImDrawList *drawList) {
@@ -953,6 +980,25 @@ std::pair<float, float> InputService::WindowToScreen(float x, float y) const {
 template <int port>
 void InputService::ReadPeripheral(ymir::peripheral::PeripheralReport &report) {
     // TODO: this is the appropriate location to capture inputs for a movie recording
+
+    // Latch the freshest snapshot published by the GUI thread. Fall back to building the report from the live input
+    // state if nothing has been published yet or the peripheral was swapped since the last snapshot.
+    ymir::peripheral::PeripheralReport latched{};
+    uint64 timestamp = 0;
+    if (m_latches[port - 1].Latch(latched, timestamp) && latched.type == report.type) {
+        report.report = latched.report;
+        if (m_context.inputLatency.enabled) {
+            const uint64 now =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(clk::now().time_since_epoch()).count();
+            m_context.inputLatency.histogram.Record(now - timestamp);
+        }
+        return;
+    }
+    BuildReport<port>(report);
+}
+
+template <int port>
+void InputService::BuildReport(ymir::peripheral::PeripheralReport &report) const {
     switch (report.type) {
     case ymir::peripheral::PeripheralType::ControlPad:
         report.report.controlPad.buttons = m_context.controlPadInputs[port - 1].buttons;
@@ -2,9 +2,11 @@
 
 #include <app/settings.hpp>
 #include <app/shared_context.hpp>
+#include <array>
 #include <functional>
 #include <imgui.h>
 #include <utility>
+#include <ymir/hw/smpc/peripheral/peripheral_latch.hpp>
 #include <ymir/hw/smpc/peripheral/peripheral_report.hpp>
 
 namespace app::services {
@@ -34,11 +36,21 @@ public:
     /// @param[in] timeDelta Seconds elapsed since the last update.
     void UpdateInputs(double timeDelta);
 
+    /// @brief Publishes the input state if any input action was handled since it was last published.
+    ///
+    /// Invoked while processing SDL events so that input changes reach the emulator thread without waiting for
+    /// `UpdateInputs` at the end of the GUI frame.
+    void PublishChangedInputs();
+
     /// @brief Draws lightgun crosshairs or other input overlays.
     /// @param[out] drawList ImGui draw list to render into.
     void DrawInputs(ImDrawList *drawList);
 
     /// @brief Reads input data from a specific controller port.
+    ///
+    /// Invoked by the emulator thread when the SMPC reads the peripherals. Uses the latest inputs published by
+    /// `UpdateInputs` or `PublishChangedInputs`.
+    ///
     /// @tparam port Port index.
     /// @param[out] report Report struct to fill with input data.
     template <int port>
@@ -47,9 +59,24 @@ public:
 private:
     std::pair<float, float> WindowToScreen(float x, float y) const;
 
+    /// @brief Builds a peripheral report from the current input state of a controller port.
+    /// @tparam port Port index.
+    /// @param[in,out] report Report struct to fill with input data. The type must be set by the caller.
+    template <int port>
+    void BuildReport(ymir::peripheral::PeripheralReport &report) const;
+
+    /// @brief Publishes a snapshot of the input state of both ports for the emulator thread to latch.
+    void PublishInputs();
+
     SharedContext &m_context;
     Settings &m_settings;
     InputServiceCallbacks m_callbacks;
+
+    // Freshest input snapshots for each port, published by the GUI thread and latched by the emulator thread
+    std::array<ymir::peripheral::PeripheralLatch, 2> m_latches;
+
+    // Input context action count as of the last published snapshot
+    uint64 m_publishedActionCount = 0;
 };
 
 } // namespace app::services
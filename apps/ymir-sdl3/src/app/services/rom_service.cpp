@@ -70,6 +70,7 @@ void ROMService::ScanIPLROMs() {
 
     {
         std::unique_lock lock{m_context.locks.romManager};
+        m_context.romManager.UseIndex(m_context.profile.GetPath(ProfilePath::PersistentState) / kROMIndexFile);
         m_context.romManager.ScanIPLROMs(romsPath);
     }
 
@@ -200,6 +201,7 @@ void ROMService::ScanCDBlockROMs() {
 
     {
         std::unique_lock lock{m_context.locks.romManager};
+        m_context.romManager.UseIndex(m_context.profile.GetPath(ProfilePath::PersistentState) / kROMIndexFile);
         m_context.romManager.ScanCDBlockROMs(romsPath);
     }
 
@@ -264,6 +266,7 @@ void ROMService::ScanROMCarts() {
 
     {
         std::unique_lock lock{m_context.locks.romManager};
+        m_context.romManager.UseIndex(m_context.profile.GetPath(ProfilePath::PersistentState) / kROMIndexFile);
         std::error_code error{};
         m_context.romManager.ScanROMCarts(romCartsPath, error);
         if (error) {
@@ -23,16 +23,167 @@
 
 #include <app/profile.hpp>
 #include <ymir/util/bitmask_enum.hpp>
+#include <ymir/util/data_ops.hpp>
 #include <ymir/util/dev_log.hpp>
+#include <ymir/util/thread_name.hpp>
+
+#include <lz4.h>
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
 
 using namespace app::savestates;
 using clk = std::chrono::steady_clock;
 
 namespace app::services {
 
+// -----------------------------------------------------------------------------
+// Compressed save state files
+//
+// Save states are serialized with the portable binary archive, split into chunks and compressed with LZ4 in parallel.
+// Layout (little-endian):
+//   char[8]  magic "YMSSLZ4\0"
+//   uint32   format version (1)
+//   uint32   chunk size
+//   uint64   uncompressed size
+//   uint32   number of chunks
+//   uint32[] compressed size of each chunk
+//   ...      compressed chunks
+// Files without the magic are uncompressed portable binary archives written by older versions.
+
+static constexpr char kCompressedMagic[8] = {'Y', 'M', 'S', 'S', 'L', 'Z', '4', '\0'};
+static constexpr uint32 kCompressedVersion = 1;
+static constexpr uint32 kChunkSize = 1u << 20u;
+static constexpr size_t kHeaderSize = sizeof(kCompressedMagic) + sizeof(uint32) * 2 + sizeof(uint64) + sizeof(uint32);
+
+// Serializes, compresses and writes the state to a temporary file, then renames it over the target path.
+static bool WriteStateFile(const ymir::savestate::SaveState &state, const std::filesystem::path &path) {
+    std::ostringstream serialized{std::ios::binary};
+    {
+        cereal::PortableBinaryOutputArchive archive{serialized};
+        archive(state);
+    }
+    const std::string raw = std::move(serialized).str();
+
+    // Compress chunks in parallel
+    const size_t numChunks = (raw.size() + kChunkSize - 1) / kChunkSize;
+    std::vector<std::vector<char>> chunks(numChunks);
+    auto compress = [&](size_t first, size_t stride) {
+        for (size_t i = first; i < numChunks; i += stride) {
+            const size_t offset = i * kChunkSize;
+            const int srcSize = static_cast<int>(std::min<size_t>(kChunkSize, raw.size() - offset));
+            auto &chunk = chunks[i];
+            chunk.resize(LZ4_compressBound(srcSize));
+            const int size = LZ4_compress_default(&raw[offset], chunk.data(), srcSize, chunk.size());
+            chunk.resize(size);
+        }
+    };
+    const size_t maxWorkers = std::clamp<size_t>(numChunks, 1, 8);
+    const size_t numWorkers = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, maxWorkers);
+    {
+        std::vector<std::jthread> workers;
+        for (size_t i = 1; i < numWorkers; ++i) {
+            workers.emplace_back(compress, i, numWorkers);
+        }
+        compress(0, numWorkers);
+    }
+    for (const auto &chunk : chunks) {
+        if (chunk.empty()) {
+            devlog::error<grp::base>("Could not compress save state for {}", path);
+            return false;
+        }
+    }
+
+    std::vector<uint8> header(kHeaderSize + numChunks * sizeof(uint32));
+    std::copy_n(kCompressedMagic, sizeof(kCompressedMagic), header.begin());
+    util::WriteLE<uint32>(&header[8], kCompressedVersion);
+    util::WriteLE<uint32>(&header[12], kChunkSize);
+    util::WriteLE<uint64>(&header[16], raw.size());
+    util::WriteLE<uint32>(&header[24], numChunks);
+    for (size_t i = 0; i < numChunks; ++i) {
+        util::WriteLE<uint32>(&header[kHeaderSize + i * sizeof(uint32)], chunks[i].size());
+    }
+
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    {
+        std::ofstream out{tmpPath, std::ios::binary | std::ios::trunc};
+        out.write(reinterpret_cast<const char *>(header.data()), header.size());
+        for (const auto &chunk : chunks) {
+            out.write(chunk.data(), chunk.size());
+        }
+        out.flush();
+        if (!out) {
+            devlog::error<grp::base>("Could not write save state to {}", tmpPath);
+            out.close();
+            std::error_code err{};
+            std::filesystem::remove(tmpPath, err);
+            return false;
+        }
+    }
+
+    std::error_code err{};
+    std::filesystem::rename(tmpPath, path, err);
+    if (err) {
+        devlog::error<grp::base>("Could not replace save state {}: {}", path, err.message());
+        std::filesystem::remove(tmpPath, err);
+        return false;
+    }
+    return true;
+}
+
+// Reads a save state file, decompressing it if needed, and returns the serialized state.
+// Throws std::runtime_error if the file is compressed and malformed.
+static std::string ReadStateFile(std::ifstream &in) {
+    std::string data{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    const bool compressed = data.size() >= kHeaderSize &&
+                            std::equal(std::begin(kCompressedMagic), std::end(kCompressedMagic), data.begin());
+    if (!compressed) {
+        // Uncompressed save state
+        return data;
+    }
+
+    const auto *bytes = reinterpret_cast<const uint8 *>(data.data());
+    const uint32 version = util::ReadLE<uint32>(&bytes[8]);
+    const uint32 chunkSize = util::ReadLE<uint32>(&bytes[12]);
+    const uint64 rawSize = util::ReadLE<uint64>(&bytes[16]);
+    const uint32 numChunks = util::ReadLE<uint32>(&bytes[24]);
+    if (version != kCompressedVersion || chunkSize == 0 || chunkSize > LZ4_MAX_INPUT_SIZE ||
+        numChunks != (rawSize + chunkSize - 1) / chunkSize ||
+        data.size() < kHeaderSize + static_cast<uint64>(numChunks) * sizeof(uint32)) {
+        throw std::runtime_error("invalid compressed save state header");
+    }
+
+    std::string raw(rawSize, '\0');
+    size_t offset = kHeaderSize + numChunks * sizeof(uint32);
+    for (uint32 i = 0; i < numChunks; ++i) {
+        const uint32 compSize = util::ReadLE<uint32>(&bytes[kHeaderSize + i * sizeof(uint32)]);
+        const uint64 rawOffset = static_cast<uint64>(i) * chunkSize;
+        const int expectedSize = static_cast<int>(std::min<uint64>(chunkSize, rawSize - rawOffset));
+        if (compSize > data.size() - offset ||
+            LZ4_decompress_safe(&data[offset], &raw[rawOffset], compSize, expectedSize) != expectedSize) {
+            throw std::runtime_error("corrupted compressed save state");
+        }
+        offset += compSize;
+    }
+    return raw;
+}
+
+// -----------------------------------------------------------------------------
+// Implementation
+
 SaveStateService::SaveStateService(SharedContext &context, Settings &settings)
     : m_context(context)
-    , m_settings(settings) {}
+    , m_settings(settings) {
+
+    m_persistThread = std::thread{[this] { PersistThread(); }};
+}
+
+SaveStateService::~SaveStateService() {
+    m_persistQueue.enqueue(PersistJob{.quit = true});
+    m_persistThread.join();
+}
 
 const Slot *SaveStateService::Peek(std::size_t slotIndex) noexcept {
     if (!IsValidIndex(slotIndex)) {
@@ -131,6 +282,7 @@ std::unique_ptr<ymir::savestate::SaveState> SaveStateService::PopUndoLoadState()
 }
 
 void SaveStateService::LoadSaveStates() {
+    WaitForPendingWrites();
     WriteSaveStateMeta();
 
     auto basePath = m_context.profile.GetPath(app::ProfilePath::SaveStates);
@@ -143,8 +295,9 @@ void SaveStateService::LoadSaveStates() {
             std::ifstream in{statePath, std::ios::binary};
 
             if (in) {
-                cereal::PortableBinaryInputArchive archive{in};
                 try {
+                    std::istringstream serialized{ReadStateFile(in), std::ios::binary};
+                    cereal::PortableBinaryInputArchive archive{serialized};
                     auto state = std::make_unique<ymir::savestate::SaveState>();
                     archive(*state);
                     entry.state.swap(state);
@@ -182,6 +335,8 @@ void SaveStateService::LoadSaveStates() {
 }
 
 void SaveStateService::ClearSaveStates() {
+    WaitForPendingWrites();
+
     auto basePath = m_context.profile.GetPath(app::ProfilePath::SaveStates);
     auto gameStatesPath = basePath / ymir::ToString(m_context.saturn.instance->GetDiscHash());
 
@@ -222,33 +377,70 @@ void SaveStateService::PersistSaveState(std::size_t slotIndex) {
         return;
     }
 
-    auto lock = std::unique_lock{saves.SlotMutex(slotIndex)};
+    PersistJob job{.slotIndex = slotIndex};
+    {
+        auto lock = std::unique_lock{saves.SlotMutex(slotIndex)};
 
-    // ensure to not dereference empty slots
-    auto *slot = saves.Peek(slotIndex);
-    if (slot) {
-        auto save = [&](const std::unique_ptr<ymir::savestate::SaveState> &state, std::string name) {
+        // ensure to not dereference empty slots
+        auto *slot = saves.Peek(slotIndex);
+        if (slot == nullptr || !slot->IsValid()) {
+            return;
+        }
+
+        // Snapshot the states; this is all the emulator thread may have to wait for
+        auto snapshot = [&](const std::unique_ptr<ymir::savestate::SaveState> &state, std::string name) {
             if (state) {
-                // Create directory for this game's save states
                 auto basePath = m_context.profile.GetPath(app::ProfilePath::SaveStates);
                 auto gameStatesPath = basePath / ymir::ToString(state->discHash);
-                std::filesystem::create_directories(gameStatesPath);
-
-                // Write save state
-                auto statePath = gameStatesPath / name;
-                std::ofstream out{statePath, std::ios::binary};
-                cereal::PortableBinaryOutputArchive archive{out};
-                archive(*state);
+                job.files.push_back({
+                    .path = gameStatesPath / name,
+                    .state = std::make_unique<ymir::savestate::SaveState>(*state),
+                });
             }
-            return state.get() != nullptr;
         };
+        snapshot(slot->primary.state, fmt::format("{}.savestate", slotIndex));
+        snapshot(slot->backup.state, fmt::format("{}-1.savestate", slotIndex));
+    }
+
+    WriteSaveStateMeta();
+
+    ++m_persistEnqueued;
+    m_persistQueue.enqueue(std::move(job));
+}
+
+void SaveStateService::WaitForPendingWrites() {
+    uint64 completed = m_persistCompleted.load(std::memory_order_acquire);
+    while (completed != m_persistEnqueued) {
+        m_persistCompleted.wait(completed, std::memory_order_acquire);
+        completed = m_persistCompleted.load(std::memory_order_acquire);
+    }
+}
+
+void SaveStateService::PersistThread() {
+    util::SetCurrentThreadName("Save state writer");
+
+    PersistJob job{};
+    while (true) {
+        m_persistQueue.wait_dequeue(job);
+        if (job.quit) {
+            break;
+        }
 
-        if (slot->IsValid()) {
-            save(slot->primary.state, fmt::format("{}.savestate", slotIndex));
-            save(slot->backup.state, fmt::format("{}-1.savestate", slotIndex));
-            WriteSaveStateMeta();
-            m_context.DisplayMessage(fmt::format("State {} saved", slotIndex + 1));
+        bool success = true;
+        for (const auto &file : job.files) {
+            std::error_code err{};
+            std::filesystem::create_directories(file.path.parent_path(), err);
+            success &= WriteStateFile(*file.state, file.path);
         }
+        if (success) {
+            m_context.DisplayMessage(fmt::format("State {} saved", job.slotIndex + 1));
+        } else {
+            m_context.DisplayMessage(fmt::format("Could not save state {}", job.slotIndex + 1));
+        }
+        job = {};
+
+        m_persistCompleted.fetch_add(1, std::memory_order_release);
+        m_persistCompleted.notify_all();
     }
 }
 
@@ -8,8 +8,14 @@
 #include <app/settings.hpp>
 #include <app/shared_context.hpp>
 
+#include <blockingconcurrentqueue.h>
+
 #include <array>
+#include <atomic>
+#include <filesystem>
 #include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 
 namespace app::services {
@@ -21,7 +27,7 @@ public:
     using SlotArray = std::array<savestates::Slot, kSlots>; // type alias for private member
 
     SaveStateService(SharedContext &context, Settings &settings);
-    ~SaveStateService() = default;
+    ~SaveStateService();
 
     /// @brief Retrieves the number of save state slots.
     /// @return the number of save state slots
@@ -123,9 +129,15 @@ public:
     void SelectSaveStateSlot(std::size_t slotIndex);
 
     /// @brief Writes the save state data for a slot to disk.
+    ///
+    /// Takes a snapshot of the slot's states and hands it over to a background writer which compresses and writes them
+    /// atomically. The slot is locked only for as long as it takes to copy the states.
     /// @param[in] slotIndex Slot index.
     void PersistSaveState(std::size_t slotIndex);
 
+    /// @brief Waits until all save states passed to `PersistSaveState` have been written to disk.
+    void WaitForPendingWrites();
+
     /// @brief Writes a metadata text file next to the save states on disk.
     void WriteSaveStateMeta();
 
@@ -149,6 +161,26 @@ private:
 
     // Undo load state support - stores the emulator state before loading
     std::unique_ptr<ymir::savestate::SaveState> m_undoLoadState{};
+
+    // Background save state writer
+
+    struct PersistFile {
+        std::filesystem::path path;
+        std::unique_ptr<ymir::savestate::SaveState> state;
+    };
+
+    struct PersistJob {
+        std::size_t slotIndex{};
+        std::vector<PersistFile> files{};
+        bool quit = false;
+    };
+
+    moodycamel::BlockingConcurrentQueue<PersistJob> m_persistQueue{};
+    uint64 m_persistEnqueued = 0;
+    std::atomic<uint64> m_persistCompleted = 0;
+    std::thread m_persistThread;
+
+    void PersistThread();
 };
 
 } // namespace app::services
@@ -23,6 +23,8 @@ WindowManagerService::WindowManagerService(SharedContext &context, Settings &set
     , m_vdpWindowSet(m_context)
     , m_cdblockWindowSet(m_context)
     , m_debugOutputWindow(m_context)
+    , m_cpuProfilerWindow(m_context)
+    , m_hostTimingWindow(m_context)
     , m_settingsWindow(m_context)
     , m_periphConfigWindow(m_context)
     , m_messageHistoryWindow(m_context)
@@ -48,6 +50,8 @@ void WindowManagerService::DrawWindows() {
     m_cdblockWindowSet.DisplayAll();
 
     m_debugOutputWindow.Display();
+    m_cpuProfilerWindow.Display();
+    m_hostTimingWindow.Display();
 
     for (auto &memView : m_memoryViewerWindows) {
         memView.Display();
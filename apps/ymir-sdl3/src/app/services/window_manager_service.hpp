@@ -16,6 +16,8 @@
 #include <app/ui/windows/update_window.hpp>
 
 #include <app/ui/windows/debug/cdblock_window_set.hpp>
+#include <app/ui/windows/debug/cpu_profiler_window.hpp>
+#include <app/ui/windows/debug/host_timing_window.hpp>
 #include <app/ui/windows/debug/debug_output_window.hpp>
 #include <app/ui/windows/debug/memory_viewer_window.hpp>
 #include <app/ui/windows/debug/scsp_window_set.hpp>
@@ -93,6 +95,12 @@ public:
     ui::DebugOutputWindow &DebugOutputWindow() {
         return m_debugOutputWindow;
     }
+    ui::CPUProfilerWindow &CPUProfilerWindow() {
+        return m_cpuProfilerWindow;
+    }
+    ui::HostTimingWindow &HostTimingWindow() {
+        return m_hostTimingWindow;
+    }
     std::vector<ui::MemoryViewerWindow> &MemoryViewerWindows() {
         return m_memoryViewerWindows;
     }
@@ -146,6 +154,8 @@ private:
     ui::CDBlockWindowSet m_cdblockWindowSet;
 
     ui::DebugOutputWindow m_debugOutputWindow;
+    ui::CPUProfilerWindow m_cpuProfilerWindow;
+    ui::HostTimingWindow m_hostTimingWindow;
 
     std::vector<ui::MemoryViewerWindow> m_memoryViewerWindows;
 
@@ -1008,6 +1008,7 @@ void Settings::ResetToDefaults() {
     general.rememberLastLoadedDisc = false;
     general.boostEmuThreadPriority = true;
     general.boostProcessPriority = true;
+    general.bindEmuMemoryToNUMANode = true;
     general.screenshotScale = 2;
 
     general.enableRewindBuffer = false;
@@ -1222,6 +1223,7 @@ SettingsLoadResult Settings::Load(const std::filesystem::path &path) {
         Parse(tblGeneral, "RememberLastLoadedDisc", general.rememberLastLoadedDisc);
         Parse(tblGeneral, "BoostEmuThreadPriority", general.boostEmuThreadPriority);
         Parse(tblGeneral, "BoostProcessPriority", general.boostProcessPriority);
+        Parse(tblGeneral, "BindEmuMemoryToNUMANode", general.bindEmuMemoryToNUMANode);
         Parse(tblGeneral, "EnableRewindBuffer", general.enableRewindBuffer);
         Parse(tblGeneral, "ScreenshotScale", general.screenshotScale);
         Parse(tblGeneral, "RewindCompressionLevel", general.rewindCompressionLevel);
@@ -1875,6 +1877,7 @@ SettingsSaveResult Settings::Save() {
             {"RememberLastLoadedDisc", general.rememberLastLoadedDisc},
             {"BoostEmuThreadPriority", general.boostEmuThreadPriority},
             {"BoostProcessPriority", general.boostProcessPriority},
+            {"BindEmuMemoryToNUMANode", general.bindEmuMemoryToNUMANode},
             {"EnableRewindBuffer", general.enableRewindBuffer},
             {"ScreenshotScale", general.screenshotScale},
             {"RewindCompressionLevel", general.rewindCompressionLevel},
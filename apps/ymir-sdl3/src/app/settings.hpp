@@ -144,6 +144,7 @@ struct Settings {
 
         bool boostEmuThreadPriority;
         bool boostProcessPriority;
+        bool bindEmuMemoryToNUMANode;
 
         int screenshotScale;
 
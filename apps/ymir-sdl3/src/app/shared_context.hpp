@@ -25,6 +25,11 @@
 
 #include <util/service_locator.hpp>
 
+#include <ymir/debug/host_timing.hpp>
+#include <ymir/debug/input_latency.hpp>
+#include <ymir/debug/pc_sampler.hpp>
+#include <ymir/debug/trace_recorder.hpp>
+
 #include <ymir/hw/smpc/peripheral/peripheral_state_common.hpp>
 
 #include <ymir/core/configuration.hpp>
@@ -39,6 +44,7 @@
 #include <blockingconcurrentqueue.h>
 
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <deque>
 #include <filesystem>
@@ -731,6 +737,37 @@ struct SharedContext {
         YGRTracer YGR;
     } tracers;
 
+    // Debug tracing stays enabled while it has users. The debug tracing toggle and binary trace recording each hold a
+    // reference, so stopping one never undoes the other. Only modified by the emulator thread.
+    struct DebugTracing {
+        std::atomic_bool requested = false; // State of the debug tracing toggle
+        uint32 refCount = 0;
+    } debugTracing;
+
+    // Binary trace recording. Only accessed by the emulator thread, except for the recording status.
+    struct TraceRecording {
+        ymir::debug::trace::TraceRecorder recorder;
+        uint64 frame = 0;
+    } traceRecording;
+
+    // Sampling CPU profiler. The sampler is attached to the emulator while enabled.
+    struct Profiler {
+        ymir::debug::PCSampler sampler;
+        std::atomic_bool enabled = false;
+    } profiler;
+
+    // Host per-component timing statistics. The statistics are attached to the emulator while enabled.
+    struct HostTiming {
+        ymir::debug::HostTimingStats stats;
+        std::atomic_bool enabled = false;
+    } hostTiming;
+
+    // Host input to INTBACK latency measurements. Samples are recorded by the peripheral report callbacks while enabled.
+    struct InputLatency {
+        ymir::debug::InputLatencyHistogram histogram;
+        std::atomic_bool enabled = false;
+    } inputLatency;
+
     struct Fonts {
         struct {
             ImFont *regular = nullptr;
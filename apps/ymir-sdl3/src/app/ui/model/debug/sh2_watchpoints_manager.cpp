@@ -1,6 +1,7 @@
 #include "sh2_watchpoints_manager.hpp"
 
-#include <ymir/hw/sh2/sh2.hpp>
+#include <app/events/emu_debug_event_factory.hpp>
+#include <app/shared_context.hpp>
 
 #include <fmt/format.h>
 
@@ -11,22 +12,23 @@ using namespace ymir;
 
 namespace app::ui {
 
-void SH2WatchpointsManager::Bind(sh2::SH2 &sh2) {
-    m_sh2 = &sh2;
-    m_sh2->ReplaceWatchpoints(BuildActiveWatchpointsSet());
+void SH2WatchpointsManager::Bind(SharedContext &context, bool master) {
+    m_context = &context;
+    m_master = master;
+    m_context->EnqueueEvent(events::emu::debug::ReplaceSH2Watchpoints(m_master, BuildActiveWatchpointsSet()));
 }
 
 void SH2WatchpointsManager::Unbind() {
-    if (m_sh2 != nullptr) {
-        m_sh2->ClearWatchpoints();
-        m_sh2 = nullptr;
+    if (m_context != nullptr) {
+        m_context->EnqueueEvent(events::emu::debug::ClearSH2Watchpoints(m_master));
+        m_context = nullptr;
     }
 }
 
 void SH2WatchpointsManager::AddWatchpoint(uint32 address, debug::WatchpointFlags flags) {
     m_watchpoints[address].flags |= flags;
-    if (m_sh2) {
-        m_sh2->AddWatchpoint(address, flags);
+    if (m_context) {
+        m_context->EnqueueEvent(events::emu::debug::AddSH2Watchpoint(m_master, address, flags));
     }
 }
 
@@ -35,15 +37,15 @@ void SH2WatchpointsManager::RemoveWatchpoint(uint32 address, debug::WatchpointFl
     if (m_watchpoints[address].flags == debug::WatchpointFlags::None) {
         m_watchpoints.erase(address);
     }
-    if (m_sh2) {
-        m_sh2->RemoveWatchpoint(address, flags);
+    if (m_context) {
+        m_context->EnqueueEvent(events::emu::debug::RemoveSH2Watchpoint(m_master, address, flags));
     }
 }
 
 void SH2WatchpointsManager::ClearWatchpoint(uint32 address) {
     if (m_watchpoints.erase(address) > 0) {
-        if (m_sh2) {
-            m_sh2->ClearWatchpointsAt(address);
+        if (m_context) {
+            m_context->EnqueueEvent(events::emu::debug::ClearSH2WatchpointsAt(m_master, address));
         }
     }
 }
@@ -62,10 +64,10 @@ bool SH2WatchpointsManager::MoveWatchpoint(uint32 address, uint32 newAddress) {
     const SH2Watchpoint wtpt = it->second;
     m_watchpoints.erase(it);
     m_watchpoints[newAddress] = wtpt;
-    if (m_sh2) {
-        m_sh2->ClearWatchpointsAt(address);
+    if (m_context) {
+        m_context->EnqueueEvent(events::emu::debug::ClearSH2WatchpointsAt(m_master, address));
         if (wtpt.enabled) {
-            m_sh2->AddWatchpoint(newAddress, wtpt.flags);
+            m_context->EnqueueEvent(events::emu::debug::AddSH2Watchpoint(m_master, newAddress, wtpt.flags));
         }
     }
     return true;
@@ -78,11 +80,11 @@ bool SH2WatchpointsManager::ToggleWatchpointEnabled(uint32 address) {
     }
     auto &wtpt = m_watchpoints[address];
     wtpt.enabled ^= true;
-    if (m_sh2) {
+    if (m_context) {
         if (wtpt.enabled) {
-            m_sh2->AddWatchpoint(address, wtpt.flags);
+            m_context->EnqueueEvent(events::emu::debug::AddSH2Watchpoint(m_master, address, wtpt.flags));
         } else {
-            m_sh2->ClearWatchpointsAt(address);
+            m_context->EnqueueEvent(events::emu::debug::ClearSH2WatchpointsAt(m_master, address));
         }
     }
     return wtpt.enabled;
@@ -90,15 +92,15 @@ bool SH2WatchpointsManager::ToggleWatchpointEnabled(uint32 address) {
 
 void SH2WatchpointsManager::ClearAllWatchpoints() {
     m_watchpoints.clear();
-    if (m_sh2) {
-        m_sh2->ClearWatchpoints();
+    if (m_context) {
+        m_context->EnqueueEvent(events::emu::debug::ClearSH2Watchpoints(m_master));
     }
 }
 
 void SH2WatchpointsManager::ReplaceWatchpoints(std::map<uint32, SH2Watchpoint> watchpoints) {
     m_watchpoints = watchpoints;
-    if (m_sh2) {
-        m_sh2->ReplaceWatchpoints(BuildActiveWatchpointsSet());
+    if (m_context) {
+        m_context->EnqueueEvent(events::emu::debug::ReplaceSH2Watchpoints(m_master, BuildActiveWatchpointsSet()));
     }
 }
 
@@ -117,11 +119,11 @@ bool SH2WatchpointsManager::EnableWatchpoint(uint32 address, bool enable) {
         return false;
     }
     it->second.enabled = enable;
-    if (m_sh2) {
+    if (m_context) {
         if (enable) {
-            m_sh2->AddWatchpoint(address, it->second.flags);
+            m_context->EnqueueEvent(events::emu::debug::AddSH2Watchpoint(m_master, address, it->second.flags));
         } else {
-            m_sh2->ClearWatchpointsAt(address);
+            m_context->EnqueueEvent(events::emu::debug::ClearSH2WatchpointsAt(m_master, address));
         }
     }
     return true;
@@ -141,7 +143,7 @@ bool SH2WatchpointsManager::CheckWatchpointCondition(uint32 address) const {
 }
 
 void SH2WatchpointsManager::LoadState(std::filesystem::path path) {
-    if (m_sh2 == nullptr) {
+    if (m_context == nullptr) {
         return;
     }
 
@@ -10,11 +10,11 @@
 // -----------------------------------------------------------------------------
 // Forward declarations
 
-namespace ymir::sh2 {
+namespace app {
 
-class SH2;
+struct SharedContext;
 
-} // namespace ymir::sh2
+} // namespace app
 
 // -----------------------------------------------------------------------------
 // Implementation
@@ -29,14 +29,16 @@ struct SH2Watchpoint {
 
 /// @brief Manages watchpoints on an SH2 instance.
 ///
-/// None of the method in this class are thread-safe. Methods touch the bound SH2 instance are annotated as such and
-/// require additional synchronization if the emulator runs in its own thread.
+/// None of the method in this class are thread-safe. Methods that update the bound SH2 instance are annotated as such.
+/// The updates are sent through the emulator event queue, so the SH2 instance's watchpoints are only ever modified by
+/// the emulator thread.
 class SH2WatchpointsManager {
 public:
-    /// @brief Binds the given SH2 instance to this manager.
+    /// @brief Binds the SH2 instance of the given context to this manager.
     /// Upon binding, the SH2 instance's watchpoints are replaced with this manager's.
-    /// @param[in] sh2 the SH2 instance to bind to
-    void Bind(ymir::sh2::SH2 &sh2);
+    /// @param[in] context the shared context containing the SH2 instance
+    /// @param[in] master whether to bind to the master (`true`) or slave (`false`) SH2
+    void Bind(SharedContext &context, bool master);
 
     /// @brief If an SH2 instance is bound, clears all of its watchpoints and unbinds it.
     void Unbind();
@@ -143,7 +145,8 @@ public:
     void SaveState(std::filesystem::path path) const;
 
 private:
-    ymir::sh2::SH2 *m_sh2 = nullptr;
+    SharedContext *m_context = nullptr;
+    bool m_master = true;
 
     std::map<uint32, SH2Watchpoint> m_watchpoints{};
 
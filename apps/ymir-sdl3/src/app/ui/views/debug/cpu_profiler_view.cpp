@@ -0,0 +1,170 @@
+#include "cpu_profiler_view.hpp"
+
+#include <app/events/emu_event_factory.hpp>
+#include <app/events/gui_event_factory.hpp>
+
+#include <util/sdl_file_dialog.hpp>
+
+#include <fmt/format.h>
+#include <fmt/std.h>
+
+#include <fstream>
+#include <memory>
+
+using namespace ymir;
+
+namespace app::ui {
+
+CPUProfilerView::CPUProfilerView(SharedContext &context)
+    : m_context(context) {}
+
+void CPUProfilerView::Display() {
+    auto &profiler = m_context.profiler;
+
+    const float paddingWidth = ImGui::GetStyle().FramePadding.x;
+    ImGui::PushFont(m_context.fonts.monospace.regular, m_context.fontSizes.medium);
+    const float hexCharWidth = ImGui::CalcTextSize("F").x;
+    ImGui::PopFont();
+
+    bool enabled = profiler.enabled;
+    if (ImGui::Checkbox("Enable sampling", &enabled)) {
+        m_context.EnqueueEvent(events::emu::SetPCSampling(enabled));
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Clear##profiler")) {
+        profiler.sampler.Clear();
+        m_nextRefreshTime = 0.0;
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(100.0f * m_context.displayScale);
+    uint64 interval = profiler.sampler.GetInterval();
+    if (ImGui::InputScalar("Interval (cycles)", ImGuiDataType_U64, &interval)) {
+        profiler.sampler.SetInterval(interval);
+    }
+
+    if (ImGui::Button("Load SH-2 symbols...")) {
+        m_context.EnqueueEvent(events::gui::OpenFile({
+            .dialogTitle = "Load SH-2 symbol map",
+            .filters = {{"Symbol maps (*.sym, *.map, *.txt)", "sym;map;txt"}, {"All files (*.*)", "*"}},
+            .userdata = this,
+            .callback = util::WrapSingleSelectionCallback<&CPUProfilerView::ProcessLoadSymbols,
+                                                          &util::NoopCancelFileDialogCallback,
+                                                          &CPUProfilerView::ProcessFileDialogError>,
+        }));
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Export collapsed stacks...")) {
+        m_context.EnqueueEvent(events::gui::SaveFile({
+            .dialogTitle = "Export collapsed stacks",
+            .defaultPath = m_context.profile.GetPath(ProfilePath::Dumps) / "profile.folded",
+            .filters = {{"Collapsed stacks (*.folded)", "folded"}, {"All files (*.*)", "*"}},
+            .userdata = this,
+            .callback = util::WrapSingleSelectionCallback<&CPUProfilerView::ProcessExportProfile,
+                                                          &util::NoopCancelFileDialogCallback,
+                                                          &CPUProfilerView::ProcessFileDialogError>,
+        }));
+    }
+
+    for (size_t i = 0; i < debug::kNumProfiledCPUs; ++i) {
+        const auto cpu = static_cast<debug::ProfiledCPU>(i);
+        if (i > 0) {
+            ImGui::SameLine();
+        }
+        if (ImGui::RadioButton(debug::GetProfiledCPUName(cpu).data(), m_selectedCPU == cpu)) {
+            m_selectedCPU = cpu;
+            m_nextRefreshTime = 0.0;
+        }
+    }
+    ImGui::SameLine();
+    if (ImGui::Checkbox("Group by function", &m_byFunction)) {
+        m_nextRefreshTime = 0.0;
+    }
+
+    // Sorting the full histogram is expensive; refresh a few times per second
+    if (ImGui::GetTime() >= m_nextRefreshTime) {
+        Refresh();
+        m_nextRefreshTime = ImGui::GetTime() + 0.5;
+    }
+
+    ImGui::Text("%" PRIu64 " samples", m_totalSamples);
+
+    if (ImGui::BeginTable("profiler_hot_spots", 4, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_ScrollY)) {
+        ImGui::TableSetupColumn("Address", ImGuiTableColumnFlags_WidthFixed, paddingWidth * 2 + hexCharWidth * 8);
+        ImGui::TableSetupColumn("Samples", ImGuiTableColumnFlags_WidthFixed, paddingWidth * 2 + hexCharWidth * 10);
+        ImGui::TableSetupColumn("%", ImGuiTableColumnFlags_WidthFixed, paddingWidth * 2 + hexCharWidth * 6);
+        ImGui::TableSetupColumn("Symbol", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableHeadersRow();
+
+        for (const auto &hotSpot : m_hotSpots) {
+            ImGui::TableNextRow();
+            if (ImGui::TableNextColumn()) {
+                ImGui::PushFont(m_context.fonts.monospace.regular, m_context.fontSizes.medium);
+                ImGui::Text("%08X", hotSpot.address);
+                ImGui::PopFont();
+            }
+            if (ImGui::TableNextColumn()) {
+                ImGui::PushFont(m_context.fonts.monospace.regular, m_context.fontSizes.medium);
+                ImGui::Text("%" PRIu64, hotSpot.samples);
+                ImGui::PopFont();
+            }
+            if (ImGui::TableNextColumn()) {
+                ImGui::PushFont(m_context.fonts.monospace.regular, m_context.fontSizes.medium);
+                ImGui::Text("%6.2f", m_totalSamples > 0 ? hotSpot.samples * 100.0 / m_totalSamples : 0.0);
+                ImGui::PopFont();
+            }
+            if (ImGui::TableNextColumn()) {
+                ImGui::TextUnformatted(hotSpot.name.c_str());
+            }
+        }
+
+        ImGui::EndTable();
+    }
+}
+
+void CPUProfilerView::Refresh() {
+    static constexpr size_t kMaxHotSpots = 256;
+    m_totalSamples = m_context.profiler.sampler.GetTotalSamples(m_selectedCPU);
+    m_hotSpots = m_context.profiler.sampler.GetHotSpots(m_selectedCPU, m_byFunction, kMaxHotSpots);
+}
+
+void CPUProfilerView::ProcessLoadSymbols(void *userdata, std::filesystem::path file, int filter) {
+    static_cast<CPUProfilerView *>(userdata)->LoadSymbols(file);
+}
+
+void CPUProfilerView::ProcessExportProfile(void *userdata, std::filesystem::path file, int filter) {
+    static_cast<CPUProfilerView *>(userdata)->ExportProfile(file);
+}
+
+void CPUProfilerView::ProcessFileDialogError(void *userdata, const char *errorMessage, int filter) {
+    static_cast<CPUProfilerView *>(userdata)->ShowErrorDialog(errorMessage);
+}
+
+void CPUProfilerView::LoadSymbols(std::filesystem::path file) {
+    auto symbols = std::make_shared<debug::SymbolMap>();
+    std::error_code error{};
+    if (!symbols->Load(file, error)) {
+        ShowErrorDialog(fmt::format("Could not load symbol map from {}: {}", file, error.message()).c_str());
+        return;
+    }
+    m_context.profiler.sampler.SetSymbolMap(debug::ProfiledCPU::MasterSH2, symbols);
+    m_context.profiler.sampler.SetSymbolMap(debug::ProfiledCPU::SlaveSH2, symbols);
+    m_context.DisplayMessage(fmt::format("Loaded {} symbols from {}", symbols->Size(), file));
+    m_nextRefreshTime = 0.0;
+}
+
+void CPUProfilerView::ExportProfile(std::filesystem::path file) {
+    std::filesystem::create_directories(file.parent_path());
+
+    std::ofstream out{file};
+    m_context.profiler.sampler.WriteCollapsedStacks(out);
+    if (!out) {
+        ShowErrorDialog(fmt::format("Could not write profile to {}", file).c_str());
+    }
+}
+
+void CPUProfilerView::ShowErrorDialog(const char *message) {
+    m_context.EnqueueEvent(events::gui::ShowError(message));
+}
+
+} // namespace app::ui
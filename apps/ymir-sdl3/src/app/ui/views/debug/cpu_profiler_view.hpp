@@ -0,0 +1,39 @@
+#pragma once
+
+#include <app/shared_context.hpp>
+
+#include <ymir/debug/pc_sampler.hpp>
+
+#include <filesystem>
+#include <vector>
+
+namespace app::ui {
+
+class CPUProfilerView {
+public:
+    CPUProfilerView(SharedContext &context);
+
+    void Display();
+
+private:
+    SharedContext &m_context;
+
+    ymir::debug::ProfiledCPU m_selectedCPU = ymir::debug::ProfiledCPU::MasterSH2;
+    bool m_byFunction = true;
+
+    std::vector<ymir::debug::PCSampler::HotSpot> m_hotSpots;
+    uint64 m_totalSamples = 0;
+    double m_nextRefreshTime = 0.0;
+
+    void Refresh();
+
+    static void ProcessLoadSymbols(void *userdata, std::filesystem::path file, int filter);
+    static void ProcessExportProfile(void *userdata, std::filesystem::path file, int filter);
+    static void ProcessFileDialogError(void *userdata, const char *errorMessage, int filter);
+
+    void LoadSymbols(std::filesystem::path file);
+    void ExportProfile(std::filesystem::path file);
+    void ShowErrorDialog(const char *message);
+};
+
+} // namespace app::ui
@@ -0,0 +1,123 @@
+#include "host_timing_view.hpp"
+
+#include <app/events/emu_event_factory.hpp>
+
+#include <fmt/format.h>
+
+#include <imgui.h>
+
+#include <string>
+
+using namespace ymir;
+
+namespace app::ui {
+
+HostTimingView::HostTimingView(SharedContext &context)
+    : m_context(context) {}
+
+void HostTimingView::Display() {
+    auto &hostTiming = m_context.hostTiming;
+
+    const float paddingWidth = ImGui::GetStyle().FramePadding.x;
+    ImGui::PushFont(m_context.fonts.monospace.regular, m_context.fontSizes.medium);
+    const float digitWidth = ImGui::CalcTextSize("0").x;
+    ImGui::PopFont();
+
+    if constexpr (!Ymir_HOST_TIMING) {
+        ImGui::TextWrapped("Host timing instrumentation is not compiled into this build. Rebuild with "
+                           "Ymir_ENABLE_HOST_TIMING to measure individual components.");
+        ImGui::Separator();
+    }
+
+    bool enabled = hostTiming.enabled;
+    if (ImGui::Checkbox("Enable host timing", &enabled)) {
+        m_context.EnqueueEvent(events::emu::SetHostTiming(enabled));
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset##host_timing")) {
+        m_context.EnqueueEvent(events::emu::ResetHostTiming());
+    }
+
+    // Values change every frame; refresh a few times per second to keep them readable
+    if (ImGui::GetTime() >= m_nextRefreshTime) {
+        m_lastFrame = hostTiming.stats.GetLastFrame();
+        m_totals = hostTiming.stats.GetTotals();
+        m_inputLatency = m_context.inputLatency.histogram.GetReport();
+        m_nextRefreshTime = ImGui::GetTime() + 0.25;
+    }
+
+    const double frames = static_cast<double>(m_totals.frames);
+    const double avgFrameMs = frames > 0 ? m_totals.frameTimeMs / frames : 0.0;
+    ImGui::Text("%" PRIu64 " frames, last %.3f ms, average %.3f ms, max %.3f ms", m_totals.frames,
+                m_lastFrame.frameTimeMs, avgFrameMs, m_totals.maxFrameTimeMs);
+
+    if (ImGui::BeginTable("host_timing", 5, ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("Component", ImGuiTableColumnFlags_WidthFixed, paddingWidth * 2 + digitWidth * 10);
+        ImGui::TableSetupColumn("Last (ms)", ImGuiTableColumnFlags_WidthFixed, paddingWidth * 2 + digitWidth * 10);
+        ImGui::TableSetupColumn("Avg (ms)", ImGuiTableColumnFlags_WidthFixed, paddingWidth * 2 + digitWidth * 10);
+        ImGui::TableSetupColumn("Max (ms)", ImGuiTableColumnFlags_WidthFixed, paddingWidth * 2 + digitWidth * 10);
+        ImGui::TableSetupColumn("Share of frame time", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableHeadersRow();
+
+        for (size_t i = 0; i < debug::kNumHostTimingComponents; ++i) {
+            const auto component = static_cast<debug::HostTimingComponent>(i);
+            const double totalMs = m_totals.componentTimeMs[i];
+            const double share = m_totals.frameTimeMs > 0.0 ? totalMs / m_totals.frameTimeMs : 0.0;
+
+            ImGui::TableNextRow();
+            if (ImGui::TableNextColumn()) {
+                ImGui::TextUnformatted(debug::GetHostTimingComponentName(component).data());
+            }
+            if (ImGui::TableNextColumn()) {
+                ImGui::PushFont(m_context.fonts.monospace.regular, m_context.fontSizes.medium);
+                ImGui::Text("%8.3f", m_lastFrame.componentTimeMs[i]);
+                ImGui::PopFont();
+            }
+            if (ImGui::TableNextColumn()) {
+                ImGui::PushFont(m_context.fonts.monospace.regular, m_context.fontSizes.medium);
+                ImGui::Text("%8.3f", frames > 0 ? totalMs / frames : 0.0);
+                ImGui::PopFont();
+            }
+            if (ImGui::TableNextColumn()) {
+                ImGui::PushFont(m_context.fonts.monospace.regular, m_context.fontSizes.medium);
+                ImGui::Text("%8.3f", m_totals.maxComponentTimeMs[i]);
+                ImGui::PopFont();
+            }
+            if (ImGui::TableNextColumn()) {
+                const std::string overlay = fmt::format("{:.1f}%", share * 100.0);
+                ImGui::ProgressBar(static_cast<float>(share), ImVec2(-FLT_MIN, 0.0f), overlay.c_str());
+            }
+        }
+
+        ImGui::EndTable();
+    }
+
+    ImGui::Separator();
+    DisplayInputLatency();
+}
+
+void HostTimingView::DisplayInputLatency() {
+    auto &inputLatency = m_context.inputLatency;
+
+    bool enabled = inputLatency.enabled;
+    if (ImGui::Checkbox("Measure input latency", &enabled)) {
+        inputLatency.enabled = enabled;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset##input_latency")) {
+        inputLatency.histogram.Reset();
+        m_inputLatency = {};
+    }
+    ImGui::TextWrapped("Time between the host inputs being sampled and the SMPC reading them through INTBACK.");
+
+    auto toMs = [](double ns) { return ns / 1000000.0; };
+    ImGui::PushFont(m_context.fonts.monospace.regular, m_context.fontSizes.medium);
+    ImGui::Text("%" PRIu64 " reads", m_inputLatency.count);
+    ImGui::Text("mean %8.3f ms  min %8.3f ms  max %8.3f ms", toMs(m_inputLatency.MeanNs()),
+                toMs(m_inputLatency.minNs), toMs(m_inputLatency.maxNs));
+    ImGui::Text("p50 <%7.3f ms  p95 <%7.3f ms  p99 <%7.3f ms", toMs(m_inputLatency.PercentileNs(0.50)),
+                toMs(m_inputLatency.PercentileNs(0.95)), toMs(m_inputLatency.PercentileNs(0.99)));
+    ImGui::PopFont();
+}
+
+} // namespace app::ui
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <app/shared_context.hpp>
+
+#include <ymir/debug/host_timing.hpp>
+#include <ymir/debug/input_latency.hpp>
+
+namespace app::ui {
+
+class HostTimingView {
+public:
+    HostTimingView(SharedContext &context);
+
+    void Display();
+
+private:
+    void DisplayInputLatency();
+
+    SharedContext &m_context;
+
+    ymir::debug::HostTimingReport m_lastFrame;
+    ymir::debug::HostTimingReport m_totals;
+    ymir::debug::InputLatencyReport m_inputLatency;
+    double m_nextRefreshTime = 0.0;
+};
+
+} // namespace app::ui
@@ -47,6 +47,13 @@ void GeneralSettingsView::Display() {
     widgets::ExplanationTooltip("Increases the emulator thread's priority, which may help reduce jitter.",
                                 m_context.displayScale);
 
+    MakeDirty(ImGui::Checkbox("Keep emulated memory local to the emulator thread", &settings.bindEmuMemoryToNUMANode));
+    widgets::ExplanationTooltip(
+        "On systems with multiple NUMA nodes (multi-socket or chiplet CPUs with separate memory controllers), moves the\n"
+        "emulated system's memory to the node the emulator thread runs on, reducing memory access latency.\n"
+        "Takes effect the next time Ymir is started. Only supported on Linux.",
+        m_context.displayScale);
+
     MakeDirty(ImGui::Checkbox("Preload disc images to RAM", &settings.preloadDiscImagesToRAM));
     widgets::ExplanationTooltip(
         "Preloads the entire disc image to memory.\n"
@@ -0,0 +1,23 @@
+#include "cpu_profiler_window.hpp"
+
+#include <imgui.h>
+
+namespace app::ui {
+
+CPUProfilerWindow::CPUProfilerWindow(SharedContext &context)
+    : WindowBase(context)
+    , m_cpuProfilerView(context) {
+
+    m_windowConfig.name = "CPU profiler";
+}
+
+void CPUProfilerWindow::PrepareWindow() {
+    ImGui::SetNextWindowSizeConstraints(ImVec2(480 * m_context.displayScale, 240 * m_context.displayScale),
+                                        ImVec2(FLT_MAX, FLT_MAX));
+}
+
+void CPUProfilerWindow::DrawContents() {
+    m_cpuProfilerView.Display();
+}
+
+} // namespace app::ui
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <app/ui/window_base.hpp>
+
+#include <app/ui/views/debug/cpu_profiler_view.hpp>
+
+namespace app::ui {
+
+class CPUProfilerWindow : public WindowBase {
+public:
+    CPUProfilerWindow(SharedContext &context);
+
+protected:
+    void PrepareWindow() override;
+    void DrawContents() override;
+
+private:
+    CPUProfilerView m_cpuProfilerView;
+};
+
+} // namespace app::ui
@@ -0,0 +1,23 @@
+#include "host_timing_window.hpp"
+
+#include <imgui.h>
+
+namespace app::ui {
+
+HostTimingWindow::HostTimingWindow(SharedContext &context)
+    : WindowBase(context)
+    , m_hostTimingView(context) {
+
+    m_windowConfig.name = "Host timing";
+}
+
+void HostTimingWindow::PrepareWindow() {
+    ImGui::SetNextWindowSizeConstraints(ImVec2(480 * m_context.displayScale, 200 * m_context.displayScale),
+                                        ImVec2(FLT_MAX, FLT_MAX));
+}
+
+void HostTimingWindow::DrawContents() {
+    m_hostTimingView.Display();
+}
+
+} // namespace app::ui
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <app/ui/window_base.hpp>
+
+#include <app/ui/views/debug/host_timing_view.hpp>
+
+namespace app::ui {
+
+class HostTimingWindow : public WindowBase {
+public:
+    HostTimingWindow(SharedContext &context);
+
+protected:
+    void PrepareWindow() override;
+    void DrawContents() override;
+
+private:
+    HostTimingView m_hostTimingView;
+};
+
+} // namespace app::ui
@@ -112,7 +112,7 @@ void SH2DebuggerWindow::DrawContents() {
     }
     if (ImGui::Shortcut(ImGuiKey_F11)) {
         // Toggle debug tracing
-        m_context.EnqueueEvent(events::emu::SetDebugTrace(!m_context.saturn.IsDebugTracingEnabled()));
+        m_context.EnqueueEvent(events::emu::SetDebugTrace(!m_context.debugTracing.requested));
     }
     if (ImGui::Shortcut(ImGuiKey_Space, baseFlags) || ImGui::Shortcut(ImGuiKey_R, baseFlags)) {
         // Pause/Resume
@@ -32,7 +32,7 @@ struct SH2WindowSet {
 
         auto &sh2 = context.saturn.GetSH2(master);
         debuggerModel.breakpoints.Bind(sh2);
-        debuggerModel.watchpoints.Bind(sh2);
+        debuggerModel.watchpoints.Bind(context, master);
     }
 
     void DisplayAll() {
@@ -3,6 +3,8 @@
 #if defined(_WIN32)
     #include <dwmapi.h>
     #include <fileapi.h>
+#else
+    #include <sys/stat.h>
 #endif
 
 #include <SDL3/SDL_video.h>
@@ -30,4 +32,27 @@ void SetFileHidden(std::filesystem::path path, bool hidden) {
 #endif
 }
 
+uint64_t GetFileID(const std::filesystem::path &path) {
+#if defined(_WIN32)
+    HANDLE file = CreateFileW(path.wstring().c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return 0;
+    }
+    BY_HANDLE_FILE_INFORMATION info{};
+    const bool result = GetFileInformationByHandle(file, &info);
+    CloseHandle(file);
+    if (!result) {
+        return 0;
+    }
+    return (static_cast<uint64_t>(info.nFileIndexHigh) << 32ull) | info.nFileIndexLow;
+#else
+    struct stat st{};
+    if (stat(path.c_str(), &st) != 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(st.st_ino);
+#endif
+}
+
 } // namespace util::os
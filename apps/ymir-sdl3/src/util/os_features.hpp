@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 
 struct SDL_Window;
@@ -17,4 +18,10 @@ void ConfigureWindowDecorations(SDL_Window *window);
 /// @param[in] hidden the value of the hidden attribute
 void SetFileHidden(std::filesystem::path path, bool hidden);
 
+/// @brief Retrieves a number that identifies the file within its volume (the inode number on POSIX systems, the file
+/// index on Windows). Together with the path, size and modification time, this detects files replaced in place.
+/// @param[in] path the path to the file
+/// @return the file identifier, or 0 if it cannot be determined
+uint64_t GetFileID(const std::filesystem::path &path);
+
 } // namespace util::os
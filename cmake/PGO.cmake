@@ -1,5 +1,7 @@
 set(_Ymir_PGO_MODULE_DIR "${CMAKE_CURRENT_LIST_DIR}")
 
+include(CheckCXXCompilerFlag)
+
 function(ymir_configure_pgo)
     # PGO control (tri-state)
     set(Ymir_PGO "OFF" CACHE STRING "Enable PGO (OFF, GENERATE, USE)")
@@ -9,6 +11,12 @@ function(ymir_configure_pgo)
     set(Ymir_PGO_DIR "${CMAKE_BINARY_DIR}/pgo-profdata" CACHE PATH "PGO profile data directory")
     set(Ymir_PGO_PROFDATA "${Ymir_PGO_DIR}/ymir.profdata" CACHE FILEPATH "Merged LLVM PGO profile data")
 
+    # Automated pipeline (ymir-pgo target)
+    option(Ymir_PGO_BOLT "Link with relocations and optimize ymir-headless with BOLT in the PGO pipeline" OFF)
+    set(Ymir_PGO_IPL "" CACHE FILEPATH "IPL ROM used by the PGO pipeline workload")
+    set(Ymir_PGO_WORKLOAD "" CACHE PATH "Input movie or directory of input movies replayed by the PGO pipeline")
+    set(Ymir_PGO_WORK_DIR "${CMAKE_BINARY_DIR}/pgo" CACHE PATH "Build trees and profile data of the PGO pipeline")
+
     # Validate user input
     string(TOUPPER "${Ymir_PGO}" _ymir_pgo_mode)
     if (NOT _ymir_pgo_mode STREQUAL "OFF" AND
@@ -18,6 +26,7 @@ function(ymir_configure_pgo)
     endif ()
 
     if (_ymir_pgo_mode STREQUAL "OFF")
+        _ymir_add_pgo_pipeline_target()
         return()
     endif ()
 
@@ -30,6 +39,7 @@ function(ymir_configure_pgo)
         if (_ymir_pgo_mode STREQUAL "GENERATE")
             add_compile_options(-fprofile-instr-generate)
             add_link_options(-fprofile-instr-generate)
+            _ymir_add_atomic_profile_update()
 
             # Helper target to merge profraw -> profdata.
             find_program(LLVM_PROFDATA_EXE llvm-profdata)
@@ -59,9 +69,20 @@ function(ymir_configure_pgo)
 
     # GCC PGO (Linux)
     elseif (CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        # Name .gcda files after object paths relative to the build tree instead of absolute paths, so that profiles
+        # from one build tree can be used by another
+        check_cxx_compiler_flag("-fprofile-prefix-path=${CMAKE_BINARY_DIR}" Ymir_HAS_PROFILE_PREFIX_PATH)
+        if (Ymir_HAS_PROFILE_PREFIX_PATH)
+            add_compile_options("-fprofile-prefix-path=${CMAKE_BINARY_DIR}")
+        else ()
+            message(WARNING "GCC does not support -fprofile-prefix-path; profiles can only be used by the build tree "
+                            "that generated them")
+        endif ()
+
         if (_ymir_pgo_mode STREQUAL "GENERATE")
             add_compile_options("-fprofile-generate=${Ymir_PGO_DIR}/gcc")
             add_link_options("-fprofile-generate=${Ymir_PGO_DIR}/gcc")
+            _ymir_add_atomic_profile_update()
         elseif (_ymir_pgo_mode STREQUAL "USE")
             add_compile_options("-fprofile-use=${Ymir_PGO_DIR}/gcc" -fprofile-correction)
             add_link_options("-fprofile-use=${Ymir_PGO_DIR}/gcc" -fprofile-correction)
@@ -69,4 +90,76 @@ function(ymir_configure_pgo)
     else ()
         message(WARNING "PGO requested, but compiler ${CMAKE_CXX_COMPILER_ID} is not handled in cmake/PGO.cmake")
     endif ()
+
+    # BOLT needs relocations to reorder code within functions
+    if (_ymir_pgo_mode STREQUAL "USE" AND Ymir_PGO_BOLT)
+        if (CMAKE_SYSTEM_NAME STREQUAL "Linux")
+            add_link_options(-Wl,--emit-relocs)
+        else ()
+            message(WARNING "Ymir_PGO_BOLT is only supported on Linux")
+        endif ()
+    endif ()
+endfunction()
+
+# The emulator runs several threads; without atomic counter updates, concurrent increments are lost and may corrupt the
+# profile
+function(_ymir_add_atomic_profile_update)
+    check_cxx_compiler_flag(-fprofile-update=atomic Ymir_HAS_PROFILE_UPDATE_ATOMIC)
+    if (Ymir_HAS_PROFILE_UPDATE_ATOMIC)
+        add_compile_options(-fprofile-update=atomic)
+    endif ()
+endfunction()
+
+# Adds the ymir-pgo target, which runs the PGO pipeline in cmake/PGOPipeline.cmake on separate build trees using the
+# compilers and settings of this build
+function(_ymir_add_pgo_pipeline_target)
+    if (Ymir_LIBRARY_ONLY OR NOT Ymir_ENABLE_YMIR_HEADLESS)
+        return()
+    endif ()
+    if (NOT CMAKE_CXX_COMPILER_ID MATCHES "Clang" AND NOT CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        return()
+    endif ()
+
+    find_program(LLVM_PROFDATA_EXE llvm-profdata)
+    find_program(LLVM_BOLT_EXE llvm-bolt)
+
+    # Forward settings that affect code generation so the pipeline builds the same code as this build tree
+    set(_forward_args "")
+    foreach (_var Ymir_AVX2 Ymir_ENABLE_IPO Ymir_EXTRA_INLINING Ymir_DEV_BUILD Ymir_ENABLE_DEVLOG
+                  Ymir_ENABLE_DEV_ASSERTIONS Ymir_ENABLE_HOST_TIMING Ymir_FEATUREFLAG_DEFAULT Ymir_FF_HOST_CD_DRIVES
+                  VCPKG_TARGET_TRIPLET)
+        if (DEFINED ${_var})
+            list(APPEND _forward_args "-D${_var}=${${_var}}")
+        endif ()
+    endforeach ()
+
+    # Reuse the packages vcpkg already installed for this build tree so that the pipeline works offline
+    if (DEFINED VCPKG_INSTALLED_DIR)
+        list(APPEND _forward_args "-DVCPKG_INSTALLED_DIR=${VCPKG_INSTALLED_DIR}" "-DVCPKG_MANIFEST_INSTALL=OFF")
+    endif ()
+
+    # Semicolons would split the list into separate command arguments
+    list(JOIN _forward_args "|" _forward_args)
+
+    add_custom_target(ymir-pgo
+        COMMAND ${CMAKE_COMMAND}
+            -D "SOURCE_DIR=${CMAKE_SOURCE_DIR}"
+            -D "WORK_DIR=${Ymir_PGO_WORK_DIR}"
+            -D "GENERATOR=${CMAKE_GENERATOR}"
+            -D "C_COMPILER=${CMAKE_C_COMPILER}"
+            -D "CXX_COMPILER=${CMAKE_CXX_COMPILER}"
+            -D "COMPILER_ID=${CMAKE_CXX_COMPILER_ID}"
+            -D "TOOLCHAIN_FILE=${CMAKE_TOOLCHAIN_FILE}"
+            -D "FORWARD_ARGS=${_forward_args}"
+            -D "IPL=${Ymir_PGO_IPL}"
+            -D "WORKLOAD=${Ymir_PGO_WORKLOAD}"
+            -D "BOLT=${Ymir_PGO_BOLT}"
+            -D "LLVM_PROFDATA_EXE=${LLVM_PROFDATA_EXE}"
+            -D "LLVM_BOLT_EXE=${LLVM_BOLT_EXE}"
+            -D "EXE_SUFFIX=${CMAKE_EXECUTABLE_SUFFIX}"
+            -P "${_Ymir_PGO_MODULE_DIR}/PGOPipeline.cmake"
+        COMMENT "Running the PGO pipeline in ${Ymir_PGO_WORK_DIR}"
+        USES_TERMINAL
+        VERBATIM
+    )
 endfunction()
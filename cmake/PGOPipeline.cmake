@@ -0,0 +1,160 @@
+# Runs the full profile-guided optimization pipeline:
+# 1. Configures and builds an instrumented ymir-headless
+# 2. Replays the input movies in the workload with the instrumented build, which also verifies that the replays are
+#    deterministic
+# 3. Merges the raw profiles (LLVM only; GCC reads .gcda files directly)
+# 4. Configures and builds ymir-core, ymir-headless and ymir-sdl3 with the merged profile
+# 5. Optionally optimizes the code layout of ymir-headless with BOLT, using an instrumented replay of the same workload
+#
+# Expected inputs:
+# - SOURCE_DIR: Ymir source directory
+# - WORK_DIR: directory for the generate and use build trees and the profile data
+# - GENERATOR: CMake generator
+# - CXX_COMPILER: C++ compiler to use; must be Clang or GCC
+# - COMPILER_ID: CMAKE_CXX_COMPILER_ID of the compiler
+# - IPL: path to the IPL ROM used for the replays
+# - WORKLOAD: input movie file or directory of input movies to replay
+# Optional inputs:
+# - C_COMPILER: C compiler to use
+# - TOOLCHAIN_FILE: CMake toolchain file (e.g. vcpkg)
+# - FORWARD_ARGS: |-separated list of -D cache arguments applied to both builds
+# - BOLT: ON to run the BOLT step
+# - LLVM_PROFDATA_EXE, LLVM_BOLT_EXE: paths to llvm-profdata and llvm-bolt
+# - EXE_SUFFIX: executable suffix of the platform
+foreach (_ymir_var SOURCE_DIR WORK_DIR GENERATOR CXX_COMPILER COMPILER_ID IPL WORKLOAD)
+    if (NOT DEFINED ${_ymir_var} OR "${${_ymir_var}}" STREQUAL "")
+        message(FATAL_ERROR "PGOPipeline.cmake requires ${_ymir_var}.")
+    endif ()
+endforeach ()
+
+if (NOT EXISTS "${IPL}")
+    message(FATAL_ERROR "IPL ROM not found: ${IPL}. Set Ymir_PGO_IPL to an IPL ROM image.")
+endif ()
+if (NOT EXISTS "${WORKLOAD}")
+    message(FATAL_ERROR "PGO workload not found: ${WORKLOAD}. Set Ymir_PGO_WORKLOAD to an input movie or a directory "
+                        "of input movies recorded with ymir-headless --record-movie.")
+endif ()
+
+string(REPLACE "|" ";" FORWARD_ARGS "${FORWARD_ARGS}")
+
+set(_ymir_gen_dir "${WORK_DIR}/gen")
+set(_ymir_use_dir "${WORK_DIR}/use")
+set(_ymir_profile_dir "${WORK_DIR}/profiles")
+set(_ymir_profdata "${_ymir_profile_dir}/ymir.profdata")
+
+# Settings that affect code generation must be identical in both builds for the profile to match
+set(_ymir_common_args
+    -G "${GENERATOR}"
+    -D CMAKE_BUILD_TYPE=Release
+    -D "CMAKE_CXX_COMPILER=${CXX_COMPILER}"
+    -D Ymir_ENABLE_TESTS=OFF
+    -D Ymir_ENABLE_SANDBOX=OFF
+    -D Ymir_ENABLE_YMDASM=OFF
+    -D Ymir_ENABLE_YMIR_DBG=OFF
+    -D Ymir_ENABLE_YMIR_HEADLESS=ON
+    -D "Ymir_PGO_DIR=${_ymir_profile_dir}"
+    -D "Ymir_PGO_PROFDATA=${_ymir_profdata}"
+    ${FORWARD_ARGS}
+)
+if (DEFINED C_COMPILER AND NOT C_COMPILER STREQUAL "")
+    list(APPEND _ymir_common_args -D "CMAKE_C_COMPILER=${C_COMPILER}")
+endif ()
+if (DEFINED TOOLCHAIN_FILE AND NOT TOOLCHAIN_FILE STREQUAL "")
+    list(APPEND _ymir_common_args -D "CMAKE_TOOLCHAIN_FILE=${TOOLCHAIN_FILE}")
+endif ()
+
+function(_ymir_pgo_run step)
+    message(STATUS "Ymir PGO: ${step}")
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE _result)
+    if (NOT _result EQUAL 0)
+        message(FATAL_ERROR "Ymir PGO: ${step} failed (${_result})")
+    endif ()
+endfunction()
+
+# Locates an executable in a build tree, accounting for multi-config generators
+function(_ymir_pgo_find_exe out build_dir subdir name)
+    foreach (_candidate
+             "${build_dir}/${subdir}/${name}${EXE_SUFFIX}"
+             "${build_dir}/${subdir}/Release/${name}${EXE_SUFFIX}")
+        if (EXISTS "${_candidate}")
+            set(${out} "${_candidate}" PARENT_SCOPE)
+            return()
+        endif ()
+    endforeach ()
+    message(FATAL_ERROR "Ymir PGO: could not find ${name} in ${build_dir}/${subdir}")
+endfunction()
+
+# Replays the workload with the given ymir-headless binary. The configuration file is empty so that the user's settings
+# don't leak into the profile. Fails if any replay diverges from its recording.
+function(_ymir_pgo_replay step headless)
+    file(WRITE "${WORK_DIR}/pgo-workload.toml" "")
+    _ymir_pgo_run("${step}"
+        "${CMAKE_COMMAND}" -E env "LLVM_PROFILE_FILE=${_ymir_profile_dir}/ymir_%m_%p.profraw"
+        "${headless}" bench
+            --config "${WORK_DIR}/pgo-workload.toml"
+            --ipl "${IPL}"
+            --bench-report "${WORK_DIR}/${step}.json"
+            "${WORKLOAD}"
+    )
+endfunction()
+
+# Start from a clean slate; stale profiles from previous runs would skew the results
+file(REMOVE_RECURSE "${_ymir_profile_dir}")
+file(MAKE_DIRECTORY "${_ymir_profile_dir}")
+
+_ymir_pgo_run("configure instrumented build"
+    "${CMAKE_COMMAND}" -S "${SOURCE_DIR}" -B "${_ymir_gen_dir}" ${_ymir_common_args}
+        -D Ymir_PGO=GENERATE
+        -D Ymir_PGO_BOLT=OFF)
+_ymir_pgo_run("build instrumented ymir-headless"
+    "${CMAKE_COMMAND}" --build "${_ymir_gen_dir}" --config Release --target ymir-headless --parallel)
+
+_ymir_pgo_find_exe(_ymir_gen_headless "${_ymir_gen_dir}" apps/ymir-headless ymir-headless)
+_ymir_pgo_replay("training-replay" "${_ymir_gen_headless}")
+
+if (COMPILER_ID MATCHES "Clang")
+    if (NOT DEFINED LLVM_PROFDATA_EXE OR NOT EXISTS "${LLVM_PROFDATA_EXE}")
+        message(FATAL_ERROR "Ymir PGO: llvm-profdata is required to merge Clang profiles")
+    endif ()
+    set(PGO_DIR "${_ymir_profile_dir}")
+    set(PGO_PROFDATA "${_ymir_profdata}")
+    include("${CMAKE_CURRENT_LIST_DIR}/PGOMerge.cmake")
+endif ()
+
+_ymir_pgo_run("configure optimized build"
+    "${CMAKE_COMMAND}" -S "${SOURCE_DIR}" -B "${_ymir_use_dir}" ${_ymir_common_args}
+        -D Ymir_PGO=USE
+        -D "Ymir_PGO_BOLT=${BOLT}")
+_ymir_pgo_run("build optimized targets"
+    "${CMAKE_COMMAND}" --build "${_ymir_use_dir}" --config Release --parallel
+        --target ymir-core ymir-headless ymir-sdl3)
+
+_ymir_pgo_find_exe(_ymir_use_headless "${_ymir_use_dir}" apps/ymir-headless ymir-headless)
+_ymir_pgo_replay("verification-replay" "${_ymir_use_headless}")
+
+if (BOLT)
+    if (NOT DEFINED LLVM_BOLT_EXE OR NOT EXISTS "${LLVM_BOLT_EXE}")
+        message(FATAL_ERROR "Ymir PGO: llvm-bolt is required for the BOLT step")
+    endif ()
+
+    # BOLT profiles are tied to the exact binary they were collected from, so only ymir-headless, which can replay the
+    # workload, is post-link optimized
+    set(_ymir_bolt_dir "${WORK_DIR}/bolt")
+    set(_ymir_bolt_fdata "${_ymir_bolt_dir}/ymir-headless.fdata")
+    file(REMOVE_RECURSE "${_ymir_bolt_dir}")
+    file(MAKE_DIRECTORY "${_ymir_bolt_dir}")
+
+    _ymir_pgo_run("instrument ymir-headless with BOLT"
+        "${LLVM_BOLT_EXE}" "${_ymir_use_headless}" -instrument
+            "-instrumentation-file=${_ymir_bolt_fdata}"
+            -o "${_ymir_bolt_dir}/ymir-headless-instrumented${EXE_SUFFIX}")
+    _ymir_pgo_replay("bolt-training-replay" "${_ymir_bolt_dir}/ymir-headless-instrumented${EXE_SUFFIX}")
+    _ymir_pgo_run("optimize ymir-headless layout with BOLT"
+        "${LLVM_BOLT_EXE}" "${_ymir_use_headless}" "-data=${_ymir_bolt_fdata}"
+            -reorder-blocks=ext-tsp -reorder-functions=cdsort -split-functions -split-all-cold -icf=1 -dyno-stats
+            -o "${_ymir_bolt_dir}/ymir-headless${EXE_SUFFIX}")
+    _ymir_pgo_replay("bolt-verification-replay" "${_ymir_bolt_dir}/ymir-headless${EXE_SUFFIX}")
+    message(STATUS "Ymir PGO: BOLT-optimized ymir-headless written to ${_ymir_bolt_dir}")
+endif ()
+
+message(STATUS "Ymir PGO: optimized build tree is ${_ymir_use_dir}")
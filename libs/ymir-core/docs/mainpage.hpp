@@ -40,7 +40,11 @@ You can configure several parameters of the emulator core through `ymir::Saturn:
 
 Use `ymir::Saturn::LoadIPL` to copy an IPL ROM image into the emulator. By default, the emulator will use a simple
 do-nothing image that puts the master SH-2 into an infinite loop and immediately returns from all exceptions. The IPL
-ROM is accessible through the `ymir::Saturn::mem` member, in `ymir::sys::SystemMemory::IPL`.
+ROM is accessible through the `ymir::Saturn::mem` member with `ymir::sys::SystemMemory::GetIPL`.
+
+`ymir::Saturn::LoadIPL` and `ymir::cart::ROMCartridge::LoadROM` also accept a `util::SharedMemory` object, which is
+mapped read-only into the emulator instead of copied. Instances that load the same image share the same physical
+memory; `ymir::sys::SharedROMPool` deduplicates images by content.
 
 CD Block ROMs (required for low level emulation) can be loaded directly into the SH-1's internal ROM area with
 `ymir::sh1::SH1::LoadROM`. By default it also uses the same do-nothing image used with the SH-2s.
@@ -211,6 +215,20 @@ You probably want to accumulate those samples into a ring buffer before sending
 
 Use `ymir::scsp::SCSP::SetSampleCallback` to bind this callback.
 
+Alternatively, the SCSP can deliver samples in blocks, which is cheaper and allows the frontend to resample and pace
+audio outside of the emulation loop. The block callback is invoked whenever the internal block buffer fills up and at
+the end of every frame. The callback signature is:
+
+```cpp
+void SCSPSampleBlockCallback(std::span<const ymir::scsp::OutputSample> samples, void *userContext)
+```
+
+where:
+- `samples` contains consecutive stereo samples in the same format as above; the span is only valid during the call
+- `userContext` is a user-provided context pointer
+
+Use `ymir::scsp::SCSP::SetSampleBlockCallback` to bind this callback. Both callbacks may be bound at the same time.
+
 You can run the emulator core without providing video and audio callbacks (headless mode). It will work fine, but you
 won't receive video frames or audio samples. For optimal performance in this scenario, use the null VDP renderer.
 
@@ -70,6 +70,9 @@
 @namespace ymir::debug
 @brief Debugging framework.
 
+@namespace ymir::debug::trace
+@brief Binary trace recording and reading.
+
 @namespace ymir::m68k
 @brief MC68EC000 emulation.
 
@@ -112,6 +115,9 @@
 @namespace ymir::savestate
 @brief Ymir save state structure definitions.
 
+@namespace ymir::savestate::binary
+@brief Native fixed-layout binary save state format.
+
 @namespace ymir::sys
 @brief Sega Saturn system components emulation.
 
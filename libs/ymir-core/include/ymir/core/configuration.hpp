@@ -75,6 +75,25 @@ struct Configuration {
         /// slowly and, while going faster technically is feasible, a 2.8 GHz SH2 is already too much to emulate, let
         /// alone two of them.
         util::Observable<RatioU32, ClampSH2ClockRatio> sh2ClockFactor = RatioU32::FromPercentage(100u);
+
+        /// @brief Allows the SMPC to enable the slave SH-2.
+        ///
+        /// When disabled, SSHON commands are ignored and the slave SH-2 stays halted. Software that relies on the slave
+        /// SH-2 will misbehave; this is meant for diagnostics and for measuring the cost of emulating it.
+        ///
+        /// Takes effect on the next SSHON command or reset.
+        bool slaveSH2Enabled = true;
+
+        /// @brief Runs the slave SH-2 in a dedicated thread.
+        ///
+        /// Instead of alternating with the master SH-2 every few cycles on the emulator thread, the slave SH-2 follows
+        /// the master SH-2 one step behind on its own thread while the SCU is idle. Work RAM accesses of both SH-2s are
+        /// tracked; if they depend on the order of execution or the slave SH-2 touches any device, the timeslice is
+        /// rolled back and rerun on the emulator thread. The timeslice also continues on the emulator thread once the
+        /// master SH-2 touches a device. The output is identical to running without this option.
+        ///
+        /// Has no effect while debug tracing is enabled.
+        util::Observable<bool> threadedSlaveSH2 = false;
     } system;
 
     /// @brief RTC configuration
@@ -122,7 +141,10 @@ struct Configuration {
 
         /// @brief Runs the SCSP and MC68EC000 CPU in a dedicated thread.
         ///
-        /// Currently unimplemented.
+        /// Produces the same output as single-threaded mode. While the SCU sound request interrupt is enabled, the
+        /// SCSP thread runs in lockstep with the emulator thread.
+        ///
+        /// When enabled, the sample callbacks are invoked from the SCSP thread.
         util::Observable<bool> threadedSCSP = false;
     } audio;
 
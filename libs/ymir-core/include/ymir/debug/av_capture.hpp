@@ -0,0 +1,210 @@
+#pragma once
+
+/**
+@file
+@brief Defines `ymir::debug::AVCapture`, a lossless audio/video capture pipeline.
+*/
+
+#include <ymir/hw/scsp/scsp_callbacks.hpp>
+
+#include <ymir/core/types.hpp>
+
+#include <blockingconcurrentqueue.h>
+
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace ymir::debug {
+
+/// @brief Captures emulator video and audio output to lossless files.
+///
+/// Video is written as a YUV4MPEG2 (Y4M) stream with full-range BT.601 4:4:4 frames. Audio is written as a 16-bit
+/// stereo 44100 Hz WAV file. Encoding and file output happen on one dedicated writer thread per stream.
+///
+/// Both streams are synchronized to emulated time, measured in SCSP output samples (44100 per emulated second; see
+/// `scsp::SCSP::GetOutputSampleCount()`). Call `MarkFrame` with the current sample count after every emulated frame.
+/// The video stream has a constant frame rate: the image rendered during each emulated frame fills every output frame
+/// that starts within it, duplicating or dropping images as needed when the rates differ. The audio stream is padded
+/// with silence or truncated to end at the same point in emulated time as the video stream.
+///
+/// Producers never block on the writers. Frames and sample blocks are copied into pooled buffers and handed over
+/// through lock-free queues. If a writer falls behind and its pool runs out, images are dropped (the previous image
+/// is repeated in their place) and samples are replaced with silence, preserving synchronization.
+///
+/// Feed `ReceiveFrame` from the VDP software render callback and `ReceiveSamples` from the SCSP sample block callback.
+/// `ReceiveFrame` may be called from the VDP2 render thread; the image rendered last when `MarkFrame` is called is
+/// assigned to that frame, so with the threaded VDP2 renderer images may lag behind by one frame. `ReceiveSamples` must
+/// be called from a single thread at a time.
+///
+/// `Start()` and `Stop()` must not be called while the producers may be invoked. Samples still buffered by the
+/// threaded SCSP when starting or stopping are not accounted for; flush the SCSP output beforehand for exact results.
+class AVCapture {
+public:
+    /// @brief Maximum number of frame buffers allocated by the capture.
+    static constexpr size_t kMaxFrames = 32;
+
+    /// @brief Number of samples per audio block.
+    static constexpr size_t kAudioBlockSize = 2048;
+
+    /// @brief Maximum number of audio blocks allocated by the capture.
+    static constexpr size_t kMaxAudioBlocks = 64;
+
+    /// @brief Capture settings.
+    struct Settings {
+        std::optional<std::filesystem::path> videoPath; ///< Y4M output path; absent to skip video
+        std::optional<std::filesystem::path> audioPath; ///< WAV output path; absent to skip audio
+        uint32 frameRateNum = 60000;                     ///< Video frame rate numerator
+        uint32 frameRateDen = 1001;                      ///< Video frame rate denominator
+    };
+
+    AVCapture();
+    ~AVCapture();
+
+    AVCapture(const AVCapture &) = delete;
+    AVCapture &operator=(const AVCapture &) = delete;
+
+    /// @brief Starts capturing into the specified files, replacing their contents.
+    /// Stops the current capture if there is one.
+    /// @param[in] settings the capture settings
+    /// @param[in] startSampleTime the current SCSP output sample count
+    /// @param[out] error receives the filesystem error if a file could not be created
+    /// @return `true` if the capture started successfully
+    bool Start(const Settings &settings, uint64 startSampleTime, std::error_code &error);
+
+    /// @brief Ends the capture at the last frame marker, waits for the writer threads to finish and closes the files.
+    void Stop();
+
+    /// @brief Determines if a capture is in progress.
+    /// @return `true` if capturing
+    [[nodiscard]] bool IsCapturing() const {
+        return m_capturing;
+    }
+
+    /// @brief Copies a rendered frame. Does nothing if not capturing.
+    /// @param[in] fb the framebuffer in XBGR8888 format
+    /// @param[in] width the framebuffer width
+    /// @param[in] height the framebuffer height
+    void ReceiveFrame(const uint32 *fb, uint32 width, uint32 height);
+
+    /// @brief Copies a block of output samples. Does nothing if not capturing.
+    /// @param[in] samples the samples
+    void ReceiveSamples(std::span<const scsp::OutputSample> samples);
+
+    /// @brief Marks the end of an emulated frame, submitting the image rendered last to the video writer.
+    /// Must be called from the emulator thread.
+    /// @param[in] sampleTime the current SCSP output sample count
+    void MarkFrame(uint64 sampleTime);
+
+    /// @brief Capture statistics.
+    struct Stats {
+        uint64 framesReceived = 0;   ///< Number of images received
+        uint64 framesDropped = 0;    ///< Images that did not make it into the video stream
+        uint64 framesWritten = 0;    ///< Number of video frames written
+        uint64 framesDuplicated = 0; ///< Video frames that repeat the previous image
+        uint64 samplesWritten = 0;   ///< Number of audio samples written, including padding
+        uint64 samplesDropped = 0;   ///< Samples replaced with silence because the pool was exhausted
+        bool writeError = false;     ///< Whether a write error has occurred
+    };
+
+    /// @brief Retrieves the statistics of the current or last capture.
+    /// Only accounts for data already processed by the writer threads.
+    /// @return the capture statistics
+    [[nodiscard]] Stats GetStats() const;
+
+private:
+    std::atomic_bool m_capturing = false;
+
+    uint64 m_startSampleTime = 0;
+    uint64 m_lastMarkTime = 0; // Relative to m_startSampleTime
+
+    // -------------------------------------------------------------------------
+    // Video
+
+    struct Frame {
+        std::vector<uint32> pixels;
+        uint32 width = 0;
+        uint32 height = 0;
+    };
+
+    struct FrameMarker {
+        Frame *frame; // nullptr to repeat the previous image
+        uint64 time;  // End of the emulated frame, relative to the start of the capture
+        bool end;     // Ends the stream at the specified time
+    };
+
+    bool m_videoEnabled = false;
+    uint32 m_frameRateNum = 60000;
+    uint32 m_frameRateDen = 1001;
+
+    // Frame buffer pool
+    std::mutex m_frameAllocMutex;
+    std::vector<std::unique_ptr<Frame>> m_frames;
+    moodycamel::ConcurrentQueue<Frame *> m_freeFrames;
+
+    // Most recently rendered image not yet assigned to a frame
+    std::atomic<Frame *> m_latestFrame = nullptr;
+
+    std::thread m_videoThread;
+    moodycamel::BlockingConcurrentQueue<FrameMarker> m_pendingFrames;
+    std::ofstream m_videoOut;
+
+    void VideoWriterThread();
+
+    // -------------------------------------------------------------------------
+    // Audio
+
+    struct AudioBlock {
+        std::array<scsp::OutputSample, kAudioBlockSize> samples;
+        uint32 count = 0;
+        uint64 silenceBefore = 0; // Samples dropped before this block
+    };
+
+    bool m_audioEnabled = false;
+
+    // Audio block pool
+    std::vector<std::unique_ptr<AudioBlock>> m_audioBlocks;
+    moodycamel::ConcurrentQueue<AudioBlock *> m_freeAudioBlocks;
+
+    // Producer state
+    AudioBlock *m_audioBlock = nullptr;
+    uint64 m_droppedSamples = 0;
+
+    // Total length of the audio stream; written before the end sentinel is submitted
+    uint64 m_audioLength = 0;
+
+    // Size to truncate the audio file to after closing it, or zero to leave it as is
+    uint64 m_audioFileSize = 0;
+    std::filesystem::path m_audioPath;
+
+    std::thread m_audioThread;
+    moodycamel::BlockingConcurrentQueue<AudioBlock *> m_pendingAudioBlocks;
+    std::ofstream m_audioOut;
+
+    /// @brief Acquires a free audio block, allocating a new one if the pool is empty and the limit has not been
+    /// reached. Returns `nullptr` if the pool is exhausted.
+    AudioBlock *AcquireAudioBlock();
+
+    void AudioWriterThread();
+
+    // -------------------------------------------------------------------------
+    // Statistics
+
+    std::atomic_uint64_t m_statFramesReceived = 0;
+    std::atomic_uint64_t m_statFramesDropped = 0;
+    std::atomic_uint64_t m_statFramesWritten = 0;
+    std::atomic_uint64_t m_statFramesDuplicated = 0;
+    std::atomic_uint64_t m_statSamplesWritten = 0;
+    std::atomic_uint64_t m_statSamplesDropped = 0;
+    std::atomic_bool m_writeError = false;
+};
+
+} // namespace ymir::debug
@@ -0,0 +1,190 @@
+#pragma once
+
+/**
+@file
+@brief Host-side per-component timing instrumentation.
+
+Defines `ymir::debug::HostTimingStats`, which aggregates the host time spent emulating each component per frame, and
+the `YMIR_HOST_TIMER(stats, component)` macro that measures the enclosing scope.
+
+Instrumentation must be enabled by defining the `Ymir_HOST_TIMING` macro with a truthy value (CMake option
+`Ymir_ENABLE_HOST_TIMING`). When disabled, `YMIR_HOST_TIMER` expands to nothing and the emulator never reads the host
+clock. `HostTimingStats` remains available in both cases so that frontends do not need conditional compilation; it
+simply reports zero component times when instrumentation is compiled out.
+*/
+
+/**
+@def YMIR_HOST_TIMER
+@brief Measures the host time spent in the enclosing scope and adds it to a component's counter.
+@param[in] stats a pointer to the `ymir::debug::HostTimingStats` to update; may be `nullptr`
+@param[in] component the `ymir::debug::HostTimingComponent` to charge
+*/
+
+#include <ymir/core/types.hpp>
+
+#include <ymir/util/inline.hpp>
+
+#include <array>
+#include <atomic>
+#include <string_view>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+    #define Ymir_HOST_TIMING_USE_TSC 1
+#else
+    #include <chrono>
+    #define Ymir_HOST_TIMING_USE_TSC 0
+#endif
+
+namespace ymir::debug {
+
+/// @brief Emulated components measured by host timing instrumentation.
+enum class HostTimingComponent : uint8 {
+    SH2,     ///< Master and slave SH-2 execution
+    SCU,     ///< SCU DMA and DSP
+    VDP1,    ///< VDP1 command processing and drawing
+    VDP2,    ///< VDP2 line rendering and composition
+    SCSP,    ///< SCSP slot processing, DSP and MC68EC000
+    CDBlock, ///< High-level CD block command and drive processing
+    SH1,     ///< CD block SH-1 (low-level CD block emulation)
+};
+
+/// @brief The number of components measured by host timing instrumentation.
+inline constexpr size_t kNumHostTimingComponents = 7;
+
+/// @brief Retrieves the name of a host timing component.
+/// @param[in] component the component
+/// @return the component name
+[[nodiscard]] std::string_view GetHostTimingComponentName(HostTimingComponent component);
+
+/// @brief Reads the host timestamp counter.
+///
+/// Uses the CPU timestamp counter on x86 hosts and the steady clock elsewhere. Ticks are converted to nanoseconds by
+/// `HostTimingStats`, which calibrates the counter against the steady clock on every frame.
+///
+/// @return the current host tick count
+FORCE_INLINE uint64 ReadHostTicks() {
+#if Ymir_HOST_TIMING_USE_TSC
+    return __rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+/// @brief Host timings of a single frame or an aggregate of frames.
+struct HostTimingReport {
+    uint64 frames = 0;         ///< Number of frames covered by this report
+    double frameTimeMs = 0.0;  ///< Total host wall time of the covered frames in milliseconds
+    double maxFrameTimeMs = 0; ///< Longest frame time in milliseconds
+
+    /// @brief Host time spent on each component in milliseconds. Indexed by `HostTimingComponent`.
+    std::array<double, kNumHostTimingComponents> componentTimeMs{};
+
+    /// @brief Longest time spent on each component in a single frame, in milliseconds.
+    std::array<double, kNumHostTimingComponents> maxComponentTimeMs{};
+};
+
+/// @brief Aggregates host time spent on each emulated component.
+///
+/// Instrumented code adds tick counts to per-component accumulators with relaxed atomic additions, which may happen
+/// concurrently from the emulator, renderer and SCSP threads. `EndFrame()` is invoked by the emulator thread once per
+/// frame to publish the accumulated times and start a new frame. Work done by other threads is attributed to the frame
+/// in progress when it completes.
+///
+/// Readers use `GetLastFrame()` and `GetTotals()`, which never block the emulator. Individual values are read
+/// atomically, but a report may mix values from two consecutive frames if read while a frame is being published.
+class HostTimingStats {
+public:
+    /// @brief Adds host ticks to a component's accumulator.
+    /// @param[in] component the component to charge
+    /// @param[in] ticks the number of host ticks
+    FORCE_INLINE void Add(HostTimingComponent component, uint64 ticks) {
+        m_accum[static_cast<size_t>(component)].fetch_add(ticks, std::memory_order_relaxed);
+    }
+
+    /// @brief Publishes the timings of the current frame and begins a new frame.
+    ///
+    /// The first invocation only establishes the baseline for subsequent frames; nothing is published.
+    /// Must be invoked by the emulator thread.
+    void EndFrame();
+
+    /// @brief Publishes the timings of the current frame using the given timestamps and begins a new frame.
+    ///
+    /// The host tick rate is calibrated from the tick and nanosecond deltas since the previous frame.
+    ///
+    /// @param[in] ticks the current host tick count, as returned by `ReadHostTicks()`
+    /// @param[in] nanos the current steady clock time in nanoseconds
+    void EndFrame(uint64 ticks, uint64 nanos);
+
+    /// @brief Clears the aggregated totals. The next `EndFrame()` call establishes a new baseline.
+    ///
+    /// Must be invoked by the emulator thread or while emulation is stopped.
+    void ResetTotals();
+
+    /// @brief Retrieves the timings of the last completed frame.
+    /// @return the last frame's timings
+    [[nodiscard]] HostTimingReport GetLastFrame() const;
+
+    /// @brief Retrieves the timings aggregated over all frames since construction or the last `ResetTotals()` call.
+    /// @return the aggregated timings
+    [[nodiscard]] HostTimingReport GetTotals() const;
+
+private:
+    using AtomicDouble = std::atomic<double>;
+
+    alignas(64) std::array<std::atomic<uint64>, kNumHostTimingComponents> m_accum{};
+
+    // Calibration state, only accessed by EndFrame()
+    uint64 m_lastTicks = 0;
+    uint64 m_lastNanos = 0;
+    bool m_started = false;
+    double m_msPerTick = 0.0;
+
+    // Published values
+    std::array<AtomicDouble, kNumHostTimingComponents> m_lastComponentMs{};
+    AtomicDouble m_lastFrameMs{0.0};
+
+    std::atomic<uint64> m_totalFrames{0};
+    AtomicDouble m_totalFrameMs{0.0};
+    AtomicDouble m_maxFrameMs{0.0};
+    std::array<AtomicDouble, kNumHostTimingComponents> m_totalComponentMs{};
+    std::array<AtomicDouble, kNumHostTimingComponents> m_maxComponentMs{};
+};
+
+/// @brief Measures the lifetime of the object and charges it to a component.
+class ScopedHostTimer {
+public:
+    FORCE_INLINE ScopedHostTimer(HostTimingStats *stats, HostTimingComponent component)
+        : m_stats(stats)
+        , m_component(component)
+        , m_start(stats != nullptr ? ReadHostTicks() : 0) {}
+
+    FORCE_INLINE ~ScopedHostTimer() {
+        if (m_stats != nullptr) {
+            m_stats->Add(m_component, ReadHostTicks() - m_start);
+        }
+    }
+
+    ScopedHostTimer(const ScopedHostTimer &) = delete;
+    ScopedHostTimer &operator=(const ScopedHostTimer &) = delete;
+
+private:
+    HostTimingStats *m_stats;
+    HostTimingComponent m_component;
+    uint64 m_start;
+};
+
+} // namespace ymir::debug
+
+#if Ymir_HOST_TIMING
+    #define YMIR_HOST_TIMER_CONCAT_INNER(a, b) a##b
+    #define YMIR_HOST_TIMER_CONCAT(a, b) YMIR_HOST_TIMER_CONCAT_INNER(a, b)
+    #define YMIR_HOST_TIMER(stats, component) \
+        ::ymir::debug::ScopedHostTimer YMIR_HOST_TIMER_CONCAT(_hostTimer, __LINE__)(stats, component)
+#else
+    #define YMIR_HOST_TIMER(stats, component)
+#endif
@@ -0,0 +1,77 @@
+#pragma once
+
+/**
+@file
+@brief Host input to INTBACK latency histogram.
+
+Defines `ymir::debug::InputLatencyHistogram`, which measures how old host input samples are by the time the SMPC reads
+them. Frontends record one sample per peripheral read: the difference between the host time at which the inputs were
+sampled and the host time at which INTBACK consumed them.
+*/
+
+#include <ymir/core/types.hpp>
+
+#include <array>
+#include <atomic>
+
+namespace ymir::debug {
+
+/// @brief Number of buckets in an input latency histogram.
+///
+/// Bucket 0 counts latencies under 1 µs. Bucket `n` counts latencies in [2^(n-1), 2^n) µs. The last bucket also counts
+/// all longer latencies.
+inline constexpr size_t kNumInputLatencyBuckets = 32;
+
+/// @brief Snapshot of an input latency histogram.
+struct InputLatencyReport {
+    uint64 count = 0;    ///< Number of recorded samples
+    uint64 totalNs = 0;  ///< Sum of all recorded latencies in nanoseconds
+    uint64 minNs = 0;    ///< Shortest recorded latency in nanoseconds
+    uint64 maxNs = 0;    ///< Longest recorded latency in nanoseconds
+    std::array<uint64, kNumInputLatencyBuckets> buckets{}; ///< Sample counts per bucket
+
+    /// @brief Computes the mean latency in nanoseconds.
+    [[nodiscard]] double MeanNs() const {
+        return count > 0 ? static_cast<double>(totalNs) / count : 0.0;
+    }
+
+    /// @brief Estimates a latency percentile from the histogram.
+    ///
+    /// The result is the upper bound of the bucket containing the percentile, clamped to the recorded maximum.
+    ///
+    /// @param[in] fraction the percentile as a fraction between 0.0 and 1.0
+    /// @return the estimated latency in nanoseconds, or 0 if there are no samples
+    [[nodiscard]] uint64 PercentileNs(double fraction) const;
+};
+
+/// @brief Retrieves the exclusive upper bound of a latency histogram bucket.
+/// @param[in] bucket the bucket index
+/// @return the upper bound in nanoseconds
+[[nodiscard]] uint64 GetInputLatencyBucketUpperBoundNs(size_t bucket);
+
+/// @brief Aggregates host input to INTBACK latencies.
+///
+/// `Record()` is meant to be invoked by the emulator thread from the peripheral report callback. `GetReport()` may be
+/// invoked concurrently from any thread; individual values are read atomically, but a report may be slightly
+/// inconsistent if read while samples are being recorded.
+class InputLatencyHistogram {
+public:
+    /// @brief Records a latency sample.
+    /// @param[in] latencyNs the latency in nanoseconds
+    void Record(uint64 latencyNs);
+
+    /// @brief Clears all recorded samples.
+    void Reset();
+
+    /// @brief Retrieves a snapshot of the recorded samples.
+    [[nodiscard]] InputLatencyReport GetReport() const;
+
+private:
+    std::array<std::atomic<uint64>, kNumInputLatencyBuckets> m_buckets{};
+    std::atomic<uint64> m_count{0};
+    std::atomic<uint64> m_totalNs{0};
+    std::atomic<uint64> m_minNs{~0ull};
+    std::atomic<uint64> m_maxNs{0};
+};
+
+} // namespace ymir::debug
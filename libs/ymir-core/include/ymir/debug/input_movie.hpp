@@ -0,0 +1,249 @@
+#pragma once
+
+/**
+@file
+@brief Input movie recording and deterministic replay.
+
+An input movie holds every peripheral report read by the emulated system on each frame, along with the settings and
+optionally the save state needed to reproduce a run exactly, plus a hash of key parts of the system state at the end of
+each frame. Replaying a movie on the same or a different build of the emulator and comparing the hashes pinpoints the
+first frame where emulation diverges.
+
+Movies that start from power on are portable across builds. Movies that start from a save state embed a binary save
+state (see `savestate_binary.hpp`) and can only be replayed by builds with the same save state layout.
+
+Movie files are laid out as follows, in little-endian byte order:
+- Header: magic, version, peripheral report size and settings
+- Game disc path, as a length-prefixed UTF-8 string
+- Frame, report and start state counts
+- Frame table: per-port read counts and end of frame hash for each frame
+- Peripheral reports of all frames, in order; within each frame, port 1 reads come before port 2 reads
+- Start state: binary save state, or nothing for movies that start from power on
+*/
+
+#include <ymir/hw/smpc/peripheral/peripheral_report.hpp>
+
+#include <ymir/core/configuration_defs.hpp>
+#include <ymir/core/hash.hpp>
+#include <ymir/core/types.hpp>
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace ymir {
+
+struct Saturn;
+
+namespace savestate {
+    struct SaveState;
+    struct SH2SaveState;
+    struct VDPSaveState;
+    struct SCSPSaveState;
+} // namespace savestate
+
+} // namespace ymir
+
+namespace ymir::debug {
+
+/// @brief Number of peripheral ports recorded in input movies.
+inline constexpr size_t kNumMoviePorts = 2;
+
+/// @brief An input movie.
+struct InputMovie {
+    /// @brief Settings that affect emulation, applied before replaying the movie.
+    struct Settings {
+        core::config::sys::VideoStandard videoStandard = core::config::sys::VideoStandard::NTSC;
+        uint8 areaCode = 0x4;
+        bool emulateSH2Cache = false;
+        uint8 cdReadSpeedFactor = 2;
+        uint32 sh2ClockFactorNum = 1;
+        uint32 sh2ClockFactorDen = 1;
+
+        /// @brief Virtual RTC timestamp on power on. Movies always use the virtual RTC.
+        sint64 rtcTimestamp = 0;
+
+        /// @brief Peripheral connected to each port.
+        std::array<peripheral::PeripheralType, kNumMoviePorts> ports{peripheral::PeripheralType::None,
+                                                                     peripheral::PeripheralType::None};
+    };
+
+    /// @brief Inputs and result of a single frame.
+    struct Frame {
+        std::array<uint16, kNumMoviePorts> reads{}; ///< Number of reports read from each port
+        XXH128Hash hash{};                          ///< Determinism hash at the end of the frame
+    };
+
+    Settings settings;
+
+    /// @brief Game disc used when recording. Informative; replaying requires the same disc to be loaded.
+    std::string gamePath;
+
+    /// @brief Binary save state to start from. Empty to start from power on.
+    std::vector<uint8> startState;
+
+    std::vector<Frame> frames;
+    std::vector<peripheral::PeripheralReport> reports;
+};
+
+/// @brief Input movie loading results.
+enum class InputMovieReadResult {
+    Success,         ///< The movie was loaded successfully
+    FilesystemError, ///< The file could not be opened
+    InvalidFormat,   ///< The file is not an input movie
+    VersionMismatch, ///< The file uses a different format version
+    LayoutMismatch,  ///< The file was written by a build with a different peripheral report layout
+    Truncated,       ///< The file is shorter than specified by its headers
+};
+
+/// @brief Writes an input movie to a file.
+/// @param[in] path the path to the file to write
+/// @param[in] movie the movie to write
+/// @param[out] error receives any filesystem error
+/// @return `true` if the file was written successfully
+bool WriteInputMovie(const std::filesystem::path &path, const InputMovie &movie, std::error_code &error);
+
+/// @brief Reads an input movie from a file.
+/// @param[in] path the path to the file to read
+/// @param[out] movie the movie to fill in
+/// @param[out] error receives any filesystem error
+/// @return the result of the operation. `movie` is not modified unless the result is `InputMovieReadResult::Success`.
+InputMovieReadResult ReadInputMovie(const std::filesystem::path &path, InputMovie &movie, std::error_code &error);
+
+/// @brief Computes determinism hashes of the emulated system.
+///
+/// The hash covers low and high WRAM, VDP1 VRAM, VDP2 VRAM and CRAM, the SH-2 and MC68EC000 registers and SCSP sound
+/// RAM. Reuse the same instance across frames to avoid reallocating its scratch buffers.
+class DeterminismHasher {
+public:
+    DeterminismHasher();
+    ~DeterminismHasher();
+
+    /// @brief Computes the determinism hash of the current state of the system.
+    /// @param[in] saturn the system to hash
+    /// @return the hash
+    [[nodiscard]] XXH128Hash Calc(Saturn &saturn);
+
+private:
+    std::unique_ptr<savestate::SH2SaveState> m_sh2State;
+    std::unique_ptr<savestate::VDPSaveState> m_vdpState;
+    std::unique_ptr<savestate::SCSPSaveState> m_scspState;
+};
+
+/// @brief Records input movies.
+///
+/// Call `Begin` to start recording, `RecordRead` with every report filled in by the peripheral report callbacks of
+/// either port and `EndFrame` after every emulated frame. The recorder does not install any callbacks.
+class InputMovieRecorder {
+public:
+    /// @brief Starts recording a new movie.
+    ///
+    /// Switches the system to the virtual RTC, which is required for deterministic replay. If `powerOn` is `true`, the
+    /// system is hard reset and the movie starts from power on; otherwise, the movie starts from a save state of the
+    /// current system state.
+    ///
+    /// @param[in] saturn the system to record
+    /// @param[in] powerOn whether to start from power on
+    /// @param[in] gamePath the path to the game disc, stored in the movie for reference
+    void Begin(Saturn &saturn, bool powerOn, std::string gamePath = {});
+
+    /// @brief Records a peripheral report read from a port during the current frame.
+    /// @param[in] port the port index: 0 for port 1, 1 for port 2
+    /// @param[in] report the report delivered to the peripheral
+    void RecordRead(uint32 port, const peripheral::PeripheralReport &report);
+
+    /// @brief Ends the current frame, hashing the system state.
+    /// @param[in] saturn the system being recorded
+    void EndFrame(Saturn &saturn);
+
+    /// @brief Retrieves the movie recorded so far.
+    /// @return the movie
+    [[nodiscard]] const InputMovie &GetMovie() const {
+        return m_movie;
+    }
+
+private:
+    InputMovie m_movie;
+    InputMovie::Frame m_frame;
+    std::array<std::vector<peripheral::PeripheralReport>, kNumMoviePorts> m_frameReports;
+    DeterminismHasher m_hasher;
+};
+
+/// @brief Replays input movies and checks that they reproduce the recorded system states.
+///
+/// Call `Begin` to prepare the system and connect the recorded peripherals, then `EndFrame` after every emulated frame
+/// until `IsFinished` returns `true`. Peripheral reads are served from the movie in the order they were recorded. If the
+/// emulated system reads a port more often than recorded in a frame, the last report read from that port is repeated.
+class InputMoviePlayer {
+public:
+    /// @brief Movie replay preparation results.
+    enum class BeginResult {
+        Success,          ///< The system is ready to replay the movie
+        InvalidState,     ///< The embedded save state could not be read; it may come from a different build
+        IncompatibleState ///< The embedded save state was rejected by the system, possibly due to a different disc
+    };
+
+    /// @brief Prepares the system to replay the movie.
+    ///
+    /// Applies the movie settings, restores the embedded save state or hard resets the system, connects the recorded
+    /// peripherals and installs peripheral report callbacks on both ports. The movie must outlive the replay.
+    ///
+    /// @param[in] saturn the system to replay the movie on
+    /// @param[in] movie the movie to replay
+    /// @return the result of the operation
+    BeginResult Begin(Saturn &saturn, const InputMovie &movie);
+
+    /// @brief Ends the current frame, checking the system state against the recorded hash.
+    /// @param[in] saturn the system replaying the movie
+    /// @return `true` if the hash matches
+    bool EndFrame(Saturn &saturn);
+
+    /// @brief Disconnects the peripherals connected by `Begin`.
+    /// @param[in] saturn the system replaying the movie
+    void End(Saturn &saturn);
+
+    /// @brief Determines if all frames of the movie have been replayed.
+    /// @return `true` if the replay is finished
+    [[nodiscard]] bool IsFinished() const {
+        return m_movie == nullptr || m_frameIndex >= m_movie->frames.size();
+    }
+
+    /// @brief Retrieves the index of the frame being replayed.
+    /// @return the current frame index
+    [[nodiscard]] uint64 GetFrameIndex() const {
+        return m_frameIndex;
+    }
+
+    /// @brief Retrieves the first frame whose hash did not match the recording.
+    /// @return the index of the first diverging frame, or `std::nullopt` if all frames matched so far
+    [[nodiscard]] std::optional<uint64> GetFirstDivergentFrame() const {
+        return m_firstDivergentFrame;
+    }
+
+    /// @brief Retrieves the number of peripheral reads that did not line up with the recording.
+    /// @return the number of reads beyond those recorded plus the number of recorded reads that did not happen
+    [[nodiscard]] uint64 GetReadMismatches() const {
+        return m_readMismatches;
+    }
+
+    /// @brief Serves a peripheral read from the movie.
+    /// @param[in] port the port index: 0 for port 1, 1 for port 2
+    /// @param[in,out] report the report to fill in
+    void ReadReport(uint32 port, peripheral::PeripheralReport &report);
+
+private:
+    const InputMovie *m_movie = nullptr;
+    uint64 m_frameIndex = 0;
+    uint64 m_frameReportBase = 0; // Index of the first report of the current frame
+    std::array<uint16, kNumMoviePorts> m_portReads{};
+    std::array<std::optional<peripheral::PeripheralReport>, kNumMoviePorts> m_lastReports;
+    std::optional<uint64> m_firstDivergentFrame;
+    uint64 m_readMismatches = 0;
+    DeterminismHasher m_hasher;
+};
+
+} // namespace ymir::debug
@@ -0,0 +1,201 @@
+#pragma once
+
+/**
+@file
+@brief Defines `ymir::debug::PCSampler`, a sampling program counter profiler for the emulated CPUs.
+*/
+
+#include "symbol_map.hpp"
+
+#include <ymir/core/types.hpp>
+
+#include <concurrentqueue.h>
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ymir::debug {
+
+/// @brief CPUs sampled by the `PCSampler`.
+enum class ProfiledCPU : uint8 { MasterSH2, SlaveSH2, M68K, SH1 };
+
+/// @brief The number of CPUs sampled by the `PCSampler`.
+inline constexpr size_t kNumProfiledCPUs = 4;
+
+/// @brief Retrieves a short name for the given profiled CPU, suitable for reports and collapsed stacks.
+/// @param[in] cpu the CPU
+/// @return the name of the CPU
+[[nodiscard]] std::string_view GetProfiledCPUName(ProfiledCPU cpu);
+
+/// @brief Program counters of all profiled CPUs captured at one point in time.
+struct PCSnapshot {
+    std::array<uint32, kNumProfiledCPUs> pc{};   ///< Program counter of each CPU
+    std::array<bool, kNumProfiledCPUs> active{}; ///< Whether the CPU was running when the snapshot was taken
+
+    /// @brief Stores the program counter of a running CPU.
+    /// @param[in] cpu the CPU
+    /// @param[in] value the program counter value
+    void Set(ProfiledCPU cpu, uint32 value) {
+        pc[static_cast<size_t>(cpu)] = value;
+        active[static_cast<size_t>(cpu)] = true;
+    }
+};
+
+/// @brief Sampling program counter profiler.
+///
+/// Attach to a `Saturn` instance with `Saturn::UsePCSampler(PCSampler *)`. The emulator takes a `PCSnapshot` of all
+/// running CPUs every `GetInterval()` system clock cycles and records it into per-CPU address histograms. This works
+/// independently of debug tracing, so it can be used at full emulation speed.
+///
+/// SH-2 program counters are recorded without the cache area bits (`pc & 0x07FFFFFF`) so that cached and cache-through
+/// mirrors aggregate into the same addresses.
+///
+/// Reports can be aggregated by function when a symbol map is assigned to the CPU, and exported as collapsed stacks
+/// compatible with flame graph tools.
+///
+/// Recording is lock-free: `Record()` appends snapshots to a block owned by the recording thread and hands full blocks
+/// over to a queue. The histograms are updated from queued blocks when reports are requested or `Aggregate()` is
+/// called, so the cost of aggregation is paid by the reader. Snapshots still in the partially filled block are not
+/// visible to reports until `Flush()` is called.
+///
+/// `Record()` and `Flush()` must only be called from one thread at a time (the emulator thread). All other methods are
+/// thread-safe and may be called from any thread.
+class PCSampler {
+public:
+    /// @brief Default sampling interval in system clock cycles.
+    static constexpr uint64 kDefaultInterval = 1024;
+
+    /// @brief Number of snapshots buffered by `Record()` before they are handed over for aggregation.
+    static constexpr size_t kBlockSize = 1024;
+
+    /// @brief Number of pending blocks past which `Flush()` aggregates them itself if no reader is busy.
+    static constexpr size_t kMaxPendingBlocks = 64;
+
+    PCSampler() = default;
+    PCSampler(const PCSampler &) = delete;
+    PCSampler &operator=(const PCSampler &) = delete;
+
+    /// @brief A histogram entry.
+    struct HotSpot {
+        uint32 address;   ///< Sampled address, or the symbol start address when aggregated by function
+        std::string name; ///< Symbol name; empty if the address is not covered by a symbol
+        uint64 samples;   ///< Number of samples
+    };
+
+    /// @brief Sets the sampling interval.
+    /// @param[in] cycles the interval in system clock cycles; values below 1 are clamped to 1
+    void SetInterval(uint64 cycles);
+
+    /// @brief Retrieves the sampling interval.
+    /// @return the interval in system clock cycles
+    [[nodiscard]] uint64 GetInterval() const {
+        return m_interval.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Records a snapshot of program counters.
+    ///
+    /// Must only be called from the recording thread.
+    ///
+    /// @param[in] snapshot the snapshot to record
+    /// @param[in] weight the number of sampling intervals covered by the snapshot
+    void Record(const PCSnapshot &snapshot, uint64 weight = 1) {
+        if (m_recordBlock == nullptr) [[unlikely]] {
+            m_recordBlock = AcquireBlock();
+        }
+        m_recordBlock->samples[m_recordBlock->count++] = {snapshot, weight};
+        if (m_recordBlock->count == kBlockSize) [[unlikely]] {
+            Flush();
+        }
+    }
+
+    /// @brief Hands over the snapshots buffered by `Record()` for aggregation.
+    ///
+    /// Must only be called from the recording thread, or while no thread is recording.
+    void Flush();
+
+    /// @brief Aggregates all flushed snapshots into the histograms.
+    ///
+    /// Reports do this automatically. Long-running recordings without reports should call this periodically to
+    /// recycle the buffered blocks; otherwise `Flush()` falls back to aggregating once `kMaxPendingBlocks` pile up.
+    void Aggregate();
+
+    /// @brief Clears all recorded samples. Symbol maps are preserved.
+    void Clear();
+
+    /// @brief Assigns a symbol map to the given CPU.
+    /// @param[in] cpu the CPU
+    /// @param[in] symbols the symbol map, or `nullptr` to remove the current map
+    void SetSymbolMap(ProfiledCPU cpu, std::shared_ptr<const SymbolMap> symbols);
+
+    /// @brief Retrieves the total number of samples recorded for the given CPU.
+    /// @param[in] cpu the CPU
+    /// @return the number of samples
+    [[nodiscard]] uint64 GetTotalSamples(ProfiledCPU cpu) const;
+
+    /// @brief Builds a histogram of the most sampled addresses or functions of the given CPU, sorted by sample count in
+    /// descending order.
+    /// @param[in] cpu the CPU
+    /// @param[in] byFunction aggregate samples by symbol if a symbol map is assigned to the CPU
+    /// @param[in] maxEntries the maximum number of entries to return
+    /// @return the histogram entries
+    [[nodiscard]] std::vector<HotSpot> GetHotSpots(ProfiledCPU cpu, bool byFunction,
+                                                   size_t maxEntries = std::numeric_limits<size_t>::max()) const;
+
+    /// @brief Writes all samples in the collapsed stack format used by flame graph tools.
+    ///
+    /// Each line has the form `<cpu>;<function> <samples>`, where `<function>` is the symbol name or the hexadecimal
+    /// address if no symbol covers the sampled address.
+    ///
+    /// @param[in] out the output stream
+    void WriteCollapsedStacks(std::ostream &out) const;
+
+private:
+    std::atomic<uint64> m_interval = kDefaultInterval;
+
+    struct Sample {
+        PCSnapshot snapshot;
+        uint64 weight;
+    };
+
+    struct SampleBlock {
+        std::array<Sample, kBlockSize> samples;
+        size_t count = 0;
+    };
+
+    // Block currently being filled by Record(); owned by the recording thread
+    SampleBlock *m_recordBlock = nullptr;
+
+    // Full blocks waiting to be aggregated and empty blocks ready for reuse
+    mutable moodycamel::ConcurrentQueue<SampleBlock *> m_pendingBlocks;
+    mutable moodycamel::ConcurrentQueue<SampleBlock *> m_freeBlocks;
+
+    // Owns all blocks ever allocated
+    std::mutex m_blockAllocMutex;
+    std::vector<std::unique_ptr<SampleBlock>> m_blocks;
+
+    [[nodiscard]] SampleBlock *AcquireBlock();
+
+    struct CPUProfile {
+        std::unordered_map<uint32, uint64> histogram;
+        uint64 totalSamples = 0;
+        std::shared_ptr<const SymbolMap> symbols;
+    };
+
+    mutable std::mutex m_mutex;
+    mutable std::array<CPUProfile, kNumProfiledCPUs> m_profiles;
+
+    // Aggregates pending blocks into the histograms and recycles them. Must be called with m_mutex held.
+    void DrainPendingBlocks(bool discard) const;
+
+    [[nodiscard]] std::vector<HotSpot> BuildHotSpots(const CPUProfile &profile, bool byFunction) const;
+};
+
+} // namespace ymir::debug
@@ -0,0 +1,81 @@
+#pragma once
+
+/**
+@file
+@brief Defines `ymir::debug::SymbolMap`, an address to symbol name lookup table.
+*/
+
+#include <ymir/core/types.hpp>
+
+#include <filesystem>
+#include <istream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace ymir::debug {
+
+/// @brief Maps code addresses to symbol names.
+///
+/// Each symbol covers the address range from its start address up to, but not including, the start address of the
+/// next symbol.
+class SymbolMap {
+public:
+    /// @brief A symbol entry.
+    struct Symbol {
+        uint32 address;   ///< The start address of the symbol
+        std::string name; ///< The symbol name
+    };
+
+    /// @brief Loads symbols from a text file, replacing the current contents of the map.
+    ///
+    /// See `Parse(std::istream &)` for the supported format.
+    ///
+    /// @param[in] path the path to the symbol file
+    /// @param[out] error receives the filesystem error if the file could not be read
+    /// @return `true` if the file was loaded successfully
+    bool Load(const std::filesystem::path &path, std::error_code &error);
+
+    /// @brief Parses symbols from a text stream, replacing the current contents of the map.
+    ///
+    /// Each line contains a hexadecimal address (with an optional `0x` prefix), an optional single-character symbol
+    /// type as produced by `nm`, and the symbol name, separated by whitespace. Empty lines and lines starting with `#`
+    /// or `;` are ignored, as are lines that cannot be parsed.
+    ///
+    /// @param[in] in the input stream
+    /// @return the number of symbols parsed
+    size_t Parse(std::istream &in);
+
+    /// @brief Adds or replaces a symbol.
+    /// @param[in] address the start address of the symbol
+    /// @param[in] name the symbol name
+    void Add(uint32 address, std::string_view name);
+
+    /// @brief Removes all symbols.
+    void Clear() {
+        m_symbols.clear();
+    }
+
+    /// @brief Determines if the map contains no symbols.
+    /// @return `true` if there are no symbols
+    [[nodiscard]] bool IsEmpty() const {
+        return m_symbols.empty();
+    }
+
+    /// @brief Retrieves the number of symbols in the map.
+    /// @return the number of symbols
+    [[nodiscard]] size_t Size() const {
+        return m_symbols.size();
+    }
+
+    /// @brief Finds the symbol that contains the given address.
+    /// @param[in] address the address to look up
+    /// @return a pointer to the symbol, or `nullptr` if the address precedes all symbols
+    [[nodiscard]] const Symbol *Find(uint32 address) const;
+
+private:
+    std::map<uint32, Symbol> m_symbols;
+};
+
+} // namespace ymir::debug
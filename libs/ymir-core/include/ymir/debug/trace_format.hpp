@@ -0,0 +1,275 @@
+#pragma once
+
+/**
+@file
+@brief Binary trace file format definitions.
+
+A binary trace file starts with a `FileHeader` followed by any number of chunks. Each chunk consists of a
+`ChunkHeader` followed by `ChunkHeader::compressedSize` bytes of LZ4-compressed record data which decompresses to
+exactly `ChunkHeader::rawSize` bytes.
+
+Every chunk contains records from a single `Source`. Records within a source are stored in the order they were
+produced. Chunks from different sources are interleaved in the order they were submitted by the recorder, which is
+indicated by `ChunkHeader::sequence`; records from different sources are therefore only loosely ordered with respect
+to each other. Use `RecordType::FrameMarker` records in the `Source::System` stream as coarse synchronization points.
+
+Streams bound to a cycle counter interleave `RecordType::CycleStamp` records with their regular records. A stamp gives
+the emulated cycle count of every following record of its stream up to the next stamp, and is only emitted when the
+count changes. Every chunk of such a stream starts with a stamp, so chunks can be decoded independently. Stamps order
+records across sources at the resolution of each source's counter.
+
+A record is a single `RecordType` byte followed by the corresponding payload structure from the `record` namespace.
+Payloads are packed and stored in little-endian byte order. The size of each payload is given by `GetPayloadSize`.
+*/
+
+#include <ymir/core/types.hpp>
+
+#include <array>
+#include <string_view>
+
+namespace ymir::debug::trace {
+
+/// @brief Magic number identifying binary trace files ("YMTR" in little-endian byte order).
+inline constexpr uint32 kMagic = 0x52544D59;
+
+/// @brief Current binary trace format version.
+inline constexpr uint32 kFormatVersion = 2;
+
+/// @brief Maximum size of the uncompressed record data in a chunk.
+inline constexpr uint32 kMaxChunkSize = 256 * 1024;
+
+/// @brief Trace record sources. Each source is recorded into an independent stream.
+enum class Source : uint8 {
+    System,    ///< System-wide events such as frame markers
+    MasterSH2, ///< Master SH-2
+    SlaveSH2,  ///< Slave SH-2
+    SCU,       ///< SCU interrupts and DMA
+    CDBlock,   ///< CD Block commands
+
+    Count
+};
+
+/// @brief Total number of trace sources.
+inline constexpr size_t kNumSources = static_cast<size_t>(Source::Count);
+
+/// @brief Trace record types.
+enum class RecordType : uint8 {
+    FrameMarker, ///< `record::FrameMarker`
+    CycleStamp,  ///< `record::CycleStamp`
+
+    SH2Reset,                ///< `record::SH2Reset`
+    SH2Instruction,          ///< `record::SH2Instruction`
+    SH2DelaySlotInstruction, ///< `record::SH2Instruction`, executed in a delay slot
+    SH2Branch,               ///< `record::SH2Branch`
+    SH2BranchDelay,          ///< `record::SH2Target`
+    SH2Call,                 ///< `record::SH2Target`
+    SH2Return,               ///< `record::SH2Target`
+    SH2ReturnFromException,  ///< `record::SH2ReturnFromException`
+    SH2Interrupt,            ///< `record::SH2Interrupt`
+    SH2Exception,            ///< `record::SH2Exception`
+    SH2Trap,                 ///< `record::SH2Trap`
+    SH2DMABegin,             ///< `record::SH2DMABegin`
+    SH2DMAEnd,               ///< `record::SH2DMAEnd`
+
+    SCURaiseInterrupt,       ///< `record::SCURaiseInterrupt`
+    SCUAcknowledgeInterrupt, ///< `record::SCUAcknowledgeInterrupt`
+    SCUDMA,                  ///< `record::SCUDMA`
+    SCUDSPDMA,               ///< `record::SCUDSPDMA`
+
+    CDBlockCommand,  ///< `record::CDBlockCommand`
+    CDBlockResponse, ///< `record::CDBlockCommand`
+
+    Count
+};
+
+/// @brief Total number of trace record types.
+inline constexpr size_t kNumRecordTypes = static_cast<size_t>(RecordType::Count);
+
+/// @brief Binary trace file header.
+struct FileHeader {
+    uint32 magic;        ///< Must be `kMagic`
+    uint32 version;      ///< Must be `kFormatVersion`
+    uint32 maxChunkSize; ///< Maximum uncompressed chunk size used by the recorder
+    uint32 reserved;
+};
+static_assert(sizeof(FileHeader) == 16);
+
+/// @brief Binary trace chunk header.
+struct ChunkHeader {
+    uint8 source;   ///< The `Source` of all records in this chunk
+    uint8 reserved[3];
+    uint32 rawSize;        ///< Uncompressed size of the record data
+    uint32 compressedSize; ///< Size of the LZ4-compressed record data following this header
+    uint32 recordCount;    ///< Number of records in this chunk
+    uint64 sequence;       ///< Global submission order of this chunk
+};
+static_assert(sizeof(ChunkHeader) == 24);
+
+/// @brief Trace record payloads.
+namespace record {
+
+#pragma pack(push, 1)
+
+    struct FrameMarker {
+        uint64 frame;
+    };
+
+    struct CycleStamp {
+        uint64 cycle; ///< Absolute emulated cycle count
+    };
+
+    struct SH2Reset {
+        uint32 pc;
+        uint32 sp;
+        uint8 watchdogInitiated;
+    };
+
+    struct SH2Instruction {
+        uint32 pc;
+        uint16 opcode;
+    };
+
+    struct SH2Branch {
+        uint32 pc;
+        uint32 target;
+    };
+
+    struct SH2Target {
+        uint32 target;
+    };
+
+    struct SH2ReturnFromException {
+        uint32 target;
+        uint32 newSP;
+    };
+
+    struct SH2Interrupt {
+        uint8 vecNum;
+        uint8 level;
+        uint8 source; ///< `sh2::InterruptSource`
+        uint32 pc;
+    };
+
+    struct SH2Exception {
+        uint8 vecNum;
+        uint32 oldPC;
+        uint32 oldSR;
+        uint32 oldSP;
+        uint32 newPC;
+    };
+
+    struct SH2Trap {
+        uint8 vecNum;
+        uint32 oldPC;
+        uint32 oldSP;
+        uint32 newPC;
+    };
+
+    struct SH2DMABegin {
+        uint8 channel;
+        uint8 unitSize;
+        uint32 srcAddress;
+        uint32 dstAddress;
+        uint32 count;
+        sint32 srcInc;
+        sint32 dstInc;
+    };
+
+    struct SH2DMAEnd {
+        uint8 channel;
+        uint8 irqRaised;
+    };
+
+    struct SCURaiseInterrupt {
+        uint8 index;
+        uint8 level;
+    };
+
+    struct SCUAcknowledgeInterrupt {
+        uint8 index;
+    };
+
+    struct SCUDMA {
+        uint8 channel;
+        uint8 indirect;
+        uint32 srcAddr;
+        uint32 dstAddr;
+        uint32 xferCount;
+        uint32 srcAddrInc;
+        uint32 dstAddrInc;
+        uint32 indirectAddr;
+    };
+
+    struct SCUDSPDMA {
+        uint8 toD0;
+        uint8 addrDSP;
+        uint8 count;
+        uint8 addrInc;
+        uint8 hold;
+        uint32 addrD0;
+    };
+
+    struct CDBlockCommand {
+        uint16 cr1;
+        uint16 cr2;
+        uint16 cr3;
+        uint16 cr4;
+    };
+
+#pragma pack(pop)
+
+} // namespace record
+
+namespace detail {
+
+    inline constexpr auto kPayloadSizes = [] {
+        std::array<uint8, kNumRecordTypes> sizes{};
+        auto set = [&](RecordType type, size_t size) { sizes[static_cast<size_t>(type)] = static_cast<uint8>(size); };
+        set(RecordType::FrameMarker, sizeof(record::FrameMarker));
+        set(RecordType::CycleStamp, sizeof(record::CycleStamp));
+        set(RecordType::SH2Reset, sizeof(record::SH2Reset));
+        set(RecordType::SH2Instruction, sizeof(record::SH2Instruction));
+        set(RecordType::SH2DelaySlotInstruction, sizeof(record::SH2Instruction));
+        set(RecordType::SH2Branch, sizeof(record::SH2Branch));
+        set(RecordType::SH2BranchDelay, sizeof(record::SH2Target));
+        set(RecordType::SH2Call, sizeof(record::SH2Target));
+        set(RecordType::SH2Return, sizeof(record::SH2Target));
+        set(RecordType::SH2ReturnFromException, sizeof(record::SH2ReturnFromException));
+        set(RecordType::SH2Interrupt, sizeof(record::SH2Interrupt));
+        set(RecordType::SH2Exception, sizeof(record::SH2Exception));
+        set(RecordType::SH2Trap, sizeof(record::SH2Trap));
+        set(RecordType::SH2DMABegin, sizeof(record::SH2DMABegin));
+        set(RecordType::SH2DMAEnd, sizeof(record::SH2DMAEnd));
+        set(RecordType::SCURaiseInterrupt, sizeof(record::SCURaiseInterrupt));
+        set(RecordType::SCUAcknowledgeInterrupt, sizeof(record::SCUAcknowledgeInterrupt));
+        set(RecordType::SCUDMA, sizeof(record::SCUDMA));
+        set(RecordType::SCUDSPDMA, sizeof(record::SCUDSPDMA));
+        set(RecordType::CDBlockCommand, sizeof(record::CDBlockCommand));
+        set(RecordType::CDBlockResponse, sizeof(record::CDBlockCommand));
+        return sizes;
+    }();
+
+} // namespace detail
+
+/// @brief Retrieves the payload size of the given record type.
+/// @param[in] type the record type
+/// @return the size of the payload in bytes, not including the type byte
+constexpr size_t GetPayloadSize(RecordType type) {
+    return detail::kPayloadSizes[static_cast<size_t>(type)];
+}
+
+/// @brief Retrieves a human-readable name for the given trace source.
+/// @param[in] source the trace source
+/// @return the name of the source
+inline std::string_view GetSourceName(Source source) {
+    switch (source) {
+    case Source::System: return "System";
+    case Source::MasterSH2: return "MSH2";
+    case Source::SlaveSH2: return "SSH2";
+    case Source::SCU: return "SCU";
+    case Source::CDBlock: return "CDBlock";
+    default: return "(invalid)";
+    }
+}
+
+} // namespace ymir::debug::trace
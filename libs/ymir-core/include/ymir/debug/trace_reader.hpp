@@ -0,0 +1,133 @@
+#pragma once
+
+/**
+@file
+@brief Defines `ymir::debug::trace::TraceReader`, the reader for binary trace files.
+*/
+
+#include "trace_format.hpp"
+
+#include <ymir/core/types.hpp>
+
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace ymir::debug::trace {
+
+/// @brief Binary trace reading results.
+enum class ReadResult {
+    Success,         ///< The operation completed successfully
+    EndOfFile,       ///< There are no more chunks to read
+    FilesystemError, ///< The file could not be opened or read
+    InvalidFormat,   ///< The file is not a binary trace
+    VersionMismatch, ///< The file uses a different format version
+    Truncated,       ///< The file ends in the middle of a chunk
+    CorruptChunk,    ///< A chunk failed to decompress or contains invalid records
+};
+
+/// @brief A view into a single decoded trace record.
+struct RecordView {
+    Source source;                 ///< The source of the record
+    RecordType type;               ///< The record type
+    std::span<const uint8> payload; ///< The raw payload bytes
+
+    /// @brief Copies the payload into the corresponding payload structure.
+    /// @tparam T the payload structure type from the `record` namespace
+    /// @return the payload
+    template <typename T>
+    [[nodiscard]] T As() const {
+        assert(payload.size() == sizeof(T));
+        T value;
+        std::memcpy(&value, payload.data(), sizeof(T));
+        return value;
+    }
+};
+
+/// @brief Reads binary trace files produced by `TraceRecorder`.
+///
+/// Chunks are read sequentially in file order, which matches the submission order of the recorder.
+class TraceReader {
+public:
+    /// @brief Opens a trace file and validates its header.
+    /// @param[in] path the path to the trace file
+    /// @param[out] error receives the filesystem error if the file could not be opened or read
+    /// @return the result of the operation
+    ReadResult Open(const std::filesystem::path &path, std::error_code &error);
+
+    /// @brief Reads and decompresses the next chunk.
+    /// @param[out] error receives the filesystem error if the file could not be read
+    /// @return `ReadResult::Success` if a chunk was read, `ReadResult::EndOfFile` if there are no more chunks, or an
+    /// error code
+    ReadResult NextChunk(std::error_code &error);
+
+    /// @brief Retrieves the header of the current chunk.
+    /// @return the current chunk header
+    [[nodiscard]] const ChunkHeader &GetChunkHeader() const {
+        return m_chunkHeader;
+    }
+
+    /// @brief Invokes the given function for every record in the current chunk.
+    /// @tparam TFn the function type, which must accept a `const RecordView &`
+    /// @param[in] fn the function to invoke for each record
+    /// @return `ReadResult::Success` or `ReadResult::CorruptChunk` if an invalid record was found
+    template <typename TFn>
+    ReadResult ForEachRecord(TFn &&fn) const {
+        const Source source = static_cast<Source>(m_chunkHeader.source);
+        size_t pos = 0;
+        while (pos < m_chunk.size()) {
+            const uint8 typeValue = m_chunk[pos];
+            if (typeValue >= kNumRecordTypes) {
+                return ReadResult::CorruptChunk;
+            }
+            const RecordType type = static_cast<RecordType>(typeValue);
+            const size_t size = GetPayloadSize(type);
+            if (pos + 1 + size > m_chunk.size()) {
+                return ReadResult::CorruptChunk;
+            }
+            fn(RecordView{source, type, std::span{m_chunk}.subspan(pos + 1, size)});
+            pos += 1 + size;
+        }
+        return ReadResult::Success;
+    }
+
+    /// @brief Reads all remaining records in the file.
+    /// @tparam TFn the function type, which must accept a `const RecordView &`
+    /// @param[in] fn the function to invoke for each record
+    /// @param[out] error receives the filesystem error if the file could not be read
+    /// @return `ReadResult::Success` if all records were read, or an error code
+    template <typename TFn>
+    ReadResult ReadAll(TFn &&fn, std::error_code &error) {
+        while (true) {
+            ReadResult result = NextChunk(error);
+            if (result == ReadResult::EndOfFile) {
+                return ReadResult::Success;
+            }
+            if (result != ReadResult::Success) {
+                return result;
+            }
+            result = ForEachRecord(fn);
+            if (result != ReadResult::Success) {
+                return result;
+            }
+        }
+    }
+
+private:
+    std::ifstream m_in;
+    ChunkHeader m_chunkHeader{};
+    std::vector<uint8> m_chunk;
+    std::vector<char> m_compressed;
+};
+
+/// @brief Formats a trace record as a single line of human-readable text, without the line terminator.
+/// @param[in] record the record to format
+/// @return the formatted record
+std::string FormatRecord(const RecordView &record);
+
+} // namespace ymir::debug::trace
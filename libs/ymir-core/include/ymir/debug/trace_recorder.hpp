@@ -0,0 +1,353 @@
+#pragma once
+
+/**
+@file
+@brief Defines `ymir::debug::trace::TraceRecorder`, a low-overhead binary trace recorder.
+*/
+
+#include "trace_format.hpp"
+
+#include "cdblock_tracer_base.hpp"
+#include "scu_tracer_base.hpp"
+#include "sh2_tracer_base.hpp"
+
+#include <ymir/core/types.hpp>
+
+#include <ymir/util/inline.hpp>
+
+#include <blockingconcurrentqueue.h>
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace ymir::debug::trace {
+
+/// @brief Records compact binary traces of SH-2, SCU and CD Block activity to a file.
+///
+/// Each `Source` is recorded into its own stream. A stream appends fixed-size binary records to a chunk buffer owned
+/// by the producing thread without any locking. Full chunks are handed to a background writer thread through a
+/// lock-free queue, compressed with LZ4 and appended to the trace file. Chunk buffers are recycled, so recording does
+/// not allocate memory in steady state. If the writer falls behind by more than `kMaxChunks` chunks, producers wait
+/// for a chunk to be recycled instead of dropping records.
+///
+/// Attach the tracers returned by `GetMasterSH2Tracer()`, `GetSlaveSH2Tracer()`, `GetSCUTracer()` and
+/// `GetCDBlockTracer()` to the corresponding components while recording, or let `Saturn::UseTraceRecorder()` do it.
+/// SH-2 instruction tracing requires the emulator to run in debug tracing mode. Streams bound to a cycle counter with
+/// `BindCycleCounter()` stamp their records with the emulated cycle count.
+///
+/// `Start()` and `Stop()` must not be called while any of the tracers may be invoked. Each stream must be fed by a
+/// single thread at a time.
+///
+/// Use `TraceReader` to read the resulting files.
+class TraceRecorder {
+public:
+    /// @brief Maximum number of chunk buffers allocated by the recorder.
+    static constexpr size_t kMaxChunks = 64;
+
+    TraceRecorder();
+    ~TraceRecorder();
+
+    TraceRecorder(const TraceRecorder &) = delete;
+    TraceRecorder &operator=(const TraceRecorder &) = delete;
+
+    /// @brief Starts recording into the specified file, replacing its contents.
+    /// Stops the current recording if there is one.
+    /// @param[in] path the path to the trace file
+    /// @param[out] error receives the filesystem error if the file could not be created
+    /// @return `true` if recording started successfully
+    bool Start(const std::filesystem::path &path, std::error_code &error);
+
+    /// @brief Flushes all pending records, waits for the writer thread to finish and closes the trace file.
+    void Stop();
+
+    /// @brief Determines if the recorder is currently recording.
+    /// @return `true` if recording
+    [[nodiscard]] bool IsRecording() const {
+        return m_recording;
+    }
+
+    /// @brief Records a frame marker in the `Source::System` stream.
+    /// @param[in] frame the frame number
+    void MarkFrame(uint64 frame) {
+        m_streams[static_cast<size_t>(Source::System)].Emit<RecordType::FrameMarker>(record::FrameMarker{frame});
+    }
+
+    /// @brief Stamps the records of a stream with the emulated cycle count at which they were produced.
+    ///
+    /// The count is read as `*base + *offset` whenever a record is emitted and a `RecordType::CycleStamp` record is
+    /// inserted when it differs from the previous one. Pass `nullptr` as `base` to stop stamping.
+    ///
+    /// Must not be called while the tracers of the stream may be invoked.
+    ///
+    /// @param[in] source the stream to stamp
+    /// @param[in] base the primary cycle counter
+    /// @param[in] offset an optional counter added to `base`
+    void BindCycleCounter(Source source, const uint64 *base, const uint64 *offset = nullptr) {
+        m_streams[static_cast<size_t>(source)].BindCycleCounter(base, offset);
+    }
+
+    /// @brief Recording statistics.
+    struct Stats {
+        uint64 chunks = 0;          ///< Number of chunks written
+        uint64 records = 0;         ///< Number of records written
+        uint64 rawBytes = 0;        ///< Total uncompressed record data size
+        uint64 compressedBytes = 0; ///< Total compressed record data size
+        bool writeError = false;    ///< Whether a write error has occurred
+    };
+
+    /// @brief Retrieves the statistics of the current or last recording.
+    /// Only accounts for chunks already processed by the writer thread.
+    /// @return the recording statistics
+    [[nodiscard]] Stats GetStats() const;
+
+    /// @brief Retrieves the tracer for the master SH-2.
+    /// @return the master SH-2 tracer
+    [[nodiscard]] ISH2Tracer &GetMasterSH2Tracer() {
+        return m_masterSH2Tracer;
+    }
+
+    /// @brief Retrieves the tracer for the slave SH-2.
+    /// @return the slave SH-2 tracer
+    [[nodiscard]] ISH2Tracer &GetSlaveSH2Tracer() {
+        return m_slaveSH2Tracer;
+    }
+
+    /// @brief Retrieves the tracer for the SCU.
+    /// @return the SCU tracer
+    [[nodiscard]] ISCUTracer &GetSCUTracer() {
+        return m_scuTracer;
+    }
+
+    /// @brief Retrieves the tracer for the CD Block.
+    /// @return the CD Block tracer
+    [[nodiscard]] ICDBlockTracer &GetCDBlockTracer() {
+        return m_cdblockTracer;
+    }
+
+private:
+    struct Chunk {
+        std::array<uint8, kMaxChunkSize> data;
+        uint32 size = 0;
+        uint32 recordCount = 0;
+        Source source = Source::System;
+        uint64 sequence = 0;
+    };
+
+    /// @brief A single-producer record stream.
+    class Stream {
+    public:
+        Stream(TraceRecorder &recorder, Source source)
+            : m_recorder(recorder)
+            , m_source(source) {}
+
+        /// @brief Appends a record to the stream, preceded by a cycle stamp if the bound cycle counter changed since
+        /// the previous record. Does nothing if the recorder is not running.
+        /// @tparam type the record type
+        /// @tparam T the payload type
+        /// @param[in] payload the record payload
+        template <RecordType type, typename T>
+        FORCE_INLINE void Emit(const T &payload) {
+            static_assert(sizeof(T) == GetPayloadSize(type), "payload type does not match record type");
+            static constexpr uint32 kStampSize = 1 + sizeof(record::CycleStamp);
+            if (m_chunk == nullptr) [[unlikely]] {
+                return;
+            }
+            if (m_chunk->size + kStampSize + 1 + sizeof(T) > kMaxChunkSize) [[unlikely]] {
+                Submit();
+            }
+            if (m_cycleBase != nullptr) {
+                const uint64 cycle = *m_cycleBase + *m_cycleOffset;
+                if (cycle != m_lastCycle) {
+                    m_lastCycle = cycle;
+                    Append<RecordType::CycleStamp>(record::CycleStamp{cycle});
+                }
+            }
+            Append<type>(payload);
+        }
+
+        void BindCycleCounter(const uint64 *base, const uint64 *offset) {
+            m_cycleBase = base;
+            m_cycleOffset = offset != nullptr ? offset : &kNoCycleOffset;
+            m_lastCycle = ~0ull;
+        }
+
+        /// @brief Acquires the initial chunk buffer.
+        void Open();
+
+        /// @brief Submits the partially filled chunk, if any, and releases the chunk buffer.
+        void Close();
+
+    private:
+        static constexpr uint64 kNoCycleOffset = 0;
+
+        TraceRecorder &m_recorder;
+        const Source m_source;
+        Chunk *m_chunk = nullptr;
+
+        const uint64 *m_cycleBase = nullptr;
+        const uint64 *m_cycleOffset = &kNoCycleOffset;
+        uint64 m_lastCycle = ~0ull; // forces a stamp at the start of every chunk
+
+        template <RecordType type, typename T>
+        FORCE_INLINE void Append(const T &payload) {
+            uint8 *dst = &m_chunk->data[m_chunk->size];
+            dst[0] = static_cast<uint8>(type);
+            std::memcpy(dst + 1, &payload, sizeof(T));
+            m_chunk->size += 1 + sizeof(T);
+            ++m_chunk->recordCount;
+        }
+
+        /// @brief Submits the current chunk to the writer thread and acquires a new one.
+        void Submit();
+    };
+
+    class SH2Tracer final : public ISH2Tracer {
+    public:
+        explicit SH2Tracer(Stream &stream)
+            : m_stream(stream) {}
+
+        void Reset(uint32 pc, uint32 sp, bool watchdogInitiated) final {
+            m_stream.Emit<RecordType::SH2Reset>(record::SH2Reset{pc, sp, watchdogInitiated});
+        }
+
+        void ExecuteInstruction(uint32 pc, uint16 opcode, bool delaySlot) final {
+            if (delaySlot) {
+                m_stream.Emit<RecordType::SH2DelaySlotInstruction>(record::SH2Instruction{pc, opcode});
+            } else {
+                m_stream.Emit<RecordType::SH2Instruction>(record::SH2Instruction{pc, opcode});
+            }
+        }
+
+        void Branch(uint32 pc, uint32 target) final {
+            m_stream.Emit<RecordType::SH2Branch>(record::SH2Branch{pc, target});
+        }
+
+        void BranchDelay(uint32 target) final {
+            m_stream.Emit<RecordType::SH2BranchDelay>(record::SH2Target{target});
+        }
+
+        void Call(uint32 target) final {
+            m_stream.Emit<RecordType::SH2Call>(record::SH2Target{target});
+        }
+
+        void Return(uint32 target) final {
+            m_stream.Emit<RecordType::SH2Return>(record::SH2Target{target});
+        }
+
+        void ReturnFromException(uint32 target, uint32 newSP) final {
+            m_stream.Emit<RecordType::SH2ReturnFromException>(record::SH2ReturnFromException{target, newSP});
+        }
+
+        void Interrupt(uint8 vecNum, uint8 level, sh2::InterruptSource source, uint32 pc) final {
+            m_stream.Emit<RecordType::SH2Interrupt>(
+                record::SH2Interrupt{vecNum, level, static_cast<uint8>(source), pc});
+        }
+
+        void Exception(uint8 vecNum, uint32 oldPC, uint32 oldSR, uint32 oldSP, uint32 newPC) final {
+            m_stream.Emit<RecordType::SH2Exception>(record::SH2Exception{vecNum, oldPC, oldSR, oldSP, newPC});
+        }
+
+        void Trap(uint8 vecNum, uint32 oldPC, uint32 oldSP, uint32 newPC) final {
+            m_stream.Emit<RecordType::SH2Trap>(record::SH2Trap{vecNum, oldPC, oldSP, newPC});
+        }
+
+        void DMAXferBegin(uint32 channel, uint32 srcAddress, uint32 dstAddress, uint32 count, uint32 unitSize,
+                          sint32 srcInc, sint32 dstInc) final {
+            m_stream.Emit<RecordType::SH2DMABegin>(record::SH2DMABegin{
+                static_cast<uint8>(channel), static_cast<uint8>(unitSize), srcAddress, dstAddress, count, srcInc, dstInc});
+        }
+
+        void DMAXferEnd(uint32 channel, bool irqRaised) final {
+            m_stream.Emit<RecordType::SH2DMAEnd>(record::SH2DMAEnd{static_cast<uint8>(channel), irqRaised});
+        }
+
+    private:
+        Stream &m_stream;
+    };
+
+    class SCUTracer final : public ISCUTracer {
+    public:
+        explicit SCUTracer(Stream &stream)
+            : m_stream(stream) {}
+
+        void RaiseInterrupt(uint8 index, uint8 level) final {
+            m_stream.Emit<RecordType::SCURaiseInterrupt>(record::SCURaiseInterrupt{index, level});
+        }
+
+        void AcknowledgeInterrupt(uint8 index) final {
+            m_stream.Emit<RecordType::SCUAcknowledgeInterrupt>(record::SCUAcknowledgeInterrupt{index});
+        }
+
+        void DMA(uint8 channel, uint32 srcAddr, uint32 dstAddr, uint32 xferCount, uint32 srcAddrInc,
+                 uint32 dstAddrInc, bool indirect, uint32 indirectAddr) final {
+            m_stream.Emit<RecordType::SCUDMA>(record::SCUDMA{channel, indirect, srcAddr, dstAddr, xferCount,
+                                                             srcAddrInc, dstAddrInc, indirectAddr});
+        }
+
+        void DSPDMA(bool toD0, uint32 addrD0, uint8 addrDSP, uint8 count, uint8 addrInc, bool hold) final {
+            m_stream.Emit<RecordType::SCUDSPDMA>(record::SCUDSPDMA{toD0, addrDSP, count, addrInc, hold, addrD0});
+        }
+
+    private:
+        Stream &m_stream;
+    };
+
+    class CDBlockTracer final : public ICDBlockTracer {
+    public:
+        explicit CDBlockTracer(Stream &stream)
+            : m_stream(stream) {}
+
+        void ProcessCommand(uint16 cr1, uint16 cr2, uint16 cr3, uint16 cr4) final {
+            m_stream.Emit<RecordType::CDBlockCommand>(record::CDBlockCommand{cr1, cr2, cr3, cr4});
+        }
+
+        void ProcessCommandResponse(uint16 cr1, uint16 cr2, uint16 cr3, uint16 cr4) final {
+            m_stream.Emit<RecordType::CDBlockResponse>(record::CDBlockCommand{cr1, cr2, cr3, cr4});
+        }
+
+    private:
+        Stream &m_stream;
+    };
+
+    std::array<Stream, kNumSources> m_streams;
+
+    SH2Tracer m_masterSH2Tracer{m_streams[static_cast<size_t>(Source::MasterSH2)]};
+    SH2Tracer m_slaveSH2Tracer{m_streams[static_cast<size_t>(Source::SlaveSH2)]};
+    SCUTracer m_scuTracer{m_streams[static_cast<size_t>(Source::SCU)]};
+    CDBlockTracer m_cdblockTracer{m_streams[static_cast<size_t>(Source::CDBlock)]};
+
+    std::atomic_bool m_recording = false;
+
+    // Chunk buffer pool
+    std::mutex m_chunkAllocMutex;
+    std::vector<std::unique_ptr<Chunk>> m_chunks;
+    moodycamel::BlockingConcurrentQueue<Chunk *> m_freeChunks;
+
+    /// @brief Acquires a free chunk buffer, allocating a new one if the pool is empty and the limit has not been
+    /// reached, or waiting for the writer thread to recycle one otherwise.
+    Chunk *AcquireChunk();
+
+    // Writer thread
+    std::thread m_writerThread;
+    moodycamel::BlockingConcurrentQueue<Chunk *> m_pendingChunks;
+    std::atomic_uint64_t m_nextSequence = 0;
+    std::ofstream m_out;
+
+    std::atomic_uint64_t m_statChunks = 0;
+    std::atomic_uint64_t m_statRecords = 0;
+    std::atomic_uint64_t m_statRawBytes = 0;
+    std::atomic_uint64_t m_statCompressedBytes = 0;
+    std::atomic_bool m_writeError = false;
+
+    void WriterThread();
+};
+
+} // namespace ymir::debug::trace
@@ -5,6 +5,11 @@
 #include "cart_base.hpp"
 
 #include <ymir/util/data_ops.hpp>
+#include <ymir/util/shared_memory.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <span>
 
 namespace ymir::cart {
 
@@ -48,26 +53,48 @@ public:
 
     void PokeByte(uint32 address, uint8 value) override {
         if (util::AddressInRange<0x200'0000, 0x3FF'FFFF>(address)) {
+            m_romSlot.MakeWritable();
             m_rom[address & (kROMCartSize - 1)] = value;
         }
     }
     void PokeWord(uint32 address, uint16 value) override {
         if (util::AddressInRange<0x200'0000, 0x3FF'FFFF>(address)) {
+            m_romSlot.MakeWritable();
             util::WriteBE<uint16>(&m_rom[address & (kROMCartSize - 1) & ~1], value);
         }
     }
 
     void LoadROM(std::span<const uint8> out) {
         const size_t size = std::min(out.size(), kROMCartSize);
-        std::copy_n(out.begin(), size, m_rom.begin());
+        m_romSlot.MapPrivate();
+        std::copy_n(out.begin(), size, m_rom);
+    }
+
+    /// @brief Loads a ROM image from shared memory.
+    ///
+    /// Images of exactly `kROMCartSize` bytes are mapped without copying, sharing their physical memory with every other
+    /// cartridge that loads the same image. Pokes turn the mapping into a private copy-on-write view. Smaller images are
+    /// copied.
+    ///
+    /// @param[in] rom the shared ROM image
+    void LoadROM(std::shared_ptr<const util::SharedMemory> rom) {
+        m_romSlot.MapShared(std::move(rom), false);
+    }
+
+    /// @brief Determines if the cartridge holds the specified ROM image.
+    /// @param[in] rom the ROM image to compare against
+    /// @return `true` if the first `rom.size()` bytes of the cartridge ROM match `rom`
+    bool HasROM(std::span<const uint8> rom) const {
+        return rom.size() <= kROMCartSize && std::equal(rom.begin(), rom.end(), m_rom);
     }
 
     void DumpROM(std::span<uint8, kROMCartSize> out) const {
-        std::copy(m_rom.begin(), m_rom.end(), out.begin());
+        std::copy_n(m_rom, kROMCartSize, out.begin());
     }
 
 protected:
-    std::array<uint8, kROMCartSize> m_rom;
+    util::SharedMemorySlot m_romSlot{kROMCartSize};
+    uint8 *const m_rom = m_romSlot.Data(); // stable across loads
 };
 
 } // namespace ymir::cart
@@ -4,6 +4,7 @@
 
 #include "cdblock_buffer.hpp"
 #include "cdblock_filter.hpp"
+#include "cdblock_partition_manager.hpp"
 
 #include <ymir/core/configuration.hpp>
 #include <ymir/core/scheduler.hpp>
@@ -12,6 +13,7 @@
 #include <ymir/sys/clocks.hpp>
 
 #include <ymir/debug/cdblock_tracer_base.hpp>
+#include <ymir/debug/host_timing.hpp>
 
 #include <ymir/hw/cdblock/cdblock_internal_callbacks.hpp>
 #include <ymir/sys/system_internal_callbacks.hpp>
@@ -26,7 +28,7 @@
 #include <ymir/core/hash.hpp>
 
 #include <array>
-#include <deque>
+#include <span>
 
 namespace ymir::cdblock {
 
@@ -87,6 +89,9 @@ private:
     template <mem_primitive T>
     T ReadReg(uint32 address);
 
+    // Performs successive 32-bit reads from the same register. Used by DMA engines to pull transfer data in bulk.
+    uint32 ReadRegBulk(uint32 address, std::span<uint32> out);
+
     template <mem_primitive T>
     void WriteReg(uint32 address, T value);
 
@@ -189,17 +194,18 @@ private:
     uint32 m_xferPos;                          // Current transfer position in words
     uint32 m_xferLength;                       // Total number of words to be transferred
     uint32 m_xferCount;                        // Number of words transferred in the last transfer
-    std::array<uint16, 2352 / 2> m_xferBuffer; // Transfer buffer
+    std::array<uint16, 2352 / 2> m_xferBuffer; // Transfer buffer for TOC, file info and subcode transfers
     uint32 m_xferBufferPos;                    // Transfer buffer position
 
     // Parameters for sector transfers
-    uint32 m_xferSectorPos; // Current transfer sector position
-    uint32 m_xferSectorEnd; // Last sector to transfer
-    uint8 m_xferPartition;  // From which partition to read
+    uint32 m_xferSectorPos;  // Current transfer sector position
+    uint32 m_xferSectorEnd;  // Last sector to transfer
+    uint8 m_xferPartition;   // From which partition to read
     // uint8 m_xferFilter;      // To which filter to write
-    uint32 m_xferGetLength; // How many bytes to read from the current sector
-    uint32 m_xferDelStart;  // Starting offset of sectors to delete in GetThenDeleteSector transfer
-    uint32 m_xferDelCount;  // Number of sectors to delete in GetThenDeleteSector transfer
+    uint32 m_xferGetLength;  // How many bytes to read from the current sector
+    uint8 *m_xferSectorData; // Current sector data, read in place from its pool buffer (nullptr if out of bounds)
+    uint32 m_xferDelStart;   // Starting offset of sectors to delete in GetThenDeleteSector transfer
+    uint32 m_xferDelCount;   // Number of sectors to delete in GetThenDeleteSector transfer
 
     // Parameters for subcode transfers
     uint32 m_xferSubcodeFrameAddress; // Last subcode R-W frame address
@@ -218,7 +224,14 @@ private:
 
     void ReadSector();
 
+    // Points m_xferSectorData to the data of the current sector being transferred.
+    void BindTransferSector();
+
+    // Reads the word at the current transfer buffer position without advancing the transfer.
+    uint16 PeekTransferWord() const;
+
     uint16 DoReadTransfer();
+    void DoReadTransferBulk(std::span<uint16> out); // same as calling DoReadTransfer() for each element
     void DoWriteTransfer(uint16 value);
 
     void AdvanceTransfer();
@@ -270,58 +283,14 @@ private:
     //
     // Disconnected filter output connectors will result in dropping the data.
 
-    class PartitionManager {
-    public:
-        PartitionManager();
-
-        void UseTracer(debug::ICDBlockTracer *tracer) {
-            m_tracer = tracer;
-        }
-
-        void Reset();
-
-        uint8 GetBufferCount(uint8 partitionIndex) const;
-        uint32 GetFreeBufferCount() const;
-        bool ReserveBuffers(uint16 count);
-        bool UseReservedBuffers(uint16 count);
-        void ReleaseReservedBuffers();
-
-        void InsertHead(uint8 partitionIndex, const Buffer &buffer);
-        Buffer *GetTail(uint8 partitionIndex, uint8 offset);
-        bool RemoveTail(uint8 partitionIndex, uint8 offset);
-
-        uint32 DeleteSectors(uint8 partitionIndex, uint16 sectorPos, uint16 sectorCount);
-
-        void Clear(uint8 partitionIndex);
-
-        uint32 CalculateSize(uint8 partitionIndex, uint32 start, uint32 end) const;
-
-        // -------------------------------------------------------------------------
-        // Save states
-
-        void SaveState(savestate::CDBlockSaveState &state) const;
-        [[nodiscard]] bool ValidateState(const savestate::CDBlockSaveState &state) const;
-        void LoadState(const savestate::CDBlockSaveState &state);
-
-        // -------------------------------------------------------------------------
-        // Debugger
-
-        void OnTracerAttached();
-
-    private:
-        std::array<std::deque<Buffer>, kNumPartitions> m_partitions;
-
-        uint32 m_freeBuffers;
-        uint32 m_reservedBuffers;
-
-        debug::ICDBlockTracer *m_tracer = nullptr;
-    };
-
     PartitionManager m_partitionManager;
     std::array<Filter, kNumFilters> m_filters;
 
-    std::array<Buffer, kNumBuffers + 1> m_scratchBuffers;
-    uint32 m_scratchBufferPutIndex;
+    // Receives sectors read from the drive while no pool buffers are free; they are either sent to the SCSP or dropped.
+    Buffer m_scratchBuffer;
+
+    // Put Sector Data writes straight into the buffers reserved in the partition manager.
+    uint32 m_putBufferIndex; // Index of the reserved buffer being written
 
     uint8 m_cdDeviceConnection;
     uint8 m_lastCDWritePartition;
@@ -337,6 +306,14 @@ private:
 
     void DisconnectFilterInput(uint8 filterNumber);
 
+    // Runs a sector through the filter chain starting at the given filter.
+    // Returns the destination buffer partition, or Filter::kDisconnected if the sector is discarded.
+    uint8 RouteSector(uint8 filterNumber, const Buffer &buffer) const;
+
+    // Validates the parameters of the copy/move sector data commands and computes the source sector range.
+    bool ResolveSectorRange(uint8 dstFilterNumber, uint8 srcPartitionNumber, uint16 sectorOffset, uint16 sectorNumber,
+                            uint32 &startSector, uint32 &sectorCount) const;
+
     // -------------------------------------------------------------------------
     // Commands
 
@@ -454,6 +431,12 @@ public:
         m_partitionManager.OnTracerAttached();
     }
 
+    // Attaches host timing statistics to this component.
+    // Pass nullptr to disable timing.
+    void UseHostTimingStats(debug::HostTimingStats *stats) {
+        m_hostTiming = stats;
+    }
+
     class Probe {
     public:
         Probe(CDBlock &cdblock);
@@ -490,6 +473,7 @@ public:
 private:
     Probe m_probe{*this};
     debug::ICDBlockTracer *m_tracer = nullptr;
+    debug::HostTimingStats *m_hostTiming = nullptr;
 
     uint8 m_netlinkSCR;
 };
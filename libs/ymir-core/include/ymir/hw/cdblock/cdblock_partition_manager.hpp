@@ -0,0 +1,167 @@
+#pragma once
+
+#include "cdblock_buffer.hpp"
+#include "cdblock_defs.hpp"
+
+#include <ymir/debug/cdblock_tracer_base.hpp>
+
+#include <ymir/savestate/savestate_cdblock.hpp>
+
+#include <ymir/core/types.hpp>
+
+#include <array>
+#include <cassert>
+
+namespace ymir::cdblock {
+
+// Manages the fixed pool of sector buffers and their assignment to buffer partitions.
+//
+// Buffers are never copied when moving between partitions or the free list. Each buffer is identified by its index in
+// the pool. Every partition keeps an ordered list of the indices of its buffers, from the oldest ("tail", offset 0) to
+// the newest ("head") sector, so that sectors can be looked up by offset in constant time. Free buffers are kept in a
+// stack of indices. Reserved buffers sit at the bottom of the stack and are not handed out until they are inserted into
+// a partition with InsertReservedBuffers().
+class PartitionManager {
+public:
+    static constexpr uint8 kNoBuffer = 0xFF;
+    static_assert(kNumBuffers < kNoBuffer);
+
+    static constexpr uint8 kNoPartition = 0xFF;
+    static_assert(kNumPartitions < kNoPartition);
+
+    PartitionManager();
+
+    void UseTracer(debug::ICDBlockTracer *tracer) {
+        m_tracer = tracer;
+    }
+
+    void Reset();
+
+    uint8 GetBufferCount(uint8 partitionIndex) const;
+    uint32 GetFreeBufferCount() const;
+    bool ReserveBuffers(uint16 count);
+    void ReleaseReservedBuffers();
+
+    // Returns the index of the reserved buffer at the given position, or kNoBuffer if fewer buffers are reserved.
+    // Reserved buffers can be written to in place before they are inserted into a partition.
+    uint8 GetReservedBuffer(uint16 index) const;
+
+    // Links the first count reserved buffers to the head of a partition in order, without copying their contents.
+    // Returns false if fewer buffers are reserved.
+    bool InsertReservedBuffers(uint8 partitionIndex, uint16 count);
+
+    // Returns the index of the buffer that will be returned by the next call to AllocateBuffer() without removing it
+    // from the free list, or kNoBuffer if there are no unreserved free buffers. Allows data to be written in place
+    // before deciding whether the buffer is to be kept.
+    uint8 PeekFreeBuffer() const;
+
+    // Removes a buffer from the free list. The buffer must be inserted into a partition with InsertHead().
+    // Returns kNoBuffer if there are no unreserved free buffers.
+    uint8 AllocateBuffer();
+
+    Buffer &GetBuffer(uint8 bufferIndex) {
+        assert(bufferIndex < kNumBuffers);
+        return m_buffers[bufferIndex];
+    }
+
+    const Buffer &GetBuffer(uint8 bufferIndex) const {
+        assert(bufferIndex < kNumBuffers);
+        return m_buffers[bufferIndex];
+    }
+
+    // Links an allocated buffer to the head of a partition.
+    void InsertHead(uint8 partitionIndex, uint8 bufferIndex);
+
+    // Copies the buffer into a newly allocated buffer and links it to the head of a partition.
+    void InsertHead(uint8 partitionIndex, const Buffer &buffer);
+
+    Buffer *GetTail(uint8 partitionIndex, uint8 offset);
+    bool RemoveTail(uint8 partitionIndex, uint8 offset);
+
+    uint32 DeleteSectors(uint8 partitionIndex, uint16 sectorPos, uint16 sectorCount);
+
+    // Moves count sectors starting at the given offset out of a partition. route(const Buffer &) returns the partition
+    // each sector goes to, or kNoPartition to discard it. Buffers are relinked by index without copying their contents.
+    // Sectors routed back into the source partition are appended to it.
+    template <typename FnRoute>
+    void MoveSectors(uint8 partitionIndex, uint32 offset, uint32 count, FnRoute &&route) {
+        assert(partitionIndex < m_partitions.size());
+        assert(offset + count <= m_partitions[partitionIndex].count);
+        for (uint32 i = 0; i < count; i++) {
+            const uint8 bufferIndex = DetachBuffer(partitionIndex, offset);
+            const uint8 dstPartitionIndex = route(static_cast<const Buffer &>(m_buffers[bufferIndex]));
+            if (dstPartitionIndex != kNoPartition) {
+                InsertHead(dstPartitionIndex, bufferIndex);
+            } else {
+                ReleaseBuffer(bufferIndex);
+            }
+        }
+    }
+
+    // Copies count sectors starting at the given offset of a partition into buffers allocated from the pool.
+    // route(const Buffer &) returns the partition each copy goes to, or kNoPartition to skip the sector.
+    // Returns false without copying anything if there are not enough free buffers to copy every sector.
+    template <typename FnRoute>
+    bool CopySectors(uint8 partitionIndex, uint32 offset, uint32 count, FnRoute &&route) {
+        assert(partitionIndex < m_partitions.size());
+        assert(offset + count <= m_partitions[partitionIndex].count);
+        if (count > m_freeBuffers - m_reservedBuffers) {
+            return false;
+        }
+        // Copies routed back into the source partition are appended after the sectors being copied
+        const auto &partition = m_partitions[partitionIndex];
+        for (uint32 i = 0; i < count; i++) {
+            const Buffer &buffer = m_buffers[partition.buffers[offset + i]];
+            const uint8 dstPartitionIndex = route(buffer);
+            if (dstPartitionIndex != kNoPartition) {
+                InsertHead(dstPartitionIndex, buffer);
+            }
+        }
+        return true;
+    }
+
+    void Clear(uint8 partitionIndex);
+
+    uint32 CalculateSize(uint8 partitionIndex, uint32 start, uint32 end) const;
+
+    // -------------------------------------------------------------------------
+    // Save states
+
+    void SaveState(savestate::CDBlockSaveState &state) const;
+    [[nodiscard]] bool ValidateState(const savestate::CDBlockSaveState &state) const;
+    void LoadState(const savestate::CDBlockSaveState &state);
+
+    // -------------------------------------------------------------------------
+    // Debugger
+
+    void OnTracerAttached();
+
+private:
+    struct Partition {
+        std::array<uint8, kNumBuffers> buffers; // buffer indices from oldest to newest
+        uint8 count = 0;
+    };
+
+    alignas(64) std::array<Buffer, kNumBuffers> m_buffers;
+    std::array<Partition, kNumPartitions> m_partitions;
+    std::array<uint8, kNumBuffers> m_freeList; // free buffer indices; the top of the stack is at m_freeBuffers - 1
+
+    uint32 m_freeBuffers;
+    uint32 m_reservedBuffers;
+
+    // Returns all buffers to the free list and empties all partitions.
+    void ResetPool();
+
+    // Returns a buffer unlinked from a partition to the free list.
+    void ReleaseBuffer(uint8 bufferIndex);
+
+    // Unlinks the buffer at the given offset from a partition without returning it to the free list.
+    uint8 DetachBuffer(uint8 partitionIndex, uint32 offset);
+
+    // Unlinks count buffers starting at the given offset from a partition and returns them to the free list.
+    void RemoveRange(uint8 partitionIndex, uint32 offset, uint32 count);
+
+    debug::ICDBlockTracer *m_tracer = nullptr;
+};
+
+} // namespace ymir::cdblock
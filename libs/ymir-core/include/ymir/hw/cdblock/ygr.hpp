@@ -18,6 +18,7 @@
 
 #include <array>
 #include <cassert>
+#include <span>
 
 namespace ymir::cdblock {
 
@@ -58,6 +59,8 @@ struct YGR {
     uint16 HostReadWord(uint32 address) const;
     template <bool doubleFIFOPull>
     uint32 HostReadLong(uint32 address) const;
+    template <bool doubleFIFOPull>
+    uint32 HostReadLongBulk(uint32 address, std::span<uint32> out) const;
 
     template <bool poke>
     void HostWriteWord(uint32 address, uint16 value);
@@ -36,6 +36,10 @@ public:
 
     void SetExternalInterruptLevel(uint8 level);
 
+    uint32 GetPC() const {
+        return PC;
+    }
+
     // -------------------------------------------------------------------------
     // Save states
 
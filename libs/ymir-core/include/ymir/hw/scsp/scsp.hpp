@@ -18,6 +18,7 @@
 
 #include <ymir/hw/hw_defs.hpp>
 
+#include <ymir/debug/host_timing.hpp>
 #include <ymir/debug/scsp_tracer_base.hpp>
 
 #include <ymir/hw/cdblock/cdblock_internal_callbacks.hpp>
@@ -34,7 +35,6 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
-#include <blockingconcurrentqueue.h>
 #include <iosfwd>
 #include <mutex>
 #include <optional>
@@ -131,6 +131,22 @@ public:
         m_cbOutputSample = callback;
     }
 
+    void SetSampleBlockCallback(CBOutputSampleBlock callback) {
+        m_cbOutputSampleBlock = callback;
+    }
+
+    // Sends all buffered samples to the sample block callback.
+    // In threaded mode, the SCSP thread sends them once it catches up with the emulator thread; this does not block.
+    void FlushOutput();
+
+    // Returns the number of output samples produced since the SCSP was created. Since the SCSP outputs exactly 44100
+    // samples per emulated second, this doubles as a monotonic emulated clock. Not affected by resets or save states.
+    // Must be called from the emulator thread. In threaded mode, the most recent samples may not have been sent to the
+    // sample callbacks yet.
+    [[nodiscard]] uint64 GetOutputSampleCount() const {
+        return m_outputSampleCount;
+    }
+
     void MapCallbacks(CBTriggerSoundRequestInterrupt callback) {
         m_cbTriggerSoundRequestInterrupt = callback;
     }
@@ -210,11 +226,18 @@ private:
     // set to false when the CDDA buffer is empty
     bool m_cddaReady;
 
+    // Reads the next CDDA sample pair from the buffer, or silence on underruns.
+    std::array<sint16, 2> ReadCDDASample();
+
     m68k::MC68EC000 m_m68k;
     uint64 m_m68kSpilloverCycles;
     std::atomic<uint64> m_m68kClockShift = 0ull;
     std::atomic<bool> m_m68kEnabled = false;
 
+    // M68K program counter published by the thread running the M68K after every burst of instructions, so that the
+    // emulator thread can sample it while the SCSP runs on its own thread.
+    std::atomic<uint32> m_m68kPublishedPC = 0;
+
     core::Scheduler &m_scheduler;
     core::EventID m_sampleTickEvent;
 
@@ -265,6 +288,7 @@ private:
     bool m_debugTracing = false;
 
     CBOutputSample m_cbOutputSample;
+    CBOutputSampleBlock m_cbOutputSampleBlock;
     CBTriggerSoundRequestInterrupt m_cbTriggerSoundRequestInterrupt;
     CBSendMidiOutputMessage m_cbSendMidiOutputMessage;
 
@@ -1118,8 +1142,7 @@ private:
     void UpdateM68KInterrupts();
     void UpdateSCUInterrupts() {
         if (m_threadedSCSP) {
-            m_scspInterruptLevel.store((m_scuPendingInterrupts & m_scuEnabledInterrupts) != 0,
-                                       std::memory_order_relaxed);
+            PublishSCUInterrupt((m_scuPendingInterrupts & m_scuEnabledInterrupts) != 0);
         } else {
             m_cbTriggerSoundRequestInterrupt((m_scuPendingInterrupts & m_scuEnabledInterrupts) != 0);
         }
@@ -1154,7 +1177,7 @@ private:
     void TickSample(); // Processes a full sample (512 SCSP cycles)
 
     void RunM68K(uint64 cycles);
-    void UpdateTimers();
+    void UpdateTimers(uint64 sampleCounter);
 
     // Emulates one slot's worth of cycles.
     // This executes the 7 slot operations once, and 4 DSP program steps.
@@ -1174,6 +1197,9 @@ private:
     // Advances the sample counter by one.
     void IncrementSampleCounter();
 
+    // Ticks timers and raises the interrupts signaled at the end of a sample.
+    void RaiseSampleInterrupts(uint64 sampleCounter);
+
     // Accumulates audio data into the final output using the given send level and panning parameters.
     void AddOutput(sint32 output, uint8 sendLevel, uint8 pan);
 
@@ -1226,6 +1252,7 @@ private:
 
     uint64 m_m68kCycles;                     // MC68EC000 cycle counter
     std::atomic<uint64> m_sampleCounter = 0; // Total number of samples
+    uint64 m_outputSampleCount = 0;          // Total number of output samples, tracked by the emulator thread
 
     uint32 m_lfsr; // Noise LFSR
 
@@ -1233,6 +1260,14 @@ private:
 
     std::array<sint32, 2> m_out;
 
+    // Samples pending delivery to the sample block callback
+    static constexpr uint32 kSampleBlockSize = 1024;
+    std::array<OutputSample, kSampleBlockSize> m_sampleBlock;
+    uint32 m_sampleBlockCount = 0;
+
+    // Sends all buffered samples to the sample block callback.
+    void FlushSampleBlock();
+
     // -------------------------------------------------------------------------
     // Interrupt handling
 
@@ -1257,6 +1292,13 @@ public:
         m_tracer = tracer;
     }
 
+    // Attaches host timing statistics to this component.
+    // Pass nullptr to disable timing.
+    // When running the SCSP on a dedicated thread, samples are timed on that thread.
+    void UseHostTimingStats(debug::HostTimingStats *stats) {
+        m_hostTiming = stats;
+    }
+
     class Probe {
     public:
         explicit Probe(SCSP &scsp);
@@ -1285,6 +1327,20 @@ public:
             return m_scsp.m_m68kInterruptLevels;
         }
 
+        bool IsM68KEnabled() const {
+            return m_scsp.m_m68kEnabled;
+        }
+
+        uint32 GetM68KPC() const {
+            return m_scsp.m_m68k.GetPC();
+        }
+
+        // Retrieves the M68K program counter as of the end of the last processed sample.
+        // Unlike GetM68KPC(), this is safe to call while the SCSP runs on its own thread.
+        uint32 GetPublishedM68KPC() const {
+            return m_scsp.m_m68kPublishedPC.load(std::memory_order_relaxed);
+        }
+
     private:
         SCSP &m_scsp;
     };
@@ -1301,36 +1357,46 @@ private:
     // -------------------------------------------------------------------------
     // Threading
     //
-    struct ConcQueueTraits : moodycamel::ConcurrentQueueDefaultTraits {
-        static constexpr size_t BLOCK_SIZE = 64;
-        static constexpr size_t EXPLICIT_BLOCK_EMPTY_COUNTER_THRESHOLD = 64;
-        static constexpr std::uint32_t EXPLICIT_CONSUMER_CONSUMPTION_QUOTA_BEFORE_ROTATE = 512;
-        static constexpr int MAX_SEMA_SPINS = 20000;
-    };
-
-    struct WriteEvent {
-        uint32 address;
-        uint32 value;
-        uint8 size;
-    };
-
-    struct ThreadEvent {
-        enum class Type { Write, Sample, Quit };
-
+    // Writes and CDDA samples are recorded by the emulator thread into a journal of fixed-size batches, each entry
+    // timestamped with the number of samples ticked since the start of its batch. The SCSP thread replays every entry
+    // at the exact sample it was recorded on, producing the same output as the single-threaded path.
+    //
+    // Sound request interrupt signal changes travel the other way. The SCSP thread publishes them stamped with the
+    // sample they happened on, along with the number of samples whose interrupt state is final. While the signal may
+    // change on its own (the M68K is running or MCIEB is nonzero), the emulator thread hands over every sample and
+    // waits for its interrupt state before moving on. The SCSP thread resolves the interrupt state of a sample before
+    // running its slots and DSP, so only the M68K and timers hold up the emulator thread.
+
+    static constexpr uint32 kJournalBatchEntries = 512; // maximum number of entries in a batch
+    static constexpr uint32 kJournalBatchSamples = 128; // maximum number of samples ticked in a batch
+    static constexpr uint32 kJournalDepth = 8;          // number of batches in the ring
+
+    struct JournalEntry {
+        enum class Type : uint8 { Write, CDDA };
+
+        uint32 sample;  // number of samples ticked in the batch before this entry is applied
+        uint32 address; // write address
+        uint32 value;   // write value, or CDDA samples (left in bits 0-15, right in bits 16-31)
+        uint8 size;     // write size in bytes
         Type type;
-        WriteEvent write;
-
-        static ThreadEvent Write(uint32 address, uint32 value, uint8 size) {
-            return ThreadEvent{.type = Type::Write,
-                               .write = WriteEvent{.address = address, .value = value, .size = size}};
-        }
+    };
 
-        static ThreadEvent Sample() {
-            return ThreadEvent{.type = Type::Sample};
+    struct JournalBatch {
+        std::array<JournalEntry, kJournalBatchEntries> entries;
+        uint32 numEntries = 0;
+        uint32 numSamples = 0;
+        bool flushOutput = false; // deliver buffered output samples after processing the batch
+        bool quit = false;        // stop the SCSP thread after processing the batch
+
+        void Clear() {
+            numEntries = 0;
+            numSamples = 0;
+            flushOutput = false;
+            quit = false;
         }
 
-        static ThreadEvent Quit() {
-            return ThreadEvent{.type = Type::Quit};
+        [[nodiscard]] bool IsEmpty() const {
+            return numEntries == 0 && numSamples == 0 && !flushOutput && !quit;
         }
     };
 
@@ -1338,18 +1404,40 @@ private:
     std::atomic<bool> m_threadRunning = false;
     std::atomic<bool> m_threadedSCSP = false;
 
-    std::atomic<uint64> m_eventsProcessed = 0;
-    uint64 m_eventsEnqueued = 0;
+    std::array<JournalBatch, kJournalDepth> m_journal;
 
-    moodycamel::BlockingConcurrentQueue<ThreadEvent, ConcQueueTraits> m_threadEventQueue;
-    moodycamel::ProducerToken m_ptokThreadEventQueue{m_threadEventQueue};
-    moodycamel::ConsumerToken m_ctokThreadEventQueue{m_threadEventQueue};
+    // Number of batches submitted to and processed by the SCSP thread
+    alignas(64) std::atomic<uint64> m_journalSubmitted = 0;
+    alignas(64) std::atomic<uint64> m_journalProcessed = 0;
 
-    std::mutex m_cddaMutex;
-    std::mutex m_midiQueueMutex;
+    static constexpr uint32 kInterruptEventCount = 256; // capacity of the interrupt event ring
+
+    struct InterruptEvent {
+        uint64 sample; // sample the signal changed on
+        bool level;
+    };
 
-    std::atomic<bool> m_scspInterruptLevel{false};
-    bool m_lastSCSPInterruptLevel = false;
+    std::array<InterruptEvent, kInterruptEventCount> m_interruptEvents;
+
+    // Number of interrupt events published by the SCSP thread and delivered by the emulator thread
+    alignas(64) std::atomic<uint64> m_interruptEventsPublished = 0;
+    alignas(64) std::atomic<uint64> m_interruptEventsDelivered = 0;
+
+    // Number of samples whose interrupt state is final and the value of MCIEB after the last of them.
+    // Written by the SCSP thread.
+    alignas(64) std::atomic<uint64> m_interruptSamplesPublished = 0;
+    std::atomic<uint16> m_publishedSCUEnabledInterrupts = 0;
+
+    // SCSP thread state
+    uint64 m_scspThreadSample = 0;          // number of samples ticked by the SCSP thread
+    bool m_scspThreadInterruptLevel = false; // last published sound request interrupt signal
+
+    // Emulator thread state
+    uint64 m_journalSample = 0; // number of samples recorded into the journal
+    // MCIEB as of the last sample whose interrupt state was delivered
+    uint16 m_journalSCUEnabledInterrupts = 0;
+
+    std::mutex m_midiQueueMutex;
 
     sys::SH2Bus *m_bus = nullptr;
 
@@ -1362,15 +1450,42 @@ private:
     // Stops the SCSP thread if running and waits for it to finish.
     void StopSCSPThread();
 
-    // Periodically checks and triggers sound request interrupts back to the SCU.
-    void PollSCSPInterrupts();
+    // Returns true if the sound request interrupt signal may change without a write from the SCU, in which case the
+    // emulator thread waits for the interrupt state of every sample.
+    [[nodiscard]] bool IsSCSPInterruptLive() const {
+        return m_m68kEnabled || m_journalSCUEnabledInterrupts != 0;
+    }
+
+    // Records a sound request interrupt signal change on the SCSP thread.
+    void PublishSCUInterrupt(bool level);
+
+    // Publishes the interrupt state of the sample being ticked on the SCSP thread.
+    void PublishSCUInterruptSample();
 
-    // Queues a write operation to be applied by the SCSP thread.
+    // Waits until the interrupt state of the current sample is published, then delivers it to the SCU.
+    void WaitForSCSPInterrupts();
+
+    // Triggers published sound request interrupt signal changes on the SCU.
+    void DeliverSCSPInterrupts();
+
+    // Records a write operation to be applied by the SCSP thread at the current sample.
     template <mem_primitive T>
     void EnqueueWrite(uint32 address, T value);
 
-    // Queues an event to be processed by the SCSP thread.
-    void EnqueueEvent(ThreadEvent &&event);
+    // Returns the batch currently being recorded by the emulator thread.
+    JournalBatch &CurrentJournalBatch() {
+        return m_journal[m_journalSubmitted.load(std::memory_order_relaxed) % kJournalDepth];
+    }
+
+    // Appends an entry to the current batch, submitting it if full.
+    void AppendJournalEntry(const JournalEntry &entry);
+
+    // Hands the current batch over to the SCSP thread and starts recording a new one, waiting for a free slot in the
+    // ring if necessary.
+    void SubmitJournalBatch();
+
+    // Replays a batch on the SCSP thread.
+    void ProcessJournalBatch(JournalBatch &batch);
 
     void MapMemoryDirect(sys::SH2Bus &bus);
     void MapMemoryThreaded(sys::SH2Bus &bus);
@@ -1389,15 +1504,10 @@ private:
     template <uint32 stepShift>
     void TickSlotsThreaded();
 
-public:
-    // Syncs execution at the end of the frame.
-    void SyncSCSPThreadPublic() {
-        SyncSCSPThread();
-    }
-
 private:
     Probe m_probe{*this};
     debug::ISCSPTracer *m_tracer = nullptr;
+    debug::HostTimingStats *m_hostTiming = nullptr;
 };
 
 } // namespace ymir::scsp
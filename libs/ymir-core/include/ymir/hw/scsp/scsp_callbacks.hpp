@@ -4,11 +4,22 @@
 
 #include <ymir/util/callback.hpp>
 
+#include <span>
+
 namespace ymir::scsp {
 
+// A stereo output sample
+struct OutputSample {
+    sint16 left, right;
+};
+
 // Sample output callback, invoked every sample
 using CBOutputSample = util::OptionalCallback<void(sint16 left, sint16 right)>;
 
+// Sample block output callback, invoked with consecutive samples whenever the output block fills up and at the end of
+// every frame
+using CBOutputSampleBlock = util::OptionalCallback<void(std::span<const OutputSample> samples)>;
+
 // MIDI message output callback, invoked when a complete midi message is ready to send
 using CBSendMidiOutputMessage = util::OptionalCallback<void(std::span<uint8> msg)>;
 
@@ -93,6 +93,20 @@ public:
         return m_activeDMAChannelLevel < m_dmaChannels.size() || m_dsp.dmaRun;
     }
 
+    // Checks if the SCU has no work in progress: no DMA transfers or pending DMA end interrupts and no DSP program.
+    // Advancing an idle SCU in several runs of cycles has the same effect as advancing it once through all of them.
+    bool IsIdle() const {
+        if (IsDMAActive() || m_dsp.programExecuting || m_dsp.programStep) {
+            return false;
+        }
+        for (const auto &ch : m_dmaChannels) {
+            if (ch.intrDelay != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     // -------------------------------------------------------------------------
     // Cartridge slot
 
@@ -14,6 +14,7 @@
 
 #include <array>
 
+#include "scu_dsp_decode.hpp"
 #include "scu_dsp_instr.hpp"
 
 namespace ymir::scu {
@@ -55,7 +56,9 @@ public:
             }
         }
 
-        programRAM[PC++].u32 = value;
+        programRAM[PC].u32 = value;
+        m_programOps[PC] = TranslateDSPInstr(programRAM[PC]);
+        PC++;
     }
 
     template <bool poke>
@@ -397,8 +400,32 @@ private:
 
     debug::ISCUTracer *m_tracer = nullptr;
 
+    // Pre-translated program RAM.
+    // Entries are retranslated when program RAM is written through WriteProgram or DMA transfers. Direct writes to
+    // programRAM (debugger, save states) are caught by FetchOp, which compares the translated instruction against the
+    // one being executed.
+    std::array<DSPOp, 256> m_programOps;
+    DSPOp m_scratchOp;        // translation of instructions that don't match program RAM
+    uint8 m_nextInstrAddress; // program address from which nextInstr was fetched
+
     void IncrementPC();
 
+    // Retrieves the translation of the given instruction fetched from the specified program address
+    FORCE_INLINE const DSPOp &FetchOp(uint8 address, DSPInstr instr) {
+        DSPOp &op = m_programOps[address];
+        if (op.instr == instr) [[likely]] {
+            return op;
+        }
+        if (programRAM[address] == instr) {
+            op = TranslateDSPInstr(instr);
+            return op;
+        }
+        m_scratchOp = TranslateDSPInstr(instr);
+        return m_scratchOp;
+    }
+
+    void TranslateProgram();
+
     // Run pending DMA transfer if the CT register is in use
     template <bool debug>
     FORCE_INLINE void RunPendingDMA(uint8 ctIndex) {
@@ -410,13 +437,16 @@ private:
     // Command interpreters
 
 #define TPL_DEBUG template <bool debug>
-    TPL_DEBUG void Cmd_Operation(DSPInstr instr);
-    TPL_DEBUG void Cmd_LoadImm(DSPInstr instr);
-    TPL_DEBUG void Cmd_Special(DSPInstr instr);
+    TPL_DEBUG void Cmd_Operation(const DSPOp &op);
+    void Cmd_ALUOnly(const DSPOp &op);
+    TPL_DEBUG void Cmd_LoadImm(const DSPOp &op);
     TPL_DEBUG void Cmd_Special_DMA(DSPInstr instr);
-    void Cmd_Special_Jump(DSPInstr instr);
-    void Cmd_Special_Loop(DSPInstr instr);
-    void Cmd_Special_End(DSPInstr instr);
+    void Cmd_Special_Jump(const DSPOp &op);
+    void Cmd_Special_LoopStart();
+    void Cmd_Special_LoopBottom();
+    void Cmd_Special_End(bool interrupt);
+
+    void ExecuteALU(uint8 aluOp);
 #undef TPL_DEBUG
 };
 
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <ymir/core/types.hpp>
+
+#include "scu_dsp_instr.hpp"
+
+namespace ymir::scu {
+
+// Pre-translated SCU DSP instruction types.
+enum class DSPOpType : uint8 {
+    Operation,   // ALU operation with X-Bus, Y-Bus and/or D1-Bus transfers
+    ALUOnly,     // ALU operation without bus transfers (includes NOP)
+    LoadImm,     // MVI SImm,[d]
+    LoadImmCond, // MVI SImm,[d],<cond>
+    DMA,         // DMA, DMAH
+    Jump,        // JMP SImm
+    JumpCond,    // JMP <cond>,SImm
+    LoopStart,   // LPS
+    LoopBottom,  // BTM
+    End,         // END
+    EndInt,      // ENDI
+    Invalid,     // instruction class 01; does nothing, not even advance PC
+};
+
+// D1-Bus transfers with all conflicts against X-Bus and Y-Bus transfers resolved.
+enum class DSPD1Op : uint8 {
+    None,    // no transfer, or the transfer is suppressed entirely
+    Imm,     // MOV SImm,[d]
+    ClearCT, // MOV SImm,MCn where the bank was read by the X/Y-Bus; clears bit 0 of CTn
+    Move,    // MOV [s],[d]
+    Read,    // MOV [s],P where P was written by the X-Bus; [s] is read and the value is discarded
+    IncCT,   // MOV MCs,MCd where MCd's bank was read by the X/Y-Bus; only CTs is incremented
+};
+
+// X-Bus and Y-Bus operation flags
+namespace dsp_bus {
+    inline constexpr uint8 kXMulToP = 1u << 0u;  // MOV MUL,P
+    inline constexpr uint8 kXReadToP = 1u << 1u; // MOV [s],P
+    inline constexpr uint8 kXReadToX = 1u << 2u; // MOV [s],X
+    inline constexpr uint8 kYClearA = 1u << 3u;  // CLR A
+    inline constexpr uint8 kYALUToA = 1u << 4u;  // MOV ALU,A
+    inline constexpr uint8 kYReadToA = 1u << 5u; // MOV [s],A
+    inline constexpr uint8 kYReadToY = 1u << 6u; // MOV [s],Y
+
+    inline constexpr uint8 kXRead = kXReadToP | kXReadToX;
+    inline constexpr uint8 kYRead = kYReadToA | kYReadToY;
+} // namespace dsp_bus
+
+// A pre-translated SCU DSP instruction.
+// All decisions that depend only on the instruction bits are resolved at translation time, so that execution only has
+// to perform the selected transfers.
+struct DSPOp {
+    DSPInstr instr{}; // source instruction
+
+    DSPOpType type = DSPOpType::ALUOnly;
+
+    uint8 aluOp = 0;    // ALU operation (aluInfo.aluOp)
+    uint8 busOps = 0;   // X-Bus and Y-Bus operations (dsp_bus::k*)
+    uint8 xBusSrc = 0;  // X-Bus [s]
+    uint8 yBusSrc = 0;  // Y-Bus [s]
+    DSPD1Op d1Op = DSPD1Op::None;
+    uint8 d1Src = 0;    // D1-Bus [s], or CT index for DSPD1Op::IncCT
+    uint8 dst = 0;      // D1-Bus or MVI [d], or CT index for DSPD1Op::ClearCT
+    uint8 cond = 0;     // MVI or JMP condition
+    sint32 imm = 0;     // D1-Bus or MVI immediate, or JMP target
+};
+
+// Translates a DSP instruction into its pre-decoded form.
+DSPOp TranslateDSPInstr(DSPInstr instr);
+
+} // namespace ymir::scu
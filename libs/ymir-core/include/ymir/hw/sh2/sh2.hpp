@@ -34,11 +34,14 @@
 #include <ymir/util/inline.hpp>
 #include <ymir/util/virtual_memory.hpp>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <iosfwd>
 #include <map>
 #include <set>
+#include <vector>
 
 namespace ymir::sh2 {
 
@@ -58,6 +61,12 @@ public:
         m_currCount = &currCountRef;
     }
 
+    // Retrieves a reference to the number of cycles executed so far in the current timeslice.
+    // Added to the global cycle counter, it yields the cycle count of the instruction being executed.
+    [[nodiscard]] const uint64 &GetSliceCyclesRef() const {
+        return m_cyclesExecuted;
+    }
+
     void BindEmulateCacheOption(const bool &emulateCacheRef) {
         m_emulateCache = &emulateCacheRef;
     }
@@ -67,16 +76,26 @@ public:
         if (mgr != nullptr) {
             m_breakpoints.Allocate();
             m_watchpoints.Allocate();
+            m_breakpointPages.Allocate();
+            m_watchpointPages.Allocate();
             ReapplyBreakpoints();
             ReapplyWatchpoints();
         } else {
             m_breakpoints.Free();
             m_watchpoints.Free();
+            m_breakpointPages.Free();
+            m_watchpointPages.Free();
         }
     }
 
     void MapMemory(sys::SH2Bus &bus);
 
+    // Redirects all memory accesses made by this CPU to the specified bus.
+    // Used to run the CPU speculatively against a journaling view of the system bus.
+    void UseBus(sys::SH2Bus &bus) {
+        m_bus = &bus;
+    }
+
     void DumpCacheData(std::ostream &out) const;
     void DumpCacheAddressTag(std::ostream &out) const;
 
@@ -104,6 +123,9 @@ public:
     bool GetNMI() const;
     void SetNMI();
 
+    // Triggers the FRT input capture, as done by writes to the MINIT/SINIT area.
+    void TriggerFRTInputCapture();
+
     // Purges the contents of the cache.
     // Should be done before enabling cache emulation to ensure previous cache contents are cleared.
     void PurgeCache();
@@ -145,7 +167,8 @@ private:
     FORCE_INLINE uint64 GetBreakpointBitmapChunk(uint32 address) const {
         address >>= 4u; // 1 bit for halfword alignment, 3 bits for 8 bits packed in a byte
         address &= ~(sizeof(uint64) - 1);
-        return *m_breakpoints.GetPointer<uint64>(address);
+        const uint64 *chunk = m_breakpoints.GetPointer<uint64>(address);
+        return chunk != nullptr ? *chunk : 0;
     }
 
     // Builds a value containing the breakpoint bitmap bit for the given address.
@@ -160,6 +183,7 @@ public:
     bool AddBreakpoint(uint32 address) {
         if (m_breakpoints.IsAllocated()) {
             BreakpointBitmapChunkRef(address) |= MakeBreakpointBit(address);
+            m_breakpointPages.Set(address, true);
         }
         return m_breakpointSet.insert(address & ~1u).second;
     }
@@ -171,7 +195,9 @@ public:
         if (m_breakpoints.IsAllocated()) {
             BreakpointBitmapChunkRef(address) &= ~MakeBreakpointBit(address);
         }
-        return m_breakpointSet.erase(address & ~1u);
+        const bool result = m_breakpointSet.erase(address & ~1u);
+        UpdateBreakpointPage(address);
+        return result;
     }
 
     // Toggles the breakpoint at the specified address.
@@ -186,6 +212,7 @@ public:
         if (!result) {
             m_breakpointSet.erase(address);
         }
+        UpdateBreakpointPage(address);
         return result;
     }
 
@@ -195,6 +222,7 @@ public:
             for (uint32 address : m_breakpointSet) {
                 BreakpointBitmapChunkRef(address) &= ~MakeBreakpointBit(address);
             }
+            m_breakpointPages.Clear();
         }
         m_breakpointSet.clear();
     }
@@ -221,11 +249,20 @@ public:
     }
 
 private:
-    // Determines if a breakpoint is set at specified address using the fast bitmap.
+    // Determines if a breakpoint is set at specified address using the page filter and the fast bitmap.
     // The address is force-aligned to word boundaries.
     // Must only be invoked if the bitmap is allocated.
     FORCE_INLINE bool IsBreakpointSetInBitmap(uint32 address) const {
-        return GetBreakpointBitmapChunk(address) & MakeBreakpointBit(address);
+        return m_breakpointPages.Test(address) && (GetBreakpointBitmapChunk(address) & MakeBreakpointBit(address));
+    }
+
+    // Updates the page filter bit for the page containing the given address after breakpoints were removed from it.
+    void UpdateBreakpointPage(uint32 address) {
+        if (m_breakpointPages.IsAllocated()) {
+            const uint32 pageStart = PageFilter::PageStart(address);
+            auto it = m_breakpointSet.lower_bound(pageStart);
+            m_breakpointPages.Set(address, it != m_breakpointSet.end() && *it <= pageStart + PageFilter::kPageMask);
+        }
     }
 
     // Reapplies the breakpoints from the set into the bitmap.
@@ -250,7 +287,23 @@ private:
     // Returns the watchpoint flags for the given address.
     template <mem_primitive T>
     FORCE_INLINE T GetWatchpointFlags(uint32 address) const {
-        return *m_watchpoints.GetPointer<T>(address);
+        const T *flags = m_watchpoints.GetPointer<T>(address);
+        return flags != nullptr ? *flags : 0;
+    }
+
+    // Publishes the number of watchpoints to the fast path check in Advance.
+    void UpdateWatchpointCount() {
+        m_watchpointCount.store(m_watchpointSet.size(), std::memory_order_relaxed);
+    }
+
+    // Updates the page filter bit for the page containing the given address after watchpoints were removed from it.
+    void UpdateWatchpointPage(uint32 address) {
+        if (m_watchpointPages.IsAllocated()) {
+            const uint32 pageStart = PageFilter::PageStart(address);
+            auto it = m_watchpointSet.lower_bound(pageStart);
+            m_watchpointPages.Set(address,
+                                  it != m_watchpointSet.end() && it->first <= pageStart + PageFilter::kPageMask);
+        }
     }
 
 public:
@@ -263,6 +316,10 @@ public:
         }
         if (flags != debug::WatchpointFlags::None) {
             m_watchpointSet[address] |= flags;
+            if (m_watchpointPages.IsAllocated()) {
+                m_watchpointPages.Set(address, true);
+            }
+            UpdateWatchpointCount();
         }
     }
 
@@ -278,6 +335,8 @@ public:
         wtpt &= ~flags;
         if (wtpt == debug::WatchpointFlags::None) {
             m_watchpointSet.erase(address);
+            UpdateWatchpointPage(address);
+            UpdateWatchpointCount();
         }
     }
 
@@ -287,6 +346,8 @@ public:
             WatchpointFlagsRef(address) = debug::WatchpointFlags::None;
         }
         m_watchpointSet.erase(address);
+        UpdateWatchpointPage(address);
+        UpdateWatchpointCount();
     }
 
     // Clears all watchpoints.
@@ -295,8 +356,10 @@ public:
             for (auto [address, _] : m_watchpointSet) {
                 WatchpointFlagsRef(address) = debug::WatchpointFlags::None;
             }
+            m_watchpointPages.Clear();
         }
         m_watchpointSet.clear();
+        UpdateWatchpointCount();
     }
 
     // Retrieves configured watchpoints for the specified address.
@@ -720,7 +783,9 @@ private:
     // -------------------------------------------------------------------------
     // Memory accessors
 
-    sys::SH2Bus &m_bus;
+    // Held by pointer so that UseBus can redirect accesses. Loads through it compile to the same code as through a
+    // reference member.
+    sys::SH2Bus *m_bus;
 
     // According to the SH7604/SH7095 manuals, the address space is divided into these areas:
     //
@@ -859,6 +924,17 @@ private:
     template <bool debug, bool emulateCache>
     bool StepDMAC(uint32 channel);
 
+    // Handles the end of a transfer after a DMA step. Returns true if the channel has more data to transfer.
+    template <bool debug>
+    bool FinishDMAStep(uint32 channel);
+
+    // Determines if DMA reads from the address bypass the cache and can be performed in bulk.
+    template <bool emulateCache>
+    bool IsDMABulkReadSource(uint32 address) const;
+
+    // Determines if the address is in the CD block region, the only one that asserts the bus wait signal.
+    static bool IsCDBlockAddress(uint32 address);
+
     template <bool debug, bool emulateCache>
     void AdvanceDMA(uint64 cycles);
 
@@ -895,8 +971,6 @@ private:
     template <bool write>
     void AdvanceFRT();
 
-    void TriggerFRTInputCapture();
-
     // -------------------------------------------------------------------------
     // Interrupts
 
@@ -1012,7 +1086,7 @@ private:
 
         using Chunk = std::array<uint8, kChunkSize>;
 
-        // Retrieves a pointer to the specified object in memory.
+        // Retrieves a pointer to the specified object in memory, allocating its chunk if needed.
         // The address is force-aligned to sizeof(T).
         template <typename T>
         T *GetPointer(size_t address) {
@@ -1024,9 +1098,17 @@ private:
             return reinterpret_cast<T *>(&(*m_chunks[chunkIndex])[address & kChunkMask]);
         }
 
+        // Retrieves a pointer to the specified object in memory, or nullptr if its chunk was never allocated (in which
+        // case the object is zero). Never allocates.
+        // The address is force-aligned to sizeof(T).
         template <typename T>
         const T *GetPointer(size_t address) const {
-            return const_cast<ChunkedMemory *>(this)->GetPointer<T>(address);
+            static_assert(bit::is_power_of_two(sizeof(T)));
+            const size_t chunkIndex = address >> chunkSizeBits;
+            if (!m_chunks[chunkIndex]) {
+                return nullptr;
+            }
+            return reinterpret_cast<const T *>(&(*m_chunks[chunkIndex])[address & kChunkMask]);
         }
 
         void Allocate() {
@@ -1061,6 +1143,58 @@ private:
     // For watchpoints, we reserve one byte per address in the address space.
     ChunkedMemory<32, 19> m_watchpoints;
 
+    // Page-level filter over the address space with one bit per 4 KiB page, set if the page contains at least one
+    // breakpoint or watchpoint. Checked before the maps above so that execution in pages without breakpoints and
+    // accesses to pages without watchpoints are rejected with a single bit test.
+    struct PageFilter {
+        static constexpr uint32 kPageBits = 12;
+        static constexpr uint32 kPageMask = (1u << kPageBits) - 1u;
+        static constexpr size_t kNumPages = kAddressSpaceSize >> kPageBits;
+
+        static constexpr uint32 PageStart(uint32 address) {
+            return address & ~kPageMask;
+        }
+
+        // Must only be invoked if the filter is allocated.
+        FORCE_INLINE bool Test(uint32 address) const {
+            const uint32 page = address >> kPageBits;
+            return (m_bits[page >> 6u] >> (page & 63u)) & 1u;
+        }
+
+        void Set(uint32 address, bool value) {
+            const uint32 page = address >> kPageBits;
+            const uint64 bit = 1ull << (page & 63u);
+            if (value) {
+                m_bits[page >> 6u] |= bit;
+            } else {
+                m_bits[page >> 6u] &= ~bit;
+            }
+        }
+
+        void Clear() {
+            std::fill(m_bits.begin(), m_bits.end(), 0);
+        }
+
+        void Allocate() {
+            m_bits.assign(kNumPages / 64, 0);
+        }
+
+        void Free() {
+            m_bits.clear();
+            m_bits.shrink_to_fit();
+        }
+
+        bool IsAllocated() const {
+            return !m_bits.empty();
+        }
+
+    private:
+        std::vector<uint64> m_bits;
+    };
+
+    PageFilter m_breakpointPages;
+    PageFilter m_watchpointPages;
+
     // TODO: util::VirtualMemory may fail to allocate large chunks of memory if there's not enough free RAM on the
     // system. Figure out a way to use it again but allocate memory dynamically.
 
@@ -1068,6 +1202,10 @@ private:
     std::set<uint32> m_breakpointSet;
     std::map<uint32, debug::WatchpointFlags> m_watchpointSet;
 
+    // Number of entries in m_watchpointSet. Checked before every instruction in debug mode, so it must be readable even
+    // if a frontend modifies the set without synchronizing with the emulator thread.
+    std::atomic<uint32> m_watchpointCount = 0;
+
     bool m_debugSuspend = false; // Disables CPU while in debug mode
 
     bool CheckBreakpoint();
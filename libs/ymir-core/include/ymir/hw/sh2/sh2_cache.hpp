@@ -11,8 +11,15 @@
 #include <ymir/util/inline.hpp>
 
 #include <array>
+#include <bit>
 #include <cassert>
 
+#if defined(_M_X64) || defined(__x86_64__)
+    #include <immintrin.h>
+#elif defined(_M_ARM64) || defined(__aarch64__)
+    #include <arm_neon.h>
+#endif
+
 namespace ymir::sh2 {
 
 // -----------------------------------------------------------------------------
@@ -106,9 +113,24 @@ struct CacheEntry {
     alignas(16) std::array<Tag, kCacheWays> tag;
     alignas(16) std::array<std::array<uint8, kCacheLineSize>, kCacheWays> line;
 
+    // Returns the way containing the address, or 4 on a miss.
+    // If multiple ways match (only possible by writing to the address array), the lowest one wins.
     FORCE_INLINE uint8 FindWay(uint32 address) const {
         const uint32 tagAddress = (bit::extract<10, 28>(address) << 10) | (1 << 2);
 
+#if defined(_M_X64) || defined(__x86_64__)
+        // Compare all four tags at once and extract one bit per matching way
+        const __m128i tags = _mm_load_si128(reinterpret_cast<const __m128i *>(tag.data()));
+        const __m128i match = _mm_cmpeq_epi32(tags, _mm_set1_epi32(static_cast<int>(tagAddress)));
+        const uint32 mask = static_cast<uint32>(_mm_movemask_ps(_mm_castsi128_ps(match)));
+        return std::countr_zero(mask | 0b10000u);
+#elif defined(_M_ARM64) || defined(__aarch64__)
+        // Compare all four tags at once and narrow the result into 16 bits per way
+        const uint32x4_t tags = vld1q_u32(&tag[0].u32);
+        const uint32x4_t match = vceqq_u32(tags, vdupq_n_u32(tagAddress));
+        const uint64 mask = vget_lane_u64(vreinterpret_u64_u16(vmovn_u32(match)), 0);
+        return std::countr_zero(mask) >> 4u;
+#else
         if (tag[0].u32 == tagAddress) {
             return 0;
         }
@@ -122,6 +144,7 @@ struct CacheEntry {
             return 3;
         }
         return 4;
+#endif
     }
 };
 
@@ -152,6 +175,21 @@ class Cache {
         return arr;
     }();
 
+    // Precomputed LRU values after accessing each way, indexed by [way][current LRU].
+    // Folds the AND/OR update into a single table lookup.
+    alignas(16) static constexpr auto kCacheLRUNext = [] {
+        std::array<std::array<uint8, 64>, kCacheWays> arr{};
+        for (uint8 way = 0; way < kCacheWays; way++) {
+            for (uint8 lru = 0; lru < 64; lru++) {
+                arr[way][lru] = (lru & kCacheLRUUpdateBits[way].andMask) | kCacheLRUUpdateBits[way].orMask;
+            }
+        }
+        return arr;
+    }();
+
+    // Fetch line address value that never matches an instruction fetch address
+    static constexpr uint32 kNoFetchLine = 0xFFFFFFFFu;
+
 public:
     Cache() {
         Reset();
@@ -164,6 +202,7 @@ public:
         m_replaceANDMask = 0x3Fu;
         m_replaceORMask[false] = 0u;
         m_replaceORMask[true] = 0u;
+        InvalidateFetchLine();
     }
 
     FORCE_INLINE CacheEntry &GetEntry(uint32 address) {
@@ -188,6 +227,7 @@ public:
         const uint8 lru = m_lru[index];
         const uint8 way = GetWayFromLRU<instrFetch>(lru);
         if (IsValidCacheWay(way)) {
+            InvalidateFetchLine();
             const uint32 tagAddress = bit::extract<10, 28>(address);
             m_entries[index].tag[way].tagAddress = tagAddress;
             m_entries[index].tag[way].valid = 1;
@@ -207,11 +247,48 @@ public:
 
     FORCE_INLINE void UpdateLRU(uint32 address, uint8 way) {
         const uint32 index = bit::extract<4, 9>(address);
-        m_lru[index] &= kCacheLRUUpdateBits[way].andMask;
-        m_lru[index] |= kCacheLRUUpdateBits[way].orMask;
+        m_lru[index] = kCacheLRUNext[way][m_lru[index] & 0x3F];
+    }
+
+    // -------------------------------------------------------------------------
+    // Instruction fetch line
+    //
+    // Remembers the cache line that served the most recent instruction fetch so that sequential fetches within the
+    // same 16-byte line can skip the tag lookup. Any operation that may change tags or the replacement state of the
+    // remembered line invalidates it.
+
+    /// @brief Retrieves the contents of the fetch line if it contains the given address.
+    /// @param[in] address the instruction fetch address
+    /// @return a pointer to the line contents, or `nullptr` if the address is not in the fetch line
+    FORCE_INLINE const uint8 *GetFetchLine(uint32 address) const {
+        if ((address & ~0xF) != m_fetchLineAddress) [[unlikely]] {
+            return nullptr;
+        }
+        return m_entries[m_fetchLineIndex].line[m_fetchLineWay].data();
+    }
+
+    /// @brief Remembers the line that served an instruction fetch.
+    /// @param[in] address the instruction fetch address
+    /// @param[in] way the way containing the address
+    FORCE_INLINE void SetFetchLine(uint32 address, uint8 way) {
+        m_fetchLineAddress = address & ~0xF;
+        m_fetchLineIndex = bit::extract<4, 9>(address);
+        m_fetchLineWay = way;
+    }
+
+    /// @brief Updates the LRU bits of the fetch line as if it had been looked up.
+    FORCE_INLINE void UpdateFetchLineLRU() {
+        m_lru[m_fetchLineIndex] = kCacheLRUNext[m_fetchLineWay][m_lru[m_fetchLineIndex] & 0x3F];
     }
 
+    FORCE_INLINE void InvalidateFetchLine() {
+        m_fetchLineAddress = kNoFetchLine;
+    }
+
+    // -------------------------------------------------------------------------
+
     FORCE_INLINE void AssociativePurge(uint32 address) {
+        InvalidateFetchLine();
         const uint32 index = bit::extract<4, 9>(address);
         const uint32 tagAddress = bit::extract<10, 28>(address);
         for (auto &tag : m_entries[index].tag) {
@@ -229,6 +306,7 @@ public:
 
     template <mem_primitive T, bool poke>
     FORCE_INLINE void WriteAddressArray(uint32 address, T value) {
+        InvalidateFetchLine();
         const uint32 index = bit::extract<4, 9>(address);
         if constexpr (poke) {
             uint32 currValue;
@@ -277,6 +355,7 @@ public:
     }
 
     FORCE_INLINE void Purge() {
+        InvalidateFetchLine();
         for (uint32 index = 0; index < 64; index++) {
             for (auto &tag : m_entries[index].tag) {
                 tag.valid = 0;
@@ -297,6 +376,7 @@ public:
     template <bool poke>
     FORCE_INLINE void WriteCCR(uint8 value) {
         CCR.Write(value);
+        InvalidateFetchLine();
         m_replaceANDMask = CCR.TW ? 0x1u : 0x3Fu;
         m_replaceORMask[false] = CCR.OD ? -1 : 0;
         m_replaceORMask[true] = CCR.ID ? -1 : 0;
@@ -331,6 +411,7 @@ public:
             m_entries[i].line = state.entries[i].lines;
         }
         m_lru = state.lru;
+        InvalidateFetchLine();
     }
 
     // -------------------------------------------------------------------------
@@ -338,6 +419,8 @@ public:
 
     FORCE_INLINE CacheEntry &GetEntryByIndex(uint8 index) {
         assert(index < kCacheEntries);
+        // The caller may modify the tags
+        InvalidateFetchLine();
         return m_entries[index];
     }
 
@@ -351,6 +434,11 @@ private:
     alignas(16) std::array<uint8, kCacheEntries> m_lru;
     uint8 m_replaceANDMask;
     std::array<sint8, 2> m_replaceORMask; // [0]=data, [1]=code
+
+    // Instruction fetch line
+    uint32 m_fetchLineAddress; // 16-byte aligned address of the line, or kNoFetchLine if invalid
+    uint8 m_fetchLineIndex;
+    uint8 m_fetchLineWay;
 };
 
 } // namespace ymir::sh2
@@ -0,0 +1,80 @@
+#pragma once
+
+/**
+@file
+@brief Lock-free mailbox for the latest peripheral report sampled by the host.
+*/
+
+#include "peripheral_report.hpp"
+
+#include <ymir/core/types.hpp>
+
+#include <array>
+#include <atomic>
+
+namespace ymir::peripheral {
+
+/// @brief Hands the freshest host input sample over to the emulator at the moment the SMPC reads the peripherals.
+///
+/// The frontend's input thread publishes a complete `PeripheralReport` every time the host inputs change, stamped
+/// with the host time they were sampled. The peripheral report callback, invoked by the emulator thread when INTBACK
+/// reads the ports, latches the most recent report without blocking either thread.
+///
+/// Implemented as a triple buffer: the producer and consumer each own one slot and swap it with the shared slot, so
+/// neither side ever observes a partially written report. Only one producer thread and one consumer thread may use a
+/// latch at any given time.
+class PeripheralLatch {
+public:
+    /// @brief Publishes a new report, replacing any report not yet latched by the consumer.
+    /// @param[in] report the peripheral report
+    /// @param[in] timestamp the host time at which the inputs were sampled, in nanoseconds
+    void Publish(const PeripheralReport &report, uint64 timestamp) {
+        Slot &slot = m_slots[m_writeIndex];
+        slot.report = report;
+        slot.timestamp = timestamp;
+        const uint8 prev = m_shared.exchange(m_writeIndex | kFresh, std::memory_order_acq_rel);
+        m_writeIndex = prev & kIndexMask;
+    }
+
+    /// @brief Latches the most recently published report.
+    /// @param[out] report receives the latest peripheral report
+    /// @param[out] timestamp receives the host time at which the report was sampled, in nanoseconds
+    /// @return `true` if a report was ever published, `false` otherwise; the outputs are not modified in this case
+    bool Latch(PeripheralReport &report, uint64 &timestamp) {
+        if (m_shared.load(std::memory_order_relaxed) & kFresh) {
+            const uint8 prev = m_shared.exchange(m_readIndex, std::memory_order_acq_rel);
+            m_readIndex = prev & kIndexMask;
+            m_hasReport = true;
+        }
+        if (!m_hasReport) {
+            return false;
+        }
+        const Slot &slot = m_slots[m_readIndex];
+        report = slot.report;
+        timestamp = slot.timestamp;
+        return true;
+    }
+
+private:
+    static constexpr uint8 kIndexMask = 0x3;
+    static constexpr uint8 kFresh = 0x4;
+
+    struct Slot {
+        PeripheralReport report{};
+        uint64 timestamp = 0;
+    };
+
+    std::array<Slot, 3> m_slots{};
+
+    // Index of the slot shared between producer and consumer, plus a flag indicating it holds an unread report
+    alignas(64) std::atomic<uint8> m_shared{1};
+
+    // Producer state
+    alignas(64) uint8 m_writeIndex = 0;
+
+    // Consumer state
+    alignas(64) uint8 m_readIndex = 2;
+    bool m_hasReport = false;
+};
+
+} // namespace ymir::peripheral
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <ymir/core/types.hpp>
+#include <ymir/util/data_ops.hpp>
+#include <ymir/util/inline.hpp>
+
+#include <ymir/hw/hw_defs.hpp>
+
+#include <array>
+
+namespace ymir::vdp {
+
+// Memory region targeted by a VDP2 write span.
+enum class VDP2WriteSpanTarget : uint8 { VRAM, CRAM };
+
+// A run of bytes written to consecutive addresses of VDP2 VRAM or CRAM.
+struct VDP2WriteSpan {
+    // Maximum number of bytes in a span. Sized so that a span fits in a 64-byte renderer event.
+    static constexpr uint32 kCapacity = 52;
+
+    uint32 address;                    // Address of the first byte
+    uint32 length;                     // Number of bytes written
+    std::array<uint8, kCapacity> data; // Written bytes in memory order
+};
+
+// Coalesces VDP2 VRAM and CRAM writes into spans.
+//
+// A write that continues the open span of its lane is appended to it; any other write closes the span and opens a new
+// one. Closed spans are handed to a sink with the signature `void(VDP2WriteSpanTarget, const VDP2WriteSpan &)`.
+//
+// VRAM uses a single lane. CRAM uses one lane per 2 KiB half: CRAM mode 0 mirrors every write into the other half and
+// modes 1 and 2 interleave consecutive words between both halves, so a single lane would break on every write.
+//
+// Lanes cover disjoint memory, so spans from different lanes may reach the sink out of order. Call Flush() before
+// anything that depends on the written contents.
+class VDP2WriteSpanCoalescer {
+public:
+    template <mem_primitive_16 T, typename FnSink>
+    FORCE_INLINE void WriteVRAM(uint32 address, T value, FnSink &&sink) {
+        Write<T>(m_spans[0], VDP2WriteSpanTarget::VRAM, address, value, sink);
+    }
+
+    template <mem_primitive_16 T, typename FnSink>
+    FORCE_INLINE void WriteCRAM(uint32 address, T value, FnSink &&sink) {
+        Write<T>(m_spans[1 + ((address >> 11u) & 1u)], VDP2WriteSpanTarget::CRAM, address, value, sink);
+    }
+
+    // Closes all open spans.
+    template <typename FnSink>
+    FORCE_INLINE void Flush(FnSink &&sink) {
+        for (uint32 i = 0; i < m_spans.size(); ++i) {
+            if (m_spans[i].length != 0) {
+                sink(i == 0 ? VDP2WriteSpanTarget::VRAM : VDP2WriteSpanTarget::CRAM,
+                     static_cast<const VDP2WriteSpan &>(m_spans[i]));
+                m_spans[i].length = 0;
+            }
+        }
+    }
+
+    // Discards all open spans. Used when the consumer's copy of memory is about to be replaced wholesale.
+    void Reset() {
+        for (auto &span : m_spans) {
+            span.length = 0;
+        }
+    }
+
+private:
+    // [0] = VRAM, [1] = CRAM 000-7FF, [2] = CRAM 800-FFF
+    std::array<VDP2WriteSpan, 3> m_spans{};
+
+    template <mem_primitive_16 T, typename FnSink>
+    FORCE_INLINE static void Write(VDP2WriteSpan &span, VDP2WriteSpanTarget target, uint32 address, T value,
+                                   FnSink &sink) {
+        if (span.length != 0 &&
+            (address != span.address + span.length || span.length + sizeof(T) > VDP2WriteSpan::kCapacity)) {
+            sink(target, static_cast<const VDP2WriteSpan &>(span));
+            span.length = 0;
+        }
+        if (span.length == 0) {
+            span.address = address;
+        }
+        util::WriteBE<T>(&span.data[span.length], value);
+        span.length += sizeof(T);
+    }
+};
+
+} // namespace ymir::vdp
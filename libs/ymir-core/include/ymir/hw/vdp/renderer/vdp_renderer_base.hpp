@@ -13,6 +13,8 @@
 
 #include <ymir/savestate/savestate_vdp.hpp>
 
+#include <ymir/debug/host_timing.hpp>
+
 #include <ymir/core/types.hpp>
 
 #include <ymir/util/inline.hpp>
@@ -73,6 +75,37 @@ protected:
     virtual void UpdateEnhancements() {}
 
 public:
+    /// @brief Determines whether the renderer should skip drawing the next VDP2 frame.
+    /// Takes effect on the next call to `VDP2BeginFrame`.
+    ///
+    /// Renderers must still process all state changes and memory writes as usual while skipping frames, and must
+    /// leave the VDP1 framebuffers and all emulation-visible state exactly as they would be if the frame were rendered.
+    /// @param[in] skip `true` to skip rendering the next frame, `false` to render it
+    void SetSkipNextFrame(bool skip) {
+        m_skipNextFrame = skip;
+    }
+
+    /// @brief Determines if the renderer will skip drawing the next VDP2 frame.
+    /// @return `true` if the next frame will be skipped
+    bool IsSkipNextFrame() const {
+        return m_skipNextFrame;
+    }
+
+    /// @brief Attaches host timing statistics to the renderer.
+    ///
+    /// When host timing instrumentation is compiled in, renderers charge VDP1 command processing and VDP2 line
+    /// rendering to the respective components, on whichever thread performs the work.
+    /// @param[in] stats the statistics to update, or `nullptr` to detach
+    void UseHostTimingStats(debug::HostTimingStats *stats) {
+        m_hostTiming = stats;
+    }
+
+    /// @brief Retrieves the attached host timing statistics.
+    /// @return a pointer to the attached statistics, or `nullptr` if none are attached
+    debug::HostTimingStats *GetHostTimingStats() const {
+        return m_hostTiming;
+    }
+
     /// @brief Renderer callback functions. Automatically configured by the VDP when a new renderer is created.
     config::RendererCallbacks Callbacks;
 
@@ -277,6 +310,12 @@ protected:
     /// Updated automatically whenever the enhancements are changed.
     bool m_hasEnhancements = false;
 
+    /// @brief Whether to skip rendering the next VDP2 frame. Implementations should latch this on `VDP2BeginFrame`.
+    bool m_skipNextFrame = false;
+
+    /// @brief Host timing statistics to update, if any.
+    debug::HostTimingStats *m_hostTiming = nullptr;
+
 private:
     const VDPRendererType m_type;
 };
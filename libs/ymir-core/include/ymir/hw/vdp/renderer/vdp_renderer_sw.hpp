@@ -14,6 +14,7 @@
 #include <ymir/hw/vdp/vdp_state.hpp>
 
 #include <ymir/hw/vdp/renderer/common/vdp1_steppers.hpp>
+#include <ymir/hw/vdp/renderer/common/vdp2_write_spans.hpp>
 
 #include <ymir/hw/hw_defs.hpp>
 
@@ -387,10 +388,8 @@ private:
             VDP2DrawLine,
             VDP2EndFrame,
 
-            VDP2VRAMWriteByte,
-            VDP2VRAMWriteWord,
-            VDP2CRAMWriteByte,
-            VDP2CRAMWriteWord,
+            VDP2VRAMWriteSpan,
+            VDP2CRAMWriteSpan,
             VDP2RegWrite,
 
             PreSaveStateSync,
@@ -409,6 +408,10 @@ private:
                 bool odd;
             } oddField;
 
+            struct {
+                bool skip;
+            } beginFrame;
+
             /*struct {
                 uint64 steps;
             } vdp1ProcessCommands;*/
@@ -417,6 +420,8 @@ private:
                 uint32 address;
                 uint32 value;
             } write;
+
+            VDP2WriteSpan writeSpan;
         };
 
         static VDP2RenderEvent Reset() {
@@ -439,8 +444,8 @@ private:
             return {Type::VDP1SwapFramebuffer};
         }
 
-        static VDP2RenderEvent VDP2BeginFrame() {
-            return {Type::VDP2BeginFrame};
+        static VDP2RenderEvent VDP2BeginFrame(bool skip) {
+            return {Type::VDP2BeginFrame, {.beginFrame = {.skip = skip}}};
         }
 
         static VDP2RenderEvent VDP2UpdateEnabledBGs() {
@@ -455,40 +460,9 @@ private:
             return {Type::VDP2EndFrame};
         }
 
-        template <mem_primitive_16 T>
-        static VDP2RenderEvent VDP2VRAMWrite(uint32 address, T value) {
-            if constexpr (std::is_same_v<T, uint8>) {
-                return VDP2VRAMWriteByte(address, value);
-            } else if constexpr (std::is_same_v<T, uint16>) {
-                return VDP2VRAMWriteWord(address, value);
-            }
-            util::unreachable();
-        }
-
-        static VDP2RenderEvent VDP2VRAMWriteByte(uint32 address, uint8 value) {
-            return {Type::VDP2VRAMWriteByte, {.write = {.address = address, .value = value}}};
-        }
-
-        static VDP2RenderEvent VDP2VRAMWriteWord(uint32 address, uint16 value) {
-            return {Type::VDP2VRAMWriteWord, {.write = {.address = address, .value = value}}};
-        }
-
-        template <mem_primitive_16 T>
-        static VDP2RenderEvent VDP2CRAMWrite(uint32 address, T value) {
-            if constexpr (std::is_same_v<T, uint8>) {
-                return VDP2CRAMWriteByte(address, value);
-            } else if constexpr (std::is_same_v<T, uint16>) {
-                return VDP2CRAMWriteWord(address, value);
-            }
-            util::unreachable();
-        }
-
-        static VDP2RenderEvent VDP2CRAMWriteByte(uint32 address, uint8 value) {
-            return {Type::VDP2CRAMWriteByte, {.write = {.address = address, .value = value}}};
-        }
-
-        static VDP2RenderEvent VDP2CRAMWriteWord(uint32 address, uint16 value) {
-            return {Type::VDP2CRAMWriteWord, {.write = {.address = address, .value = value}}};
+        static VDP2RenderEvent WriteSpan(VDP2WriteSpanTarget target, const VDP2WriteSpan &span) {
+            const Type type = target == VDP2WriteSpanTarget::VRAM ? Type::VDP2VRAMWriteSpan : Type::VDP2CRAMWriteSpan;
+            return {type, {.writeSpan = span}};
         }
 
         static VDP2RenderEvent VDP2RegWrite(uint32 address, uint16 value) {
@@ -507,6 +481,7 @@ private:
             return {Type::Shutdown};
         }
     };
+    static_assert(sizeof(VDP2RenderEvent) <= 64);
 
     mutable struct VDP2RenderContext {
         moodycamel::BlockingConcurrentQueue<VDP2RenderEvent, ConcQueueTraits> eventQueue;
@@ -523,9 +498,15 @@ private:
         uint32 deinterlaceY;
         std::atomic_bool deinterlaceShutdown;
 
+        // Whether the frame currently being processed by the render thread is skipped.
+        bool skipFrame = false;
+
         std::array<VDP2RenderEvent, 64> pendingEvents;
         size_t pendingEventsCount = 0;
 
+        // VRAM and CRAM writes are coalesced into spans, which are sent along with the other pending events.
+        VDP2WriteSpanCoalescer writeSpans;
+
         struct VDP2 {
             VDP2Regs regs;
             VDP2Memory mem{regs};
@@ -544,31 +525,55 @@ private:
             displayFB = 0;
         }
 
+        FORCE_INLINE void AddPendingEvent(const VDP2RenderEvent &event) {
+            pendingEvents[pendingEventsCount++] = event;
+            if (pendingEventsCount == pendingEvents.size()) {
+                eventQueue.enqueue_bulk(pTok, pendingEvents.begin(), pendingEventsCount);
+                pendingEventsCount = 0;
+            }
+        }
+
+        FORCE_INLINE auto SpanSink() {
+            return [this](VDP2WriteSpanTarget target, const VDP2WriteSpan &span) {
+                AddPendingEvent(VDP2RenderEvent::WriteSpan(target, span));
+            };
+        }
+
         void EnqueueEvent(VDP2RenderEvent &&event) {
             switch (event.type) {
-            case VDP2RenderEvent::Type::VDP2VRAMWriteByte:
-            case VDP2RenderEvent::Type::VDP2VRAMWriteWord:
-            case VDP2RenderEvent::Type::VDP2CRAMWriteByte:
-            case VDP2RenderEvent::Type::VDP2CRAMWriteWord:
             case VDP2RenderEvent::Type::VDP2RegWrite:
-                // Batch these writes to send in bulk
-                pendingEvents[pendingEventsCount++] = event;
-                if (pendingEventsCount == pendingEvents.size()) {
-                    eventQueue.enqueue_bulk(pTok, pendingEvents.begin(), pendingEventsCount);
-                    pendingEventsCount = 0;
-                }
+                // Batch these writes to send in bulk.
+                // Register writes may change how memory contents are interpreted (e.g. CRAM mode), so memory writes
+                // issued before them must be sent first.
+                writeSpans.Flush(SpanSink());
+                AddPendingEvent(event);
                 break;
             default:
                 // Send any pending writes before rendering
-                if (pendingEventsCount > 0) {
-                    eventQueue.enqueue_bulk(pTok, pendingEvents.begin(), pendingEventsCount);
-                    pendingEventsCount = 0;
-                }
+                FlushPendingEvents();
                 eventQueue.enqueue(pTok, event);
                 break;
             }
         }
 
+        template <mem_primitive_16 T>
+        FORCE_INLINE void EnqueueVRAMWrite(uint32 address, T value) {
+            writeSpans.WriteVRAM(address, value, SpanSink());
+        }
+
+        template <mem_primitive_16 T>
+        FORCE_INLINE void EnqueueCRAMWrite(uint32 address, T value) {
+            writeSpans.WriteCRAM(address, value, SpanSink());
+        }
+
+        FORCE_INLINE void FlushPendingEvents() {
+            writeSpans.Flush(SpanSink());
+            if (pendingEventsCount > 0) {
+                eventQueue.enqueue_bulk(pTok, pendingEvents.begin(), pendingEventsCount);
+                pendingEventsCount = 0;
+            }
+        }
+
         template <typename It>
         size_t DequeueEvents(It first, size_t count) {
             return eventQueue.wait_dequeue_bulk(cTok, first, count);
@@ -605,6 +610,9 @@ private:
     // Runs the deinterlacer in a dedicated thread.
     bool m_threadedDeinterlacer = false;
 
+    // Whether the current frame is being skipped. Latched from m_skipNextFrame on VDP2BeginFrame.
+    bool m_skipFrame = false;
+
     using FnVDP1ProcessCommand = void (SoftwareVDPRenderer::*)();
     using FnVDP1HandleCommand = void (SoftwareVDPRenderer::*)(uint32 cmdAddress, VDP1Command::Control control);
     using FnVDP2DrawLine = void (SoftwareVDPRenderer::*)(uint32 y, bool altField);
@@ -30,6 +30,7 @@
 #include <blockingconcurrentqueue.h>
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <span>
 #include <utility>
@@ -178,6 +179,33 @@ public:
         m_renderer->ConfigureEnhancements(m_enhancements);
     }
 
+    /// @brief Retrieves the frame rendering skip policy.
+    /// @return the current frame skip configuration
+    const config::FrameSkip &GetFrameSkip() const {
+        return m_frameSkip;
+    }
+
+    /// @brief Applies a frame rendering skip policy. Takes effect on the next frame.
+    /// @param[in] frameSkip the frame skip configuration to apply
+    void SetFrameSkip(const config::FrameSkip &frameSkip) {
+        m_frameSkip = frameSkip;
+        m_frameSkipCounter = 0;
+    }
+
+    /// @brief Requests the next frame to be rendered when using the `config::FrameSkip::Mode::OnRequest` frame skip
+    /// mode. Has no effect in other modes.
+    ///
+    /// This method is thread-safe.
+    void RequestFrameRender() {
+        m_frameRenderRequested.store(true, std::memory_order_relaxed);
+    }
+
+    /// @brief Attaches host timing statistics to the current and future renderers.
+    /// @param[in] stats the statistics to update, or `nullptr` to detach
+    void UseHostTimingStats(debug::HostTimingStats *stats) {
+        m_renderer->UseHostTimingStats(stats);
+    }
+
     // Enable or disable VDP1 drawing stall on VRAM writes.
     void SetStallVDP1OnVRAMWrites(bool enable) {
         m_stallVDP1OnVRAMWrites = enable;
@@ -295,6 +323,8 @@ private:
             renderer->SwCallbacks = m_swRendererCallbacks;
         }
         renderer->ConfigureEnhancements(m_enhancements);
+        renderer->SetSkipNextFrame(m_renderer->IsSkipNextFrame());
+        renderer->UseHostTimingStats(m_renderer->GetHostTimingStats());
         renderer->VDP2SetResolution(m_HRes, m_VRes, m_exclusiveMonitor);
         renderer->VDP2SetField(m_state.regs2.TVSTAT.ODD);
 
@@ -327,6 +357,14 @@ private:
     // Current enhancements configuration.
     config::Enhancements m_enhancements;
 
+    // Current frame skip configuration.
+    config::FrameSkip m_frameSkip;
+    uint32 m_frameSkipCounter = 0;
+    std::atomic_bool m_frameRenderRequested = false;
+
+    // Determines if the frame about to begin should be rendered based on the frame skip policy.
+    bool ShouldRenderFrame();
+
     /// @brief The current software renderer callbacks configuration.
     SoftwareRendererCallbacks m_swRendererCallbacks;
 
@@ -35,6 +35,25 @@ struct Enhancements {
     }
 };
 
+/// @brief Frame rendering skip policy.
+///
+/// Skipped frames are fully emulated -- VDP1 drawing, framebuffer erase/swap, sprite draw end interrupts and VDP2
+/// access pattern calculations happen as usual -- but the renderer does not compose VDP2 lines or deinterlace them,
+/// and does not deliver the frame to the frontend.
+struct FrameSkip {
+    enum class Mode {
+        Off,       ///< Render every frame
+        Interval,  ///< Render one out of every `interval` frames
+        OnRequest, ///< Render only the frames requested with `VDP::RequestFrameRender`
+    };
+
+    /// @brief The frame skip mode.
+    Mode mode = Mode::Off;
+
+    /// @brief Frame rendering interval used with `Mode::Interval`. Values 0 and 1 render every frame.
+    uint32 interval = 1;
+};
+
 /// @brief VDP2 debug rendering options.
 struct VDP2DebugRender {
     VDP2DebugRender() {
@@ -19,6 +19,13 @@ public:
     // available in the file. If the number of bytes read is less than the output size, only the first bytes of the
     // buffer are modified; the rest of the buffer is left untouched.
     virtual uintmax_t Read(uintmax_t offset, uintmax_t size, std::span<uint8> output) const = 0;
+
+    // Returns a direct view of size bytes starting at offset if the file contents are resident in memory (e.g. mapped
+    // or preloaded), avoiding the copy done by Read.
+    // Returns an empty span if the contents cannot be viewed directly or the range is not entirely within the file.
+    virtual std::span<const uint8> View(uintmax_t offset, uintmax_t size) const {
+        return {};
+    }
 };
 
 } // namespace ymir::media
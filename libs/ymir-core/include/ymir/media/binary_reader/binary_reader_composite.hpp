@@ -45,6 +45,19 @@ public:
         return it->second.reader->Read(localOffset, size, output);
     }
 
+    std::span<const uint8> View(uintmax_t offset, uintmax_t size) const final {
+        if (offset >= m_size || size == 0) {
+            return {};
+        }
+
+        // Views cannot span multiple readers
+        auto it = m_readers.lower_bound(offset);
+        if (it == m_readers.end() || size - 1 > it->first - offset) {
+            return {};
+        }
+        return it->second.reader->View(offset - it->second.base, size);
+    }
+
 private:
     struct Reader {
         uintmax_t base;
@@ -6,5 +6,6 @@
 #include "binary_reader_file.hpp"
 #include "binary_reader_mem.hpp"
 #include "binary_reader_mmap.hpp"
+#include "binary_reader_shared.hpp"
 #include "binary_reader_subview.hpp"
 #include "binary_reader_zero.hpp"
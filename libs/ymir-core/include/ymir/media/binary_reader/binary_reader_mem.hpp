@@ -76,6 +76,13 @@ public:
         return size;
     }
 
+    std::span<const uint8> View(uintmax_t offset, uintmax_t size) const final {
+        if (offset > m_data.size() || size > m_data.size() - offset) {
+            return {};
+        }
+        return {m_data.data() + offset, size};
+    }
+
 private:
     std::vector<uint8> m_data;
 };
@@ -49,6 +49,16 @@ public:
         return size;
     }
 
+    std::span<const uint8> View(uintmax_t offset, uintmax_t size) const final {
+        if (!m_in.is_mapped()) {
+            return {};
+        }
+        if (offset > m_in.size() || size > m_in.size() - offset) {
+            return {};
+        }
+        return {reinterpret_cast<const uint8 *>(m_in.data()) + offset, size};
+    }
+
 private:
     mio::mmap_source m_in;
 };
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "binary_reader.hpp"
+
+#include <ymir/util/shared_memory.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <span>
+
+namespace ymir::media {
+
+// Implementation of IBinaryReader backed by read-only shared memory.
+// Used to preload disc images when the loader is asked to share them: the contents are faulted into memory up front,
+// but they live in the operating system's file cache instead of a private buffer, so every instance and process that
+// loads the same image shares them.
+class SharedMemoryBinaryReader final : public IBinaryReader {
+public:
+    // Initializes a reader pointing to no data.
+    SharedMemoryBinaryReader() = default;
+
+    // Initializes a reader over the specified shared memory object.
+    explicit SharedMemoryBinaryReader(std::shared_ptr<const util::SharedMemory> memory)
+        : m_memory(std::move(memory)) {}
+
+    // Maps and preloads the entire contents of the specified file.
+    // If any errors occur while mapping the file, initializes an empty reader and returns the error in the provided
+    // std::error_code object.
+    SharedMemoryBinaryReader(std::filesystem::path path, std::error_code &error) {
+        m_memory = util::SharedMemory::MapFile(path, error);
+        if (m_memory != nullptr) {
+            m_memory->Prefault();
+        }
+    }
+
+    uintmax_t Size() const final {
+        return m_memory != nullptr ? m_memory->Size() : 0;
+    }
+
+    uintmax_t Read(uintmax_t offset, uintmax_t size, std::span<uint8> output) const final {
+        const std::span<const uint8> data = m_memory != nullptr ? m_memory->Data() : std::span<const uint8>{};
+        if (offset >= data.size()) {
+            return 0;
+        }
+        // Limit size to the smallest of the requested size, the output buffer size and the amount of bytes available in
+        // the file starting from offset
+        size = std::min(size, data.size() - offset);
+        size = std::min(size, output.size());
+        std::copy_n(data.begin() + offset, size, output.begin());
+        return size;
+    }
+
+    std::span<const uint8> View(uintmax_t offset, uintmax_t size) const final {
+        const std::span<const uint8> data = m_memory != nullptr ? m_memory->Data() : std::span<const uint8>{};
+        if (offset > data.size() || size > data.size() - offset) {
+            return {};
+        }
+        return data.subspan(offset, size);
+    }
+
+private:
+    std::shared_ptr<const util::SharedMemory> m_memory;
+};
+
+} // namespace ymir::media
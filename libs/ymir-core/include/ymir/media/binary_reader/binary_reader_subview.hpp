@@ -13,7 +13,8 @@ public:
     SharedSubviewBinaryReader(std::shared_ptr<IBinaryReader> binaryReader)
         : m_fileContent(binaryReader)
         , m_offset(0)
-        , m_size(binaryReader->Size()) {}
+        , m_fileSize(binaryReader->Size())
+        , m_size(m_fileSize) {}
 
     // Initializes a subview of the specified IBinaryReader that views the given portion of the file.
     // If the offset is out of range, the resulting view is empty.
@@ -63,13 +64,22 @@ public:
         return count;
     }
 
+    std::span<const uint8> View(uintmax_t offset, uintmax_t size) const final {
+        // Only ranges entirely within the file portion of the view can be forwarded; pregap and postgap zeros have no
+        // backing storage
+        if (offset < m_pregap || offset - m_pregap > m_fileSize || size > m_fileSize - (offset - m_pregap)) {
+            return {};
+        }
+        return m_fileContent->View(offset - m_pregap + m_offset, size);
+    }
+
 private:
     std::shared_ptr<IBinaryReader> m_fileContent;
     uintmax_t m_offset;
     uintmax_t m_fileSize;
     uintmax_t m_size;
-    uintmax_t m_pregap;
-    uintmax_t m_postgap;
+    uintmax_t m_pregap = 0;
+    uintmax_t m_postgap = 0;
 };
 
 } // namespace ymir::media
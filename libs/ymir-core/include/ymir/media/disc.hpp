@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <filesystem>
 #include <memory>
 #include <span>
 #include <vector>
@@ -289,6 +290,9 @@ struct Disc {
 
     SaturnHeader header;
 
+    // Every file opened by the loader to build this disc, starting with the file that was loaded
+    std::vector<std::filesystem::path> imageFiles;
+
     Disc() {
         Invalidate();
     }
@@ -302,11 +306,13 @@ struct Disc {
     void Swap(Disc &&disc) {
         sessions.swap(disc.sessions);
         header.Swap(std::move(disc.header));
+        imageFiles.swap(disc.imageFiles);
     }
 
     void Invalidate() {
         sessions.clear();
         header.Invalidate();
+        imageFiles.clear();
     }
 };
 
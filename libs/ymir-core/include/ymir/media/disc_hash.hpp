@@ -0,0 +1,111 @@
+#pragma once
+
+/**
+@file
+@brief Full disc image hashing and on-disk hash cache.
+*/
+
+#include "disc.hpp"
+
+#include <ymir/core/hash.hpp>
+#include <ymir/core/types.hpp>
+
+#include <ymir/util/size_ops.hpp>
+
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+namespace ymir::media {
+
+/// @brief Size of the chunks of track data hashed independently by `CalcDiscImageHash`.
+inline constexpr uint64 kDiscHashShardSize = 4_MiB;
+
+/// @brief Seed used for full disc image hashes.
+inline constexpr uint64 kDiscImageHashSeed = 0x59'4D'49'52'44'49'53'43ull; // "YMIRDISC"
+
+/// @brief Calculates the XXH128 hash of every sector of every track in the disc.
+///
+/// Each track is split into shards of `kDiscHashShardSize` bytes which are hashed in parallel. The shard hashes are
+/// then combined in disc order, so the result does not depend on the number of threads used.
+///
+/// Memory-mapped and preloaded images are hashed directly from memory. Other images are read through
+/// `IBinaryReader::Read` one shard at a time.
+///
+/// This is not the same hash as `Disc::header` or `fs::Filesystem::GetHash()`, which only cover the volume descriptors.
+///
+/// @param[in] disc the disc to hash
+/// @param[in] numThreads the maximum number of threads to use. 0 uses all available hardware threads.
+/// @return the hash of the disc image, or `std::nullopt` if any track could not be read entirely
+std::optional<XXH128Hash> CalcDiscImageHash(const Disc &disc, uint32 numThreads = 0);
+
+/// @brief Caches full disc image hashes on disk, keyed by image path, size and modification time.
+///
+/// Multi-file images (e.g. BIN/CUE) are keyed by the file that was loaded. The size and modification time of every
+/// other file opened by the loader (`Disc::imageFiles`) are stored along with the entry, so replacing any track file
+/// also invalidates the cached hash.
+class DiscHashCache {
+public:
+    /// @brief Loads cache entries from the specified file, replacing the current contents.
+    /// A missing file results in an empty cache and is not an error.
+    /// @param[in] path the path to the cache file
+    /// @param[out] error receives any errors that occur while reading the file
+    /// @return `true` if the cache was loaded or the file does not exist
+    bool Load(const std::filesystem::path &path, std::error_code &error);
+
+    /// @brief Writes all cache entries to the specified file.
+    /// The file is written to a temporary file first and then moved into place.
+    /// @param[in] path the path to the cache file
+    /// @param[out] error receives any errors that occur while writing the file
+    /// @return `true` if the cache was saved successfully
+    bool Save(const std::filesystem::path &path, std::error_code &error) const;
+
+    /// @brief Looks up the hash of an image file.
+    /// @param[in] imagePath the path to the image file
+    /// @return the cached hash if the image file and all files stored with the entry exist and their sizes and
+    /// modification times match the cached entry
+    std::optional<XXH128Hash> Find(const std::filesystem::path &imagePath) const;
+
+    /// @brief Stores the hash of an image file along with the current size and modification time of the image file and
+    /// all of its track files.
+    /// Does nothing if any of the files cannot be queried.
+    /// @param[in] imagePath the path to the image file
+    /// @param[in] hash the hash of the image
+    /// @param[in] imageFiles all files the image was loaded from (`Disc::imageFiles`). May include `imagePath`.
+    void Store(const std::filesystem::path &imagePath, const XXH128Hash &hash,
+               std::span<const std::filesystem::path> imageFiles = {});
+
+    /// @brief Returns the number of cached entries.
+    size_t Size() const {
+        return m_entries.size();
+    }
+
+    /// @brief Determines if the cache has been modified since it was last loaded or saved.
+    bool IsDirty() const {
+        return m_dirty;
+    }
+
+private:
+    struct FileStamp {
+        std::string path; // absolute path in UTF-8
+        uintmax_t size;
+        sint64 mtime;
+    };
+
+    struct Entry {
+        uintmax_t size;
+        sint64 mtime;
+        XXH128Hash hash;
+        std::vector<FileStamp> files; // track files other than the image file itself
+    };
+
+    // Keyed by the absolute image path in UTF-8
+    std::unordered_map<std::string, Entry> m_entries;
+    mutable bool m_dirty = false;
+};
+
+} // namespace ymir::media
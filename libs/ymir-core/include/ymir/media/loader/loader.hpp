@@ -18,6 +18,10 @@ namespace ymir::media {
 // If this function returns false, the Disc object is invalidated.
 // preloadToRAM specifies if the entire disc image should be preloaded into memory.
 // cbMsg is the callback for message reporting.
-bool LoadDisc(std::filesystem::path path, Disc &disc, bool preloadToRAM, CbLoaderMessage cbMsg);
+// sharedPreload makes preloading use shared read-only mappings of uncompressed image files instead of private copies,
+// so that instances and processes loading the same image share its memory. CHD images are always decompressed into
+// private memory. Has no effect unless preloadToRAM is set.
+bool LoadDisc(std::filesystem::path path, Disc &disc, bool preloadToRAM, CbLoaderMessage cbMsg,
+              bool sharedPreload = false);
 
 } // namespace ymir::media
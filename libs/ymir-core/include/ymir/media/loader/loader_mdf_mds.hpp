@@ -16,6 +16,9 @@ namespace ymir::media::loader::mdfmds {
 // If this function returns false, the Disc object is invalidated.
 // preloadToRAM specifies if the entire disc image should be preloaded into memory.
 // cbMsg is the callback for message reporting.
-bool Load(std::filesystem::path mdsPath, Disc &disc, bool preloadToRAM, CbLoaderMessage cbMsg);
+// sharedPreload makes preloading use shared read-only mappings of the image files instead of private copies, so that
+// instances and processes loading the same image share its memory. Has no effect unless preloadToRAM is set.
+bool Load(std::filesystem::path mdsPath, Disc &disc, bool preloadToRAM, CbLoaderMessage cbMsg,
+          bool sharedPreload = false);
 
 } // namespace ymir::media::loader::mdfmds
@@ -13,9 +13,34 @@
 #include "savestate_vdp.hpp"
 #include "savestate_ygr.hpp"
 
+#include <cstring>
+#include <type_traits>
+
 namespace ymir::savestate {
 
 struct SaveState {
+    /// @brief Zero-fills all fixed-layout members, including their padding bytes.
+    ///
+    /// The binary save state format copies these members verbatim, so padding must have a defined value for section
+    /// checksums and rewind deltas to depend only on the emulated state.
+    SaveState() {
+        ZeroFill(scheduler);
+        ZeroFill(system);
+        ZeroFill(msh2);
+        ZeroFill(ssh2);
+        ZeroFill(scu.dma);
+        ZeroFill(scu.dsp);
+        ZeroFill(vdp);
+        ZeroFill(scsp);
+        ZeroFill(cdif);
+        ZeroFill(cdblock);
+        ZeroFill(sh1);
+        ZeroFill(ygr);
+        ZeroFill(cddrive);
+        ZeroFill(cdblockDRAM);
+        ZeroFill(discHash);
+    }
+
     SchedulerSaveState scheduler;
     SystemSaveState system;
     SH2SaveState msh2;
@@ -57,6 +82,13 @@ struct SaveState {
     uint64 ssh2SpilloverCycles;
     uint64 sh1SpilloverCycles;
     uint64 sh1FracCycles;
+
+private:
+    template <typename T>
+    static void ZeroFill(T &value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        std::memset(&value, 0, sizeof(T));
+    }
 };
 
 } // namespace ymir::savestate
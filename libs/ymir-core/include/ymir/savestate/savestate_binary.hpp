@@ -0,0 +1,161 @@
+#pragma once
+
+/**
+@file
+@brief Native fixed-layout binary save state format.
+
+This format stores a `savestate::SaveState` as a flat sequence of sections whose payloads are the in-memory
+representation of the save state structures. It is meant for fast, same-build round trips such as rewind, run-ahead
+and automated test farms: saving is a series of `memcpy`s into one contiguous buffer and loading is a series of
+`memcpy`s out of it, which can be a memory-mapped file.
+
+The layout depends on the compiler, target architecture and build configuration. Files are rejected if any section
+size or the format version does not match. Use the portable save state format provided by the frontend for
+long-term storage.
+
+The file is laid out as follows:
+- `FileHeader`
+- `SectionHeader` table with `kNumSections` entries, indexed by `SectionID`
+- Section payloads. Sections that contain large memory blocks (WRAM, VDP1/VDP2 VRAM, SCSP WRAM, CD block DRAM) are
+  placed so that those blocks start on a page boundary. All other sections are aligned to `kSectionAlignment`.
+
+Each section carries an XXH3 64-bit checksum of its payload. Loaders may provide the checksums of the data currently
+held by the target state to skip copying sections that have not changed.
+*/
+
+#include "savestate.hpp"
+
+#include <ymir/core/types.hpp>
+
+#include <array>
+#include <filesystem>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace ymir::savestate::binary {
+
+/// @brief Magic number identifying binary save states ("YMSS" in little-endian byte order).
+inline constexpr uint32 kMagic = 0x53534D59;
+
+/// @brief Current binary save state format version.
+/// Must be incremented whenever the set of sections or the meaning of any section changes.
+inline constexpr uint32 kFormatVersion = 1;
+
+/// @brief Alignment of large memory blocks within the file.
+inline constexpr size_t kPageSize = 4096;
+
+/// @brief Alignment of all other sections within the file.
+inline constexpr size_t kSectionAlignment = 64;
+
+/// @brief Binary save state section identifiers.
+enum class SectionID : uint32 {
+    Meta,        ///< Execution state, disc hash and CD block mode
+    Scheduler,   ///< `SchedulerSaveState`
+    System,      ///< `SystemSaveState`, including WRAM
+    MSH2,        ///< `SH2SaveState` of the master SH-2
+    SSH2,        ///< `SH2SaveState` of the slave SH-2
+    SCU,         ///< `SCUSaveState` without cartridge data
+    SCUCartData, ///< `SCUSaveState::cartData` (variable size)
+    SMPC,        ///< `SMPCSaveState` without the INTBACK report
+    SMPCReport,  ///< `SMPCSaveState::intback.report` (variable size)
+    VDP,         ///< `VDPSaveState`
+    SCSP,        ///< `SCSPSaveState`
+    CDInterface, ///< `CDInterfaceSaveState`
+    CDBlock,     ///< `CDBlockSaveState` (HLE CD block only)
+    SH1,         ///< `SH1SaveState` (LLE CD block only)
+    YGR,         ///< `YGRSaveState` (LLE CD block only)
+    CDDrive,     ///< `CDDriveSaveState` (LLE CD block only)
+    CDBlockDRAM, ///< CD block DRAM (LLE CD block only)
+
+    Count
+};
+
+/// @brief Total number of sections in a binary save state.
+inline constexpr size_t kNumSections = static_cast<size_t>(SectionID::Count);
+
+/// @brief Binary save state file header.
+struct FileHeader {
+    uint32 magic;       ///< Must be `kMagic`
+    uint32 version;     ///< Must be `kFormatVersion`
+    uint32 numSections; ///< Must be `kNumSections`
+    uint32 headerSize;  ///< Size of this header in bytes
+    uint64 totalSize;   ///< Total size of the binary save state in bytes
+    uint64 reserved[5];
+};
+static_assert(sizeof(FileHeader) == 64);
+
+/// @brief Binary save state section header.
+struct SectionHeader {
+    uint64 offset;   ///< Offset of the payload from the start of the file
+    uint64 size;     ///< Payload size in bytes. Zero means the section is absent.
+    uint64 checksum; ///< XXH3 64-bit hash of the payload
+    uint64 reserved;
+};
+static_assert(sizeof(SectionHeader) == 32);
+
+/// @brief Section payload checksums, indexed by `SectionID`.
+///
+/// When passed to `Read`, the checksums must describe the contents of the target save state. Sections whose checksum
+/// matches the one stored in the file are not copied. Zero means unknown and always forces a copy.
+/// Reset all entries to zero if the save state is modified by any other means.
+using SectionChecksums = std::array<uint64, kNumSections>;
+
+/// @brief Binary save state loading results.
+enum class ReadResult {
+    Success,          ///< The save state was loaded successfully
+    FilesystemError,  ///< The file could not be opened or mapped
+    InvalidFormat,    ///< The data is not a binary save state
+    VersionMismatch,  ///< The data uses a different format version
+    LayoutMismatch,   ///< The data was written by a build with a different structure layout
+    Truncated,        ///< The data is shorter than specified by its headers
+    ChecksumMismatch, ///< A section checksum does not match its contents (only when verification is requested)
+};
+
+/// @brief Computes the exact size of the binary representation of the given save state.
+/// @param[in] state the save state
+/// @return the size of the binary save state in bytes
+[[nodiscard]] size_t CalcSize(const SaveState &state);
+
+/// @brief Writes a save state into a caller-provided buffer.
+/// @param[in] state the save state to write
+/// @param[out] out the output buffer. Must be at least `CalcSize(state)` bytes long.
+/// @param[out] checksums receives the section checksums if not `nullptr`
+/// @return the number of bytes written, or 0 if the buffer is too small
+size_t Write(const SaveState &state, std::span<uint8> out, SectionChecksums *checksums = nullptr);
+
+/// @brief Writes a save state into a vector, resizing it to fit the data exactly.
+/// Reuse the same vector across calls to avoid reallocations.
+/// @param[in] state the save state to write
+/// @param[out] out the output vector
+/// @param[out] checksums receives the section checksums if not `nullptr`
+void Write(const SaveState &state, std::vector<uint8> &out, SectionChecksums *checksums = nullptr);
+
+/// @brief Reads a save state from a binary buffer.
+/// @param[in] data the binary save state
+/// @param[out] state the save state to fill in
+/// @param[in,out] checksums if not `nullptr`, the checksums of the current contents of `state`. Unchanged sections
+/// are skipped. Updated with the checksums of the loaded sections on success.
+/// @param[in] verify whether to recompute and verify section checksums before loading
+/// @return the result of the operation. `state` is not modified unless the result is `ReadResult::Success`.
+ReadResult Read(std::span<const uint8> data, SaveState &state, SectionChecksums *checksums = nullptr,
+                bool verify = false);
+
+/// @brief Writes a save state to a file with a single contiguous write.
+/// @param[in] path the path to the file to write
+/// @param[in] state the save state to write
+/// @param[out] error receives any filesystem error
+/// @return `true` if the file was written successfully
+bool WriteFile(const std::filesystem::path &path, const SaveState &state, std::error_code &error);
+
+/// @brief Reads a save state from a memory-mapped file.
+/// @param[in] path the path to the file to read
+/// @param[out] state the save state to fill in
+/// @param[out] error receives any filesystem error
+/// @param[in,out] checksums see `Read`
+/// @param[in] verify whether to recompute and verify section checksums before loading
+/// @return the result of the operation
+ReadResult ReadFile(const std::filesystem::path &path, SaveState &state, std::error_code &error,
+                    SectionChecksums *checksums = nullptr, bool verify = false);
+
+} // namespace ymir::savestate::binary
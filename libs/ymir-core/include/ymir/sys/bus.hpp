@@ -17,6 +17,7 @@
 #include <ymir/util/unreachable.hpp>
 
 #include <concepts>
+#include <span>
 #include <type_traits>
 
 namespace ymir::sys {
@@ -32,13 +33,19 @@ using FnWrite32 = void (*)(uint32 address, uint32 value, void *ctx); ///< Functi
 /// @brief Function signature for bus wait checks.
 using FnBusWait = bool (*)(uint32 address, uint32 size, bool write, void *ctx);
 
+/// @brief Function signature for bulk 32-bit reads from a single address.
+///
+/// Must behave exactly like successive 32-bit reads from `address`, stopping before the first read that would be
+/// blocked by the bus wait signal. Returns the number of values written to `out`.
+using FnBulkRead32 = uint32 (*)(uint32 address, std::span<uint32> out, void *ctx);
+
 /// @brief Specifies valid bus handler function types.
 /// @tparam T the type to check
 template <typename T>
 concept bus_handler_fn =
     fninfo::IsAssignable<FnRead8, T> || fninfo::IsAssignable<FnRead16, T> || fninfo::IsAssignable<FnRead32, T> ||
     fninfo::IsAssignable<FnWrite8, T> || fninfo::IsAssignable<FnWrite16, T> || fninfo::IsAssignable<FnWrite32, T> ||
-    fninfo::IsAssignable<FnBusWait, T>;
+    fninfo::IsAssignable<FnBusWait, T> || fninfo::IsAssignable<FnBulkRead32, T>;
 
 /// @brief Represents a memory bus interconnecting various components in the system.
 ///
@@ -51,12 +58,13 @@ concept bus_handler_fn =
 /// @tparam addressBits number of valid address bits
 template <uint32 addressBits, uint32 pageGranularityBits>
 class Bus {
+public:
     static constexpr uint32 kAddressMask = (1u << addressBits) - 1;
+    static constexpr uint32 kPageShift = pageGranularityBits;
     static constexpr uint32 kPageSize = 1u << pageGranularityBits;
     static constexpr uint32 kPageMask = kPageSize - 1;
     static constexpr uint32 kPageCount = (1u << (addressBits - pageGranularityBits));
 
-public:
     /// @brief Maps both normal (read/write) and side-effect-free (peek/poke) handlers to the specified range.
     ///
     /// The same handler of a given type will be used for both categories.
@@ -145,6 +153,22 @@ public:
     template <size_t N>
         requires(bit::is_power_of_two(N) && N >= kPageSize)
     void MapArray(uint32 start, uint32 end, std::array<uint8, N> &array, bool writable) {
+        MapArray(start, end, std::span<uint8, N>(array), writable);
+    }
+
+    /// @brief Convenience method that maps a fixed-size block of memory to the specified range.
+    ///
+    /// Behaves like the `std::array` overload. Read-only memory (`writable == false`) is never written to, so the block
+    /// may be a read-only view of shared memory.
+    ///
+    /// @tparam N the size of the block. Must be a power of two and at least as large as the bus's page size
+    /// @param[in] start the lower bound of the address range to map the handlers into
+    /// @param[in] end the upper bound of the address range to map the handlers into
+    /// @param memory the block of memory to be mapped
+    /// @param writable indicates if the memory is meant to be writable or read-only
+    template <size_t N>
+        requires(bit::is_power_of_two(N) && N >= kPageSize)
+    void MapArray(uint32 start, uint32 end, std::span<uint8, N> memory, bool writable) {
         static constexpr uint32 kMask = N - 1;
 
         const uint32 startIndex = start >> pageGranularityBits;
@@ -152,7 +176,7 @@ public:
         uint32 offset = 0;
         for (uint32 i = startIndex; i <= endIndex; i++) {
             m_pages[i] = {}; // clear all handlers
-            m_pages[i].array = &array[offset & kMask];
+            m_pages[i].array = &memory[offset & kMask];
             m_pages[i].arrayWritable = writable;
             offset += kPageSize;
         }
@@ -186,6 +210,33 @@ public:
         }
     }
 
+    /// @brief Performs up to `out.size()` successive 32-bit reads from the same address, such as a data port or FIFO.
+    ///
+    /// Stops before the first read that would be blocked by the bus wait signal. Uses the bulk read handler assigned to
+    /// the address if there is one, which lets the device copy a run of values in one call; otherwise, falls back to
+    /// individual reads. Either way, the device observes the same sequence of accesses.
+    ///
+    /// @param[in] address the address to read
+    /// @param[out] out the buffer to receive the values
+    /// @return the number of values read
+    uint32 BulkRead(uint32 address, std::span<uint32> out) {
+        address &= kAddressMask & ~3u;
+
+        const MemoryPage &entry = m_pages[address >> pageGranularityBits];
+
+        if (entry.bulkRead32 != nullptr) {
+            return entry.bulkRead32(address, out, entry.ctx);
+        }
+        uint32 count = 0;
+        for (; count < out.size(); ++count) {
+            if (IsBusWait(address, sizeof(uint32), false)) {
+                break;
+            }
+            out[count] = Read<uint32>(address);
+        }
+        return count;
+    }
+
     /// @brief Writes data to the bus using the handler assigned to the specified address.
     /// @tparam T the data type of the access
     /// @param[in] address the address to write
@@ -309,6 +360,19 @@ public:
         }
     }
 
+    /// @brief Copies the access cycle timings of every page from another bus, leaving handlers untouched.
+    /// @param[in] other the bus to copy timings from
+    void CopyAccessCycles(const Bus &other) {
+        for (uint32 i = 0; i < kPageCount; i++) {
+            m_pages[i].readCycles8 = other.m_pages[i].readCycles8;
+            m_pages[i].writeCycles8 = other.m_pages[i].writeCycles8;
+            m_pages[i].readCycles16 = other.m_pages[i].readCycles16;
+            m_pages[i].writeCycles16 = other.m_pages[i].writeCycles16;
+            m_pages[i].readCycles32 = other.m_pages[i].readCycles32;
+            m_pages[i].writeCycles32 = other.m_pages[i].writeCycles32;
+        }
+    }
+
     /// @brief Retrieves the number of cycles needed to access the given address.
     /// @tparam T the type of the access
     /// @tparam write whether to query read (`false`) or write (`true`) cycles
@@ -357,6 +421,8 @@ private:
 
         FnBusWait busWait = [](uint32, uint32, bool, void *) -> bool { return false; };
 
+        FnBulkRead32 bulkRead32 = nullptr;
+
         uint64 readCycles8 = 1;
         uint64 readCycles16 = 1;
         uint64 readCycles32 = 1;
@@ -391,6 +457,10 @@ private:
     static void AssignHandler(MemoryPage &page, THandler &&handler) {
         if constexpr (fninfo::IsAssignable<FnBusWait, THandler>) {
             page.busWait = handler;
+        } else if constexpr (fninfo::IsAssignable<FnBulkRead32, THandler>) {
+            if constexpr (!peekpoke) {
+                page.bulkRead32 = handler;
+            }
         } else if constexpr (peekpoke) {
             if constexpr (fninfo::IsAssignable<FnRead8, THandler>) {
                 page.peek8 = handler;
@@ -18,8 +18,11 @@ comprising the main system memory and 32 KiB of internal backup memory for stori
 #include <ymir/core/hash.hpp>
 #include <ymir/core/types.hpp>
 
+#include <ymir/util/shared_memory.hpp>
+
 #include <array>
 #include <iosfwd>
+#include <memory>
 #include <span>
 
 namespace ymir::sys {
@@ -45,6 +48,31 @@ struct SystemMemory {
     /// @param[in] ipl the contents of the IPL ROM image
     void LoadIPL(std::span<uint8, kIPLSize> ipl);
 
+    /// @brief Loads an IPL ROM image from shared memory.
+    ///
+    /// The IPL ROM region maps the shared memory directly instead of holding a private copy, so instances loading the
+    /// same image share its physical memory.
+    ///
+    /// @param[in] ipl the shared IPL ROM image. Must be exactly `kIPLSize` bytes long.
+    /// @return `true` if the image was loaded, `false` if the image is missing or has the wrong size
+    bool LoadIPL(std::shared_ptr<const util::SharedMemory> ipl);
+
+    /// @brief Retrieves the contents of the IPL ROM.
+    /// @return a read-only view of the IPL ROM
+    [[nodiscard]] std::span<const uint8, kIPLSize> GetIPL() const {
+        return std::span<const uint8, kIPLSize>(m_ipl.Data(), kIPLSize);
+    }
+
+    /// @brief Retrieves the memory backing the IPL ROM, for mapping into buses as read-only memory.
+    ///
+    /// The memory may be a read-only view of a shared image and must never be written to. Its address is stable across
+    /// IPL ROM loads.
+    ///
+    /// @return the IPL ROM memory
+    [[nodiscard]] std::span<uint8, kIPLSize> GetIPLMemory() {
+        return std::span<uint8, kIPLSize>(m_ipl.Data(), kIPLSize);
+    }
+
     /// @brief Retrieves the IPL ROM hash code.
     /// @return the hash code of the currently loaded IPL ROM image
     XXH128Hash GetIPLHash() const;
@@ -114,12 +142,12 @@ struct SystemMemory {
     // -------------------------------------------------------------------------
     // Memory
 
-    alignas(16) std::array<uint8, kIPLSize> IPL; ///< 512 KiB IPL ROM (aka BIOS ROM)
-
     alignas(16) std::array<uint8, kWRAMLowSize> WRAMLow;   ///< 1 MiB Low Work RAM (slow)
     alignas(16) std::array<uint8, kWRAMHighSize> WRAMHigh; ///< 1 MiB High Work RAM (fast)
 
 private:
+    util::SharedMemorySlot m_ipl{kIPLSize}; ///< 512 KiB IPL ROM (aka BIOS ROM), possibly shared with other instances
+
     bup::BackupMemory m_internalBackupRAM; ///< Internal backup memory
 
     XXH128Hash m_iplHash{}; ///< Cached IPL ROM hash
@@ -0,0 +1,302 @@
+#pragma once
+
+/**
+@file
+@brief Defines `ymir::sys::ParallelSlaveSH2`, which runs the slave SH-2 speculatively on a dedicated thread.
+*/
+
+#include "bus.hpp"
+
+#include <ymir/hw/sh2/sh2.hpp>
+
+#include <ymir/savestate/savestate_sh2.hpp>
+
+#include <ymir/core/types.hpp>
+
+#include <ymir/util/callback.hpp>
+
+#include <array>
+#include <atomic>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace ymir::sys {
+
+/// @brief Runs the slave SH-2 on a dedicated thread, concurrently with the master SH-2.
+///
+/// The emulator thread normally interleaves both SH-2s in small steps: the master SH-2 runs a step, then the slave SH-2
+/// runs up to the same cycle count, then the SCU catches up. This class reproduces that exact sequence with the slave
+/// SH-2 on its own thread, following the master SH-2 one step behind. The outcome is identical to the interleaved loop.
+///
+/// A slice starts with `Begin`. The emulator thread then runs the master SH-2 step by step, calling `EndStep` after
+/// each step to hand its end to the slave SH-2 thread, and calls `Finish` at the end. The SCU must be idle for the
+/// whole slice, so that advancing it once at the end is the same as advancing it after every step.
+///
+/// While speculating, both SH-2s access memory through tracking views of the system bus:
+/// - Slave SH-2 writes to shared memory go to a private shadow copy and are applied to the real memory by `Finish`.
+/// - Every 16-byte line of shared memory accessed by either SH-2 is stamped with the step of the access. In the
+///   interleaved order, a slave SH-2 read in step N sees master SH-2 writes up to step N, and a master SH-2 access in
+///   step N sees slave SH-2 writes up to step N-1. The speculative run is only kept if the stamps show that no access
+///   depended on that order. Instruction fetches are tracked the same way, so self-modifying code is handled too.
+/// - Shared memory is accessed atomically on both sides, since the master SH-2 may write to lines the slave SH-2 reads.
+/// - The slave SH-2 may not access anything else (MMIO, MINIT/SINIT, cartridges, backup memory). Doing so fails the
+///   speculative run.
+/// - When the master SH-2 accesses anything else, the slave SH-2 thread is stopped at the end of the previous step and
+///   its speculative run is validated and committed. The rest of the slice is finished interleaved on the emulator
+///   thread, starting with the access that caused the divergence.
+///
+/// On conflicts, the master SH-2's writes are undone, both SH-2s are restored from snapshots taken by `Begin` and the
+/// slice is run again interleaved on the emulator thread. Conflicts tend to come in bursts, so the slices that follow
+/// also run interleaved, backing off exponentially on repeated conflicts.
+class ParallelSlaveSH2 {
+public:
+    /// @brief Slice execution statistics.
+    struct Stats {
+        uint64 slices = 0;     ///< Total number of slices started with `Begin`
+        uint64 committed = 0;  ///< Slices run on both threads and committed
+        uint64 diverted = 0;   ///< Slices finished interleaved after the master SH-2 accessed a device
+        uint64 rolledBack = 0; ///< Slices rolled back and rerun interleaved due to a conflict
+        uint64 sequential = 0; ///< Slices run interleaved due to backoff
+    };
+
+    /// @brief Invoked to advance the SCU through the cycles executed by the master SH-2.
+    using CBAdvanceSCU = util::RequiredCallback<void(uint64 cycles)>;
+
+    ParallelSlaveSH2(sh2::SH2 &master, sh2::SH2 &slave, SH2Bus &bus);
+    ~ParallelSlaveSH2();
+
+    /// @brief Sets the callback that advances the SCU.
+    /// @param[in] callback the callback to invoke
+    void SetAdvanceSCUCallback(CBAdvanceSCU callback) {
+        m_cbAdvanceSCU = callback;
+    }
+
+    /// @brief Declares a region of plain memory that the slave SH-2 may access from its own thread.
+    ///
+    /// The memory is mirrored across the whole range, as done by `SH2Bus::MapArray`. Must be called while disabled.
+    ///
+    /// @param[in] start the lower bound of the address range
+    /// @param[in] end the upper bound of the address range
+    /// @param[in] memory the memory mapped to the range. The size must be a power of two.
+    /// @param[in] writable whether the memory can be written to
+    void AddSharedMemory(uint32 start, uint32 end, std::span<uint8> memory, bool writable);
+
+    /// @brief Copies the access cycle timings from the system bus.
+    ///
+    /// Must be called whenever the system bus timings change.
+    void UpdateAccessCycles();
+
+    /// @brief Starts or stops the slave SH-2 thread.
+    /// @param[in] enable whether to run the slave SH-2 on its own thread
+    void Enable(bool enable);
+
+    /// @brief Determines if the slave SH-2 thread is running.
+    /// @return `true` if the slave SH-2 runs on its own thread
+    [[nodiscard]] bool IsEnabled() const {
+        return m_enabled;
+    }
+
+    /// @brief Starts running the slave SH-2 through a slice on its own thread.
+    ///
+    /// If this returns `true`, the master SH-2 must be run through the slice in steps with `SH2::Advance`, calling
+    /// `EndStep` after every step and `Finish` at the end, without advancing the SCU. Otherwise, the slice must be run
+    /// interleaved on the emulator thread.
+    ///
+    /// @tparam emulateCache whether to emulate the SH-2 cache
+    /// @param[in] cycles the length of the slice
+    /// @param[in] masterCycles the cycles already executed by the master SH-2 at the start of the slice
+    /// @param[in] slaveCycles the cycles already executed by the slave SH-2 at the start of the slice
+    /// @return `true` if the slave SH-2 runs on its own thread through this slice
+    template <bool emulateCache>
+    bool Begin(uint64 cycles, uint64 masterCycles, uint64 slaveCycles);
+
+    /// @brief Hands the end of a master SH-2 step to the slave SH-2 thread.
+    /// @param[in] masterCycles the cycles executed by the master SH-2 at the end of the step
+    /// @return `true` if the master SH-2 may run another step, `false` if the slice must be finished now
+    bool EndStep(uint64 masterCycles);
+
+    /// @brief Waits for the slave SH-2 to catch up with the master SH-2, then commits or rolls back the slice.
+    ///
+    /// If the slice is not complete when this returns, the remaining steps must be run interleaved on the emulator
+    /// thread starting from the updated cycle counts.
+    ///
+    /// @param[in] cycles the length of the slice
+    /// @param[in,out] masterCycles the cycles executed by the master SH-2; reset to the start of the slice on rollback
+    /// @param[out] slaveCycles receives the cycles executed by the slave SH-2
+    /// @return `true` if the slice is complete
+    bool Finish(uint64 cycles, uint64 &masterCycles, uint64 &slaveCycles);
+
+    /// @brief Retrieves the slice execution statistics.
+    /// @return the statistics collected since the last reset
+    [[nodiscard]] const Stats &GetStats() const {
+        return m_stats;
+    }
+
+    /// @brief Clears the slice execution statistics.
+    void ResetStats() {
+        m_stats = {};
+    }
+
+private:
+    sh2::SH2 &m_master;
+    sh2::SH2 &m_slave;
+    SH2Bus &m_bus;
+
+    CBAdvanceSCU m_cbAdvanceSCU;
+
+    bool m_enabled = false;
+
+    // -------------------------------------------------------------------------
+    // Memory accesses
+
+    static constexpr uint32 kLineShift = 4;
+
+    struct SharedRegion {
+        uint8 *memory;
+        uint32 mask;
+        bool writable;
+
+        // The following are only used by writable regions
+
+        std::vector<uint8> shadow; // Values written by the slave SH-2 during the current slice
+        std::vector<uint8> dirty;  // 0xFF for every byte present in shadow, 0x00 otherwise
+
+        // Step stamps per line: zero if not accessed, otherwise the step of the access plus one.
+        // Slave SH-2 stamps record the first access (earliest step), master SH-2 stamps record the last (latest step).
+        std::vector<uint32> slaveReads;
+        std::vector<uint32> slaveWrites;
+        std::vector<uint32> masterAccesses;
+        std::vector<uint32> masterWrites;
+    };
+
+    struct LineRef {
+        uint32 line;
+        uint8 region;
+    };
+
+    struct WriteLogEntry {
+        uint32 offset;
+        uint8 region;
+        uint8 size;
+    };
+
+    struct UndoLogEntry {
+        uint32 offset;
+        uint32 value; // Value overwritten by the master SH-2
+        uint8 region;
+        uint8 size;
+    };
+
+    // Tracking view of the system bus used by the slave SH-2 on its own thread
+    SH2Bus m_slaveBus;
+
+    // Tracking view of the system bus used by the master SH-2 while the slave SH-2 runs on its own thread
+    SH2Bus m_masterBus;
+
+    std::vector<SharedRegion> m_regions;
+    std::array<uint8, SH2Bus::kPageCount> m_pageRegions{}; // Index into m_regions plus one, or zero if not shared
+
+    // Written by the slave SH-2 thread
+    std::vector<LineRef> m_slaveLines;
+    std::vector<WriteLogEntry> m_writeLog;
+    uint32 m_slaveStamp = 0;
+    bool m_deviceAccessed = false;
+
+    // Written by the emulator thread
+    std::vector<LineRef> m_masterLines;
+    std::vector<UndoLogEntry> m_undoLog;
+
+    template <mem_primitive T>
+    T SlaveRead(uint32 address);
+
+    template <mem_primitive T>
+    void SlaveWrite(uint32 address, T value);
+
+    bool SlaveBusWait(uint32 address);
+
+    template <mem_primitive T>
+    T MasterRead(uint32 address);
+
+    template <mem_primitive T>
+    void MasterWrite(uint32 address, T value);
+
+    bool MasterBusWait(uint32 address, uint32 size, bool write);
+
+    [[nodiscard]] bool Validate() const;
+    void CommitWrites();
+    void DiscardWrites();
+    void UndoMasterWrites();
+    void ResetTracking();
+
+    // -------------------------------------------------------------------------
+    // Slices
+
+    static constexpr uint32 kMaxBackoffSlices = 64;
+
+    enum class State : uint8 {
+        Idle,        // No slice in progress
+        Speculating, // The slave SH-2 follows the master SH-2 on its own thread
+        Diverted,    // The master SH-2 accessed a device and the slave SH-2 was synchronized on the emulator thread
+        Aborted,     // The master SH-2 accessed a device but the slave SH-2 could not be synchronized
+    };
+
+    State m_state = State::Idle;
+
+    savestate::SH2SaveState m_masterSnapshot;
+    savestate::SH2SaveState m_slaveSnapshot;
+
+    uint64 m_masterStart = 0;
+    uint64 m_slaveStart = 0;
+    uint64 m_divertCycles = 0; // Master SH-2 cycles at the start of the step that was diverted
+
+    std::vector<uint64> m_stepEnds; // Master SH-2 cycle count at the end of every step
+    uint32 m_step = 0;              // Number of steps completed by the master SH-2
+
+    uint32 m_backoffSlices = 0;    // Length of the current backoff period
+    uint32 m_sequentialSlices = 0; // Slices left to run interleaved on the emulator thread
+
+    Stats m_stats;
+
+    // Stops the slave SH-2 thread at the end of the steps completed so far and switches the rest of the slice over to
+    // the emulator thread. Invoked when the master SH-2 accesses a device.
+    bool Divert();
+
+    bool Rollback(uint64 &masterCycles, uint64 &slaveCycles);
+
+    void RestoreBuses();
+
+    // -------------------------------------------------------------------------
+    // Threading
+
+    using FnAdvance = uint64 (*)(sh2::SH2 &slave, uint64 cycles, uint64 spilloverCycles);
+
+    // Set in the published step count once the slice is closed
+    static constexpr uint64 kSliceClosed = 1ull << 63ull;
+
+    std::thread m_thread;
+    std::atomic<bool> m_threadRunning = false;
+
+    // Written by the emulator thread before submitting a slice
+    FnAdvance m_advance = nullptr;
+
+    // Written by the slave SH-2 thread before completing a slice
+    uint64 m_sliceResult = 0;
+
+    // Number of slices submitted to and completed by the slave SH-2 thread
+    alignas(64) std::atomic<uint64> m_submitted = 0;
+    alignas(64) std::atomic<uint64> m_completed = 0;
+
+    // Number of steps published to the slave SH-2 thread, plus kSliceClosed when no more steps will be published
+    alignas(64) std::atomic<uint64> m_published = 0;
+
+    // Raised by the slave SH-2 thread when it stops early due to a device access
+    alignas(64) std::atomic<bool> m_slaveFailed = false;
+
+    void ThreadLoop();
+    void RunSlice();
+    void CloseSlice();
+    void StopThread();
+};
+
+} // namespace ymir::sys
@@ -15,8 +15,12 @@ See @ref index for instructions on how to use the emulator.
 #include <ymir/savestate/savestate.hpp>
 
 #include <ymir/debug/debug_break.hpp>
+#include <ymir/debug/host_timing.hpp>
+#include <ymir/debug/pc_sampler.hpp>
+#include <ymir/debug/trace_recorder.hpp>
 
 #include "memory.hpp"
+#include "parallel_slave_sh2.hpp"
 #include "system.hpp"
 
 #include <ymir/hw/cart/cart.hpp>
@@ -32,6 +36,10 @@ See @ref index for instructions on how to use the emulator.
 
 #include <ymir/media/cd_interface.hpp>
 
+#include <ymir/util/virtual_memory.hpp>
+
+#include <new>
+
 namespace ymir {
 
 /// @brief Represents an emulated Sega Saturn system.
@@ -46,6 +54,33 @@ struct Saturn {
     /// into an infinite do-nothing loop.
     Saturn();
 
+    /// @brief Allocates memory for a `Saturn` instance.
+    ///
+    /// Emulated memory (WRAM, VRAM, sound RAM, CD block DRAM and buffers) and the bus page tables are all members of
+    /// this object. Instances are allocated in a single block of virtual memory aligned to huge page boundaries and
+    /// backed by huge pages when the system allows it, so the whole working set is covered by a handful of TLB entries.
+    ///
+    /// @param[in] size the size of the instance in bytes
+    /// @return a pointer to the allocated memory
+    static void *operator new(std::size_t size);
+    static void *operator new(std::size_t size, std::align_val_t alignment);
+    static void operator delete(void *ptr) noexcept;
+    static void operator delete(void *ptr, std::align_val_t alignment) noexcept;
+
+    /// @brief Retrieves the kind of pages backing this instance's memory.
+    /// @return the page backing of the instance, or `util::VirtualMemory::Backing::Regular` if the instance was not
+    /// allocated with `new`
+    [[nodiscard]] util::VirtualMemory::Backing GetMemoryBacking() const;
+
+    /// @brief Binds this instance's memory to the NUMA node of the calling thread, migrating pages resident on other
+    /// nodes.
+    ///
+    /// Meant to be invoked from the thread that runs the emulator when it is not the one that created the instance.
+    /// Only supported on Linux; this is a no-op on systems with a single NUMA node.
+    ///
+    /// @return `true` if the memory was bound to the node of the calling thread
+    bool BindMemoryToCurrentNUMANode();
+
     /// @brief Performs a soft or hard reset of the system.
     /// @param[in] hard `true` to do a hard reset, `false` for a soft reset
     void Reset(bool hard);
@@ -82,6 +117,14 @@ struct Saturn {
     /// @param[in] ipl the contents of the IPL ROM image
     void LoadIPL(std::span<uint8, sys::kIPLSize> ipl);
 
+    /// @brief Loads an IPL ROM image from shared memory, mapping it without copying.
+    ///
+    /// Use `sys::SharedROMPool` to share the image between instances.
+    ///
+    /// @param[in] ipl the shared IPL ROM image. Must be exactly `sys::kIPLSize` bytes long.
+    /// @return `true` if the image was loaded, `false` if the image is missing or has the wrong size
+    bool LoadIPL(std::shared_ptr<const util::SharedMemory> ipl);
+
     /// @brief Loads the specified CD Block ROM image.
     /// @param[in] rom the contents of the CD Block ROM image
     void LoadCDBlockROM(std::span<uint8, sh1::kROMSize> rom);
@@ -235,6 +278,54 @@ struct Saturn {
         return (this->*m_stepSSH2Fn)();
     }
 
+    /// @brief Attaches a sampling program counter profiler.
+    ///
+    /// While attached, the program counters of the master and slave SH-2, the MC68EC000 and the CD block SH-1 (when
+    /// low-level CD block emulation is enabled) are sampled every `PCSampler::GetInterval()` cycles. Sampling does not
+    /// require debug tracing.
+    ///
+    /// Samples are taken between emulation slices, so the effective resolution is limited by the distance between
+    /// scheduled events. Samples that span multiple intervals are weighted accordingly.
+    ///
+    /// The previously attached sampler, if any, is flushed before it is detached.
+    ///
+    /// @param[in] sampler the sampler to use, or `nullptr` to disable sampling
+    void UsePCSampler(debug::PCSampler *sampler) {
+        if (m_pcSampler != nullptr) {
+            m_pcSampler->Flush();
+        }
+        m_pcSampler = sampler;
+        m_pcSampleCycles = 0;
+    }
+
+    /// @brief Attaches a binary trace recorder to the master and slave SH-2, the SCU and the CD block.
+    ///
+    /// The recorder's tracers replace the tracers attached to these components, and its streams are stamped with the
+    /// emulated cycle count: SH-2 records with the exact cycle of each instruction, SCU, CD block and frame marker
+    /// records with the cycle at the start of the current emulation slice. Instruction-level records require debug
+    /// tracing.
+    ///
+    /// Passing `nullptr` detaches the tracers of these components and unbinds the previously attached recorder from
+    /// the cycle counters. Must not be called while the emulator is running.
+    ///
+    /// @param[in] recorder the recorder to attach, or `nullptr` to detach it
+    void UseTraceRecorder(debug::trace::TraceRecorder *recorder);
+
+    /// @brief Attaches host timing statistics to the emulator.
+    ///
+    /// Host timing instrumentation must be compiled in (CMake option `Ymir_ENABLE_HOST_TIMING`) for components to be
+    /// measured. The SH-2 CPUs, SCU, SH-1, SCSP and CD block are measured on the emulator thread or the SCSP thread,
+    /// while VDP1 and VDP2 rendering is measured by the renderer on whichever thread performs the work.
+    /// `HostTimingStats::EndFrame()` is invoked at the end of every emulated frame.
+    ///
+    /// @param[in] stats the statistics to update, or `nullptr` to disable timing
+    void UseHostTimingStats(debug::HostTimingStats *stats) {
+        m_hostTiming = stats;
+        VDP.UseHostTimingStats(stats);
+        SCSP.UseHostTimingStats(stats);
+        CDBlock.UseHostTimingStats(stats);
+    }
+
     /// @brief Detaches all debug tracers from all components.
     void DetachAllTracers() {
         masterSH2.UseTracer(nullptr);
@@ -362,6 +453,26 @@ private:
     /// @param[in] cycles the number of system cycles to advance
     void AdvanceSH1(uint64 cycles);
 
+    /// @brief Advances the SCU while it is idle. Used by the threaded slave SH-2 to catch up the SCU after a slice.
+    /// @param[in] cycles the number of system cycles to advance
+    void AdvanceIdleSCU(uint64 cycles);
+
+    /// @brief The attached binary trace recorder, if any.
+    debug::trace::TraceRecorder *m_traceRecorder = nullptr;
+
+    /// @brief The attached program counter sampler, if any.
+    debug::PCSampler *m_pcSampler = nullptr;
+
+    /// @brief System cycles accumulated since the last program counter sample.
+    uint64 m_pcSampleCycles = 0;
+
+    /// @brief Accumulates executed cycles and samples program counters if the sampling interval has elapsed.
+    /// @param[in] cycles the number of system cycles executed
+    void SamplePCs(uint64 cycles);
+
+    /// @brief The attached host timing statistics, if any.
+    debug::HostTimingStats *m_hostTiming = nullptr;
+
     /// @brief Configures bus access cycles.
     /// @param[in] fastTimings `true` to use 1 waitstate for every access, `false` to use normal timings
     void ConfigureAccessCycles(bool fastTimings);
@@ -462,6 +573,9 @@ private:
     uint64 m_sh1SpilloverCycles;  ///< SH-1 execution cycles spilled over between executions
     uint64 m_sh1FracCycles;       ///< SH-1 fractional execution cycles spilled over by clock ratio calculation
 
+    /// @brief Runs the slave SH-2 on a dedicated thread
+    sys::ParallelSlaveSH2 m_parallelSlaveSH2{masterSH2, slaveSH2, mainBus};
+
     /// @brief Invoked when the CD interface detects a change in media.
     void OnMediaChanged();
 
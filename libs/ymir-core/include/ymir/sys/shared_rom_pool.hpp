@@ -0,0 +1,62 @@
+#pragma once
+
+/**
+@file
+@brief Content-addressed pool of read-only images shared between emulator instances.
+*/
+
+#include <ymir/core/hash.hpp>
+#include <ymir/core/types.hpp>
+
+#include <ymir/util/shared_memory.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <system_error>
+#include <unordered_map>
+
+namespace ymir::sys {
+
+/// @brief A pool of read-only ROM and disc images shared between emulator instances, indexed by content hash.
+///
+/// Acquiring an image whose contents are already in the pool returns the existing shared memory object, so instances
+/// that load the same IPL ROM or cartridge ROM reference the same physical memory. The pool only holds weak references;
+/// images are released when no instance uses them anymore.
+///
+/// All methods are thread-safe.
+class SharedROMPool {
+public:
+    /// @brief Retrieves the shared memory object holding the specified contents, creating one if necessary.
+    /// @param[in] data the image contents
+    /// @param[out] error receives the system error if a new shared memory object could not be created
+    /// @return the shared memory object, or `nullptr` if it could not be created
+    std::shared_ptr<const util::SharedMemory> Acquire(std::span<const uint8> data, std::error_code &error);
+
+    /// @brief Retrieves the shared memory object holding the contents of the specified file, mapping the file if no
+    /// object in the pool has the same contents.
+    /// @param[in] path the path to the image file
+    /// @param[out] error receives the system error if the file could not be mapped
+    /// @return the shared memory object, or `nullptr` if the file could not be mapped
+    std::shared_ptr<const util::SharedMemory> AcquireFile(const std::filesystem::path &path, std::error_code &error);
+
+    /// @brief Adds an existing shared memory object, such as one imported from another process, to the pool.
+    /// @param[in] memory the shared memory object to add
+    /// @return the object in the pool with the same contents; `memory` itself if there was none
+    std::shared_ptr<const util::SharedMemory> Add(std::shared_ptr<const util::SharedMemory> memory);
+
+    /// @brief Counts the images in use.
+    /// @return the number of shared memory objects in the pool that are still referenced
+    [[nodiscard]] size_t GetLiveCount() const;
+
+private:
+    mutable std::mutex m_mutex;
+    std::unordered_map<XXH128Hash, std::weak_ptr<const util::SharedMemory>> m_entries;
+
+    std::shared_ptr<const util::SharedMemory> Find(const XXH128Hash &hash);
+    std::shared_ptr<const util::SharedMemory> Insert(const XXH128Hash &hash,
+                                                     std::shared_ptr<const util::SharedMemory> memory);
+};
+
+} // namespace ymir::sys
@@ -0,0 +1,186 @@
+#pragma once
+
+/**
+@file
+@brief Read-only memory shared between emulator instances, threads and processes.
+
+`SharedMemory` holds an immutable block of memory backed by a shared memory object or a file mapping. Any number of
+`SharedMemorySlot`s can display its contents without copying them; the operating system maps the same physical pages
+into every slot, so identical ROM images used by multiple emulator instances are only resident in memory once.
+
+Shared memory objects can be passed to other processes through their native handles (a file descriptor on POSIX
+systems, a `HANDLE` on Windows) and imported there with `SharedMemory::Import`.
+*/
+
+#include <ymir/core/types.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <system_error>
+
+namespace util {
+
+/// @brief An immutable, reference-counted block of shared memory.
+///
+/// Instances are always managed by `std::shared_ptr`; the memory is unmapped when the last reference is released.
+class SharedMemory {
+public:
+#ifdef _WIN32
+    using NativeHandle = void *;
+    static constexpr NativeHandle kInvalidHandle = nullptr;
+#else
+    using NativeHandle = int;
+    static constexpr NativeHandle kInvalidHandle = -1;
+#endif
+
+    /// @brief Creates a shared memory object with a copy of the specified data.
+    ///
+    /// On Linux, the object is sealed against writes and resizing.
+    ///
+    /// @param[in] data the contents of the shared memory object. Must not be empty.
+    /// @param[out] error receives the system error if the object could not be created
+    /// @return a pointer to the shared memory object, or `nullptr` if it could not be created
+    static std::shared_ptr<SharedMemory> Create(std::span<const uint8> data, std::error_code &error);
+
+    /// @brief Maps a file in read-only mode.
+    ///
+    /// The contents are served from the operating system's file cache, which is shared by every process that maps the
+    /// same file. The file must not be modified while mapped.
+    ///
+    /// @param[in] path the path to the file to map
+    /// @param[out] error receives the system error if the file could not be mapped
+    /// @return a pointer to the shared memory object, or `nullptr` if the file could not be mapped
+    static std::shared_ptr<SharedMemory> MapFile(const std::filesystem::path &path, std::error_code &error);
+
+    /// @brief Imports a shared memory object from a native handle, typically received from another process.
+    ///
+    /// The handle is duplicated; the caller retains ownership of `handle`.
+    ///
+    /// @param[in] handle the native handle of the shared memory object
+    /// @param[in] size the size of the shared memory object in bytes
+    /// @param[out] error receives the system error if the object could not be imported
+    /// @return a pointer to the shared memory object, or `nullptr` if it could not be imported
+    static std::shared_ptr<SharedMemory> Import(NativeHandle handle, size_t size, std::error_code &error);
+
+    SharedMemory(const SharedMemory &) = delete;
+    SharedMemory(SharedMemory &&) = delete;
+    ~SharedMemory();
+
+    SharedMemory &operator=(const SharedMemory &) = delete;
+    SharedMemory &operator=(SharedMemory &&) = delete;
+
+    /// @brief Retrieves the contents of the shared memory object.
+    /// @return a read-only view of the memory
+    [[nodiscard]] std::span<const uint8> Data() const {
+        return {m_data, m_size};
+    }
+
+    /// @brief Retrieves the size of the shared memory object.
+    /// @return the size in bytes
+    [[nodiscard]] size_t Size() const {
+        return m_size;
+    }
+
+    /// @brief Retrieves the native handle of the shared memory object, which can be passed to other processes.
+    ///
+    /// The handle remains owned by this object.
+    ///
+    /// @return the native handle
+    [[nodiscard]] NativeHandle GetNativeHandle() const {
+        return m_handle;
+    }
+
+    /// @brief Touches every page of the memory so that it is resident before it is first accessed.
+    void Prefault() const;
+
+private:
+    SharedMemory() = default;
+
+    bool MapView(size_t size, std::error_code &error);
+
+    const uint8 *m_data = nullptr;
+    size_t m_size = 0;
+    NativeHandle m_handle = kInvalidHandle;
+
+    friend class SharedMemorySlot;
+};
+
+/// @brief A block of memory at a fixed address that holds either private memory or a view of a `SharedMemory` object.
+///
+/// The address of the block never changes, so pointers into it (such as bus page pointers) remain valid when switching
+/// between private and shared contents.
+class SharedMemorySlot {
+public:
+    /// @brief Allocates a slot of the specified size filled with zeros.
+    /// @param[in] size the size of the slot in bytes. Must be a multiple of the system page size.
+    explicit SharedMemorySlot(size_t size);
+
+    SharedMemorySlot(const SharedMemorySlot &) = delete;
+    SharedMemorySlot(SharedMemorySlot &&) = delete;
+    ~SharedMemorySlot();
+
+    SharedMemorySlot &operator=(const SharedMemorySlot &) = delete;
+    SharedMemorySlot &operator=(SharedMemorySlot &&) = delete;
+
+    /// @brief Retrieves a pointer to the memory of the slot.
+    ///
+    /// The memory must not be written to while `IsReadOnly()` returns `true`.
+    ///
+    /// @return a pointer to the memory
+    [[nodiscard]] uint8 *Data() const {
+        return m_data;
+    }
+
+    /// @brief Retrieves the size of the slot.
+    /// @return the size in bytes
+    [[nodiscard]] size_t Size() const {
+        return m_size;
+    }
+
+    /// @brief Retrieves the shared memory object viewed by the slot.
+    /// @return the shared memory object, or `nullptr` if the slot holds private memory
+    [[nodiscard]] const std::shared_ptr<const SharedMemory> &GetSharedMemory() const {
+        return m_shared;
+    }
+
+    /// @brief Determines if the slot holds a read-only view of a shared memory object.
+    /// @return `true` if the memory of the slot must not be written to
+    [[nodiscard]] bool IsReadOnly() const {
+        return m_readOnly;
+    }
+
+    /// @brief Replaces the contents of the slot with private, zero-filled memory.
+    ///
+    /// Throws `std::bad_alloc` if no memory can be mapped at the address of the slot.
+    void MapPrivate();
+
+    /// @brief Replaces the contents of the slot with a view of the shared memory object.
+    ///
+    /// If the object is smaller or larger than the slot or cannot be mapped into it, its contents are copied into
+    /// private memory instead and the remainder of the slot is filled with zeros.
+    ///
+    /// @param[in] memory the shared memory object to view
+    /// @param[in] copyOnWrite `true` to make the view writable, copying pages into private memory when they are first
+    /// written to; `false` to make the view read-only
+    /// @return `true` if the object is mapped into the slot, `false` if its contents were copied
+    bool MapShared(std::shared_ptr<const SharedMemory> memory, bool copyOnWrite);
+
+    /// @brief Makes the slot writable, switching a read-only view to a copy-on-write view of the same object.
+    void MakeWritable();
+
+private:
+    uint8 *m_data = nullptr;
+    size_t m_size = 0;
+    std::shared_ptr<const SharedMemory> m_shared;
+    bool m_readOnly = false;
+
+    // Replaces the view at the address of the slot. Returns false if the new view could not be mapped, in which case
+    // the slot holds private memory with unspecified contents. Throws std::bad_alloc if not even that could be mapped.
+    bool Remap(const SharedMemory *memory, bool copyOnWrite);
+
+    struct Internal;
+    std::unique_ptr<Internal> m_internal;
+};
+
+} // namespace util
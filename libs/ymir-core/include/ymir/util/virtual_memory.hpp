@@ -5,22 +5,52 @@
 @brief Virtual memory management.
 */
 
+#include <ymir/core/types.hpp>
+
 #include <ymir/util/inline.hpp>
 
 #include <memory>
+#include <optional>
 #include <utility>
 
 namespace util {
 
+/// @brief The size of a huge page (also called large page) on the platforms that support them.
+inline constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+/// @brief Options for allocating virtual memory.
+struct VirtualMemoryOptions {
+    /// @brief Back the memory with huge pages if possible.
+    ///
+    /// Covering a large block of memory with a handful of huge pages instead of hundreds of regular pages greatly reduces
+    /// TLB misses on random accesses. The block is aligned to `kHugePageSize`. If the system has no huge pages available,
+    /// the memory falls back to regular pages.
+    bool hugePages = false;
+};
+
 /// @brief Holds a block of virtual memory.
 class VirtualMemory {
 public:
+    /// @brief The kinds of pages backing a block of virtual memory.
+    enum class Backing {
+        /// @brief Regular pages.
+        Regular,
+
+        /// @brief Regular pages that the operating system was advised to promote to huge pages in the background
+        /// (Linux transparent huge pages).
+        TransparentHuge,
+
+        /// @brief Huge pages reserved on allocation.
+        Huge,
+    };
+
     /// @brief Constructs an unallocated block of virtual memory.
     VirtualMemory();
 
     /// @brief Constructs a block of virtual memory of the specified size.
     /// @param[in] size the size of the virtual memory block in bytes.
-    VirtualMemory(size_t size);
+    /// @param[in] options allocation options
+    VirtualMemory(size_t size, VirtualMemoryOptions options = {});
 
     VirtualMemory(const VirtualMemory &) = delete;
     VirtualMemory(VirtualMemory &&rhs);
@@ -29,14 +59,16 @@ public:
     VirtualMemory &operator=(const VirtualMemory &) = delete;
     VirtualMemory &operator=(VirtualMemory &&rhs) {
         std::swap(m_mem, rhs.m_mem);
+        std::swap(m_size, rhs.m_size);
         std::swap(m_internal, rhs.m_internal);
         return *this;
     }
 
     /// @brief Allocates a block of virtual memory of the specified size
     /// @param[in] size the size of the virtual memory block in bytes.
+    /// @param[in] options allocation options
     /// @return a pointers to the allocated memory. `nullptr` if the allocation failed.
-    void *Allocate(size_t size);
+    void *Allocate(size_t size, VirtualMemoryOptions options = {});
 
     /// @brief Frees the block of virtual memory.
     void Free();
@@ -59,15 +91,32 @@ public:
         return m_mem;
     }
 
+    /// @brief Retrieves the kind of pages backing the memory.
+    /// @return the page backing of the block of virtual memory. `Backing::Regular` if not allocated.
+    Backing GetBacking() const;
+
+    /// @brief Binds the memory to the specified NUMA node, migrating pages that are already resident elsewhere.
+    ///
+    /// Only supported on Linux. The binding is a preference; pages may still be placed on other nodes if the preferred
+    /// node runs out of memory.
+    ///
+    /// @param[in] node the NUMA node to bind to
+    /// @return `true` if the memory was bound to the node
+    bool BindToNUMANode(uint32 node);
+
 private:
     void *m_mem = nullptr;
     size_t m_size = 0;
 
-    void Map(size_t size);
+    void Map(size_t size, VirtualMemoryOptions options);
     void Unmap();
 
     struct Internal;
     std::unique_ptr<Internal> m_internal;
 };
 
+/// @brief Determines which NUMA node the calling thread is currently running on.
+/// @return the NUMA node of the current thread, or `std::nullopt` if it could not be determined
+std::optional<uint32> GetCurrentNUMANode();
+
 } // namespace util
@@ -0,0 +1,393 @@
+#include <ymir/debug/av_capture.hpp>
+
+#include <ymir/util/thread_name.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace ymir::debug {
+
+// SCSP output sample rate, which is the timebase for emulated time
+static constexpr uint64 kSampleRate = 44100;
+
+AVCapture::AVCapture() = default;
+
+AVCapture::~AVCapture() {
+    Stop();
+}
+
+bool AVCapture::Start(const Settings &settings, uint64 startSampleTime, std::error_code &error) {
+    Stop();
+    error.clear();
+
+    m_videoEnabled = settings.videoPath.has_value();
+    m_audioEnabled = settings.audioPath.has_value();
+    m_frameRateNum = std::max<uint32>(settings.frameRateNum, 1);
+    m_frameRateDen = std::max<uint32>(settings.frameRateDen, 1);
+
+    if (m_videoEnabled) {
+        m_videoOut.open(*settings.videoPath, std::ios::binary | std::ios::trunc);
+        if (!m_videoOut) {
+            error.assign(errno, std::generic_category());
+            return false;
+        }
+    }
+    if (m_audioEnabled) {
+        m_audioOut.open(*settings.audioPath, std::ios::binary | std::ios::trunc);
+        if (!m_audioOut) {
+            error.assign(errno, std::generic_category());
+            m_videoOut.close();
+            return false;
+        }
+    }
+
+    m_audioPath = settings.audioPath.value_or(std::filesystem::path{});
+    m_startSampleTime = startSampleTime;
+    m_lastMarkTime = 0;
+    m_droppedSamples = 0;
+    m_audioLength = 0;
+    m_audioFileSize = 0;
+
+    m_statFramesReceived = 0;
+    m_statFramesDropped = 0;
+    m_statFramesWritten = 0;
+    m_statFramesDuplicated = 0;
+    m_statSamplesWritten = 0;
+    m_statSamplesDropped = 0;
+    m_writeError = false;
+
+    if (m_videoEnabled) {
+        m_videoThread = std::thread([&] { VideoWriterThread(); });
+    }
+    if (m_audioEnabled) {
+        m_audioThread = std::thread([&] { AudioWriterThread(); });
+    }
+    m_capturing = true;
+    return true;
+}
+
+void AVCapture::Stop() {
+    if (!m_capturing) {
+        return;
+    }
+    m_capturing = false;
+
+    if (m_videoEnabled) {
+        // Images rendered after the last frame marker fall outside of the capture
+        if (Frame *frame = m_latestFrame.exchange(nullptr)) {
+            m_statFramesDropped.fetch_add(1, std::memory_order_relaxed);
+            m_freeFrames.enqueue(frame);
+        }
+        m_pendingFrames.enqueue(FrameMarker{.frame = nullptr, .time = m_lastMarkTime, .end = true});
+        if (m_videoThread.joinable()) {
+            m_videoThread.join();
+        }
+        m_videoOut.close();
+    }
+
+    if (m_audioEnabled) {
+        if (m_audioBlock != nullptr) {
+            m_pendingAudioBlocks.enqueue(m_audioBlock);
+            m_audioBlock = nullptr;
+        }
+        m_audioLength = m_lastMarkTime;
+        m_pendingAudioBlocks.enqueue(nullptr);
+        if (m_audioThread.joinable()) {
+            m_audioThread.join();
+        }
+        m_audioOut.close();
+        if (m_audioFileSize != 0) {
+            // Drop excess samples past the end of the capture
+            std::error_code error{};
+            std::filesystem::resize_file(m_audioPath, m_audioFileSize, error);
+            if (error) {
+                m_writeError = true;
+            }
+        }
+    }
+}
+
+void AVCapture::ReceiveFrame(const uint32 *fb, uint32 width, uint32 height) {
+    if (!m_capturing || !m_videoEnabled) {
+        return;
+    }
+    m_statFramesReceived.fetch_add(1, std::memory_order_relaxed);
+
+    Frame *frame = nullptr;
+    if (!m_freeFrames.try_dequeue(frame)) {
+        std::unique_lock lock{m_frameAllocMutex};
+        if (m_frames.size() >= kMaxFrames) {
+            // Pool exhausted; the writer will repeat the previous image
+            m_statFramesDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        frame = m_frames.emplace_back(std::make_unique<Frame>()).get();
+    }
+
+    frame->pixels.assign(fb, fb + width * height);
+    frame->width = width;
+    frame->height = height;
+
+    if (Frame *prev = m_latestFrame.exchange(frame)) {
+        m_statFramesDropped.fetch_add(1, std::memory_order_relaxed);
+        m_freeFrames.enqueue(prev);
+    }
+}
+
+void AVCapture::ReceiveSamples(std::span<const scsp::OutputSample> samples) {
+    if (!m_capturing || !m_audioEnabled) {
+        return;
+    }
+
+    while (!samples.empty()) {
+        if (m_audioBlock == nullptr) {
+            m_audioBlock = AcquireAudioBlock();
+            if (m_audioBlock == nullptr) {
+                // Pool exhausted; replace the samples with silence
+                m_droppedSamples += samples.size();
+                m_statSamplesDropped.fetch_add(samples.size(), std::memory_order_relaxed);
+                return;
+            }
+            m_audioBlock->count = 0;
+            m_audioBlock->silenceBefore = m_droppedSamples;
+            m_droppedSamples = 0;
+        }
+
+        const size_t count = std::min<size_t>(samples.size(), kAudioBlockSize - m_audioBlock->count);
+        std::copy_n(samples.begin(), count, m_audioBlock->samples.begin() + m_audioBlock->count);
+        m_audioBlock->count += count;
+        samples = samples.subspan(count);
+
+        if (m_audioBlock->count == kAudioBlockSize) {
+            m_pendingAudioBlocks.enqueue(m_audioBlock);
+            m_audioBlock = nullptr;
+        }
+    }
+}
+
+void AVCapture::MarkFrame(uint64 sampleTime) {
+    if (!m_capturing) {
+        return;
+    }
+
+    m_lastMarkTime = sampleTime - m_startSampleTime;
+    if (m_videoEnabled) {
+        m_pendingFrames.enqueue(FrameMarker{.frame = m_latestFrame.exchange(nullptr), .time = m_lastMarkTime, .end = false});
+    }
+}
+
+AVCapture::Stats AVCapture::GetStats() const {
+    return {
+        .framesReceived = m_statFramesReceived.load(std::memory_order_relaxed),
+        .framesDropped = m_statFramesDropped.load(std::memory_order_relaxed),
+        .framesWritten = m_statFramesWritten.load(std::memory_order_relaxed),
+        .framesDuplicated = m_statFramesDuplicated.load(std::memory_order_relaxed),
+        .samplesWritten = m_statSamplesWritten.load(std::memory_order_relaxed),
+        .samplesDropped = m_statSamplesDropped.load(std::memory_order_relaxed),
+        .writeError = m_writeError.load(std::memory_order_relaxed),
+    };
+}
+
+// -----------------------------------------------------------------------------
+// Video
+
+// Converts an XBGR8888 image to full range BT.601 YCbCr 4:4:4 planes, scaling it to the output size with nearest
+// neighbor interpolation if necessary.
+static void ConvertImage(const uint32 *pixels, uint32 width, uint32 height, uint32 outWidth, uint32 outHeight,
+                         std::vector<uint8> &image) {
+    const size_t planeSize = static_cast<size_t>(outWidth) * outHeight;
+    uint8 *y = &image[0];
+    uint8 *cb = &image[planeSize];
+    uint8 *cr = &image[planeSize * 2];
+
+    for (uint32 oy = 0; oy < outHeight; ++oy) {
+        const uint32 *line = &pixels[static_cast<size_t>(oy * height / outHeight) * width];
+        for (uint32 ox = 0; ox < outWidth; ++ox) {
+            const uint32 color = width == outWidth ? line[ox] : line[ox * width / outWidth];
+            const sint32 r = color & 0xFF;
+            const sint32 g = (color >> 8u) & 0xFF;
+            const sint32 b = (color >> 16u) & 0xFF;
+            *y++ = (19595 * r + 38470 * g + 7471 * b + 32768) >> 16;
+            *cb++ = std::min((-11059 * r - 21709 * g + 32768 * b + (128 << 16) + 32768) >> 16, 255);
+            *cr++ = std::min((32768 * r - 27439 * g - 5329 * b + (128 << 16) + 32768) >> 16, 255);
+        }
+    }
+}
+
+void AVCapture::VideoWriterThread() {
+    util::SetCurrentThreadName("Video capture writer thread");
+
+    // Output frame k starts at k * slotLength samples, where slotLength = kSampleRate * den / num.
+    // The image of each emulated frame fills every output frame that starts before the end of the emulated frame.
+    const uint64 slotDivisor = kSampleRate * m_frameRateDen;
+    auto slotsBefore = [&](uint64 time) { return (time * m_frameRateNum + slotDivisor - 1) / slotDivisor; };
+
+    static constexpr char kFrameHeader[] = "FRAME\n";
+
+    uint32 outWidth = 0;
+    uint32 outHeight = 0;
+    std::vector<uint8> image;
+    bool hasImage = false;
+    bool freshImage = false;
+    uint64 slotsWritten = 0;
+
+    auto writeSlots = [&](uint64 slots) {
+        for (; slotsWritten < slots; ++slotsWritten) {
+            if (m_writeError.load(std::memory_order_relaxed)) {
+                return;
+            }
+            m_videoOut.write(kFrameHeader, sizeof(kFrameHeader) - 1);
+            m_videoOut.write(reinterpret_cast<const char *>(image.data()), image.size());
+            if (!m_videoOut) {
+                m_writeError = true;
+                return;
+            }
+            m_statFramesWritten.fetch_add(1, std::memory_order_relaxed);
+            if (!freshImage) {
+                m_statFramesDuplicated.fetch_add(1, std::memory_order_relaxed);
+            }
+            freshImage = false;
+        }
+    };
+
+    FrameMarker marker{};
+    while (true) {
+        m_pendingFrames.wait_dequeue(marker);
+
+        if (Frame *frame = marker.frame) {
+            if (!hasImage) {
+                // The first image determines the output size
+                outWidth = frame->width;
+                outHeight = frame->height;
+                image.resize(static_cast<size_t>(outWidth) * outHeight * 3);
+                const auto header = fmt::format("YUV4MPEG2 W{} H{} F{}:{} Ip A0:0 C444 XCOLORRANGE=FULL\n", outWidth,
+                                                outHeight, m_frameRateNum, m_frameRateDen);
+                m_videoOut.write(header.data(), header.size());
+                hasImage = true;
+            }
+            ConvertImage(frame->pixels.data(), frame->width, frame->height, outWidth, outHeight, image);
+            m_freeFrames.enqueue(frame);
+
+            if (freshImage) {
+                // The previous image didn't last long enough to fill an output frame
+                m_statFramesDropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            freshImage = true;
+        }
+
+        // Output frames preceding the first image are filled with that image
+        if (hasImage) {
+            writeSlots(slotsBefore(marker.time));
+        }
+
+        if (marker.end) {
+            break;
+        }
+    }
+    if (freshImage) {
+        m_statFramesDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    m_videoOut.flush();
+    if (!m_videoOut) {
+        m_writeError = true;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Audio
+
+AVCapture::AudioBlock *AVCapture::AcquireAudioBlock() {
+    AudioBlock *block = nullptr;
+    if (m_freeAudioBlocks.try_dequeue(block)) {
+        return block;
+    }
+    if (m_audioBlocks.size() < kMaxAudioBlocks) {
+        return m_audioBlocks.emplace_back(std::make_unique<AudioBlock>()).get();
+    }
+    return nullptr;
+}
+
+static constexpr uint64 kWAVHeaderSize = 44;
+
+// Writes a canonical WAV header for 16-bit stereo PCM
+static void WriteWAVHeader(std::ostream &out, uint64 sampleCount) {
+    const uint32 dataSize = static_cast<uint32>(std::min<uint64>(sampleCount * sizeof(scsp::OutputSample),
+                                                                 std::numeric_limits<uint32>::max() - 36));
+    auto write32 = [&](uint32 value) { out.write(reinterpret_cast<const char *>(&value), sizeof(value)); };
+    auto write16 = [&](uint16 value) { out.write(reinterpret_cast<const char *>(&value), sizeof(value)); };
+
+    out.write("RIFF", 4);
+    write32(36 + dataSize);
+    out.write("WAVEfmt ", 8);
+    write32(16);                                       // fmt chunk size
+    write16(1);                                        // PCM
+    write16(2);                                        // channels
+    write32(kSampleRate);                              // sample rate
+    write32(kSampleRate * sizeof(scsp::OutputSample)); // byte rate
+    write16(sizeof(scsp::OutputSample));               // block align
+    write16(16);                                       // bits per sample
+    out.write("data", 4);
+    write32(dataSize);
+}
+
+void AVCapture::AudioWriterThread() {
+    util::SetCurrentThreadName("Audio capture writer thread");
+
+    // Sizes are patched in once the capture ends
+    WriteWAVHeader(m_audioOut, 0);
+
+    static constexpr std::array<scsp::OutputSample, kAudioBlockSize> kSilence{};
+
+    uint64 samplesWritten = 0;
+    auto writeSilence = [&](uint64 count) {
+        while (count > 0) {
+            const size_t chunk = std::min<uint64>(count, kSilence.size());
+            m_audioOut.write(reinterpret_cast<const char *>(kSilence.data()), chunk * sizeof(scsp::OutputSample));
+            samplesWritten += chunk;
+            m_statSamplesWritten.fetch_add(chunk, std::memory_order_relaxed);
+            count -= chunk;
+        }
+    };
+
+    AudioBlock *block = nullptr;
+    while (true) {
+        m_pendingAudioBlocks.wait_dequeue(block);
+        if (block == nullptr) {
+            break;
+        }
+
+        if (!m_writeError.load(std::memory_order_relaxed)) {
+            writeSilence(block->silenceBefore);
+            m_audioOut.write(reinterpret_cast<const char *>(block->samples.data()),
+                             block->count * sizeof(scsp::OutputSample));
+            samplesWritten += block->count;
+            m_statSamplesWritten.fetch_add(block->count, std::memory_order_relaxed);
+            if (!m_audioOut) {
+                m_writeError = true;
+            }
+        }
+
+        m_freeAudioBlocks.enqueue(block);
+    }
+
+    // Match the length of the video stream, padding with silence or dropping excess samples
+    const uint64 length = m_audioLength;
+    if (samplesWritten < length) {
+        writeSilence(length - samplesWritten);
+    } else if (samplesWritten > length) {
+        m_statSamplesWritten.fetch_sub(samplesWritten - length, std::memory_order_relaxed);
+        m_audioFileSize = kWAVHeaderSize + length * sizeof(scsp::OutputSample);
+    }
+    m_audioOut.seekp(0);
+    WriteWAVHeader(m_audioOut, length);
+    m_audioOut.flush();
+    if (!m_audioOut) {
+        m_writeError = true;
+    }
+}
+
+} // namespace ymir::debug
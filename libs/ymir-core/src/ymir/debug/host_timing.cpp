@@ -0,0 +1,101 @@
+#include <ymir/debug/host_timing.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+namespace ymir::debug {
+
+std::string_view GetHostTimingComponentName(HostTimingComponent component) {
+    switch (component) {
+    case HostTimingComponent::SH2: return "SH-2";
+    case HostTimingComponent::SCU: return "SCU";
+    case HostTimingComponent::VDP1: return "VDP1";
+    case HostTimingComponent::VDP2: return "VDP2";
+    case HostTimingComponent::SCSP: return "SCSP";
+    case HostTimingComponent::CDBlock: return "CD Block";
+    case HostTimingComponent::SH1: return "SH-1";
+    default: return "?";
+    }
+}
+
+void HostTimingStats::EndFrame() {
+    const uint64 nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now().time_since_epoch())
+                             .count();
+    EndFrame(ReadHostTicks(), nanos);
+}
+
+void HostTimingStats::EndFrame(uint64 ticks, uint64 nanos) {
+    if (!m_started) {
+        // Establish the baseline; anything accumulated so far cannot be attributed to a measured frame
+        m_started = true;
+        m_lastTicks = ticks;
+        m_lastNanos = nanos;
+        for (auto &accum : m_accum) {
+            accum.store(0, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    const uint64 deltaTicks = ticks - m_lastTicks;
+    const uint64 deltaNanos = nanos - m_lastNanos;
+    m_lastTicks = ticks;
+    m_lastNanos = nanos;
+    if (deltaTicks > 0) {
+        m_msPerTick = static_cast<double>(deltaNanos) / static_cast<double>(deltaTicks) * 1e-6;
+    }
+
+    const double frameMs = static_cast<double>(deltaNanos) * 1e-6;
+    m_lastFrameMs.store(frameMs, std::memory_order_relaxed);
+    m_totalFrameMs.store(m_totalFrameMs.load(std::memory_order_relaxed) + frameMs, std::memory_order_relaxed);
+    m_maxFrameMs.store(std::max(m_maxFrameMs.load(std::memory_order_relaxed), frameMs), std::memory_order_relaxed);
+
+    for (size_t i = 0; i < kNumHostTimingComponents; ++i) {
+        const uint64 componentTicks = m_accum[i].exchange(0, std::memory_order_relaxed);
+        const double componentMs = static_cast<double>(componentTicks) * m_msPerTick;
+        m_lastComponentMs[i].store(componentMs, std::memory_order_relaxed);
+        m_totalComponentMs[i].store(m_totalComponentMs[i].load(std::memory_order_relaxed) + componentMs,
+                                    std::memory_order_relaxed);
+        m_maxComponentMs[i].store(std::max(m_maxComponentMs[i].load(std::memory_order_relaxed), componentMs),
+                                  std::memory_order_relaxed);
+    }
+
+    m_totalFrames.fetch_add(1, std::memory_order_release);
+}
+
+void HostTimingStats::ResetTotals() {
+    m_started = false;
+    m_totalFrames.store(0, std::memory_order_relaxed);
+    m_totalFrameMs.store(0.0, std::memory_order_relaxed);
+    m_maxFrameMs.store(0.0, std::memory_order_relaxed);
+    for (size_t i = 0; i < kNumHostTimingComponents; ++i) {
+        m_totalComponentMs[i].store(0.0, std::memory_order_relaxed);
+        m_maxComponentMs[i].store(0.0, std::memory_order_relaxed);
+    }
+}
+
+HostTimingReport HostTimingStats::GetLastFrame() const {
+    HostTimingReport report{};
+    report.frames = m_totalFrames.load(std::memory_order_acquire) > 0 ? 1 : 0;
+    report.frameTimeMs = m_lastFrameMs.load(std::memory_order_relaxed);
+    report.maxFrameTimeMs = report.frameTimeMs;
+    for (size_t i = 0; i < kNumHostTimingComponents; ++i) {
+        report.componentTimeMs[i] = m_lastComponentMs[i].load(std::memory_order_relaxed);
+        report.maxComponentTimeMs[i] = report.componentTimeMs[i];
+    }
+    return report;
+}
+
+HostTimingReport HostTimingStats::GetTotals() const {
+    HostTimingReport report{};
+    report.frames = m_totalFrames.load(std::memory_order_acquire);
+    report.frameTimeMs = m_totalFrameMs.load(std::memory_order_relaxed);
+    report.maxFrameTimeMs = m_maxFrameMs.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kNumHostTimingComponents; ++i) {
+        report.componentTimeMs[i] = m_totalComponentMs[i].load(std::memory_order_relaxed);
+        report.maxComponentTimeMs[i] = m_maxComponentMs[i].load(std::memory_order_relaxed);
+    }
+    return report;
+}
+
+} // namespace ymir::debug
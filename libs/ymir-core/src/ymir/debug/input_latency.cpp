@@ -0,0 +1,68 @@
+#include <ymir/debug/input_latency.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace ymir::debug {
+
+uint64 InputLatencyReport::PercentileNs(double fraction) const {
+    if (count == 0) {
+        return 0;
+    }
+    const double target = std::clamp(fraction, 0.0, 1.0) * count;
+    uint64 accum = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        accum += buckets[i];
+        if (accum > 0 && accum >= target) {
+            return std::min(GetInputLatencyBucketUpperBoundNs(i), maxNs);
+        }
+    }
+    return maxNs;
+}
+
+uint64 GetInputLatencyBucketUpperBoundNs(size_t bucket) {
+    if (bucket >= kNumInputLatencyBuckets - 1) {
+        return ~0ull;
+    }
+    return (1ull << bucket) * 1000ull;
+}
+
+void InputLatencyHistogram::Record(uint64 latencyNs) {
+    const uint64 latencyUs = latencyNs / 1000ull;
+    const size_t bucket = std::min<size_t>(std::bit_width(latencyUs), kNumInputLatencyBuckets - 1);
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_totalNs.fetch_add(latencyNs, std::memory_order_relaxed);
+
+    // Only the emulator thread records samples, so plain compare-and-store is enough
+    if (latencyNs < m_minNs.load(std::memory_order_relaxed)) {
+        m_minNs.store(latencyNs, std::memory_order_relaxed);
+    }
+    if (latencyNs > m_maxNs.load(std::memory_order_relaxed)) {
+        m_maxNs.store(latencyNs, std::memory_order_relaxed);
+    }
+}
+
+void InputLatencyHistogram::Reset() {
+    for (auto &bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_totalNs.store(0, std::memory_order_relaxed);
+    m_minNs.store(~0ull, std::memory_order_relaxed);
+    m_maxNs.store(0, std::memory_order_relaxed);
+}
+
+InputLatencyReport InputLatencyHistogram::GetReport() const {
+    InputLatencyReport report{};
+    for (size_t i = 0; i < m_buckets.size(); ++i) {
+        report.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    }
+    report.count = m_count.load(std::memory_order_relaxed);
+    report.totalNs = m_totalNs.load(std::memory_order_relaxed);
+    report.minNs = report.count > 0 ? m_minNs.load(std::memory_order_relaxed) : 0;
+    report.maxNs = m_maxNs.load(std::memory_order_relaxed);
+    return report;
+}
+
+} // namespace ymir::debug
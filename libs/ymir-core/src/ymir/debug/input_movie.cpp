@@ -0,0 +1,423 @@
+#include <ymir/debug/input_movie.hpp>
+
+#include <ymir/savestate/savestate.hpp>
+#include <ymir/savestate/savestate_binary.hpp>
+#include <ymir/sys/saturn.hpp>
+
+#include <xxh3.h>
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+namespace ymir::debug {
+
+// "YMOV" in little-endian byte order
+static constexpr uint32 kMagic = 0x564F4D59;
+static constexpr uint32 kFormatVersion = 1;
+
+static constexpr size_t kFrameRecordSize = sizeof(uint16) * kNumMoviePorts + sizeof(XXH128Hash);
+
+// -----------------------------------------------------------------------------
+// File format
+
+bool WriteInputMovie(const std::filesystem::path &path, const InputMovie &movie, std::error_code &error) {
+    error.clear();
+
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+    if (!out) {
+        error.assign(errno, std::generic_category());
+        return false;
+    }
+
+    auto write = [&]<typename T>(T value) { out.write(reinterpret_cast<const char *>(&value), sizeof(value)); };
+
+    const auto &settings = movie.settings;
+    write(kMagic);
+    write(kFormatVersion);
+    write(static_cast<uint32>(sizeof(peripheral::PeripheralReport)));
+    write(static_cast<uint8>(settings.videoStandard));
+    write(settings.areaCode);
+    write(static_cast<uint8>(settings.emulateSH2Cache));
+    write(settings.cdReadSpeedFactor);
+    write(settings.sh2ClockFactorNum);
+    write(settings.sh2ClockFactorDen);
+    write(settings.rtcTimestamp);
+    for (peripheral::PeripheralType type : settings.ports) {
+        write(static_cast<uint8>(type));
+    }
+
+    write(static_cast<uint32>(movie.gamePath.size()));
+    out.write(movie.gamePath.data(), movie.gamePath.size());
+
+    write(static_cast<uint64>(movie.frames.size()));
+    write(static_cast<uint64>(movie.reports.size()));
+    write(static_cast<uint64>(movie.startState.size()));
+
+    for (const InputMovie::Frame &frame : movie.frames) {
+        for (uint16 reads : frame.reads) {
+            write(reads);
+        }
+        out.write(reinterpret_cast<const char *>(frame.hash.data()), frame.hash.size());
+    }
+    out.write(reinterpret_cast<const char *>(movie.reports.data()),
+              movie.reports.size() * sizeof(peripheral::PeripheralReport));
+    out.write(reinterpret_cast<const char *>(movie.startState.data()), movie.startState.size());
+
+    out.flush();
+    if (!out) {
+        error.assign(errno, std::generic_category());
+        return false;
+    }
+    return true;
+}
+
+InputMovieReadResult ReadInputMovie(const std::filesystem::path &path, InputMovie &movie, std::error_code &error) {
+    error.clear();
+
+    const uint64 fileSize = std::filesystem::file_size(path, error);
+    if (error) {
+        return InputMovieReadResult::FilesystemError;
+    }
+    std::ifstream in{path, std::ios::binary};
+    if (!in) {
+        error.assign(errno, std::generic_category());
+        return InputMovieReadResult::FilesystemError;
+    }
+
+    auto read = [&]<typename T>(T &value) { in.read(reinterpret_cast<char *>(&value), sizeof(value)); };
+
+    uint32 magic = 0;
+    uint32 version = 0;
+    uint32 reportSize = 0;
+    read(magic);
+    if (!in || magic != kMagic) {
+        return InputMovieReadResult::InvalidFormat;
+    }
+    read(version);
+    if (!in) {
+        return InputMovieReadResult::Truncated;
+    }
+    if (version != kFormatVersion) {
+        return InputMovieReadResult::VersionMismatch;
+    }
+    read(reportSize);
+    if (!in) {
+        return InputMovieReadResult::Truncated;
+    }
+    if (reportSize != sizeof(peripheral::PeripheralReport)) {
+        return InputMovieReadResult::LayoutMismatch;
+    }
+
+    InputMovie::Settings settings{};
+    uint8 videoStandard = 0;
+    uint8 emulateSH2Cache = 0;
+    std::array<uint8, kNumMoviePorts> ports{};
+    read(videoStandard);
+    read(settings.areaCode);
+    read(emulateSH2Cache);
+    read(settings.cdReadSpeedFactor);
+    read(settings.sh2ClockFactorNum);
+    read(settings.sh2ClockFactorDen);
+    read(settings.rtcTimestamp);
+    for (uint8 &type : ports) {
+        read(type);
+    }
+    if (!in) {
+        return InputMovieReadResult::Truncated;
+    }
+    if (videoStandard > static_cast<uint8>(core::config::sys::VideoStandard::PAL)) {
+        return InputMovieReadResult::InvalidFormat;
+    }
+    settings.videoStandard = static_cast<core::config::sys::VideoStandard>(videoStandard);
+    settings.emulateSH2Cache = emulateSH2Cache != 0;
+    for (size_t i = 0; i < kNumMoviePorts; ++i) {
+        if (ports[i] > static_cast<uint8>(peripheral::PeripheralType::ShuttleMouse)) {
+            return InputMovieReadResult::InvalidFormat;
+        }
+        settings.ports[i] = static_cast<peripheral::PeripheralType>(ports[i]);
+    }
+
+    uint32 gamePathSize = 0;
+    read(gamePathSize);
+    if (!in || gamePathSize > fileSize) {
+        return InputMovieReadResult::Truncated;
+    }
+    std::string gamePath(gamePathSize, '\0');
+    in.read(gamePath.data(), gamePathSize);
+
+    uint64 frameCount = 0;
+    uint64 reportCount = 0;
+    uint64 startStateSize = 0;
+    read(frameCount);
+    read(reportCount);
+    read(startStateSize);
+    if (!in) {
+        return InputMovieReadResult::Truncated;
+    }
+
+    // Check sizes against the file before allocating anything
+    const uint64 offset = static_cast<uint64>(in.tellg());
+    const uint64 remaining = fileSize - std::min(offset, fileSize);
+    if (frameCount > remaining / kFrameRecordSize || reportCount > remaining / reportSize ||
+        frameCount * kFrameRecordSize + reportCount * reportSize + startStateSize > remaining) {
+        return InputMovieReadResult::Truncated;
+    }
+
+    std::vector<InputMovie::Frame> frames(frameCount);
+    uint64 totalReads = 0;
+    for (InputMovie::Frame &frame : frames) {
+        for (uint16 &reads : frame.reads) {
+            read(reads);
+            totalReads += reads;
+        }
+        in.read(reinterpret_cast<char *>(frame.hash.data()), frame.hash.size());
+    }
+    if (totalReads != reportCount) {
+        return InputMovieReadResult::InvalidFormat;
+    }
+
+    std::vector<peripheral::PeripheralReport> reports(reportCount);
+    in.read(reinterpret_cast<char *>(reports.data()), reportCount * reportSize);
+
+    std::vector<uint8> startState(startStateSize);
+    in.read(reinterpret_cast<char *>(startState.data()), startStateSize);
+    if (!in) {
+        return InputMovieReadResult::Truncated;
+    }
+
+    movie.settings = settings;
+    movie.gamePath = std::move(gamePath);
+    movie.frames = std::move(frames);
+    movie.reports = std::move(reports);
+    movie.startState = std::move(startState);
+    return InputMovieReadResult::Success;
+}
+
+// -----------------------------------------------------------------------------
+// Determinism hash
+
+DeterminismHasher::DeterminismHasher()
+    : m_sh2State(std::make_unique<savestate::SH2SaveState>())
+    , m_vdpState(std::make_unique<savestate::VDPSaveState>())
+    , m_scspState(std::make_unique<savestate::SCSPSaveState>()) {}
+
+DeterminismHasher::~DeterminismHasher() = default;
+
+XXH128Hash DeterminismHasher::Calc(Saturn &saturn) {
+    XXH3_state_t *state = XXH3_createState();
+    XXH3_128bits_reset(state);
+
+    auto update = [&](const auto &value) { XXH3_128bits_update(state, &value, sizeof(value)); };
+
+    update(saturn.mem.WRAMLow);
+    update(saturn.mem.WRAMHigh);
+
+    // Registers are hashed individually to skip padding bytes
+    for (const sh2::SH2 *sh2 : {&saturn.masterSH2, &saturn.slaveSH2}) {
+        sh2->SaveState(*m_sh2State);
+        update(m_sh2State->R);
+        update(m_sh2State->PC);
+        update(m_sh2State->PR);
+        update(m_sh2State->SR);
+        update(m_sh2State->GBR);
+        update(m_sh2State->VBR);
+        update(m_sh2State->MACH);
+        update(m_sh2State->MACL);
+    }
+
+    saturn.VDP.SaveState(*m_vdpState);
+    update(m_vdpState->VRAM1);
+    update(m_vdpState->VRAM2);
+    update(m_vdpState->CRAM);
+
+    saturn.SCSP.SaveState(*m_scspState);
+    update(m_scspState->WRAM);
+    update(m_scspState->m68k.DA);
+    update(m_scspState->m68k.PC);
+    update(m_scspState->m68k.SR);
+
+    const XXH128_hash_t hash = XXH3_128bits_digest(state);
+    XXH3_freeState(state);
+
+    XXH128_canonical_t canonicalHash{};
+    XXH128_canonicalFromHash(&canonicalHash, hash);
+    XXH128Hash out{};
+    std::copy_n(canonicalHash.digest, out.size(), out.begin());
+    return out;
+}
+
+// -----------------------------------------------------------------------------
+// Settings
+
+// Applies the settings of a movie to the system. Does not reset the system.
+static void ApplySettings(Saturn &saturn, const InputMovie::Settings &settings) {
+    auto &config = saturn.configuration;
+    config.system.videoStandard = settings.videoStandard;
+    config.system.emulateSH2Cache = settings.emulateSH2Cache;
+    config.system.sh2ClockFactor = RatioU32{settings.sh2ClockFactorNum, settings.sh2ClockFactorDen};
+    config.cdblock.readSpeedFactor = settings.cdReadSpeedFactor;
+    config.rtc.mode = core::config::rtc::Mode::Virtual;
+    config.rtc.virtHardResetStrategy = core::config::rtc::HardResetStrategy::ResetToFixedTime;
+    config.rtc.virtHardResetTimestamp = settings.rtcTimestamp;
+    saturn.SMPC.SetAreaCode(settings.areaCode);
+}
+
+static peripheral::PeripheralPort &GetPort(Saturn &saturn, uint32 port) {
+    return port == 0 ? saturn.SMPC.GetPeripheralPort1() : saturn.SMPC.GetPeripheralPort2();
+}
+
+// -----------------------------------------------------------------------------
+// Recorder
+
+void InputMovieRecorder::Begin(Saturn &saturn, bool powerOn, std::string gamePath) {
+    const auto &config = saturn.configuration;
+
+    m_movie = {};
+    auto &settings = m_movie.settings;
+    settings.videoStandard = *config.system.videoStandard;
+    settings.areaCode = saturn.SMPC.GetAreaCode();
+    settings.emulateSH2Cache = *config.system.emulateSH2Cache;
+    settings.cdReadSpeedFactor = *config.cdblock.readSpeedFactor;
+    settings.sh2ClockFactorNum = config.system.sh2ClockFactor->Numerator();
+    settings.sh2ClockFactorDen = config.system.sh2ClockFactor->Denominator();
+    settings.rtcTimestamp = config.rtc.virtHardResetTimestamp;
+    for (uint32 port = 0; port < kNumMoviePorts; ++port) {
+        settings.ports[port] = GetPort(saturn, port).GetPeripheral().GetType();
+    }
+    m_movie.gamePath = std::move(gamePath);
+
+    ApplySettings(saturn, settings);
+    if (powerOn) {
+        saturn.Reset(true);
+    } else {
+        auto state = std::make_unique<savestate::SaveState>();
+        saturn.SaveState(*state);
+        savestate::binary::Write(*state, m_movie.startState);
+    }
+
+    m_frame = {};
+    for (auto &reports : m_frameReports) {
+        reports.clear();
+    }
+}
+
+void InputMovieRecorder::RecordRead(uint32 port, const peripheral::PeripheralReport &report) {
+    if (port < kNumMoviePorts && m_frameReports[port].size() < std::numeric_limits<uint16>::max()) {
+        m_frameReports[port].push_back(report);
+    }
+}
+
+void InputMovieRecorder::EndFrame(Saturn &saturn) {
+    for (uint32 port = 0; port < kNumMoviePorts; ++port) {
+        auto &reports = m_frameReports[port];
+        m_frame.reads[port] = reports.size();
+        m_movie.reports.insert(m_movie.reports.end(), reports.begin(), reports.end());
+        reports.clear();
+    }
+    m_frame.hash = m_hasher.Calc(saturn);
+    m_movie.frames.push_back(m_frame);
+}
+
+// -----------------------------------------------------------------------------
+// Player
+
+InputMoviePlayer::BeginResult InputMoviePlayer::Begin(Saturn &saturn, const InputMovie &movie) {
+    m_movie = &movie;
+    m_frameIndex = 0;
+    m_frameReportBase = 0;
+    m_portReads.fill(0);
+    m_lastReports.fill(std::nullopt);
+    m_firstDivergentFrame = std::nullopt;
+    m_readMismatches = 0;
+
+    ApplySettings(saturn, movie.settings);
+    if (movie.startState.empty()) {
+        saturn.Reset(true);
+    } else {
+        auto state = std::make_unique<savestate::SaveState>();
+        if (savestate::binary::Read(movie.startState, *state) != savestate::binary::ReadResult::Success) {
+            m_movie = nullptr;
+            return BeginResult::InvalidState;
+        }
+        if (!saturn.LoadState(*state)) {
+            m_movie = nullptr;
+            return BeginResult::IncompatibleState;
+        }
+    }
+
+    auto &port1 = saturn.SMPC.GetPeripheralPort1();
+    auto &port2 = saturn.SMPC.GetPeripheralPort2();
+    port1.SetPeripheralReportCallback({this, [](peripheral::PeripheralReport &report, void *ctx) {
+                                           static_cast<InputMoviePlayer *>(ctx)->ReadReport(0, report);
+                                       }});
+    port2.SetPeripheralReportCallback({this, [](peripheral::PeripheralReport &report, void *ctx) {
+                                           static_cast<InputMoviePlayer *>(ctx)->ReadReport(1, report);
+                                       }});
+    for (uint32 port = 0; port < kNumMoviePorts; ++port) {
+        auto &periphPort = GetPort(saturn, port);
+        switch (movie.settings.ports[port]) {
+        case peripheral::PeripheralType::None: periphPort.DisconnectPeripherals(); break;
+        case peripheral::PeripheralType::ControlPad: periphPort.ConnectControlPad(); break;
+        case peripheral::PeripheralType::AnalogPad: periphPort.ConnectAnalogPad(); break;
+        case peripheral::PeripheralType::ArcadeRacer: periphPort.ConnectArcadeRacer(); break;
+        case peripheral::PeripheralType::MissionStick: periphPort.ConnectMissionStick(); break;
+        case peripheral::PeripheralType::VirtuaGun: periphPort.ConnectVirtuaGun(); break;
+        case peripheral::PeripheralType::ShuttleMouse: periphPort.ConnectShuttleMouse(); break;
+        }
+    }
+
+    return BeginResult::Success;
+}
+
+bool InputMoviePlayer::EndFrame(Saturn &saturn) {
+    if (IsFinished()) {
+        return true;
+    }
+
+    const InputMovie::Frame &frame = m_movie->frames[m_frameIndex];
+    for (uint32 port = 0; port < kNumMoviePorts; ++port) {
+        m_readMismatches += frame.reads[port] - m_portReads[port];
+        m_frameReportBase += frame.reads[port];
+    }
+    m_portReads.fill(0);
+
+    const bool match = m_hasher.Calc(saturn) == frame.hash;
+    if (!match && !m_firstDivergentFrame) {
+        m_firstDivergentFrame = m_frameIndex;
+    }
+    ++m_frameIndex;
+    return match;
+}
+
+void InputMoviePlayer::End(Saturn &saturn) {
+    for (uint32 port = 0; port < kNumMoviePorts; ++port) {
+        auto &periphPort = GetPort(saturn, port);
+        periphPort.DisconnectPeripherals();
+        periphPort.SetPeripheralReportCallback({});
+    }
+    m_movie = nullptr;
+}
+
+void InputMoviePlayer::ReadReport(uint32 port, peripheral::PeripheralReport &report) {
+    if (port >= kNumMoviePorts) {
+        return;
+    }
+
+    if (!IsFinished()) {
+        const InputMovie::Frame &frame = m_movie->frames[m_frameIndex];
+        if (m_portReads[port] < frame.reads[port]) {
+            const uint64 index = m_frameReportBase + (port == 1 ? frame.reads[0] : 0) + m_portReads[port]++;
+            m_lastReports[port] = m_movie->reports[index];
+        } else {
+            ++m_readMismatches;
+        }
+    }
+
+    // Reads past the end of the recorded frame or the movie repeat the last report
+    if (m_lastReports[port] && m_lastReports[port]->type == report.type) {
+        report.report = m_lastReports[port]->report;
+    }
+}
+
+} // namespace ymir::debug
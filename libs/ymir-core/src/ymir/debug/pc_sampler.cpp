@@ -0,0 +1,165 @@
+#include <ymir/debug/pc_sampler.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+namespace ymir::debug {
+
+std::string_view GetProfiledCPUName(ProfiledCPU cpu) {
+    switch (cpu) {
+    case ProfiledCPU::MasterSH2: return "MSH2";
+    case ProfiledCPU::SlaveSH2: return "SSH2";
+    case ProfiledCPU::M68K: return "M68K";
+    case ProfiledCPU::SH1: return "SH1";
+    default: return "?";
+    }
+}
+
+void PCSampler::SetInterval(uint64 cycles) {
+    m_interval.store(std::max<uint64>(cycles, 1), std::memory_order_relaxed);
+}
+
+void PCSampler::Flush() {
+    if (m_recordBlock == nullptr || m_recordBlock->count == 0) {
+        return;
+    }
+    m_pendingBlocks.enqueue(m_recordBlock);
+    m_recordBlock = nullptr;
+
+    // Nobody is reading the reports; keep memory bounded without ever blocking the recording thread
+    if (m_pendingBlocks.size_approx() >= kMaxPendingBlocks) [[unlikely]] {
+        std::unique_lock lock{m_mutex, std::try_to_lock};
+        if (lock) {
+            DrainPendingBlocks(false);
+        }
+    }
+}
+
+void PCSampler::Aggregate() {
+    std::unique_lock lock{m_mutex};
+    DrainPendingBlocks(false);
+}
+
+PCSampler::SampleBlock *PCSampler::AcquireBlock() {
+    SampleBlock *block = nullptr;
+    if (m_freeBlocks.try_dequeue(block)) {
+        return block;
+    }
+    std::unique_lock lock{m_blockAllocMutex};
+    return m_blocks.emplace_back(std::make_unique<SampleBlock>()).get();
+}
+
+void PCSampler::DrainPendingBlocks(bool discard) const {
+    SampleBlock *block = nullptr;
+    while (m_pendingBlocks.try_dequeue(block)) {
+        if (!discard) {
+            for (size_t sampleIndex = 0; sampleIndex < block->count; ++sampleIndex) {
+                const Sample &sample = block->samples[sampleIndex];
+                for (size_t i = 0; i < kNumProfiledCPUs; ++i) {
+                    if (!sample.snapshot.active[i]) {
+                        continue;
+                    }
+                    uint32 pc = sample.snapshot.pc[i];
+                    const auto cpu = static_cast<ProfiledCPU>(i);
+                    if (cpu == ProfiledCPU::MasterSH2 || cpu == ProfiledCPU::SlaveSH2) {
+                        pc &= 0x07FFFFFF;
+                    }
+                    CPUProfile &profile = m_profiles[i];
+                    profile.histogram[pc] += sample.weight;
+                    profile.totalSamples += sample.weight;
+                }
+            }
+        }
+        block->count = 0;
+        m_freeBlocks.enqueue(block);
+    }
+}
+
+void PCSampler::Clear() {
+    std::unique_lock lock{m_mutex};
+    DrainPendingBlocks(true);
+    for (CPUProfile &profile : m_profiles) {
+        profile.histogram.clear();
+        profile.totalSamples = 0;
+    }
+}
+
+void PCSampler::SetSymbolMap(ProfiledCPU cpu, std::shared_ptr<const SymbolMap> symbols) {
+    std::unique_lock lock{m_mutex};
+    m_profiles[static_cast<size_t>(cpu)].symbols = std::move(symbols);
+}
+
+uint64 PCSampler::GetTotalSamples(ProfiledCPU cpu) const {
+    std::unique_lock lock{m_mutex};
+    DrainPendingBlocks(false);
+    return m_profiles[static_cast<size_t>(cpu)].totalSamples;
+}
+
+std::vector<PCSampler::HotSpot> PCSampler::GetHotSpots(ProfiledCPU cpu, bool byFunction, size_t maxEntries) const {
+    std::vector<HotSpot> hotSpots{};
+    {
+        std::unique_lock lock{m_mutex};
+        DrainPendingBlocks(false);
+        hotSpots = BuildHotSpots(m_profiles[static_cast<size_t>(cpu)], byFunction);
+    }
+    std::sort(hotSpots.begin(), hotSpots.end(), [](const HotSpot &lhs, const HotSpot &rhs) {
+        return lhs.samples != rhs.samples ? lhs.samples > rhs.samples : lhs.address < rhs.address;
+    });
+    if (hotSpots.size() > maxEntries) {
+        hotSpots.resize(maxEntries);
+    }
+    return hotSpots;
+}
+
+void PCSampler::WriteCollapsedStacks(std::ostream &out) const {
+    std::unique_lock lock{m_mutex};
+    DrainPendingBlocks(false);
+    for (size_t i = 0; i < kNumProfiledCPUs; ++i) {
+        const std::string_view cpuName = GetProfiledCPUName(static_cast<ProfiledCPU>(i));
+        std::vector<HotSpot> hotSpots = BuildHotSpots(m_profiles[i], true);
+        std::sort(hotSpots.begin(), hotSpots.end(),
+                  [](const HotSpot &lhs, const HotSpot &rhs) { return lhs.address < rhs.address; });
+        for (const HotSpot &hotSpot : hotSpots) {
+            if (hotSpot.name.empty()) {
+                out << fmt::format("{};{:08X} {}\n", cpuName, hotSpot.address, hotSpot.samples);
+            } else {
+                out << fmt::format("{};{} {}\n", cpuName, hotSpot.name, hotSpot.samples);
+            }
+        }
+    }
+}
+
+std::vector<PCSampler::HotSpot> PCSampler::BuildHotSpots(const CPUProfile &profile, bool byFunction) const {
+    std::vector<HotSpot> hotSpots{};
+    const SymbolMap *symbols = profile.symbols.get();
+
+    if (!byFunction || symbols == nullptr || symbols->IsEmpty()) {
+        hotSpots.reserve(profile.histogram.size());
+        for (const auto &[address, samples] : profile.histogram) {
+            const SymbolMap::Symbol *symbol = symbols != nullptr ? symbols->Find(address) : nullptr;
+            hotSpots.push_back({
+                .address = address,
+                .name = symbol != nullptr ? symbol->name : std::string{},
+                .samples = samples,
+            });
+        }
+        return hotSpots;
+    }
+
+    // Aggregate by function. Addresses not covered by any symbol are kept as is.
+    std::unordered_map<const SymbolMap::Symbol *, uint64> functionSamples{};
+    for (const auto &[address, samples] : profile.histogram) {
+        if (const SymbolMap::Symbol *symbol = symbols->Find(address)) {
+            functionSamples[symbol] += samples;
+        } else {
+            hotSpots.push_back({.address = address, .name = {}, .samples = samples});
+        }
+    }
+    for (const auto &[symbol, samples] : functionSamples) {
+        hotSpots.push_back({.address = symbol->address, .name = symbol->name, .samples = samples});
+    }
+    return hotSpots;
+}
+
+} // namespace ymir::debug
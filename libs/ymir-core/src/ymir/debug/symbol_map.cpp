@@ -0,0 +1,87 @@
+#include <ymir/debug/symbol_map.hpp>
+
+#include <charconv>
+#include <fstream>
+#include <iterator>
+
+namespace ymir::debug {
+
+bool SymbolMap::Load(const std::filesystem::path &path, std::error_code &error) {
+    error.clear();
+
+    std::ifstream in{path};
+    if (!in) {
+        error.assign(errno, std::generic_category());
+        return false;
+    }
+    Parse(in);
+    if (in.bad()) {
+        error.assign(errno, std::generic_category());
+        return false;
+    }
+    return true;
+}
+
+size_t SymbolMap::Parse(std::istream &in) {
+    m_symbols.clear();
+
+    auto isSpace = [](char ch) { return ch == ' ' || ch == '\t' || ch == '\r'; };
+    auto nextToken = [&](std::string_view &line) {
+        size_t start = 0;
+        while (start < line.size() && isSpace(line[start])) {
+            ++start;
+        }
+        size_t end = start;
+        while (end < line.size() && !isSpace(line[end])) {
+            ++end;
+        }
+        const std::string_view token = line.substr(start, end - start);
+        line.remove_prefix(end);
+        return token;
+    };
+
+    std::string lineBuf{};
+    while (std::getline(in, lineBuf)) {
+        std::string_view line = lineBuf;
+
+        std::string_view addrToken = nextToken(line);
+        if (addrToken.empty() || addrToken.starts_with('#') || addrToken.starts_with(';')) {
+            continue;
+        }
+        if (addrToken.starts_with("0x") || addrToken.starts_with("0X")) {
+            addrToken.remove_prefix(2);
+        }
+        uint32 address{};
+        const auto [ptr, ec] = std::from_chars(addrToken.data(), addrToken.data() + addrToken.size(), address, 16);
+        if (ec != std::errc{} || ptr != addrToken.data() + addrToken.size()) {
+            continue;
+        }
+
+        std::string_view name = nextToken(line);
+        if (name.size() == 1) {
+            // nm-style symbol type
+            if (std::string_view actualName = nextToken(line); !actualName.empty()) {
+                name = actualName;
+            }
+        }
+        if (name.empty()) {
+            continue;
+        }
+        Add(address, name);
+    }
+    return m_symbols.size();
+}
+
+void SymbolMap::Add(uint32 address, std::string_view name) {
+    m_symbols.insert_or_assign(address, Symbol{.address = address, .name = std::string{name}});
+}
+
+const SymbolMap::Symbol *SymbolMap::Find(uint32 address) const {
+    auto it = m_symbols.upper_bound(address);
+    if (it == m_symbols.begin()) {
+        return nullptr;
+    }
+    return &std::prev(it)->second;
+}
+
+} // namespace ymir::debug
@@ -0,0 +1,174 @@
+#include <ymir/debug/trace_reader.hpp>
+
+#include <ymir/hw/sh2/sh2_intc.hpp>
+
+#include <fmt/format.h>
+
+#include <lz4.h>
+
+namespace ymir::debug::trace {
+
+ReadResult TraceReader::Open(const std::filesystem::path &path, std::error_code &error) {
+    error.clear();
+
+    m_in.close();
+    m_in.clear();
+    m_in.open(path, std::ios::binary);
+    if (!m_in) {
+        error.assign(errno, std::generic_category());
+        return ReadResult::FilesystemError;
+    }
+
+    FileHeader header{};
+    m_in.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (m_in.gcount() != sizeof(header) || header.magic != kMagic) {
+        return ReadResult::InvalidFormat;
+    }
+    if (header.version != kFormatVersion) {
+        return ReadResult::VersionMismatch;
+    }
+    if (header.maxChunkSize == 0 || header.maxChunkSize > 64 * 1024 * 1024) {
+        return ReadResult::InvalidFormat;
+    }
+
+    m_chunk.reserve(header.maxChunkSize);
+    m_compressed.reserve(LZ4_compressBound(header.maxChunkSize));
+    return ReadResult::Success;
+}
+
+ReadResult TraceReader::NextChunk(std::error_code &error) {
+    error.clear();
+    m_chunk.clear();
+
+    m_in.read(reinterpret_cast<char *>(&m_chunkHeader), sizeof(m_chunkHeader));
+    if (m_in.gcount() == 0 && m_in.eof()) {
+        return ReadResult::EndOfFile;
+    }
+    if (m_in.gcount() != sizeof(m_chunkHeader)) {
+        return ReadResult::Truncated;
+    }
+    if (m_chunkHeader.source >= kNumSources || m_chunkHeader.rawSize > m_chunk.capacity() ||
+        m_chunkHeader.compressedSize > m_compressed.capacity()) {
+        return ReadResult::CorruptChunk;
+    }
+
+    m_compressed.resize(m_chunkHeader.compressedSize);
+    m_in.read(m_compressed.data(), m_compressed.size());
+    if (static_cast<size_t>(m_in.gcount()) != m_compressed.size()) {
+        if (m_in.bad()) {
+            error.assign(errno, std::generic_category());
+            return ReadResult::FilesystemError;
+        }
+        return ReadResult::Truncated;
+    }
+
+    m_chunk.resize(m_chunkHeader.rawSize);
+    const int size = LZ4_decompress_safe(m_compressed.data(), reinterpret_cast<char *>(m_chunk.data()),
+                                         m_compressed.size(), m_chunk.size());
+    if (size < 0 || static_cast<uint32>(size) != m_chunkHeader.rawSize) {
+        m_chunk.clear();
+        return ReadResult::CorruptChunk;
+    }
+    return ReadResult::Success;
+}
+
+std::string FormatRecord(const RecordView &record) {
+    const std::string_view src = GetSourceName(record.source);
+
+    switch (record.type) {
+    case RecordType::FrameMarker: {
+        const auto r = record.As<record::FrameMarker>();
+        return fmt::format("{:<7} frame {}", src, r.frame);
+    }
+    case RecordType::CycleStamp: {
+        const auto r = record.As<record::CycleStamp>();
+        return fmt::format("{:<7} @ cycle {}", src, r.cycle);
+    }
+    case RecordType::SH2Reset: {
+        const auto r = record.As<record::SH2Reset>();
+        return fmt::format("{:<7} reset pc={:08X} sp={:08X}{}", src, r.pc, r.sp, (r.watchdogInitiated ? " (WDT)" : ""));
+    }
+    case RecordType::SH2Instruction: [[fallthrough]];
+    case RecordType::SH2DelaySlotInstruction: {
+        const auto r = record.As<record::SH2Instruction>();
+        const bool delaySlot = record.type == RecordType::SH2DelaySlotInstruction;
+        return fmt::format("{:<7} exec {:08X} {:04X}{}", src, r.pc, r.opcode, (delaySlot ? " (delay slot)" : ""));
+    }
+    case RecordType::SH2Branch: {
+        const auto r = record.As<record::SH2Branch>();
+        return fmt::format("{:<7} branch {:08X} -> {:08X}", src, r.pc, r.target);
+    }
+    case RecordType::SH2BranchDelay: {
+        const auto r = record.As<record::SH2Target>();
+        return fmt::format("{:<7} delayed branch -> {:08X}", src, r.target);
+    }
+    case RecordType::SH2Call: {
+        const auto r = record.As<record::SH2Target>();
+        return fmt::format("{:<7} call -> {:08X}", src, r.target);
+    }
+    case RecordType::SH2Return: {
+        const auto r = record.As<record::SH2Target>();
+        return fmt::format("{:<7} return -> {:08X}", src, r.target);
+    }
+    case RecordType::SH2ReturnFromException: {
+        const auto r = record.As<record::SH2ReturnFromException>();
+        return fmt::format("{:<7} rte -> {:08X} sp={:08X}", src, r.target, r.newSP);
+    }
+    case RecordType::SH2Interrupt: {
+        const auto r = record.As<record::SH2Interrupt>();
+        return fmt::format("{:<7} interrupt vec={:02X} level={} source={} pc={:08X}", src, r.vecNum, r.level,
+                           sh2::GetInterruptSourceName(static_cast<sh2::InterruptSource>(r.source)), r.pc);
+    }
+    case RecordType::SH2Exception: {
+        const auto r = record.As<record::SH2Exception>();
+        return fmt::format("{:<7} exception vec={:02X} pc={:08X} sr={:08X} sp={:08X} -> {:08X}", src, r.vecNum,
+                           r.oldPC, r.oldSR, r.oldSP, r.newPC);
+    }
+    case RecordType::SH2Trap: {
+        const auto r = record.As<record::SH2Trap>();
+        return fmt::format("{:<7} trapa vec={:02X} pc={:08X} sp={:08X} -> {:08X}", src, r.vecNum, r.oldPC, r.oldSP,
+                           r.newPC);
+    }
+    case RecordType::SH2DMABegin: {
+        const auto r = record.As<record::SH2DMABegin>();
+        return fmt::format("{:<7} dma{} begin {:08X}{:+d} -> {:08X}{:+d} count={} unit={}", src, r.channel,
+                           r.srcAddress, r.srcInc, r.dstAddress, r.dstInc, r.count, r.unitSize);
+    }
+    case RecordType::SH2DMAEnd: {
+        const auto r = record.As<record::SH2DMAEnd>();
+        return fmt::format("{:<7} dma{} end{}", src, r.channel, (r.irqRaised ? " (IRQ)" : ""));
+    }
+    case RecordType::SCURaiseInterrupt: {
+        const auto r = record.As<record::SCURaiseInterrupt>();
+        return fmt::format("{:<7} raise interrupt {} level={}", src, r.index, r.level);
+    }
+    case RecordType::SCUAcknowledgeInterrupt: {
+        const auto r = record.As<record::SCUAcknowledgeInterrupt>();
+        return fmt::format("{:<7} acknowledge interrupt {}", src, r.index);
+    }
+    case RecordType::SCUDMA: {
+        const auto r = record.As<record::SCUDMA>();
+        if (r.indirect) {
+            return fmt::format("{:<7} dma{} indirect @{:08X} {:08X}+{:X} -> {:08X}+{:X} count={:X}", src, r.channel,
+                               r.indirectAddr, r.srcAddr, r.srcAddrInc, r.dstAddr, r.dstAddrInc, r.xferCount);
+        }
+        return fmt::format("{:<7} dma{} {:08X}+{:X} -> {:08X}+{:X} count={:X}", src, r.channel, r.srcAddr,
+                           r.srcAddrInc, r.dstAddr, r.dstAddrInc, r.xferCount);
+    }
+    case RecordType::SCUDSPDMA: {
+        const auto r = record.As<record::SCUDSPDMA>();
+        return fmt::format("{:<7} dsp dma {} D0={:08X} DSP={} count={} inc={}{}", src, (r.toD0 ? "DSP->D0" : "D0->DSP"),
+                           r.addrD0, r.addrDSP, r.count, r.addrInc, (r.hold ? " hold" : ""));
+    }
+    case RecordType::CDBlockCommand: [[fallthrough]];
+    case RecordType::CDBlockResponse: {
+        const auto r = record.As<record::CDBlockCommand>();
+        const bool response = record.type == RecordType::CDBlockResponse;
+        return fmt::format("{:<7} {} {:04X} {:04X} {:04X} {:04X}", src, (response ? "response" : "command "), r.cr1,
+                           r.cr2, r.cr3, r.cr4);
+    }
+    default: return fmt::format("{:<7} (unknown record type {})", src, static_cast<uint8>(record.type));
+    }
+}
+
+} // namespace ymir::debug::trace
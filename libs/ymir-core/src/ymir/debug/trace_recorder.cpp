@@ -0,0 +1,179 @@
+#include <ymir/debug/trace_recorder.hpp>
+
+#include <ymir/util/thread_name.hpp>
+
+#include <lz4.h>
+
+namespace ymir::debug::trace {
+
+TraceRecorder::TraceRecorder()
+    : m_streams{{{*this, Source::System},
+                 {*this, Source::MasterSH2},
+                 {*this, Source::SlaveSH2},
+                 {*this, Source::SCU},
+                 {*this, Source::CDBlock}}} {
+    static_assert(kNumSources == 5, "update stream initializers");
+}
+
+TraceRecorder::~TraceRecorder() {
+    Stop();
+}
+
+bool TraceRecorder::Start(const std::filesystem::path &path, std::error_code &error) {
+    Stop();
+    error.clear();
+
+    m_out.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_out) {
+        error.assign(errno, std::generic_category());
+        return false;
+    }
+
+    const FileHeader header{
+        .magic = kMagic,
+        .version = kFormatVersion,
+        .maxChunkSize = kMaxChunkSize,
+        .reserved = 0,
+    };
+    m_out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    if (!m_out) {
+        error.assign(errno, std::generic_category());
+        m_out.close();
+        return false;
+    }
+
+    m_nextSequence = 0;
+    m_statChunks = 0;
+    m_statRecords = 0;
+    m_statRawBytes = 0;
+    m_statCompressedBytes = 0;
+    m_writeError = false;
+
+    m_writerThread = std::thread([&] { WriterThread(); });
+    for (auto &stream : m_streams) {
+        stream.Open();
+    }
+    m_recording = true;
+    return true;
+}
+
+void TraceRecorder::Stop() {
+    if (!m_recording) {
+        return;
+    }
+    m_recording = false;
+
+    for (auto &stream : m_streams) {
+        stream.Close();
+    }
+    m_pendingChunks.enqueue(nullptr);
+    if (m_writerThread.joinable()) {
+        m_writerThread.join();
+    }
+    m_out.close();
+}
+
+TraceRecorder::Stats TraceRecorder::GetStats() const {
+    return {
+        .chunks = m_statChunks.load(std::memory_order_relaxed),
+        .records = m_statRecords.load(std::memory_order_relaxed),
+        .rawBytes = m_statRawBytes.load(std::memory_order_relaxed),
+        .compressedBytes = m_statCompressedBytes.load(std::memory_order_relaxed),
+        .writeError = m_writeError.load(std::memory_order_relaxed),
+    };
+}
+
+TraceRecorder::Chunk *TraceRecorder::AcquireChunk() {
+    Chunk *chunk = nullptr;
+    if (m_freeChunks.try_dequeue(chunk)) {
+        return chunk;
+    }
+    {
+        std::unique_lock lock{m_chunkAllocMutex};
+        if (m_chunks.size() < kMaxChunks) {
+            return m_chunks.emplace_back(std::make_unique<Chunk>()).get();
+        }
+    }
+    // Pool exhausted; wait for the writer to catch up
+    m_freeChunks.wait_dequeue(chunk);
+    return chunk;
+}
+
+void TraceRecorder::WriterThread() {
+    util::SetCurrentThreadName("Trace writer thread");
+
+    std::vector<char> compressed(LZ4_compressBound(kMaxChunkSize));
+
+    Chunk *chunk = nullptr;
+    while (true) {
+        m_pendingChunks.wait_dequeue(chunk);
+        if (chunk == nullptr) {
+            break;
+        }
+
+        const int compressedSize = LZ4_compress_default(reinterpret_cast<const char *>(chunk->data.data()),
+                                                        compressed.data(), chunk->size, compressed.size());
+
+        if (compressedSize > 0 && !m_writeError.load(std::memory_order_relaxed)) {
+            const ChunkHeader header{
+                .source = static_cast<uint8>(chunk->source),
+                .reserved = {},
+                .rawSize = chunk->size,
+                .compressedSize = static_cast<uint32>(compressedSize),
+                .recordCount = chunk->recordCount,
+                .sequence = chunk->sequence,
+            };
+            m_out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            m_out.write(compressed.data(), compressedSize);
+            if (m_out) {
+                m_statChunks.fetch_add(1, std::memory_order_relaxed);
+                m_statRecords.fetch_add(chunk->recordCount, std::memory_order_relaxed);
+                m_statRawBytes.fetch_add(chunk->size, std::memory_order_relaxed);
+                m_statCompressedBytes.fetch_add(compressedSize, std::memory_order_relaxed);
+            } else {
+                m_writeError = true;
+            }
+        } else {
+            m_writeError = true;
+        }
+
+        chunk->size = 0;
+        chunk->recordCount = 0;
+        m_freeChunks.enqueue(chunk);
+    }
+
+    m_out.flush();
+    if (!m_out) {
+        m_writeError = true;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Stream
+
+void TraceRecorder::Stream::Open() {
+    m_chunk = m_recorder.AcquireChunk();
+    m_chunk->source = m_source;
+    m_lastCycle = ~0ull;
+}
+
+void TraceRecorder::Stream::Close() {
+    if (m_chunk == nullptr) {
+        return;
+    }
+    if (m_chunk->size > 0) {
+        m_chunk->sequence = m_recorder.m_nextSequence.fetch_add(1, std::memory_order_relaxed);
+        m_recorder.m_pendingChunks.enqueue(m_chunk);
+    } else {
+        m_recorder.m_freeChunks.enqueue(m_chunk);
+    }
+    m_chunk = nullptr;
+}
+
+void TraceRecorder::Stream::Submit() {
+    m_chunk->sequence = m_recorder.m_nextSequence.fetch_add(1, std::memory_order_relaxed);
+    m_recorder.m_pendingChunks.enqueue(m_chunk);
+    Open();
+}
+
+} // namespace ymir::debug::trace
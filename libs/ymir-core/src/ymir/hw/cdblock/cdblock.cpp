@@ -140,6 +140,7 @@ void CDBlock::Reset(bool hard) {
     m_xferCount = 0xFFFFFF;
     m_xferBuffer.fill(0xFFFF);
     m_xferBufferPos = 0;
+    m_xferSectorData = nullptr;
 
     m_xferSubcodeFrameAddress = 0;
     m_xferSubcodeGroup = 0;
@@ -188,7 +189,11 @@ void CDBlock::MapMemory(sys::SH2Bus &bus) {
                 cast(ctx).WriteReg<uint16>(address + 2, value >> 0u);
             },
             // Bus wait handler
-            [](uint32, uint32, bool, void *) -> bool { return false; });
+            [](uint32, uint32, bool, void *) -> bool { return false; },
+            // Bulk read handler
+            [](uint32 address, std::span<uint32> out, void *ctx) -> uint32 {
+                return cast(ctx).ReadRegBulk(address, out);
+            });
 
         bus.MapSideEffectFree(
             address, address + 0xFFF, this,
@@ -327,6 +332,12 @@ void CDBlock::SaveState(savestate::CDBlockSaveState &state) const {
     state.xferCount = m_xferCount;
     state.xferBuffer = m_xferBuffer;
     state.xferBufferPos = m_xferBufferPos;
+    if (m_xferSectorData != nullptr) {
+        // Sector data is read in place; store the current sector in the transfer buffer
+        for (uint32 i = 0; i < m_xferGetLength / sizeof(uint16); i++) {
+            state.xferBuffer[i] = util::ReadBE<uint16>(&m_xferSectorData[i * sizeof(uint16)]);
+        }
+    }
 
     state.xferSectorPos = m_xferSectorPos;
     state.xferSectorEnd = m_xferSectorEnd;
@@ -339,9 +350,9 @@ void CDBlock::SaveState(savestate::CDBlockSaveState &state) const {
 
     state.xferExtraCount = m_xferExtraCount;
 
-    // Store partition buffers first, then scratch buffers.
+    // Store partition and reserved buffers first, then the scratch buffer.
     // Since there are always 200 buffers (and one extra scratch buffer), we can use the free buffer count to determine
-    // both how many scratch buffers to write and where to begin writing them.
+    // where to write the scratch buffer.
 
     // Clear all buffers first
     for (auto &buffer : state.buffers) {
@@ -355,25 +366,20 @@ void CDBlock::SaveState(savestate::CDBlockSaveState &state) const {
         buffer.partitionIndex = 0xFF;
     }
 
-    // Write partition buffers
+    // Write partition and reserved buffers
     m_partitionManager.SaveState(state);
 
-    // Write scratch buffers after partition buffers
-    const uint32 basePos = kNumBuffers - m_partitionManager.GetFreeBufferCount();
-    uint32 pos = basePos;
-    while (pos < kNumBuffers + 1) {
-        auto &scratchBuffer = m_scratchBuffers[pos - basePos];
-        state.buffers[pos].data = scratchBuffer.data;
-        state.buffers[pos].size = scratchBuffer.size;
-        state.buffers[pos].frameAddress = scratchBuffer.frameAddress;
-        state.buffers[pos].fileNum = scratchBuffer.subheader.fileNum;
-        state.buffers[pos].chanNum = scratchBuffer.subheader.chanNum;
-        state.buffers[pos].submode = scratchBuffer.subheader.submode;
-        state.buffers[pos].codingInfo = scratchBuffer.subheader.codingInfo;
-        ++pos;
-    }
+    // Write scratch buffer after partition and reserved buffers
+    const uint32 scratchPos = kNumBuffers - m_partitionManager.GetFreeBufferCount();
+    state.buffers[scratchPos].data = m_scratchBuffer.data;
+    state.buffers[scratchPos].size = m_scratchBuffer.size;
+    state.buffers[scratchPos].frameAddress = m_scratchBuffer.frameAddress;
+    state.buffers[scratchPos].fileNum = m_scratchBuffer.subheader.fileNum;
+    state.buffers[scratchPos].chanNum = m_scratchBuffer.subheader.chanNum;
+    state.buffers[scratchPos].submode = m_scratchBuffer.subheader.submode;
+    state.buffers[scratchPos].codingInfo = m_scratchBuffer.subheader.codingInfo;
 
-    state.scratchBufferPutIndex = m_scratchBufferPutIndex;
+    state.scratchBufferPutIndex = m_putBufferIndex;
 
     for (size_t i = 0; i < kNumFilters; i++) {
         state.filters[i].startFrameAddress = m_filters[i].startFrameAddress;
@@ -486,23 +492,19 @@ void CDBlock::LoadState(const savestate::CDBlockSaveState &state) {
 
     m_xferExtraCount = state.xferExtraCount;
 
-    // Read partition buffers followed by scratch buffers
+    // Read partition and reserved buffers followed by the scratch buffer
     m_partitionManager.LoadState(state);
-    const uint32 basePos = kNumBuffers - m_partitionManager.GetFreeBufferCount();
-    uint32 pos = basePos;
-    while (pos < kNumBuffers + 1) {
-        auto &scratchBuffer = m_scratchBuffers[pos - basePos];
-        scratchBuffer.data = state.buffers[pos].data;
-        scratchBuffer.size = state.buffers[pos].size;
-        scratchBuffer.frameAddress = state.buffers[pos].frameAddress;
-        scratchBuffer.subheader.fileNum = state.buffers[pos].fileNum;
-        scratchBuffer.subheader.chanNum = state.buffers[pos].chanNum;
-        scratchBuffer.subheader.submode = state.buffers[pos].submode;
-        scratchBuffer.subheader.codingInfo = state.buffers[pos].codingInfo;
-        ++pos;
-    }
-
-    m_scratchBufferPutIndex = state.scratchBufferPutIndex;
+    const uint32 scratchPos = kNumBuffers - m_partitionManager.GetFreeBufferCount();
+    m_scratchBuffer.data = state.buffers[scratchPos].data;
+    m_scratchBuffer.size = state.buffers[scratchPos].size;
+    m_scratchBuffer.frameAddress = state.buffers[scratchPos].frameAddress;
+    m_scratchBuffer.subheader.fileNum = state.buffers[scratchPos].fileNum;
+    m_scratchBuffer.subheader.chanNum = state.buffers[scratchPos].chanNum;
+    m_scratchBuffer.subheader.submode = state.buffers[scratchPos].submode;
+    m_scratchBuffer.subheader.codingInfo = state.buffers[scratchPos].codingInfo;
+
+    m_putBufferIndex = state.scratchBufferPutIndex;
+    BindTransferSector();
 
     for (size_t i = 0; i < kNumFilters; i++) {
         m_filters[i].startFrameAddress = state.filters[i].startFrameAddress;
@@ -539,12 +541,14 @@ void CDBlock::LoadState(const savestate::CDBlockSaveState &state) {
 
 void CDBlock::OnDriveStateUpdateEvent(core::EventContext &eventContext, void *userContext) {
     auto &cdb = *static_cast<CDBlock *>(userContext);
+    YMIR_HOST_TIMER(cdb.m_hostTiming, debug::HostTimingComponent::CDBlock);
     cdb.ProcessDriveState();
     eventContext.Reschedule(cdb.m_targetDriveCycles);
 }
 
 void CDBlock::OnCommandExecEvent(core::EventContext &eventContext, void *userContext) {
     auto &cdb = *static_cast<CDBlock *>(userContext);
+    YMIR_HOST_TIMER(cdb.m_hostTiming, debug::HostTimingComponent::CDBlock);
     cdb.ProcessCommand();
 }
 
@@ -577,6 +581,27 @@ T CDBlock::ReadReg(uint32 address) {
     }
 }
 
+uint32 CDBlock::ReadRegBulk(uint32 address, std::span<uint32> out) {
+    if ((address & 0x3F) != 0x00) {
+        for (uint32 &value : out) {
+            value = ReadReg<uint16>(address + 0) << 16u;
+            value |= ReadReg<uint16>(address + 2) << 0u;
+        }
+        return out.size();
+    }
+
+    // Both halves of a 32-bit read from the data transfer register pull a word from the transfer
+    std::array<uint16, 256> words;
+    for (size_t offset = 0; offset < out.size(); offset += words.size() / 2) {
+        const size_t count = std::min(out.size() - offset, words.size() / 2);
+        DoReadTransferBulk(std::span{words}.first(count * 2));
+        for (size_t i = 0; i < count; i++) {
+            out[offset + i] = (words[i * 2 + 0] << 16u) | words[i * 2 + 1];
+        }
+    }
+    return out.size();
+}
+
 template <mem_primitive T>
 void CDBlock::WriteReg(uint32 address, T value) {
     if constexpr (std::is_same_v<T, uint8>) {
@@ -635,8 +660,8 @@ T CDBlock::PeekReg(uint32 address) {
         // ReadReg and WriteReg implement the correct register set.
 
         switch (address) {
-        case 0x00: return m_xferBuffer[m_xferBufferPos % m_xferBuffer.size()];
-        case 0x02: return m_xferBuffer[m_xferBufferPos % m_xferBuffer.size()];
+        case 0x00: return PeekTransferWord();
+        case 0x02: return PeekTransferWord();
 
         case 0x08: return m_HIRQ;
         case 0x0C: return m_HIRQMASK;
@@ -670,8 +695,14 @@ void CDBlock::PokeReg(uint32 address, T value) {
         // ReadReg and WriteReg implement the correct register set.
 
         switch (address) {
-        case 0x00: m_xferBuffer[m_xferBufferPos % m_xferBuffer.size()] = value; break;
-        case 0x02: m_xferBuffer[m_xferBufferPos % m_xferBuffer.size()] = value; break;
+        case 0x00: [[fallthrough]];
+        case 0x02:
+            if (m_xferSectorData != nullptr) {
+                util::WriteBE<uint16>(&m_xferSectorData[m_xferBufferPos * sizeof(uint16)], value);
+            } else {
+                m_xferBuffer[m_xferBufferPos % m_xferBuffer.size()] = value;
+            }
+            break;
 
         case 0x08: m_HIRQ = value; break;
         case 0x0C: m_HIRQMASK = value; break;
@@ -1048,7 +1079,12 @@ void CDBlock::ProcessDriveStatePlay() {
             return;
         }
 
-        Buffer &buffer = m_scratchBuffers[0];
+        // Read directly into the next free buffer so that accepted sectors can be linked into a partition without
+        // copying. Fall back to the scratch buffer if no buffers are free; the sector is either sent to the SCSP or
+        // dropped in that case.
+        const uint8 freeBufferIndex = m_partitionManager.PeekFreeBuffer();
+        Buffer &buffer = freeBufferIndex != PartitionManager::kNoBuffer ? m_partitionManager.GetBuffer(freeBufferIndex)
+                                                                         : m_scratchBuffer;
         media::DiscPosition discPos{};
 
         // Sanity check: is the track valid?
@@ -1096,30 +1132,13 @@ void CDBlock::ProcessDriveStatePlay() {
                 buffer.subheader.ReadFrom(buffer.data);
 
                 // Check against CD device filter and send data to the appropriate destination
-                uint8 filterNum = m_cdDeviceConnection;
-                for (int i = 0; i < kNumFilters && filterNum != Filter::kDisconnected; i++) {
-                    const Filter &filter = m_filters[filterNum];
-                    if (filter.Test(buffer)) {
-                        if (filter.passOutput == Filter::kDisconnected) [[unlikely]] {
-                            devlog::trace<grp::play>("Passed filter; output disconnected - discarded");
-                        } else {
-                            assert(filter.passOutput < m_filters.size());
-                            devlog::trace<grp::play>("Passed filter; sent to buffer partition {}", filter.passOutput);
-                            m_partitionManager.InsertHead(filter.passOutput, buffer);
-                            m_lastCDWritePartition = filter.passOutput;
-                            SetInterrupt(kHIRQ_CSCT);
-                        }
-                        break;
-                    } else {
-                        if (filter.failOutput == Filter::kDisconnected) [[unlikely]] {
-                            devlog::trace<grp::play>("Filtered out; output disconnected - discarded");
-                            break;
-                        } else {
-                            assert(filter.failOutput < m_filters.size());
-                            devlog::trace<grp::play>("Filtered out; sent to filter {}", filter.failOutput);
-                            filterNum = filter.failOutput;
-                        }
-                    }
+                const uint8 partitionNum = RouteSector(m_cdDeviceConnection, buffer);
+                if (partitionNum != Filter::kDisconnected) {
+                    const uint8 bufferIndex = m_partitionManager.AllocateBuffer();
+                    assert(bufferIndex == freeBufferIndex);
+                    m_partitionManager.InsertHead(partitionNum, bufferIndex);
+                    m_lastCDWritePartition = partitionNum;
+                    SetInterrupt(kHIRQ_CSCT);
                 }
             }
 
@@ -1258,6 +1277,8 @@ void CDBlock::SetupTOCTransfer() {
     m_xferType = TransferType::TOC;
     m_xferPos = 0;
     m_xferBufferPos = 0;
+
+    m_xferSectorData = nullptr;
     m_xferLength = saturnTOC.size() * sizeof(uint32) / sizeof(uint16);
     m_xferCount = 0;
     m_xferExtraCount = 0;
@@ -1339,15 +1360,17 @@ void CDBlock::SetupPutSectorTransfer(uint16 sectorCount, uint8 partitionNumber)
     m_xferType = TransferType::PutSector;
     m_xferPos = 0;
     m_xferBufferPos = 0;
+
+    m_xferSectorData = nullptr;
     m_xferLength = m_putSectorLength / sizeof(uint16) * sectorCount;
     m_xferCount = 0;
     m_xferExtraCount = 0;
 
-    m_scratchBufferPutIndex = 0;
+    m_putBufferIndex = 0;
 
-    // Prepare sectors in scratch area
+    // Prepare the reserved buffers, which receive the data in place
     for (uint32 i = 0; i < sectorCount; ++i) {
-        auto &buffer = m_scratchBuffers[i];
+        auto &buffer = m_partitionManager.GetBuffer(m_partitionManager.GetReservedBuffer(i));
         buffer.frameAddress = 0;
         buffer.size = m_putSectorLength;
         buffer.subheader.fileNum = 0;
@@ -1380,6 +1403,8 @@ uint32 CDBlock::SetupFileInfoTransfer(uint32 fileID) {
     m_xferType = TransferType::FileInfo;
     m_xferPos = 0;
     m_xferBufferPos = 0;
+
+    m_xferSectorData = nullptr;
     m_xferLength = numFileInfos * 12 / sizeof(uint16);
     m_xferCount = 0;
     m_xferExtraCount = 0;
@@ -1415,6 +1440,8 @@ bool CDBlock::SetupSubcodeTransfer(uint8 type) {
         m_xferType = TransferType::Subcode;
         m_xferPos = 0;
         m_xferBufferPos = 0;
+
+        m_xferSectorData = nullptr;
         m_xferLength = 5;
         m_xferCount = 0;
         m_xferExtraCount = 0;
@@ -1448,6 +1475,8 @@ bool CDBlock::SetupSubcodeTransfer(uint8 type) {
         m_xferType = TransferType::Subcode;
         m_xferPos = 0;
         m_xferBufferPos = 0;
+
+        m_xferSectorData = nullptr;
         m_xferLength = 12;
         m_xferCount = 0;
         m_xferExtraCount = 0;
@@ -1478,23 +1507,18 @@ bool CDBlock::SetupSubcodeTransfer(uint8 type) {
 void CDBlock::ReadSector() {
     const Buffer *buffer = m_partitionManager.GetTail(m_xferPartition, m_xferSectorPos);
     if (buffer != nullptr) {
-        // Skip to user data when not reading 2352 bytes.
-        // Also force get sector length 2048 -> 2324 when executing:
+        // Force get sector length 2048 -> 2324 when executing:
         // - Get Sector Data from Mode 2 Form 2 sectors
         // - Get Then Delete Sector Data from Mode 2 sectors
-        const bool mode1 = buffer->data[0xF] == 0x01;
         const bool mode2 = buffer->data[0xF] == 0x02;
         const bool mode2form2 = mode2 && bit::test<5>(buffer->data[0x12]);
         const bool mode2GetThenDelete = mode2 && m_xferType == TransferType::GetThenDeleteSector;
         const bool extendLength = mode2form2 || mode2GetThenDelete;
         const uint32 getLength = extendLength ? std::max(2324u, m_getSectorLength) : m_getSectorLength;
-        const uint32 limit = mode1 ? 16u : 24u;
-        const uint32 offset = std::min(2352u - getLength, limit);
 
-        for (size_t i = 0; i < getLength; i += sizeof(uint16)) {
-            m_xferBuffer[i / sizeof(uint16)] = util::ReadBE<uint16>(&buffer->data[i + offset]);
-        }
+        // The data is read straight out of the sector's pool buffer
         m_xferGetLength = getLength;
+        BindTransferSector();
 
         // Extend total transfer length if the current sector length was extended
         if (extendLength) {
@@ -1506,9 +1530,34 @@ void CDBlock::ReadSector() {
     } else {
         devlog::warn<grp::xfer>("Out of bounds transfer - sector {}", m_xferSectorPos);
         m_xferGetLength = m_getSectorLength;
+        m_xferSectorData = nullptr;
     }
 }
 
+void CDBlock::BindTransferSector() {
+    m_xferSectorData = nullptr;
+    if (m_xferType != TransferType::GetSector && m_xferType != TransferType::GetThenDeleteSector) {
+        return;
+    }
+    Buffer *buffer = m_partitionManager.GetTail(m_xferPartition, m_xferSectorPos);
+    if (buffer == nullptr) {
+        return;
+    }
+
+    // Skip to user data when not reading 2352 bytes
+    const bool mode1 = buffer->data[0xF] == 0x01;
+    const uint32 limit = mode1 ? 16u : 24u;
+    const uint32 getLength = std::min<uint32>(m_xferGetLength, 2352u);
+    m_xferSectorData = &buffer->data[std::min(2352u - getLength, limit)];
+}
+
+uint16 CDBlock::PeekTransferWord() const {
+    if (m_xferSectorData != nullptr) {
+        return util::ReadBE<uint16>(&m_xferSectorData[m_xferBufferPos * sizeof(uint16)]);
+    }
+    return m_xferBuffer[m_xferBufferPos % m_xferBuffer.size()];
+}
+
 uint16 CDBlock::DoReadTransfer() {
     if (m_xferPos >= m_xferLength) {
         // TODO: what to return here?
@@ -1516,7 +1565,9 @@ uint16 CDBlock::DoReadTransfer() {
     }
 
     uint16 value;
-    if (m_xferBufferPos < m_xferBuffer.size()) {
+    if (m_xferSectorData != nullptr) {
+        value = util::ReadBE<uint16>(&m_xferSectorData[m_xferBufferPos++ * sizeof(uint16)]);
+    } else if (m_xferBufferPos < m_xferBuffer.size()) {
         // TODO: what happens when games attempt to do out-of-bounds reads from TOC of file info transfers?
         value = m_xferBuffer[m_xferBufferPos++];
     } else {
@@ -1549,6 +1600,42 @@ uint16 CDBlock::DoReadTransfer() {
     return value;
 }
 
+void CDBlock::DoReadTransferBulk(std::span<uint16> out) {
+    size_t pos = 0;
+    while (pos < out.size()) {
+        // Copy runs of words from the current sector directly out of its pool buffer.
+        // Everything else, including sector boundaries at the end of the transfer, goes through the regular path.
+        const uint32 sectorWords = m_xferGetLength / sizeof(uint16);
+        if (m_xferSectorData == nullptr || m_xferPos >= m_xferLength || m_xferBufferPos >= sectorWords) {
+            out[pos++] = DoReadTransfer();
+            continue;
+        }
+
+        const uint32 count = std::min<uint32>({static_cast<uint32>(out.size() - pos), sectorWords - m_xferBufferPos,
+                                               m_xferLength - m_xferPos});
+        const uint8 *data = &m_xferSectorData[m_xferBufferPos * sizeof(uint16)];
+        for (uint32 i = 0; i < count; i++) {
+            out[pos + i] = util::ReadBE<uint16>(&data[i * sizeof(uint16)]);
+        }
+        pos += count;
+        m_xferBufferPos += count;
+        m_xferPos += count;
+        m_xferCount += count;
+
+        if (m_xferBufferPos >= m_xferGetLength / sizeof(uint16)) {
+            ++m_xferSectorPos;
+            devlog::trace<grp::xfer>("Going to sector index {}", m_xferSectorPos);
+            m_xferBufferPos = 0;
+            if (m_xferPos < m_xferLength) {
+                ReadSector();
+            }
+        }
+        if (m_xferPos >= m_xferLength) {
+            devlog::trace<grp::xfer>("Transfer finished - {} of {} words transferred", m_xferCount, m_xferLength);
+        }
+    }
+}
+
 void CDBlock::DoWriteTransfer(uint16 value) {
     if (m_xferPos >= m_xferLength) {
         return;
@@ -1556,8 +1643,9 @@ void CDBlock::DoWriteTransfer(uint16 value) {
 
     switch (m_xferType) {
     case TransferType::PutSector:
-        if (m_scratchBufferPutIndex < m_scratchBuffers.size()) {
-            auto &buffer = m_scratchBuffers[m_scratchBufferPutIndex];
+        if (const uint8 bufferIndex = m_partitionManager.GetReservedBuffer(m_putBufferIndex);
+            bufferIndex != PartitionManager::kNoBuffer) {
+            auto &buffer = m_partitionManager.GetBuffer(bufferIndex);
             if (m_xferBufferPos < m_putSectorLength) {
                 const uint32 writePos = m_xferBufferPos + m_putOffset;
                 util::WriteBE<uint16>(&buffer.data[writePos], value);
@@ -1576,7 +1664,7 @@ void CDBlock::DoWriteTransfer(uint16 value) {
         }
         m_xferBufferPos += sizeof(uint16);
         if (m_xferBufferPos >= m_putSectorLength) {
-            ++m_scratchBufferPutIndex;
+            ++m_putBufferIndex;
             m_xferBufferPos = 0;
         }
         break;
@@ -1620,10 +1708,7 @@ void CDBlock::EndTransfer() {
     case TransferType::PutSector: //
     {
         const uint32 sectorCount = m_xferLength * sizeof(uint16) / m_putSectorLength;
-        if (m_partitionManager.UseReservedBuffers(sectorCount)) {
-            for (uint32 i = 0; i < sectorCount; ++i) {
-                m_partitionManager.InsertHead(m_xferPartition, m_scratchBuffers[i]);
-            }
+        if (m_partitionManager.InsertReservedBuffers(m_xferPartition, sectorCount)) {
             devlog::trace<grp::xfer>("Sector sent to partition {}", m_xferPartition);
         } else {
             devlog::trace<grp::xfer>("Not enough room to write sector");
@@ -1639,6 +1724,7 @@ void CDBlock::EndTransfer() {
     m_xferType = TransferType::None;
     m_xferPos = 0;
     m_xferBufferPos = 0;
+    m_xferSectorData = nullptr;
     m_xferLength = 0;
     m_xferCount = 0xFFFFFF;
 }
@@ -1676,6 +1762,32 @@ void CDBlock::DisconnectFilterInput(uint8 filterNumber) {
     }
 }
 
+static_assert(Filter::kDisconnected == PartitionManager::kNoPartition,
+              "discarded sectors must be routed to no partition in the partition manager");
+
+uint8 CDBlock::RouteSector(uint8 filterNumber, const Buffer &buffer) const {
+    for (uint32 i = 0; i < kNumFilters && filterNumber != Filter::kDisconnected; i++) {
+        const Filter &filter = m_filters[filterNumber];
+        if (filter.Test(buffer)) {
+            if (filter.passOutput == Filter::kDisconnected) [[unlikely]] {
+                devlog::trace<grp::play>("Passed filter; output disconnected - discarded");
+            } else {
+                assert(filter.passOutput < m_filters.size());
+                devlog::trace<grp::play>("Passed filter; sent to buffer partition {}", filter.passOutput);
+            }
+            return filter.passOutput;
+        }
+        if (filter.failOutput == Filter::kDisconnected) [[unlikely]] {
+            devlog::trace<grp::play>("Filtered out; output disconnected - discarded");
+            return Filter::kDisconnected;
+        }
+        assert(filter.failOutput < m_filters.size());
+        devlog::trace<grp::play>("Filtered out; sent to filter {}", filter.failOutput);
+        filterNumber = filter.failOutput;
+    }
+    return Filter::kDisconnected;
+}
+
 void CDBlock::SetupCommand() {
     m_scheduler.ScheduleFromNow(m_commandExecEvent, 50);
 }
@@ -1722,8 +1834,8 @@ FORCE_INLINE void CDBlock::ProcessCommand() {
     case 0x62: CmdDeleteSectorData(); break;
     case 0x63: CmdGetThenDeleteSectorData(); break;
     case 0x64: CmdPutSectorData(); break;
-    // case 0x65: CmdCopySectorData(); break;
-    // case 0x66: CmdMoveSectorData(); break;
+    case 0x65: CmdCopySectorData(); break;
+    case 0x66: CmdMoveSectorData(); break;
     case 0x67: CmdGetCopyError(); break;
     case 0x70: CmdChangeDirectory(); break;
     case 0x71: CmdReadDirectory(); break;
@@ -1943,6 +2055,7 @@ void CDBlock::CmdInitializeCDSystem() {
         m_xferPos = 0;
         m_xferLength = 0;
         m_xferCount = 0xFFFFFF;
+        m_xferSectorData = nullptr;
         m_xferBuffer.fill(0xFFFF);
         m_xferBufferPos = 0;
 
@@ -3028,20 +3141,35 @@ void CDBlock::CmdCopySectorData() {
     // sector offset
     // source partition number   <blank>
     // sector number
-    // const uint8 dstPartitionNumber = bit::extract<0, 7>(m_CR[0]);
-    // const uint16 sectorOffset = m_CR[1];
-    // const uint8 srcPartitionNumber = bit::extract<8, 15>(m_CR[2]);
-    // const uint16 sectorNumber = m_CR[3];
-
-    // TODO: setup async sector copy transfer
-    // TODO: report Reject status if not enough buffer space available
-    devlog::info<grp::base>("Copy sector data command is unimplemented");
-    YMIR_DEV_CHECK();
+    const uint8 dstFilterNumber = bit::extract<0, 7>(m_CR[0]);
+    const uint16 sectorOffset = m_CR[1];
+    const uint8 srcPartitionNumber = bit::extract<8, 15>(m_CR[2]);
+    const uint16 sectorNumber = m_CR[3];
 
-    // Output structure: standard CD status data
-    ReportCDStatus();
+    // TODO: copy asynchronously
+    uint32 startSector, sectorCount;
+    bool reject = !ResolveSectorRange(dstFilterNumber, srcPartitionNumber, sectorOffset, sectorNumber, startSector,
+                                      sectorCount);
+    if (!reject) {
+        // Fails if there are not enough free buffers for the copies
+        auto route = [&](const Buffer &buffer) { return RouteSector(dstFilterNumber, buffer); };
+        reject = !m_partitionManager.CopySectors(srcPartitionNumber, startSector, sectorCount, route);
+    }
+    if (reject) [[unlikely]] {
+        devlog::trace<grp::base>("Copy sector data rejected");
+    } else {
+        devlog::trace<grp::base>("Copied {} sectors from partition {} at offset {} to filter {}", sectorCount,
+                                 srcPartitionNumber, startSector, dstFilterNumber);
+    }
 
-    SetInterrupt(kHIRQ_CMOK | kHIRQ_ECPY);
+    // Output structure: standard CD status data
+    if (reject) [[unlikely]] {
+        ReportCDStatus(kStatusReject);
+        SetInterrupt(kHIRQ_CMOK);
+    } else {
+        ReportCDStatus();
+        SetInterrupt(kHIRQ_CMOK | kHIRQ_ECPY);
+    }
 }
 
 void CDBlock::CmdMoveSectorData() {
@@ -3052,19 +3180,46 @@ void CDBlock::CmdMoveSectorData() {
     // sector offset
     // source partition number   <blank>
     // sector number
-    // const uint8 dstPartitionNumber = bit::extract<0, 7>(m_CR[0]);
-    // const uint16 sectorOffset = m_CR[1];
-    // const uint8 srcPartitionNumber = bit::extract<8, 15>(m_CR[2]);
-    // const uint16 sectorNumber = m_CR[3];
+    const uint8 dstFilterNumber = bit::extract<0, 7>(m_CR[0]);
+    const uint16 sectorOffset = m_CR[1];
+    const uint8 srcPartitionNumber = bit::extract<8, 15>(m_CR[2]);
+    const uint16 sectorNumber = m_CR[3];
 
-    // TODO: setup async sector move transfer
-    devlog::info<grp::base>("Move sector data command is unimplemented");
-    YMIR_DEV_CHECK();
+    // TODO: move asynchronously
+    uint32 startSector, sectorCount;
+    const bool reject = !ResolveSectorRange(dstFilterNumber, srcPartitionNumber, sectorOffset, sectorNumber,
+                                            startSector, sectorCount);
+    if (reject) [[unlikely]] {
+        devlog::trace<grp::base>("Move sector data rejected");
+    } else {
+        auto route = [&](const Buffer &buffer) { return RouteSector(dstFilterNumber, buffer); };
+        m_partitionManager.MoveSectors(srcPartitionNumber, startSector, sectorCount, route);
+        devlog::trace<grp::base>("Moved {} sectors from partition {} at offset {} to filter {}", sectorCount,
+                                 srcPartitionNumber, startSector, dstFilterNumber);
+    }
 
     // Output structure: standard CD status data
-    ReportCDStatus();
+    if (reject) [[unlikely]] {
+        ReportCDStatus(kStatusReject);
+        SetInterrupt(kHIRQ_CMOK);
+    } else {
+        ReportCDStatus();
+        SetInterrupt(kHIRQ_CMOK | kHIRQ_ECPY);
+    }
+}
 
-    SetInterrupt(kHIRQ_CMOK | kHIRQ_ECPY);
+bool CDBlock::ResolveSectorRange(uint8 dstFilterNumber, uint8 srcPartitionNumber, uint16 sectorOffset,
+                                 uint16 sectorNumber, uint32 &startSector, uint32 &sectorCount) const {
+    if (dstFilterNumber >= kNumFilters || srcPartitionNumber >= kNumPartitions) [[unlikely]] {
+        return false;
+    }
+    const uint32 partSecCount = m_partitionManager.GetBufferCount(srcPartitionNumber);
+    if (partSecCount == 0 || sectorNumber == 0) [[unlikely]] {
+        return false;
+    }
+    startSector = sectorOffset == 0xFFFF ? partSecCount - 1 : sectorOffset;
+    sectorCount = sectorNumber == 0xFFFF ? partSecCount - std::min(startSector, partSecCount) : sectorNumber;
+    return startSector < partSecCount && startSector + sectorCount <= partSecCount;
 }
 
 void CDBlock::CmdGetCopyError() {
@@ -1,10 +1,10 @@
-#include <ymir/hw/cdblock/cdblock.hpp>
+#include <ymir/hw/cdblock/cdblock_partition_manager.hpp>
 
 #include "cdblock_devlog.hpp"
 
+#include <algorithm>
 #include <cassert>
-#include <numeric>
-#include <utility>
+#include <deque>
 
 namespace ymir::cdblock {
 
@@ -40,31 +40,41 @@ FORCE_INLINE static void TracePartitionClear(debug::ICDBlockTracer *tracer, uint
 // -----------------------------------------------------------------------------
 // Implementation
 
-CDBlock::PartitionManager::PartitionManager() {
+PartitionManager::PartitionManager() {
     Reset();
 }
 
-void CDBlock::PartitionManager::Reset() {
-    m_partitions.fill({});
-    m_freeBuffers = kNumBuffers;
+void PartitionManager::Reset() {
+    ResetPool();
     m_reservedBuffers = 0;
     devlog::trace<grp::part_mgr>("Cleared partitions; free buffers = {}", m_freeBuffers);
     OnTracerAttached();
 }
 
-uint8 CDBlock::PartitionManager::GetBufferCount(uint8 partitionIndex) const {
+void PartitionManager::ResetPool() {
+    for (auto &partition : m_partitions) {
+        partition.count = 0;
+    }
+    // Hand out buffers in ascending order after a reset
+    for (uint32 i = 0; i < kNumBuffers; i++) {
+        m_freeList[i] = kNumBuffers - 1 - i;
+    }
+    m_freeBuffers = kNumBuffers;
+}
+
+uint8 PartitionManager::GetBufferCount(uint8 partitionIndex) const {
     assert(partitionIndex < m_partitions.size());
-    devlog::trace<grp::part_mgr>("Partition {} has {} buffers", partitionIndex, m_partitions[partitionIndex].size());
-    return m_partitions[partitionIndex].size();
+    devlog::trace<grp::part_mgr>("Partition {} has {} buffers", partitionIndex, m_partitions[partitionIndex].count);
+    return m_partitions[partitionIndex].count;
 }
 
-uint32 CDBlock::PartitionManager::GetFreeBufferCount() const {
+uint32 PartitionManager::GetFreeBufferCount() const {
     const uint32 freeCount = m_freeBuffers - m_reservedBuffers;
     devlog::trace<grp::part_mgr>("Free buffers = {}", freeCount);
     return freeCount;
 }
 
-bool CDBlock::PartitionManager::ReserveBuffers(uint16 count) {
+bool PartitionManager::ReserveBuffers(uint16 count) {
     if (count == 0 || count > m_freeBuffers) {
         return false;
     }
@@ -72,58 +82,113 @@ bool CDBlock::PartitionManager::ReserveBuffers(uint16 count) {
     return true;
 }
 
-bool CDBlock::PartitionManager::UseReservedBuffers(uint16 count) {
-    if (count <= m_reservedBuffers) {
-        m_reservedBuffers -= count;
-        return true;
+void PartitionManager::ReleaseReservedBuffers() {
+    m_reservedBuffers = 0;
+}
+
+uint8 PartitionManager::GetReservedBuffer(uint16 index) const {
+    return index < m_reservedBuffers ? m_freeList[index] : kNoBuffer;
+}
+
+bool PartitionManager::InsertReservedBuffers(uint8 partitionIndex, uint16 count) {
+    if (count > m_reservedBuffers) {
+        return false;
     }
-    return false;
+    for (uint32 i = 0; i < count; i++) {
+        InsertHead(partitionIndex, m_freeList[i]);
+    }
+    std::copy(m_freeList.begin() + count, m_freeList.begin() + m_freeBuffers, m_freeList.begin());
+    m_freeBuffers -= count;
+    m_reservedBuffers -= count;
+    return true;
 }
 
-void CDBlock::PartitionManager::ReleaseReservedBuffers() {
-    m_reservedBuffers = 0;
+uint8 PartitionManager::PeekFreeBuffer() const {
+    return m_freeBuffers > m_reservedBuffers ? m_freeList[m_freeBuffers - 1] : kNoBuffer;
 }
 
-void CDBlock::PartitionManager::InsertHead(uint8 partitionIndex, const Buffer &buffer) {
+uint8 PartitionManager::AllocateBuffer() {
+    if (m_freeBuffers <= m_reservedBuffers) {
+        return kNoBuffer;
+    }
+    return m_freeList[--m_freeBuffers];
+}
+
+void PartitionManager::ReleaseBuffer(uint8 bufferIndex) {
+    assert(bufferIndex < kNumBuffers);
+    assert(m_freeBuffers < kNumBuffers);
+    m_freeList[m_freeBuffers++] = bufferIndex;
+}
+
+void PartitionManager::InsertHead(uint8 partitionIndex, uint8 bufferIndex) {
     assert(partitionIndex < m_partitions.size());
-    assert(m_freeBuffers > 0);
+    assert(bufferIndex < kNumBuffers);
     auto &partition = m_partitions[partitionIndex];
-    partition.push_back(buffer);
-    m_freeBuffers--;
-    devlog::trace<grp::part_mgr>("Inserted buffer into partition {} -> {} buffers; free buffers = {}", partitionIndex,
-                                 partition.size(), m_freeBuffers);
-    TracePartitionInsertHead(m_tracer, partitionIndex, buffer);
+    assert(partition.count < kNumBuffers);
+    partition.buffers[partition.count++] = bufferIndex;
+    devlog::trace<grp::part_mgr>("Inserted buffer {} into partition {} -> {} buffers; free buffers = {}", bufferIndex,
+                                 partitionIndex, partition.count, m_freeBuffers);
+    TracePartitionInsertHead(m_tracer, partitionIndex, m_buffers[bufferIndex]);
 }
 
-Buffer *CDBlock::PartitionManager::GetTail(uint8 partitionIndex, uint8 offset) {
+void PartitionManager::InsertHead(uint8 partitionIndex, const Buffer &buffer) {
+    const uint8 bufferIndex = AllocateBuffer();
+    assert(bufferIndex != kNoBuffer);
+    m_buffers[bufferIndex] = buffer;
+    InsertHead(partitionIndex, bufferIndex);
+}
+
+Buffer *PartitionManager::GetTail(uint8 partitionIndex, uint8 offset) {
     assert(partitionIndex < m_partitions.size());
-    auto &partition = m_partitions[partitionIndex];
-    if (offset < partition.size()) {
-        return &*(partition.begin() + offset);
+    const auto &partition = m_partitions[partitionIndex];
+    if (offset < partition.count) {
+        return &m_buffers[partition.buffers[offset]];
     } else {
         return nullptr;
     }
 }
 
-bool CDBlock::PartitionManager::RemoveTail(uint8 partitionIndex, uint8 offset) {
+bool PartitionManager::RemoveTail(uint8 partitionIndex, uint8 offset) {
     assert(partitionIndex < m_partitions.size());
-    auto &partition = m_partitions[partitionIndex];
-    if (offset < partition.size()) {
-        partition.erase(partition.begin() + offset);
-        m_freeBuffers++;
+    if (offset < m_partitions[partitionIndex].count) {
+        RemoveRange(partitionIndex, offset, 1);
         devlog::trace<grp::part_mgr>("Removed buffer from partition {} -> {} buffers; free buffers = {}",
-                                     partitionIndex, partition.size(), m_freeBuffers);
+                                     partitionIndex, m_partitions[partitionIndex].count, m_freeBuffers);
         TracePartitionRemoveTail(m_tracer, partitionIndex, offset);
         return true;
     }
     return false;
 }
 
-uint32 CDBlock::PartitionManager::DeleteSectors(uint8 partitionIndex, uint16 sectorPos, uint16 sectorCount) {
-    assert(partitionIndex < m_partitions.size());
+uint8 PartitionManager::DetachBuffer(uint8 partitionIndex, uint32 offset) {
+    auto &partition = m_partitions[partitionIndex];
+    assert(offset < partition.count);
+    const uint8 bufferIndex = partition.buffers[offset];
+    std::copy(partition.buffers.begin() + offset + 1, partition.buffers.begin() + partition.count,
+              partition.buffers.begin() + offset);
+    partition.count--;
+    TracePartitionRemoveTail(m_tracer, partitionIndex, offset);
+    return bufferIndex;
+}
 
+void PartitionManager::RemoveRange(uint8 partitionIndex, uint32 offset, uint32 count) {
     auto &partition = m_partitions[partitionIndex];
-    const uint32 totalSectors = partition.size();
+    assert(offset + count <= partition.count);
+    for (uint32 i = offset; i < offset + count; i++) {
+        ReleaseBuffer(partition.buffers[i]);
+    }
+    std::copy(partition.buffers.begin() + offset + count, partition.buffers.begin() + partition.count,
+              partition.buffers.begin() + offset);
+    partition.count -= count;
+}
+
+uint32 PartitionManager::DeleteSectors(uint8 partitionIndex, uint16 sectorPos, uint16 sectorCount) {
+    assert(partitionIndex < m_partitions.size());
+
+    const uint32 totalSectors = m_partitions[partitionIndex].count;
+    if (totalSectors == 0) {
+        return 0;
+    }
     uint16 start, end;
     if (sectorPos == 0xFFFF) {
         start = totalSectors - 1;
@@ -137,55 +202,71 @@ uint32 CDBlock::PartitionManager::DeleteSectors(uint8 partitionIndex, uint16 sec
     }
     start = std::min<uint16>(start, totalSectors - 1);
     end = std::min<uint16>(end, totalSectors - 1);
-    partition.erase(partition.begin() + start, partition.begin() + end + 1);
-    m_freeBuffers += end - start + 1;
+    RemoveRange(partitionIndex, start, end - start + 1);
     devlog::trace<grp::part_mgr>("Removed {} buffers from partition {} -> {} buffers; free buffers = {}",
-                                 end - start + 1, partitionIndex, partition.size(), m_freeBuffers);
+                                 end - start + 1, partitionIndex, m_partitions[partitionIndex].count, m_freeBuffers);
     TracePartitionDeleteSectors(m_tracer, partitionIndex, start, end);
     return end - start + 1;
 }
 
-void CDBlock::PartitionManager::Clear(uint8 partitionIndex) {
+void PartitionManager::Clear(uint8 partitionIndex) {
     assert(partitionIndex < m_partitions.size());
     auto &partition = m_partitions[partitionIndex];
-    m_freeBuffers += partition.size();
-    devlog::trace<grp::part_mgr>("Cleared all {} buffers from partition {}; free buffers = {}", partition.size(),
-                                 partitionIndex, m_freeBuffers);
-    partition.clear();
+    devlog::trace<grp::part_mgr>("Cleared all {} buffers from partition {}; free buffers = {}", partition.count,
+                                 partitionIndex, m_freeBuffers + partition.count);
+    RemoveRange(partitionIndex, 0, partition.count);
     TracePartitionClear(m_tracer, partitionIndex);
 }
 
-uint32 CDBlock::PartitionManager::CalculateSize(uint8 partitionIndex, uint32 start, uint32 end) const {
+uint32 PartitionManager::CalculateSize(uint8 partitionIndex, uint32 start, uint32 end) const {
     assert(partitionIndex < m_partitions.size());
-    auto &partition = m_partitions[partitionIndex];
-    start = std::min<uint32>(start, partition.size() - 1);
-    end = std::min<uint32>(end, partition.size() - 1);
-    const uint32 size = std::accumulate(partition.begin() + start, partition.begin() + end + 1, 0u,
-                                        [](const uint32 lhs, const Buffer &rhs) { return lhs + rhs.size; });
+    const auto &partition = m_partitions[partitionIndex];
+    start = std::min<uint32>(start, partition.count - 1);
+    end = std::min<uint32>(end, partition.count - 1);
+    uint32 size = 0;
+    for (uint32 i = start; i <= end && i < partition.count; i++) {
+        size += m_buffers[partition.buffers[i]].size;
+    }
     devlog::trace<grp::part_mgr>("Calculated partition {} size from {} to {} = {} bytes", partitionIndex, start, end,
                                  size);
     return size;
 }
 
-void CDBlock::PartitionManager::SaveState(savestate::CDBlockSaveState &state) const {
-    size_t bufferIndex = 0;
+void PartitionManager::SaveState(savestate::CDBlockSaveState &state) const {
+    size_t stateIndex = 0;
     for (size_t i = 0; i < m_partitions.size(); i++) {
-        for (const auto &buffer : m_partitions[i]) {
-            state.buffers[bufferIndex].data = buffer.data;
-            state.buffers[bufferIndex].size = buffer.size;
-            state.buffers[bufferIndex].frameAddress = buffer.frameAddress;
-            state.buffers[bufferIndex].fileNum = buffer.subheader.fileNum;
-            state.buffers[bufferIndex].chanNum = buffer.subheader.chanNum;
-            state.buffers[bufferIndex].submode = buffer.subheader.submode;
-            state.buffers[bufferIndex].codingInfo = buffer.subheader.codingInfo;
-            state.buffers[bufferIndex].partitionIndex = i;
-            bufferIndex++;
+        const auto &partition = m_partitions[i];
+        for (uint32 j = 0; j < partition.count; j++) {
+            const Buffer &buffer = m_buffers[partition.buffers[j]];
+            state.buffers[stateIndex].data = buffer.data;
+            state.buffers[stateIndex].size = buffer.size;
+            state.buffers[stateIndex].frameAddress = buffer.frameAddress;
+            state.buffers[stateIndex].fileNum = buffer.subheader.fileNum;
+            state.buffers[stateIndex].chanNum = buffer.subheader.chanNum;
+            state.buffers[stateIndex].submode = buffer.subheader.submode;
+            state.buffers[stateIndex].codingInfo = buffer.subheader.codingInfo;
+            state.buffers[stateIndex].partitionIndex = i;
+            stateIndex++;
         }
     }
+
+    // Reserved buffers may hold data written by a sector transfer in progress; store them after the partition buffers
+    for (uint32 i = 0; i < m_reservedBuffers; i++) {
+        const Buffer &buffer = m_buffers[m_freeList[i]];
+        state.buffers[stateIndex].data = buffer.data;
+        state.buffers[stateIndex].size = buffer.size;
+        state.buffers[stateIndex].frameAddress = buffer.frameAddress;
+        state.buffers[stateIndex].fileNum = buffer.subheader.fileNum;
+        state.buffers[stateIndex].chanNum = buffer.subheader.chanNum;
+        state.buffers[stateIndex].submode = buffer.subheader.submode;
+        state.buffers[stateIndex].codingInfo = buffer.subheader.codingInfo;
+        state.buffers[stateIndex].partitionIndex = 0xFF;
+        stateIndex++;
+    }
     state.reservedBuffers = m_reservedBuffers;
 }
 
-bool CDBlock::PartitionManager::ValidateState(const savestate::CDBlockSaveState &state) const {
+bool PartitionManager::ValidateState(const savestate::CDBlockSaveState &state) const {
     uint32 usedBuffers = 0u;
     for (const auto &buffer : state.buffers) {
         if (buffer.partitionIndex < kNumPartitions) {
@@ -200,33 +281,48 @@ bool CDBlock::PartitionManager::ValidateState(const savestate::CDBlockSaveState
     return true;
 }
 
-void CDBlock::PartitionManager::LoadState(const savestate::CDBlockSaveState &state) {
-    for (auto &partition : m_partitions) {
-        partition.clear();
-    }
-    m_freeBuffers = kNumBuffers;
+void PartitionManager::LoadState(const savestate::CDBlockSaveState &state) {
+    ResetPool();
+
+    auto loadBuffer = [](Buffer &partBuffer, const savestate::CDBlockSaveState::BufferSaveState &buffer) {
+        partBuffer.data = buffer.data;
+        partBuffer.size = buffer.size;
+        partBuffer.frameAddress = buffer.frameAddress;
+        partBuffer.subheader.fileNum = buffer.fileNum;
+        partBuffer.subheader.chanNum = buffer.chanNum;
+        partBuffer.subheader.submode = buffer.submode;
+        partBuffer.subheader.codingInfo = buffer.codingInfo;
+    };
 
+    uint32 usedBuffers = 0;
     for (const auto &buffer : state.buffers) {
         if (buffer.partitionIndex < kNumPartitions) {
-            auto &partBuffer = m_partitions[buffer.partitionIndex].emplace_back();
-            partBuffer.data = buffer.data;
-            partBuffer.size = buffer.size;
-            partBuffer.frameAddress = buffer.frameAddress;
-            partBuffer.subheader.fileNum = buffer.fileNum;
-            partBuffer.subheader.chanNum = buffer.chanNum;
-            partBuffer.subheader.submode = buffer.submode;
-            partBuffer.subheader.codingInfo = buffer.codingInfo;
-            --m_freeBuffers;
+            const uint8 bufferIndex = AllocateBuffer();
+            loadBuffer(m_buffers[bufferIndex], buffer);
+            auto &partition = m_partitions[buffer.partitionIndex];
+            partition.buffers[partition.count++] = bufferIndex;
+            ++usedBuffers;
         }
     }
+
+    // Reserved buffers follow the partition buffers
     m_reservedBuffers = state.reservedBuffers;
+    for (uint32 i = 0; i < m_reservedBuffers; i++) {
+        loadBuffer(m_buffers[m_freeList[i]], state.buffers[usedBuffers + i]);
+    }
     OnTracerAttached();
 }
 
-void CDBlock::PartitionManager::OnTracerAttached() {
+void PartitionManager::OnTracerAttached() {
     if (m_tracer) {
+        std::deque<Buffer> buffers{};
         for (uint8 i = 0; i < kNumPartitions; ++i) {
-            m_tracer->PartitionSync(i, m_partitions[i]);
+            buffers.clear();
+            const auto &partition = m_partitions[i];
+            for (uint32 j = 0; j < partition.count; j++) {
+                buffers.push_back(m_buffers[partition.buffers[j]]);
+            }
+            m_tracer->PartitionSync(i, buffers);
         }
     }
 }
@@ -128,13 +128,19 @@ void YGR::MapMemory(sys::SH2Bus &mainBus) {
         // 32-bit reads from FIFO at 0x25890000 pull one word.
         // 32-bit reads from FIFO at 0x25810000 pull two words.
         if (address & 0x80000) {
-            mainBus.MapNormal(address, address + 0xFFF, this, [](uint32 address, void *ctx) -> uint32 {
-                return cast(ctx).HostReadLong<false>(address);
-            });
+            mainBus.MapNormal(
+                address, address + 0xFFF, this,
+                [](uint32 address, void *ctx) -> uint32 { return cast(ctx).HostReadLong<false>(address); },
+                [](uint32 address, std::span<uint32> out, void *ctx) -> uint32 {
+                    return cast(ctx).HostReadLongBulk<false>(address, out);
+                });
         } else {
-            mainBus.MapNormal(address, address + 0xFFF, this, [](uint32 address, void *ctx) -> uint32 {
-                return cast(ctx).HostReadLong<true>(address);
-            });
+            mainBus.MapNormal(
+                address, address + 0xFFF, this,
+                [](uint32 address, void *ctx) -> uint32 { return cast(ctx).HostReadLong<true>(address); },
+                [](uint32 address, std::span<uint32> out, void *ctx) -> uint32 {
+                    return cast(ctx).HostReadLongBulk<true>(address, out);
+                });
         }
 
         mainBus.MapSideEffectFree(
@@ -482,6 +488,19 @@ uint32 YGR::HostReadLong(uint32 address) const {
     }
 }
 
+template <bool doubleFIFOPull>
+uint32 YGR::HostReadLongBulk(uint32 address, std::span<uint32> out) const {
+    uint32 count = 0;
+    for (; count < out.size(); ++count) {
+        // Stop where the bus wait handler would stall the access
+        if ((address & 0x3C) == 0x00 && m_regs.TRCTL.TE && m_fifo.Used() < sizeof(uint32) / sizeof(uint16)) {
+            break;
+        }
+        out[count] = HostReadLong<doubleFIFOPull>(address);
+    }
+    return count;
+}
+
 template <bool poke>
 FORCE_INLINE void YGR::HostWriteWord(uint32 address, uint16 value) {
     address &= 0x3C;
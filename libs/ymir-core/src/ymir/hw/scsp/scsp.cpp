@@ -2,12 +2,18 @@
 
 #include <ymir/sys/clocks.hpp>
 
+#include <ymir/util/dev_assert.hpp>
 #include <ymir/util/scope_guard.hpp>
 #include <ymir/util/thread_name.hpp>
 
 #include <algorithm>
 #include <limits>
 #include <ostream>
+#include <thread>
+
+#if defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64)
+    #include <immintrin.h>
+#endif
 
 using namespace ymir::m68k;
 
@@ -86,6 +92,7 @@ void SCSP::Reset(bool hard) {
     m_m68k.Reset(true);
     m_m68kSpilloverCycles = 0;
     m_m68kEnabled = false;
+    m_m68kPublishedPC = m_m68k.GetPC();
 
     m_m68kCycles = 0;
     m_sampleCounter = 0;
@@ -95,6 +102,7 @@ void SCSP::Reset(bool hard) {
     m_currSlot = 0;
 
     m_out.fill(0);
+    m_sampleBlockCount = 0;
 
     if (hard) {
         m_scheduler.ScheduleFromNow(m_sampleTickEvent, kCyclesPerSample);
@@ -135,13 +143,8 @@ void SCSP::Reset(bool hard) {
 
     m_dsp.Reset();
 
-    // Clear write queue
-    ThreadEvent dummy;
-    while (m_threadEventQueue.try_dequeue(m_ctokThreadEventQueue, dummy)) {
-    }
-
-    m_scspInterruptLevel = false;
-    m_lastSCSPInterruptLevel = false;
+    m_journalSCUEnabledInterrupts = m_scuEnabledInterrupts;
+    m_scspThreadInterruptLevel = false;
 }
 
 void SCSP::MapMemoryDirect(sys::SH2Bus &bus) {
@@ -239,16 +242,20 @@ void SCSP::SetDebugTracing(bool enable) {
     }
 }
 
-uint32 SCSP::ReceiveCDDA(std::span<uint8, 2352> data) {
-    if (m_threadedSCSP) {
-        m_cddaMutex.lock();
+std::array<sint16, 2> SCSP::ReadCDDASample() {
+    if (m_cddaReady && m_cddaReadPos != m_cddaWritePos) {
+        const sint16 left = util::ReadLE<uint16>(&m_cddaBuffer[m_cddaReadPos + 0]);
+        const sint16 right = util::ReadLE<uint16>(&m_cddaBuffer[m_cddaReadPos + 2]);
+        m_cddaReadPos = (m_cddaReadPos + 2 * sizeof(uint16)) % m_cddaBuffer.size();
+        return {left, right};
     }
-    util::ScopeGuard sgUnlock{[&] {
-        if (m_threadedSCSP) {
-            m_cddaMutex.unlock();
-        }
-    }};
 
+    // Buffer underrun
+    m_cddaReady = false;
+    return {0, 0};
+}
+
+uint32 SCSP::ReceiveCDDA(std::span<uint8, 2352> data) {
     std::copy_n(data.begin(), 2352, m_cddaBuffer.begin() + m_cddaWritePos);
     m_cddaWritePos = (m_cddaWritePos + 2352) % m_cddaBuffer.size();
     sint32 len = static_cast<sint32>(m_cddaWritePos) - m_cddaReadPos;
@@ -407,6 +414,9 @@ void SCSP::DumpDSPRegs(std::ostream &out) const {
 }
 
 void SCSP::SetCPUEnabled(bool enabled) {
+    if (m_threadedSCSP) {
+        SyncSCSPThread();
+    }
     if (m_m68kEnabled != enabled) {
         devlog::info<grp::base>("MC68EC00 processor {}", (enabled ? "enabled" : "disabled"));
         if (enabled) {
@@ -538,6 +548,10 @@ void SCSP::LoadState(const savestate::SCSPSaveState &state) {
     m_m68k.LoadState(state.m68k);
     m_m68kSpilloverCycles = state.m68kSpilloverCycles;
     m_m68kEnabled = state.m68kEnabled;
+    m_m68kPublishedPC = m_m68k.GetPC();
+
+    // Samples buffered before the load belong to the discarded timeline
+    m_sampleBlockCount = 0;
 
     for (size_t i = 0; i < 32; i++) {
         m_slots[i].LoadState(state.slots[i]);
@@ -593,13 +607,8 @@ void SCSP::LoadState(const savestate::SCSPSaveState &state) {
     m_midiOutputSize = state.midiOutputSize;
     m_expectedOutputPacketSize = state.expectedOutputPacketSize;
 
-    // Clear write queue
-    ThreadEvent dummy;
-    while (m_threadEventQueue.try_dequeue(m_ctokThreadEventQueue, dummy)) {
-    }
-
-    m_scspInterruptLevel = (m_scuPendingInterrupts & m_scuEnabledInterrupts) != 0;
-    m_lastSCSPInterruptLevel = m_scspInterruptLevel;
+    m_journalSCUEnabledInterrupts = m_scuEnabledInterrupts;
+    m_scspThreadInterruptLevel = (m_scuPendingInterrupts & m_scuEnabledInterrupts) != 0;
 
     // Realign the tick event if the save state was using a more granular slot step
     if (m_stepGranularity <= 5u && (m_currSlot & ((1u << m_stepGranularity) - 1u)) != 0) {
@@ -738,11 +747,19 @@ void SCSP::EnableThreading(bool enable) {
         return;
     }
 
-    m_threadedSCSP = enable;
-
     if (enable) {
         devlog::debug<grp::base>("Enabling threaded SCSP");
 
+        m_journalSample = 0;
+        m_journalSCUEnabledInterrupts = m_scuEnabledInterrupts;
+        m_scspThreadSample = 0;
+        m_scspThreadInterruptLevel = (m_scuPendingInterrupts & m_scuEnabledInterrupts) != 0;
+        m_interruptEventsPublished = 0;
+        m_interruptEventsDelivered = 0;
+        m_interruptSamplesPublished = 0;
+        m_publishedSCUEnabledInterrupts = m_scuEnabledInterrupts;
+        m_threadedSCSP = true;
+
         if (m_bus) {
             MapMemoryThreaded(*m_bus);
         }
@@ -752,6 +769,9 @@ void SCSP::EnableThreading(bool enable) {
     } else {
         devlog::debug<grp::base>("Disabling threaded SCSP");
 
+        // Catch up and deliver any pending interrupt changes before the SCSP returns to this thread
+        SyncSCSPThread();
+        m_threadedSCSP = false;
         StopSCSPThread();
 
         if (m_bus) {
@@ -880,6 +900,7 @@ void SCSP::ExecuteDMA() {
 
 template <uint32 stepShift, bool debug>
 FORCE_INLINE void SCSP::TickSlots() {
+    YMIR_HOST_TIMER(m_hostTiming, debug::HostTimingComponent::SCSP);
     RunM68K(kM68KCyclesPerSlot << stepShift);
     ProcessMidiInputQueue<false>();
     StepSlots<stepShift, false>();
@@ -887,6 +908,7 @@ FORCE_INLINE void SCSP::TickSlots() {
 
 template <bool debug, bool threaded>
 FORCE_INLINE void SCSP::TickSample() {
+    YMIR_HOST_TIMER(m_hostTiming, debug::HostTimingComponent::SCSP);
     RunM68K(kM68KCyclesPerSample);
     ProcessMidiInputQueue<threaded>();
     StepSample<debug, threaded>();
@@ -900,6 +922,7 @@ FORCE_INLINE void SCSP::RunM68K(uint64 cycles) {
             cy += m_m68k.Step();
         }
         m_m68kSpilloverCycles = cy - cycles;
+        m_m68kPublishedPC.store(m_m68k.GetPC(), std::memory_order_relaxed);
     }
 }
 
@@ -927,16 +950,26 @@ FORCE_INLINE void SCSP::StepSlots() {
 template <bool debug, bool threaded>
 FORCE_INLINE void SCSP::StepSample() {
     assert(m_currSlot == 0);
+    if constexpr (threaded) {
+        // Slots and the DSP never touch interrupt state, so the interrupts signaled at the end of the sample can be
+        // raised and published before processing them
+        RaiseSampleInterrupts(m_sampleCounter + 1);
+        PublishSCUInterruptSample();
+    }
     for (uint32 i = 0; i < 32; ++i) {
         ProcessSlots<debug, threaded>(i);
     }
-    IncrementSampleCounter();
+    if constexpr (threaded) {
+        ++m_sampleCounter;
+    } else {
+        IncrementSampleCounter();
+    }
 }
 
-FORCE_INLINE void SCSP::UpdateTimers() {
+FORCE_INLINE void SCSP::UpdateTimers(uint64 sampleCounter) {
     for (int i = 0; i < 3; i++) {
         auto &timer = m_timers[i];
-        const bool trigger = (m_sampleCounter & timer.incrementMask) == 0;
+        const bool trigger = (sampleCounter & timer.incrementMask) == 0;
         if (trigger && timer.Tick()) {
             SetInterrupt(kIntrTimerA + i, true);
         }
@@ -1036,30 +1069,21 @@ FORCE_INLINE void SCSP::ProcessSlots(uint32 i) {
         }
 
         // Write to output and reset
+        if constexpr (!threaded) {
+            ++m_outputSampleCount;
+        }
         m_cbOutputSample(m_out[0], m_out[1]);
+        m_sampleBlock[m_sampleBlockCount++] = {static_cast<sint16>(m_out[0]), static_cast<sint16>(m_out[1])};
+        if (m_sampleBlockCount == kSampleBlockSize) {
+            FlushSampleBlock();
+        }
         m_out.fill(0);
 
         // Copy CDDA data to DSP EXTS (0=left, 1=right)
-        {
-            if constexpr (threaded) {
-                m_cddaMutex.lock();
-            }
-            util::ScopeGuard sgUnlock{[&] {
-                if constexpr (threaded) {
-                    m_cddaMutex.unlock();
-                }
-            }};
-
-            if (m_cddaReady && m_cddaReadPos != m_cddaWritePos) {
-                m_dsp.audioInOut[0] = util::ReadLE<uint16>(&m_cddaBuffer[m_cddaReadPos + 0]);
-                m_dsp.audioInOut[1] = util::ReadLE<uint16>(&m_cddaBuffer[m_cddaReadPos + 2]);
-                m_cddaReadPos = (m_cddaReadPos + 2 * sizeof(uint16)) % m_cddaBuffer.size();
-            } else {
-                // Buffer underrun
-                m_dsp.audioInOut[0] = 0;
-                m_dsp.audioInOut[1] = 0;
-                m_cddaReady = false;
-            }
+        // The CDDA buffer belongs to the emulator thread; in threaded mode, the samples are read by TickSampleThreaded
+        // and replayed from the journal.
+        if constexpr (!threaded) {
+            m_dsp.audioInOut = ReadCDDASample();
         }
     }
 
@@ -1068,11 +1092,31 @@ FORCE_INLINE void SCSP::ProcessSlots(uint32 i) {
 
 FORCE_INLINE void SCSP::IncrementSampleCounter() {
     ++m_sampleCounter;
-    UpdateTimers();
+    RaiseSampleInterrupts(m_sampleCounter);
+}
+
+FORCE_INLINE void SCSP::RaiseSampleInterrupts(uint64 sampleCounter) {
+    UpdateTimers(sampleCounter);
     SetInterrupt(kIntrSample, true);
     UpdateM68KInterrupts();
 }
 
+void SCSP::FlushSampleBlock() {
+    if (m_sampleBlockCount > 0) {
+        m_cbOutputSampleBlock(std::span<const OutputSample>{m_sampleBlock.data(), m_sampleBlockCount});
+        m_sampleBlockCount = 0;
+    }
+}
+
+void SCSP::FlushOutput() {
+    if (m_threadedSCSP) {
+        CurrentJournalBatch().flushOutput = true;
+        SubmitJournalBatch();
+    } else {
+        FlushSampleBlock();
+    }
+}
+
 FORCE_INLINE void SCSP::AddOutput(sint32 output, uint8 sendLevel, uint8 pan) {
     if (sendLevel == 0) { // = -infinity dB
         return;
@@ -1377,55 +1421,108 @@ SCSP::Probe::Probe(SCSP &scsp)
 // -----------------------------------------------------------------------------
 // Threaded execution and synchronization implementation
 
+// Number of polls before a waiting thread gives up its time slice. The emulator thread waits for a single sample's
+// worth of M68K execution at a time, so the SCSP thread usually picks up the next sample while still spinning.
+static constexpr uint32 kSpinIterations = 4096;
+
+FORCE_INLINE static void SpinPause() {
+#if defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #if defined(_MSC_VER)
+    __yield();
+    #else
+    asm volatile("yield");
+    #endif
+#endif
+}
+
+// Spins for a while, then yields the time slice on every call.
+FORCE_INLINE static void Backoff(uint32 &spins) {
+    if (spins < kSpinIterations) {
+        ++spins;
+        SpinPause();
+    } else {
+        std::this_thread::yield();
+    }
+}
+
 void SCSP::SCSPThreadLoop() {
     util::SetCurrentThreadName("SCSP thread");
 
-    std::array<ThreadEvent, 64> events{};
-
+    uint64 processed = m_journalProcessed.load(std::memory_order_relaxed);
     while (m_threadRunning) {
-        const size_t numEvents =
-            m_threadEventQueue.wait_dequeue_bulk(m_ctokThreadEventQueue, events.begin(), events.size());
-        for (size_t i = 0; i < numEvents; ++i) {
-            const auto &evt = events[i];
-
-            switch (evt.type) {
-            case ThreadEvent::Type::Write: //
-            {
-                const bool isReg = (evt.write.address >= 0x5B0'0000);
-                if (isReg) {
-                    if (evt.write.size == 1) {
-                        WriteReg<uint8, SCSPAccessType::SCU>(evt.write.address & 0xFFF,
-                                                             static_cast<uint8>(evt.write.value));
-                    } else {
-                        WriteReg<uint16, SCSPAccessType::SCU>(evt.write.address & 0xFFF,
-                                                              static_cast<uint16>(evt.write.value));
-                    }
-                } else {
-                    if (evt.write.size == 1) {
-                        WriteWRAM<uint8>(evt.write.address & 0x7FFFF, static_cast<uint8>(evt.write.value));
-                    } else {
-                        WriteWRAM<uint16>(evt.write.address & 0x7FFFF, static_cast<uint16>(evt.write.value));
-                    }
-                }
-                break;
+        // Wait for the next batch
+        uint64 submitted = m_journalSubmitted.load(std::memory_order_acquire);
+        for (uint32 i = 0; submitted == processed && i < kSpinIterations; ++i) {
+            SpinPause();
+            submitted = m_journalSubmitted.load(std::memory_order_acquire);
+        }
+        while (submitted == processed) {
+            m_journalSubmitted.wait(submitted, std::memory_order_acquire);
+            submitted = m_journalSubmitted.load(std::memory_order_acquire);
+        }
+
+        auto &batch = m_journal[processed % kJournalDepth];
+        ProcessJournalBatch(batch);
+        if (batch.quit) {
+            m_threadRunning = false;
+        }
+
+        ++processed;
+        m_journalProcessed.store(processed, std::memory_order_release);
+        m_journalProcessed.notify_all();
+    }
+}
+
+void SCSP::ProcessJournalBatch(JournalBatch &batch) {
+    uint32 sample = 0;
+    auto runUntil = [&](uint32 target) {
+        for (; sample < target; ++sample) {
+            ++m_scspThreadSample;
+            if (m_debugTracing) {
+                TickSample<true, true>();
+            } else {
+                TickSample<false, true>();
             }
+        }
+    };
 
-            case ThreadEvent::Type::Sample:
-                // Process one sample
-                if (m_debugTracing) {
-                    TickSample<true, true>();
+    for (uint32 i = 0; i < batch.numEntries; ++i) {
+        const auto &entry = batch.entries[i];
+        runUntil(entry.sample);
+
+        switch (entry.type) {
+        case JournalEntry::Type::Write: //
+        {
+            const bool isReg = (entry.address >= 0x5B0'0000);
+            if (isReg) {
+                if (entry.size == 1) {
+                    WriteReg<uint8, SCSPAccessType::SCU>(entry.address & 0xFFF, static_cast<uint8>(entry.value));
                 } else {
-                    TickSample<false, true>();
+                    WriteReg<uint16, SCSPAccessType::SCU>(entry.address & 0xFFF, static_cast<uint16>(entry.value));
+                }
+            } else {
+                if (entry.size == 1) {
+                    WriteWRAM<uint8>(entry.address & 0x7FFFF, static_cast<uint8>(entry.value));
+                } else {
+                    WriteWRAM<uint16>(entry.address & 0x7FFFF, static_cast<uint16>(entry.value));
                 }
-                break;
-
-            case ThreadEvent::Type::Quit: m_threadRunning = false; break;
             }
+            break;
+        }
 
-            m_eventsProcessed.fetch_add(1, std::memory_order_release);
-            m_eventsProcessed.notify_all();
+        case JournalEntry::Type::CDDA:
+            m_dsp.audioInOut[0] = static_cast<sint16>(entry.value >> 0u);
+            m_dsp.audioInOut[1] = static_cast<sint16>(entry.value >> 16u);
+            break;
         }
     }
+    runUntil(batch.numSamples);
+
+    if (batch.flushOutput) {
+        FlushSampleBlock();
+    }
 }
 
 void SCSP::SyncSCSPThread() {
@@ -1433,42 +1530,102 @@ void SCSP::SyncSCSPThread() {
         return;
     }
 
-    uint64 target = m_eventsProcessed.load();
-    while (target != m_eventsEnqueued) {
-        m_eventsProcessed.wait(target, std::memory_order_acquire);
-        target = m_eventsProcessed.load(std::memory_order_acquire);
+    if (!CurrentJournalBatch().IsEmpty()) {
+        SubmitJournalBatch();
+    }
+
+    // Keep delivering interrupts while waiting so that the SCSP thread never stalls on a full event ring
+    const uint64 submitted = m_journalSubmitted.load(std::memory_order_relaxed);
+    for (uint32 spins = 0; m_journalProcessed.load(std::memory_order_acquire) != submitted; Backoff(spins)) {
+        DeliverSCSPInterrupts();
     }
 
-    PollSCSPInterrupts();
+    // The SCSP thread is idle now; its state can be inspected freely
+    m_journalSCUEnabledInterrupts = m_scuEnabledInterrupts;
+    DeliverSCSPInterrupts();
 }
 
 void SCSP::StopSCSPThread() {
     if (m_scspThread.joinable()) {
-        EnqueueEvent(ThreadEvent::Quit());
+        CurrentJournalBatch().quit = true;
+        SubmitJournalBatch();
         m_scspThread.join();
     }
 }
 
-void SCSP::PollSCSPInterrupts() {
-    if (!m_threadedSCSP) {
+void SCSP::PublishSCUInterrupt(bool level) {
+    if (level == m_scspThreadInterruptLevel) {
         return;
     }
-    bool expected = m_lastSCSPInterruptLevel;
-    bool current = m_scspInterruptLevel.load(std::memory_order_relaxed);
-    if (expected != current) {
-        m_lastSCSPInterruptLevel = current;
-        m_cbTriggerSoundRequestInterrupt(current);
+    m_scspThreadInterruptLevel = level;
+
+    const uint64 published = m_interruptEventsPublished.load(std::memory_order_relaxed);
+    for (uint32 spins = 0;
+         published - m_interruptEventsDelivered.load(std::memory_order_acquire) >= kInterruptEventCount;
+         Backoff(spins)) {
     }
+    m_interruptEvents[published % kInterruptEventCount] = {.sample = m_scspThreadSample, .level = level};
+    m_interruptEventsPublished.store(published + 1, std::memory_order_release);
 }
 
-template <mem_primitive T>
-void SCSP::EnqueueWrite(uint32 address, T value) {
-    EnqueueEvent(ThreadEvent::Write(address, static_cast<uint32>(value), static_cast<uint8>(sizeof(T))));
+void SCSP::PublishSCUInterruptSample() {
+    m_publishedSCUEnabledInterrupts.store(m_scuEnabledInterrupts, std::memory_order_relaxed);
+    m_interruptSamplesPublished.store(m_scspThreadSample, std::memory_order_release);
 }
 
-void SCSP::EnqueueEvent(ThreadEvent &&event) {
-    ++m_eventsEnqueued;
-    m_threadEventQueue.enqueue(m_ptokThreadEventQueue, std::move(event));
+void SCSP::WaitForSCSPInterrupts() {
+    for (uint32 spins = 0; m_interruptSamplesPublished.load(std::memory_order_acquire) < m_journalSample;
+         Backoff(spins)) {
+        DeliverSCSPInterrupts();
+    }
+    m_journalSCUEnabledInterrupts = m_publishedSCUEnabledInterrupts.load(std::memory_order_relaxed);
+    DeliverSCSPInterrupts();
+}
+
+void SCSP::DeliverSCSPInterrupts() {
+    // The delivered count is updated before each callback in case the SCU reenters the SCSP
+    uint64 delivered = m_interruptEventsDelivered.load(std::memory_order_relaxed);
+    while (delivered != m_interruptEventsPublished.load(std::memory_order_acquire)) {
+        const InterruptEvent event = m_interruptEvents[delivered % kInterruptEventCount];
+        m_interruptEventsDelivered.store(++delivered, std::memory_order_release);
+
+        // Changes must reach the SCU on the sample they happened on to match single-threaded execution
+        YMIR_DEV_ASSERT(event.sample == m_journalSample);
+        m_cbTriggerSoundRequestInterrupt(event.level);
+    }
+}
+
+void SCSP::AppendJournalEntry(const JournalEntry &entry) {
+    auto &batch = CurrentJournalBatch();
+    batch.entries[batch.numEntries++] = entry;
+    if (batch.numEntries == kJournalBatchEntries) {
+        SubmitJournalBatch();
+    }
+}
+
+void SCSP::SubmitJournalBatch() {
+    const uint64 submitted = m_journalSubmitted.load(std::memory_order_relaxed) + 1;
+    m_journalSubmitted.store(submitted, std::memory_order_release);
+    m_journalSubmitted.notify_all();
+
+    // Wait until the SCSP thread releases the slot for the next batch
+    for (uint32 spins = 0; submitted - m_journalProcessed.load(std::memory_order_acquire) >= kJournalDepth;
+         Backoff(spins)) {
+        DeliverSCSPInterrupts();
+    }
+
+    m_journal[submitted % kJournalDepth].Clear();
+}
+
+template <mem_primitive T>
+void SCSP::EnqueueWrite(uint32 address, T value) {
+    AppendJournalEntry(JournalEntry{
+        .sample = CurrentJournalBatch().numSamples,
+        .address = address,
+        .value = static_cast<uint32>(value),
+        .size = static_cast<uint8>(sizeof(T)),
+        .type = JournalEntry::Type::Write,
+    });
 }
 
 template void SCSP::EnqueueWrite<uint8>(uint32 address, uint8 value);
@@ -1506,6 +1663,12 @@ template <mem_primitive T>
 void SCSP::WriteRegBus(uint32 address, T value) {
     if (m_threadedSCSP) {
         EnqueueWrite<T>(address, value);
+
+        // Writes may change the sound request interrupt signal while it is enabled, and writes to MCIEB may enable it
+        const bool isMCIEB = (address & 0xFFE) == 0x42A;
+        if (m_journalSCUEnabledInterrupts != 0 || isMCIEB) {
+            SyncSCSPThread();
+        }
     } else {
         WriteReg<T, SCSPAccessType::SCU>(address, value);
     }
@@ -1515,8 +1678,26 @@ template void SCSP::WriteRegBus<uint8>(uint32 address, uint8 value);
 template void SCSP::WriteRegBus<uint16>(uint32 address, uint16 value);
 
 void SCSP::TickSampleThreaded() {
-    EnqueueEvent(ThreadEvent::Sample());
-    PollSCSPInterrupts();
+    // Read CDDA on this thread and hand the samples to the SCSP thread, to be applied at the end of this sample
+    const auto cdda = ReadCDDASample();
+
+    auto &batch = CurrentJournalBatch();
+    ++batch.numSamples;
+    ++m_journalSample;
+    ++m_outputSampleCount;
+    batch.entries[batch.numEntries++] = JournalEntry{
+        .sample = batch.numSamples,
+        .value = static_cast<uint16>(cdda[0]) | (static_cast<uint32>(static_cast<uint16>(cdda[1])) << 16u),
+        .type = JournalEntry::Type::CDDA,
+    };
+
+    if (IsSCSPInterruptLive()) {
+        // Hand the sample over right away and deliver its sound request interrupt changes on time
+        SubmitJournalBatch();
+        WaitForSCSPInterrupts();
+    } else if (batch.numSamples == kJournalBatchSamples || batch.numEntries == kJournalBatchEntries) {
+        SubmitJournalBatch();
+    }
 }
 
 template <uint32 stepShift>
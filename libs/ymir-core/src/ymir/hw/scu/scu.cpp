@@ -489,8 +489,12 @@ void SCU::LoadState(const savestate::SCUSaveState &state) {
     }
     case savestate::SCUSaveState::CartType::ROM: //
     {
-        auto *cart = m_cartSlot.InsertCartridge<cart::ROMCartridge>();
-        cart->LoadROM(std::span<const uint8, 4_MiB>(state.cartData.begin(), 4_MiB));
+        // Keep the inserted cartridge if it holds the same ROM so that shared ROM images stay shared
+        const auto *current = m_cartSlot.GetCartridge().As<cart::CartType::ROM>();
+        if (current == nullptr || !current->HasROM(state.cartData)) {
+            auto *cart = m_cartSlot.InsertCartridge<cart::ROMCartridge>();
+            cart->LoadROM(std::span<const uint8, 4_MiB>(state.cartData.begin(), 4_MiB));
+        }
         break;
     }
     default: break;
@@ -828,7 +832,35 @@ void SCU::RunDMA(uint64 cycles) {
             }
 
             // 32-bit transfers -- the bulk of the DMA operation
+            // Reads from a fixed A-Bus address (typically the CD block data port) are pulled in runs with a single bus
+            // call once the prefetch buffer is drained. This is equivalent to reading them one by one with read32().
+            const bool bulkRead = srcBus == BusID::ABus && ch.currSrcAddrInc == 0;
             while (ch.currXferCount >= 4) {
+                if (bulkRead && xfer.bufPos == 4) {
+                    std::array<uint32, 128> values;
+                    const uint32 count = std::min<uint32>(ch.currXferCount / 4, values.size());
+                    const uint32 readCount = m_bus.BulkRead(ch.currSrcAddr & ~3u, std::span{values}.first(count));
+                    for (uint32 i = 0; i < readCount; ++i) {
+                        incDst();
+                        const uint32 addr = (currDstAddr + currDstOffset) & ~3u;
+                        m_bus.Write<uint32>(addr, values[i]);
+                        currDstOffset += 4;
+                    }
+                    ch.currXferCount -= readCount * 4;
+                    if (readCount > 0) {
+                        xfer.buf = values[readCount - 1];
+                    }
+                    devlog::trace<grp::dma>("SCU DMA{}: Bulk 32-bit read from {:08X} -> {} longwords, {:X} bytes "
+                                            "remaining",
+                                            level, ch.currSrcAddr & ~3u, readCount, ch.currXferCount);
+                    if (readCount < count) {
+                        // Stalled by the bus wait signal
+                        incDst();
+                        return;
+                    }
+                    continue;
+                }
+
                 incDst();
                 const uint32 addr = (currDstAddr + currDstOffset) & ~3u;
                 if (checkReadStall(sizeof(uint32)) || checkWriteStall(addr, sizeof(uint32))) {
@@ -33,6 +33,7 @@ void SCUDSP::Reset(bool hard) {
         for (auto &bank : dataRAM) {
             bank.fill(0);
         }
+        TranslateProgram();
     }
 
     programExecuting = false;
@@ -44,6 +45,7 @@ void SCUDSP::Reset(bool hard) {
     dataAddress = 0;
 
     nextInstr.u32 = 0;
+    m_nextInstrAddress = 0;
 
     sign = false;
     zero = false;
@@ -100,7 +102,9 @@ FLATTEN void SCUDSP::Run(uint64 cycles) {
 
         // Execute next command and fetch next instruction
         const DSPInstr instruction = nextInstr;
+        const uint8 instrAddress = m_nextInstrAddress;
         nextInstr = programRAM[PC];
+        m_nextInstrAddress = PC;
 
         // const bool doDMA = dmaRun;
         if (dmaRun) {
@@ -111,10 +115,20 @@ FLATTEN void SCUDSP::Run(uint64 cycles) {
             }
         }
 
-        switch (instruction.instructionInfo.instructionClass) {
-        case 0b00: Cmd_Operation<debug>(instruction); break;
-        case 0b10: Cmd_LoadImm<debug>(instruction); break;
-        case 0b11: Cmd_Special<debug>(instruction); break;
+        const DSPOp &op = FetchOp(instrAddress, instruction);
+        switch (op.type) {
+        case DSPOpType::Operation: Cmd_Operation<debug>(op); break;
+        case DSPOpType::ALUOnly: Cmd_ALUOnly(op); break;
+        case DSPOpType::LoadImm:
+        case DSPOpType::LoadImmCond: Cmd_LoadImm<debug>(op); break;
+        case DSPOpType::DMA: Cmd_Special_DMA<debug>(op.instr); break;
+        case DSPOpType::Jump:
+        case DSPOpType::JumpCond: Cmd_Special_Jump(op); break;
+        case DSPOpType::LoopStart: Cmd_Special_LoopStart(); break;
+        case DSPOpType::LoopBottom: Cmd_Special_LoopBottom(); break;
+        case DSPOpType::End: Cmd_Special_End(false); break;
+        case DSPOpType::EndInt: Cmd_Special_End(true); break;
+        case DSPOpType::Invalid: break;
         }
 
         // TODO: is this correct?
@@ -210,7 +224,9 @@ bool SCUDSP::RunDMA(uint64 cycles) {
             if (useDataRAM) {
                 dataRAM[ctIndex][CT.array[ctIndex]] = value;
             } else if (useProgramRAM) {
-                programRAM[programRAMIndex++].u32 = value;
+                programRAM[programRAMIndex].u32 = value;
+                m_programOps[programRAMIndex] = TranslateDSPInstr(programRAM[programRAMIndex]);
+                programRAMIndex++;
             }
         }
         dmaAddrD0 &= 0x7FF'FFFF;
@@ -334,6 +350,14 @@ void SCUDSP::LoadState(const savestate::SCUDSPState &state) {
     dmaAddrInc = state.dmaAddrInc;
     dmaAddrD0 = state.dmaAddrD0 & 0x7FFFFFF;
     m_cyclesSpillover = state.cyclesSpillover;
+
+    TranslateProgram();
+}
+
+void SCUDSP::TranslateProgram() {
+    for (size_t i = 0; i < programRAM.size(); ++i) {
+        m_programOps[i] = TranslateDSPInstr(programRAM[i]);
+    }
 }
 
 FORCE_INLINE void SCUDSP::IncrementPC() {
@@ -348,27 +372,9 @@ FORCE_INLINE void SCUDSP::IncrementPC() {
     }
 }
 
-template <bool debug>
-FORCE_INLINE void SCUDSP::Cmd_Operation(DSPInstr instr) {
-    IncrementPC();
-
-    // D1-Bus MOVs to MC0-3 using the a bank that was read by any of the three busses prevents writes and CT updates.
-    // MOV to M0-3 is unaffected because it writes directly to CT as opposed to M0-3 reads which hit Data RAM.
-    //
-    // For reference:
-    // src 0..3 = M0..M3
-    // src 4..7 = MC0..MC3
-    // dst 0..3 = MC0..MC3
-    uint8 dataRAMReads = 0x0;
-    auto markDataRAMRead = [&](uint8 src) {
-        if (src < 0x8) {
-            dataRAMReads |= 1u << (src & 0x3);
-        }
-    };
-
-    // ALU
+FORCE_INLINE void SCUDSP::ExecuteALU(uint8 aluOp) {
     ALU = AC;
-    switch (instr.aluInfo.aluOp) {
+    switch (aluOp) {
     case 0b0000: break;            // NOP
     case 0b0001: ALU_AND(); break; // AND
     case 0b0010: ALU_OR(); break;  // OR
@@ -382,6 +388,20 @@ FORCE_INLINE void SCUDSP::Cmd_Operation(DSPInstr instr) {
     case 0b1011: ALU_RL(); break;  // RL
     case 0b1111: ALU_RL8(); break; // RL8
     }
+}
+
+template <bool debug>
+FORCE_INLINE void SCUDSP::Cmd_Operation(const DSPOp &op) {
+    IncrementPC();
+
+    // Bus transfers are pre-resolved by TranslateDSPInstr, including the following conflicts:
+    //
+    // D1-Bus MOVs to MC0-3 using the a bank that was read by any of the three busses prevents writes and CT updates.
+    // MOV to M0-3 is unaffected because it writes directly to CT as opposed to M0-3 reads which hit Data RAM.
+    // D1-Bus MOVs to X or P are suppressed if the X-Bus writes to the same register.
+
+    // ALU
+    ExecuteALU(op.aluOp);
 
     // X-Bus
     //
@@ -396,18 +416,17 @@ FORCE_INLINE void SCUDSP::Cmd_Operation(DSPInstr instr) {
     //  101               MOV [s],X
     //  110   MOV MUL,P   MOV [s],X
     //  111   MOV [s],P   MOV [s],X
-    if ((instr.aluInfo.xBusOp & 0b11) == 0b10) {
+    if (op.busOps & dsp_bus::kXMulToP) {
         // MOV MUL,P
         P.u64 = bit::extract<0, 47>(static_cast<sint64>(RX) * static_cast<sint64>(RY));
     }
-    if (instr.aluInfo.xBusOp >= 0b011) {
-        const sint32 value = ReadSource<debug>(instr.aluInfo.xBusSource);
-        markDataRAMRead(instr.aluInfo.xBusSource);
-        if ((instr.aluInfo.xBusOp & 0b11) == 0b11) {
+    if (op.busOps & dsp_bus::kXRead) {
+        const sint32 value = ReadSource<debug>(op.xBusSrc);
+        if (op.busOps & dsp_bus::kXReadToP) {
             // MOV [s],P
             P.u64 = bit::extract<0, 47>(static_cast<sint64>(value));
         }
-        if (bit::test<2>(instr.aluInfo.xBusOp)) {
+        if (op.busOps & dsp_bus::kXReadToX) {
             // MOV [s],X
             RX = value;
         }
@@ -426,79 +445,52 @@ FORCE_INLINE void SCUDSP::Cmd_Operation(DSPInstr instr) {
     // 101    CLR A       MOV [s],Y
     // 110    MOV ALU,A   MOV [s],Y
     // 111    MOV [s],A   MOV [s],Y
-    if ((instr.aluInfo.yBusOp & 0b11) == 0b01) {
+    if (op.busOps & dsp_bus::kYClearA) {
         // CLR A
         AC.u64 = 0;
-    } else if ((instr.aluInfo.yBusOp & 0b11) == 0b10) {
+    } else if (op.busOps & dsp_bus::kYALUToA) {
         // MOV ALU,A
         AC.u64 = ALU.u64;
     }
-    if (instr.aluInfo.yBusOp >= 0b11) {
-        const sint32 value = ReadSource<debug>(instr.aluInfo.yBusSource);
-        markDataRAMRead(instr.aluInfo.yBusSource);
-        if ((instr.aluInfo.yBusOp & 0b11) == 0b11) {
+    if (op.busOps & dsp_bus::kYRead) {
+        const sint32 value = ReadSource<debug>(op.yBusSrc);
+        if (op.busOps & dsp_bus::kYReadToA) {
             // MOV [s],A
             AC.u64 = bit::extract<0, 47>(static_cast<sint64>(value));
         }
-        if (bit::test<2>(instr.aluInfo.yBusOp)) {
+        if (op.busOps & dsp_bus::kYReadToY) {
             // MOV [s],Y
             RY = value;
         }
     }
 
     // D1-Bus
-    switch (instr.aluInfo.d1BusOp) {
-    case 0b01: // MOV SImm, [d]
-    {
-        const sint32 imm = instr.aluInfo.d1BusImm;
-        const uint8 dst = instr.aluInfo.d1BusDest;
-        if (dst < 0x4 && (dataRAMReads & (1u << dst))) {
-            CT.u32 &= ~(1 << (dst * 8));
-        } else if (dst == 0x4 && bit::test<2>(instr.aluInfo.xBusOp)) {
-            // Prevent writes to X if X-Bus has written to it
-        } else if (dst == 0x5 && bit::test<1>(instr.aluInfo.xBusOp)) {
-            // Prevent writes to P if X-Bus has written to it
-        } else {
-            WriteD1Bus<debug>(dst, imm);
-        }
+    switch (op.d1Op) {
+    case DSPD1Op::None: break;
+    case DSPD1Op::Imm: WriteD1Bus<debug>(op.dst, op.imm); break;
+    case DSPD1Op::ClearCT: CT.u32 &= ~(1 << (op.dst * 8)); break;
+    case DSPD1Op::Move: WriteD1Bus<debug>(op.dst, ReadSource<debug>(op.d1Src)); break;
+    case DSPD1Op::Read: void(ReadSource<debug>(op.d1Src)); break;
+    case DSPD1Op::IncCT:
+        // Reads from MC0-3 should still increment CT
+        incCT |= 1u << (op.d1Src * 8);
         break;
     }
-    case 0b11: // MOV [s], [d]
-    {
-        const uint8 src = instr.aluInfo.d1BusImm & 0b1111;
-        const uint8 dst = instr.aluInfo.d1BusDest;
-        markDataRAMRead(src);
-
-        if (dst >= 0x4 || (dataRAMReads & (1u << dst)) == 0) {
-            // Allow writes to Data RAM only if src wasn't read
-
-            if (dst == 0x4 && bit::test<2>(instr.aluInfo.xBusOp)) {
-                // Prevent writes to X if X-Bus has written to it
-            } else if (dst == 0x5 && bit::test<1>(instr.aluInfo.xBusOp)) {
-                // Prevent writes to P if X-Bus has written to it
-                void(ReadSource<debug>(src));
-            } else {
-                const uint32 value = ReadSource<debug>(src);
-                WriteD1Bus<debug>(dst, value);
-            }
-        } else if (dst < 0x4 && src >= 0x4 && src < 0x8 && dst != (src & 3)) {
-            // Reads from MC0-3 should still increment CT
-            incCT |= 1u << ((src & 3) * 8);
-        }
-        break;
-    }
-    }
 
     // Update CT0-3
     CT.u32 = (CT.u32 + incCT) & 0x3F3F3F3F;
     incCT = 0x00000000;
 }
 
-template <bool debug>
-FORCE_INLINE void SCUDSP::Cmd_LoadImm(DSPInstr instr) {
-    const uint8 dst = instr.loadInfo.loadControl.storageLocation;
+FORCE_INLINE void SCUDSP::Cmd_ALUOnly(const DSPOp &op) {
+    // Fast path for ALU operations without bus transfers; CT0-3 are never incremented here
+    IncrementPC();
+    ExecuteALU(op.aluOp);
+}
 
-    const bool writeToPC = dst == 0b1100;
+template <bool debug>
+FORCE_INLINE void SCUDSP::Cmd_LoadImm(const DSPOp &op) {
+    const bool writeToPC = op.dst == 0b1100;
     if (looping) {
         if (loopCount == 0) {
             looping = false;
@@ -511,34 +503,13 @@ FORCE_INLINE void SCUDSP::Cmd_LoadImm(DSPInstr instr) {
         ++PC;
     }
 
-    sint32 imm;
-    if (instr.loadInfo.loadControl.conditionalLoad) {
-        // Conditional transfer
-        // MVI SImm,[d],<cond>
-        imm = instr.loadInfo.conditional.imm;
-
-        const uint8 cond = instr.loadInfo.conditional.condition;
-        if (!CondCheck(cond)) {
-            return;
-        }
-    } else {
-        // Unconditional transfer
-        // MVI SImm,[d]
-        imm = instr.loadInfo.unconditional.imm;
+    // MVI SImm,[d],<cond>
+    if (op.type == DSPOpType::LoadImmCond && !CondCheck(op.cond)) {
+        return;
     }
 
-    WriteImm<debug>(dst, imm);
-}
-
-template <bool debug>
-FORCE_INLINE void SCUDSP::Cmd_Special(DSPInstr instr) {
-    const uint32 cmdSubcategory = instr.specialInfo.specialControl.specialClass;
-    switch (cmdSubcategory) {
-    case 0b00: Cmd_Special_DMA<debug>(instr); break;
-    case 0b01: Cmd_Special_Jump(instr); break;
-    case 0b10: Cmd_Special_Loop(instr); break;
-    case 0b11: Cmd_Special_End(instr); break;
-    }
+    // MVI SImm,[d]
+    WriteImm<debug>(op.dst, op.imm);
 }
 
 template <bool debug>
@@ -597,44 +568,41 @@ FORCE_INLINE void SCUDSP::Cmd_Special_DMA(DSPInstr command) {
     devlog::trace<grp::dsp>("DSP DMA command: {:04X} @ {:02X}", command.u32, PC);
 }
 
-FORCE_INLINE void SCUDSP::Cmd_Special_Jump(DSPInstr command) {
+FORCE_INLINE void SCUDSP::Cmd_Special_Jump(const DSPOp &op) {
     // JMP <cond>,SImm
     // JMP SImm
     IncrementPC();
 
-    if (command.specialInfo.jumpInfo.conditional) {
-        const uint32 cond = command.specialInfo.jumpInfo.condition;
-        if (cond != 0 && !CondCheck(cond)) {
-            return;
-        }
+    if (op.type == DSPOpType::JumpCond && !CondCheck(op.cond)) {
+        return;
     }
 
-    PC = command.specialInfo.jumpInfo.target;
+    PC = op.imm;
 }
 
-FORCE_INLINE void SCUDSP::Cmd_Special_Loop(DSPInstr command) {
-    if (command.specialInfo.loopInfo.repeat) {
-        // LPS
-        looping = true;
-        IncrementPC();
+FORCE_INLINE void SCUDSP::Cmd_Special_LoopStart() {
+    // LPS
+    looping = true;
+    IncrementPC();
+}
+
+FORCE_INLINE void SCUDSP::Cmd_Special_LoopBottom() {
+    // BTM
+    if (loopCount != 0) {
+        PC = loopTop;
     } else {
-        // BTM
-        if (loopCount != 0) {
-            PC = loopTop;
-        } else {
-            IncrementPC();
-        }
-        loopCount = (loopCount - 1) & 0xFFF;
+        IncrementPC();
     }
+    loopCount = (loopCount - 1) & 0xFFF;
 }
 
-FORCE_INLINE void SCUDSP::Cmd_Special_End(DSPInstr command) {
+FORCE_INLINE void SCUDSP::Cmd_Special_End(bool interrupt) {
     // END
     // ENDI
     IncrementPC();
 
     programExecuting = false;
-    if (command.specialInfo.endInfo.interrupt && !programEnded) {
+    if (interrupt && !programEnded) {
         programEnded = true;
         m_cbTriggerDSPEnd();
     }
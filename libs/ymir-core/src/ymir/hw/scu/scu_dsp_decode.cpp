@@ -0,0 +1,134 @@
+#include <ymir/hw/scu/scu_dsp_decode.hpp>
+
+#include <ymir/util/bit_ops.hpp>
+
+namespace ymir::scu {
+
+static void TranslateOperation(DSPInstr instr, DSPOp &op) {
+    const auto &info = instr.aluInfo;
+    op.aluOp = info.aluOp;
+    op.xBusSrc = info.xBusSource;
+    op.yBusSrc = info.yBusSource;
+
+    // See SCUDSP::Cmd_Operation for the meaning of the bus operation bits
+    const uint8 xBusOp = info.xBusOp;
+    const uint8 yBusOp = info.yBusOp;
+    if ((xBusOp & 0b11) == 0b10) {
+        op.busOps |= dsp_bus::kXMulToP;
+    }
+    if (xBusOp >= 0b011) {
+        if ((xBusOp & 0b11) == 0b11) {
+            op.busOps |= dsp_bus::kXReadToP;
+        }
+        if (bit::test<2>(xBusOp)) {
+            op.busOps |= dsp_bus::kXReadToX;
+        }
+    }
+    if ((yBusOp & 0b11) == 0b01) {
+        op.busOps |= dsp_bus::kYClearA;
+    } else if ((yBusOp & 0b11) == 0b10) {
+        op.busOps |= dsp_bus::kYALUToA;
+    }
+    if (yBusOp >= 0b011) {
+        if ((yBusOp & 0b11) == 0b11) {
+            op.busOps |= dsp_bus::kYReadToA;
+        }
+        if (bit::test<2>(yBusOp)) {
+            op.busOps |= dsp_bus::kYReadToY;
+        }
+    }
+
+    // Data RAM banks read by the X-Bus and Y-Bus. Their sources are always M0-3 or MC0-3.
+    uint8 dataRAMReads = 0x0;
+    if (op.busOps & dsp_bus::kXRead) {
+        dataRAMReads |= 1u << (op.xBusSrc & 0x3);
+    }
+    if (op.busOps & dsp_bus::kYRead) {
+        dataRAMReads |= 1u << (op.yBusSrc & 0x3);
+    }
+
+    const bool xWritesX = bit::test<2>(xBusOp);
+    const bool xWritesP = bit::test<1>(xBusOp);
+    const uint8 dst = info.d1BusDest;
+    switch (info.d1BusOp) {
+    case 0b01: // MOV SImm, [d]
+        if (dst < 0x4 && (dataRAMReads & (1u << dst))) {
+            op.d1Op = DSPD1Op::ClearCT;
+            op.dst = dst;
+        } else if ((dst == 0x4 && xWritesX) || (dst == 0x5 && xWritesP)) {
+            // Suppressed by X-Bus writes to X or P
+        } else {
+            op.d1Op = DSPD1Op::Imm;
+            op.dst = dst;
+            op.imm = info.d1BusImm;
+        }
+        break;
+    case 0b11: // MOV [s], [d]
+    {
+        const uint8 src = info.d1BusImm & 0b1111;
+        if (src < 0x8) {
+            dataRAMReads |= 1u << (src & 0x3);
+        }
+
+        if (dst >= 0x4 || (dataRAMReads & (1u << dst)) == 0) {
+            if (dst == 0x4 && xWritesX) {
+                // Suppressed by X-Bus write to X
+            } else if (dst == 0x5 && xWritesP) {
+                op.d1Op = DSPD1Op::Read;
+                op.d1Src = src;
+            } else {
+                op.d1Op = DSPD1Op::Move;
+                op.d1Src = src;
+                op.dst = dst;
+            }
+        } else if (dst < 0x4 && src >= 0x4 && src < 0x8 && dst != (src & 3)) {
+            op.d1Op = DSPD1Op::IncCT;
+            op.d1Src = src & 3;
+        }
+        break;
+    }
+    }
+
+    op.type = op.busOps == 0 && op.d1Op == DSPD1Op::None ? DSPOpType::ALUOnly : DSPOpType::Operation;
+}
+
+static void TranslateLoadImm(DSPInstr instr, DSPOp &op) {
+    op.dst = instr.loadInfo.loadControl.storageLocation;
+    if (instr.loadInfo.loadControl.conditionalLoad) {
+        op.imm = instr.loadInfo.conditional.imm;
+        op.cond = instr.loadInfo.conditional.condition;
+        // Condition 000000 always passes
+        op.type = op.cond != 0 ? DSPOpType::LoadImmCond : DSPOpType::LoadImm;
+    } else {
+        op.imm = instr.loadInfo.unconditional.imm;
+        op.type = DSPOpType::LoadImm;
+    }
+}
+
+static void TranslateSpecial(DSPInstr instr, DSPOp &op) {
+    const auto &info = instr.specialInfo;
+    switch (info.specialControl.specialClass) {
+    case 0b00: op.type = DSPOpType::DMA; break;
+    case 0b01:
+        op.imm = info.jumpInfo.target;
+        op.cond = info.jumpInfo.conditional ? info.jumpInfo.condition : 0;
+        op.type = op.cond != 0 ? DSPOpType::JumpCond : DSPOpType::Jump;
+        break;
+    case 0b10: op.type = info.loopInfo.repeat ? DSPOpType::LoopStart : DSPOpType::LoopBottom; break;
+    case 0b11: op.type = info.endInfo.interrupt ? DSPOpType::EndInt : DSPOpType::End; break;
+    }
+}
+
+DSPOp TranslateDSPInstr(DSPInstr instr) {
+    DSPOp op{};
+    op.instr = instr;
+    switch (instr.instructionInfo.instructionClass) {
+    case 0b00: TranslateOperation(instr, op); break;
+    case 0b01: op.type = DSPOpType::Invalid; break;
+    case 0b10: TranslateLoadImm(instr, op); break;
+    case 0b11: TranslateSpecial(instr, op); break;
+    }
+    return op;
+}
+
+} // namespace ymir::scu
@@ -320,7 +320,7 @@ FORCE_INLINE static void TraceDMAXferEnd(debug::ISH2Tracer *tracer, uint32 chann
 // Implementation
 
 SH2::SH2(sys::SH2Bus &bus, bool master)
-    : m_bus(bus)
+    : m_bus(&bus)
     , m_logPrefix(master ? "SH2-M" : "SH2-S") {
 
     BCR1.MASTER = !master;
@@ -457,6 +457,24 @@ FLATTEN uint64 SH2::Advance(uint64 cycles, uint64 spilloverCycles) {
     while (m_cyclesExecuted < cycles) {
         // [[maybe_unused]] const uint32 prevPC = PC; // debug aid
 
+        // Run the non-debug interpreter while the current 4 KiB page has no breakpoints.
+        // Tracers observe every instruction and watchpoints decode every instruction, so both need the debug path.
+        if constexpr (debug) {
+            if (m_tracer == nullptr && m_watchpointCount.load(std::memory_order_relaxed) == 0 &&
+                (m_debugBreakMgr == nullptr || !m_breakpointPages.Test(PC))) {
+                const uint32 pageStart = PageFilter::PageStart(PC);
+                do {
+                    m_cyclesExecuted += InterpretNext<false, emulateCache>();
+                } while (m_cyclesExecuted < cycles && PageFilter::PageStart(PC) == pageStart);
+
+                // The first instruction in the new page has not been checked yet
+                if (m_debugBreakMgr && CheckBreakpoint()) {
+                    break;
+                }
+                continue;
+            }
+        }
+
         // TODO: choose between interpreter (cached or uncached) and JIT recompiler
         m_cyclesExecuted += InterpretNext<debug, emulateCache>();
 
@@ -478,10 +496,13 @@ FLATTEN uint64 SH2::Advance(uint64 cycles, uint64 spilloverCycles) {
                     break;
                 }
 
-                const uint16 instr = MemRead<uint16, true, true, emulateCache>(PC);
-                const auto &mem = DecodeTable::s_instance.mem[instr];
-                if (CheckWatchpoints(mem)) {
-                    break;
+                // Only decode the next instruction's memory accesses if there is anything to watch
+                if (m_watchpointCount.load(std::memory_order_relaxed) != 0) {
+                    const uint16 instr = MemRead<uint16, true, true, emulateCache>(PC);
+                    const auto &mem = DecodeTable::s_instance.mem[instr];
+                    if (CheckWatchpoints(mem)) {
+                        break;
+                    }
                 }
             }
         }
@@ -651,6 +672,15 @@ T SH2::MemRead(uint32 address) {
     case 0b000: // cache
         if constexpr (emulateCache) {
             if (m_cache.CCR.CE) {
+                if constexpr (instrFetch && !peek) {
+                    // Fast path for sequential fetches within the same line
+                    if (const uint8 *line = m_cache.GetFetchLine(address)) {
+                        const uint32 byte = bit::extract<0, 3>(address) ^ (4 - sizeof(T));
+                        m_cache.UpdateFetchLineLRU();
+                        return util::ReadNE<T>(&line[byte]);
+                    }
+                }
+
                 CacheEntry &entry = m_cache.GetEntry(address);
                 uint32 way = entry.FindWay(address);
 
@@ -663,7 +693,7 @@ T SH2::MemRead(uint32 address) {
                             const uint32 baseAddress = address & ~0xF;
                             for (uint32 offset = 0; offset < 16; offset += 4) {
                                 const uint32 addressInc = (address + 4 + offset) & 0xC;
-                                const uint32 memValue = m_bus.Read<uint32>((baseAddress + addressInc) & 0x7FFFFFF);
+                                const uint32 memValue = m_bus->Read<uint32>((baseAddress + addressInc) & 0x7FFFFFF);
                                 util::WriteNE<uint32>(&entry.line[way][addressInc], memValue);
                             }
                         }
@@ -676,6 +706,9 @@ T SH2::MemRead(uint32 address) {
                     const T value = util::ReadNE<T>(&entry.line[way][byte]);
                     if constexpr (!peek) {
                         m_cache.UpdateLRU(address, way);
+                        if constexpr (instrFetch) {
+                            m_cache.SetFetchLine(address, way);
+                        }
                         devlog::trace<grp::cache>(m_logPrefix,
                                                   "[PC = {:08X}] {}-bit SH-2 cached area read from {:08X} = {:X} (hit)",
                                                   PC, sizeof(T) * 8, address, value);
@@ -693,9 +726,9 @@ T SH2::MemRead(uint32 address) {
     case 0b001:
     case 0b101: // cache-through
         if constexpr (peek) {
-            return m_bus.Peek<T>(address & 0x7FFFFFF);
+            return m_bus->Peek<T>(address & 0x7FFFFFF);
         } else {
-            return m_bus.Read<T>(address & 0x7FFFFFF);
+            return m_bus->Read<T>(address & 0x7FFFFFF);
         }
     case 0b010: // associative purge
         m_cache.AssociativePurge(address);
@@ -789,9 +822,9 @@ void SH2::MemWrite(uint32 address, T value) {
     case 0b001:
     case 0b101: // cache-through
         if constexpr (poke) {
-            m_bus.Poke<T>(address & 0x7FFFFFF, value);
+            m_bus->Poke<T>(address & 0x7FFFFFF, value);
         } else {
-            m_bus.Write<T>(address & 0x7FFFFFF, value);
+            m_bus->Write<T>(address & 0x7FFFFFF, value);
         }
         break;
     case 0b010: // associative purge
@@ -967,7 +1000,7 @@ FORCE_INLINE_EX uint64 SH2::AccessCycles(uint32 address) {
             } else {
                 // Cache miss - fill cache line
                 // TODO: stall bus for 4 accesses
-                return m_bus.GetAccessCycles<T, write>(address);
+                return m_bus->GetAccessCycles<T, write>(address);
             }
         } else if constexpr (!emulateCache) {
             // Simplified model - assume cache hits on all accesses to cached area
@@ -976,7 +1009,7 @@ FORCE_INLINE_EX uint64 SH2::AccessCycles(uint32 address) {
         [[fallthrough]];
     case 0b001: [[fallthrough]];
     case 0b101: // cache-through
-        return m_bus.GetAccessCycles<T, write>(address);
+        return m_bus->GetAccessCycles<T, write>(address);
     case 0b010: return 1;        // associative purge
     case 0b011: return 1;        // cache address array
     case 0b100: [[fallthrough]]; // cache data array
@@ -995,7 +1028,7 @@ uint64 SH2::AccessCyclesRMWByte(uint32 address) {
     case 0b001: [[fallthrough]]; // cache-through
     case 0b101:                  // cache-through
     {
-        const uint64 readCycles = m_bus.GetAccessCycles<uint8, false>(address);
+        const uint64 readCycles = m_bus->GetAccessCycles<uint8, false>(address);
         return readCycles - 1;
     }
     default: // everything else
@@ -1820,12 +1853,12 @@ FORCE_INLINE bool SH2::StepDMAC(uint32 channel) {
         }
     };
 
-    if (m_bus.IsBusWait(ch.srcAddress, xferSize, false)) {
+    if (m_bus->IsBusWait(ch.srcAddress, xferSize, false)) {
         devlog::trace<grp::dma_xfer>(m_logPrefix, "DMAC{} transfer from {:08X} stalled by bus wait signal", channel,
                                      ch.srcAddress);
         return false;
     }
-    if (m_bus.IsBusWait(ch.dstAddress, xferSize, true)) {
+    if (m_bus->IsBusWait(ch.dstAddress, xferSize, true)) {
         devlog::trace<grp::dma_xfer>(m_logPrefix, "DMAC{} transfer to {:08X} stalled by bus wait signal", channel,
                                      ch.dstAddress);
         return false;
@@ -1842,6 +1875,29 @@ FORCE_INLINE bool SH2::StepDMAC(uint32 channel) {
         }
     }
 
+    // Pull runs of longwords from fixed-address data ports, such as the CD block data transfer register, with a single
+    // bus call. This is equivalent to performing the transfers one by one: the run stops at the same point when the
+    // source stalls. Only the CD block asserts the bus wait signal, so writes to any other region never stall.
+    if constexpr (!debug) {
+        if (ch.xferSize == DMATransferSize::Longword && srcInc == 0 && ch.xferCount > 1 &&
+            IsDMABulkReadSource<emulateCache>(ch.srcAddress) && !IsCDBlockAddress(ch.dstAddress)) {
+            std::array<uint32, 128> values;
+            const uint32 count = std::min<uint32>(ch.xferCount, values.size());
+            const uint32 readCount = m_bus->BulkRead(ch.srcAddress & 0x7FFFFFF, std::span{values}.first(count));
+            for (uint32 i = 0; i < readCount; ++i) {
+                MemWriteLong<debug, emulateCache>(ch.dstAddress, values[i]);
+                ch.dstAddress += dstInc;
+            }
+            devlog::trace<grp::dma_xfer>(m_logPrefix, "DMAC{} bulk 32-bit transfer from {:08X} -> {} longwords",
+                                         channel, ch.srcAddress, readCount);
+            if (readCount == 0) {
+                return false;
+            }
+            ch.xferCount -= readCount;
+            return FinishDMAStep<debug>(channel);
+        }
+    }
+
     // Perform one unit of transfer
     switch (ch.xferSize) {
     case DMATransferSize::Byte: {
@@ -1900,6 +1956,28 @@ FORCE_INLINE bool SH2::StepDMAC(uint32 channel) {
         --ch.xferCount;
     }
 
+    return FinishDMAStep<debug>(channel);
+}
+
+template <bool emulateCache>
+FORCE_INLINE bool SH2::IsDMABulkReadSource(uint32 address) const {
+    const uint32 partition = (address >> 29u) & 0b111;
+    switch (partition) {
+    case 0b000: return !emulateCache || !m_cache.CCR.CE;
+    case 0b001: [[fallthrough]];
+    case 0b101: return true;
+    default: return false;
+    }
+}
+
+FORCE_INLINE bool SH2::IsCDBlockAddress(uint32 address) {
+    return ((address & 0x7FFFFFF) >> 20u) == 0x58;
+}
+
+template <bool debug>
+FORCE_INLINE bool SH2::FinishDMAStep(uint32 channel) {
+    auto &ch = m_dmaChannels[channel];
+
     if (ch.xferCount == 0) {
         TraceDMAXferEnd<debug>(m_tracer, channel, ch.irqEnable);
         if constexpr (debug) {
@@ -1980,7 +2058,7 @@ FORCE_INLINE void SH2::AdvanceFRT() {
     }
 }
 
-FORCE_INLINE void SH2::TriggerFRTInputCapture() {
+void SH2::TriggerFRTInputCapture() {
     // TODO: FRT.TCR.IEDGA
     FRT.ICR = FRT.FRC;
     FRT.FTCSR.ICF = 1;
@@ -2102,6 +2180,10 @@ FORCE_INLINE bool SH2::CheckWatchpoint(const DecodedMemAccesses::Access &access)
     case AccType::AtDispPC: address = (PC & ~(access.size - 1)) + access.disp; break;
     }
 
+    if (!m_watchpointPages.Test(address)) {
+        return false;
+    }
+
     static constexpr auto kReadMask8 = static_cast<uint8>(debug::WatchpointFlags::Read);
     static constexpr auto kWriteMask8 = static_cast<uint8>(debug::WatchpointFlags::Write);
     static constexpr auto kReadMask16 = (kReadMask8 << 8u) | kReadMask8;
@@ -2669,7 +2751,7 @@ FORCE_INLINE uint64 SH2::MOVWL(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rm];
     uint64 cycles = AccessCycles<uint16, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), false)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint16), false)) [[likely]] {
         R[rn] = bit::sign_extend<16>(MemReadWord<emulateCache>(address));
         TraceChangeStack<debug>(m_tracer, rn, R[15]);
         AdvancePC<debug, emulateCache, delaySlot>();
@@ -2685,7 +2767,7 @@ FORCE_INLINE uint64 SH2::MOVLL(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rm];
     uint64 cycles = AccessCycles<uint32, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), false)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint32), false)) [[likely]] {
         R[rn] = MemReadLong<emulateCache>(address);
         TraceChangeStack<debug>(m_tracer, rn, R[15]);
         AdvancePC<debug, emulateCache, delaySlot>();
@@ -2714,7 +2796,7 @@ FORCE_INLINE uint64 SH2::MOVWL0(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rm] + R[0];
     uint64 cycles = AccessCycles<uint16, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), false)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint16), false)) [[likely]] {
         R[rn] = bit::sign_extend<16>(MemReadWord<emulateCache>(address));
         TraceChangeStack<debug>(m_tracer, rn, R[15]);
         AdvancePC<debug, emulateCache, delaySlot>();
@@ -2730,7 +2812,7 @@ FORCE_INLINE uint64 SH2::MOVLL0(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rm] + R[0];
     uint64 cycles = AccessCycles<uint32, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), false)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint32), false)) [[likely]] {
         R[rn] = MemReadLong<emulateCache>(address);
         TraceChangeStack<debug>(m_tracer, rn, R[15]);
         AdvancePC<debug, emulateCache, delaySlot>();
@@ -2758,7 +2840,7 @@ FORCE_INLINE uint64 SH2::MOVWL4(uint16 opcode) {
     DECODE_MD(1u)
     const uint32 address = R[rm] + disp;
     uint64 cycles = AccessCycles<uint16, false, emulateCache>(address) + WritebackCycles(rm);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), false)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint16), false)) [[likely]] {
         R[0] = bit::sign_extend<16>(MemReadWord<emulateCache>(address));
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(rm);
@@ -2773,7 +2855,7 @@ FORCE_INLINE uint64 SH2::MOVLL4(uint16 opcode) {
     DECODE_NMD(2u)
     const uint32 address = R[rm] + disp;
     uint64 cycles = AccessCycles<uint32, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), false)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint32), false)) [[likely]] {
         R[rn] = MemReadLong<emulateCache>(address);
         TraceChangeStack<debug>(m_tracer, rn, R[15]);
         AdvancePC<debug, emulateCache, delaySlot>();
@@ -2801,7 +2883,7 @@ FORCE_INLINE uint64 SH2::MOVWLG(uint16 opcode) {
     DECODE_D_U(1u);
     const uint32 address = GBR + disp;
     const uint64 cycles = AccessCycles<uint16, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), false)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint16), false)) [[likely]] {
         R[0] = bit::sign_extend<16>(MemReadWord<emulateCache>(address));
         AdvancePC<debug, emulateCache, delaySlot>();
         m_wbReg = 0;
@@ -2815,7 +2897,7 @@ FORCE_INLINE uint64 SH2::MOVLLG(uint16 opcode) {
     DECODE_D_U(2u);
     const uint32 address = GBR + disp;
     const uint64 cycles = AccessCycles<uint32, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), false)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint32), false)) [[likely]] {
         R[0] = MemReadLong<emulateCache>(address);
         AdvancePC<debug, emulateCache, delaySlot>();
         m_wbReg = 0;
@@ -2843,7 +2925,7 @@ FORCE_INLINE uint64 SH2::MOVWM(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rn] - 2;
     uint64 cycles = AccessCycles<uint16, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), true)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint16), true)) [[likely]] {
         MemWriteWord<debug, emulateCache>(address, R[rm]);
         TracePushRegisterToStack<debug>(m_tracer, rn, rm, R[15], address);
         R[rn] = address;
@@ -2860,7 +2942,7 @@ FORCE_INLINE uint64 SH2::MOVLM(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rn] - 4;
     uint64 cycles = AccessCycles<uint32, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), true)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint32), true)) [[likely]] {
         MemWriteLong<debug, emulateCache>(address, R[rm]);
         TracePushRegisterToStack<debug>(m_tracer, rn, rm, R[15], address);
         R[rn] = address;
@@ -2894,7 +2976,7 @@ FORCE_INLINE uint64 SH2::MOVWP(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rm];
     uint64 cycles = AccessCycles<uint16, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), false)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint16), false)) [[likely]] {
         R[rn] = bit::sign_extend<16>(MemReadWord<emulateCache>(address));
         if (rn != rm) {
             R[rm] += 2;
@@ -2914,7 +2996,7 @@ FORCE_INLINE uint64 SH2::MOVLP(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rm];
     uint64 cycles = AccessCycles<uint32, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), false)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint32), false)) [[likely]] {
         R[rn] = MemReadLong<emulateCache>(address);
         if (rn != rm) {
             R[rm] += 4;
@@ -2946,7 +3028,7 @@ FORCE_INLINE uint64 SH2::MOVWS(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rn];
     uint64 cycles = AccessCycles<uint16, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), true)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint16), true)) [[likely]] {
         MemWriteWord<debug, emulateCache>(address, R[rm]);
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(rm, rn);
@@ -2961,7 +3043,7 @@ FORCE_INLINE uint64 SH2::MOVLS(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rn];
     uint64 cycles = AccessCycles<uint32, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), true)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint32), true)) [[likely]] {
         MemWriteLong<debug, emulateCache>(address, R[rm]);
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(rm, rn);
@@ -2988,7 +3070,7 @@ FORCE_INLINE uint64 SH2::MOVWS0(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rn] + R[0];
     uint64 cycles = AccessCycles<uint16, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), true)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint16), true)) [[likely]] {
         MemWriteWord<debug, emulateCache>(address, R[rm]);
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(rn, 0);
@@ -3003,7 +3085,7 @@ FORCE_INLINE uint64 SH2::MOVLS0(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rn] + R[0];
     uint64 cycles = AccessCycles<uint32, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), true)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint32), true)) [[likely]] {
         MemWriteLong<debug, emulateCache>(address, R[rm]);
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(rn, 0);
@@ -3030,7 +3112,7 @@ FORCE_INLINE uint64 SH2::MOVWS4(uint16 opcode) {
     DECODE_ND4(1u)
     const uint32 address = R[rn] + disp;
     uint64 cycles = AccessCycles<uint16, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), true)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint16), true)) [[likely]] {
         MemWriteWord<debug, emulateCache>(address, R[0]);
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(rn, 0);
@@ -3045,7 +3127,7 @@ FORCE_INLINE uint64 SH2::MOVLS4(uint16 opcode) {
     DECODE_NMD(2u)
     const uint32 address = R[rn] + disp;
     uint64 cycles = AccessCycles<uint32, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), true)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint32), true)) [[likely]] {
         MemWriteLong<debug, emulateCache>(address, R[rm]);
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(rm, rn);
@@ -3072,7 +3154,7 @@ FORCE_INLINE uint64 SH2::MOVWSG(uint16 opcode) {
     DECODE_D_U(1u)
     const uint32 address = GBR + disp;
     uint64 cycles = AccessCycles<uint16, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), true)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint16), true)) [[likely]] {
         MemWriteWord<debug, emulateCache>(address, R[0]);
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(0);
@@ -3087,7 +3169,7 @@ FORCE_INLINE uint64 SH2::MOVLSG(uint16 opcode) {
     DECODE_D_U(2u)
     const uint32 address = GBR + disp;
     uint64 cycles = AccessCycles<uint32, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), true)) [[likely]] {
+    if (!m_bus->IsBusWait(address, sizeof(uint32), true)) [[likely]] {
         MemWriteLong<debug, emulateCache>(address, R[0]);
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(0);
@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <limits>
 
 #if defined(_M_X64) || defined(__x86_64__)
@@ -104,6 +105,8 @@ void SoftwareVDPRenderer::Reset(bool hard) {
     }
 
     if (m_threadedVDP2Rendering) {
+        // The render thread clears its copy of VRAM and CRAM, so writes still being coalesced are stale
+        m_vdp2RenderingContext.writeSpans.Reset();
         m_vdp2RenderingContext.EnqueueEvent(VDP2RenderEvent::Reset());
     } else {
         m_framebuffer.fill(0xFF000000);
@@ -176,6 +179,7 @@ void SoftwareVDPRenderer::EnableThreadedVDP2(bool enable) {
 
     m_threadedVDP2Rendering = enable;
     if (enable) {
+        m_vdp2RenderingContext.writeSpans.Reset();
         m_vdp2RenderingContext.EnqueueEvent(VDP2RenderEvent::PostLoadStateSync());
         m_VDP2RenderThread = std::thread{[&] { VDP2RenderThread(); }};
         m_VDP2DeinterlaceRenderThread = std::thread{[&] { VDP2DeinterlaceRenderThread(); }};
@@ -243,6 +247,8 @@ void SoftwareVDPRenderer::PostLoadStateSync() {
         m_vdp1RenderingContext.EnqueueEvent(VDP1RenderEvent::PostLoadStateSync());
     }
     if (m_threadedVDP2Rendering) {
+        // The render thread copies the loaded VRAM and CRAM, which supersede writes still being coalesced
+        m_vdp2RenderingContext.writeSpans.Reset();
         m_vdp2RenderingContext.EnqueueEvent(VDP2RenderEvent::PostLoadStateSync());
     }
 
@@ -389,7 +395,7 @@ void SoftwareVDPRenderer::VDP2WriteVRAM(uint32 address, uint16 value) {
 template <mem_primitive_16 T>
 FORCE_INLINE void SoftwareVDPRenderer::VDP2WriteVRAMImpl(uint32 address, T value) {
     if (m_threadedVDP2Rendering) {
-        m_vdp2RenderingContext.EnqueueEvent(VDP2RenderEvent::VDP2VRAMWrite<T>(address, value));
+        m_vdp2RenderingContext.EnqueueVRAMWrite(address, value);
     }
 }
 
@@ -405,7 +411,7 @@ template <mem_primitive_16 T>
 FORCE_INLINE void SoftwareVDPRenderer::VDP2WriteCRAMImpl(uint32 address, T value) {
     VDP2UpdateCRAMCache<T>(address);
     if (m_threadedVDP2Rendering) {
-        m_vdp2RenderingContext.EnqueueEvent(VDP2RenderEvent::VDP2CRAMWrite<T>(address, value));
+        m_vdp2RenderingContext.EnqueueCRAMWrite(address, value);
     }
 }
 
@@ -484,6 +490,7 @@ void SoftwareVDPRenderer::VDP1ExecuteCommand(uint32 cmdAddress, VDP1Command::Con
     if (m_threadedVDP1Rendering) {
         m_vdp1RenderingContext.EnqueueEvent(VDP1RenderEvent::Command(cmdAddress, control));
     } else {
+        YMIR_HOST_TIMER(m_hostTiming, debug::HostTimingComponent::VDP1);
         (this->*m_fnVDP1HandleCommand)(cmdAddress, control);
     }
 }
@@ -524,8 +531,9 @@ void SoftwareVDPRenderer::VDP2LatchTVMD() {
 }
 
 void SoftwareVDPRenderer::VDP2BeginFrame() {
+    m_skipFrame = m_skipNextFrame;
     if (m_threadedVDP2Rendering) {
-        m_vdp2RenderingContext.EnqueueEvent(VDP2RenderEvent::VDP2BeginFrame());
+        m_vdp2RenderingContext.EnqueueEvent(VDP2RenderEvent::VDP2BeginFrame(m_skipFrame));
     } else {
         VDP2InitFrame();
     }
@@ -536,7 +544,13 @@ void SoftwareVDPRenderer::VDP2RenderLine(uint32 y) {
         m_vdp2RenderingContext.EnqueueEvent(VDP2RenderEvent::VDP2DrawLine(y));
         m_state.state2.CalcAccessPatterns(m_state.regs2, m_vdp2AccessPatternsConfig);
         m_state.state2.CalcVCellScrollDelay(m_state.regs2);
+    } else if (m_skipFrame) {
+        // Update line state without drawing or composing anything
+        YMIR_HOST_TIMER(m_hostTiming, debug::HostTimingComponent::VDP2);
+        VDP2PrepareLine(y);
+        VDP2FinishLine(y);
     } else {
+        YMIR_HOST_TIMER(m_hostTiming, debug::HostTimingComponent::VDP2);
         const bool interlaced = m_state.regs2.TVMD.IsInterlaced();
         VDP2PrepareLine(y);
         (this->*m_fnVDP2DrawLine)(y, false);
@@ -558,7 +572,9 @@ void SoftwareVDPRenderer::VDP2EndFrame() {
         Callbacks.VDP2ResolutionChanged(m_HRes, m_VRes);
     }
     Callbacks.VDP2DrawFinished();
-    SwCallbacks.FrameComplete(m_framebuffer.data(), m_HRes, m_VRes);
+    if (!m_skipFrame) {
+        SwCallbacks.FrameComplete(m_framebuffer.data(), m_HRes, m_VRes);
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -631,7 +647,12 @@ void SoftwareVDPRenderer::VDP1RenderThread() {
                 m_state.spriteFB[fbIndex] = rctx.vdp1.spriteFB[fbIndex];
                 break;
             }
-            case EvtType::Command: (this->*m_fnVDP1HandleCommand)(event.command.address, event.command.control); break;
+            case EvtType::Command: //
+            {
+                YMIR_HOST_TIMER(m_hostTiming, debug::HostTimingComponent::VDP1);
+                (this->*m_fnVDP1HandleCommand)(event.command.address, event.command.control);
+                break;
+            }
 
             case EvtType::VRAMWriteByte: rctx.vdp1.mem.VRAM[event.write.address] = event.write.value; break;
             case EvtType::VRAMWriteWord:
@@ -690,10 +711,20 @@ void SoftwareVDPRenderer::VDP2RenderThread() {
                 rctx.framebufferSwapSignal.Set();
                 break;
 
-            case EvtType::VDP2BeginFrame: VDP2InitFrame(); break;
+            case EvtType::VDP2BeginFrame:
+                rctx.skipFrame = event.beginFrame.skip;
+                VDP2InitFrame();
+                break;
             case EvtType::VDP2UpdateEnabledBGs: VDP2UpdateEnabledBGs(); break;
             case EvtType::VDP2DrawLine: //
             {
+                YMIR_HOST_TIMER(m_hostTiming, debug::HostTimingComponent::VDP2);
+                if (rctx.skipFrame) {
+                    // Update line state without drawing or composing anything
+                    VDP2PrepareLine(event.drawLine.vcnt);
+                    VDP2FinishLine(event.drawLine.vcnt);
+                    break;
+                }
                 const bool deinterlaceRender = m_enhancements.deinterlace;
                 const bool threadedDeinterlacer = m_threadedDeinterlacer;
                 const bool interlaced = rctx.vdp2.regs.TVMD.IsInterlaced();
@@ -716,39 +747,21 @@ void SoftwareVDPRenderer::VDP2RenderThread() {
             }
             case EvtType::VDP2EndFrame: rctx.renderFinishedSignal.Set(); break;
 
-            case EvtType::VDP2VRAMWriteByte: rctx.vdp2.mem.VRAM[event.write.address] = event.write.value; break;
-            case EvtType::VDP2VRAMWriteWord:
-                util::WriteBE<uint16>(&rctx.vdp2.mem.VRAM[event.write.address], event.write.value);
+            case EvtType::VDP2VRAMWriteSpan:
+                std::memcpy(&rctx.vdp2.mem.VRAM[event.writeSpan.address], event.writeSpan.data.data(),
+                            event.writeSpan.length);
                 break;
-            case EvtType::VDP2CRAMWriteByte:
-                // Update CRAM cache if color RAM mode changed is in one of the RGB555 modes
-                if (rctx.vdp2.regs.vramControl.colorRAMMode <= 1) {
-                    const uint8 oldValue = rctx.vdp2.mem.CRAM[event.write.address];
-                    rctx.vdp2.mem.CRAM[event.write.address] = event.write.value;
-
-                    if (oldValue != event.write.value) {
-                        const uint32 cramAddress = event.write.address & ~1;
-                        const uint16 colorValue = VDP2ReadRendererCRAM<uint16>(cramAddress);
-                        const Color555 color5{.u16 = colorValue};
-                        rctx.vdp2.CRAMCache[cramAddress / sizeof(uint16)] = ConvertRGB555to888(color5);
-                    }
-                } else {
-                    rctx.vdp2.mem.CRAM[event.write.address] = event.write.value;
-                }
-                break;
-            case EvtType::VDP2CRAMWriteWord:
+            case EvtType::VDP2CRAMWriteSpan:
+                std::memcpy(&rctx.vdp2.mem.CRAM[event.writeSpan.address], event.writeSpan.data.data(),
+                            event.writeSpan.length);
+
                 // Update CRAM cache if color RAM mode is in one of the RGB555 modes
                 if (rctx.vdp2.regs.vramControl.colorRAMMode <= 1) {
-                    const uint16 oldValue = util::ReadBE<uint16>(&rctx.vdp2.mem.CRAM[event.write.address]);
-                    util::WriteBE<uint16>(&rctx.vdp2.mem.CRAM[event.write.address], event.write.value);
-
-                    if (oldValue != event.write.value) {
-                        const uint32 cramAddress = event.write.address & ~1;
-                        const Color555 color5{.u16 = (uint16)event.write.value};
-                        rctx.vdp2.CRAMCache[cramAddress / sizeof(uint16)] = ConvertRGB555to888(color5);
+                    const uint32 end = event.writeSpan.address + event.writeSpan.length;
+                    for (uint32 addr = event.writeSpan.address & ~1; addr < end; addr += sizeof(uint16)) {
+                        const Color555 color5{.u16 = util::ReadBE<uint16>(&rctx.vdp2.mem.CRAM[addr])};
+                        rctx.vdp2.CRAMCache[addr / sizeof(uint16)] = ConvertRGB555to888(color5);
                     }
-                } else {
-                    util::WriteBE<uint16>(&rctx.vdp2.mem.CRAM[event.write.address], event.write.value);
                 }
                 break;
             case EvtType::VDP2RegWrite:
@@ -3,6 +3,8 @@
 #include <ymir/util/bit_ops.hpp>
 #include <ymir/util/dev_log.hpp>
 
+#include <algorithm>
+
 namespace ymir::vdp {
 
 VDP::VDP(core::Scheduler &scheduler, core::Configuration &config)
@@ -935,12 +937,28 @@ void VDP::BeginVPhaseLastLine() {
 
     devlog::trace<grp::vdp2_render>("Begin VDP2 frame, VDP1 framebuffer {}", m_state.displayFB);
 
+    m_renderer->SetSkipNextFrame(!ShouldRenderFrame());
     m_renderer->VDP2BeginFrame();
 
     m_state.regs2.TVSTAT.VBLANK = 0;
     m_cbVBlankStateChange(false);
 }
 
+bool VDP::ShouldRenderFrame() {
+    switch (m_frameSkip.mode) {
+    case config::FrameSkip::Mode::Off: return true;
+    case config::FrameSkip::Mode::Interval:
+        if (m_frameSkipCounter > 0) {
+            --m_frameSkipCounter;
+            return false;
+        }
+        m_frameSkipCounter = std::max(m_frameSkip.interval, 1u) - 1;
+        return true;
+    case config::FrameSkip::Mode::OnRequest: return m_frameRenderRequested.exchange(false, std::memory_order_relaxed);
+    }
+    return true;
+}
+
 void VDP::VDP1SwapFramebuffer() {
     devlog::trace<grp::vdp1>("Swapping framebuffers - draw {}, display {}", m_state.displayFB, m_state.displayFB ^ 1);
 
@@ -0,0 +1,325 @@
+#include <ymir/media/disc_hash.hpp>
+
+#include <ymir/util/data_ops.hpp>
+#include <ymir/util/thread_name.hpp>
+
+#include <xxh3.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <fstream>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace ymir::media {
+
+namespace {
+
+    struct Shard {
+        const IBinaryReader *reader;
+        uintmax_t offset;
+        uintmax_t size;
+    };
+
+    struct TrackShards {
+        uint32 index;
+        uintmax_t size;
+        size_t firstShard;
+        size_t numShards;
+    };
+
+    bool ParseHash(std::string_view str, XXH128Hash &hash) {
+        if (str.size() != hash.size() * 2) {
+            return false;
+        }
+        for (size_t i = 0; i < hash.size(); ++i) {
+            const auto [ptr, ec] = std::from_chars(str.data() + i * 2, str.data() + i * 2 + 2, hash[i], 16);
+            if (ec != std::errc{} || ptr != str.data() + i * 2 + 2) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Retrieves the absolute path of the file along with its size and modification time
+    bool StatFile(const std::filesystem::path &path, std::string &key, uintmax_t &size, sint64 &mtime) {
+        std::error_code error{};
+        const auto absPath = std::filesystem::absolute(path, error);
+        if (error) {
+            return false;
+        }
+        size = std::filesystem::file_size(absPath, error);
+        if (error) {
+            return false;
+        }
+        const auto writeTime = std::filesystem::last_write_time(absPath, error);
+        if (error) {
+            return false;
+        }
+        const auto u8Path = absPath.lexically_normal().u8string();
+        key.assign(u8Path.begin(), u8Path.end());
+        mtime = writeTime.time_since_epoch().count();
+        return true;
+    }
+
+} // namespace
+
+std::optional<XXH128Hash> CalcDiscImageHash(const Disc &disc, uint32 numThreads) {
+    // Split all tracks into shards
+    std::vector<Shard> shards{};
+    std::vector<TrackShards> tracks{};
+    for (const Session &session : disc.sessions) {
+        for (const Track &track : session.tracks) {
+            if (!track.binaryReader) {
+                continue;
+            }
+            const uintmax_t numFrames = track.endFrameAddress - track.startFrameAddress + 1;
+            const uintmax_t trackSize = std::min(track.binaryReader->Size(), numFrames * track.unitSize);
+
+            TrackShards &trackShards = tracks.emplace_back();
+            trackShards.index = track.index;
+            trackShards.size = trackSize;
+            trackShards.firstShard = shards.size();
+            for (uintmax_t offset = 0; offset < trackSize; offset += kDiscHashShardSize) {
+                const uintmax_t size = std::min<uintmax_t>(kDiscHashShardSize, trackSize - offset);
+                shards.push_back({track.binaryReader.get(), offset, size});
+            }
+            trackShards.numShards = shards.size() - trackShards.firstShard;
+        }
+    }
+
+    // Hash all shards. Workers claim shards in order; each shard hash lands in its own slot.
+    // Readers that cannot provide direct views may not be thread-safe, so their reads are serialized.
+    std::vector<XXH128_canonical_t> shardHashes(shards.size());
+    std::atomic<size_t> nextShard = 0;
+    std::atomic_bool failed = false;
+    std::mutex readMutex{};
+
+    auto worker = [&] {
+        std::vector<uint8> buffer{};
+        size_t shardIndex;
+        while (!failed.load(std::memory_order_relaxed) &&
+               (shardIndex = nextShard.fetch_add(1, std::memory_order_relaxed)) < shards.size()) {
+            const Shard &shard = shards[shardIndex];
+            std::span<const uint8> data = shard.reader->View(shard.offset, shard.size);
+            if (data.empty()) {
+                buffer.resize(shard.size);
+                std::unique_lock lock{readMutex};
+                if (shard.reader->Read(shard.offset, shard.size, buffer) != shard.size) {
+                    failed = true;
+                    return;
+                }
+                lock.unlock();
+                data = {buffer.data(), static_cast<size_t>(shard.size)};
+            }
+            XXH128_canonicalFromHash(&shardHashes[shardIndex], XXH3_128bits(data.data(), data.size()));
+        }
+    };
+
+    if (numThreads == 0) {
+        numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    numThreads = std::min<size_t>(numThreads, shards.size());
+    if (numThreads <= 1) {
+        worker();
+    } else {
+        std::vector<std::jthread> threads{};
+        threads.reserve(numThreads - 1);
+        for (uint32 i = 1; i < numThreads; ++i) {
+            threads.emplace_back([&] {
+                util::SetCurrentThreadName("Disc hash worker");
+                worker();
+            });
+        }
+        worker();
+    }
+    if (failed) {
+        return std::nullopt;
+    }
+
+    // Combine shard hashes in disc order along with the track layout
+    XXH3_state_t *xxh3State = XXH3_createState();
+    if (xxh3State == nullptr) {
+        return std::nullopt;
+    }
+    XXH3_128bits_reset_withSeed(xxh3State, kDiscImageHashSeed);
+    for (const TrackShards &track : tracks) {
+        std::array<uint8, 12> trackHeader{};
+        util::WriteLE<uint32>(&trackHeader[0], track.index);
+        util::WriteLE<uint64>(&trackHeader[4], track.size);
+        XXH3_128bits_update(xxh3State, trackHeader.data(), trackHeader.size());
+        XXH3_128bits_update(xxh3State, &shardHashes[track.firstShard], track.numShards * sizeof(XXH128_canonical_t));
+    }
+    XXH128_canonical_t canonicalHash{};
+    XXH128_canonicalFromHash(&canonicalHash, XXH3_128bits_digest(xxh3State));
+    XXH3_freeState(xxh3State);
+
+    XXH128Hash out{};
+    std::copy_n(canonicalHash.digest, out.size(), out.begin());
+    return out;
+}
+
+// -----------------------------------------------------------------------------
+// Hash cache
+
+static constexpr std::string_view kCacheHeader = "# Ymir disc hash cache v2";
+
+bool DiscHashCache::Load(const std::filesystem::path &path, std::error_code &error) {
+    error.clear();
+    m_entries.clear();
+    m_dirty = false;
+
+    std::ifstream in{path};
+    if (!in) {
+        if (!std::filesystem::exists(path, error) && !error) {
+            return true;
+        }
+        if (!error) {
+            error = std::make_error_code(std::errc::io_error);
+        }
+        return false;
+    }
+
+    // Each entry is a line with: <hash> <size> <mtime> <absolute path>
+    // followed by one line for each track file with: + <size> <mtime> <absolute path>
+    // Entries that fail to parse are skipped; the cache is rebuilt on the next save anyway.
+    std::string line{};
+    if (!std::getline(in, line) || line != kCacheHeader) {
+        return true;
+    }
+
+    // Splits a line into its first field and the <size> <mtime> <path> fields that follow it
+    auto parseLine = [](std::string_view str, std::string_view &first, std::string &path, uintmax_t &size,
+                        sint64 &mtime) {
+        const size_t sizePos = str.find(' ');
+        const size_t mtimePos = sizePos == str.npos ? str.npos : str.find(' ', sizePos + 1);
+        const size_t pathPos = mtimePos == str.npos ? str.npos : str.find(' ', mtimePos + 1);
+        if (pathPos == str.npos || pathPos + 1 >= str.size()) {
+            return false;
+        }
+        const char *sizeEnd = str.data() + mtimePos;
+        if (std::from_chars(str.data() + sizePos + 1, sizeEnd, size).ptr != sizeEnd) {
+            return false;
+        }
+        const char *mtimeEnd = str.data() + pathPos;
+        if (std::from_chars(str.data() + mtimePos + 1, mtimeEnd, mtime).ptr != mtimeEnd) {
+            return false;
+        }
+        first = str.substr(0, sizePos);
+        path.assign(str.substr(pathPos + 1));
+        return true;
+    };
+
+    std::string key{};
+    Entry entry{};
+    bool valid = false;
+    while (std::getline(in, line)) {
+        std::string_view first{};
+        std::string path{};
+        uintmax_t size{};
+        sint64 mtime{};
+        const bool parsed = parseLine(line, first, path, size, mtime);
+        if (parsed && first == "+") {
+            if (valid) {
+                entry.files.push_back({.path = std::move(path), .size = size, .mtime = mtime});
+            }
+            continue;
+        }
+
+        if (valid) {
+            m_entries.insert_or_assign(std::move(key), std::move(entry));
+        }
+        entry = {};
+        valid = parsed && ParseHash(first, entry.hash);
+        if (valid) {
+            key = std::move(path);
+            entry.size = size;
+            entry.mtime = mtime;
+        }
+    }
+    if (valid) {
+        m_entries.insert_or_assign(std::move(key), std::move(entry));
+    }
+    return true;
+}
+
+bool DiscHashCache::Save(const std::filesystem::path &path, std::error_code &error) const {
+    error.clear();
+
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    {
+        std::ofstream out{tmpPath, std::ios::trunc};
+        if (!out) {
+            error = std::make_error_code(std::errc::io_error);
+            return false;
+        }
+        out << kCacheHeader << '\n';
+        for (const auto &[key, entry] : m_entries) {
+            out << ToString(entry.hash) << ' ' << entry.size << ' ' << entry.mtime << ' ' << key << '\n';
+            for (const FileStamp &file : entry.files) {
+                out << "+ " << file.size << ' ' << file.mtime << ' ' << file.path << '\n';
+            }
+        }
+        if (!out) {
+            error = std::make_error_code(std::errc::io_error);
+            return false;
+        }
+    }
+    std::filesystem::rename(tmpPath, path, error);
+    if (error) {
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+std::optional<XXH128Hash> DiscHashCache::Find(const std::filesystem::path &imagePath) const {
+    std::string key{};
+    uintmax_t size{};
+    sint64 mtime{};
+    if (!StatFile(imagePath, key, size, mtime)) {
+        return std::nullopt;
+    }
+    auto it = m_entries.find(key);
+    if (it == m_entries.end() || it->second.size != size || it->second.mtime != mtime) {
+        return std::nullopt;
+    }
+    for (const FileStamp &file : it->second.files) {
+        std::string filePath{};
+        const std::u8string u8Path{file.path.begin(), file.path.end()};
+        if (!StatFile(u8Path, filePath, size, mtime) || size != file.size || mtime != file.mtime) {
+            return std::nullopt;
+        }
+    }
+    return it->second.hash;
+}
+
+void DiscHashCache::Store(const std::filesystem::path &imagePath, const XXH128Hash &hash,
+                          std::span<const std::filesystem::path> imageFiles) {
+    std::string key{};
+    Entry entry{.hash = hash};
+    if (!StatFile(imagePath, key, entry.size, entry.mtime)) {
+        return;
+    }
+    for (const auto &path : imageFiles) {
+        FileStamp file{};
+        if (!StatFile(path, file.path, file.size, file.mtime)) {
+            return;
+        }
+        const bool duplicate = file.path == key || std::ranges::any_of(entry.files, [&](const FileStamp &other) {
+                                   return other.path == file.path;
+                               });
+        if (!duplicate) {
+            entry.files.push_back(std::move(file));
+        }
+    }
+    m_entries.insert_or_assign(std::move(key), std::move(entry));
+    m_dirty = true;
+}
+
+} // namespace ymir::media
@@ -354,7 +354,7 @@ static std::optional<CueSheet> LoadSheet(std::filesystem::path cuePath, CbLoader
     return sheet;
 }
 
-bool Load(std::filesystem::path cuePath, Disc &disc, bool preloadToRAM, CbLoaderMessage cbMsg) {
+bool Load(std::filesystem::path cuePath, Disc &disc, bool preloadToRAM, CbLoaderMessage cbMsg, bool sharedPreload) {
     util::ScopeGuard sgInvalidateDisc{[&] { disc.Invalidate(); }};
 
     auto errorMsg = [&](std::string message) { cbMsg(MessageType::Error, message); };
@@ -370,7 +370,9 @@ bool Load(std::filesystem::path cuePath, Disc &disc, bool preloadToRAM, CbLoader
         if (sheet.files.size() == 1) {
             auto &file = sheet.files.front();
             std::error_code err{};
-            if (preloadToRAM) {
+            if (preloadToRAM && sharedPreload) {
+                reader = std::make_shared<SharedMemoryBinaryReader>(file.path, err);
+            } else if (preloadToRAM) {
                 reader = std::make_shared<MemoryBinaryReader>(file.path, err);
             } else {
                 reader = std::make_shared<MemoryMappedBinaryReader>(file.path, err);
@@ -614,7 +616,9 @@ bool Load(std::filesystem::path cuePath, Disc &disc, bool preloadToRAM, CbLoader
                         }
                     }();
                 } else {
-                    if (preloadToRAM) {
+                    if (preloadToRAM && sharedPreload) {
+                        fileReader = std::make_shared<SharedMemoryBinaryReader>(file.path, err);
+                    } else if (preloadToRAM) {
                         fileReader = std::make_shared<MemoryBinaryReader>(file.path, err);
                     } else {
                         fileReader = std::make_shared<MemoryMappedBinaryReader>(file.path, err);
@@ -863,6 +867,11 @@ bool Load(std::filesystem::path cuePath, Disc &disc, bool preloadToRAM, CbLoader
 
         debugMsg(fmt::format("BIN/CUE: Final FAD = {:6X}, file offset = {:X}", frameAddress - 1, currFileBinOffset));
 
+        disc.imageFiles.assign({cuePath});
+        for (const auto &file : sheet.files) {
+            disc.imageFiles.push_back(file.path);
+        }
+
         sgInvalidateDisc.Cancel();
 
         return true;
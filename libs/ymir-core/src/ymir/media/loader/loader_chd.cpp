@@ -441,6 +441,8 @@ bool Load(std::filesystem::path chdPath, Disc &disc, bool preloadToRAM, CbLoader
         disc.header.ReadFrom(std::span<uint8, 256>{headerData.begin(), 256});
     }
 
+    disc.imageFiles.assign({chdPath});
+
     sgInvalidateDisc.Cancel();
     return true;
 }
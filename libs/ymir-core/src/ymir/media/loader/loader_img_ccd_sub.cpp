@@ -46,7 +46,7 @@ struct CaseInsensitiveStringCompare {
 const std::set<std::string, CaseInsensitiveStringCompare> kValidSectionNames = {"CloneCD", "Disc",  "CDText",
                                                                                 "Session", "Entry", "TRACK"};
 
-bool Load(std::filesystem::path ccdPath, Disc &disc, bool preloadToRAM, CbLoaderMessage cbMsg) {
+bool Load(std::filesystem::path ccdPath, Disc &disc, bool preloadToRAM, CbLoaderMessage cbMsg, bool sharedPreload) {
     std::ifstream in{ccdPath, std::ios::binary};
 
     util::ScopeGuard sgInvalidateDisc{[&] { disc.Invalidate(); }};
@@ -239,7 +239,9 @@ bool Load(std::filesystem::path ccdPath, Disc &disc, bool preloadToRAM, CbLoader
     imgPath.replace_extension("img");
     std::error_code err{};
     std::shared_ptr<IBinaryReader> imgFile;
-    if (preloadToRAM) {
+    if (preloadToRAM && sharedPreload) {
+        imgFile = std::make_shared<SharedMemoryBinaryReader>(imgPath, err);
+    } else if (preloadToRAM) {
         imgFile = std::make_shared<MemoryBinaryReader>(imgPath, err);
     } else {
         imgFile = std::make_shared<MemoryMappedBinaryReader>(imgPath, err);
@@ -351,6 +353,8 @@ bool Load(std::filesystem::path ccdPath, Disc &disc, bool preloadToRAM, CbLoader
         session.BuildTOC();
     }
 
+    disc.imageFiles.assign({ccdPath, imgPath});
+
     sgInvalidateDisc.Cancel();
 
     return true;
@@ -18,7 +18,7 @@ static std::string ToLower(std::string str) {
     return str;
 }
 
-bool Load(std::filesystem::path isoPath, Disc &disc, bool preloadToRAM, CbLoaderMessage cbMsg) {
+bool Load(std::filesystem::path isoPath, Disc &disc, bool preloadToRAM, CbLoaderMessage cbMsg, bool sharedPreload) {
     util::ScopeGuard sgInvalidateDisc{[&] { disc.Invalidate(); }};
 
     auto invFmtMsg = [&](std::string message) { cbMsg(MessageType::InvalidFormat, message); };
@@ -91,7 +91,9 @@ bool Load(std::filesystem::path isoPath, Disc &disc, bool preloadToRAM, CbLoader
     index.endFrameAddress = track.endFrameAddress;
 
     std::error_code err{};
-    if (preloadToRAM) {
+    if (preloadToRAM && sharedPreload) {
+        track.binaryReader = std::make_unique<SharedMemoryBinaryReader>(isoPath, err);
+    } else if (preloadToRAM) {
         track.binaryReader = std::make_unique<MemoryBinaryReader>(isoPath, err);
     } else {
         track.binaryReader = std::make_unique<MemoryMappedBinaryReader>(isoPath, err);
@@ -115,6 +117,8 @@ bool Load(std::filesystem::path isoPath, Disc &disc, bool preloadToRAM, CbLoader
 
     session.BuildTOC();
 
+    disc.imageFiles.assign({isoPath});
+
     sgInvalidateDisc.Cancel();
 
     return true;
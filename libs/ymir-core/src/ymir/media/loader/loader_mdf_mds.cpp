@@ -93,7 +93,7 @@ struct MDSFooter {
 #pragma pack(pop)
 static_assert(sizeof(MDSFooter) == 0x10);
 
-bool Load(std::filesystem::path mdsPath, Disc &disc, bool preloadToRAM, CbLoaderMessage cbMsg) {
+bool Load(std::filesystem::path mdsPath, Disc &disc, bool preloadToRAM, CbLoaderMessage cbMsg, bool sharedPreload) {
     std::ifstream in{mdsPath, std::ios::binary};
 
     util::ScopeGuard sgInvalidateDisc{[&] { disc.Invalidate(); }};
@@ -290,7 +290,9 @@ bool Load(std::filesystem::path mdsPath, Disc &disc, bool preloadToRAM, CbLoader
 
                 if (!files.contains(mdfPath)) {
                     std::error_code err{};
-                    if (preloadToRAM) {
+                    if (preloadToRAM && sharedPreload) {
+                        files.insert({mdfPath, std::make_shared<SharedMemoryBinaryReader>(mdfPath, err)});
+                    } else if (preloadToRAM) {
                         files.insert({mdfPath, std::make_shared<MemoryBinaryReader>(mdfPath, err)});
                     } else {
                         files.insert({mdfPath, std::make_shared<MemoryMappedBinaryReader>(mdfPath, err)});
@@ -366,6 +368,11 @@ bool Load(std::filesystem::path mdsPath, Disc &disc, bool preloadToRAM, CbLoader
         session.BuildTOC();
     }
 
+    disc.imageFiles.assign({mdsPath});
+    for (const auto &[mdfPath, _] : files) {
+        disc.imageFiles.push_back(mdfPath);
+    }
+
     sgInvalidateDisc.Cancel();
 
     return true;
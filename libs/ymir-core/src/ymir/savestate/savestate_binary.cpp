@@ -0,0 +1,539 @@
+#include <ymir/savestate/savestate_binary.hpp>
+
+#include <mio/mmap.hpp>
+
+#include <xxh3.h>
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+namespace ymir::savestate::binary {
+
+namespace {
+
+    // -------------------------------------------------------------------------
+    // Flattened sections for save state structures that are not trivially copyable
+
+    struct MetaSection {
+        XXH128Hash discHash;
+        uint64 msh2SpilloverCycles;
+        uint64 ssh2SpilloverCycles;
+        uint64 sh1SpilloverCycles;
+        uint64 sh1FracCycles;
+        bool cdblockLLE;
+    };
+
+    struct SCUSection {
+        std::array<SCUDMASaveState, 3> dma;
+        SCUDSPState dsp;
+
+        SCUSaveState::CartType cartType;
+
+        uint32 intrMask;
+        uint32 intrStatus;
+        uint16 abusIntrsPendingAck;
+        uint8 pendingIntrLevel;
+        uint8 pendingIntrIndex;
+
+        uint16 timer0Counter;
+        uint16 timer0Compare;
+        uint16 timer1Reload;
+        bool timer1Mode;
+        bool timerEnable;
+
+        bool wramSizeSelect;
+    };
+
+    struct SMPCSection {
+        std::array<uint8, 7> IREG;
+        std::array<uint8, 32> OREG;
+        uint8 COMREG;
+        uint8 SR;
+        bool SF;
+        uint8 PDR1;
+        uint8 PDR2;
+        uint8 DDR1;
+        uint8 DDR2;
+        uint8 IOSEL;
+        uint8 EXLE;
+
+        bool intbackGetPeripheralData;
+        bool intbackOptimize;
+        uint8 intbackPort1mode;
+        uint8 intbackPort2mode;
+        uint64 intbackReportOffset;
+        bool intbackInProgress;
+
+        uint8 busValue;
+        bool resetDisable;
+        uint8 commandEventState;
+
+        sint64 rtcTimestamp;
+        uint64 rtcSysClockCount;
+    };
+
+    static_assert(std::is_trivially_copyable_v<MetaSection>);
+    static_assert(std::is_trivially_copyable_v<SchedulerSaveState>);
+    static_assert(std::is_trivially_copyable_v<SystemSaveState>);
+    static_assert(std::is_trivially_copyable_v<SH2SaveState>);
+    static_assert(std::is_trivially_copyable_v<SCUSection>);
+    static_assert(std::is_trivially_copyable_v<SMPCSection>);
+    static_assert(std::is_trivially_copyable_v<VDPSaveState>);
+    static_assert(std::is_trivially_copyable_v<SCSPSaveState>);
+    static_assert(std::is_trivially_copyable_v<CDInterfaceSaveState>);
+    static_assert(std::is_trivially_copyable_v<CDBlockSaveState>);
+    static_assert(std::is_trivially_copyable_v<SH1SaveState>);
+    static_assert(std::is_trivially_copyable_v<YGRSaveState>);
+    static_assert(std::is_trivially_copyable_v<CDDriveSaveState>);
+
+    static_assert(std::is_standard_layout_v<SystemSaveState>);
+    static_assert(std::is_standard_layout_v<VDPSaveState>);
+    static_assert(std::is_standard_layout_v<SCSPSaveState>);
+
+    void ToSection(const SCUSaveState &state, SCUSection &section) {
+        section.dma = state.dma;
+        section.dsp = state.dsp;
+        section.cartType = state.cartType;
+        section.intrMask = state.intrMask;
+        section.intrStatus = state.intrStatus;
+        section.abusIntrsPendingAck = state.abusIntrsPendingAck;
+        section.pendingIntrLevel = state.pendingIntrLevel;
+        section.pendingIntrIndex = state.pendingIntrIndex;
+        section.timer0Counter = state.timer0Counter;
+        section.timer0Compare = state.timer0Compare;
+        section.timer1Reload = state.timer1Reload;
+        section.timer1Mode = state.timer1Mode;
+        section.timerEnable = state.timerEnable;
+        section.wramSizeSelect = state.wramSizeSelect;
+    }
+
+    void FromSection(const SCUSection &section, SCUSaveState &state) {
+        state.dma = section.dma;
+        state.dsp = section.dsp;
+        state.cartType = section.cartType;
+        state.intrMask = section.intrMask;
+        state.intrStatus = section.intrStatus;
+        state.abusIntrsPendingAck = section.abusIntrsPendingAck;
+        state.pendingIntrLevel = section.pendingIntrLevel;
+        state.pendingIntrIndex = section.pendingIntrIndex;
+        state.timer0Counter = section.timer0Counter;
+        state.timer0Compare = section.timer0Compare;
+        state.timer1Reload = section.timer1Reload;
+        state.timer1Mode = section.timer1Mode;
+        state.timerEnable = section.timerEnable;
+        state.wramSizeSelect = section.wramSizeSelect;
+    }
+
+    void ToSection(const SMPCSaveState &state, SMPCSection &section) {
+        section.IREG = state.IREG;
+        section.OREG = state.OREG;
+        section.COMREG = state.COMREG;
+        section.SR = state.SR;
+        section.SF = state.SF;
+        section.PDR1 = state.PDR1;
+        section.PDR2 = state.PDR2;
+        section.DDR1 = state.DDR1;
+        section.DDR2 = state.DDR2;
+        section.IOSEL = state.IOSEL;
+        section.EXLE = state.EXLE;
+        section.intbackGetPeripheralData = state.intback.getPeripheralData;
+        section.intbackOptimize = state.intback.optimize;
+        section.intbackPort1mode = state.intback.port1mode;
+        section.intbackPort2mode = state.intback.port2mode;
+        section.intbackReportOffset = state.intback.reportOffset;
+        section.intbackInProgress = state.intback.inProgress;
+        section.busValue = state.busValue;
+        section.resetDisable = state.resetDisable;
+        section.commandEventState = state.commandEventState;
+        section.rtcTimestamp = state.rtcTimestamp;
+        section.rtcSysClockCount = state.rtcSysClockCount;
+    }
+
+    void FromSection(const SMPCSection &section, SMPCSaveState &state) {
+        state.IREG = section.IREG;
+        state.OREG = section.OREG;
+        state.COMREG = section.COMREG;
+        state.SR = section.SR;
+        state.SF = section.SF;
+        state.PDR1 = section.PDR1;
+        state.PDR2 = section.PDR2;
+        state.DDR1 = section.DDR1;
+        state.DDR2 = section.DDR2;
+        state.IOSEL = section.IOSEL;
+        state.EXLE = section.EXLE;
+        state.intback.getPeripheralData = section.intbackGetPeripheralData;
+        state.intback.optimize = section.intbackOptimize;
+        state.intback.port1mode = section.intbackPort1mode;
+        state.intback.port2mode = section.intbackPort2mode;
+        state.intback.reportOffset = section.intbackReportOffset;
+        state.intback.inProgress = section.intbackInProgress;
+        state.busValue = section.busValue;
+        state.resetDisable = section.resetDisable;
+        state.commandEventState = section.commandEventState;
+        state.rtcTimestamp = section.rtcTimestamp;
+        state.rtcSysClockCount = section.rtcSysClockCount;
+    }
+
+    // -------------------------------------------------------------------------
+    // Section layout
+
+    // Fixed payload size of each section. Zero denotes variable-sized sections.
+    constexpr std::array<size_t, kNumSections> kFixedSizes = {
+        sizeof(MetaSection),          // Meta
+        sizeof(SchedulerSaveState),   // Scheduler
+        sizeof(SystemSaveState),      // System
+        sizeof(SH2SaveState),         // MSH2
+        sizeof(SH2SaveState),         // SSH2
+        sizeof(SCUSection),           // SCU
+        0,                            // SCUCartData
+        sizeof(SMPCSection),          // SMPC
+        0,                            // SMPCReport
+        sizeof(VDPSaveState),         // VDP
+        sizeof(SCSPSaveState),        // SCSP
+        sizeof(CDInterfaceSaveState), // CDInterface
+        sizeof(CDBlockSaveState),     // CDBlock
+        sizeof(SH1SaveState),         // SH1
+        sizeof(YGRSaveState),         // YGR
+        sizeof(CDDriveSaveState),     // CDDrive
+        sizeof(SaveState::cdblockDRAM), // CDBlockDRAM
+    };
+
+    // Offset of the large memory block within each section that must be aligned to a page boundary.
+    // SIZE_MAX denotes sections without large memory blocks.
+    constexpr std::array<size_t, kNumSections> kPageAnchors = {
+        SIZE_MAX,                           // Meta
+        SIZE_MAX,                           // Scheduler
+        offsetof(SystemSaveState, WRAMLow), // System
+        SIZE_MAX,                           // MSH2
+        SIZE_MAX,                           // SSH2
+        SIZE_MAX,                           // SCU
+        SIZE_MAX,                           // SCUCartData
+        SIZE_MAX,                           // SMPC
+        SIZE_MAX,                           // SMPCReport
+        offsetof(VDPSaveState, VRAM1),      // VDP
+        offsetof(SCSPSaveState, WRAM),      // SCSP
+        SIZE_MAX,                           // CDInterface
+        SIZE_MAX,                           // CDBlock
+        SIZE_MAX,                           // SH1
+        SIZE_MAX,                           // YGR
+        SIZE_MAX,                           // CDDrive
+        0,                                  // CDBlockDRAM
+    };
+
+    constexpr size_t kTableOffset = sizeof(FileHeader);
+    constexpr size_t kPayloadOffset = kTableOffset + sizeof(SectionHeader) * kNumSections;
+
+    constexpr size_t AlignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    constexpr size_t Index(SectionID id) {
+        return static_cast<size_t>(id);
+    }
+
+    // Determines if the section is stored for a save state with the given CD block mode.
+    constexpr bool IsSectionPresent(SectionID id, bool cdblockLLE) {
+        switch (id) {
+        case SectionID::CDBlock: return !cdblockLLE;
+        case SectionID::SH1: [[fallthrough]];
+        case SectionID::YGR: [[fallthrough]];
+        case SectionID::CDDrive: [[fallthrough]];
+        case SectionID::CDBlockDRAM: return cdblockLLE;
+        default: return true;
+        }
+    }
+
+    // Computes section offsets and sizes for the given state.
+    // Returns the total size of the binary save state.
+    size_t ComputeLayout(const SaveState &state, std::array<SectionHeader, kNumSections> &table) {
+        size_t pos = kPayloadOffset;
+        for (size_t i = 0; i < kNumSections; ++i) {
+            const auto id = static_cast<SectionID>(i);
+            size_t size = kFixedSizes[i];
+            if (id == SectionID::SCUCartData) {
+                size = state.scu.cartData.size();
+            } else if (id == SectionID::SMPCReport) {
+                size = state.smpc.intback.report.size();
+            } else if (!IsSectionPresent(id, state.cdblockLLE)) {
+                size = 0;
+            }
+
+            SectionHeader &section = table[i];
+            section = {};
+            if (size == 0) {
+                continue;
+            }
+
+            const size_t anchor = kPageAnchors[i];
+            if (anchor != SIZE_MAX) {
+                pos = AlignUp(pos + anchor, kPageSize) - anchor;
+            } else {
+                pos = AlignUp(pos, kSectionAlignment);
+            }
+            section.offset = pos;
+            section.size = size;
+            pos += size;
+        }
+        return pos;
+    }
+
+} // namespace
+
+size_t CalcSize(const SaveState &state) {
+    std::array<SectionHeader, kNumSections> table;
+    return ComputeLayout(state, table);
+}
+
+size_t Write(const SaveState &state, std::span<uint8> out, SectionChecksums *checksums) {
+    std::array<SectionHeader, kNumSections> table;
+    const size_t totalSize = ComputeLayout(state, table);
+    if (out.size() < totalSize) {
+        return 0;
+    }
+
+    uint8 *base = out.data();
+
+    // Zero out the header and all padding so that identical states produce identical outputs
+    std::memset(base, 0, kPayloadOffset);
+    for (size_t i = 0, pos = kPayloadOffset; i < kNumSections; ++i) {
+        if (table[i].size == 0) {
+            continue;
+        }
+        std::memset(base + pos, 0, table[i].offset - pos);
+        pos = table[i].offset + table[i].size;
+    }
+
+    auto write = [&](SectionID id, const void *data) {
+        SectionHeader &section = table[Index(id)];
+        if (section.size == 0) {
+            return;
+        }
+        uint8 *dst = base + section.offset;
+        std::memcpy(dst, data, section.size);
+        section.checksum = XXH3_64bits(dst, section.size);
+    };
+
+    // Field-by-field copies don't touch padding bytes, so clear them first
+    MetaSection meta;
+    std::memset(&meta, 0, sizeof(meta));
+    meta.discHash = state.discHash;
+    meta.msh2SpilloverCycles = state.msh2SpilloverCycles;
+    meta.ssh2SpilloverCycles = state.ssh2SpilloverCycles;
+    meta.sh1SpilloverCycles = state.sh1SpilloverCycles;
+    meta.sh1FracCycles = state.sh1FracCycles;
+    meta.cdblockLLE = state.cdblockLLE;
+
+    SCUSection scu;
+    std::memset(&scu, 0, sizeof(scu));
+    ToSection(state.scu, scu);
+
+    SMPCSection smpc;
+    std::memset(&smpc, 0, sizeof(smpc));
+    ToSection(state.smpc, smpc);
+
+    write(SectionID::Meta, &meta);
+    write(SectionID::Scheduler, &state.scheduler);
+    write(SectionID::System, &state.system);
+    write(SectionID::MSH2, &state.msh2);
+    write(SectionID::SSH2, &state.ssh2);
+    write(SectionID::SCU, &scu);
+    write(SectionID::SCUCartData, state.scu.cartData.data());
+    write(SectionID::SMPC, &smpc);
+    write(SectionID::SMPCReport, state.smpc.intback.report.data());
+    write(SectionID::VDP, &state.vdp);
+    write(SectionID::SCSP, &state.scsp);
+    write(SectionID::CDInterface, &state.cdif);
+    write(SectionID::CDBlock, &state.cdblock);
+    write(SectionID::SH1, &state.sh1);
+    write(SectionID::YGR, &state.ygr);
+    write(SectionID::CDDrive, &state.cddrive);
+    write(SectionID::CDBlockDRAM, state.cdblockDRAM.data());
+
+    FileHeader header{};
+    header.magic = kMagic;
+    header.version = kFormatVersion;
+    header.numSections = kNumSections;
+    header.headerSize = sizeof(FileHeader);
+    header.totalSize = totalSize;
+    std::memcpy(base, &header, sizeof(header));
+    std::memcpy(base + kTableOffset, table.data(), sizeof(table));
+
+    if (checksums != nullptr) {
+        for (size_t i = 0; i < kNumSections; ++i) {
+            (*checksums)[i] = table[i].checksum;
+        }
+    }
+
+    return totalSize;
+}
+
+void Write(const SaveState &state, std::vector<uint8> &out, SectionChecksums *checksums) {
+    out.resize(CalcSize(state));
+    Write(state, std::span<uint8>{out}, checksums);
+}
+
+ReadResult Read(std::span<const uint8> data, SaveState &state, SectionChecksums *checksums, bool verify) {
+    // Validate header
+    if (data.size() < sizeof(FileHeader)) {
+        return ReadResult::InvalidFormat;
+    }
+    FileHeader header{};
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != kMagic) {
+        return ReadResult::InvalidFormat;
+    }
+    if (header.version != kFormatVersion) {
+        return ReadResult::VersionMismatch;
+    }
+    if (header.numSections != kNumSections || header.headerSize != sizeof(FileHeader)) {
+        return ReadResult::LayoutMismatch;
+    }
+    if (data.size() < kPayloadOffset || data.size() < header.totalSize) {
+        return ReadResult::Truncated;
+    }
+
+    // Validate section table
+    std::array<SectionHeader, kNumSections> table;
+    std::memcpy(table.data(), data.data() + kTableOffset, sizeof(table));
+    for (const SectionHeader &section : table) {
+        if (section.size == 0) {
+            continue;
+        }
+        if (section.offset < kPayloadOffset || section.offset > header.totalSize ||
+            section.size > header.totalSize - section.offset) {
+            return ReadResult::Truncated;
+        }
+    }
+
+    const SectionHeader &metaSection = table[Index(SectionID::Meta)];
+    if (metaSection.size != sizeof(MetaSection)) {
+        return ReadResult::LayoutMismatch;
+    }
+    MetaSection meta{};
+    std::memcpy(&meta, data.data() + metaSection.offset, sizeof(meta));
+
+    for (size_t i = 0; i < kNumSections; ++i) {
+        const auto id = static_cast<SectionID>(i);
+        if (kFixedSizes[i] == 0) {
+            continue;
+        }
+        const size_t expectedSize = IsSectionPresent(id, meta.cdblockLLE) ? kFixedSizes[i] : 0;
+        if (table[i].size != expectedSize) {
+            return ReadResult::LayoutMismatch;
+        }
+    }
+
+    if (verify) {
+        for (const SectionHeader &section : table) {
+            if (section.size != 0 && XXH3_64bits(data.data() + section.offset, section.size) != section.checksum) {
+                return ReadResult::ChecksumMismatch;
+            }
+        }
+    }
+
+    // Everything checks out; load the sections.
+    // Sections whose contents match the target state are skipped.
+    auto shouldLoad = [&](SectionID id) {
+        const SectionHeader &section = table[Index(id)];
+        if (section.size == 0) {
+            return false;
+        }
+        if (checksums != nullptr) {
+            uint64 &checksum = (*checksums)[Index(id)];
+            if (checksum != 0 && checksum == section.checksum) {
+                return false;
+            }
+            checksum = section.checksum;
+        }
+        return true;
+    };
+    auto load = [&](SectionID id, void *dst) {
+        if (shouldLoad(id)) {
+            const SectionHeader &section = table[Index(id)];
+            std::memcpy(dst, data.data() + section.offset, section.size);
+        }
+    };
+    auto loadVector = [&](SectionID id, std::vector<uint8> &dst) {
+        const SectionHeader &section = table[Index(id)];
+        if (section.size == 0) {
+            dst.clear();
+            if (checksums != nullptr) {
+                (*checksums)[Index(id)] = 0;
+            }
+        } else if (shouldLoad(id)) {
+            const uint8 *src = data.data() + section.offset;
+            dst.assign(src, src + section.size);
+        }
+    };
+
+    if (shouldLoad(SectionID::Meta)) {
+        state.discHash = meta.discHash;
+        state.msh2SpilloverCycles = meta.msh2SpilloverCycles;
+        state.ssh2SpilloverCycles = meta.ssh2SpilloverCycles;
+        state.sh1SpilloverCycles = meta.sh1SpilloverCycles;
+        state.sh1FracCycles = meta.sh1FracCycles;
+        state.cdblockLLE = meta.cdblockLLE;
+    }
+    load(SectionID::Scheduler, &state.scheduler);
+    load(SectionID::System, &state.system);
+    load(SectionID::MSH2, &state.msh2);
+    load(SectionID::SSH2, &state.ssh2);
+    if (shouldLoad(SectionID::SCU)) {
+        SCUSection scu{};
+        std::memcpy(&scu, data.data() + table[Index(SectionID::SCU)].offset, sizeof(scu));
+        FromSection(scu, state.scu);
+    }
+    loadVector(SectionID::SCUCartData, state.scu.cartData);
+    if (shouldLoad(SectionID::SMPC)) {
+        SMPCSection smpc{};
+        std::memcpy(&smpc, data.data() + table[Index(SectionID::SMPC)].offset, sizeof(smpc));
+        FromSection(smpc, state.smpc);
+    }
+    loadVector(SectionID::SMPCReport, state.smpc.intback.report);
+    load(SectionID::VDP, &state.vdp);
+    load(SectionID::SCSP, &state.scsp);
+    load(SectionID::CDInterface, &state.cdif);
+    load(SectionID::CDBlock, &state.cdblock);
+    load(SectionID::SH1, &state.sh1);
+    load(SectionID::YGR, &state.ygr);
+    load(SectionID::CDDrive, &state.cddrive);
+    load(SectionID::CDBlockDRAM, state.cdblockDRAM.data());
+
+    return ReadResult::Success;
+}
+
+bool WriteFile(const std::filesystem::path &path, const SaveState &state, std::error_code &error) {
+    error.clear();
+
+    std::vector<uint8> buffer{};
+    Write(state, buffer);
+
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+    if (!out) {
+        error.assign(errno, std::generic_category());
+        return false;
+    }
+    out.write(reinterpret_cast<const char *>(buffer.data()), buffer.size());
+    if (!out) {
+        error.assign(errno, std::generic_category());
+        return false;
+    }
+    return true;
+}
+
+ReadResult ReadFile(const std::filesystem::path &path, SaveState &state, std::error_code &error,
+                    SectionChecksums *checksums, bool verify) {
+    error.clear();
+
+    auto mmap = mio::make_mmap_source(path.native(), error);
+    if (error) {
+        return ReadResult::FilesystemError;
+    }
+
+    const auto *data = reinterpret_cast<const uint8 *>(mmap.data());
+    return Read(std::span<const uint8>{data, mmap.size()}, state, checksums, verify);
+}
+
+} // namespace ymir::savestate::binary
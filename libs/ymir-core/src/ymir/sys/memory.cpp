@@ -5,7 +5,7 @@
 namespace ymir::sys {
 
 SystemMemory::SystemMemory() {
-    nullprog::CopyNullProgram(IPL);
+    nullprog::CopyNullProgram(GetIPLMemory());
     Reset(true);
 }
 
@@ -17,7 +17,7 @@ void SystemMemory::Reset(bool hard) {
 }
 
 void SystemMemory::MapMemory(SH2Bus &bus) {
-    bus.MapArray(0x000'0000, 0x00F'FFFF, IPL, false);
+    bus.MapArray(0x000'0000, 0x00F'FFFF, GetIPLMemory(), false);
     m_internalBackupRAM.MapMemory(bus, 0x018'0000, 0x01F'FFFF);
     bus.MapArray(0x020'0000, 0x02F'FFFF, WRAMLow, true);
     bus.MapArray(0x600'0000, 0x7FF'FFFF, WRAMHigh, true);
@@ -31,8 +31,18 @@ void SystemMemory::MapMemory(SH2Bus &bus) {
 }
 
 void SystemMemory::LoadIPL(std::span<uint8, kIPLSize> ipl) {
-    std::copy(ipl.begin(), ipl.end(), IPL.begin());
-    m_iplHash = CalcHash128(IPL.data(), IPL.size(), kIPLHashSeed);
+    m_ipl.MapPrivate();
+    std::copy(ipl.begin(), ipl.end(), m_ipl.Data());
+    m_iplHash = CalcHash128(m_ipl.Data(), kIPLSize, kIPLHashSeed);
+}
+
+bool SystemMemory::LoadIPL(std::shared_ptr<const util::SharedMemory> ipl) {
+    if (ipl == nullptr || ipl->Size() != kIPLSize) {
+        return false;
+    }
+    m_ipl.MapShared(std::move(ipl), false);
+    m_iplHash = CalcHash128(m_ipl.Data(), kIPLSize, kIPLHashSeed);
+    return true;
 }
 
 XXH128Hash SystemMemory::GetIPLHash() const {
@@ -0,0 +1,598 @@
+#include <ymir/sys/parallel_slave_sh2.hpp>
+
+#include <ymir/util/bit_ops.hpp>
+#include <ymir/util/data_ops.hpp>
+#include <ymir/util/dev_assert.hpp>
+#include <ymir/util/dev_log.hpp>
+#include <ymir/util/inline.hpp>
+#include <ymir/util/thread_name.hpp>
+#include <ymir/util/unreachable.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64)
+    #include <immintrin.h>
+#endif
+
+namespace ymir::sys {
+
+namespace grp {
+
+    // -----------------------------------------------------------------------------
+    // Dev log groups
+
+    // Hierarchy:
+    //
+    // parallel_ssh2
+
+    struct parallel_ssh2 {
+        static constexpr bool enabled = true;
+        static constexpr devlog::Level level = devlog::level::debug;
+        static constexpr std::string_view name = "SH2-S-Thread";
+    };
+
+} // namespace grp
+
+// Number of polls before a waiting thread goes to sleep. Slices are only a few microseconds long, so both threads
+// usually pick up the other's signal while still spinning.
+static constexpr uint32 kSpinIterations = 4096;
+
+FORCE_INLINE static void SpinPause() {
+#if defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #if defined(_MSC_VER)
+    __yield();
+    #else
+    asm volatile("yield");
+    #endif
+#endif
+}
+
+// Waits until the counter differs from the given value.
+static uint64 WaitForChange(const std::atomic<uint64> &counter, uint64 value) {
+    for (uint32 i = 0; i < kSpinIterations; i++) {
+        const uint64 current = counter.load(std::memory_order_acquire);
+        if (current != value) {
+            return current;
+        }
+        SpinPause();
+    }
+    uint64 current = counter.load(std::memory_order_acquire);
+    while (current == value) {
+        counter.wait(value, std::memory_order_acquire);
+        current = counter.load(std::memory_order_acquire);
+    }
+    return current;
+}
+template <bool emulateCache>
+static uint64 AdvanceSlave(sh2::SH2 &slave, uint64 cycles, uint64 spilloverCycles) {
+    return slave.Advance<false, emulateCache>(cycles, spilloverCycles);
+}
+
+// Shared memory may be read by the slave SH-2 thread while the emulator thread writes to it. Conflicting accesses are
+// always detected and rolled back, but they must not tear or be optimized away in the meantime.
+
+template <mem_primitive T>
+FORCE_INLINE static T AtomicReadBE(uint8 *ptr) {
+    T value = std::atomic_ref<T>{*reinterpret_cast<T *>(ptr)}.load(std::memory_order_relaxed);
+    if constexpr (std::endian::native == std::endian::little) {
+        value = bit::byte_swap(value);
+    }
+    return value;
+}
+
+template <mem_primitive T>
+FORCE_INLINE static void AtomicWriteBE(uint8 *ptr, T value) {
+    if constexpr (std::endian::native == std::endian::little) {
+        value = bit::byte_swap(value);
+    }
+    std::atomic_ref<T>{*reinterpret_cast<T *>(ptr)}.store(value, std::memory_order_relaxed);
+}
+
+ParallelSlaveSH2::ParallelSlaveSH2(sh2::SH2 &master, sh2::SH2 &slave, SH2Bus &bus)
+    : m_master(master)
+    , m_slave(slave)
+    , m_bus(bus) {
+
+    using Self = ParallelSlaveSH2;
+    m_slaveBus.MapBoth(
+        0x000'0000, 0x7FF'FFFF, this,
+        [](uint32 address, void *ctx) -> uint8 { return static_cast<Self *>(ctx)->SlaveRead<uint8>(address); },
+        [](uint32 address, void *ctx) -> uint16 { return static_cast<Self *>(ctx)->SlaveRead<uint16>(address); },
+        [](uint32 address, void *ctx) -> uint32 { return static_cast<Self *>(ctx)->SlaveRead<uint32>(address); },
+        [](uint32 address, uint8 value, void *ctx) { static_cast<Self *>(ctx)->SlaveWrite<uint8>(address, value); },
+        [](uint32 address, uint16 value, void *ctx) { static_cast<Self *>(ctx)->SlaveWrite<uint16>(address, value); },
+        [](uint32 address, uint32 value, void *ctx) { static_cast<Self *>(ctx)->SlaveWrite<uint32>(address, value); },
+        [](uint32 address, uint32, bool, void *ctx) { return static_cast<Self *>(ctx)->SlaveBusWait(address); });
+
+    m_masterBus.MapBoth(
+        0x000'0000, 0x7FF'FFFF, this,
+        [](uint32 address, void *ctx) -> uint8 { return static_cast<Self *>(ctx)->MasterRead<uint8>(address); },
+        [](uint32 address, void *ctx) -> uint16 { return static_cast<Self *>(ctx)->MasterRead<uint16>(address); },
+        [](uint32 address, void *ctx) -> uint32 { return static_cast<Self *>(ctx)->MasterRead<uint32>(address); },
+        [](uint32 address, uint8 value, void *ctx) { static_cast<Self *>(ctx)->MasterWrite<uint8>(address, value); },
+        [](uint32 address, uint16 value, void *ctx) { static_cast<Self *>(ctx)->MasterWrite<uint16>(address, value); },
+        [](uint32 address, uint32 value, void *ctx) { static_cast<Self *>(ctx)->MasterWrite<uint32>(address, value); },
+        [](uint32 address, uint32 size, bool write, void *ctx) {
+            return static_cast<Self *>(ctx)->MasterBusWait(address, size, write);
+        });
+}
+
+ParallelSlaveSH2::~ParallelSlaveSH2() {
+    StopThread();
+}
+
+void ParallelSlaveSH2::AddSharedMemory(uint32 start, uint32 end, std::span<uint8> memory, bool writable) {
+    YMIR_DEV_ASSERT(!m_enabled);
+    YMIR_DEV_ASSERT(bit::is_power_of_two(memory.size()) && memory.size() >= SH2Bus::kPageSize);
+    YMIR_DEV_ASSERT(m_regions.size() < 255);
+
+    auto &region = m_regions.emplace_back();
+    region.memory = memory.data();
+    region.mask = static_cast<uint32>(memory.size() - 1);
+    region.writable = writable;
+    if (writable) {
+        const size_t lineCount = memory.size() >> kLineShift;
+        region.shadow.resize(memory.size());
+        region.dirty.resize(memory.size());
+        region.slaveReads.resize(lineCount);
+        region.slaveWrites.resize(lineCount);
+        region.masterAccesses.resize(lineCount);
+        region.masterWrites.resize(lineCount);
+    }
+
+    const uint32 startIndex = start >> SH2Bus::kPageShift;
+    const uint32 endIndex = end >> SH2Bus::kPageShift;
+    for (uint32 i = startIndex; i <= endIndex; i++) {
+        m_pageRegions[i] = static_cast<uint8>(m_regions.size());
+    }
+}
+
+void ParallelSlaveSH2::UpdateAccessCycles() {
+    m_slaveBus.CopyAccessCycles(m_bus);
+    m_masterBus.CopyAccessCycles(m_bus);
+}
+
+void ParallelSlaveSH2::Enable(bool enable) {
+    if (m_enabled == enable) {
+        return;
+    }
+
+    if (enable) {
+        devlog::debug<grp::parallel_ssh2>("Enabling threaded slave SH-2");
+
+        UpdateAccessCycles();
+
+        m_backoffSlices = 0;
+        m_sequentialSlices = 0;
+        m_threadRunning = true;
+        m_thread = std::thread{[this] { ThreadLoop(); }};
+    } else {
+        devlog::debug<grp::parallel_ssh2>(
+            "Disabling threaded slave SH-2 - {} slices, {} committed, {} diverted, {} rolled back, {} sequential",
+            m_stats.slices, m_stats.committed, m_stats.diverted, m_stats.rolledBack, m_stats.sequential);
+
+        StopThread();
+    }
+
+    m_enabled = enable;
+}
+
+// -----------------------------------------------------------------------------
+// Slices
+
+template <bool emulateCache>
+bool ParallelSlaveSH2::Begin(uint64 cycles, uint64 masterCycles, uint64 slaveCycles) {
+    YMIR_DEV_ASSERT(m_enabled);
+    YMIR_DEV_ASSERT(m_state == State::Idle);
+
+    ++m_stats.slices;
+    if (m_sequentialSlices > 0) {
+        --m_sequentialSlices;
+        ++m_stats.sequential;
+        return false;
+    }
+
+    // Every step but the last advances the master SH-2 by at least one cycle
+    const uint64 maxSteps = (cycles > masterCycles ? cycles - masterCycles : 0) + 1;
+    if (m_stepEnds.size() < maxSteps) {
+        m_stepEnds.resize(maxSteps);
+    }
+
+    m_master.SaveState(m_masterSnapshot);
+    m_slave.SaveState(m_slaveSnapshot);
+    m_master.UseBus(m_masterBus);
+    m_slave.UseBus(m_slaveBus);
+    m_masterStart = masterCycles;
+    m_slaveStart = slaveCycles;
+    m_step = 0;
+    m_deviceAccessed = false;
+    m_slaveFailed.store(false, std::memory_order_relaxed);
+    m_state = State::Speculating;
+
+    m_advance = &AdvanceSlave<emulateCache>;
+    m_published.store(0, std::memory_order_relaxed);
+    const uint64 submitted = m_submitted.load(std::memory_order_relaxed) + 1;
+    m_submitted.store(submitted, std::memory_order_release);
+    m_submitted.notify_one();
+    return true;
+}
+
+template bool ParallelSlaveSH2::Begin<false>(uint64, uint64, uint64);
+template bool ParallelSlaveSH2::Begin<true>(uint64, uint64, uint64);
+
+bool ParallelSlaveSH2::EndStep(uint64 masterCycles) {
+    if (m_state != State::Speculating) {
+        return false;
+    }
+
+    YMIR_DEV_ASSERT(m_step < m_stepEnds.size());
+    m_stepEnds[m_step] = masterCycles;
+    ++m_step;
+    m_published.store(m_step, std::memory_order_release);
+    m_published.notify_one();
+
+    // No point in continuing if the slave SH-2 already failed
+    return !m_slaveFailed.load(std::memory_order_relaxed);
+}
+
+bool ParallelSlaveSH2::Finish(uint64 cycles, uint64 &masterCycles, uint64 &slaveCycles) {
+    switch (m_state) {
+    case State::Speculating:
+        CloseSlice();
+        if (!Validate()) {
+            return Rollback(masterCycles, slaveCycles);
+        }
+        CommitWrites();
+        ResetTracking();
+        RestoreBuses();
+        m_state = State::Idle;
+
+        m_cbAdvanceSCU(masterCycles - m_masterStart);
+        slaveCycles = m_sliceResult;
+        ++m_stats.committed;
+        m_backoffSlices = 0;
+        return masterCycles >= cycles;
+
+    case State::Diverted:
+        // Finish the step interrupted by the device access as the interleaved loop would
+        m_state = State::Idle;
+        slaveCycles = m_advance(m_slave, masterCycles, m_sliceResult);
+        m_cbAdvanceSCU(masterCycles - m_divertCycles);
+        ++m_stats.diverted;
+        return masterCycles >= cycles;
+
+    case State::Aborted: return Rollback(masterCycles, slaveCycles);
+
+    default: util::unreachable();
+    }
+}
+
+bool ParallelSlaveSH2::Divert() {
+    YMIR_DEV_ASSERT(m_state == State::Speculating);
+
+    CloseSlice();
+    if (!Validate()) {
+        // Leave the master SH-2 running against the tracking bus with devices cut off until the slice is rolled back
+        m_state = State::Aborted;
+        return false;
+    }
+    CommitWrites();
+    ResetTracking();
+    RestoreBuses();
+    m_state = State::Diverted;
+
+    // Both SH-2s are now where the interleaved loop would be in the middle of the current step. Catch up the SCU with
+    // the steps completed so far.
+    m_divertCycles = m_step > 0 ? m_stepEnds[m_step - 1] : m_masterStart;
+    m_cbAdvanceSCU(m_divertCycles - m_masterStart);
+    return true;
+}
+
+bool ParallelSlaveSH2::Rollback(uint64 &masterCycles, uint64 &slaveCycles) {
+    UndoMasterWrites();
+    DiscardWrites();
+    ResetTracking();
+    m_master.LoadState(m_masterSnapshot);
+    m_slave.LoadState(m_slaveSnapshot);
+    RestoreBuses();
+    m_state = State::Idle;
+
+    masterCycles = m_masterStart;
+    slaveCycles = m_slaveStart;
+    ++m_stats.rolledBack;
+
+    m_backoffSlices = std::clamp<uint32>(m_backoffSlices * 2, 1, kMaxBackoffSlices);
+    m_sequentialSlices = m_backoffSlices;
+    return false;
+}
+
+void ParallelSlaveSH2::RestoreBuses() {
+    m_master.UseBus(m_bus);
+    m_slave.UseBus(m_bus);
+}
+
+// -----------------------------------------------------------------------------
+// Slave SH-2 memory accesses
+//
+// These run on the slave SH-2 thread. Step N of the slave SH-2 only starts after the master SH-2 has finished step N,
+// so every master SH-2 write up to step N is visible here.
+
+template <mem_primitive T>
+FORCE_INLINE T ParallelSlaveSH2::SlaveRead(uint32 address) {
+    const uint8 index = m_pageRegions[address >> SH2Bus::kPageShift];
+    if (index == 0) [[unlikely]] {
+        m_deviceAccessed = true;
+        return 0;
+    }
+
+    SharedRegion &region = m_regions[index - 1];
+    const uint32 offset = address & region.mask;
+    if (!region.writable) {
+        return util::ReadBE<T>(&region.memory[offset]);
+    }
+
+    // Own writes take precedence over shared memory
+    static constexpr T kAllDirty = static_cast<T>(~T{});
+    const T dirty = util::ReadBE<T>(&region.dirty[offset]);
+    if (dirty == kAllDirty) {
+        return util::ReadBE<T>(&region.shadow[offset]);
+    }
+
+    const uint32 line = offset >> kLineShift;
+    if (region.slaveReads[line] == 0) {
+        if (region.slaveWrites[line] == 0) {
+            m_slaveLines.push_back({.line = line, .region = static_cast<uint8>(index - 1)});
+        }
+        region.slaveReads[line] = m_slaveStamp;
+    }
+
+    const T value = AtomicReadBE<T>(&region.memory[offset]);
+    if (dirty != 0) {
+        return static_cast<T>((value & ~dirty) | (util::ReadBE<T>(&region.shadow[offset]) & dirty));
+    }
+    return value;
+}
+
+template <mem_primitive T>
+FORCE_INLINE void ParallelSlaveSH2::SlaveWrite(uint32 address, T value) {
+    const uint8 index = m_pageRegions[address >> SH2Bus::kPageShift];
+    if (index == 0) [[unlikely]] {
+        m_deviceAccessed = true;
+        return;
+    }
+
+    SharedRegion &region = m_regions[index - 1];
+    if (!region.writable) {
+        return;
+    }
+
+    const uint32 offset = address & region.mask;
+    util::WriteBE<T>(&region.shadow[offset], value);
+
+    static constexpr T kAllDirty = static_cast<T>(~T{});
+    if (util::ReadNE<T>(&region.dirty[offset]) != kAllDirty) {
+        util::WriteNE<T>(&region.dirty[offset], kAllDirty);
+        m_writeLog.push_back({.offset = offset, .region = static_cast<uint8>(index - 1), .size = sizeof(T)});
+    }
+
+    const uint32 line = offset >> kLineShift;
+    if (region.slaveWrites[line] == 0) {
+        if (region.slaveReads[line] == 0) {
+            m_slaveLines.push_back({.line = line, .region = static_cast<uint8>(index - 1)});
+        }
+        region.slaveWrites[line] = m_slaveStamp;
+    }
+}
+
+bool ParallelSlaveSH2::SlaveBusWait(uint32 address) {
+    // The wait state of a device cannot be checked from this thread
+    if (m_pageRegions[address >> SH2Bus::kPageShift] == 0) [[unlikely]] {
+        m_deviceAccessed = true;
+    }
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+// Master SH-2 memory accesses
+//
+// These run on the emulator thread while the slave SH-2 runs one step behind on its own thread.
+
+template <mem_primitive T>
+FORCE_INLINE T ParallelSlaveSH2::MasterRead(uint32 address) {
+    const uint8 index = m_pageRegions[address >> SH2Bus::kPageShift];
+    if (index == 0) [[unlikely]] {
+        if (m_state == State::Speculating) {
+            Divert();
+        }
+        return m_state == State::Diverted ? m_bus.Read<T>(address) : 0;
+    }
+
+    SharedRegion &region = m_regions[index - 1];
+    const uint32 offset = address & region.mask;
+    if (region.writable) {
+        const uint32 line = offset >> kLineShift;
+        if (region.masterAccesses[line] == 0) {
+            m_masterLines.push_back({.line = line, .region = static_cast<uint8>(index - 1)});
+        }
+        region.masterAccesses[line] = m_step + 1;
+    }
+    return util::ReadBE<T>(&region.memory[offset]);
+}
+
+template <mem_primitive T>
+FORCE_INLINE void ParallelSlaveSH2::MasterWrite(uint32 address, T value) {
+    const uint8 index = m_pageRegions[address >> SH2Bus::kPageShift];
+    if (index == 0) [[unlikely]] {
+        if (m_state == State::Speculating) {
+            Divert();
+        }
+        if (m_state == State::Diverted) {
+            m_bus.Write<T>(address, value);
+        }
+        return;
+    }
+
+    SharedRegion &region = m_regions[index - 1];
+    if (!region.writable) {
+        return;
+    }
+
+    const uint32 offset = address & region.mask;
+    const uint32 line = offset >> kLineShift;
+    if (region.masterAccesses[line] == 0) {
+        m_masterLines.push_back({.line = line, .region = static_cast<uint8>(index - 1)});
+    }
+    region.masterAccesses[line] = m_step + 1;
+    region.masterWrites[line] = m_step + 1;
+
+    uint8 *ptr = &region.memory[offset];
+    m_undoLog.push_back({.offset = offset,
+                         .value = util::ReadBE<T>(ptr),
+                         .region = static_cast<uint8>(index - 1),
+                         .size = sizeof(T)});
+    AtomicWriteBE<T>(ptr, value);
+}
+
+bool ParallelSlaveSH2::MasterBusWait(uint32 address, uint32 size, bool write) {
+    if (m_pageRegions[address >> SH2Bus::kPageShift] != 0 || m_state == State::Aborted) {
+        return false;
+    }
+    // Devices are in the same state as in the interleaved loop up to the first access, so they can be queried directly
+    return m_bus.IsBusWait(address, size, write);
+}
+
+// -----------------------------------------------------------------------------
+// Validation
+
+bool ParallelSlaveSH2::Validate() const {
+    if (m_deviceAccessed) {
+        return false;
+    }
+
+    // In the interleaved loop, the slave SH-2 sees master SH-2 writes up to its own step and the master SH-2 sees slave
+    // SH-2 writes up to the step before. Speculation is only valid if no line was accessed out of that order.
+    for (const LineRef &ref : m_slaveLines) {
+        const SharedRegion &region = m_regions[ref.region];
+        const uint32 read = region.slaveReads[ref.line];
+        const uint32 written = region.slaveWrites[ref.line];
+        if (read != 0 && region.masterWrites[ref.line] > read) {
+            return false;
+        }
+        if (written != 0 && region.masterAccesses[ref.line] > written) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ParallelSlaveSH2::CommitWrites() {
+    for (const WriteLogEntry &entry : m_writeLog) {
+        SharedRegion &region = m_regions[entry.region];
+        std::memcpy(&region.memory[entry.offset], &region.shadow[entry.offset], entry.size);
+    }
+    DiscardWrites();
+}
+
+void ParallelSlaveSH2::DiscardWrites() {
+    for (const WriteLogEntry &entry : m_writeLog) {
+        std::memset(&m_regions[entry.region].dirty[entry.offset], 0, entry.size);
+    }
+    m_writeLog.clear();
+}
+
+void ParallelSlaveSH2::UndoMasterWrites() {
+    for (auto it = m_undoLog.rbegin(); it != m_undoLog.rend(); ++it) {
+        uint8 *ptr = &m_regions[it->region].memory[it->offset];
+        switch (it->size) {
+        case 1: util::WriteBE<uint8>(ptr, it->value); break;
+        case 2: util::WriteBE<uint16>(ptr, it->value); break;
+        default: util::WriteBE<uint32>(ptr, it->value); break;
+        }
+    }
+    m_undoLog.clear();
+}
+
+void ParallelSlaveSH2::ResetTracking() {
+    for (const LineRef &ref : m_slaveLines) {
+        m_regions[ref.region].slaveReads[ref.line] = 0;
+        m_regions[ref.region].slaveWrites[ref.line] = 0;
+    }
+    for (const LineRef &ref : m_masterLines) {
+        m_regions[ref.region].masterAccesses[ref.line] = 0;
+        m_regions[ref.region].masterWrites[ref.line] = 0;
+    }
+    m_slaveLines.clear();
+    m_masterLines.clear();
+    m_undoLog.clear();
+}
+
+// -----------------------------------------------------------------------------
+// Threading
+
+void ParallelSlaveSH2::ThreadLoop() {
+    util::SetCurrentThreadName("Slave SH-2 thread");
+
+    uint64 completed = m_completed.load(std::memory_order_relaxed);
+    while (true) {
+        WaitForChange(m_submitted, completed);
+        if (!m_threadRunning) {
+            break;
+        }
+
+        RunSlice();
+
+        ++completed;
+        m_completed.store(completed, std::memory_order_release);
+        m_completed.notify_one();
+    }
+}
+
+void ParallelSlaveSH2::RunSlice() {
+    uint64 slaveCycles = m_slaveStart;
+    uint64 step = 0;
+    while (true) {
+        const uint64 published = WaitForChange(m_published, step);
+        const uint64 stepCount = published & ~kSliceClosed;
+        while (step < stepCount) {
+            m_slaveStamp = static_cast<uint32>(step + 1);
+            slaveCycles = m_advance(m_slave, m_stepEnds[step], slaveCycles);
+            ++step;
+            if (m_deviceAccessed) {
+                // The rest of the speculative run is useless
+                m_slaveFailed.store(true, std::memory_order_relaxed);
+                m_sliceResult = slaveCycles;
+                return;
+            }
+        }
+        if (published & kSliceClosed) {
+            break;
+        }
+    }
+    m_sliceResult = slaveCycles;
+}
+
+void ParallelSlaveSH2::CloseSlice() {
+    m_published.store(m_step | kSliceClosed, std::memory_order_release);
+    m_published.notify_one();
+
+    const uint64 submitted = m_submitted.load(std::memory_order_relaxed);
+    if (m_completed.load(std::memory_order_acquire) != submitted) {
+        WaitForChange(m_completed, submitted - 1);
+    }
+}
+
+void ParallelSlaveSH2::StopThread() {
+    if (m_thread.joinable()) {
+        m_threadRunning = false;
+        m_submitted.fetch_add(1, std::memory_order_release);
+        m_submitted.notify_one();
+        m_thread.join();
+        m_completed.store(m_submitted.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+} // namespace ymir::sys
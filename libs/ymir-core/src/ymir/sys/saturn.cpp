@@ -6,6 +6,8 @@
 
 #include <bit>
 #include <cassert>
+#include <mutex>
+#include <unordered_map>
 
 namespace ymir {
 
@@ -48,6 +50,86 @@ namespace grp {
 
 } // namespace grp
 
+// -----------------------------------------------------------------------------
+// Instance memory
+
+namespace {
+
+    // Blocks of virtual memory backing Saturn instances, indexed by address
+    struct InstanceMemoryRegistry {
+        std::mutex mutex;
+        std::unordered_map<void *, util::VirtualMemory> blocks;
+    };
+
+    InstanceMemoryRegistry &GetInstanceMemoryRegistry() {
+        static InstanceMemoryRegistry registry;
+        return registry;
+    }
+
+} // namespace
+
+// Virtual memory is page-aligned
+static_assert(alignof(Saturn) <= 4096);
+
+void *Saturn::operator new(std::size_t size) {
+    util::VirtualMemory memory{size, {.hugePages = true}};
+    if (!memory.IsAllocated()) {
+        throw std::bad_alloc{};
+    }
+    void *ptr = memory.GetMemory();
+
+    auto &registry = GetInstanceMemoryRegistry();
+    std::unique_lock lock{registry.mutex};
+    registry.blocks.emplace(ptr, std::move(memory));
+    return ptr;
+}
+
+void *Saturn::operator new(std::size_t size, std::align_val_t) {
+    return operator new(size);
+}
+
+void Saturn::operator delete(void *ptr) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    auto &registry = GetInstanceMemoryRegistry();
+    std::unique_lock lock{registry.mutex};
+    registry.blocks.erase(ptr);
+}
+
+void Saturn::operator delete(void *ptr, std::align_val_t) noexcept {
+    operator delete(ptr);
+}
+
+util::VirtualMemory::Backing Saturn::GetMemoryBacking() const {
+    auto &registry = GetInstanceMemoryRegistry();
+    std::unique_lock lock{registry.mutex};
+    if (auto it = registry.blocks.find(const_cast<Saturn *>(this)); it != registry.blocks.end()) {
+        return it->second.GetBacking();
+    }
+    return util::VirtualMemory::Backing::Regular;
+}
+
+bool Saturn::BindMemoryToCurrentNUMANode() {
+    const auto node = util::GetCurrentNUMANode();
+    if (!node) {
+        return false;
+    }
+
+    auto &registry = GetInstanceMemoryRegistry();
+    std::unique_lock lock{registry.mutex};
+    if (auto it = registry.blocks.find(this); it != registry.blocks.end()) {
+        if (it->second.BindToNUMANode(*node)) {
+            devlog::debug<grp::system>("Bound instance memory to NUMA node {}", *node);
+            return true;
+        }
+    }
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+// Implementation
+
 Saturn::Saturn()
     : masterSH2(mainBus, true)
     , slaveSH2(mainBus, false)
@@ -150,6 +232,11 @@ Saturn::Saturn()
     masterSH2.BindEmulateCacheOption(m_emulateSH2Caches);
     slaveSH2.BindEmulateCacheOption(m_emulateSH2Caches);
 
+    m_parallelSlaveSH2.AddSharedMemory(0x000'0000, 0x00F'FFFF, mem.GetIPLMemory(), false);
+    m_parallelSlaveSH2.AddSharedMemory(0x020'0000, 0x02F'FFFF, mem.WRAMLow, true);
+    m_parallelSlaveSH2.AddSharedMemory(0x600'0000, 0x7FF'FFFF, mem.WRAMHigh, true);
+    m_parallelSlaveSH2.SetAdvanceSCUCallback(util::MakeClassMemberRequiredCallback<&Saturn::AdvanceIdleSCU>(this));
+
     ConfigureAccessCycles(false);
 
     m_enableDebugTracing = false;
@@ -161,6 +248,7 @@ Saturn::Saturn()
     configuration.system.debugTracing.Observe([&](bool enabled) { UpdateDebugTracing(enabled); });
     configuration.system.emulateSH2Cache.Observe([&](bool enabled) { UpdateSH2CacheEmulation(enabled); });
     configuration.system.sh2ClockFactor.Observe([&](RatioU32 factor) { UpdateSH2ClockFactor(factor); });
+    configuration.system.threadedSlaveSH2.Observe([&](bool enabled) { m_parallelSlaveSH2.Enable(enabled); });
     configuration.system.videoStandard.Observe(
         [&](core::config::sys::VideoStandard videoStandard) { UpdateVideoStandard(videoStandard); });
     configuration.cdblock.useLLE.Observe([&](bool enabled) { SetCDBlockLLE(enabled); });
@@ -221,6 +309,10 @@ void Saturn::LoadIPL(std::span<uint8, sys::kIPLSize> ipl) {
     mem.LoadIPL(ipl);
 }
 
+bool Saturn::LoadIPL(std::shared_ptr<const util::SharedMemory> ipl) {
+    return mem.LoadIPL(std::move(ipl));
+}
+
 void Saturn::LoadCDBlockROM(std::span<uint8, sh1::kROMSize> rom) {
     SH1.LoadROM(rom);
 }
@@ -468,6 +560,37 @@ bool Saturn::LoadState(const savestate::SaveState &state, bool skipROMChecks) {
     return true;
 }
 
+void Saturn::UseTraceRecorder(debug::trace::TraceRecorder *recorder) {
+    using debug::trace::Source;
+
+    if (m_traceRecorder != nullptr) {
+        for (size_t i = 0; i < debug::trace::kNumSources; ++i) {
+            m_traceRecorder->BindCycleCounter(static_cast<Source>(i), nullptr);
+        }
+    }
+    m_traceRecorder = recorder;
+
+    if (recorder == nullptr) {
+        masterSH2.UseTracer(nullptr);
+        slaveSH2.UseTracer(nullptr);
+        SCU.UseTracer(nullptr);
+        CDBlock.UseTracer(nullptr);
+        return;
+    }
+
+    const uint64 *cycles = &m_scheduler.CurrentCountRef();
+    recorder->BindCycleCounter(Source::System, cycles);
+    recorder->BindCycleCounter(Source::MasterSH2, cycles, &masterSH2.GetSliceCyclesRef());
+    recorder->BindCycleCounter(Source::SlaveSH2, cycles, &slaveSH2.GetSliceCyclesRef());
+    recorder->BindCycleCounter(Source::SCU, cycles);
+    recorder->BindCycleCounter(Source::CDBlock, cycles);
+
+    masterSH2.UseTracer(&recorder->GetMasterSH2Tracer());
+    slaveSH2.UseTracer(&recorder->GetSlaveSH2Tracer());
+    SCU.UseTracer(&recorder->GetSCUTracer());
+    CDBlock.UseTracer(&recorder->GetCDBlockTracer());
+}
+
 void Saturn::DumpCDBlockDRAM(std::ostream &out) {
     out.write((const char *)CDBlockDRAM.data(), CDBlockDRAM.size());
 }
@@ -506,7 +629,10 @@ void Saturn::RunFrameImpl() {
             return;
         }
     }
-    SCSP.SyncSCSPThreadPublic();
+    SCSP.FlushOutput();
+    if (m_hostTiming != nullptr) [[unlikely]] {
+        m_hostTiming->EndFrame();
+    }
 }
 
 template <bool debug, bool enableSH2Cache, bool cdblockLLE>
@@ -519,24 +645,45 @@ bool Saturn::Run() {
     if (SCU.IsDMAActive()) {
         // Stall both SH2 CPUs and only run the SCU and other stuff
         execCycles = cycles;
+        YMIR_HOST_TIMER(m_hostTiming, debug::HostTimingComponent::SCU);
         SCU.Advance<debug>(execCycles);
     } else {
         execCycles = m_msh2SpilloverCycles;
         m_msh2SpilloverCycles = 0;
         if (slaveSH2Enabled) {
             uint64 slaveCycles = m_ssh2SpilloverCycles;
-            do {
+            bool sliceDone = false;
+            if (!debug && m_parallelSlaveSH2.IsEnabled() && SCU.IsIdle() &&
+                m_parallelSlaveSH2.Begin<enableSH2Cache>(cycles, execCycles, slaveCycles)) {
+                // The slave SH-2 follows the master SH-2 one step behind on its own thread. The SCU is idle, so it is
+                // advanced through all steps at once. The outcome is the same as the interleaved loop below, which
+                // finishes the timeslice if the master SH-2 touches a device or the slave SH-2 run is rolled back.
+                do {
+                    const uint64 targetCycles = std::min(execCycles + kSH2SyncMaxStep, cycles);
+                    YMIR_HOST_TIMER(m_hostTiming, debug::HostTimingComponent::SH2);
+                    execCycles = masterSH2.Advance<debug, enableSH2Cache>(targetCycles, execCycles);
+                } while (m_parallelSlaveSH2.EndStep(execCycles) && execCycles < cycles);
+                sliceDone = m_parallelSlaveSH2.Finish(cycles, execCycles, slaveCycles);
+            }
+            while (!sliceDone) {
                 const uint64 prevExecCycles = execCycles;
                 const uint64 targetCycles = std::min(execCycles + kSH2SyncMaxStep, cycles);
-                execCycles = masterSH2.Advance<debug, enableSH2Cache>(targetCycles, execCycles);
-                slaveCycles = slaveSH2.Advance<debug, enableSH2Cache>(execCycles, slaveCycles);
-                SCU.Advance<debug>(execCycles - prevExecCycles);
+                {
+                    YMIR_HOST_TIMER(m_hostTiming, debug::HostTimingComponent::SH2);
+                    execCycles = masterSH2.Advance<debug, enableSH2Cache>(targetCycles, execCycles);
+                    slaveCycles = slaveSH2.Advance<debug, enableSH2Cache>(execCycles, slaveCycles);
+                }
+                {
+                    YMIR_HOST_TIMER(m_hostTiming, debug::HostTimingComponent::SCU);
+                    SCU.Advance<debug>(execCycles - prevExecCycles);
+                }
                 if constexpr (debug) {
                     if (m_debugBreakMgr.IsDebugBreakRaised()) {
                         break;
                     }
                 }
-            } while (execCycles < cycles);
+                sliceDone = execCycles >= cycles;
+            }
             if constexpr (debug) {
                 // If the SSH2 hits a breakpoint early, the cycle count may be shorter than the total executed cycles.
                 if (slaveCycles > execCycles) {
@@ -552,8 +699,14 @@ bool Saturn::Run() {
             do {
                 const uint64 prevExecCycles = execCycles;
                 const uint64 targetCycles = std::min(execCycles + kSH2SyncMaxStep, cycles);
-                execCycles = masterSH2.Advance<debug, enableSH2Cache>(targetCycles, execCycles);
-                SCU.Advance<debug>(execCycles - prevExecCycles);
+                {
+                    YMIR_HOST_TIMER(m_hostTiming, debug::HostTimingComponent::SH2);
+                    execCycles = masterSH2.Advance<debug, enableSH2Cache>(targetCycles, execCycles);
+                }
+                {
+                    YMIR_HOST_TIMER(m_hostTiming, debug::HostTimingComponent::SCU);
+                    SCU.Advance<debug>(execCycles - prevExecCycles);
+                }
                 if constexpr (debug) {
                     if (m_debugBreakMgr.IsDebugBreakRaised()) {
                         break;
@@ -580,6 +733,10 @@ bool Saturn::Run() {
         SMPC.Advance(smpcCycles);
     }*/
 
+    if (m_pcSampler != nullptr) [[unlikely]] {
+        SamplePCs(execCycles);
+    }
+
     m_scheduler.Advance(execCycles);
 
     if constexpr (debug) {
@@ -692,11 +849,40 @@ FORCE_INLINE void Saturn::AdvanceSH1(uint64 cycles) {
     const uint64 sh1Cycles = sh1ScaledCycles / clockRatios.CDBlockDen;
     m_sh1FracCycles = sh1ScaledCycles % clockRatios.CDBlockDen;
     if (sh1Cycles > 0) {
+        YMIR_HOST_TIMER(m_hostTiming, debug::HostTimingComponent::SH1);
         const uint64 sh1ExecCycles = SH1.Advance(sh1Cycles, m_sh1SpilloverCycles);
         m_sh1SpilloverCycles = sh1ExecCycles - sh1Cycles;
     }
 }
 
+void Saturn::AdvanceIdleSCU(uint64 cycles) {
+    YMIR_HOST_TIMER(m_hostTiming, debug::HostTimingComponent::SCU);
+    SCU.Advance<false>(cycles);
+}
+
+void Saturn::SamplePCs(uint64 cycles) {
+    const uint64 interval = m_pcSampler->GetInterval();
+    m_pcSampleCycles += cycles;
+    if (m_pcSampleCycles < interval) {
+        return;
+    }
+    const uint64 weight = m_pcSampleCycles / interval;
+    m_pcSampleCycles %= interval;
+
+    debug::PCSnapshot snapshot{};
+    snapshot.Set(debug::ProfiledCPU::MasterSH2, masterSH2.GetProbe().PC());
+    if (slaveSH2Enabled) {
+        snapshot.Set(debug::ProfiledCPU::SlaveSH2, slaveSH2.GetProbe().PC());
+    }
+    if (SCSP.GetProbe().IsM68KEnabled()) {
+        snapshot.Set(debug::ProfiledCPU::M68K, SCSP.GetProbe().GetPublishedM68KPC());
+    }
+    if (m_cdblockLLE) {
+        snapshot.Set(debug::ProfiledCPU::SH1, SH1.GetProbe().PC());
+    }
+    m_pcSampler->Record(snapshot, weight);
+}
+
 void Saturn::ConfigureAccessCycles(bool fastTimings) {
     if (fastTimings) {
         // HACK: this fixes X-Men/Marvel Super Heroes vs. Street Fighter
@@ -755,6 +941,7 @@ void Saturn::ConfigureAccessCycles(bool fastTimings) {
         // mainBus.SetAccessCycles(0x5FE'0000, 0x5FE'FFFF, 8, 8, 8, 8, 8, 8);       // SCU registers
         // mainBus.SetAccessCycles(0x600'0000, 0x7FF'FFFF, 8, 8, 8, 8, 8, 8);       // High Work RAM
     }
+    m_parallelSlaveSH2.UpdateAccessCycles();
 }
 
 void Saturn::UpdatePreferredRegionOrder(std::span<const core::config::sys::Region> regions) {
@@ -875,6 +1062,9 @@ void Saturn::SMPCOperations::RaiseNMI() {
 }
 
 void Saturn::SMPCOperations::EnableAndResetSlaveSH2() {
+    if (!m_saturn.configuration.system.slaveSH2Enabled) {
+        return;
+    }
     m_saturn.slaveSH2Enabled = true;
     m_saturn.slaveSH2.Reset(true);
 }
@@ -0,0 +1,70 @@
+#include <ymir/sys/shared_rom_pool.hpp>
+
+#include <algorithm>
+
+namespace ymir::sys {
+
+static constexpr uint64 kSharedROMHashSeed = 0x5EA4ED40B1E5C0DEull;
+
+static XXH128Hash HashContents(std::span<const uint8> data) {
+    return CalcHash128(data.data(), data.size(), kSharedROMHashSeed);
+}
+
+std::shared_ptr<const util::SharedMemory> SharedROMPool::Acquire(std::span<const uint8> data, std::error_code &error) {
+    error.clear();
+    const XXH128Hash hash = HashContents(data);
+    if (auto memory = Find(hash)) {
+        return memory;
+    }
+
+    // Created outside the lock; if another thread adds the same contents first, its object wins
+    std::shared_ptr<const util::SharedMemory> memory = util::SharedMemory::Create(data, error);
+    if (memory == nullptr) {
+        return nullptr;
+    }
+    return Insert(hash, std::move(memory));
+}
+
+std::shared_ptr<const util::SharedMemory> SharedROMPool::AcquireFile(const std::filesystem::path &path,
+                                                                     std::error_code &error) {
+    std::shared_ptr<const util::SharedMemory> memory = util::SharedMemory::MapFile(path, error);
+    if (memory == nullptr) {
+        return nullptr;
+    }
+    return Add(std::move(memory));
+}
+
+std::shared_ptr<const util::SharedMemory> SharedROMPool::Add(std::shared_ptr<const util::SharedMemory> memory) {
+    if (memory == nullptr) {
+        return nullptr;
+    }
+    const XXH128Hash hash = HashContents(memory->Data());
+    return Insert(hash, std::move(memory));
+}
+
+size_t SharedROMPool::GetLiveCount() const {
+    std::lock_guard lock{m_mutex};
+    return std::count_if(m_entries.begin(), m_entries.end(), [](const auto &entry) { return !entry.second.expired(); });
+}
+
+std::shared_ptr<const util::SharedMemory> SharedROMPool::Find(const XXH128Hash &hash) {
+    std::lock_guard lock{m_mutex};
+    if (auto it = m_entries.find(hash); it != m_entries.end()) {
+        return it->second.lock();
+    }
+    return nullptr;
+}
+
+std::shared_ptr<const util::SharedMemory> SharedROMPool::Insert(const XXH128Hash &hash,
+                                                                std::shared_ptr<const util::SharedMemory> memory) {
+    std::lock_guard lock{m_mutex};
+    std::erase_if(m_entries, [](const auto &entry) { return entry.second.expired(); });
+    auto &entry = m_entries[hash];
+    if (auto existing = entry.lock()) {
+        return existing;
+    }
+    entry = memory;
+    return memory;
+}
+
+} // namespace ymir::sys
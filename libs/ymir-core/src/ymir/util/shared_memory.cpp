@@ -0,0 +1,455 @@
+#include <ymir/util/shared_memory.hpp>
+
+#ifdef WIN32
+
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <Windows.h>
+
+    #include <ymir/util/bit_ops.hpp>
+
+#else // POSIX
+
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+    #if !defined(__linux__)
+        #include <atomic>
+        #include <cstdio>
+    #endif
+
+#endif
+
+#include <algorithm>
+#include <new>
+
+namespace util {
+
+static std::error_code LastError() {
+#ifdef WIN32
+    return {static_cast<int>(GetLastError()), std::system_category()};
+#else // POSIX
+    return {errno, std::generic_category()};
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// SharedMemory
+
+SharedMemory::~SharedMemory() {
+#ifdef WIN32
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_handle != kInvalidHandle) {
+        CloseHandle(m_handle);
+    }
+#else // POSIX
+    if (m_data != nullptr) {
+        munmap(const_cast<uint8 *>(m_data), m_size);
+    }
+    if (m_handle != kInvalidHandle) {
+        close(m_handle);
+    }
+#endif
+}
+
+bool SharedMemory::MapView(size_t size, std::error_code &error) {
+#ifdef WIN32
+    void *view = MapViewOfFile(m_handle, FILE_MAP_READ, 0, 0, size);
+    if (view == nullptr) {
+        error = LastError();
+        return false;
+    }
+#else // POSIX
+    void *view = mmap(nullptr, size, PROT_READ, MAP_SHARED, m_handle, 0);
+    if (view == MAP_FAILED) {
+        error = LastError();
+        return false;
+    }
+#endif
+    m_data = static_cast<const uint8 *>(view);
+    m_size = size;
+    return true;
+}
+
+std::shared_ptr<SharedMemory> SharedMemory::Create(std::span<const uint8> data, std::error_code &error) {
+    error.clear();
+    if (data.empty()) {
+        error = std::make_error_code(std::errc::invalid_argument);
+        return nullptr;
+    }
+
+    std::shared_ptr<SharedMemory> memory{new SharedMemory()};
+    const size_t size = data.size();
+
+#ifdef WIN32
+    memory->m_handle = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, bit::extract<32, 63>(size),
+                                          bit::extract<0, 31>(size), nullptr);
+    if (memory->m_handle == nullptr) {
+        error = LastError();
+        return nullptr;
+    }
+    void *view = MapViewOfFile(memory->m_handle, FILE_MAP_WRITE, 0, 0, size);
+    if (view == nullptr) {
+        error = LastError();
+        return nullptr;
+    }
+    std::copy(data.begin(), data.end(), static_cast<uint8 *>(view));
+    UnmapViewOfFile(view);
+#else // POSIX
+    #ifdef __linux__
+    memory->m_handle = memfd_create("ymir-shared-memory", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    #else
+    // Create a uniquely named object and unlink it right away; only the descriptor keeps it alive
+    static std::atomic<uint64> counter{0};
+    char name[64];
+    std::snprintf(name, sizeof(name), "/ymir-%d-%llu", static_cast<int>(getpid()),
+                  static_cast<unsigned long long>(counter++));
+    memory->m_handle = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (memory->m_handle != kInvalidHandle) {
+        shm_unlink(name);
+    }
+    #endif
+    if (memory->m_handle == kInvalidHandle) {
+        error = LastError();
+        return nullptr;
+    }
+    if (ftruncate(memory->m_handle, size) != 0) {
+        error = LastError();
+        return nullptr;
+    }
+    void *view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, memory->m_handle, 0);
+    if (view == MAP_FAILED) {
+        error = LastError();
+        return nullptr;
+    }
+    std::copy(data.begin(), data.end(), static_cast<uint8 *>(view));
+    munmap(view, size);
+    #ifdef __linux__
+    // Best effort; the object is only ever mapped read-only or copy-on-write by this class
+    fcntl(memory->m_handle, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL);
+    #endif
+#endif
+
+    if (!memory->MapView(size, error)) {
+        return nullptr;
+    }
+    return memory;
+}
+
+std::shared_ptr<SharedMemory> SharedMemory::MapFile(const std::filesystem::path &path, std::error_code &error) {
+    error.clear();
+
+    std::shared_ptr<SharedMemory> memory{new SharedMemory()};
+    size_t size = 0;
+
+#ifdef WIN32
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        error = LastError();
+        return nullptr;
+    }
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize)) {
+        error = LastError();
+        CloseHandle(file);
+        return nullptr;
+    }
+    size = static_cast<size_t>(fileSize.QuadPart);
+    if (size > 0) {
+        memory->m_handle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (memory->m_handle == nullptr) {
+            error = LastError();
+        }
+    }
+    // The mapping object keeps the file open
+    CloseHandle(file);
+    if (error) {
+        return nullptr;
+    }
+#else // POSIX
+    memory->m_handle = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (memory->m_handle == kInvalidHandle) {
+        error = LastError();
+        return nullptr;
+    }
+    struct stat st {};
+    if (fstat(memory->m_handle, &st) != 0) {
+        error = LastError();
+        return nullptr;
+    }
+    size = static_cast<size_t>(st.st_size);
+#endif
+
+    if (size == 0) {
+        error = std::make_error_code(std::errc::invalid_argument);
+        return nullptr;
+    }
+    if (!memory->MapView(size, error)) {
+        return nullptr;
+    }
+    return memory;
+}
+
+std::shared_ptr<SharedMemory> SharedMemory::Import(NativeHandle handle, size_t size, std::error_code &error) {
+    error.clear();
+    if (size == 0) {
+        error = std::make_error_code(std::errc::invalid_argument);
+        return nullptr;
+    }
+
+    std::shared_ptr<SharedMemory> memory{new SharedMemory()};
+#ifdef WIN32
+    if (!DuplicateHandle(GetCurrentProcess(), handle, GetCurrentProcess(), &memory->m_handle, 0, FALSE,
+                         DUPLICATE_SAME_ACCESS)) {
+        memory->m_handle = kInvalidHandle;
+        error = LastError();
+        return nullptr;
+    }
+#else // POSIX
+    memory->m_handle = fcntl(handle, F_DUPFD_CLOEXEC, 0);
+    if (memory->m_handle == kInvalidHandle) {
+        error = LastError();
+        return nullptr;
+    }
+#endif
+
+    if (!memory->MapView(size, error)) {
+        return nullptr;
+    }
+    return memory;
+}
+
+void SharedMemory::Prefault() const {
+    static constexpr size_t kPageSize = 4096;
+
+#if !defined(WIN32) && defined(MADV_WILLNEED)
+    madvise(const_cast<uint8 *>(m_data), m_size, MADV_WILLNEED);
+#endif
+    volatile uint8 sink = 0;
+    for (size_t offset = 0; offset < m_size; offset += kPageSize) {
+        sink = m_data[offset];
+    }
+    (void)sink;
+}
+
+// -----------------------------------------------------------------------------
+// SharedMemorySlot
+
+#ifdef WIN32
+
+    #ifndef MEM_RESERVE_PLACEHOLDER
+        #define MEM_RESERVE_PLACEHOLDER 0x00040000
+    #endif
+    #ifndef MEM_REPLACE_PLACEHOLDER
+        #define MEM_REPLACE_PLACEHOLDER 0x00004000
+    #endif
+    #ifndef MEM_PRESERVE_PLACEHOLDER
+        #define MEM_PRESERVE_PLACEHOLDER 0x00000002
+    #endif
+
+// Dynamically link to the placeholder functions available since Windows 10 version 1803. A placeholder keeps the
+// address range of a slot reserved while its view is being replaced, so no other allocation can claim it in between.
+static struct PlaceholderDynamicLink {
+    PlaceholderDynamicLink() {
+        HMODULE hKernelBase = LoadLibraryW(L"KernelBase.dll");
+        if (hKernelBase != nullptr) {
+            fnVirtualAlloc2 = (FnVirtualAlloc2)GetProcAddress(hKernelBase, "VirtualAlloc2");
+            fnMapViewOfFile3 = (FnMapViewOfFile3)GetProcAddress(hKernelBase, "MapViewOfFile3");
+            fnUnmapViewOfFile2 = (FnUnmapViewOfFile2)GetProcAddress(hKernelBase, "UnmapViewOfFile2");
+        }
+    }
+
+    bool IsAvailable() const {
+        return fnVirtualAlloc2 != nullptr && fnMapViewOfFile3 != nullptr && fnUnmapViewOfFile2 != nullptr;
+    }
+
+    // The extended parameters are never used, so they are declared as opaque pointers
+    using FnVirtualAlloc2 = PVOID(WINAPI *)(HANDLE Process, PVOID BaseAddress, SIZE_T Size, ULONG AllocationType,
+                                            ULONG PageProtection, void *ExtendedParameters, ULONG ParameterCount);
+    using FnMapViewOfFile3 = PVOID(WINAPI *)(HANDLE FileMapping, HANDLE Process, PVOID BaseAddress, ULONG64 Offset,
+                                             SIZE_T ViewSize, ULONG AllocationType, ULONG PageProtection,
+                                             void *ExtendedParameters, ULONG ParameterCount);
+    using FnUnmapViewOfFile2 = BOOL(WINAPI *)(HANDLE Process, PVOID BaseAddress, ULONG UnmapFlags);
+
+    FnVirtualAlloc2 fnVirtualAlloc2 = nullptr;
+    FnMapViewOfFile3 fnMapViewOfFile3 = nullptr;
+    FnUnmapViewOfFile2 fnUnmapViewOfFile2 = nullptr;
+} g_placeholderLink;
+
+#endif
+
+struct SharedMemorySlot::Internal {
+#ifdef WIN32
+    HANDLE hSection = nullptr; // Backs the private memory
+    bool placeholder = false;  // Views are mapped into a placeholder reservation
+
+    // Maps a view of the section at the given address, which must be free or hold an empty placeholder.
+    bool MapView(HANDLE hMapping, DWORD access, ULONG protect, uint8 *data, size_t size) const {
+        if (placeholder) {
+            return g_placeholderLink.fnMapViewOfFile3(hMapping, GetCurrentProcess(), data, 0, size,
+                                                      MEM_REPLACE_PLACEHOLDER, protect, nullptr, 0) == data;
+        }
+        return MapViewOfFileEx(hMapping, access, 0, 0, size, data) == data;
+    }
+
+    // Unmaps the view at the given address, leaving an empty placeholder in its place if one is used.
+    void UnmapView(uint8 *data) const {
+        if (placeholder) {
+            g_placeholderLink.fnUnmapViewOfFile2(GetCurrentProcess(), data, MEM_PRESERVE_PLACEHOLDER);
+        } else {
+            UnmapViewOfFile(data);
+        }
+    }
+#else // POSIX
+#endif
+};
+
+SharedMemorySlot::SharedMemorySlot(size_t size)
+    : m_size(size)
+    , m_internal(std::make_unique<Internal>()) {
+#ifdef WIN32
+    m_internal->hSection = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                              bit::extract<32, 63>(size), bit::extract<0, 31>(size), nullptr);
+    if (m_internal->hSection == nullptr) {
+        throw std::bad_alloc{};
+    }
+    if (g_placeholderLink.IsAvailable()) {
+        void *placeholder = g_placeholderLink.fnVirtualAlloc2(GetCurrentProcess(), nullptr, size,
+                                                              MEM_RESERVE | MEM_RESERVE_PLACEHOLDER, PAGE_NOACCESS,
+                                                              nullptr, 0);
+        if (placeholder != nullptr) {
+            m_internal->placeholder = true;
+            if (m_internal->MapView(m_internal->hSection, FILE_MAP_ALL_ACCESS, PAGE_READWRITE,
+                                    static_cast<uint8 *>(placeholder), size)) {
+                m_data = static_cast<uint8 *>(placeholder);
+            } else {
+                m_internal->placeholder = false;
+                VirtualFree(placeholder, 0, MEM_RELEASE);
+            }
+        }
+    }
+    if (m_data == nullptr) {
+        m_data = static_cast<uint8 *>(MapViewOfFile(m_internal->hSection, FILE_MAP_ALL_ACCESS, 0, 0, size));
+    }
+    if (m_data == nullptr) {
+        CloseHandle(m_internal->hSection);
+        throw std::bad_alloc{};
+    }
+#else // POSIX
+    void *mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+        throw std::bad_alloc{};
+    }
+    m_data = static_cast<uint8 *>(mem);
+#endif
+}
+
+SharedMemorySlot::~SharedMemorySlot() {
+#ifdef WIN32
+    if (!UnmapViewOfFile(m_data) && m_internal->placeholder) {
+        // A failed remap left an empty placeholder behind
+        VirtualFree(m_data, 0, MEM_RELEASE);
+    }
+    CloseHandle(m_internal->hSection);
+#else // POSIX
+    munmap(m_data, m_size);
+#endif
+}
+
+void SharedMemorySlot::MapPrivate() {
+    Remap(nullptr, false);
+    m_shared.reset();
+    m_readOnly = false;
+}
+
+bool SharedMemorySlot::MapShared(std::shared_ptr<const SharedMemory> memory, bool copyOnWrite) {
+    if (memory == nullptr) {
+        MapPrivate();
+        return false;
+    }
+    if (memory->Size() == m_size && Remap(memory.get(), copyOnWrite)) {
+        m_shared = std::move(memory);
+        m_readOnly = !copyOnWrite;
+        return true;
+    }
+
+    // Fall back to a private copy; this also restores the mapping if remapping failed midway
+    MapPrivate();
+    const auto data = memory->Data();
+    std::copy_n(data.begin(), std::min(data.size(), m_size), m_data);
+    return false;
+}
+
+void SharedMemorySlot::MakeWritable() {
+    if (!m_readOnly) {
+        return;
+    }
+    if (Remap(m_shared.get(), true)) {
+        m_readOnly = false;
+        return;
+    }
+    const auto memory = m_shared;
+    MapPrivate();
+    const auto data = memory->Data();
+    std::copy_n(data.begin(), std::min(data.size(), m_size), m_data);
+}
+
+bool SharedMemorySlot::Remap(const SharedMemory *memory, bool copyOnWrite) {
+#ifdef WIN32
+    // Views cannot be replaced in place; unmap the current view and map the new one at the same address
+    m_internal->UnmapView(m_data);
+    bool mapped = false;
+    if (memory == nullptr) {
+        mapped = m_internal->MapView(m_internal->hSection, FILE_MAP_ALL_ACCESS, PAGE_READWRITE, m_data, m_size);
+        if (mapped) {
+            std::fill_n(m_data, m_size, 0);
+        }
+    } else if (copyOnWrite) {
+        mapped = m_internal->MapView(memory->m_handle, FILE_MAP_COPY, PAGE_WRITECOPY, m_data, m_size);
+    } else {
+        mapped = m_internal->MapView(memory->m_handle, FILE_MAP_READ, PAGE_READONLY, m_data, m_size);
+    }
+    if (mapped) {
+        return true;
+    }
+
+    // Put the private memory back in place. The placeholder keeps the address range reserved, but without one another
+    // allocation may have claimed it after the old view was unmapped.
+    if (memory != nullptr &&
+        m_internal->MapView(m_internal->hSection, FILE_MAP_ALL_ACCESS, PAGE_READWRITE, m_data, m_size)) {
+        return false;
+    }
+#else // POSIX
+    void *view = nullptr;
+    if (memory == nullptr) {
+        view = mmap(m_data, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+    } else {
+        const int prot = copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+        const int flags = (copyOnWrite ? MAP_PRIVATE : MAP_SHARED) | MAP_FIXED;
+        view = mmap(m_data, m_size, prot, flags, memory->m_handle, 0);
+    }
+    if (view == m_data) {
+        return true;
+    }
+
+    // A failed fixed mapping may have already discarded the old one; put private memory back in place
+    if (memory != nullptr && mmap(m_data, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED,
+                                  -1, 0) == m_data) {
+        return false;
+    }
+#endif
+
+    // Nothing is mapped at the address of the slot anymore, and pointers into it would dangle
+    throw std::bad_alloc{};
+}
+
+} // namespace util
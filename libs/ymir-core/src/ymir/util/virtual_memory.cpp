@@ -13,13 +13,26 @@
 
     #include <sys/mman.h>
 
+    #ifdef __linux__
+        #include <linux/mempolicy.h>
+        #include <sys/syscall.h>
+        #include <unistd.h>
+    #endif
+
 #endif
 
 namespace util {
 
+static constexpr size_t AlignUp(size_t size, size_t alignment) {
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
 struct VirtualMemory::Internal {
+    size_t mapSize = 0; // May be larger than the requested size when aligned to huge pages
+    Backing backing = Backing::Regular;
 #ifdef WIN32
-    HANDLE hSection;
+    HANDLE hSection = nullptr;
+    bool virtualAlloc = false; // Allocated with VirtualAlloc instead of mapped from hSection
 #else // POSIX
 #endif
 };
@@ -27,13 +40,15 @@ struct VirtualMemory::Internal {
 VirtualMemory::VirtualMemory()
     : m_internal(std::make_unique<Internal>()) {}
 
-VirtualMemory::VirtualMemory(size_t size)
+VirtualMemory::VirtualMemory(size_t size, VirtualMemoryOptions options)
     : m_size(size)
     , m_internal(std::make_unique<Internal>()) {
-    Map(size);
+    Map(size, options);
 }
 
-VirtualMemory::VirtualMemory(VirtualMemory &&rhs) {
+VirtualMemory::VirtualMemory(VirtualMemory &&rhs)
+    : m_internal(std::make_unique<Internal>()) {
+    // Leaves rhs with a fresh Internal so that it can still be remapped
     operator=(std::move(rhs));
 }
 
@@ -41,9 +56,9 @@ VirtualMemory::~VirtualMemory() {
     Free();
 }
 
-void *VirtualMemory::Allocate(size_t size) {
+void *VirtualMemory::Allocate(size_t size, VirtualMemoryOptions options) {
     Free();
-    Map(size);
+    Map(size, options);
     return m_mem;
 }
 
@@ -54,27 +69,142 @@ void VirtualMemory::Free() {
     }
 }
 
-void VirtualMemory::Map(size_t size) {
+VirtualMemory::Backing VirtualMemory::GetBacking() const {
+    return m_mem != nullptr ? m_internal->backing : Backing::Regular;
+}
+
+void VirtualMemory::Map(size_t size, VirtualMemoryOptions options) {
+    m_internal->mapSize = size;
+    m_internal->backing = Backing::Regular;
+
 #ifdef WIN32
+    if (options.hugePages) {
+        // Requires the "Lock pages in memory" privilege; fall back to regular pages without it
+        const size_t largePageSize = GetLargePageMinimum();
+        if (largePageSize != 0) {
+            const size_t mapSize = AlignUp(size, largePageSize);
+            m_mem = VirtualAlloc(nullptr, mapSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (m_mem != nullptr) {
+                m_internal->mapSize = mapSize;
+                m_internal->backing = Backing::Huge;
+                m_internal->virtualAlloc = true;
+                m_size = size;
+                return;
+            }
+        }
+        m_mem = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        m_internal->virtualAlloc = m_mem != nullptr;
+        m_size = m_mem != nullptr ? size : 0;
+        return;
+    }
+
     m_internal->hSection = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, bit::extract<32, 63>(size),
                                               bit::extract<0, 31>(size), nullptr);
     m_mem = MapViewOfFile(m_internal->hSection, FILE_MAP_ALL_ACCESS, 0, 0, size);
 #else // POSIX
+    if (options.hugePages) {
+        const size_t mapSize = AlignUp(size, kHugePageSize);
+    #ifdef MAP_HUGETLB
+        // Fails right away if the system has no huge pages reserved
+        m_mem = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (m_mem != MAP_FAILED) {
+            m_internal->mapSize = mapSize;
+            m_internal->backing = Backing::Huge;
+            m_size = size;
+            return;
+        }
+    #endif
+
+        // Over-allocate to align the block to a huge page boundary, then trim the excess
+        void *reserved = mmap(nullptr, mapSize + kHugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                              -1, 0);
+        if (reserved == MAP_FAILED) {
+            m_mem = nullptr;
+            m_size = 0;
+            return;
+        }
+        auto *base = static_cast<uint8 *>(reserved);
+        auto *aligned = reinterpret_cast<uint8 *>(AlignUp(reinterpret_cast<uintptr_t>(base), kHugePageSize));
+        if (aligned > base) {
+            munmap(base, aligned - base);
+        }
+        if (const size_t tail = base + mapSize + kHugePageSize - (aligned + mapSize); tail > 0) {
+            munmap(aligned + mapSize, tail);
+        }
+        m_mem = aligned;
+        m_internal->mapSize = mapSize;
+    #ifdef MADV_HUGEPAGE
+        if (madvise(m_mem, mapSize, MADV_HUGEPAGE) == 0) {
+            m_internal->backing = Backing::TransparentHuge;
+        }
+    #endif
+        m_size = size;
+        return;
+    }
+
     m_mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_SHARED, -1, 0);
+    if (m_mem == MAP_FAILED) {
+        m_mem = nullptr;
+    }
 #endif
-    m_size = size;
+    m_size = m_mem != nullptr ? size : 0;
 }
 
 void VirtualMemory::Unmap() {
 #ifdef WIN32
-    UnmapViewOfFile(m_mem);
-    CloseHandle(m_internal->hSection);
-    m_internal->hSection = INVALID_HANDLE_VALUE;
+    if (m_internal->virtualAlloc) {
+        VirtualFree(m_mem, 0, MEM_RELEASE);
+        m_internal->virtualAlloc = false;
+    } else {
+        UnmapViewOfFile(m_mem);
+        CloseHandle(m_internal->hSection);
+        m_internal->hSection = INVALID_HANDLE_VALUE;
+    }
 #else // POSIX
-    munmap(m_mem, m_size);
+    munmap(m_mem, m_internal->mapSize);
 #endif
     m_mem = nullptr;
     m_size = 0;
+    m_internal->mapSize = 0;
+    m_internal->backing = Backing::Regular;
+}
+
+bool VirtualMemory::BindToNUMANode(uint32 node) {
+#ifdef __linux__
+    if (m_mem == nullptr) {
+        return false;
+    }
+    static constexpr size_t kMaskBits = sizeof(unsigned long) * 8;
+    if (node >= kMaskBits) {
+        return false;
+    }
+    const unsigned long nodeMask = 1ul << node;
+    return syscall(SYS_mbind, m_mem, m_internal->mapSize, MPOL_PREFERRED, &nodeMask, kMaskBits, MPOL_MF_MOVE) == 0;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+std::optional<uint32> GetCurrentNUMANode() {
+#ifdef WIN32
+    PROCESSOR_NUMBER processor{};
+    GetCurrentProcessorNumberEx(&processor);
+    USHORT node = 0;
+    if (!GetNumaProcessorNodeEx(&processor, &node)) {
+        return std::nullopt;
+    }
+    return node;
+#elif defined(__linux__)
+    unsigned int cpu = 0;
+    unsigned int node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+        return std::nullopt;
+    }
+    return node;
+#else
+    return std::nullopt;
+#endif
 }
 
 } // namespace util
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ymir::debug {
+
+// Transport negotiated through transport.upgrade. Once both sides switch, every message is a length-prefixed frame:
+// JSON-RPC messages travel in Json frames and bulk payloads (memory dumps, memory diffs) travel as raw bytes in Data
+// frames, so large transfers skip JSON encoding and the line length limit entirely.
+inline constexpr std::string_view kStdioBinaryFramesTransport = "stdio-binary-frames";
+
+// Capability advertised by instances that accept transport.upgrade to kStdioBinaryFramesTransport.
+inline constexpr std::string_view kBinaryFramesCapability = "binary-frames";
+
+enum class BinaryFrameType : uint8_t {
+    Json = 0, // UTF-8 JSON-RPC message
+    Data = 1, // Raw payload referenced by a JSON-RPC message through its channel
+};
+
+enum class BinaryFramerError {
+    InvalidHeader,
+    FrameTooLarge,
+};
+
+struct BinaryFrame {
+    BinaryFrameType type{BinaryFrameType::Json};
+    uint32_t channel{};
+    std::span<const uint8_t> payload;
+
+    std::string_view Text() const {
+        return {reinterpret_cast<const char *>(payload.data()), payload.size()};
+    }
+};
+
+// Frame header, all values little-endian:
+//   2 bytes  magic "YF"
+//   uint8    frame type
+//   uint8    reserved, must be zero
+//   uint32   channel
+//   uint32   payload length
+inline constexpr size_t kBinaryFrameHeaderSize = 12;
+inline constexpr std::array<uint8_t, 2> kBinaryFrameMagic = {'Y', 'F'};
+
+using BinaryFrameHeader = std::array<uint8_t, kBinaryFrameHeaderSize>;
+
+// Encodes a frame header. Writers can send the header and the payload with a single gathered write instead of copying
+// the payload into a staging buffer.
+inline BinaryFrameHeader EncodeBinaryFrameHeader(BinaryFrameType type, uint32_t channel, uint32_t length) {
+    BinaryFrameHeader header{};
+    header[0] = kBinaryFrameMagic[0];
+    header[1] = kBinaryFrameMagic[1];
+    header[2] = static_cast<uint8_t>(type);
+    header[3] = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        header[4 + i] = static_cast<uint8_t>(channel >> (i * 8));
+        header[8 + i] = static_cast<uint8_t>(length >> (i * 8));
+    }
+    return header;
+}
+
+inline void AppendBinaryFrame(std::vector<uint8_t> &out, BinaryFrameType type, uint32_t channel,
+                              std::span<const uint8_t> payload) {
+    const auto header = EncodeBinaryFrameHeader(type, channel, static_cast<uint32_t>(payload.size()));
+    out.insert(out.end(), header.begin(), header.end());
+    out.insert(out.end(), payload.begin(), payload.end());
+}
+
+inline void AppendBinaryFrame(std::vector<uint8_t> &out, std::string_view json) {
+    AppendBinaryFrame(out, BinaryFrameType::Json, 0,
+                      {reinterpret_cast<const uint8_t *>(json.data()), json.size()});
+}
+
+// Splits a byte stream into binary frames. Complete frames found in the pushed data are delivered straight from the
+// caller's buffer; only a frame split across pushes is staged in the internal buffer.
+//
+// Length-prefixed streams cannot resynchronize, so the framer reports the first malformed or oversized frame and then
+// discards all further input.
+class BinaryFramer {
+public:
+    static constexpr size_t kMaxFrameLength = 64 * 1024 * 1024; // 64 MiB
+
+    using FrameCallback = std::function<void(const BinaryFrame &)>;
+    using ErrorCallback = std::function<void(BinaryFramerError)>;
+
+    BinaryFramer(FrameCallback onFrame, ErrorCallback onError)
+        : m_onFrame(std::move(onFrame))
+        , m_onError(std::move(onError)) {}
+
+    void Push(const char *data, size_t length) {
+        Push(std::span<const uint8_t>{reinterpret_cast<const uint8_t *>(data), length});
+    }
+
+    void Push(std::span<const uint8_t> data) {
+        if (m_failed) {
+            return;
+        }
+
+        // Complete the partially buffered frame first
+        if (!m_buffer.empty()) {
+            const size_t consumed = Fill(data);
+            data = data.subspan(consumed);
+            if (m_failed || m_buffer.size() < kBinaryFrameHeaderSize || m_buffer.size() < m_frameSize) {
+                return;
+            }
+            Emit(m_buffer);
+            m_buffer.clear();
+            m_frameSize = 0;
+            if (m_failed) {
+                return;
+            }
+        }
+
+        // Deliver complete frames without copying
+        while (data.size() >= kBinaryFrameHeaderSize) {
+            const size_t frameSize = ParseFrameSize(data);
+            if (m_failed) {
+                return;
+            }
+            if (data.size() < frameSize) {
+                break;
+            }
+            Emit(data.first(frameSize));
+            data = data.subspan(frameSize);
+        }
+
+        // Stash the remainder
+        if (!data.empty()) {
+            m_buffer.assign(data.begin(), data.end());
+            m_frameSize = m_buffer.size() >= kBinaryFrameHeaderSize ? ParseFrameSize(m_buffer) : 0;
+        }
+    }
+
+    bool Failed() const {
+        return m_failed;
+    }
+
+private:
+    // Appends bytes to the staging buffer until it holds a full header, then a full frame.
+    size_t Fill(std::span<const uint8_t> data) {
+        size_t consumed = 0;
+        if (m_buffer.size() < kBinaryFrameHeaderSize) {
+            const size_t count = std::min(kBinaryFrameHeaderSize - m_buffer.size(), data.size());
+            m_buffer.insert(m_buffer.end(), data.begin(), data.begin() + count);
+            consumed += count;
+            if (m_buffer.size() < kBinaryFrameHeaderSize) {
+                return consumed;
+            }
+            m_frameSize = ParseFrameSize(m_buffer);
+            if (m_failed) {
+                return data.size();
+            }
+            m_buffer.reserve(m_frameSize);
+        }
+        const size_t count = std::min(m_frameSize - m_buffer.size(), data.size() - consumed);
+        m_buffer.insert(m_buffer.end(), data.begin() + consumed, data.begin() + consumed + count);
+        return consumed + count;
+    }
+
+    size_t ParseFrameSize(std::span<const uint8_t> header) {
+        if (header[0] != kBinaryFrameMagic[0] || header[1] != kBinaryFrameMagic[1] ||
+            header[2] > static_cast<uint8_t>(BinaryFrameType::Data) || header[3] != 0) {
+            Fail(BinaryFramerError::InvalidHeader);
+            return 0;
+        }
+        const uint32_t length = ReadU32(header.subspan(8));
+        if (length > kMaxFrameLength) {
+            Fail(BinaryFramerError::FrameTooLarge);
+            return 0;
+        }
+        return kBinaryFrameHeaderSize + length;
+    }
+
+    void Emit(std::span<const uint8_t> frame) {
+        BinaryFrame out;
+        out.type = static_cast<BinaryFrameType>(frame[2]);
+        out.channel = ReadU32(frame.subspan(4));
+        out.payload = frame.subspan(kBinaryFrameHeaderSize);
+        m_onFrame(out);
+    }
+
+    void Fail(BinaryFramerError error) {
+        m_failed = true;
+        m_buffer.clear();
+        m_buffer.shrink_to_fit();
+        m_onError(error);
+    }
+
+    static uint32_t ReadU32(std::span<const uint8_t> bytes) {
+        return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8u) |
+               (static_cast<uint32_t>(bytes[2]) << 16u) | (static_cast<uint32_t>(bytes[3]) << 24u);
+    }
+
+    std::vector<uint8_t> m_buffer;
+    size_t m_frameSize{};
+    bool m_failed{};
+    FrameCallback m_onFrame;
+    ErrorCallback m_onError;
+};
+
+} // namespace ymir::debug
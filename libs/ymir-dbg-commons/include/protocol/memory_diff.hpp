@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ymir::debug {
+
+// A run of changed bytes within a watched memory region.
+struct MemoryDiffRun {
+    uint32_t offset{}; // Offset from the start of the region
+    uint32_t size{};
+};
+
+// Finds the ranges that differ between two snapshots of the same memory region. Runs separated by no more than mergeGap
+// unchanged bytes are merged, since resending a few unchanged bytes is cheaper than describing another run.
+inline std::vector<MemoryDiffRun> DiffMemory(std::span<const uint8_t> before, std::span<const uint8_t> after,
+                                             size_t mergeGap = 16) {
+    std::vector<MemoryDiffRun> runs;
+    const size_t size = std::min(before.size(), after.size());
+
+    // Compare eight bytes at a time; memory usually changes in a few small spots between frames
+    auto load64 = [](const uint8_t *ptr) {
+        uint64_t value;
+        std::copy_n(ptr, sizeof(value), reinterpret_cast<uint8_t *>(&value));
+        return value;
+    };
+
+    size_t pos = 0;
+    while (pos < size) {
+        // Skip unchanged bytes
+        while (pos + 8 <= size && load64(&before[pos]) == load64(&after[pos])) {
+            pos += 8;
+        }
+        while (pos < size && before[pos] == after[pos]) {
+            ++pos;
+        }
+        if (pos >= size) {
+            break;
+        }
+
+        // Extend the run until a gap longer than mergeGap is found
+        const size_t start = pos;
+        size_t end = pos + 1;
+        size_t gap = 0;
+        for (pos = end; pos < size && gap <= mergeGap; ++pos) {
+            if (before[pos] != after[pos]) {
+                end = pos + 1;
+                gap = 0;
+            } else {
+                ++gap;
+            }
+        }
+        pos = end;
+
+        if (!runs.empty() && start - (runs.back().offset + runs.back().size) <= mergeGap) {
+            runs.back().size = static_cast<uint32_t>(end - runs.back().offset);
+        } else {
+            runs.push_back({static_cast<uint32_t>(start), static_cast<uint32_t>(end - start)});
+        }
+    }
+
+    // Bytes past the end of the shorter snapshot always count as changed
+    if (after.size() > size) {
+        if (!runs.empty() && size - (runs.back().offset + runs.back().size) <= mergeGap) {
+            runs.back().size = static_cast<uint32_t>(after.size() - runs.back().offset);
+        } else {
+            runs.push_back({static_cast<uint32_t>(size), static_cast<uint32_t>(after.size() - size)});
+        }
+    }
+    return runs;
+}
+
+} // namespace ymir::debug
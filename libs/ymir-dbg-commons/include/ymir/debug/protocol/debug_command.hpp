@@ -5,6 +5,7 @@
 #include <string>
 #include <string_view>
 #include <variant>
+#include <vector>
 
 #include "debug_types.hpp"
 
@@ -26,6 +27,10 @@ enum class CommandMethod {
     BreakpointClear,
     BreakpointEnable,
     BreakpointDisable,
+    TransportUpgrade,
+    MemDump,
+    EventsSubscribe,
+    EventsUnsubscribe,
 };
 constexpr std::string_view ToString(CommandMethod m) {
     switch (m) {
@@ -44,6 +49,10 @@ constexpr std::string_view ToString(CommandMethod m) {
     case CommandMethod::BreakpointClear: return "breakpoint.clear";
     case CommandMethod::BreakpointEnable: return "breakpoint.enable";
     case CommandMethod::BreakpointDisable: return "breakpoint.disable";
+    case CommandMethod::TransportUpgrade: return "transport.upgrade";
+    case CommandMethod::MemDump: return "mem.dump";
+    case CommandMethod::EventsSubscribe: return "events.subscribe";
+    case CommandMethod::EventsUnsubscribe: return "events.unsubscribe";
     }
     return "unknown";
 }
@@ -85,8 +94,36 @@ struct ExecStepIParams {
     DebugTarget target{DebugTarget::Sh2Master};
 };
 
-using DebugCommandParams = std::variant<std::monostate, RegsReadParams, MemPeekParams, DisasmAtParams,
-                                        BreakpointSetParams, BreakpointListParams, BreakpointIdParams, ExecStepIParams>;
+// Switches the connection to another transport. The response is still sent on the current transport; both sides use
+// the new one for everything that follows it.
+struct TransportUpgradeParams {
+    std::string transport;
+};
+
+// Reads several regions in one request. Requires the binary frames transport: the result describes the regions and the
+// raw bytes follow in a single Data frame, concatenated in request order.
+struct MemDumpParams {
+    DebugTarget target{DebugTarget::Sh2Master};
+    std::vector<MemRegion> regions;
+};
+
+// Streams events in batches of events.batch notifications. Memory diffs are computed over watch_regions at the end of
+// every frame.
+struct EventsSubscribeParams {
+    std::vector<EventKind> events;
+    DebugTarget target{DebugTarget::Sh2Master};
+    std::vector<MemRegion> watch_regions;
+    uint32_t batch_frames{1}; // Number of frames to accumulate per batch
+};
+
+struct SubscriptionIdParams {
+    std::string subscription_id;
+};
+
+using DebugCommandParams =
+    std::variant<std::monostate, RegsReadParams, MemPeekParams, DisasmAtParams, BreakpointSetParams,
+                 BreakpointListParams, BreakpointIdParams, ExecStepIParams, TransportUpgradeParams, MemDumpParams,
+                 EventsSubscribeParams, SubscriptionIdParams>;
 
 struct DebugCommand {
     DebugRequestId request_id;
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
@@ -34,10 +35,32 @@ struct InstanceReadyEvent {
     std::vector<TargetInfo> targets;
 };
 
-using DebugEventPayload = std::variant<DebugStoppedEvent, InstanceReadyEvent>;
+struct FrameTickEvent {
+    uint64_t frame{};
+};
+
+struct MemoryDiffEvent {
+    uint64_t frame{};
+    uint32_t address{};
+    uint32_t size{};
+    uint32_t data_offset{}; // Offset of the new bytes within the batch's Data frame
+};
+
+using DebugEventPayload = std::variant<DebugStoppedEvent, InstanceReadyEvent, FrameTickEvent, MemoryDiffEvent>;
 
 struct DebugEvent {
     DebugEventPayload payload;
 };
 
+inline constexpr std::string_view kEventBatchNotification = "events.batch";
+
+// Events collected for a subscription since the previous batch. Breakpoint hits are reported as DebugStoppedEvents.
+// When the batch holds memory diffs, a Data frame of data_size bytes on the subscription's event channel follows it.
+struct EventBatch {
+    std::string subscription_id;
+    uint32_t sequence{};
+    std::vector<DebugEvent> events;
+    uint32_t data_size{};
+};
+
 } // namespace ymir::debug
@@ -97,9 +97,27 @@ struct ExecStepIResult {
     std::optional<std::string> breakpoint_id;
 };
 
+struct TransportUpgradeResult {
+    std::string transport;
+    uint32_t max_frame_length{};
+};
+
+struct MemDumpResult {
+    DebugTarget target{DebugTarget::Sh2Master};
+    std::vector<MemRegion> regions;
+    uint32_t data_channel{}; // Channel of the Data frame carrying the region bytes
+    uint64_t total_size{};
+};
+
+struct EventsSubscribeResult {
+    std::string subscription_id;
+    uint32_t event_channel{}; // Channel of the Data frames carrying memory diff bytes
+};
+
 using DebugResultPayload =
     std::variant<std::monostate, DebugVersionResult, InstanceStatusResult, RegsReadResult, MemPeekResult,
-                 DisasmAtResult, BreakpointSetResult, BreakpointListResult, ExecStepIResult>;
+                 DisasmAtResult, BreakpointSetResult, BreakpointListResult, ExecStepIResult, TransportUpgradeResult,
+                 MemDumpResult, EventsSubscribeResult>;
 
 // Variant enforces success XOR error at the type level; a result cannot carry both.
 using DebugResult = std::variant<DebugResultPayload, ErrorInfo>;
@@ -101,6 +101,25 @@ constexpr std::string_view ToString(ErrorCode e) {
     return "unknown";
 }
 
+enum class EventKind {
+    BreakpointHit,
+    FrameTick,
+    MemoryDiff,
+};
+constexpr std::string_view ToString(EventKind k) {
+    switch (k) {
+    case EventKind::BreakpointHit: return "breakpoint_hit";
+    case EventKind::FrameTick: return "frame_tick";
+    case EventKind::MemoryDiff: return "memory_diff";
+    }
+    return "unknown";
+}
+
+struct MemRegion {
+    uint32_t address{0};
+    uint32_t size{0};
+};
+
 struct ErrorInfo {
     ErrorCode code{ErrorCode::InternalError};
     std::string message;
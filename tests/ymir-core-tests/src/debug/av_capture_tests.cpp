@@ -0,0 +1,181 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/debug/av_capture.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace av_capture_tests {
+
+using namespace ymir;
+using namespace ymir::debug;
+
+struct TempFile {
+    explicit TempFile(const char *extension)
+        : path(std::filesystem::temp_directory_path() /
+               ("ymir-capture-test-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) +
+                extension)) {}
+
+    ~TempFile() {
+        std::error_code error{};
+        std::filesystem::remove(path, error);
+    }
+
+    std::filesystem::path path;
+};
+
+static std::vector<uint8> ReadFile(const std::filesystem::path &path) {
+    std::ifstream in{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+static uint32 Read32(const std::vector<uint8> &data, size_t offset) {
+    uint32 value = 0;
+    std::memcpy(&value, &data[offset], sizeof(value));
+    return value;
+}
+
+static constexpr uint32 kWidth = 8;
+static constexpr uint32 kHeight = 4;
+static constexpr size_t kFrameSize = 6 + kWidth * kHeight * 3; // "FRAME\n" + Y, Cb and Cr planes
+static constexpr uint64 kSamplesPerFrame = 735;                 // 60 frames per second
+
+// Emulates a number of frames, rendering an image filled with the specified color and outputting one frame's worth of
+// samples on each frame.
+static void RunFrames(AVCapture &capture, uint64 &sampleTime, uint32 frames, uint32 color,
+                      uint64 samplesPerFrame = kSamplesPerFrame) {
+    const std::vector<uint32> fb(kWidth * kHeight, color);
+    const std::vector<scsp::OutputSample> samples(samplesPerFrame, scsp::OutputSample{1000, -1000});
+    for (uint32 i = 0; i < frames; ++i) {
+        capture.ReceiveFrame(fb.data(), kWidth, kHeight);
+        capture.ReceiveSamples(samples);
+        sampleTime += kSamplesPerFrame;
+        capture.MarkFrame(sampleTime);
+    }
+}
+
+TEST_CASE("AV capture writes Y4M video and WAV audio", "[capture]") {
+    TempFile video{".y4m"};
+    TempFile audio{".wav"};
+
+    AVCapture capture{};
+    std::error_code error{};
+    uint64 sampleTime = 12345; // not at the start of emulation
+    REQUIRE(capture.Start({.videoPath = video.path, .audioPath = audio.path, .frameRateNum = 60, .frameRateDen = 1},
+                          sampleTime, error));
+    RunFrames(capture, sampleTime, 10, 0xFF0000FF); // red
+    capture.Stop();
+
+    const auto stats = capture.GetStats();
+    CHECK(stats.framesReceived == 10);
+    CHECK(stats.framesWritten == 10);
+    CHECK(stats.framesDuplicated == 0);
+    CHECK(stats.framesDropped == 0);
+    CHECK(stats.samplesWritten == 10 * kSamplesPerFrame);
+    CHECK_FALSE(stats.writeError);
+
+    const auto y4m = ReadFile(video.path);
+    const std::string header = "YUV4MPEG2 W8 H4 F60:1 Ip A0:0 C444 XCOLORRANGE=FULL\n";
+    REQUIRE(y4m.size() == header.size() + 10 * kFrameSize);
+    CHECK(std::string(y4m.begin(), y4m.begin() + header.size()) == header);
+    CHECK(std::string(y4m.begin() + header.size(), y4m.begin() + header.size() + 6) == "FRAME\n");
+    const size_t planes = header.size() + 6;
+    CHECK(y4m[planes] == 76);                         // Y
+    CHECK(y4m[planes + kWidth * kHeight] == 85);      // Cb
+    CHECK(y4m[planes + kWidth * kHeight * 2] == 255); // Cr
+
+    const auto wav = ReadFile(audio.path);
+    REQUIRE(wav.size() == 44 + 10 * kSamplesPerFrame * 4);
+    CHECK(std::string(wav.begin(), wav.begin() + 4) == "RIFF");
+    CHECK(Read32(wav, 4) == wav.size() - 8);
+    CHECK(Read32(wav, 24) == 44100);
+    CHECK(Read32(wav, 40) == 10 * kSamplesPerFrame * 4);
+    sint16 left = 0;
+    std::memcpy(&left, &wav[44], sizeof(left));
+    CHECK(left == 1000);
+}
+
+TEST_CASE("AV capture converts to a constant frame rate", "[capture]") {
+    TempFile video{".y4m"};
+
+    AVCapture capture{};
+    std::error_code error{};
+    uint64 sampleTime = 0;
+
+    SECTION("Lower frame rate drops images") {
+        REQUIRE(capture.Start({.videoPath = video.path, .frameRateNum = 30, .frameRateDen = 1}, sampleTime, error));
+        RunFrames(capture, sampleTime, 10, 0);
+        capture.Stop();
+
+        const auto stats = capture.GetStats();
+        CHECK(stats.framesWritten == 5);
+        CHECK(stats.framesDropped == 5);
+        CHECK(stats.framesDuplicated == 0);
+    }
+
+    SECTION("Higher frame rate duplicates images") {
+        REQUIRE(capture.Start({.videoPath = video.path, .frameRateNum = 120, .frameRateDen = 1}, sampleTime, error));
+        RunFrames(capture, sampleTime, 10, 0);
+        capture.Stop();
+
+        const auto stats = capture.GetStats();
+        CHECK(stats.framesWritten == 20);
+        CHECK(stats.framesDropped == 0);
+        CHECK(stats.framesDuplicated == 10);
+    }
+
+    SECTION("Frames without a new image repeat the previous one") {
+        REQUIRE(capture.Start({.videoPath = video.path, .frameRateNum = 60, .frameRateDen = 1}, sampleTime, error));
+        // Nothing is rendered during the first two frames
+        sampleTime += kSamplesPerFrame;
+        capture.MarkFrame(sampleTime);
+        sampleTime += kSamplesPerFrame;
+        capture.MarkFrame(sampleTime);
+        RunFrames(capture, sampleTime, 2, 0);
+        sampleTime += kSamplesPerFrame;
+        capture.MarkFrame(sampleTime);
+        capture.Stop();
+
+        const auto stats = capture.GetStats();
+        CHECK(stats.framesReceived == 2);
+        CHECK(stats.framesWritten == 5);
+        CHECK(stats.framesDuplicated == 3);
+    }
+
+    CHECK_FALSE(capture.GetStats().writeError);
+}
+
+TEST_CASE("AV capture matches the audio length to emulated time", "[capture]") {
+    TempFile audio{".wav"};
+
+    AVCapture capture{};
+    std::error_code error{};
+    uint64 sampleTime = 0;
+
+    SECTION("Missing samples are padded with silence") {
+        REQUIRE(capture.Start({.audioPath = audio.path}, sampleTime, error));
+        RunFrames(capture, sampleTime, 4, 0, kSamplesPerFrame - 100);
+        capture.Stop();
+    }
+
+    SECTION("Excess samples are dropped") {
+        REQUIRE(capture.Start({.audioPath = audio.path}, sampleTime, error));
+        RunFrames(capture, sampleTime, 4, 0, kSamplesPerFrame + 100);
+        capture.Stop();
+    }
+
+    const auto stats = capture.GetStats();
+    CHECK(stats.samplesWritten == 4 * kSamplesPerFrame);
+    CHECK_FALSE(stats.writeError);
+
+    const auto wav = ReadFile(audio.path);
+    REQUIRE(wav.size() == 44 + 4 * kSamplesPerFrame * 4);
+    CHECK(Read32(wav, 40) == 4 * kSamplesPerFrame * 4);
+}
+
+} // namespace av_capture_tests
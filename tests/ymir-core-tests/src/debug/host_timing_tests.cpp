@@ -0,0 +1,81 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/debug/host_timing.hpp>
+
+namespace host_timing_tests {
+
+using namespace ymir;
+using namespace ymir::debug;
+
+using Catch::Approx;
+
+TEST_CASE("Host timing stats aggregate component times per frame", "[host_timing]") {
+    HostTimingStats stats{};
+
+    // Ticks recorded before the baseline frame are discarded
+    stats.Add(HostTimingComponent::SH2, 123456);
+    stats.EndFrame(1000, 0);
+    CHECK(stats.GetTotals().frames == 0);
+
+    // 2 ticks per microsecond; 10 ms frame
+    stats.Add(HostTimingComponent::SH2, 8000);
+    stats.Add(HostTimingComponent::SH2, 2000);
+    stats.Add(HostTimingComponent::VDP2, 4000);
+    stats.EndFrame(1000 + 20000, 10'000'000);
+
+    HostTimingReport last = stats.GetLastFrame();
+    CHECK(last.frames == 1);
+    CHECK(last.frameTimeMs == Approx(10.0));
+    CHECK(last.componentTimeMs[static_cast<size_t>(HostTimingComponent::SH2)] == Approx(5.0));
+    CHECK(last.componentTimeMs[static_cast<size_t>(HostTimingComponent::VDP2)] == Approx(2.0));
+    CHECK(last.componentTimeMs[static_cast<size_t>(HostTimingComponent::SCSP)] == 0.0);
+
+    // 20 ms frame
+    stats.Add(HostTimingComponent::SH2, 2000);
+    stats.Add(HostTimingComponent::SCSP, 6000);
+    stats.EndFrame(1000 + 60000, 30'000'000);
+
+    last = stats.GetLastFrame();
+    CHECK(last.frameTimeMs == Approx(20.0));
+    CHECK(last.componentTimeMs[static_cast<size_t>(HostTimingComponent::SH2)] == Approx(1.0));
+    CHECK(last.componentTimeMs[static_cast<size_t>(HostTimingComponent::VDP2)] == 0.0);
+    CHECK(last.componentTimeMs[static_cast<size_t>(HostTimingComponent::SCSP)] == Approx(3.0));
+
+    const HostTimingReport totals = stats.GetTotals();
+    CHECK(totals.frames == 2);
+    CHECK(totals.frameTimeMs == Approx(30.0));
+    CHECK(totals.maxFrameTimeMs == Approx(20.0));
+    CHECK(totals.componentTimeMs[static_cast<size_t>(HostTimingComponent::SH2)] == Approx(6.0));
+    CHECK(totals.maxComponentTimeMs[static_cast<size_t>(HostTimingComponent::SH2)] == Approx(5.0));
+    CHECK(totals.componentTimeMs[static_cast<size_t>(HostTimingComponent::VDP2)] == Approx(2.0));
+    CHECK(totals.componentTimeMs[static_cast<size_t>(HostTimingComponent::SCSP)] == Approx(3.0));
+
+    stats.ResetTotals();
+    CHECK(stats.GetTotals().frames == 0);
+    CHECK(stats.GetTotals().frameTimeMs == 0.0);
+}
+
+TEST_CASE("Scoped host timer charges the selected component", "[host_timing]") {
+    HostTimingStats stats{};
+    stats.EndFrame();
+    {
+        ScopedHostTimer timer{&stats, HostTimingComponent::CDBlock};
+        volatile uint32 sink = 0;
+        for (uint32 i = 0; i < 10000; ++i) {
+            sink = sink + i;
+        }
+    }
+    {
+        // Null stats must be accepted
+        ScopedHostTimer timer{nullptr, HostTimingComponent::SH2};
+    }
+    stats.EndFrame();
+
+    const HostTimingReport last = stats.GetLastFrame();
+    CHECK(last.frames == 1);
+    CHECK(last.componentTimeMs[static_cast<size_t>(HostTimingComponent::CDBlock)] > 0.0);
+    CHECK(last.componentTimeMs[static_cast<size_t>(HostTimingComponent::SH2)] == 0.0);
+}
+
+} // namespace host_timing_tests
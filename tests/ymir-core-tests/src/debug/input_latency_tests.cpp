@@ -0,0 +1,117 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/debug/input_latency.hpp>
+#include <ymir/hw/smpc/peripheral/peripheral_latch.hpp>
+
+#include <atomic>
+#include <thread>
+
+namespace input_latency_tests {
+
+using namespace ymir;
+using namespace ymir::debug;
+using namespace ymir::peripheral;
+
+PeripheralReport MakeAnalogReport(uint8 value) {
+    PeripheralReport report{.type = PeripheralType::AnalogPad};
+    report.report.analogPad = {
+        .buttons = Button::Default, .analog = true, .x = value, .y = value, .l = value, .r = value};
+    return report;
+}
+
+TEST_CASE("Peripheral latch hands over the latest published report", "[input_latency][peripheral]") {
+    PeripheralLatch latch{};
+    PeripheralReport report{};
+    uint64 timestamp = 0;
+
+    CHECK_FALSE(latch.Latch(report, timestamp));
+
+    latch.Publish(MakeAnalogReport(1), 100);
+    latch.Publish(MakeAnalogReport(2), 200);
+    REQUIRE(latch.Latch(report, timestamp));
+    CHECK(report.type == PeripheralType::AnalogPad);
+    CHECK(report.report.analogPad.x == 2);
+    CHECK(timestamp == 200);
+
+    // Latching again without new reports repeats the last one
+    REQUIRE(latch.Latch(report, timestamp));
+    CHECK(report.report.analogPad.x == 2);
+    CHECK(timestamp == 200);
+
+    latch.Publish(MakeAnalogReport(3), 300);
+    REQUIRE(latch.Latch(report, timestamp));
+    CHECK(report.report.analogPad.x == 3);
+    CHECK(timestamp == 300);
+}
+
+TEST_CASE("Peripheral latch never exposes torn or stale reports", "[input_latency][peripheral]") {
+    static constexpr uint64 kReports = 200000;
+
+    PeripheralLatch latch{};
+    std::atomic_bool done = false;
+
+    std::thread producer{[&] {
+        for (uint64 i = 1; i <= kReports; ++i) {
+            latch.Publish(MakeAnalogReport(static_cast<uint8>(i)), i);
+        }
+        done = true;
+    }};
+
+    uint64 lastTimestamp = 0;
+    bool consistent = true;
+    bool monotonic = true;
+    while (!done.load() || lastTimestamp != kReports) {
+        PeripheralReport report{};
+        uint64 timestamp = 0;
+        if (!latch.Latch(report, timestamp)) {
+            continue;
+        }
+        const auto &pad = report.report.analogPad;
+        const uint8 expected = static_cast<uint8>(timestamp);
+        consistent &= pad.x == expected && pad.y == expected && pad.l == expected && pad.r == expected;
+        monotonic &= timestamp >= lastTimestamp;
+        lastTimestamp = timestamp;
+    }
+    producer.join();
+
+    CHECK(consistent);
+    CHECK(monotonic);
+    CHECK(lastTimestamp == kReports);
+}
+
+TEST_CASE("Input latency histogram buckets samples by power of two microseconds", "[input_latency]") {
+    InputLatencyHistogram histogram{};
+    CHECK(histogram.GetReport().count == 0);
+    CHECK(histogram.GetReport().PercentileNs(0.5) == 0);
+
+    histogram.Record(500);        // < 1 µs
+    histogram.Record(1'500);      // [1, 2) µs
+    histogram.Record(3'000);      // [2, 4) µs
+    histogram.Record(3'900);      // [2, 4) µs
+    histogram.Record(10'000'000); // [8192, 16384) µs
+
+    InputLatencyReport report = histogram.GetReport();
+    CHECK(report.count == 5);
+    CHECK(report.minNs == 500);
+    CHECK(report.maxNs == 10'000'000);
+    CHECK(report.totalNs == 10'008'900);
+    CHECK(report.buckets[0] == 1);
+    CHECK(report.buckets[1] == 1);
+    CHECK(report.buckets[2] == 2);
+    CHECK(report.buckets[14] == 1);
+
+    CHECK(GetInputLatencyBucketUpperBoundNs(0) == 1'000);
+    CHECK(GetInputLatencyBucketUpperBoundNs(2) == 4'000);
+    CHECK(report.PercentileNs(0.2) == 1'000);
+    CHECK(report.PercentileNs(0.5) == 4'000);
+    CHECK(report.PercentileNs(0.8) == 4'000);
+    CHECK(report.PercentileNs(1.0) == 10'000'000); // clamped to the maximum
+
+    histogram.Reset();
+    report = histogram.GetReport();
+    CHECK(report.count == 0);
+    CHECK(report.minNs == 0);
+    CHECK(report.maxNs == 0);
+}
+
+} // namespace input_latency_tests
@@ -0,0 +1,144 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/debug/input_movie.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace input_movie_tests {
+
+using namespace ymir;
+using namespace ymir::debug;
+
+struct TempFile {
+    TempFile()
+        : path(std::filesystem::temp_directory_path() /
+               ("ymir-movie-test-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) +
+                ".ymov")) {}
+
+    ~TempFile() {
+        std::error_code error{};
+        std::filesystem::remove(path, error);
+    }
+
+    std::filesystem::path path;
+};
+
+static InputMovie MakeMovie() {
+    InputMovie movie{};
+    movie.settings.videoStandard = core::config::sys::VideoStandard::PAL;
+    movie.settings.areaCode = 0xC;
+    movie.settings.emulateSH2Cache = true;
+    movie.settings.cdReadSpeedFactor = 4;
+    movie.settings.sh2ClockFactorNum = 3;
+    movie.settings.sh2ClockFactorDen = 2;
+    movie.settings.rtcTimestamp = 757382400;
+    movie.settings.ports = {peripheral::PeripheralType::ControlPad, peripheral::PeripheralType::AnalogPad};
+    movie.gamePath = "games/test.cue";
+
+    for (uint32 i = 0; i < 100; ++i) {
+        InputMovie::Frame frame{};
+        frame.reads = {static_cast<uint16>(i % 3), static_cast<uint16>(i % 2)};
+        frame.hash = MakeXXH128Hash(i, ~i);
+        movie.frames.push_back(frame);
+
+        for (uint16 read = 0; read < frame.reads[0]; ++read) {
+            peripheral::PeripheralReport report{.type = peripheral::PeripheralType::ControlPad};
+            report.report.controlPad.buttons = static_cast<peripheral::Button>(i * 7 + read);
+            movie.reports.push_back(report);
+        }
+        for (uint16 read = 0; read < frame.reads[1]; ++read) {
+            peripheral::PeripheralReport report{.type = peripheral::PeripheralType::AnalogPad};
+            report.report.analogPad = {.buttons = peripheral::Button::Default, .analog = true, .x = static_cast<uint8>(i)};
+            movie.reports.push_back(report);
+        }
+    }
+    return movie;
+}
+
+TEST_CASE("Input movies round-trip through files", "[movie]") {
+    TempFile file{};
+    InputMovie movie = MakeMovie();
+
+    SECTION("From power on") {}
+    SECTION("From a save state") {
+        movie.startState.assign(12345, 0x5A);
+    }
+
+    std::error_code error{};
+    REQUIRE(WriteInputMovie(file.path, movie, error));
+
+    InputMovie loaded{};
+    REQUIRE(ReadInputMovie(file.path, loaded, error) == InputMovieReadResult::Success);
+    CHECK(loaded.settings.videoStandard == movie.settings.videoStandard);
+    CHECK(loaded.settings.areaCode == movie.settings.areaCode);
+    CHECK(loaded.settings.emulateSH2Cache == movie.settings.emulateSH2Cache);
+    CHECK(loaded.settings.cdReadSpeedFactor == movie.settings.cdReadSpeedFactor);
+    CHECK(loaded.settings.sh2ClockFactorNum == movie.settings.sh2ClockFactorNum);
+    CHECK(loaded.settings.sh2ClockFactorDen == movie.settings.sh2ClockFactorDen);
+    CHECK(loaded.settings.rtcTimestamp == movie.settings.rtcTimestamp);
+    CHECK(loaded.settings.ports == movie.settings.ports);
+    CHECK(loaded.gamePath == movie.gamePath);
+    CHECK(loaded.startState == movie.startState);
+
+    REQUIRE(loaded.frames.size() == movie.frames.size());
+    for (size_t i = 0; i < movie.frames.size(); ++i) {
+        CAPTURE(i);
+        CHECK(loaded.frames[i].reads == movie.frames[i].reads);
+        CHECK(loaded.frames[i].hash == movie.frames[i].hash);
+    }
+
+    REQUIRE(loaded.reports.size() == movie.reports.size());
+    for (size_t i = 0; i < movie.reports.size(); ++i) {
+        CAPTURE(i);
+        REQUIRE(loaded.reports[i].type == movie.reports[i].type);
+        if (movie.reports[i].type == peripheral::PeripheralType::ControlPad) {
+            CHECK(loaded.reports[i].report.controlPad.buttons == movie.reports[i].report.controlPad.buttons);
+        } else {
+            CHECK(loaded.reports[i].report.analogPad.x == movie.reports[i].report.analogPad.x);
+        }
+    }
+}
+
+TEST_CASE("Input movie reader rejects invalid files", "[movie]") {
+    TempFile file{};
+    std::error_code error{};
+    REQUIRE(WriteInputMovie(file.path, MakeMovie(), error));
+    const auto size = std::filesystem::file_size(file.path);
+
+    InputMovie loaded{};
+    loaded.gamePath = "untouched";
+
+    SECTION("Missing file") {
+        CHECK(ReadInputMovie(file.path.string() + ".missing", loaded, error) == InputMovieReadResult::FilesystemError);
+        CHECK(error);
+    }
+
+    SECTION("Truncated file") {
+        std::filesystem::resize_file(file.path, size - 1);
+        CHECK(ReadInputMovie(file.path, loaded, error) == InputMovieReadResult::Truncated);
+    }
+
+    SECTION("Wrong magic") {
+        std::fstream stream{file.path, std::ios::binary | std::ios::in | std::ios::out};
+        stream.write("YMSS", 4);
+        stream.close();
+        CHECK(ReadInputMovie(file.path, loaded, error) == InputMovieReadResult::InvalidFormat);
+    }
+
+    SECTION("Different version") {
+        std::fstream stream{file.path, std::ios::binary | std::ios::in | std::ios::out};
+        stream.seekp(4);
+        const uint32 version = 0xFFFF;
+        stream.write(reinterpret_cast<const char *>(&version), sizeof(version));
+        stream.close();
+        CHECK(ReadInputMovie(file.path, loaded, error) == InputMovieReadResult::VersionMismatch);
+    }
+
+    CHECK(loaded.gamePath == "untouched");
+}
+
+} // namespace input_movie_tests
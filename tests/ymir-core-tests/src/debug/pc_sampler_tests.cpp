@@ -0,0 +1,155 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/debug/pc_sampler.hpp>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace pc_sampler_tests {
+
+using namespace ymir;
+using namespace ymir::debug;
+
+TEST_CASE("Symbol map parses plain and nm-style symbol lists", "[pc_sampler]") {
+    std::istringstream in{"# comment\n"
+                          "06004000 main\n"
+                          "0x06004100 T update_sprites\n"
+                          "\n"
+                          "; another comment\n"
+                          "06004200 t  idle_loop\r\n"
+                          "nonsense line\n"
+                          "06004300\n"};
+
+    SymbolMap symbols{};
+    CHECK(symbols.Parse(in) == 3);
+
+    CHECK(symbols.Find(0x06003FFE) == nullptr);
+    REQUIRE(symbols.Find(0x06004000) != nullptr);
+    CHECK(symbols.Find(0x06004000)->name == "main");
+    CHECK(symbols.Find(0x060040FE)->name == "main");
+    CHECK(symbols.Find(0x06004100)->name == "update_sprites");
+    CHECK(symbols.Find(0x06004200)->name == "idle_loop");
+    CHECK(symbols.Find(0x06FFFFFE)->name == "idle_loop");
+}
+
+TEST_CASE("PC sampler aggregates samples by address and function", "[pc_sampler]") {
+    PCSampler sampler{};
+
+    PCSnapshot snapshot{};
+    snapshot.Set(ProfiledCPU::MasterSH2, 0x26004002); // cache-through mirror
+    snapshot.Set(ProfiledCPU::M68K, 0x1000);
+    sampler.Record(snapshot, 3);
+
+    snapshot = {};
+    snapshot.Set(ProfiledCPU::MasterSH2, 0x06004002);
+    sampler.Record(snapshot);
+
+    snapshot = {};
+    snapshot.Set(ProfiledCPU::MasterSH2, 0x06004106);
+    sampler.Record(snapshot, 2);
+
+    snapshot = {};
+    snapshot.Set(ProfiledCPU::MasterSH2, 0x00000100);
+    sampler.Record(snapshot);
+    sampler.Flush();
+
+    CHECK(sampler.GetTotalSamples(ProfiledCPU::MasterSH2) == 7);
+    CHECK(sampler.GetTotalSamples(ProfiledCPU::SlaveSH2) == 0);
+    CHECK(sampler.GetTotalSamples(ProfiledCPU::M68K) == 3);
+
+    SECTION("By address") {
+        const auto hotSpots = sampler.GetHotSpots(ProfiledCPU::MasterSH2, false);
+        REQUIRE(hotSpots.size() == 3);
+        CHECK(hotSpots[0].address == 0x06004002);
+        CHECK(hotSpots[0].samples == 4);
+        CHECK(hotSpots[1].address == 0x06004106);
+        CHECK(hotSpots[1].samples == 2);
+        CHECK(hotSpots[2].address == 0x00000100);
+        CHECK(hotSpots[2].samples == 1);
+
+        CHECK(sampler.GetHotSpots(ProfiledCPU::MasterSH2, false, 1).size() == 1);
+    }
+
+    SECTION("By function") {
+        auto symbols = std::make_shared<SymbolMap>();
+        symbols->Add(0x06004000, "main");
+        symbols->Add(0x06004100, "vblank");
+        sampler.SetSymbolMap(ProfiledCPU::MasterSH2, symbols);
+
+        const auto hotSpots = sampler.GetHotSpots(ProfiledCPU::MasterSH2, true);
+        REQUIRE(hotSpots.size() == 3);
+        CHECK(hotSpots[0].name == "main");
+        CHECK(hotSpots[0].samples == 4);
+        CHECK(hotSpots[1].name == "vblank");
+        CHECK(hotSpots[1].samples == 2);
+        CHECK(hotSpots[2].name.empty());
+        CHECK(hotSpots[2].address == 0x00000100);
+
+        std::ostringstream out{};
+        sampler.WriteCollapsedStacks(out);
+        CHECK(out.str() == "MSH2;00000100 1\n"
+                           "MSH2;main 4\n"
+                           "MSH2;vblank 2\n"
+                           "M68K;00001000 3\n");
+    }
+
+    SECTION("Clear") {
+        sampler.Clear();
+        CHECK(sampler.GetTotalSamples(ProfiledCPU::MasterSH2) == 0);
+        CHECK(sampler.GetHotSpots(ProfiledCPU::MasterSH2, false).empty());
+    }
+}
+
+TEST_CASE("PC sampler aggregates recorded blocks on the reader side", "[pc_sampler]") {
+    PCSampler sampler{};
+
+    PCSnapshot snapshot{};
+    snapshot.Set(ProfiledCPU::SlaveSH2, 0x06010000);
+
+    SECTION("Partial blocks become visible when flushed") {
+        for (size_t i = 0; i < PCSampler::kBlockSize * 2 + 5; ++i) {
+            sampler.Record(snapshot);
+        }
+        CHECK(sampler.GetTotalSamples(ProfiledCPU::SlaveSH2) == PCSampler::kBlockSize * 2);
+
+        sampler.Flush();
+        CHECK(sampler.GetTotalSamples(ProfiledCPU::SlaveSH2) == PCSampler::kBlockSize * 2 + 5);
+        sampler.Flush();
+        CHECK(sampler.GetTotalSamples(ProfiledCPU::SlaveSH2) == PCSampler::kBlockSize * 2 + 5);
+    }
+
+    SECTION("Clear discards pending blocks") {
+        for (size_t i = 0; i < PCSampler::kBlockSize; ++i) {
+            sampler.Record(snapshot);
+        }
+        sampler.Clear();
+        sampler.Aggregate();
+        CHECK(sampler.GetTotalSamples(ProfiledCPU::SlaveSH2) == 0);
+
+        sampler.Record(snapshot, 2);
+        sampler.Flush();
+        CHECK(sampler.GetTotalSamples(ProfiledCPU::SlaveSH2) == 2);
+    }
+
+    SECTION("Reading while recording") {
+        static constexpr size_t kSamples = PCSampler::kBlockSize * (PCSampler::kMaxPendingBlocks * 2) + 17;
+        std::thread recorder{[&] {
+            for (size_t i = 0; i < kSamples; ++i) {
+                sampler.Record(snapshot);
+            }
+            sampler.Flush();
+        }};
+        uint64 lastTotal = 0;
+        for (int i = 0; i < 100; ++i) {
+            const uint64 total = sampler.GetTotalSamples(ProfiledCPU::SlaveSH2);
+            CHECK(total >= lastTotal);
+            lastTotal = total;
+        }
+        recorder.join();
+        CHECK(sampler.GetTotalSamples(ProfiledCPU::SlaveSH2) == kSamples);
+    }
+}
+
+} // namespace pc_sampler_tests
@@ -0,0 +1,217 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/debug/trace_reader.hpp>
+#include <ymir/debug/trace_recorder.hpp>
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace trace_tests {
+
+using namespace ymir;
+using namespace ymir::debug::trace;
+
+struct TempFile {
+    TempFile()
+        : path(std::filesystem::temp_directory_path() /
+               ("ymir-trace-test-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) +
+                ".ytrace")) {}
+
+    ~TempFile() {
+        std::error_code error{};
+        std::filesystem::remove(path, error);
+    }
+
+    std::filesystem::path path;
+};
+
+TEST_CASE("Trace recorder round-trips records through the reader", "[trace]") {
+    TempFile file{};
+
+    // Enough instructions to span multiple chunks
+    constexpr uint32 kNumInstructions = kMaxChunkSize / (1 + sizeof(record::SH2Instruction)) * 3 + 17;
+
+    TraceRecorder recorder{};
+    std::error_code error{};
+    REQUIRE(recorder.Start(file.path, error));
+    REQUIRE(recorder.IsRecording());
+
+    auto &msh2 = recorder.GetMasterSH2Tracer();
+    auto &ssh2 = recorder.GetSlaveSH2Tracer();
+    auto &scu = recorder.GetSCUTracer();
+    auto &cdb = recorder.GetCDBlockTracer();
+
+    recorder.MarkFrame(0);
+    for (uint32 i = 0; i < kNumInstructions; ++i) {
+        msh2.ExecuteInstruction(0x06004000 + i * 2, static_cast<uint16>(i), (i & 7) == 7);
+    }
+    msh2.Interrupt(0x47, 7, sh2::InterruptSource::IRL, 0x06001234);
+    ssh2.Call(0x06010000);
+    ssh2.Return(0x06002000);
+    ssh2.DMAXferBegin(1, 0x25C00000, 0x06020000, 0x100, 4, 4, 4);
+    ssh2.DMAXferEnd(1, true);
+    scu.RaiseInterrupt(0, 0xF);
+    scu.DMA(2, 0x06030000, 0x25E00000, 0x800, 4, 2, false, 0);
+    cdb.ProcessCommand(0x0100, 0x0000, 0x0000, 0x0000);
+    cdb.ProcessCommandResponse(0x2000, 0x0001, 0x0203, 0x0405);
+    recorder.MarkFrame(1);
+
+    recorder.Stop();
+    CHECK_FALSE(recorder.IsRecording());
+
+    const auto stats = recorder.GetStats();
+    CHECK_FALSE(stats.writeError);
+    CHECK(stats.records == kNumInstructions + 11);
+    CHECK(stats.chunks >= 4);
+    CHECK(stats.rawBytes >= kNumInstructions * (1 + sizeof(record::SH2Instruction)));
+    CHECK(stats.compressedBytes > 0);
+
+    TraceReader reader{};
+    REQUIRE(reader.Open(file.path, error) == ReadResult::Success);
+
+    std::array<uint64, kNumSources> recordsPerSource{};
+    uint32 nextInstruction = 0;
+    bool instructionsInOrder = true;
+    std::vector<uint64> frames{};
+    std::vector<std::string> cdbLines{};
+    const ReadResult result = reader.ReadAll(
+        [&](const RecordView &rec) {
+            ++recordsPerSource[static_cast<size_t>(rec.source)];
+            switch (rec.type) {
+            case RecordType::SH2Instruction: [[fallthrough]];
+            case RecordType::SH2DelaySlotInstruction: {
+                const auto instr = rec.As<record::SH2Instruction>();
+                const bool delaySlot = rec.type == RecordType::SH2DelaySlotInstruction;
+                if (instr.pc != 0x06004000 + nextInstruction * 2 || instr.opcode != (uint16)nextInstruction ||
+                    delaySlot != ((nextInstruction & 7) == 7)) {
+                    instructionsInOrder = false;
+                }
+                ++nextInstruction;
+                break;
+            }
+            case RecordType::FrameMarker: frames.push_back(rec.As<record::FrameMarker>().frame); break;
+            case RecordType::CDBlockCommand: [[fallthrough]];
+            case RecordType::CDBlockResponse: cdbLines.push_back(FormatRecord(rec)); break;
+            default: break;
+            }
+        },
+        error);
+    REQUIRE(result == ReadResult::Success);
+
+    CHECK(instructionsInOrder);
+    CHECK(nextInstruction == kNumInstructions);
+    CHECK(recordsPerSource[static_cast<size_t>(Source::System)] == 2);
+    CHECK(recordsPerSource[static_cast<size_t>(Source::MasterSH2)] == kNumInstructions + 1);
+    CHECK(recordsPerSource[static_cast<size_t>(Source::SlaveSH2)] == 4);
+    CHECK(recordsPerSource[static_cast<size_t>(Source::SCU)] == 2);
+    CHECK(recordsPerSource[static_cast<size_t>(Source::CDBlock)] == 2);
+    CHECK(frames == std::vector<uint64>{0, 1});
+    REQUIRE(cdbLines.size() == 2);
+    CHECK(cdbLines[0] == "CDBlock command  0100 0000 0000 0000");
+    CHECK(cdbLines[1] == "CDBlock response 2000 0001 0203 0405");
+}
+
+TEST_CASE("Trace recorder stamps records with the bound cycle counter", "[trace]") {
+    TempFile file{};
+
+    // Enough instructions to span two chunks
+    constexpr uint32 kNumInstructions = kMaxChunkSize / (1 + sizeof(record::SH2Instruction)) + 17;
+
+    uint64 sliceBase = 1000;
+    uint64 sliceCycles = 0;
+
+    TraceRecorder recorder{};
+    recorder.BindCycleCounter(Source::System, &sliceBase);
+    recorder.BindCycleCounter(Source::MasterSH2, &sliceBase, &sliceCycles);
+    std::error_code error{};
+    REQUIRE(recorder.Start(file.path, error));
+
+    auto &msh2 = recorder.GetMasterSH2Tracer();
+    recorder.MarkFrame(0);
+    for (uint32 i = 0; i < kNumInstructions; ++i) {
+        // Two instructions per cycle count
+        sliceCycles = i / 2;
+        msh2.ExecuteInstruction(0x06004000 + i * 2, static_cast<uint16>(i), false);
+    }
+    sliceBase += 5000;
+    recorder.MarkFrame(1);
+    recorder.Stop();
+
+    TraceReader reader{};
+    REQUIRE(reader.Open(file.path, error) == ReadResult::Success);
+
+    std::array<uint64, kNumSources> currCycle{};
+    std::array<bool, kNumSources> stamped{};
+    std::array<uint64, kNumSources> recordsPerSource{};
+    std::vector<uint64> frameCycles{};
+    uint32 stampCount = 0;
+    bool allStamped = true;
+    bool instructionCyclesMatch = true;
+    const ReadResult result = reader.ReadAll(
+        [&](const RecordView &rec) {
+            const size_t src = static_cast<size_t>(rec.source);
+            if (rec.type == RecordType::CycleStamp) {
+                currCycle[src] = rec.As<record::CycleStamp>().cycle;
+                stamped[src] = true;
+                ++stampCount;
+                return;
+            }
+            allStamped &= stamped[src];
+            switch (rec.type) {
+            case RecordType::SH2Instruction: {
+                const uint32 index = rec.As<record::SH2Instruction>().opcode;
+                instructionCyclesMatch &= currCycle[src] == 1000 + (index & ~1u) / 2;
+                break;
+            }
+            case RecordType::FrameMarker: frameCycles.push_back(currCycle[src]); break;
+            default: break;
+            }
+            ++recordsPerSource[src];
+        },
+        error);
+    REQUIRE(result == ReadResult::Success);
+
+    CHECK(allStamped);
+    CHECK(instructionCyclesMatch);
+    CHECK(frameCycles == std::vector<uint64>{1000, 6000});
+    // One stamp per distinct cycle count and per frame marker, plus one if the second chunk starts mid-cycle
+    const uint32 minStamps = (kNumInstructions + 1) / 2 + 2;
+    CHECK(stampCount >= minStamps);
+    CHECK(stampCount <= minStamps + 1);
+    CHECK(recordsPerSource[static_cast<size_t>(Source::MasterSH2)] == kNumInstructions);
+}
+
+TEST_CASE("Trace reader rejects invalid and truncated files", "[trace]") {
+    TempFile file{};
+    std::error_code error{};
+    TraceReader reader{};
+
+    SECTION("Missing file") {
+        CHECK(reader.Open(file.path, error) == ReadResult::FilesystemError);
+    }
+
+    SECTION("Not a trace file") {
+        std::ofstream{file.path, std::ios::binary} << "definitely not a trace file";
+        CHECK(reader.Open(file.path, error) == ReadResult::InvalidFormat);
+    }
+
+    SECTION("Truncated chunk") {
+        {
+            TraceRecorder recorder{};
+            REQUIRE(recorder.Start(file.path, error));
+            recorder.MarkFrame(123);
+            recorder.Stop();
+        }
+        const auto size = std::filesystem::file_size(file.path);
+        std::filesystem::resize_file(file.path, size - 1);
+
+        REQUIRE(reader.Open(file.path, error) == ReadResult::Success);
+        CHECK(reader.NextChunk(error) == ReadResult::Truncated);
+    }
+}
+
+} // namespace trace_tests
@@ -0,0 +1,279 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/hw/cdblock/cdblock_partition_manager.hpp>
+
+#include <memory>
+#include <vector>
+
+using namespace ymir;
+using namespace ymir::cdblock;
+
+namespace cdblock_partition_manager {
+
+// Inserts a sector tagged with the given frame address into a partition
+static void InsertSector(PartitionManager &partMgr, uint8 partitionIndex, uint32 frameAddress) {
+    const uint8 bufferIndex = partMgr.AllocateBuffer();
+    REQUIRE(bufferIndex != PartitionManager::kNoBuffer);
+    Buffer &buffer = partMgr.GetBuffer(bufferIndex);
+    buffer.size = 2048;
+    buffer.frameAddress = frameAddress;
+    partMgr.InsertHead(partitionIndex, bufferIndex);
+}
+
+// Lists the frame addresses of all sectors in a partition from the oldest to the newest
+static std::vector<uint32> FrameAddresses(PartitionManager &partMgr, uint8 partitionIndex) {
+    std::vector<uint32> frameAddresses{};
+    for (uint32 i = 0; i < partMgr.GetBufferCount(partitionIndex); i++) {
+        const Buffer *buffer = partMgr.GetTail(partitionIndex, i);
+        REQUIRE(buffer != nullptr);
+        frameAddresses.push_back(buffer->frameAddress);
+    }
+    return frameAddresses;
+}
+
+TEST_CASE("Partition manager keeps sectors in insertion order", "[cdblock][partition_manager]") {
+    auto partMgr = std::make_unique<PartitionManager>();
+
+    for (uint32 i = 0; i < 5; i++) {
+        InsertSector(*partMgr, 3, 100 + i);
+        InsertSector(*partMgr, 7, 200 + i);
+    }
+    CHECK(partMgr->GetFreeBufferCount() == kNumBuffers - 10);
+    CHECK(FrameAddresses(*partMgr, 3) == std::vector<uint32>{100, 101, 102, 103, 104});
+    CHECK(FrameAddresses(*partMgr, 7) == std::vector<uint32>{200, 201, 202, 203, 204});
+    CHECK(partMgr->GetTail(3, 5) == nullptr);
+    CHECK(partMgr->GetBufferCount(0) == 0);
+
+    SECTION("Removing the tail") {
+        CHECK(partMgr->RemoveTail(3, 0));
+        CHECK(FrameAddresses(*partMgr, 3) == std::vector<uint32>{101, 102, 103, 104});
+        CHECK(partMgr->GetFreeBufferCount() == kNumBuffers - 9);
+    }
+
+    SECTION("Removing from the middle") {
+        CHECK(partMgr->RemoveTail(3, 2));
+        CHECK(FrameAddresses(*partMgr, 3) == std::vector<uint32>{100, 101, 103, 104});
+        CHECK_FALSE(partMgr->RemoveTail(3, 4));
+
+        // The removed buffer is reused by the next insertion
+        InsertSector(*partMgr, 3, 105);
+        CHECK(FrameAddresses(*partMgr, 3) == std::vector<uint32>{100, 101, 103, 104, 105});
+        CHECK(partMgr->GetFreeBufferCount() == kNumBuffers - 10);
+    }
+
+    SECTION("Deleting a range of sectors") {
+        CHECK(partMgr->DeleteSectors(7, 1, 3) == 3);
+        CHECK(FrameAddresses(*partMgr, 7) == std::vector<uint32>{200, 204});
+        CHECK(partMgr->GetFreeBufferCount() == kNumBuffers - 7);
+    }
+
+    SECTION("Deleting with the last sector position and all sectors") {
+        CHECK(partMgr->DeleteSectors(7, 0xFFFF, 1) == 1);
+        CHECK(FrameAddresses(*partMgr, 7) == std::vector<uint32>{200, 201, 202, 203});
+        CHECK(partMgr->DeleteSectors(7, 1, 0xFFFF) == 3);
+        CHECK(FrameAddresses(*partMgr, 7) == std::vector<uint32>{200});
+        CHECK(partMgr->DeleteSectors(7, 0, 0xFFFF) == 1);
+        CHECK(partMgr->GetBufferCount(7) == 0);
+        CHECK(partMgr->DeleteSectors(7, 0, 0xFFFF) == 0);
+    }
+
+    SECTION("Clearing a partition") {
+        partMgr->Clear(3);
+        CHECK(partMgr->GetBufferCount(3) == 0);
+        CHECK(FrameAddresses(*partMgr, 7) == std::vector<uint32>{200, 201, 202, 203, 204});
+        CHECK(partMgr->GetFreeBufferCount() == kNumBuffers - 5);
+    }
+
+    SECTION("Calculating sizes") {
+        partMgr->GetTail(3, 1)->size = 2324;
+        CHECK(partMgr->CalculateSize(3, 0, 4) == 4 * 2048 + 2324);
+        CHECK(partMgr->CalculateSize(3, 1, 1) == 2324);
+        CHECK(partMgr->CalculateSize(3, 3, 100) == 2 * 2048);
+        CHECK(partMgr->CalculateSize(0, 0, 0) == 0);
+    }
+
+    SECTION("Reset") {
+        partMgr->Reset();
+        CHECK(partMgr->GetBufferCount(3) == 0);
+        CHECK(partMgr->GetBufferCount(7) == 0);
+        CHECK(partMgr->GetFreeBufferCount() == kNumBuffers);
+    }
+}
+
+TEST_CASE("Partition manager hands out every buffer exactly once", "[cdblock][partition_manager]") {
+    auto partMgr = std::make_unique<PartitionManager>();
+
+    std::vector<bool> used(kNumBuffers, false);
+    for (uint32 i = 0; i < kNumBuffers; i++) {
+        const uint8 peeked = partMgr->PeekFreeBuffer();
+        const uint8 bufferIndex = partMgr->AllocateBuffer();
+        REQUIRE(bufferIndex == peeked);
+        REQUIRE(bufferIndex < kNumBuffers);
+        CHECK_FALSE(used[bufferIndex]);
+        used[bufferIndex] = true;
+        partMgr->InsertHead(i % kNumPartitions, bufferIndex);
+    }
+    CHECK(partMgr->GetFreeBufferCount() == 0);
+    CHECK(partMgr->PeekFreeBuffer() == PartitionManager::kNoBuffer);
+    CHECK(partMgr->AllocateBuffer() == PartitionManager::kNoBuffer);
+
+    // Freed buffers return to the pool
+    partMgr->Clear(5);
+    const uint32 freed = partMgr->GetFreeBufferCount();
+    CHECK(freed == (kNumBuffers + kNumPartitions - 1 - 5) / kNumPartitions);
+    for (uint32 i = 0; i < freed; i++) {
+        CHECK(partMgr->AllocateBuffer() != PartitionManager::kNoBuffer);
+    }
+    CHECK(partMgr->AllocateBuffer() == PartitionManager::kNoBuffer);
+}
+
+TEST_CASE("Partition manager reserves buffers", "[cdblock][partition_manager]") {
+    auto partMgr = std::make_unique<PartitionManager>();
+
+    CHECK_FALSE(partMgr->ReserveBuffers(0));
+    CHECK_FALSE(partMgr->ReserveBuffers(kNumBuffers + 1));
+    REQUIRE(partMgr->ReserveBuffers(10));
+    CHECK(partMgr->GetFreeBufferCount() == kNumBuffers - 10);
+    CHECK(partMgr->GetReservedBuffer(10) == PartitionManager::kNoBuffer);
+
+    // Reserved buffers are written in place and never handed out by the allocator
+    for (uint16 i = 0; i < 10; i++) {
+        const uint8 bufferIndex = partMgr->GetReservedBuffer(i);
+        REQUIRE(bufferIndex != PartitionManager::kNoBuffer);
+        partMgr->GetBuffer(bufferIndex).frameAddress = 400 + i;
+    }
+    for (uint32 i = 0; i < kNumBuffers - 10; i++) {
+        const uint8 bufferIndex = partMgr->AllocateBuffer();
+        REQUIRE(bufferIndex != PartitionManager::kNoBuffer);
+        partMgr->GetBuffer(bufferIndex).frameAddress = 0;
+        partMgr->InsertHead(0, bufferIndex);
+    }
+    CHECK(partMgr->PeekFreeBuffer() == PartitionManager::kNoBuffer);
+    CHECK(partMgr->AllocateBuffer() == PartitionManager::kNoBuffer);
+    partMgr->Clear(0);
+
+    SECTION("Inserting reserved buffers") {
+        const Buffer *first = &partMgr->GetBuffer(partMgr->GetReservedBuffer(0));
+        CHECK(partMgr->InsertReservedBuffers(4, 4));
+        CHECK(FrameAddresses(*partMgr, 4) == std::vector<uint32>{400, 401, 402, 403});
+        CHECK(partMgr->GetTail(4, 0) == first);
+        CHECK(partMgr->GetFreeBufferCount() == kNumBuffers - 10);
+        CHECK(partMgr->GetBuffer(partMgr->GetReservedBuffer(0)).frameAddress == 404);
+        CHECK_FALSE(partMgr->InsertReservedBuffers(4, 7));
+        CHECK(partMgr->GetBufferCount(4) == 4);
+    }
+
+    SECTION("Releasing reserved buffers") {
+        partMgr->ReleaseReservedBuffers();
+        CHECK(partMgr->GetFreeBufferCount() == kNumBuffers);
+        CHECK(partMgr->GetReservedBuffer(0) == PartitionManager::kNoBuffer);
+    }
+}
+
+TEST_CASE("Partition manager moves sectors without copying them", "[cdblock][partition_manager]") {
+    auto partMgr = std::make_unique<PartitionManager>();
+
+    for (uint32 i = 0; i < 5; i++) {
+        InsertSector(*partMgr, 3, 100 + i);
+    }
+    const Buffer *moved = partMgr->GetTail(3, 1);
+
+    SECTION("To another partition") {
+        partMgr->MoveSectors(3, 1, 3, [](const Buffer &) { return uint8{7}; });
+        CHECK(FrameAddresses(*partMgr, 3) == std::vector<uint32>{100, 104});
+        CHECK(FrameAddresses(*partMgr, 7) == std::vector<uint32>{101, 102, 103});
+        CHECK(partMgr->GetTail(7, 0) == moved);
+        CHECK(partMgr->GetFreeBufferCount() == kNumBuffers - 5);
+    }
+
+    SECTION("Back into the source partition") {
+        partMgr->MoveSectors(3, 0, 2, [](const Buffer &) { return uint8{3}; });
+        CHECK(FrameAddresses(*partMgr, 3) == std::vector<uint32>{102, 103, 104, 100, 101});
+        CHECK(partMgr->GetTail(3, 4) == moved);
+    }
+
+    SECTION("Discarding sectors") {
+        partMgr->MoveSectors(3, 0, 5, [](const Buffer &buffer) {
+            return buffer.frameAddress % 2 == 0 ? uint8{5} : PartitionManager::kNoPartition;
+        });
+        CHECK(partMgr->GetBufferCount(3) == 0);
+        CHECK(FrameAddresses(*partMgr, 5) == std::vector<uint32>{100, 102, 104});
+        CHECK(partMgr->GetFreeBufferCount() == kNumBuffers - 3);
+    }
+}
+
+TEST_CASE("Partition manager copies sectors into pool buffers", "[cdblock][partition_manager]") {
+    auto partMgr = std::make_unique<PartitionManager>();
+
+    for (uint32 i = 0; i < 5; i++) {
+        InsertSector(*partMgr, 3, 100 + i);
+    }
+    partMgr->GetTail(3, 2)->data[0x20] = 0x5A;
+
+    SECTION("To another partition") {
+        CHECK(partMgr->CopySectors(3, 1, 3, [](const Buffer &) { return uint8{7}; }));
+        CHECK(FrameAddresses(*partMgr, 3) == std::vector<uint32>{100, 101, 102, 103, 104});
+        CHECK(FrameAddresses(*partMgr, 7) == std::vector<uint32>{101, 102, 103});
+        CHECK(partMgr->GetTail(7, 1) != partMgr->GetTail(3, 2));
+        CHECK(partMgr->GetTail(7, 1)->data == partMgr->GetTail(3, 2)->data);
+        CHECK(partMgr->GetFreeBufferCount() == kNumBuffers - 8);
+    }
+
+    SECTION("Back into the source partition") {
+        CHECK(partMgr->CopySectors(3, 3, 2, [](const Buffer &) { return uint8{3}; }));
+        CHECK(FrameAddresses(*partMgr, 3) == std::vector<uint32>{100, 101, 102, 103, 104, 103, 104});
+    }
+
+    SECTION("Skipping sectors") {
+        CHECK(partMgr->CopySectors(3, 0, 5, [](const Buffer &buffer) {
+            return buffer.frameAddress % 2 == 0 ? uint8{5} : PartitionManager::kNoPartition;
+        }));
+        CHECK(FrameAddresses(*partMgr, 5) == std::vector<uint32>{100, 102, 104});
+        CHECK(partMgr->GetFreeBufferCount() == kNumBuffers - 8);
+    }
+
+    SECTION("Without enough free buffers") {
+        REQUIRE(partMgr->ReserveBuffers(kNumBuffers - 7));
+        CHECK_FALSE(partMgr->CopySectors(3, 0, 3, [](const Buffer &) { return uint8{7}; }));
+        CHECK(partMgr->GetBufferCount(7) == 0);
+        CHECK(partMgr->CopySectors(3, 0, 2, [](const Buffer &) { return uint8{7}; }));
+        CHECK(FrameAddresses(*partMgr, 7) == std::vector<uint32>{100, 101});
+    }
+}
+
+TEST_CASE("Partition manager save states preserve partition contents", "[cdblock][partition_manager]") {
+    auto partMgr = std::make_unique<PartitionManager>();
+
+    // Interleave partitions and punch holes so that buffers are scattered across the pool
+    for (uint32 i = 0; i < 12; i++) {
+        InsertSector(*partMgr, i % 3, 300 + i);
+    }
+    partMgr->RemoveTail(0, 1);
+    partMgr->RemoveTail(2, 0);
+    REQUIRE(partMgr->ReserveBuffers(2));
+    partMgr->GetBuffer(partMgr->GetReservedBuffer(0)).frameAddress = 500;
+    partMgr->GetBuffer(partMgr->GetReservedBuffer(1)).frameAddress = 501;
+
+    auto state = std::make_unique<savestate::CDBlockSaveState>();
+    for (auto &buffer : state->buffers) {
+        buffer.partitionIndex = 0xFF;
+    }
+    partMgr->SaveState(*state);
+
+    auto loaded = std::make_unique<PartitionManager>();
+    REQUIRE(loaded->ValidateState(*state));
+    loaded->LoadState(*state);
+
+    for (uint8 i = 0; i < 3; i++) {
+        CHECK(FrameAddresses(*loaded, i) == FrameAddresses(*partMgr, i));
+    }
+    CHECK(FrameAddresses(*loaded, 0) == std::vector<uint32>{300, 306, 309});
+    CHECK(loaded->GetFreeBufferCount() == partMgr->GetFreeBufferCount());
+    CHECK(loaded->GetBuffer(loaded->GetReservedBuffer(0)).frameAddress == 500);
+    CHECK(loaded->GetBuffer(loaded->GetReservedBuffer(1)).frameAddress == 501);
+
+    state->reservedBuffers = kNumBuffers;
+    CHECK_FALSE(loaded->ValidateState(*state));
+}
+
+} // namespace cdblock_partition_manager
@@ -0,0 +1,199 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/hw/scsp/scsp.hpp>
+
+#include <array>
+#include <utility>
+#include <vector>
+
+using namespace ymir;
+
+namespace scsp_threading {
+
+static constexpr uint32 kWRAMBase = 0x5A0'0000;
+static constexpr uint32 kRegBase = 0x5B0'0000;
+
+// Runs a short scripted session on an SCSP and records everything observable from the outside.
+struct TestSubject {
+    core::Configuration config{};
+    core::Scheduler scheduler{};
+    sys::SH2Bus bus{};
+    scsp::SCSP scsp{scheduler, config.audio};
+
+    std::vector<std::pair<sint16, sint16>> output;
+    std::vector<std::pair<uint64, bool>> interrupts;
+    uint64 currSample = 0;
+
+    explicit TestSubject(bool threaded) {
+        scsp.MapMemory(bus);
+        scsp.MapCallbacks(util::MakeClassMemberRequiredCallback<&TestSubject::SoundRequest>(this));
+        scsp.SetSampleCallback(util::MakeClassMemberOptionalCallback<&TestSubject::Sample>(this));
+        config.audio.threadedSCSP = threaded;
+    }
+
+    void SoundRequest(bool level) {
+        // The SCU only reacts to changes of the signal, which starts out low
+        const bool prevLevel = !interrupts.empty() && interrupts.back().second;
+        if (level != prevLevel) {
+            interrupts.emplace_back(currSample, level);
+        }
+    }
+
+    void Sample(sint16 left, sint16 right) {
+        output.emplace_back(left, right);
+    }
+
+    void WriteSlotReg(uint32 slot, uint32 offset, uint16 value) {
+        bus.Write<uint16>(kRegBase + slot * 0x20 + offset, value);
+    }
+
+    void FeedCDDA(uint32 sector) {
+        alignas(16) std::array<uint8, 2352> data{};
+        for (uint32 i = 0; i < data.size(); i += 2) {
+            const uint16 value = static_cast<uint16>((sector * 2352 + i) * 13);
+            data[i + 0] = value;
+            data[i + 1] = value >> 8u;
+        }
+        scsp.ReceiveCDDA(data);
+    }
+
+    void Run() {
+        // Sawtooth waveform at the start of WRAM
+        for (uint32 i = 0; i < 64; ++i) {
+            bus.Write<uint16>(kWRAMBase + 0x1000 + i * 2, static_cast<uint16>(i * 0x400));
+        }
+
+        bus.Write<uint16>(kRegBase + 0x400, 0x000F); // MVOL = 15
+
+        // Slot 0 plays the waveform in a loop; slots 0 and 1 send CDDA to the output through EFSDL
+        WriteSlotReg(0, 0x02, 0x1000); // SA
+        WriteSlotReg(0, 0x04, 0x0000); // LSA
+        WriteSlotReg(0, 0x06, 0x0040); // LEA
+        WriteSlotReg(0, 0x08, 0x001F); // AR
+        WriteSlotReg(0, 0x0C, 0x0000); // TL
+        WriteSlotReg(0, 0x10, 0x0000); // OCT, FNS
+        WriteSlotReg(0, 0x16, 0xE0E0); // DISDL, EFSDL
+        WriteSlotReg(1, 0x16, 0x00F0); // EFSDL, EFPAN
+
+        for (uint32 sector = 0; sector < 6; ++sector) {
+            FeedCDDA(sector);
+        }
+        uint32 nextSector = 6;
+
+        WriteSlotReg(0, 0x00, 0x1820); // KYONEX, KYONB, normal loop, 16-bit PCM
+
+        for (currSample = 0; currSample < 3000; ++currSample) {
+            switch (currSample) {
+            case 500: WriteSlotReg(0, 0x10, 0x0200); break;               // raise pitch
+            case 900: bus.Write<uint16>(kRegBase + 0x42A, 0x0400); break; // MCIEB = sample interrupt
+            case 1200: bus.Write<uint16>(kRegBase + 0x42A, 0x0000); break;
+            case 1500: WriteSlotReg(0, 0x00, 0x1020); break; // key off
+            }
+            if (currSample >= 900 && currSample < 1200 && currSample % 7 == 0) {
+                bus.Write<uint16>(kRegBase + 0x42E, 0x0400); // MCIRE
+            }
+            if (currSample % 588 == 0) {
+                FeedCDDA(nextSector++);
+            }
+            if (currSample % 735 == 734) {
+                scsp.FlushOutput();
+            }
+
+            scheduler.Advance(scsp::kCyclesPerSample);
+        }
+
+        // Stops the SCSP thread, if running, after it catches up
+        config.audio.threadedSCSP = false;
+    }
+
+    // Runs an M68K program that raises and clears the sound request interrupt through MCIEB, MCIPD and MCIRE.
+    void RunM68KProgram() {
+        static constexpr std::array<uint16, 64> kProgram = {
+            0x33FC, 0x0020, 0x0010, 0x042C, // 400: move.w #$0020, $10042C  ; MCIPD = sound request (MCIEB = 0)
+            0x303C, 0x0100,                 // 408: move.w #$0100, d0
+            0x51C8, 0xFFFE,                 // 40C: dbra d0, *
+            0x33FC, 0x0020, 0x0010, 0x042A, // 410: move.w #$0020, $10042A  ; MCIEB = sound request
+            0x303C, 0x0100,                 // 418: move.w #$0100, d0
+            0x51C8, 0xFFFE,                 // 41C: dbra d0, *
+            0x33FC, 0x0020, 0x0010, 0x042E, // 420: move.w #$0020, $10042E  ; MCIRE = sound request
+            0x303C, 0x0080,                 // 428: move.w #$0080, d0
+            0x51C8, 0xFFFE,                 // 42C: dbra d0, *
+            0x33FC, 0x0000, 0x0010, 0x042A, // 430: move.w #$0000, $10042A  ; MCIEB = 0
+            0x6000, 0xFFC6,                 // 438: bra.w $400
+        };
+
+        bus.Write<uint16>(kWRAMBase + 0x0, 0x0007); // initial SSP = 0x7F000
+        bus.Write<uint16>(kWRAMBase + 0x2, 0xF000);
+        bus.Write<uint16>(kWRAMBase + 0x4, 0x0000); // initial PC = 0x400
+        bus.Write<uint16>(kWRAMBase + 0x6, 0x0400);
+        for (uint32 i = 0; i < kProgram.size(); ++i) {
+            bus.Write<uint16>(kWRAMBase + 0x400 + i * 2, kProgram[i]);
+        }
+
+        // Same sound as the scripted session so that the output comparison is meaningful
+        for (uint32 i = 0; i < 64; ++i) {
+            bus.Write<uint16>(kWRAMBase + 0x1000 + i * 2, static_cast<uint16>(i * 0x400));
+        }
+        bus.Write<uint16>(kRegBase + 0x400, 0x000F); // MVOL = 15
+        WriteSlotReg(0, 0x02, 0x1000);               // SA
+        WriteSlotReg(0, 0x06, 0x0040);               // LEA
+        WriteSlotReg(0, 0x08, 0x001F);               // AR
+        WriteSlotReg(0, 0x16, 0xE0E0);               // DISDL, EFSDL
+        WriteSlotReg(0, 0x00, 0x1820);               // KYONEX, KYONB, normal loop, 16-bit PCM
+
+        scsp.SetCPUEnabled(true);
+
+        for (currSample = 0; currSample < 3000; ++currSample) {
+            if (currSample == 1000) {
+                // Clear the request from the SCU side while the M68K is toggling it
+                bus.Write<uint16>(kRegBase + 0x42E, 0x0020); // MCIRE
+            }
+            if (currSample % 735 == 734) {
+                scsp.FlushOutput();
+            }
+
+            scheduler.Advance(scsp::kCyclesPerSample);
+        }
+
+        config.audio.threadedSCSP = false;
+    }
+};
+
+} // namespace scsp_threading
+
+using namespace scsp_threading;
+
+TEST_CASE("Threaded SCSP matches single-threaded execution", "[scsp][threading]") {
+    TestSubject direct{false};
+    TestSubject threaded{true};
+
+    direct.Run();
+    threaded.Run();
+
+    REQUIRE(direct.output.size() == 3000);
+    CHECK(threaded.output == direct.output);
+    CHECK(threaded.interrupts == direct.interrupts);
+
+    // Make sure the script actually exercised the sound output and interrupt paths
+    bool hasSound = false;
+    for (auto [left, right] : direct.output) {
+        hasSound |= left != 0 || right != 0;
+    }
+    CHECK(hasSound);
+    CHECK(direct.interrupts.size() > 2);
+}
+
+TEST_CASE("Threaded SCSP delivers sound request interrupts raised by the M68K on time", "[scsp][threading]") {
+    TestSubject direct{false};
+    TestSubject threaded{true};
+
+    direct.RunM68KProgram();
+    threaded.RunM68KProgram();
+
+    REQUIRE(direct.output.size() == 3000);
+    CHECK(threaded.output == direct.output);
+    CHECK(threaded.interrupts == direct.interrupts);
+
+    // The program toggles the signal roughly every 30 samples
+    CHECK(direct.interrupts.size() > 100);
+}
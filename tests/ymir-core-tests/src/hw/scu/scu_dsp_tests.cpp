@@ -3152,6 +3152,44 @@ TEST_CASE_PERSISTENT_FIXTURE(TestSubject, "SCU DSP DMA transfers execute correct
     //   garbage to VDP1 registers
 }
 
+TEST_CASE_PERSISTENT_FIXTURE(TestSubject, "SCU DSP executes rewritten program RAM", "[scu][scudsp][instructions]") {
+    ClearAll();
+
+    dsp.programRAM[0].u32 = 0x10040000; // ADD  MOV ALU,A
+    dsp.AC.u64 = 1;
+    dsp.P.u64 = 1;
+
+    // Setup execution
+    dsp.PC = 0;
+    dsp.programExecuting = true;
+    dsp.programEnded = false;
+    dsp.programPaused = false;
+    dsp.programStep = false;
+
+    // Run pipelined NOP + ADD  MOV ALU,A
+    dsp.Run<false>((1 + 1) * 2);
+    REQUIRE(dsp.AC.u64 == 2);
+
+    SECTION("Direct write") {
+        dsp.programRAM[0].u32 = 0x28040000; // SL   MOV ALU,A
+    }
+
+    SECTION("Program RAM port") {
+        dsp.programExecuting = false;
+        dsp.WritePC<false>(0);
+        dsp.WriteProgram<false>(0x28040000); // SL   MOV ALU,A
+        dsp.programExecuting = true;
+    }
+
+    // Run pipelined NOP + SL  MOV ALU,A
+    dsp.WritePC<true>(0);
+    dsp.Run<false>((1 + 1) * 2);
+
+    CHECK(dsp.PC == 2);
+    CHECK(dsp.ALU.u64 == 4);
+    CHECK(dsp.AC.u64 == 4);
+}
+
 // TODO: test complete programs
 
 // TODO: test DSP control (start, stop, pause, step, etc.)
@@ -0,0 +1,205 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/hw/sh2/sh2.hpp>
+
+#include <map>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Test subject class
+
+using namespace ymir;
+
+namespace sh2_brk {
+
+inline constexpr uint16 instrNOP = 0x0009;
+inline constexpr uint16 instrMOVLRead = 0x6012; // MOV.L @R1, R0
+
+inline constexpr uint32 kStartPC = 0x0000'1000;
+
+struct TestSubject {
+    mutable sys::SH2Bus bus{};
+    mutable sh2::SH2 sh2{bus, true};
+    sh2::SH2::Probe &probe{sh2.GetProbe()};
+    debug::DebugBreakManager debugBreakMgr{};
+
+    // Memory is filled with NOPs except where mocked
+    std::map<uint32, uint16> code;
+
+    std::vector<debug::DebugBreakInfo> breaks;
+
+    TestSubject() {
+        bus.MapBoth(
+            0x000'0000, 0x7FF'FFFF, this,
+            [](uint32 address, void *ctx) -> uint8 { return 0; },
+            [](uint32 address, void *ctx) -> uint16 { return static_cast<TestSubject *>(ctx)->Read16(address); },
+            [](uint32 address, void *ctx) -> uint32 {
+                auto &subject = *static_cast<TestSubject *>(ctx);
+                return (subject.Read16(address) << 16u) | subject.Read16(address + 2);
+            },
+            [](uint32 address, uint8 value, void *ctx) {}, [](uint32 address, uint16 value, void *ctx) {},
+            [](uint32 address, uint32 value, void *ctx) {});
+
+        debugBreakMgr.SetDebugBreakRaisedCallback(util::MakeClassMemberOptionalCallback<&TestSubject::Break>(this));
+
+        sh2.Reset(true);
+        probe.PC() = kStartPC;
+    }
+
+    uint16 Read16(uint32 address) const {
+        auto it = code.find(address & 0x7FF'FFFE);
+        return it != code.end() ? it->second : instrNOP;
+    }
+
+    void Break(const debug::DebugBreakInfo &info) {
+        breaks.push_back(info);
+    }
+
+    void Run() {
+        sh2.Advance<true, false>(256);
+    }
+};
+
+} // namespace sh2_brk
+
+// -----------------------------------------------------------------------------
+// Tests
+
+using namespace sh2_brk;
+
+TEST_CASE("SH-2 breakpoints stop execution at the target address", "[sh2][debug][breakpoint]") {
+    TestSubject subject{};
+
+    SECTION("Breakpoint added before attaching the debug break manager") {
+        subject.sh2.AddBreakpoint(kStartPC + 0x10);
+        subject.sh2.UseDebugBreakManager(&subject.debugBreakMgr);
+    }
+
+    SECTION("Breakpoint added after attaching the debug break manager") {
+        subject.sh2.UseDebugBreakManager(&subject.debugBreakMgr);
+        subject.sh2.AddBreakpoint(kStartPC + 0x10);
+    }
+
+    SECTION("Breakpoint remaining after removing another one in the same page") {
+        subject.sh2.UseDebugBreakManager(&subject.debugBreakMgr);
+        subject.sh2.AddBreakpoint(kStartPC + 0x08);
+        subject.sh2.AddBreakpoint(kStartPC + 0x10);
+        subject.sh2.RemoveBreakpoint(kStartPC + 0x08);
+    }
+
+    SECTION("Breakpoint toggled on in a page emptied by a removal") {
+        subject.sh2.UseDebugBreakManager(&subject.debugBreakMgr);
+        subject.sh2.AddBreakpoint(kStartPC + 0x08);
+        subject.sh2.RemoveBreakpoint(kStartPC + 0x08);
+        subject.sh2.ToggleBreakpoint(kStartPC + 0x10);
+    }
+
+    subject.Run();
+
+    REQUIRE(subject.breaks.size() == 1);
+    CHECK(subject.breaks[0].event == debug::DebugBreakInfo::Event::SH2Breakpoint);
+    CHECK(subject.breaks[0].details.sh2Breakpoint.pc == kStartPC + 0x10);
+    CHECK(subject.probe.PC() == kStartPC + 0x10);
+}
+
+TEST_CASE("SH-2 breakpoints do not trigger after removal", "[sh2][debug][breakpoint]") {
+    TestSubject subject{};
+    subject.sh2.UseDebugBreakManager(&subject.debugBreakMgr);
+
+    SECTION("Removed breakpoint") {
+        subject.sh2.AddBreakpoint(kStartPC + 0x10);
+        subject.sh2.RemoveBreakpoint(kStartPC + 0x10);
+    }
+
+    SECTION("Toggled breakpoint") {
+        subject.sh2.ToggleBreakpoint(kStartPC + 0x10);
+        subject.sh2.ToggleBreakpoint(kStartPC + 0x10);
+    }
+
+    SECTION("Cleared breakpoints") {
+        subject.sh2.AddBreakpoint(kStartPC + 0x10);
+        subject.sh2.AddBreakpoint(kStartPC + 0x20);
+        subject.sh2.ClearBreakpoints();
+    }
+
+    SECTION("Breakpoint in another page") {
+        subject.sh2.AddBreakpoint(kStartPC + 0x10 + 0x1000);
+    }
+
+    subject.Run();
+
+    CHECK(subject.breaks.empty());
+}
+
+TEST_CASE("SH-2 breakpoints trigger when execution enters their page", "[sh2][debug][breakpoint]") {
+    TestSubject subject{};
+    subject.sh2.UseDebugBreakManager(&subject.debugBreakMgr);
+
+    uint32 target{};
+
+    SECTION("Breakpoint on the first instruction of the next page") {
+        target = kStartPC + 0x1000;
+        subject.probe.PC() = target - 0x10;
+    }
+
+    SECTION("Breakpoint on a branch target in another page") {
+        target = kStartPC + 0x1002;
+        subject.code[kStartPC] = 0xA7FF; // BRA kStartPC + 0x1002
+    }
+
+    subject.sh2.AddBreakpoint(target);
+    subject.Run();
+
+    REQUIRE(subject.breaks.size() == 1);
+    CHECK(subject.breaks[0].details.sh2Breakpoint.pc == target);
+    CHECK(subject.probe.PC() == target);
+}
+
+TEST_CASE("SH-2 watchpoints stop execution before the watched access", "[sh2][debug][watchpoint]") {
+    static constexpr uint32 kWatchAddress = 0x0600'2000;
+    static constexpr uint32 kInstrAddress = kStartPC + 0x10;
+
+    TestSubject subject{};
+    subject.code[kInstrAddress] = instrMOVLRead;
+    subject.probe.R(1) = kWatchAddress;
+    subject.sh2.UseDebugBreakManager(&subject.debugBreakMgr);
+
+    SECTION("Watchpoint on the accessed address") {
+        subject.sh2.AddWatchpoint(kWatchAddress, debug::WatchpointFlags::Read);
+
+        subject.Run();
+
+        REQUIRE(subject.breaks.size() == 1);
+        CHECK(subject.breaks[0].event == debug::DebugBreakInfo::Event::SH2Watchpoint);
+        CHECK(subject.breaks[0].details.sh2Watchpoint.address == kWatchAddress);
+        CHECK(subject.breaks[0].details.sh2Watchpoint.write == false);
+        CHECK(subject.probe.PC() == kInstrAddress);
+    }
+
+    SECTION("Watchpoint removed from a page with other watchpoints") {
+        subject.sh2.AddWatchpoint(kWatchAddress + 0x100, debug::WatchpointFlags::Read);
+        subject.sh2.AddWatchpoint(kWatchAddress, debug::WatchpointFlags::Read);
+        subject.sh2.RemoveWatchpoint(kWatchAddress, debug::WatchpointFlags::Read);
+
+        subject.Run();
+
+        CHECK(subject.breaks.empty());
+    }
+
+    SECTION("Watchpoint for the other direction") {
+        subject.sh2.AddWatchpoint(kWatchAddress, debug::WatchpointFlags::Write);
+
+        subject.Run();
+
+        CHECK(subject.breaks.empty());
+    }
+
+    SECTION("Cleared watchpoints") {
+        subject.sh2.AddWatchpoint(kWatchAddress, debug::WatchpointFlags::Read);
+        subject.sh2.ClearWatchpointsAt(kWatchAddress);
+
+        subject.Run();
+
+        CHECK(subject.breaks.empty());
+    }
+}
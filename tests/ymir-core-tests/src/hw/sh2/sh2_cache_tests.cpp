@@ -0,0 +1,89 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/hw/sh2/sh2_cache.hpp>
+
+using namespace ymir;
+
+namespace sh2_cache {
+
+// Reference implementation of the tag lookup
+static uint8 FindWayScalar(const sh2::CacheEntry &entry, uint32 address) {
+    const uint32 tagAddress = (bit::extract<10, 28>(address) << 10) | (1 << 2);
+    for (uint8 way = 0; way < sh2::kCacheWays; way++) {
+        if (entry.tag[way].u32 == tagAddress) {
+            return way;
+        }
+    }
+    return 4;
+}
+
+TEST_CASE("SH-2 cache tag lookup matches the scalar reference", "[sh2][cache]") {
+    sh2::CacheEntry entry{};
+    entry.tag[0].u32 = 0x00001C04; // valid, tag 0x00001C00
+    entry.tag[1].u32 = 0x06000400; // invalid, tag 0x06000400
+    entry.tag[2].u32 = 0x06000404; // valid, tag 0x06000400
+    entry.tag[3].u32 = 0x00001C04; // duplicate of way 0
+
+    const uint32 addresses[] = {0x00001C30, 0x20001C30, 0x06000410, 0x0600041F, 0x06000810, 0x00000000, 0x1FFFFFF0};
+    for (uint32 address : addresses) {
+        CAPTURE(address);
+        CHECK(entry.FindWay(address) == FindWayScalar(entry, address));
+    }
+
+    CHECK(entry.FindWay(0x00001C30) == 0);
+    CHECK(entry.FindWay(0x06000410) == 2);
+    CHECK(entry.FindWay(0x06000810) == 4);
+}
+
+TEST_CASE("SH-2 cache LRU update follows the replacement algorithm", "[sh2][cache]") {
+    sh2::Cache cache{};
+    const uint32 address = 0x06000040;
+    const uint8 index = bit::extract<4, 9>(address);
+
+    // After touching ways 3, 2, 1, 0 in order, way 3 is the least recently used
+    cache.UpdateLRU(address, 3);
+    cache.UpdateLRU(address, 2);
+    cache.UpdateLRU(address, 1);
+    cache.UpdateLRU(address, 0);
+    CHECK(cache.GetWayFromLRU<false>(cache.GetLRU(index)) == 3);
+
+    cache.UpdateLRU(address, 3);
+    CHECK(cache.GetWayFromLRU<false>(cache.GetLRU(index)) == 2);
+    CHECK(cache.GetLRU(index) == 0b001011);
+}
+
+TEST_CASE("SH-2 cache fetch line is invalidated when tags change", "[sh2][cache]") {
+    sh2::Cache cache{};
+    cache.WriteCCR<false>(0x01); // enable cache
+
+    const uint32 address = 0x06000104;
+    const uint8 way = cache.SelectWay<true>(address);
+    REQUIRE(sh2::IsValidCacheWay(way));
+    cache.GetEntry(address).line[way][4] = 0xA5;
+
+    cache.SetFetchLine(address, way);
+    const uint8 *line = cache.GetFetchLine(0x0600010C);
+    REQUIRE(line != nullptr);
+    CHECK(line[4] == 0xA5);
+    CHECK(cache.GetFetchLine(0x06000110) == nullptr);
+    CHECK(cache.GetFetchLine(0x26000104) == nullptr);
+
+    SECTION("associative purge") {
+        cache.AssociativePurge(0x46000100);
+        CHECK(cache.GetFetchLine(address) == nullptr);
+    }
+    SECTION("cache purge") {
+        cache.WriteCCR<false>(0x11);
+        CHECK(cache.GetFetchLine(address) == nullptr);
+    }
+    SECTION("replacement") {
+        cache.SelectWay<false>(0x06001100);
+        CHECK(cache.GetFetchLine(address) == nullptr);
+    }
+    SECTION("address array write") {
+        cache.WriteAddressArray<uint32, false>(0x60000100, 0u);
+        CHECK(cache.GetFetchLine(address) == nullptr);
+    }
+}
+
+} // namespace sh2_cache
@@ -0,0 +1,234 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/hw/vdp/renderer/common/vdp2_write_spans.hpp>
+#include <ymir/hw/vdp/vdp2_defs.hpp>
+
+#include <ymir/util/data_ops.hpp>
+
+#include <blockingconcurrentqueue.h>
+
+#include <array>
+#include <cstring>
+#include <memory>
+
+using namespace ymir;
+
+namespace vdp_vram_write_patterns_tests {
+
+// Applies spans the way the renderer thread does and keeps a reference copy written directly
+struct TestSubject {
+    std::array<uint8, vdp::kVDP2VRAMSize> refVRAM{};
+    std::array<uint8, vdp::kVDP2CRAMSize> refCRAM{};
+    std::array<uint8, vdp::kVDP2VRAMSize> spanVRAM{};
+    std::array<uint8, vdp::kVDP2CRAMSize> spanCRAM{};
+
+    vdp::VDP2WriteSpanCoalescer coalescer{};
+    size_t writeCount = 0;
+    size_t spanCount = 0;
+
+    auto Sink() {
+        return [this](vdp::VDP2WriteSpanTarget target, const vdp::VDP2WriteSpan &span) {
+            uint8 *dst = target == vdp::VDP2WriteSpanTarget::VRAM ? &spanVRAM[span.address] : &spanCRAM[span.address];
+            std::memcpy(dst, span.data.data(), span.length);
+            ++spanCount;
+        };
+    }
+
+    template <mem_primitive_16 T>
+    void WriteVRAM(uint32 address, T value) {
+        util::WriteBE<T>(&refVRAM[address], value);
+        coalescer.WriteVRAM(address, value, Sink());
+        ++writeCount;
+    }
+
+    template <mem_primitive_16 T>
+    void WriteCRAM(uint32 address, T value) {
+        util::WriteBE<T>(&refCRAM[address], value);
+        coalescer.WriteCRAM(address, value, Sink());
+        ++writeCount;
+    }
+
+    void Flush() {
+        coalescer.Flush(Sink());
+    }
+};
+
+static constexpr size_t SpansFor(size_t bytes) {
+    return (bytes + vdp::VDP2WriteSpan::kCapacity - 1) / vdp::VDP2WriteSpan::kCapacity;
+}
+
+TEST_CASE("VDP2 write spans reproduce memory writes", "[vdp][vram][write_spans]") {
+    auto subject = std::make_unique<TestSubject>();
+
+    SECTION("Sequential word upload") {
+        // Typical SCU DMA transfer of character data
+        for (uint32 i = 0; i < 0x8000; i += sizeof(uint16)) {
+            subject->WriteVRAM<uint16>(0x10000 + i, i * 0x1234u);
+        }
+        subject->Flush();
+        CHECK(subject->writeCount == 0x4000);
+        CHECK(subject->spanCount == SpansFor(0x8000));
+    }
+
+    SECTION("Longword writes") {
+        // 32-bit bus writes reach VDP2 as pairs of word writes
+        for (uint32 i = 0; i < 0x1000; i += sizeof(uint32)) {
+            const uint32 value = i * 0x9E3779B9u;
+            subject->WriteVRAM<uint16>(0x7F000 + i + 0, value >> 16u);
+            subject->WriteVRAM<uint16>(0x7F000 + i + 2, value >> 0u);
+        }
+        subject->Flush();
+        CHECK(subject->spanCount == SpansFor(0x1000));
+    }
+
+    SECTION("Byte writes") {
+        for (uint32 i = 0; i < 0x200; ++i) {
+            subject->WriteVRAM<uint8>(0x300 + i, i);
+        }
+        subject->Flush();
+        CHECK(subject->spanCount == SpansFor(0x200));
+    }
+
+    SECTION("Scattered writes") {
+        uint32 state = 0x12345678u;
+        for (uint32 i = 0; i < 0x1000; ++i) {
+            state ^= state << 13u;
+            state ^= state >> 17u;
+            state ^= state << 5u;
+            subject->WriteVRAM<uint16>(state & 0x7FFFE, state >> 16u);
+        }
+        subject->Flush();
+        CHECK(subject->spanCount <= subject->writeCount);
+    }
+
+    SECTION("Writes wrapping around the end of VRAM") {
+        subject->WriteVRAM<uint16>(0x7FFFC, 0x1111);
+        subject->WriteVRAM<uint16>(0x7FFFE, 0x2222);
+        subject->WriteVRAM<uint16>(0x00000, 0x3333);
+        subject->Flush();
+        CHECK(subject->spanCount == 2);
+    }
+
+    SECTION("CRAM mode 0 mirrored writes") {
+        // Every write is mirrored into the other half of CRAM
+        for (uint32 i = 0; i < 0x800; i += sizeof(uint16)) {
+            subject->WriteCRAM<uint16>(i, i | 0x8000);
+            subject->WriteCRAM<uint16>(i ^ 0x800, i | 0x8000);
+        }
+        subject->Flush();
+        CHECK(subject->spanCount == 2 * SpansFor(0x800));
+    }
+
+    SECTION("CRAM mode 1 and 2 interleaved writes") {
+        // Consecutive words alternate between both halves of CRAM
+        for (uint32 i = 0; i < vdp::kVDP2CRAMSize; i += sizeof(uint16)) {
+            subject->WriteCRAM<uint16>(vdp::kVDP2CRAMAddressMapping[1][i], i);
+        }
+        subject->Flush();
+        CHECK(subject->spanCount == 2 * SpansFor(0x800));
+    }
+
+    SECTION("Interleaved VRAM and CRAM writes") {
+        for (uint32 i = 0; i < 0x400; i += sizeof(uint16)) {
+            subject->WriteVRAM<uint16>(0x40000 + i, ~i);
+            subject->WriteCRAM<uint16>(0x200 + i, i);
+        }
+        subject->Flush();
+        CHECK(subject->spanCount == 2 * SpansFor(0x400));
+    }
+
+    CHECK(subject->spanVRAM == subject->refVRAM);
+    CHECK(subject->spanCRAM == subject->refCRAM);
+}
+
+TEST_CASE("VDP2 write spans are flushed once", "[vdp][vram][write_spans]") {
+    auto subject = std::make_unique<TestSubject>();
+    subject->WriteVRAM<uint16>(0x100, 0xABCD);
+    subject->Flush();
+    subject->Flush();
+    CHECK(subject->spanCount == 1);
+
+    subject->WriteVRAM<uint16>(0x102, 0xEF01);
+    subject->coalescer.Reset();
+    subject->Flush();
+    CHECK(subject->spanCount == 1);
+}
+
+// -----------------------------------------------------------------------------
+
+// Event layouts matching the renderer's before and after write coalescing
+struct WriteEvent {
+    uint32 type;
+    uint32 address;
+    uint32 value;
+};
+
+struct SpanEvent {
+    uint32 type;
+    vdp::VDP2WriteSpan span;
+};
+
+struct QueueTraits : moodycamel::ConcurrentQueueDefaultTraits {
+    static constexpr size_t BLOCK_SIZE = 64;
+};
+
+TEST_CASE("VDP2 memory write enqueue overhead", "[.][benchmark][vdp][vram][write_spans]") {
+    // One 32 KiB character data upload, sent in batches of 64 events like the renderer does
+    static constexpr uint32 kUploadSize = 0x8000;
+
+    BENCHMARK_ADVANCED("Per-write events")(Catch::Benchmark::Chronometer meter) {
+        moodycamel::BlockingConcurrentQueue<WriteEvent, QueueTraits> queue{};
+        moodycamel::ProducerToken pTok{queue};
+        meter.measure([&] {
+            std::array<WriteEvent, 64> pending{};
+            size_t count = 0;
+            for (uint32 i = 0; i < kUploadSize; i += sizeof(uint16)) {
+                pending[count++] = {.type = 1, .address = i, .value = i};
+                if (count == pending.size()) {
+                    queue.enqueue_bulk(pTok, pending.begin(), count);
+                    count = 0;
+                }
+            }
+            queue.enqueue_bulk(pTok, pending.begin(), count);
+
+            std::array<WriteEvent, 64> events{};
+            size_t dequeued = 0;
+            while (size_t n = queue.try_dequeue_bulk(events.begin(), events.size())) {
+                dequeued += n;
+            }
+            return dequeued;
+        });
+    };
+
+    BENCHMARK_ADVANCED("Coalesced write spans")(Catch::Benchmark::Chronometer meter) {
+        moodycamel::BlockingConcurrentQueue<SpanEvent, QueueTraits> queue{};
+        moodycamel::ProducerToken pTok{queue};
+        meter.measure([&] {
+            std::array<SpanEvent, 64> pending{};
+            size_t count = 0;
+            vdp::VDP2WriteSpanCoalescer coalescer{};
+            auto sink = [&](vdp::VDP2WriteSpanTarget, const vdp::VDP2WriteSpan &span) {
+                pending[count++] = {.type = 1, .span = span};
+                if (count == pending.size()) {
+                    queue.enqueue_bulk(pTok, pending.begin(), count);
+                    count = 0;
+                }
+            };
+            for (uint32 i = 0; i < kUploadSize; i += sizeof(uint16)) {
+                coalescer.WriteVRAM<uint16>(i, i, sink);
+            }
+            coalescer.Flush(sink);
+            queue.enqueue_bulk(pTok, pending.begin(), count);
+
+            std::array<SpanEvent, 64> events{};
+            size_t dequeued = 0;
+            while (size_t n = queue.try_dequeue_bulk(events.begin(), events.size())) {
+                dequeued += n;
+            }
+            return dequeued;
+        });
+    };
+}
+
+} // namespace vdp_vram_write_patterns_tests
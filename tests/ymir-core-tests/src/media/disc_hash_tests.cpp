@@ -0,0 +1,198 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/media/binary_reader/binary_reader_mem.hpp>
+#include <ymir/media/binary_reader/binary_reader_subview.hpp>
+#include <ymir/media/disc_hash.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+using namespace ymir;
+
+namespace disc_hash {
+
+// Wraps a reader without exposing direct views, forcing CalcDiscImageHash through the Read path.
+// Can optionally report more data than is actually available.
+class ReadOnlyBinaryReader final : public media::IBinaryReader {
+public:
+    explicit ReadOnlyBinaryReader(std::shared_ptr<media::IBinaryReader> reader, uintmax_t missingSize = 0)
+        : m_reader(std::move(reader))
+        , m_missingSize(missingSize) {}
+
+    uintmax_t Size() const final {
+        return m_reader->Size() + m_missingSize;
+    }
+
+    uintmax_t Read(uintmax_t offset, uintmax_t size, std::span<uint8> output) const final {
+        return m_reader->Read(offset, size, output);
+    }
+
+private:
+    std::shared_ptr<media::IBinaryReader> m_reader;
+    uintmax_t m_missingSize;
+};
+
+static constexpr uint32 kUnitSize = 2352;
+
+std::vector<uint8> MakeTrackData(uint32 frames, uint32 seed) {
+    std::vector<uint8> data(frames * kUnitSize);
+    uint32 value = seed;
+    for (uint8 &b : data) {
+        value = value * 1664525u + 1013904223u;
+        b = value >> 24u;
+    }
+    return data;
+}
+
+// Builds a disc with a large data track spanning several shards and a small audio track
+media::Disc MakeDisc(std::shared_ptr<media::IBinaryReader> image, uint32 track1Frames, bool viewable) {
+    media::Disc disc{};
+    auto &session = disc.sessions.emplace_back();
+    auto addTrack = [&](uint32 index, uint32 frameOffset, uint32 frames) {
+        auto &track = session.tracks[index - 1];
+        std::shared_ptr<media::IBinaryReader> reader = image;
+        if (!viewable) {
+            reader = std::make_shared<ReadOnlyBinaryReader>(image);
+        }
+        track.binaryReader = std::make_unique<media::SharedSubviewBinaryReader>(
+            reader, static_cast<uintmax_t>(frameOffset) * kUnitSize, static_cast<uintmax_t>(frames) * kUnitSize);
+        track.index = index;
+        track.unitSize = kUnitSize;
+        track.startFrameAddress = 150 + frameOffset;
+        track.endFrameAddress = track.startFrameAddress + frames - 1;
+    };
+    const uint32 totalFrames = image->Size() / kUnitSize;
+    addTrack(1, 0, track1Frames);
+    addTrack(2, track1Frames, totalFrames - track1Frames);
+    return disc;
+}
+
+} // namespace disc_hash
+
+using namespace disc_hash;
+
+TEST_CASE("Disc image hash is independent of thread count and read path", "[media][hash]") {
+    static constexpr uint32 kTrack1Frames = 5000; // ~11 MiB, spans three shards
+    static constexpr uint32 kTrack2Frames = 300;
+
+    auto image = std::make_shared<media::MemoryBinaryReader>(MakeTrackData(kTrack1Frames + kTrack2Frames, 1));
+
+    const media::Disc disc = MakeDisc(image, kTrack1Frames, true);
+    const auto reference = media::CalcDiscImageHash(disc, 1);
+    REQUIRE(reference.has_value());
+
+    CHECK(media::CalcDiscImageHash(disc, 2) == reference);
+    CHECK(media::CalcDiscImageHash(disc, 7) == reference);
+    CHECK(media::CalcDiscImageHash(disc, 0) == reference);
+
+    const media::Disc readDisc = MakeDisc(image, kTrack1Frames, false);
+    CHECK(media::CalcDiscImageHash(readDisc, 1) == reference);
+    CHECK(media::CalcDiscImageHash(readDisc, 4) == reference);
+
+    SECTION("Any change to the contents changes the hash") {
+        auto data = MakeTrackData(kTrack1Frames + kTrack2Frames, 1);
+        data[kTrack1Frames * kUnitSize + 10] ^= 1;
+        auto modified = std::make_shared<media::MemoryBinaryReader>(std::move(data));
+        CHECK(media::CalcDiscImageHash(MakeDisc(modified, kTrack1Frames, true)) != reference);
+    }
+
+    SECTION("Moving a track boundary changes the hash") {
+        CHECK(media::CalcDiscImageHash(MakeDisc(image, kTrack1Frames - 1, true)) != reference);
+    }
+}
+
+TEST_CASE("Disc image hash fails on short reads", "[media][hash]") {
+    auto image = std::make_shared<media::MemoryBinaryReader>(MakeTrackData(100, 2));
+    media::Disc disc{};
+    auto &track = disc.sessions.emplace_back().tracks[0];
+    track.binaryReader = std::make_unique<ReadOnlyBinaryReader>(image, 10 * kUnitSize);
+    track.index = 1;
+    track.unitSize = kUnitSize;
+    track.startFrameAddress = 150;
+    track.endFrameAddress = 259;
+
+    CHECK_FALSE(media::CalcDiscImageHash(disc, 1).has_value());
+    CHECK_FALSE(media::CalcDiscImageHash(disc, 4).has_value());
+}
+
+TEST_CASE("Disc hash cache persists entries keyed by file size and modification time", "[media][hash]") {
+    const auto dir = std::filesystem::temp_directory_path() / "ymir-disc-hash-cache-tests";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    const auto imagePath = dir / "image with spaces.iso";
+    const auto cachePath = dir / "disc_hashes.txt";
+    std::ofstream{imagePath, std::ios::binary} << "disc image contents";
+
+    const XXH128Hash hash = MakeXXH128Hash(0x0123456789ABCDEFull, 0xFEDCBA9876543210ull);
+    std::error_code error{};
+
+    media::DiscHashCache cache{};
+    REQUIRE(cache.Load(cachePath, error)); // missing file is not an error
+    CHECK(cache.Size() == 0);
+    CHECK_FALSE(cache.Find(imagePath).has_value());
+
+    cache.Store(imagePath, hash);
+    CHECK(cache.IsDirty());
+    REQUIRE(cache.Save(cachePath, error));
+    CHECK_FALSE(cache.IsDirty());
+
+    media::DiscHashCache reloaded{};
+    REQUIRE(reloaded.Load(cachePath, error));
+    CHECK(reloaded.Size() == 1);
+    CHECK(reloaded.Find(imagePath) == hash);
+
+    // Growing the file invalidates the entry
+    std::ofstream{imagePath, std::ios::binary | std::ios::app} << "more";
+    CHECK_FALSE(reloaded.Find(imagePath).has_value());
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("Disc hash cache entries are invalidated by changes to track files", "[media][hash]") {
+    const auto dir = std::filesystem::temp_directory_path() / "ymir-disc-hash-cache-track-tests";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    const auto cuePath = dir / "image.cue";
+    const auto track1Path = dir / "image (Track 1).bin";
+    const auto track2Path = dir / "image (Track 2).bin";
+    const auto cachePath = dir / "disc_hashes.txt";
+    std::ofstream{cuePath, std::ios::binary} << "cue sheet";
+    std::ofstream{track1Path, std::ios::binary} << "data track";
+    std::ofstream{track2Path, std::ios::binary} << "audio track";
+
+    const XXH128Hash hash = MakeXXH128Hash(0x0123456789ABCDEFull, 0xFEDCBA9876543210ull);
+    const std::vector<std::filesystem::path> imageFiles{cuePath, track1Path, track2Path};
+    std::error_code error{};
+
+    media::DiscHashCache cache{};
+    cache.Store(cuePath, hash, imageFiles);
+    REQUIRE(cache.Save(cachePath, error));
+
+    media::DiscHashCache reloaded{};
+    REQUIRE(reloaded.Load(cachePath, error));
+    CHECK(reloaded.Size() == 1);
+    CHECK(reloaded.Find(cuePath) == hash);
+
+    SECTION("Modifying a track file") {
+        std::ofstream{track2Path, std::ios::binary | std::ios::app} << " replaced";
+        CHECK_FALSE(reloaded.Find(cuePath).has_value());
+    }
+
+    SECTION("Removing a track file") {
+        std::filesystem::remove(track1Path);
+        CHECK_FALSE(reloaded.Find(cuePath).has_value());
+    }
+
+    SECTION("Missing track files are not stored") {
+        std::filesystem::remove(track1Path);
+        media::DiscHashCache other{};
+        other.Store(cuePath, hash, imageFiles);
+        CHECK(other.Size() == 0);
+    }
+
+    std::filesystem::remove_all(dir);
+}
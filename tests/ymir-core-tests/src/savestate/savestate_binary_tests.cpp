@@ -0,0 +1,141 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <ymir/savestate/savestate_binary.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace savestate_binary {
+
+using namespace ymir::savestate;
+
+std::unique_ptr<SaveState> MakeState(bool cdblockLLE) {
+    auto state = std::make_unique<SaveState>();
+    state->cdblockLLE = cdblockLLE;
+    state->system.WRAMLow[0x1234] = 0x56;
+    state->system.WRAMHigh[0xFFFFF] = 0x78;
+    state->msh2.PC = 0x06004000;
+    state->scu.intrMask = 0xBFFF;
+    state->scu.cartData.assign(0x1000, 0xA5);
+    state->smpc.intback.report = {0xF1, 0x02, 0xFF, 0xFF};
+    state->smpc.intback.reportOffset = 2;
+    state->vdp.VRAM2[0x7FFFF] = 0x9A;
+    state->scsp.WRAM[0x100] = 0xBC;
+    state->cdblockDRAM[0x200] = 0xDE;
+    state->msh2SpilloverCycles = 123;
+    return state;
+}
+
+TEST_CASE("Binary save states round-trip", "[savestate][binary]") {
+    const bool lle = GENERATE(false, true);
+    auto src = MakeState(lle);
+
+    std::vector<uint8> buffer{};
+    binary::Write(*src, buffer);
+    REQUIRE(buffer.size() == binary::CalcSize(*src));
+
+    auto dst = std::make_unique<SaveState>();
+    REQUIRE(binary::Read(buffer, *dst, nullptr, true) == binary::ReadResult::Success);
+
+    CHECK(dst->cdblockLLE == lle);
+    CHECK(dst->system.WRAMLow == src->system.WRAMLow);
+    CHECK(dst->system.WRAMHigh == src->system.WRAMHigh);
+    CHECK(dst->msh2.PC == src->msh2.PC);
+    CHECK(dst->scu.intrMask == src->scu.intrMask);
+    CHECK(dst->scu.cartData == src->scu.cartData);
+    CHECK(dst->smpc.intback.report == src->smpc.intback.report);
+    CHECK(dst->smpc.intback.reportOffset == src->smpc.intback.reportOffset);
+    CHECK(dst->vdp.VRAM2 == src->vdp.VRAM2);
+    CHECK(dst->scsp.WRAM == src->scsp.WRAM);
+    CHECK(dst->msh2SpilloverCycles == src->msh2SpilloverCycles);
+    if (lle) {
+        CHECK(dst->cdblockDRAM == src->cdblockDRAM);
+    }
+}
+
+TEST_CASE("Binary save states place large memory blocks on page boundaries", "[savestate][binary]") {
+    auto src = MakeState(true);
+    std::vector<uint8> buffer{};
+    binary::Write(*src, buffer);
+
+    binary::SectionHeader table[binary::kNumSections];
+    std::memcpy(table, buffer.data() + sizeof(binary::FileHeader), sizeof(table));
+
+    auto offsetOf = [&](binary::SectionID id) { return table[static_cast<size_t>(id)].offset; };
+    CHECK((offsetOf(binary::SectionID::System) + offsetof(SystemSaveState, WRAMLow)) % binary::kPageSize == 0);
+    CHECK((offsetOf(binary::SectionID::VDP) + offsetof(VDPSaveState, VRAM1)) % binary::kPageSize == 0);
+    CHECK((offsetOf(binary::SectionID::SCSP) + offsetof(SCSPSaveState, WRAM)) % binary::kPageSize == 0);
+    CHECK(offsetOf(binary::SectionID::CDBlockDRAM) % binary::kPageSize == 0);
+}
+
+TEST_CASE("Binary save states skip unchanged sections", "[savestate][binary]") {
+    auto src = MakeState(false);
+    std::vector<uint8> buffer{};
+    binary::SectionChecksums srcChecksums{};
+    binary::Write(*src, buffer, &srcChecksums);
+
+    auto dst = std::make_unique<SaveState>();
+    binary::SectionChecksums dstChecksums{};
+    REQUIRE(binary::Read(buffer, *dst, &dstChecksums) == binary::ReadResult::Success);
+    CHECK(dstChecksums == srcChecksums);
+
+    // Tamper with a section in the target; the matching checksum must cause it to be skipped
+    dst->vdp.VRAM2[0] = 0xFF;
+    REQUIRE(binary::Read(buffer, *dst, &dstChecksums) == binary::ReadResult::Success);
+    CHECK(dst->vdp.VRAM2[0] == 0xFF);
+
+    // Unknown checksums force a full load
+    dstChecksums.fill(0);
+    REQUIRE(binary::Read(buffer, *dst, &dstChecksums) == binary::ReadResult::Success);
+    CHECK(dst->vdp.VRAM2[0] == src->vdp.VRAM2[0]);
+}
+
+TEST_CASE("Binary save states don't depend on uninitialized padding", "[savestate][binary]") {
+    // Construct states over memory filled with different garbage
+    auto serialize = [](uint8 fill) {
+        auto storage = std::make_unique<std::byte[]>(sizeof(SaveState));
+        std::memset(storage.get(), fill, sizeof(SaveState));
+        auto *state = new (storage.get()) SaveState();
+        state->msh2.PC = 0x06004000;
+        state->scu.intrMask = 0xBFFF;
+        state->smpc.intback.reportOffset = 2;
+
+        std::vector<uint8> buffer{};
+        binary::Write(*state, buffer);
+        state->~SaveState();
+        return buffer;
+    };
+
+    CHECK(serialize(0x00) == serialize(0xFF));
+}
+
+TEST_CASE("Binary save states reject invalid data", "[savestate][binary]") {
+    auto src = MakeState(false);
+    std::vector<uint8> buffer{};
+    binary::Write(*src, buffer);
+
+    auto dst = std::make_unique<SaveState>();
+
+    SECTION("Truncated data") {
+        buffer.resize(buffer.size() / 2);
+        CHECK(binary::Read(buffer, *dst) == binary::ReadResult::Truncated);
+    }
+    SECTION("Bad magic") {
+        buffer[0] ^= 0xFF;
+        CHECK(binary::Read(buffer, *dst) == binary::ReadResult::InvalidFormat);
+    }
+    SECTION("Different version") {
+        buffer[offsetof(binary::FileHeader, version)] ^= 0xFF;
+        CHECK(binary::Read(buffer, *dst) == binary::ReadResult::VersionMismatch);
+    }
+    SECTION("Corrupted payload") {
+        buffer.back() ^= 0xFF;
+        CHECK(binary::Read(buffer, *dst, nullptr, true) == binary::ReadResult::ChecksumMismatch);
+    }
+}
+
+} // namespace savestate_binary
@@ -0,0 +1,58 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/sys/saturn.hpp>
+
+#include <ymir/util/virtual_memory.hpp>
+
+#include <cstring>
+#include <memory>
+
+using namespace ymir;
+
+namespace instance_memory {
+
+TEST_CASE("Huge page virtual memory is usable and aligned", "[virtual_memory]") {
+    static constexpr size_t kSize = 3 * util::kHugePageSize + 12345;
+
+    util::VirtualMemory memory{kSize, {.hugePages = true}};
+    REQUIRE(memory.IsAllocated());
+    CHECK(memory.GetAllocatedSize() == kSize);
+
+    auto *bytes = static_cast<uint8 *>(memory.GetMemory());
+    std::memset(bytes, 0xA5, kSize);
+    CHECK(bytes[0] == 0xA5);
+    CHECK(bytes[kSize - 1] == 0xA5);
+
+    if (memory.GetBacking() != util::VirtualMemory::Backing::Regular) {
+        CHECK(reinterpret_cast<uintptr_t>(bytes) % util::kHugePageSize == 0);
+    }
+
+    util::VirtualMemory moved{std::move(memory)};
+    CHECK(moved.GetMemory() == bytes);
+    CHECK(moved.GetAllocatedSize() == kSize);
+
+    moved.Free();
+    CHECK_FALSE(moved.IsAllocated());
+    CHECK(moved.GetBacking() == util::VirtualMemory::Backing::Regular);
+
+    // The moved-from object remains usable
+    CHECK_FALSE(memory.IsAllocated());
+    REQUIRE(memory.Allocate(kSize, {.hugePages = true}) != nullptr);
+    CHECK(memory.GetAllocatedSize() == kSize);
+}
+
+TEST_CASE("Saturn instances are allocated in dedicated virtual memory", "[virtual_memory]") {
+    auto saturn = std::make_unique<Saturn>();
+    const auto address = reinterpret_cast<uintptr_t>(saturn.get());
+    CHECK(address % 4096 == 0);
+    if (saturn->GetMemoryBacking() != util::VirtualMemory::Backing::Regular) {
+        CHECK(address % util::kHugePageSize == 0);
+    }
+
+    // Binding is best-effort; it must not disturb the instance either way
+    saturn->BindMemoryToCurrentNUMANode();
+    saturn->mainBus.Write<uint32>(0x600'0000, 0xDEADBEEF);
+    CHECK(saturn->mainBus.Read<uint32>(0x600'0000) == 0xDEADBEEF);
+}
+
+} // namespace instance_memory
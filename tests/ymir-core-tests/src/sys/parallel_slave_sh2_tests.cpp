@@ -0,0 +1,264 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/sys/parallel_slave_sh2.hpp>
+
+#include <ymir/core/hash.hpp>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+using namespace ymir;
+
+namespace parallel_slave_sh2 {
+
+static constexpr uint32 kWRAMBase = 0x600'0000;
+static constexpr uint32 kDeviceBase = 0x5FE'0000;
+static constexpr uint32 kMasterCode = 0x0600'0000;
+static constexpr uint32 kSlaveCode = 0x0600'1000;
+
+// Master SH-2: after a delay loop, increments a counter by one plus the value of another variable, then writes to the
+// slave SH-2's input capture area (or any other address) whenever the counter matches a mask.
+//   R1 = counter address   R2 = address of the value added to the counter
+//   R3 = input capture address   R4 = mask   R9 = delay
+static constexpr std::array<uint16, 15> kMasterProgram = {
+    0x6893, // loop:  mov   r9, r8
+    0x4810, // delay: dt    r8
+    0x8BFD, //        bf    delay
+    0x6012, //        mov.l @r1, r0
+    0x7001, //        add   #1, r0
+    0x6522, //        mov.l @r2, r5
+    0x305C, //        add   r5, r0
+    0x2102, //        mov.l r0, @r1
+    0x6603, //        mov   r0, r6
+    0x2649, //        and   r4, r6
+    0x2668, //        tst   r6, r6
+    0x8B00, //        bf    skip
+    0x2301, //        mov.w r0, @r3
+    0xAFF1, // skip:  bra   loop
+    0x0009, //        nop
+};
+
+// Slave SH-2: after a delay loop, accumulates a value read from memory and round-trips it through the stack, stores
+// the sum and writes it to a device (or any other address) whenever it matches a mask.
+//   R1 = address of the value to accumulate   R2 = sum address
+//   R3 = device write address   R4 = mask   R9 = delay   R15 = stack pointer
+static constexpr std::array<uint16, 16> kSlaveProgram = {
+    0x6893, // loop:  mov   r9, r8
+    0x4810, // delay: dt    r8
+    0x8BFD, //        bf    delay
+    0x6012, //        mov.l @r1, r0
+    0x2F06, //        mov.l r0, @-r15
+    0x7703, //        add   #3, r7
+    0x65F6, //        mov.l @r15+, r5
+    0x375C, //        add   r5, r7
+    0x2272, //        mov.l r7, @r2
+    0x6673, //        mov   r7, r6
+    0x2649, //        and   r4, r6
+    0x2668, //        tst   r6, r6
+    0x8B00, //        bf    skip
+    0x2372, //        mov.l r7, @r3
+    0xAFF0, // skip:  bra   loop
+    0x0009, //        nop
+};
+
+struct Registers {
+    uint32 R1, R2, R3, R4, R9;
+};
+
+// A master and a slave SH-2 sharing WRAM, with a device that logs all writes made to it.
+struct TestSubject {
+    sys::SH2Bus bus{};
+    alignas(16) std::array<uint8, 1024 * 1024> wram{};
+    sh2::SH2 master{bus, true};
+    sh2::SH2 slave{bus, false};
+    std::optional<sys::ParallelSlaveSH2> parallelSlave;
+
+    std::vector<std::pair<uint32, uint32>> deviceWrites;
+    std::vector<XXH128Hash> frameHashes;
+    uint64 globalCycles = 0;
+    uint64 spillover = 0;
+    uint64 scuCycles = 0; // Stands in for the SCU, which must be advanced through the same cycles either way
+
+    explicit TestSubject(bool threaded) {
+        bus.MapArray(kWRAMBase, 0x7FF'FFFF, wram, true);
+        bus.MapNormal(
+            kDeviceBase, kDeviceBase + 0xFFFF, this, //
+            [](uint32, void *) -> uint8 { return 0; }, [](uint32, void *) -> uint16 { return 0; },
+            [](uint32, void *) -> uint32 { return 0; }, [](uint32, uint8, void *) {}, [](uint32, uint16, void *) {},
+            [](uint32 address, uint32 value, void *ctx) {
+                static_cast<TestSubject *>(ctx)->deviceWrites.emplace_back(address, value);
+            });
+        master.MapMemory(bus);
+        slave.MapMemory(bus);
+        master.BindGlobalCycleCounter(globalCycles);
+        slave.BindGlobalCycleCounter(globalCycles);
+
+        if (threaded) {
+            parallelSlave.emplace(master, slave, bus);
+            parallelSlave->AddSharedMemory(kWRAMBase, 0x7FF'FFFF, wram, true);
+            parallelSlave->SetAdvanceSCUCallback(util::MakeClassMemberRequiredCallback<&TestSubject::AdvanceSCU>(this));
+            parallelSlave->Enable(true);
+        }
+    }
+
+    ~TestSubject() {
+        if (parallelSlave) {
+            parallelSlave->Enable(false);
+        }
+    }
+
+    void LoadProgram(uint32 address, std::span<const uint16> program) {
+        for (uint16 instr : program) {
+            bus.Poke<uint16>(address, instr);
+            address += sizeof(uint16);
+        }
+    }
+
+    static void Start(sh2::SH2 &sh2, uint32 pc, const Registers &regs, uint32 sp) {
+        savestate::SH2SaveState state{};
+        sh2.SaveState(state);
+        state.PC = pc;
+        state.R[1] = regs.R1;
+        state.R[2] = regs.R2;
+        state.R[3] = regs.R3;
+        state.R[4] = regs.R4;
+        state.R[9] = regs.R9;
+        state.R[15] = sp;
+        state.forceFetchOpcodes = true;
+        sh2.LoadState(state);
+        sh2.PostLoadState(state);
+    }
+
+    void AdvanceSCU(uint64 cycles) {
+        scuCycles += cycles;
+    }
+
+    // Runs both CPUs through a slice as done by Saturn::Run: threaded if possible, else interleaved in small steps.
+    void RunSlice(uint64 cycles) {
+        uint64 execCycles = 0;
+        uint64 slaveCycles = spillover;
+        bool sliceDone = false;
+        if (parallelSlave && parallelSlave->Begin<false>(cycles, execCycles, slaveCycles)) {
+            do {
+                execCycles = master.Advance<false, false>(std::min<uint64>(execCycles + 32, cycles), execCycles);
+            } while (parallelSlave->EndStep(execCycles) && execCycles < cycles);
+            sliceDone = parallelSlave->Finish(cycles, execCycles, slaveCycles);
+        }
+        while (!sliceDone) {
+            const uint64 prevExecCycles = execCycles;
+            execCycles = master.Advance<false, false>(std::min<uint64>(execCycles + 32, cycles), execCycles);
+            slaveCycles = slave.Advance<false, false>(execCycles, slaveCycles);
+            AdvanceSCU(execCycles - prevExecCycles);
+            sliceDone = execCycles >= cycles;
+        }
+        spillover = slaveCycles - execCycles;
+        globalCycles += execCycles;
+    }
+
+    void HashFrame() {
+        std::vector<uint8> data{wram.begin(), wram.end()};
+        const auto *scuBytes = reinterpret_cast<const uint8 *>(&scuCycles);
+        data.insert(data.end(), scuBytes, scuBytes + sizeof(scuCycles));
+        for (const sh2::SH2 *sh2 : {&master, &slave}) {
+            savestate::SH2SaveState state{};
+            sh2->SaveState(state);
+            const std::array<uint32, 10> regs = {state.PC,   state.PR,   state.SR,      state.GBR,     state.VBR,
+                                                 state.MACL, state.MACH, state.frt.FRC, state.frt.ICR, state.frt.FTCSR};
+            const auto *regBytes = reinterpret_cast<const uint8 *>(regs.data());
+            data.insert(data.end(), regBytes, regBytes + sizeof(regs));
+            const auto *gprBytes = reinterpret_cast<const uint8 *>(state.R.data());
+            data.insert(data.end(), gprBytes, gprBytes + sizeof(state.R));
+        }
+        frameHashes.push_back(CalcHash128(data.data(), data.size()));
+    }
+
+    // Runs a fixed sequence of pseudo-randomly sized slices, hashing the system state every "frame".
+    void Run(uint32 frames) {
+        uint32 rng = 0x1234567u;
+        for (uint32 frame = 0; frame < frames; ++frame) {
+            for (uint32 slice = 0; slice < 25; ++slice) {
+                rng = rng * 1664525u + 1013904223u;
+                RunSlice(50 + (rng >> 16u) % 650);
+            }
+            HashFrame();
+        }
+    }
+};
+
+static void RunScenario(const Registers &masterRegs, const Registers &slaveRegs,
+                        const std::function<void(const sys::ParallelSlaveSH2::Stats &)> &checkStats) {
+    auto reference = std::make_unique<TestSubject>(false);
+    auto threaded = std::make_unique<TestSubject>(true);
+
+    for (TestSubject *subject : {reference.get(), threaded.get()}) {
+        subject->LoadProgram(kMasterCode, kMasterProgram);
+        subject->LoadProgram(kSlaveCode, kSlaveProgram);
+        TestSubject::Start(subject->master, kMasterCode, masterRegs, 0x2600'E000);
+        TestSubject::Start(subject->slave, kSlaveCode, slaveRegs, 0x2600'F000);
+        subject->Run(40);
+    }
+
+    REQUIRE(threaded->frameHashes.size() == reference->frameHashes.size());
+    for (size_t i = 0; i < reference->frameHashes.size(); ++i) {
+        CAPTURE(i);
+        REQUIRE(threaded->frameHashes[i] == reference->frameHashes[i]);
+    }
+    CHECK(threaded->deviceWrites == reference->deviceWrites);
+
+    const auto &stats = threaded->parallelSlave->GetStats();
+    CHECK(stats.slices == 40 * 25);
+    CHECK(stats.committed + stats.diverted + stats.rolledBack + stats.sequential == stats.slices);
+    checkStats(stats);
+}
+
+TEST_CASE("Threaded slave SH-2 commits independent slices", "[sys][sh2][threading]") {
+    RunScenario({0x2600'8000, 0x2600'8010, 0x2600'8020, 0, 7}, //
+                {0x2600'9000, 0x2600'9004, 0x2600'9008, 0, 5}, //
+                [](const sys::ParallelSlaveSH2::Stats &stats) { CHECK(stats.committed == stats.slices); });
+}
+
+TEST_CASE("Threaded slave SH-2 commits slices that only share reads", "[sys][sh2][threading]") {
+    // Both SH-2s read the same variable, which neither of them writes
+    RunScenario({0x2600'8000, 0x2600'8010, 0x2600'8020, 0, 7}, //
+                {0x2600'8010, 0x2600'9004, 0x2600'9008, 0, 5}, //
+                [](const sys::ParallelSlaveSH2::Stats &stats) { CHECK(stats.committed == stats.slices); });
+}
+
+TEST_CASE("Threaded slave SH-2 matches interleaved execution with shared variables", "[sys][sh2][threading]") {
+    // Each SH-2 reads the variable written by the other one
+    RunScenario({0x2600'8000, 0x2600'8004, 0x2600'8020, 0, 7}, //
+                {0x2600'8000, 0x2600'8004, 0x2600'9008, 0, 5}, //
+                [](const sys::ParallelSlaveSH2::Stats &stats) {
+                    CHECK(stats.rolledBack > 0);
+                    CHECK(stats.diverted == 0);
+                });
+}
+
+TEST_CASE("Threaded slave SH-2 matches interleaved execution with occasional conflicts", "[sys][sh2][threading]") {
+    // Every 64 iterations, the master SH-2 overwrites the variable accumulated by the slave SH-2
+    RunScenario({0x2600'8000, 0x2600'8010, 0x2600'9000, 0x3F, 7}, //
+                {0x2600'9000, 0x2600'9004, 0x2600'9008, 0, 5},    //
+                [](const sys::ParallelSlaveSH2::Stats &stats) {
+                    CHECK(stats.committed > 0);
+                    CHECK(stats.rolledBack > 0);
+                });
+}
+
+TEST_CASE("Threaded slave SH-2 matches interleaved execution with devices and input captures",
+          "[sys][sh2][threading]") {
+    RunScenario({0x2600'8000, 0x2600'8010, 0x2100'0000, 0x1FF, 7}, //
+                {0x2600'9000, 0x2600'9004, 0x25FE'0000, 0x7F0, 5}, //
+                [](const sys::ParallelSlaveSH2::Stats &stats) {
+                    CHECK(stats.committed > 0);
+                    CHECK(stats.diverted > 0);
+                    CHECK(stats.rolledBack > 0);
+                });
+}
+
+} // namespace parallel_slave_sh2
@@ -0,0 +1,154 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/hw/cart/cart_impl_rom.hpp>
+#include <ymir/sys/shared_rom_pool.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace shared_rom_pool_tests {
+
+using namespace ymir;
+
+static std::vector<uint8> MakeImage(size_t size, uint8 seed) {
+    std::vector<uint8> image(size);
+    for (size_t i = 0; i < size; ++i) {
+        image[i] = static_cast<uint8>(i * 31 + seed);
+    }
+    return image;
+}
+
+struct TempFile {
+    explicit TempFile(std::span<const uint8> contents)
+        : path(std::filesystem::temp_directory_path() /
+               ("ymir-shared-rom-test-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) +
+                ".bin")) {
+        std::ofstream out{path, std::ios::binary};
+        out.write(reinterpret_cast<const char *>(contents.data()), contents.size());
+    }
+
+    ~TempFile() {
+        std::error_code error{};
+        std::filesystem::remove(path, error);
+    }
+
+    std::filesystem::path path;
+};
+
+TEST_CASE("Shared ROM pool deduplicates images by content", "[shared_rom]") {
+    sys::SharedROMPool pool{};
+    const auto image = MakeImage(64 * 1024, 1);
+    const auto otherImage = MakeImage(64 * 1024, 2);
+    std::error_code error{};
+
+    auto first = pool.Acquire(image, error);
+    REQUIRE(first != nullptr);
+    CHECK(std::equal(image.begin(), image.end(), first->Data().begin(), first->Data().end()));
+
+    auto second = pool.Acquire(image, error);
+    CHECK(second == first);
+
+    auto other = pool.Acquire(otherImage, error);
+    REQUIRE(other != nullptr);
+    CHECK(other != first);
+    CHECK(pool.GetLiveCount() == 2);
+
+    SECTION("Files with the same contents resolve to the same image") {
+        TempFile file{image};
+        auto mapped = pool.AcquireFile(file.path, error);
+        CHECK(mapped == first);
+    }
+
+    SECTION("Imported objects resolve to the same image") {
+        auto imported = util::SharedMemory::Import(first->GetNativeHandle(), first->Size(), error);
+        REQUIRE(imported != nullptr);
+        CHECK(imported->Data().data() != first->Data().data());
+        CHECK(pool.Add(imported) == first);
+    }
+
+    SECTION("Released images leave the pool") {
+        other.reset();
+        CHECK(pool.GetLiveCount() == 1);
+        first.reset();
+        second.reset();
+        CHECK(pool.GetLiveCount() == 0);
+    }
+}
+
+TEST_CASE("Shared memory slots map shared images in place", "[shared_rom]") {
+    static constexpr size_t kSize = 64 * 1024;
+    const auto image = MakeImage(kSize, 3);
+    std::error_code error{};
+    auto memory = util::SharedMemory::Create(image, error);
+    REQUIRE(memory != nullptr);
+
+    util::SharedMemorySlot slot1{kSize};
+    util::SharedMemorySlot slot2{kSize};
+    uint8 *const address = slot1.Data();
+    slot1.Data()[0] = 0xAA;
+
+    REQUIRE(slot1.MapShared(memory, false));
+    REQUIRE(slot2.MapShared(memory, false));
+    CHECK(slot1.Data() == address);
+    CHECK(slot1.IsReadOnly());
+    CHECK(slot1.GetSharedMemory() == memory);
+    CHECK(std::equal(image.begin(), image.end(), slot1.Data()));
+
+    SECTION("Writable slots get private copies of written pages") {
+        slot1.MakeWritable();
+        CHECK_FALSE(slot1.IsReadOnly());
+        CHECK(slot1.Data() == address);
+        slot1.Data()[100] ^= 0xFF;
+        CHECK(slot1.Data()[100] == static_cast<uint8>(image[100] ^ 0xFF));
+        CHECK(slot2.Data()[100] == image[100]);
+        CHECK(memory->Data()[100] == image[100]);
+    }
+
+    SECTION("Mismatched sizes fall back to a copy") {
+        const auto smallImage = MakeImage(kSize / 2, 4);
+        auto small = util::SharedMemory::Create(smallImage, error);
+        REQUIRE(small != nullptr);
+        CHECK_FALSE(slot1.MapShared(small, false));
+        CHECK_FALSE(slot1.IsReadOnly());
+        CHECK(slot1.GetSharedMemory() == nullptr);
+        CHECK(std::equal(smallImage.begin(), smallImage.end(), slot1.Data()));
+        CHECK(slot1.Data()[kSize / 2] == 0);
+    }
+
+    SECTION("Private memory is zero-filled") {
+        slot1.MapPrivate();
+        CHECK(slot1.Data() == address);
+        CHECK(slot1.GetSharedMemory() == nullptr);
+        CHECK(slot1.Data()[0] == 0);
+        CHECK(slot1.Data()[kSize - 1] == 0);
+    }
+}
+
+TEST_CASE("ROM cartridges share ROM images", "[shared_rom]") {
+    sys::SharedROMPool pool{};
+    const auto image = MakeImage(cart::kROMCartSize, 5);
+    std::error_code error{};
+    auto rom = pool.Acquire(image, error);
+    REQUIRE(rom != nullptr);
+
+    cart::ROMCartridge cart1{};
+    cart::ROMCartridge cart2{};
+    cart1.LoadROM(rom);
+    cart2.LoadROM(rom);
+    CHECK(cart1.HasROM(image));
+    CHECK(cart1.ReadWord(0x200'0010) == ((image[0x10] << 8u) | image[0x11]));
+
+    // Writes are ignored; pokes only affect the poked cartridge
+    cart1.WriteByte(0x200'0000, ~image[0]);
+    CHECK(cart1.ReadByte(0x200'0000) == image[0]);
+    cart1.PokeByte(0x200'0000, ~image[0]);
+    CHECK(cart1.ReadByte(0x200'0000) == static_cast<uint8>(~image[0]));
+    CHECK(cart2.ReadByte(0x200'0000) == image[0]);
+    CHECK_FALSE(cart1.HasROM(image));
+    CHECK(cart2.HasROM(image));
+}
+
+} // namespace shared_rom_pool_tests
@@ -0,0 +1,244 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <ymir/debug/protocol/debug_command.hpp>
+#include <ymir/debug/protocol/debug_event.hpp>
+#include <ymir/debug/protocol/debug_result.hpp>
+
+#include <protocol/binary_framer.hpp>
+#include <protocol/line_framer.hpp>
+#include <protocol/memory_diff.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<uint8_t> MakePattern(size_t size) {
+    std::vector<uint8_t> data(size);
+    uint32_t state = 0x12345678u;
+    for (auto &byte : data) {
+        state = state * 1664525u + 1013904223u;
+        byte = static_cast<uint8_t>(state >> 24u);
+    }
+    return data;
+}
+
+struct ReceivedFrame {
+    ymir::debug::BinaryFrameType type;
+    uint32_t channel;
+    std::vector<uint8_t> payload;
+};
+
+} // namespace
+
+TEST_CASE("Binary protocol method names", "[protocol][binary]") {
+    CHECK(ToString(ymir::debug::CommandMethod::TransportUpgrade) == "transport.upgrade");
+    CHECK(ToString(ymir::debug::CommandMethod::MemDump) == "mem.dump");
+    CHECK(ToString(ymir::debug::CommandMethod::EventsSubscribe) == "events.subscribe");
+    CHECK(ToString(ymir::debug::CommandMethod::EventsUnsubscribe) == "events.unsubscribe");
+    CHECK(ToString(ymir::debug::EventKind::BreakpointHit) == "breakpoint_hit");
+    CHECK(ToString(ymir::debug::EventKind::FrameTick) == "frame_tick");
+    CHECK(ToString(ymir::debug::EventKind::MemoryDiff) == "memory_diff");
+    CHECK(ymir::debug::kStdioBinaryFramesTransport == "stdio-binary-frames");
+    CHECK(ymir::debug::kEventBatchNotification == "events.batch");
+}
+
+TEST_CASE("MemDumpParams carries multiple regions", "[protocol][binary]") {
+    ymir::debug::DebugCommand command;
+    command.method = ymir::debug::CommandMethod::MemDump;
+    command.params = ymir::debug::MemDumpParams{
+        ymir::debug::DebugTarget::Sh2Master,
+        {{0x06000000, 0x100000}, {0x25E00000, 0x80000}},
+    };
+
+    REQUIRE(std::holds_alternative<ymir::debug::MemDumpParams>(command.params));
+    const auto &params = std::get<ymir::debug::MemDumpParams>(command.params);
+    REQUIRE(params.regions.size() == 2);
+    CHECK(params.regions[1].address == 0x25E00000);
+    CHECK(params.regions[1].size == 0x80000);
+}
+
+TEST_CASE("EventBatch carries typed events", "[protocol][binary]") {
+    ymir::debug::EventBatch batch;
+    batch.subscription_id = "sub-1";
+    batch.events.push_back({ymir::debug::FrameTickEvent{42}});
+    batch.events.push_back({ymir::debug::MemoryDiffEvent{42, 0x06004000, 16, 0}});
+    batch.data_size = 16;
+
+    REQUIRE(batch.events.size() == 2);
+    REQUIRE(std::holds_alternative<ymir::debug::MemoryDiffEvent>(batch.events[1].payload));
+    CHECK(std::get<ymir::debug::MemoryDiffEvent>(batch.events[1].payload).address == 0x06004000);
+}
+
+TEST_CASE("BinaryFramer splits frames", "[protocol][binary]") {
+    std::vector<ReceivedFrame> frames;
+    ymir::debug::BinaryFramer framer(
+        [&](const ymir::debug::BinaryFrame &frame) {
+            frames.push_back({frame.type, frame.channel, {frame.payload.begin(), frame.payload.end()}});
+        },
+        [](ymir::debug::BinaryFramerError) { FAIL("Unexpected error"); });
+
+    const std::string json = R"({"jsonrpc":"2.0","method":"mem.dump","id":1})";
+    const std::vector<uint8_t> data = MakePattern(70000);
+
+    std::vector<uint8_t> stream;
+    ymir::debug::AppendBinaryFrame(stream, json);
+    ymir::debug::AppendBinaryFrame(stream, ymir::debug::BinaryFrameType::Data, 7, data);
+    ymir::debug::AppendBinaryFrame(stream, ymir::debug::BinaryFrameType::Data, 8, {});
+
+    auto check = [&] {
+        REQUIRE(frames.size() == 3);
+        CHECK(frames[0].type == ymir::debug::BinaryFrameType::Json);
+        CHECK(std::string(frames[0].payload.begin(), frames[0].payload.end()) == json);
+        CHECK(frames[1].type == ymir::debug::BinaryFrameType::Data);
+        CHECK(frames[1].channel == 7);
+        CHECK(frames[1].payload == data);
+        CHECK(frames[2].channel == 8);
+        CHECK(frames[2].payload.empty());
+    };
+
+    SECTION("Single push") {
+        framer.Push(stream);
+        check();
+    }
+
+    SECTION("Byte by byte") {
+        for (uint8_t byte : stream) {
+            framer.Push(std::span<const uint8_t>{&byte, 1});
+        }
+        check();
+    }
+
+    SECTION("Odd chunk sizes") {
+        const std::span<const uint8_t> bytes{stream};
+        for (size_t offset = 0; offset < bytes.size(); offset += 4093) {
+            framer.Push(bytes.subspan(offset, std::min<size_t>(4093, bytes.size() - offset)));
+        }
+        check();
+    }
+
+    SECTION("Split inside the header") {
+        framer.Push(std::span<const uint8_t>{stream}.first(5));
+        CHECK(frames.empty());
+        framer.Push(std::span<const uint8_t>{stream}.subspan(5));
+        check();
+    }
+}
+
+TEST_CASE("BinaryFramer rejects malformed streams", "[protocol][binary]") {
+    std::vector<ymir::debug::BinaryFramerError> errors;
+    size_t frameCount = 0;
+    ymir::debug::BinaryFramer framer([&](const ymir::debug::BinaryFrame &) { ++frameCount; },
+                                     [&](ymir::debug::BinaryFramerError error) { errors.push_back(error); });
+
+    SECTION("Bad magic") {
+        const std::string line = "{\"jsonrpc\":\"2.0\"}\n";
+        framer.Push(line.data(), line.size());
+        REQUIRE(errors.size() == 1);
+        CHECK(errors[0] == ymir::debug::BinaryFramerError::InvalidHeader);
+    }
+
+    SECTION("Oversized frame") {
+        const auto header = ymir::debug::EncodeBinaryFrameHeader(
+            ymir::debug::BinaryFrameType::Data, 0,
+            static_cast<uint32_t>(ymir::debug::BinaryFramer::kMaxFrameLength + 1));
+        framer.Push(header);
+        REQUIRE(errors.size() == 1);
+        CHECK(errors[0] == ymir::debug::BinaryFramerError::FrameTooLarge);
+    }
+
+    // Nothing is delivered after an error since the stream can't be resynchronized
+    std::vector<uint8_t> valid;
+    ymir::debug::AppendBinaryFrame(valid, "{}");
+    framer.Push(valid);
+    CHECK(framer.Failed());
+    CHECK(frameCount == 0);
+    CHECK(errors.size() == 1);
+}
+
+TEST_CASE("DiffMemory finds changed runs", "[protocol][binary]") {
+    const std::vector<uint8_t> before = MakePattern(4096);
+    std::vector<uint8_t> after = before;
+
+    CHECK(ymir::debug::DiffMemory(before, after).empty());
+
+    after[0] ^= 0xFF;
+    after[100] ^= 0xFF;
+    after[104] ^= 0xFF;
+    after[4095] ^= 0xFF;
+    const auto runs = ymir::debug::DiffMemory(before, after, 8);
+    REQUIRE(runs.size() == 3);
+    CHECK(runs[0].offset == 0);
+    CHECK(runs[0].size == 1);
+    CHECK(runs[1].offset == 100); // merged across the short gap
+    CHECK(runs[1].size == 5);
+    CHECK(runs[2].offset == 4095);
+    CHECK(runs[2].size == 1);
+
+    const auto unmerged = ymir::debug::DiffMemory(before, after, 0);
+    CHECK(unmerged.size() == 4);
+}
+
+TEST_CASE("Bulk memory transfer throughput", "[.][benchmark][protocol][binary]") {
+    // A full WRAM-H dump. As JSON, a region this large doesn't even fit in a single line, so the JSON baseline uses
+    // the largest region that does.
+    const std::vector<uint8_t> wram = MakePattern(1024 * 1024);
+    const std::span<const uint8_t> jsonRegion = std::span<const uint8_t>{wram}.first(192 * 1024);
+
+    BENCHMARK("JSON mem.peek, 192 KiB") {
+        const nlohmann::json message = {
+            {"jsonrpc", "2.0"},
+            {"id", 1},
+            {"result", {{"address", 0x06000000}, {"data", jsonRegion}}},
+        };
+        std::string line = message.dump();
+        line += '\n';
+
+        size_t received = 0;
+        ymir::debug::LineFramer framer(
+            [&](std::string_view text) {
+                received = nlohmann::json::parse(text)["result"]["data"].get<std::vector<uint8_t>>().size();
+            },
+            [](ymir::debug::LineFramerError) {});
+        framer.Push(line.data(), line.size());
+        return received;
+    };
+
+    BENCHMARK("Binary mem.dump, 1 MiB") {
+        std::vector<uint8_t> stream;
+        stream.reserve(wram.size() + 256);
+        ymir::debug::AppendBinaryFrame(stream, R"({"jsonrpc":"2.0","id":1,"result":{"data_channel":1}})");
+        ymir::debug::AppendBinaryFrame(stream, ymir::debug::BinaryFrameType::Data, 1, wram);
+
+        size_t received = 0;
+        ymir::debug::BinaryFramer framer(
+            [&](const ymir::debug::BinaryFrame &frame) {
+                if (frame.type == ymir::debug::BinaryFrameType::Data) {
+                    received = frame.payload.size();
+                } else {
+                    received = nlohmann::json::parse(frame.Text())["result"]["data_channel"].get<uint32_t>();
+                }
+            },
+            [](ymir::debug::BinaryFramerError) {});
+        // Deliver in pipe-sized chunks, as the relay would
+        const std::span<const uint8_t> bytes{stream};
+        for (size_t offset = 0; offset < bytes.size(); offset += 65536) {
+            framer.Push(bytes.subspan(offset, std::min<size_t>(65536, bytes.size() - offset)));
+        }
+        return received;
+    };
+
+    BENCHMARK("Per-frame memory diff, 1 MiB, 64 changed spots") {
+        std::vector<uint8_t> next = wram;
+        for (size_t i = 0; i < 64; ++i) {
+            next[i * 16381] ^= 0x5A;
+        }
+        return ymir::debug::DiffMemory(wram, next).size();
+    };
+}
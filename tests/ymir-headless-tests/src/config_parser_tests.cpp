@@ -203,6 +203,135 @@ TEST_CASE("LoadConfig defaults slave SH-2 to enabled", "[config]") {
     CHECK(config.slave_enabled);
 }
 
+TEST_CASE("LoadConfig reads shared preload flag from CLI", "[config]") {
+    ScopedEnvVar env{"YMIR_CONFIG"};
+    env.Unset();
+    TempConfigFile configFile{R"(ipl_path = "bios.bin")"};
+
+    auto defaults = LoadWithArgs({"ymir-headless", "--config", configFile.Path().string()});
+    CHECK_FALSE(defaults.shared_preload);
+
+    auto shared = LoadWithArgs({"ymir-headless", "--config", configFile.Path().string(), "--shared-preload"});
+    CHECK(shared.shared_preload);
+}
+
+TEST_CASE("LoadConfig reads frame count and render interval from CLI", "[config]") {
+    ScopedEnvVar env{"YMIR_CONFIG"};
+    env.Unset();
+    TempConfigFile configFile{R"(ipl_path = "bios.bin")"};
+
+    auto defaults = LoadWithArgs({"ymir-headless", "--config", configFile.Path().string()});
+    CHECK(defaults.frames == 0);
+    CHECK(defaults.render_interval == 0);
+
+    auto config = LoadWithArgs(
+        {"ymir-headless", "--config", configFile.Path().string(), "--frames", "600", "--render-interval", "4"});
+    CHECK(config.frames == 600);
+    CHECK(config.render_interval == 4);
+
+    auto invalid = LoadWithArgs({"ymir-headless", "--config", configFile.Path().string(), "--frames", "lots"});
+    CHECK(invalid.frames == 0);
+}
+
+TEST_CASE("LoadConfig reads trace paths from CLI", "[config]") {
+    ScopedEnvVar env{"YMIR_CONFIG"};
+    env.Unset();
+    TempConfigFile configFile{R"(ipl_path = "bios.bin")"};
+
+    auto defaults = LoadWithArgs({"ymir-headless", "--config", configFile.Path().string()});
+    CHECK_FALSE(defaults.trace_path);
+    CHECK_FALSE(defaults.dump_trace_path);
+
+    auto config = LoadWithArgs({"ymir-headless", "--config", configFile.Path().string(), "--trace", "run.ytrace",
+                                "--dump-trace", "old.ytrace"});
+    REQUIRE(config.trace_path);
+    CHECK(*config.trace_path == std::filesystem::path{"run.ytrace"});
+    REQUIRE(config.dump_trace_path);
+    CHECK(*config.dump_trace_path == std::filesystem::path{"old.ytrace"});
+}
+
+TEST_CASE("LoadConfig reads profiler options from CLI", "[config]") {
+    ScopedEnvVar env{"YMIR_CONFIG"};
+    env.Unset();
+    TempConfigFile configFile{R"(ipl_path = "bios.bin")"};
+
+    auto defaults = LoadWithArgs({"ymir-headless", "--config", configFile.Path().string()});
+    CHECK_FALSE(defaults.profile_path);
+    CHECK(defaults.profile_interval == 0);
+    CHECK_FALSE(defaults.profile_symbols_path);
+
+    auto config = LoadWithArgs({"ymir-headless", "--config", configFile.Path().string(), "--profile", "out.folded",
+                                "--profile-interval", "500", "--profile-symbols", "game.sym"});
+    REQUIRE(config.profile_path);
+    CHECK(*config.profile_path == std::filesystem::path{"out.folded"});
+    CHECK(config.profile_interval == 500);
+    REQUIRE(config.profile_symbols_path);
+    CHECK(*config.profile_symbols_path == std::filesystem::path{"game.sym"});
+}
+
+TEST_CASE("LoadConfig reads timing report path from CLI", "[config]") {
+    ScopedEnvVar env{"YMIR_CONFIG"};
+    env.Unset();
+    TempConfigFile configFile{R"(ipl_path = "bios.bin")"};
+
+    auto defaults = LoadWithArgs({"ymir-headless", "--config", configFile.Path().string()});
+    CHECK_FALSE(defaults.timing_report_path);
+
+    auto config =
+        LoadWithArgs({"ymir-headless", "--config", configFile.Path().string(), "--timing-report", "timing.json"});
+    REQUIRE(config.timing_report_path);
+    CHECK(*config.timing_report_path == std::filesystem::path{"timing.json"});
+}
+
+TEST_CASE("LoadConfig reads capture paths from CLI", "[config]") {
+    ScopedEnvVar env{"YMIR_CONFIG"};
+    env.Unset();
+    TempConfigFile configFile{R"(ipl_path = "bios.bin")"};
+
+    auto defaults = LoadWithArgs({"ymir-headless", "--config", configFile.Path().string()});
+    CHECK_FALSE(defaults.capture_video_path);
+    CHECK_FALSE(defaults.capture_audio_path);
+
+    auto config = LoadWithArgs({"ymir-headless", "--config", configFile.Path().string(), "--capture-video",
+                                "out.y4m", "--capture-audio", "out.wav"});
+    REQUIRE(config.capture_video_path);
+    CHECK(*config.capture_video_path == std::filesystem::path{"out.y4m"});
+    REQUIRE(config.capture_audio_path);
+    CHECK(*config.capture_audio_path == std::filesystem::path{"out.wav"});
+}
+
+TEST_CASE("LoadConfig reads input movie options from CLI", "[config]") {
+    ScopedEnvVar env{"YMIR_CONFIG"};
+    env.Unset();
+    TempConfigFile configFile{R"(ipl_path = "bios.bin")"};
+
+    auto defaults = LoadWithArgs({"ymir-headless", "--config", configFile.Path().string()});
+    CHECK_FALSE(defaults.record_movie_path);
+    CHECK_FALSE(defaults.bench);
+    CHECK(defaults.bench_movie_paths.empty());
+    CHECK_FALSE(defaults.bench_report_path);
+
+    auto record = LoadWithArgs(
+        {"ymir-headless", "--config", configFile.Path().string(), "--frames", "600", "--record-movie", "run.ymov"});
+    REQUIRE(record.record_movie_path);
+    CHECK(*record.record_movie_path == std::filesystem::path{"run.ymov"});
+    CHECK_FALSE(record.bench);
+
+    auto bench = LoadWithArgs({"ymir-headless", "bench", "--config", configFile.Path().string(), "a.ymov",
+                               "--bench-report", "bench.json", "movies"});
+    CHECK(bench.bench);
+    CHECK(bench.bench_movie_paths ==
+          std::vector<std::filesystem::path>{std::filesystem::path{"a.ymov"}, std::filesystem::path{"movies"}});
+    REQUIRE(bench.bench_report_path);
+    CHECK(*bench.bench_report_path == std::filesystem::path{"bench.json"});
+    CHECK(bench.ipl_path == std::filesystem::path{"bios.bin"});
+
+    // Positional arguments are only accepted by the bench subcommand
+    auto stray = LoadWithArgs({"ymir-headless", "--config", configFile.Path().string(), "a.ymov"});
+    CHECK_FALSE(stray.bench);
+    CHECK(stray.bench_movie_paths.empty());
+}
+
 TEST_CASE("ValidateConfig returns true when ipl_path is non-empty", "[config]") {
     TempConfigFile configFile{"ipl_path = \"test.bin\""};
     ymir::debug::HeadlessConfig config;